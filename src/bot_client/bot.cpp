@@ -0,0 +1,330 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "bot.h"
+#include "bot_login_connector.h"
+#include "bot_realm_connector.h"
+#include "load_stats.h"
+
+#include "base/clock.h"
+#include "base/random.h"
+#include "base/timer_queue.h"
+#include "game/spell.h"
+#include "game/spell_target_map.h"
+#include "log/default_log_levels.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace mmo
+{
+	namespace
+	{
+		/// Interval in which the behaviour of a bot is updated (in milliseconds).
+		constexpr GameTime UpdateInterval = 100;
+
+		/// Run speed used for circle movement (in yards per second).
+		constexpr float RunSpeed = 7.0f;
+
+		/// Radius of the circle a walking bot runs around its spawn point (in yards).
+		constexpr float CircleRadius = 12.0f;
+
+		/// Character names may only contain letters, so the bot index is encoded as a letter sequence.
+		std::string MakeCharacterName(uint32 index)
+		{
+			std::string suffix;
+			do
+			{
+				suffix.insert(suffix.begin(), static_cast<char>('a' + index % 26));
+				index /= 26;
+			}
+			while (index > 0);
+
+			return "Bot" + suffix;
+		}
+
+		/// Gets a random offset in [0, interval), used to spread the actions of different bots over time.
+		GameTime RandomOffset(const GameTime interval)
+		{
+			std::uniform_int_distribution<GameTime> dist(0, std::max<GameTime>(interval, 1) - 1);
+			return dist(RandomGenerator);
+		}
+	}
+
+	Bot::Bot(BotEnvironment& environment, const uint32 index)
+		: m_environment(environment)
+		, m_accountName(environment.config.accountPrefix + std::to_string(index + 1))
+		, m_characterName(MakeCharacterName(index))
+		, m_updateCountdown(environment.timers)
+	{
+		m_connections += m_updateCountdown.ended.connect([this]() { OnUpdate(); });
+	}
+
+	Bot::~Bot()
+	{
+		m_connections.disconnect();
+
+		if (m_realm)
+		{
+			m_realm->resetListener();
+			m_realm->close();
+		}
+
+		if (m_login)
+		{
+			m_login->resetListener();
+			m_login->close();
+		}
+	}
+
+	void Bot::Start()
+	{
+		m_login = std::make_shared<BotLoginConnector>(m_environment.ioService);
+		m_connections += m_login->AuthenticationResult.connect([this](const auth::AuthResult result) { OnAuthenticationResult(result); });
+		m_connections += m_login->RealmListUpdated.connect([this]() { OnRealmListUpdated(); });
+
+		m_login->Connect(m_environment.config.loginHost, m_environment.config.loginPort, m_accountName, m_environment.config.password);
+	}
+
+	void Bot::OnAuthenticationResult(const uint8 result)
+	{
+		if (result != auth::auth_result::Success)
+		{
+			Fail("Login failed with result " + std::to_string(result));
+		}
+	}
+
+	void Bot::OnRealmListUpdated()
+	{
+		const auto& realms = m_login->GetRealms();
+		const auto it = std::find_if(realms.begin(), realms.end(), [this](const BotRealm& realm)
+		{
+			return m_environment.config.realmName.empty() || realm.name == m_environment.config.realmName;
+		});
+
+		if (it == realms.end())
+		{
+			Fail("Realm '" + m_environment.config.realmName + "' not found");
+			return;
+		}
+
+		m_realm = std::make_shared<BotRealmConnector>(m_environment.ioService, m_environment.stats);
+		m_connections += m_realm->AuthenticationResult.connect([this](const uint8 result) { OnRealmAuthenticationResult(result); });
+		m_connections += m_realm->CharListUpdated.connect([this]() { OnCharListUpdated(); });
+		m_connections += m_realm->VerifyNewWorld.connect([this](const uint32 mapId, const Vector3 position, const float facing) { OnVerifyNewWorld(mapId, position, facing); });
+		m_connections += m_realm->EnterWorldFailed.connect([this]() { Fail("Failed to enter the world"); });
+		m_connections += m_realm->Disconnected.connect([this]() { OnDisconnected(); });
+
+		m_realm->Connect(it->address, it->port, m_login->GetAccountName(), m_login->GetSessionKey());
+
+		// The login connection is no longer needed
+		m_login->close();
+	}
+
+	void Bot::OnRealmAuthenticationResult(const uint8 result)
+	{
+		if (result != game::auth_result::Success)
+		{
+			Fail("Realm authentication failed with result " + std::to_string(result));
+		}
+	}
+
+	void Bot::OnCharListUpdated()
+	{
+		const auto& characters = m_realm->GetCharacterViews();
+		if (!characters.empty())
+		{
+			m_realm->EnterWorld(characters.front().GetGuid());
+			return;
+		}
+
+		if (m_createdCharacter)
+		{
+			Fail("Character creation failed");
+			return;
+		}
+
+		// The realm answers with a new character list once the character has been created
+		m_createdCharacter = true;
+		m_realm->CreateCharacter(m_characterName, m_environment.config.race, m_environment.config.characterClass, 0);
+	}
+
+	void Bot::OnVerifyNewWorld(uint32 mapId, const Vector3 position, const float facing)
+	{
+		if (m_characterGuid != 0)
+		{
+			// Teleported to another world node: only move the circle center
+			m_movement.position = position;
+			m_movement.movementFlags = movement_flags::None;
+			m_center = position - Vector3(CircleRadius, 0.0f, 0.0f);
+			m_angle = 0.0f;
+			return;
+		}
+
+		m_characterGuid = m_realm->GetCharacterViews().front().GetGuid();
+		m_environment.characters.push_back(m_characterGuid);
+		m_environment.stats.RecordBotInWorld();
+
+		m_movement = MovementInfo();
+		m_movement.position = position;
+		m_movement.facing = Radian(facing);
+		m_center = position - Vector3(CircleRadius, 0.0f, 0.0f);
+		m_angle = 0.0f;
+
+		m_realm->RegisterPacketHandler(game::realm_client_packet::TimePlayedResponse, [this](game::IncomingPacket&)
+		{
+			if (m_pingPending)
+			{
+				const std::chrono::duration<float, std::milli> roundTrip = std::chrono::steady_clock::now() - m_pingSent;
+				m_environment.stats.RecordRoundTrip(roundTrip.count());
+				m_pingPending = false;
+			}
+
+			return PacketParseResult::Pass;
+		});
+
+		// Spread actions of different bots so that they don't all hit the same server tick
+		const GameTime now = GetAsyncTimeMs();
+		const BotConfig& config = m_environment.config;
+		m_nextMovement = now + config.movementInterval + RandomOffset(config.movementInterval);
+		m_nextChat = now + RandomOffset(config.chatInterval);
+		m_nextCast = now + RandomOffset(config.castInterval);
+		m_nextPing = now + RandomOffset(config.pingInterval);
+
+		m_updateCountdown.SetEnd(now + UpdateInterval);
+	}
+
+	void Bot::OnDisconnected()
+	{
+		Fail("Lost connection to the realm");
+	}
+
+	void Bot::Fail(const std::string& reason)
+	{
+		if (m_failed)
+		{
+			return;
+		}
+
+		m_failed = true;
+		ELOG("[" << m_accountName << "] " << reason);
+
+		m_updateCountdown.Cancel();
+		m_environment.stats.RecordBotLost();
+
+		if (m_characterGuid != 0)
+		{
+			std::erase(m_environment.characters, m_characterGuid);
+			m_characterGuid = 0;
+		}
+
+		if (m_realm)
+		{
+			m_realm->ClearPacketHandlers();
+		}
+	}
+
+	void Bot::OnUpdate()
+	{
+		const GameTime now = GetAsyncTimeMs();
+		const BotConfig& config = m_environment.config;
+
+		if (IsWalking() && now >= m_nextMovement)
+		{
+			UpdateMovement(now);
+			m_nextMovement = now + config.movementInterval;
+		}
+
+		if (IsChatting() && now >= m_nextChat)
+		{
+			SendChat();
+			m_nextChat = now + config.chatInterval;
+		}
+
+		if (IsFighting() && now >= m_nextCast)
+		{
+			CastSpell();
+			m_nextCast = now + config.castInterval;
+		}
+
+		if (now >= m_nextPing)
+		{
+			SendPing();
+			m_nextPing = now + config.pingInterval;
+		}
+
+		m_updateCountdown.SetEnd(now + UpdateInterval);
+	}
+
+	void Bot::UpdateMovement(const GameTime now)
+	{
+		const bool started = (m_movement.movementFlags & movement_flags::Forward) == 0;
+		if (!started)
+		{
+			const float elapsedSeconds = static_cast<float>(now - m_movement.timestamp) / 1000.0f;
+			m_angle = std::fmod(m_angle + elapsedSeconds * RunSpeed / CircleRadius, 2.0f * Pi);
+		}
+
+		// Position on the circle and facing along its tangent, using the same angle convention as the server
+		m_movement.position.x = m_center.x + std::cos(m_angle) * CircleRadius;
+		m_movement.position.z = m_center.z - std::sin(m_angle) * CircleRadius;
+		float facing = m_angle + Pi * 0.5f;
+		facing = facing >= 2.0f * Pi ? facing - 2.0f * Pi : facing;
+		m_movement.facing = Radian(facing);
+		m_movement.timestamp = now;
+		m_movement.movementFlags |= movement_flags::Forward;
+
+		m_realm->SendMovementUpdate(m_characterGuid,
+			started ? game::client_realm_packet::MoveStartForward : game::client_realm_packet::MoveHeartBeat,
+			m_movement);
+	}
+
+	void Bot::SendChat()
+	{
+		m_realm->SendChatMessage("Load test message from " + m_characterName, ChatType::Say);
+	}
+
+	void Bot::CastSpell()
+	{
+		const auto& characters = m_environment.characters;
+		if (m_environment.config.spellId == 0 || characters.size() < 2)
+		{
+			return;
+		}
+
+		std::uniform_int_distribution<size_t> dist(0, characters.size() - 1);
+		uint64 target = characters[dist(RandomGenerator)];
+		if (target == m_characterGuid)
+		{
+			target = characters[(std::find(characters.begin(), characters.end(), target) - characters.begin() + 1) % characters.size()];
+		}
+
+		SpellTargetMap targetMap;
+		targetMap.SetTargetMap(spell_cast_target_flags::Unit);
+		targetMap.SetUnitTarget(target);
+		m_realm->CastSpell(m_environment.config.spellId, targetMap);
+	}
+
+	void Bot::SendPing()
+	{
+		// TimePlayed is answered by the world node, so the round trip includes realm proxying and world packet handling
+		m_pingSent = std::chrono::steady_clock::now();
+		m_pingPending = true;
+		m_realm->SendTimePlayedRequest();
+	}
+
+	bool Bot::IsWalking() const
+	{
+		return m_environment.config.scenario == BotScenario::Walk || m_environment.config.scenario == BotScenario::Mixed;
+	}
+
+	bool Bot::IsChatting() const
+	{
+		return m_environment.config.scenario == BotScenario::Chat || m_environment.config.scenario == BotScenario::Mixed;
+	}
+
+	bool Bot::IsFighting() const
+	{
+		return m_environment.config.scenario == BotScenario::Combat || m_environment.config.scenario == BotScenario::Mixed;
+	}
+}
@@ -0,0 +1,150 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/countdown.h"
+#include "base/non_copyable.h"
+#include "base/signal.h"
+#include "game/movement_info.h"
+
+#include "asio/io_service.hpp"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace mmo
+{
+	class BotLoginConnector;
+	class BotRealmConnector;
+	class LoadStats;
+	class TimerQueue;
+
+	/// Scripted behaviour of a bot after it entered the world.
+	enum class BotScenario
+	{
+		/// Stand still and only answer time syncs and latency probes.
+		Idle,
+		/// Run in circles around the spawn point.
+		Walk,
+		/// Stand still and talk in say chat.
+		Chat,
+		/// Cast a spell on other bots.
+		Combat,
+		/// Run in circles, talk and cast.
+		Mixed
+	};
+
+	/// Settings shared by all bots of a run.
+	struct BotConfig final
+	{
+		std::string loginHost = "127.0.0.1";
+		uint16 loginPort = 0;
+		std::string realmName;
+		std::string accountPrefix = "bot";
+		std::string password = "bot";
+		BotScenario scenario = BotScenario::Mixed;
+		uint32 spellId = 0;
+		uint8 race = 1;
+		uint8 characterClass = 1;
+
+		/// Interval of movement heartbeats in milliseconds.
+		GameTime movementInterval = 500;
+		/// Interval of chat messages in milliseconds.
+		GameTime chatInterval = 10000;
+		/// Interval of spell casts in milliseconds.
+		GameTime castInterval = 3000;
+		/// Interval of latency probes in milliseconds.
+		GameTime pingInterval = 1000;
+	};
+
+	/// State shared by all bots of a run.
+	struct BotEnvironment final
+	{
+		asio::io_service& ioService;
+		TimerQueue& timers;
+		const BotConfig& config;
+		LoadStats& stats;
+
+		/// Guids of all bot characters which are currently in the world. Used to pick combat targets.
+		std::vector<uint64> characters;
+	};
+
+	/// A headless client which logs in through the login and realm server, enters the world with a character
+	/// and then executes a scripted behaviour using the real game protocol.
+	class Bot final : public NonCopyable
+	{
+	public:
+		/// @param environment Shared state of all bots.
+		/// @param index Index of the bot, used to derive account and character names.
+		Bot(BotEnvironment& environment, uint32 index);
+
+		~Bot();
+
+	public:
+		/// Starts the login process.
+		void Start();
+
+		/// Determines whether the bot finished entering the world.
+		[[nodiscard]] bool IsInWorld() const { return m_characterGuid != 0; }
+
+	private:
+		void OnAuthenticationResult(uint8 result);
+
+		void OnRealmListUpdated();
+
+		void OnRealmAuthenticationResult(uint8 result);
+
+		void OnCharListUpdated();
+
+		void OnVerifyNewWorld(uint32 mapId, Vector3 position, float facing);
+
+		void OnDisconnected();
+
+		void Fail(const std::string& reason);
+
+		/// Executes the scripted behaviour. Called periodically while the bot is in the world.
+		void OnUpdate();
+
+		void UpdateMovement(GameTime now);
+
+		void SendChat();
+
+		void CastSpell();
+
+		void SendPing();
+
+		[[nodiscard]] bool IsWalking() const;
+
+		[[nodiscard]] bool IsChatting() const;
+
+		[[nodiscard]] bool IsFighting() const;
+
+	private:
+		BotEnvironment& m_environment;
+		std::string m_accountName;
+		std::string m_characterName;
+
+		std::shared_ptr<BotLoginConnector> m_login;
+		std::shared_ptr<BotRealmConnector> m_realm;
+		scoped_connection_container m_connections;
+
+		bool m_createdCharacter { false };
+		bool m_failed { false };
+		uint64 m_characterGuid { 0 };
+		MovementInfo m_movement;
+		Vector3 m_center;
+		float m_angle { 0.0f };
+
+		Countdown m_updateCountdown;
+		GameTime m_nextMovement { 0 };
+		GameTime m_nextChat { 0 };
+		GameTime m_nextCast { 0 };
+		GameTime m_nextPing { 0 };
+
+		std::chrono::steady_clock::time_point m_pingSent;
+		bool m_pingPending { false };
+	};
+}
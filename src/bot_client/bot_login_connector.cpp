@@ -0,0 +1,172 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "bot_login_connector.h"
+#include "version.h"
+
+#include "base/constants.h"
+#include "game_protocol/game_protocol.h"
+#include "log/default_log_levels.h"
+
+
+namespace mmo
+{
+	BotLoginConnector::BotLoginConnector(asio::io_service& io)
+		: auth::Connector(std::make_unique<asio::ip::tcp::socket>(io), nullptr)
+		, m_ioService(io)
+	{
+	}
+
+	void BotLoginConnector::Connect(const std::string& host, const uint16 port, const std::string& accountName, const std::string& password)
+	{
+		ClearPacketHandlers();
+		m_realms.clear();
+
+		m_srp.emplace(accountName, password);
+		connect(host, port, *this, m_ioService);
+	}
+
+	bool BotLoginConnector::connectionEstablished(const bool success)
+	{
+		if (!success)
+		{
+			AuthenticationResult(auth::AuthResult::FailInvalidServer);
+			return true;
+		}
+
+		RegisterPacketHandler(auth::login_client_packet::LogonChallenge, *this, &BotLoginConnector::OnLogonChallenge);
+
+		sendSinglePacket([this](auth::OutgoingPacket& packet)
+		{
+			packet.Start(auth::client_login_packet::LogonChallenge);
+			packet
+				<< io::write<uint8>(mmo::Major)
+				<< io::write<uint8>(mmo::Minor)
+				<< io::write<uint8>(mmo::Build)
+				<< io::write<uint16>(mmo::Revision)
+				<< io::write<uint32>(auth::ProtocolVersion)
+				<< io::write<uint32>(game::ProtocolVersion)
+				<< io::write<uint32>(0x64654445)	// Locale: deDE
+				<< io::write_dynamic_range<uint8>(m_srp->GetAccountName());
+			packet.Finish();
+		});
+
+		return true;
+	}
+
+	void BotLoginConnector::connectionLost()
+	{
+		ClearPacketHandlers();
+	}
+
+	void BotLoginConnector::connectionMalformedPacket()
+	{
+		ELOG("[" << m_srp->GetAccountName() << "] Received a malformed packet from the login server");
+	}
+
+	PacketParseResult BotLoginConnector::connectionPacketReceived(auth::IncomingPacket& packet)
+	{
+		return HandleIncomingPacket(packet);
+	}
+
+	PacketParseResult BotLoginConnector::OnLogonChallenge(auth::IncomingPacket& packet)
+	{
+		ClearPacketHandler(auth::login_client_packet::LogonChallenge);
+
+		uint8 result = 0;
+		if (!(packet >> io::read<uint8>(result)))
+		{
+			return PacketParseResult::Disconnect;
+		}
+
+		if (result != auth::auth_result::Success)
+		{
+			AuthenticationResult(static_cast<auth::AuthResult>(result));
+			return PacketParseResult::Disconnect;
+		}
+
+		std::array<uint8, 32> B, N, s;
+		uint8 g = 0;
+		if (!(packet >> io::read_range(B) >> io::read<uint8>(g) >> io::read_range(N) >> io::read_range(s)))
+		{
+			return PacketParseResult::Disconnect;
+		}
+
+		const SrpProof proof = m_srp->CalculateProof(BigNumber(B.data(), B.size()), BigNumber(s.data(), s.size()));
+
+		RegisterPacketHandler(auth::login_client_packet::LogonProof, *this, &BotLoginConnector::OnLogonProof);
+
+		sendSinglePacket([&proof](auth::OutgoingPacket& outPacket)
+		{
+			outPacket.Start(auth::client_login_packet::LogonProof);
+			outPacket << io::write_range(proof.A) << io::write_range(proof.m1);
+			outPacket.Finish();
+		});
+
+		return PacketParseResult::Pass;
+	}
+
+	PacketParseResult BotLoginConnector::OnLogonProof(auth::IncomingPacket& packet)
+	{
+		ClearPacketHandler(auth::login_client_packet::LogonProof);
+
+		uint8 result = 0;
+		if (!(packet >> io::read<uint8>(result)))
+		{
+			return PacketParseResult::Disconnect;
+		}
+
+		if (result != auth::auth_result::Success)
+		{
+			AuthenticationResult(static_cast<auth::AuthResult>(result));
+			return PacketParseResult::Disconnect;
+		}
+
+		SHA1Hash serverM2;
+		if (!(packet >> io::read_range(serverM2)) || !m_srp->VerifyServerProof(serverM2))
+		{
+			AuthenticationResult(auth::AuthResult::FailInternalError);
+			return PacketParseResult::Disconnect;
+		}
+
+		RegisterPacketHandler(auth::login_client_packet::RealmList, *this, &BotLoginConnector::OnRealmList);
+		RegisterPacketHandler(auth::login_client_packet::AccountFeatures, *this, &BotLoginConnector::OnAccountFeatures);
+
+		AuthenticationResult(auth::AuthResult::Success);
+		return PacketParseResult::Pass;
+	}
+
+	PacketParseResult BotLoginConnector::OnRealmList(auth::IncomingPacket& packet)
+	{
+		m_realms.clear();
+
+		uint16 realmCount = 0;
+		if (!(packet >> io::read<uint16>(realmCount)))
+		{
+			return PacketParseResult::Disconnect;
+		}
+
+		for (uint16 i = 0; i < realmCount; ++i)
+		{
+			BotRealm realm;
+			if (!(packet
+				>> io::read<uint32>(realm.id)
+				>> io::read_container<uint8>(realm.name)
+				>> io::read_container<uint8>(realm.address)
+				>> io::read<uint16>(realm.port)))
+			{
+				return PacketParseResult::Disconnect;
+			}
+
+			m_realms.emplace_back(std::move(realm));
+		}
+
+		RealmListUpdated();
+		return PacketParseResult::Pass;
+	}
+
+	PacketParseResult BotLoginConnector::OnAccountFeatures(auth::IncomingPacket& packet)
+	{
+		// Bots don't care about account features, but the packet has to be accepted
+		return PacketParseResult::Pass;
+	}
+}
@@ -0,0 +1,77 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "auth_protocol/auth_connector.h"
+#include "auth_protocol/srp_client.h"
+#include "base/signal.h"
+
+#include "asio/io_service.hpp"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+
+namespace mmo
+{
+	/// Realm entry of the realm list sent by the login server.
+	struct BotRealm final
+	{
+		uint32 id;
+		std::string name;
+		std::string address;
+		uint16 port;
+	};
+
+	/// Minimal login server connector used by bots. Performs the SRP6-A login and requests the realm list.
+	class BotLoginConnector final
+		: public auth::Connector
+		, public auth::IConnectorListener
+	{
+	public:
+		/// Signal that is fired when the login attempt finished.
+		signal<void(auth::AuthResult)> AuthenticationResult;
+
+		/// Signal that is fired when the realm list has been received.
+		signal<void()> RealmListUpdated;
+
+	public:
+		explicit BotLoginConnector(asio::io_service& io);
+
+	public:
+		/// Connects to the login server and starts the login process with the given credentials.
+		void Connect(const std::string& host, uint16 port, const std::string& accountName, const std::string& password);
+
+		/// Gets the realms received from the login server.
+		const std::vector<BotRealm>& GetRealms() const { return m_realms; }
+
+		/// Gets the session key. Only valid after a successful login.
+		const BigNumber& GetSessionKey() const { return m_srp->GetSessionKey(); }
+
+		/// Gets the uppercase account name.
+		const std::string& GetAccountName() const { return m_srp->GetAccountName(); }
+
+	public:
+		// ~ Begin IConnectorListener
+		bool connectionEstablished(bool success) override;
+		void connectionLost() override;
+		void connectionMalformedPacket() override;
+		PacketParseResult connectionPacketReceived(auth::IncomingPacket& packet) override;
+		// ~ End IConnectorListener
+
+	private:
+		PacketParseResult OnLogonChallenge(auth::IncomingPacket& packet);
+
+		PacketParseResult OnLogonProof(auth::IncomingPacket& packet);
+
+		PacketParseResult OnRealmList(auth::IncomingPacket& packet);
+
+		PacketParseResult OnAccountFeatures(auth::IncomingPacket& packet);
+
+	private:
+		asio::io_service& m_ioService;
+		std::optional<SrpClient> m_srp;
+		std::vector<BotRealm> m_realms;
+	};
+}
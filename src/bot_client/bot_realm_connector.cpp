@@ -0,0 +1,290 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "bot_realm_connector.h"
+#include "load_stats.h"
+#include "version.h"
+
+#include "base/clock.h"
+#include "base/random.h"
+#include "base/sha1.h"
+#include "game/character_customization/customizable_avatar_definition.h"
+#include "game/movement_info.h"
+#include "game/spell_target_map.h"
+#include "log/default_log_levels.h"
+
+
+namespace mmo
+{
+	BotRealmConnector::BotRealmConnector(asio::io_service& io, LoadStats& stats)
+		: game::Connector(std::make_unique<asio::ip::tcp::socket>(io), nullptr)
+		, m_ioService(io)
+		, m_stats(stats)
+	{
+	}
+
+	void BotRealmConnector::Connect(const std::string& address, const uint16 port, const std::string& accountName, const BigNumber& sessionKey)
+	{
+		m_account = accountName;
+		m_sessionKey = sessionKey;
+
+		connect(address, port, *this, m_ioService);
+	}
+
+	void BotRealmConnector::CreateCharacter(const std::string& name, const uint8 race, const uint8 characterClass, const uint8 gender)
+	{
+		// The realm does not validate customization properties yet, so the default configuration is fine for bots
+		const AvatarConfiguration customization;
+
+		SendPacket([&](game::OutgoingPacket& packet)
+		{
+			packet.Start(game::client_realm_packet::CreateChar);
+			packet
+				<< io::write_dynamic_range<uint8>(name)
+				<< io::write<uint8>(race)
+				<< io::write<uint8>(characterClass)
+				<< io::write<uint8>(gender)
+				<< customization;
+			packet.Finish();
+		});
+	}
+
+	void BotRealmConnector::EnterWorld(const uint64 guid)
+	{
+		SendPacket([guid](game::OutgoingPacket& packet)
+		{
+			packet.Start(game::client_realm_packet::EnterWorld);
+			packet << io::write<uint64>(guid);
+			packet.Finish();
+		});
+	}
+
+	void BotRealmConnector::SendMovementUpdate(const uint64 characterId, const uint16 opCode, const MovementInfo& info)
+	{
+		SendPacket([characterId, opCode, &info](game::OutgoingPacket& packet)
+		{
+			packet.Start(opCode);
+			packet << io::write<uint64>(characterId) << info;
+			packet.Finish();
+		});
+	}
+
+	void BotRealmConnector::CastSpell(const uint32 spellId, const SpellTargetMap& targetMap)
+	{
+		SendPacket([spellId, &targetMap](game::OutgoingPacket& packet)
+		{
+			packet.Start(game::client_realm_packet::CastSpell);
+			packet << io::write<uint32>(spellId) << targetMap;
+			packet.Finish();
+		});
+	}
+
+	void BotRealmConnector::SendChatMessage(const std::string& message, const ChatType chatType)
+	{
+		SendPacket([&message, chatType](game::OutgoingPacket& packet)
+		{
+			packet.Start(game::client_realm_packet::ChatMessage);
+			packet
+				<< io::write<uint8>(chatType)
+				<< io::write_range(message) << io::write<uint8>(0);
+			packet.Finish();
+		});
+	}
+
+	void BotRealmConnector::SendTimePlayedRequest()
+	{
+		SendPacket([](game::OutgoingPacket& packet)
+		{
+			packet.Start(game::client_realm_packet::TimePlayedRequest);
+			packet.Finish();
+		});
+	}
+
+	bool BotRealmConnector::connectionEstablished(const bool success)
+	{
+		if (!success)
+		{
+			AuthenticationResult(game::auth_result::FailInvalidServer);
+			return true;
+		}
+
+		std::uniform_int_distribution<uint32> dist;
+		m_clientSeed = dist(RandomGenerator);
+
+		RegisterPacketHandler(game::realm_client_packet::AuthChallenge, *this, &BotRealmConnector::OnAuthChallenge);
+		return true;
+	}
+
+	void BotRealmConnector::connectionLost()
+	{
+		ClearPacketHandlers();
+		Disconnected();
+	}
+
+	void BotRealmConnector::connectionMalformedPacket()
+	{
+		ELOG("[" << m_account << "] Received a malformed packet from the realm");
+	}
+
+	PacketParseResult BotRealmConnector::connectionPacketReceived(game::IncomingPacket& packet)
+	{
+		return HandleIncomingPacket(packet);
+	}
+
+	PacketParseResult BotRealmConnector::HandleIncomingPacket(game::IncomingPacket& packet)
+	{
+		m_stats.RecordIncoming(packet.GetId(), packet.GetSize());
+
+		PacketHandler handler = nullptr;
+		{
+			std::scoped_lock lock{ m_packetHandlerMutex };
+
+			const auto it = m_packetHandlers.find(packet.GetId());
+			if (it == m_packetHandlers.end())
+			{
+				// Bots only react to a handful of packets, everything else is just counted
+				return PacketParseResult::Pass;
+			}
+
+			handler = it->second;
+		}
+
+		return handler(packet);
+	}
+
+	void BotRealmConnector::RecordOutgoing(const uint16 opCode, const uint32 size)
+	{
+		m_stats.RecordOutgoing(opCode, size);
+	}
+
+	PacketParseResult BotRealmConnector::OnAuthChallenge(game::IncomingPacket& packet)
+	{
+		ClearPacketHandler(game::realm_client_packet::AuthChallenge);
+
+		uint32 serverSeed = 0;
+		if (!(packet >> io::read<uint32>(serverSeed)))
+		{
+			return PacketParseResult::Disconnect;
+		}
+
+		HashGeneratorSha1 hashGen;
+		hashGen.update(m_account.data(), m_account.length());
+		hashGen.update(reinterpret_cast<const char*>(&m_clientSeed), sizeof(m_clientSeed));
+		hashGen.update(reinterpret_cast<const char*>(&serverSeed), sizeof(serverSeed));
+		Sha1_Add_BigNumbers(hashGen, { m_sessionKey });
+		const SHA1Hash hash = hashGen.finalize();
+
+		RegisterPacketHandler(game::realm_client_packet::AuthSessionResponse, *this, &BotRealmConnector::OnAuthSessionResponse);
+
+		SendPacket([this, &hash](game::OutgoingPacket& outPacket)
+		{
+			outPacket.Start(game::client_realm_packet::AuthSession);
+			outPacket
+				<< io::write<uint32>(mmo::Revision)
+				<< io::write_dynamic_range<uint8>(m_account)
+				<< io::write<uint32>(m_clientSeed)
+				<< io::write_range(hash);
+			outPacket.Finish();
+		});
+
+		return PacketParseResult::Pass;
+	}
+
+	PacketParseResult BotRealmConnector::OnAuthSessionResponse(game::IncomingPacket& packet)
+	{
+		ClearPacketHandler(game::realm_client_packet::AuthSessionResponse);
+
+		uint8 result = 0;
+		if (!(packet >> io::read<uint8>(result)))
+		{
+			return PacketParseResult::Disconnect;
+		}
+
+		AuthenticationResult(result);
+		if (result != game::auth_result::Success)
+		{
+			close();
+			return PacketParseResult::Pass;
+		}
+
+		// The AuthSessionResponse is the last unencrypted packet
+		HMACHash cryptKey;
+		game::Crypt::GenerateKey(cryptKey, m_sessionKey);
+
+		game::Crypt& crypt = GetCrypt();
+		crypt.SetKey(cryptKey.data(), cryptKey.size());
+		crypt.Init();
+
+		RegisterPacketHandler(game::realm_client_packet::CharEnum, *this, &BotRealmConnector::OnCharEnum);
+		RegisterPacketHandler(game::realm_client_packet::LoginVerifyWorld, *this, &BotRealmConnector::OnLoginVerifyWorld);
+		RegisterPacketHandler(game::realm_client_packet::EnterWorldFailed, *this, &BotRealmConnector::OnEnterWorldFailed);
+		RegisterPacketHandler(game::realm_client_packet::TimeSyncRequest, *this, &BotRealmConnector::OnTimeSyncRequest);
+
+		SendPacket([](game::OutgoingPacket& outPacket)
+		{
+			outPacket.Start(game::client_realm_packet::CharEnum);
+			outPacket.Finish();
+		});
+
+		return PacketParseResult::Pass;
+	}
+
+	PacketParseResult BotRealmConnector::OnCharEnum(game::IncomingPacket& packet)
+	{
+		m_characterViews.clear();
+		if (!(packet >> io::read_container<uint8>(m_characterViews)))
+		{
+			return PacketParseResult::Disconnect;
+		}
+
+		CharListUpdated();
+		return PacketParseResult::Pass;
+	}
+
+	PacketParseResult BotRealmConnector::OnLoginVerifyWorld(game::IncomingPacket& packet)
+	{
+		uint32 mapId = 0;
+		Vector3 position;
+		float facing = 0.0f;
+		if (!(packet >> io::read<uint32>(mapId)
+			>> io::read<float>(position.x)
+			>> io::read<float>(position.y)
+			>> io::read<float>(position.z)
+			>> io::read<float>(facing)))
+		{
+			return PacketParseResult::Disconnect;
+		}
+
+		VerifyNewWorld(mapId, position, facing);
+		return PacketParseResult::Pass;
+	}
+
+	PacketParseResult BotRealmConnector::OnEnterWorldFailed(game::IncomingPacket& packet)
+	{
+		uint8 response = 0;
+		packet >> io::read<uint8>(response);
+
+		ELOG("[" << m_account << "] Failed to enter world: " << static_cast<uint16>(response));
+		EnterWorldFailed();
+		return PacketParseResult::Pass;
+	}
+
+	PacketParseResult BotRealmConnector::OnTimeSyncRequest(game::IncomingPacket& packet)
+	{
+		uint32 syncIndex = 0;
+		if (!(packet >> io::read<uint32>(syncIndex)))
+		{
+			return PacketParseResult::Disconnect;
+		}
+
+		// Movement packets are rejected by the world node until the first time sync has been answered
+		const GameTime clientTimestamp = GetAsyncTimeMs();
+		SendPacket([syncIndex, clientTimestamp](game::OutgoingPacket& outPacket)
+		{
+			outPacket.Start(game::client_realm_packet::TimeSyncResponse);
+			outPacket << io::write<uint32>(syncIndex) << io::write<uint64>(clientTimestamp);
+			outPacket.Finish();
+		});
+
+		return PacketParseResult::Pass;
+	}
+}
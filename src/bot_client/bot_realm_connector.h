@@ -0,0 +1,117 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "game_protocol/game_connector.h"
+#include "base/big_number.h"
+#include "base/signal.h"
+#include "game/character_view.h"
+#include "game/chat_type.h"
+#include "math/vector3.h"
+
+#include "asio/io_service.hpp"
+
+#include <vector>
+
+
+namespace mmo
+{
+	class LoadStats;
+	class MovementInfo;
+	class SpellTargetMap;
+
+	/// Minimal realm connector used by bots. Unlike the game client's connector, packets without a registered handler
+	/// are accepted and ignored, and the size of every packet is recorded in the load statistics.
+	class BotRealmConnector final
+		: public game::Connector
+		, public game::IConnectorListener
+	{
+	public:
+		/// Signal that is fired when the realm answered the AuthSession packet.
+		signal<void(uint8)> AuthenticationResult;
+
+		/// Signal that is fired when a new character list has been received.
+		signal<void()> CharListUpdated;
+
+		/// Signal that is fired when the character entered a world node.
+		signal<void(uint32, Vector3, float)> VerifyNewWorld;
+
+		/// Signal that is fired when the character could not enter a world.
+		signal<void()> EnterWorldFailed;
+
+		/// Signal that is fired when the connection was lost.
+		signal<void()> Disconnected;
+
+	public:
+		BotRealmConnector(asio::io_service& io, LoadStats& stats);
+
+	public:
+		/// Connects to the given realm and authenticates using the session key received from the login server.
+		void Connect(const std::string& address, uint16 port, const std::string& accountName, const BigNumber& sessionKey);
+
+		/// Gets the characters of the account.
+		const std::vector<CharacterView>& GetCharacterViews() const { return m_characterViews; }
+
+		/// Sends a packet and records its size in the load statistics.
+		template<class F>
+		void SendPacket(F generator)
+		{
+			uint16 opCode = 0;
+			uint32 size = 0;
+			sendSinglePacket([&generator, &opCode, &size](game::OutgoingPacket& packet)
+			{
+				generator(packet);
+				opCode = packet.GetId();
+				size = packet.GetSize();
+			});
+
+			RecordOutgoing(opCode, size);
+		}
+
+		void CreateCharacter(const std::string& name, uint8 race, uint8 characterClass, uint8 gender);
+
+		void EnterWorld(uint64 guid);
+
+		void SendMovementUpdate(uint64 characterId, uint16 opCode, const MovementInfo& info);
+
+		void CastSpell(uint32 spellId, const SpellTargetMap& targetMap);
+
+		void SendChatMessage(const std::string& message, ChatType chatType);
+
+		void SendTimePlayedRequest();
+
+	public:
+		// ~ Begin IConnectorListener
+		bool connectionEstablished(bool success) override;
+		void connectionLost() override;
+		void connectionMalformedPacket() override;
+		PacketParseResult connectionPacketReceived(game::IncomingPacket& packet) override;
+		// ~ End IConnectorListener
+
+	protected:
+		PacketParseResult HandleIncomingPacket(game::IncomingPacket& packet) override;
+
+	private:
+		void RecordOutgoing(uint16 opCode, uint32 size);
+
+		PacketParseResult OnAuthChallenge(game::IncomingPacket& packet);
+
+		PacketParseResult OnAuthSessionResponse(game::IncomingPacket& packet);
+
+		PacketParseResult OnCharEnum(game::IncomingPacket& packet);
+
+		PacketParseResult OnLoginVerifyWorld(game::IncomingPacket& packet);
+
+		PacketParseResult OnEnterWorldFailed(game::IncomingPacket& packet);
+
+		PacketParseResult OnTimeSyncRequest(game::IncomingPacket& packet);
+
+	private:
+		asio::io_service& m_ioService;
+		LoadStats& m_stats;
+		std::string m_account;
+		BigNumber m_sessionKey;
+		uint32 m_clientSeed { 0 };
+		std::vector<CharacterView> m_characterViews;
+	};
+}
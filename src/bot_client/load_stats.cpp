@@ -0,0 +1,107 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "load_stats.h"
+
+#include "log/default_log_levels.h"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace mmo
+{
+	namespace
+	{
+		/// Gets the value at the given percentile (0..1) of a sample set. Reorders the samples.
+		float Percentile(std::vector<float>& samples, const double percentile)
+		{
+			const size_t index = std::min(samples.size() - 1, static_cast<size_t>(percentile * static_cast<double>(samples.size())));
+			std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+			return samples[index];
+		}
+	}
+
+	void LoadStats::RecordIncoming(const uint16 opCode, const uint32 bodySize)
+	{
+		for (Traffic* traffic : { &m_interval, &m_total })
+		{
+			Counter& counter = traffic->incoming[opCode];
+			++counter.packets;
+			counter.bytes += bodySize + PacketHeaderSize;
+		}
+	}
+
+	void LoadStats::RecordOutgoing(const uint16 opCode, const uint32 bodySize)
+	{
+		for (Traffic* traffic : { &m_interval, &m_total })
+		{
+			Counter& counter = traffic->outgoing[opCode];
+			++counter.packets;
+			counter.bytes += bodySize + PacketHeaderSize;
+		}
+	}
+
+	void LoadStats::RecordRoundTrip(const float milliseconds)
+	{
+		m_interval.roundTrips.push_back(milliseconds);
+		m_total.roundTrips.push_back(milliseconds);
+	}
+
+	void LoadStats::ReportInterval(const double intervalSeconds)
+	{
+		ILOG("---- Bots in world: " << m_botsInWorld << ", lost: " << m_botsLost << " ----");
+		Report(m_interval, intervalSeconds, false);
+
+		m_interval = Traffic();
+	}
+
+	void LoadStats::ReportTotal(const double totalSeconds) const
+	{
+		ILOG("==== Summary after " << totalSeconds << " s, bots in world: " << m_botsInWorld << ", lost: " << m_botsLost << " ====");
+		Report(m_total, totalSeconds, true);
+	}
+
+	void LoadStats::Report(const Traffic& traffic, const double seconds, const bool perOpCode)
+	{
+		if (seconds <= 0.0)
+		{
+			return;
+		}
+
+		uint64 packetsIn = 0, bytesIn = 0, packetsOut = 0, bytesOut = 0;
+		for (const auto& [opCode, counter] : traffic.incoming)
+		{
+			packetsIn += counter.packets;
+			bytesIn += counter.bytes;
+		}
+		for (const auto& [opCode, counter] : traffic.outgoing)
+		{
+			packetsOut += counter.packets;
+			bytesOut += counter.bytes;
+		}
+
+		ILOG("In:  " << static_cast<uint64>(packetsIn / seconds) << " packets/s, " << static_cast<uint64>(bytesIn / seconds / 1024.0) << " KiB/s");
+		ILOG("Out: " << static_cast<uint64>(packetsOut / seconds) << " packets/s, " << static_cast<uint64>(bytesOut / seconds / 1024.0) << " KiB/s");
+
+		if (!traffic.roundTrips.empty())
+		{
+			std::vector<float> samples = traffic.roundTrips;
+			ILOG("RTT: " << samples.size() << " samples, p50 " << Percentile(samples, 0.5) << " ms, p90 " << Percentile(samples, 0.9)
+				<< " ms, p99 " << Percentile(samples, 0.99) << " ms, max " << *std::max_element(samples.begin(), samples.end()) << " ms");
+		}
+
+		if (!perOpCode)
+		{
+			return;
+		}
+
+		for (const auto& [name, counters] : { std::make_pair("in", &traffic.incoming), std::make_pair("out", &traffic.outgoing) })
+		{
+			for (const auto& [opCode, counter] : *counters)
+			{
+				ILOG("  " << name << " 0x" << std::hex << std::setw(4) << std::setfill('0') << opCode << std::dec
+					<< ": " << counter.packets << " packets, " << counter.bytes << " bytes, "
+					<< counter.bytes / std::max<uint64>(counter.packets, 1) << " bytes avg");
+			}
+		}
+	}
+}
@@ -0,0 +1,66 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/non_copyable.h"
+#include "base/typedefs.h"
+
+#include <map>
+#include <vector>
+
+namespace mmo
+{
+	/// Collects traffic and latency statistics of all bots. Only used from the io thread, so no locking is required.
+	class LoadStats final : public NonCopyable
+	{
+	public:
+		/// Size of the game packet header (uint16 opcode + uint32 body size) which is added to every packet body.
+		static constexpr uint32 PacketHeaderSize = sizeof(uint16) + sizeof(uint32);
+
+	public:
+		/// Records a packet received from the server.
+		void RecordIncoming(uint16 opCode, uint32 bodySize);
+
+		/// Records a packet sent to the server.
+		void RecordOutgoing(uint16 opCode, uint32 bodySize);
+
+		/// Records a request/response round trip time in milliseconds.
+		void RecordRoundTrip(float milliseconds);
+
+		/// Records a bot that finished entering the world.
+		void RecordBotInWorld() { ++m_botsInWorld; }
+
+		/// Records a bot that left the world or failed to log in.
+		void RecordBotLost() { ++m_botsLost; }
+
+		/// Logs the statistics gathered since the previous report and starts a new interval.
+		/// @param intervalSeconds Length of the reported interval, used to calculate rates.
+		void ReportInterval(double intervalSeconds);
+
+		/// Logs the statistics gathered since the start of the run.
+		/// @param totalSeconds Duration of the run, used to calculate rates.
+		void ReportTotal(double totalSeconds) const;
+
+	private:
+		struct Counter
+		{
+			uint64 packets = 0;
+			uint64 bytes = 0;
+		};
+
+		struct Traffic
+		{
+			std::map<uint16, Counter> incoming;
+			std::map<uint16, Counter> outgoing;
+			std::vector<float> roundTrips;
+		};
+
+		static void Report(const Traffic& traffic, double seconds, bool perOpCode);
+
+	private:
+		Traffic m_interval;
+		Traffic m_total;
+		uint32 m_botsInWorld = 0;
+		uint32 m_botsLost = 0;
+	};
+}
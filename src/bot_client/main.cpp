@@ -0,0 +1,158 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "bot.h"
+#include "load_stats.h"
+
+#include "base/clock.h"
+#include "base/constants.h"
+#include "base/timer_queue.h"
+#include "log/default_log_levels.h"
+#include "log/log_std_stream.h"
+
+#include "cxxopts/cxxopts.hpp"
+#include "asio/io_service.hpp"
+
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace mmo
+{
+	/// Runs the load test. Bots are started one by one with the given ramp interval and statistics are reported
+	/// periodically until the run duration has elapsed.
+	///	@return 0 on success, 1 on failure. This should be thought of as the process exit code.
+	int32 run(const BotConfig& config, const uint32 botCount, const GameTime rampInterval, const GameTime duration, const GameTime reportInterval)
+	{
+		asio::io_service ioService;
+		TimerQueue timers{ ioService };
+		LoadStats stats;
+		BotEnvironment environment{ ioService, timers, config, stats, {} };
+
+		std::vector<std::unique_ptr<Bot>> bots;
+		bots.reserve(botCount);
+
+		const GameTime start = GetAsyncTimeMs();
+		for (uint32 i = 0; i < botCount; ++i)
+		{
+			timers.AddEvent([&environment, &bots, i]()
+			{
+				bots.push_back(std::make_unique<Bot>(environment, i));
+				bots.back()->Start();
+			}, start + i * rampInterval);
+		}
+
+		// Periodically report the statistics of the last interval
+		GameTime lastReport = start;
+		std::function<void()> report = [&]()
+		{
+			const GameTime now = GetAsyncTimeMs();
+			stats.ReportInterval(static_cast<double>(now - lastReport) / 1000.0);
+			lastReport = now;
+
+			if (now - start < duration)
+			{
+				timers.AddEvent(report, now + reportInterval);
+			}
+		};
+		timers.AddEvent(report, start + reportInterval);
+
+		timers.AddEvent([&ioService]() { ioService.stop(); }, start + duration);
+
+		ILOG("Starting " << botCount << " bots with one bot every " << rampInterval << " ms for " << duration / 1000 << " s");
+		ioService.run();
+
+		stats.ReportTotal(static_cast<double>(GetAsyncTimeMs() - start) / 1000.0);
+
+		// Destroy the bots while the io service still exists
+		bots.clear();
+
+		return 0;
+	}
+}
+
+/// Entry point of the bot client load generator.
+///	@param argc The number of command line arguments.
+///	@param argv The command line arguments.
+///	@return 0 on success, anything else on error.
+int main(int argc, char* argv[])
+{
+	auto logOptions = mmo::g_DefaultConsoleLogOptions;
+
+	std::mutex coutLogMutex;
+	mmo::g_DefaultLog.signal().connect([&coutLogMutex, &logOptions](const mmo::LogEntry& entry) {
+		std::scoped_lock lock{ coutLogMutex };
+		printLogEntry(std::cout, entry, logOptions);
+		});
+
+	mmo::BotConfig config;
+	config.loginPort = mmo::constants::DefaultLoginPlayerPort;
+
+	uint32_t botCount = 10;
+	uint32_t rampInterval = 100;
+	uint32_t duration = 300;
+	uint32_t reportInterval = 10;
+	std::string scenario = "mixed";
+	uint32_t race = config.race;
+	uint32_t characterClass = config.characterClass;
+
+	cxxopts::Options options("Bot Client, available options");
+	options.add_options()
+		("help", "produce help message")
+		("h,host", "login server host", cxxopts::value<std::string>(config.loginHost))
+		("p,port", "login server port", cxxopts::value<uint16_t>(config.loginPort))
+		("r,realm", "name of the realm to join, first realm if empty", cxxopts::value<std::string>(config.realmName))
+		("a,account-prefix", "accounts are named <prefix><n> with n starting at 1 and have to exist already", cxxopts::value<std::string>(config.accountPrefix))
+		("password", "password of all bot accounts", cxxopts::value<std::string>(config.password))
+		("n,count", "number of bots", cxxopts::value<uint32_t>(botCount))
+		("ramp", "delay between two bot logins in milliseconds", cxxopts::value<uint32_t>(rampInterval))
+		("d,duration", "duration of the run in seconds", cxxopts::value<uint32_t>(duration))
+		("report", "statistics report interval in seconds", cxxopts::value<uint32_t>(reportInterval))
+		("s,scenario", "bot behaviour: idle, walk, chat, combat or mixed", cxxopts::value<std::string>(scenario))
+		("spell", "spell id cast on other bots in the combat scenarios", cxxopts::value<uint32_t>(config.spellId))
+		("race", "race id of created characters", cxxopts::value<uint32_t>(race))
+		("class", "class id of created characters", cxxopts::value<uint32_t>(characterClass))
+		;
+
+	// Catch exceptions from command line argument parsing. This is a huge try-block because
+	// the cxxopts interface has no default constructor for parse results, thus the call to
+	// parse needs to stay valid this whole block.
+	try
+	{
+		cxxopts::ParseResult result = options.parse(argc, argv);
+
+		if (result.count("help"))
+		{
+			ILOG(options.help());
+			return 0;
+		}
+
+		static const std::map<std::string, mmo::BotScenario> scenarios = {
+			{ "idle", mmo::BotScenario::Idle },
+			{ "walk", mmo::BotScenario::Walk },
+			{ "chat", mmo::BotScenario::Chat },
+			{ "combat", mmo::BotScenario::Combat },
+			{ "mixed", mmo::BotScenario::Mixed }
+		};
+
+		const auto it = scenarios.find(scenario);
+		if (it == scenarios.end())
+		{
+			ELOG("Unknown scenario '" << scenario << "'");
+			return 1;
+		}
+
+		config.scenario = it->second;
+		config.race = static_cast<mmo::uint8>(race);
+		config.characterClass = static_cast<mmo::uint8>(characterClass);
+
+		return mmo::run(config, botCount, rampInterval, duration * 1000, std::max<uint32_t>(reportInterval, 1) * 1000);
+	}
+	catch (const cxxopts::OptionException& e)
+	{
+		ELOG(e.what());
+		return 1;
+	}
+}
@@ -0,0 +1,365 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+// CombatLogBuffer tests.
+//
+// Combat log events are collected per world tick and sent as one CombatLog packet per subscriber. These tests verify
+// the batching, the relevance radius and the encoding, and compare the traffic of a raid encounter with the previous
+// one packet per event and subscriber.
+
+#include "game_server/objects/game_player_s.h"
+#include "game_server/world/combat_log_buffer.h"
+#include "game_server/world/solid_visibility_grid.h"
+#include "game_server/world/tile_subscriber.h"
+#include "game_server/world/visibility_tile.h"
+#include "game/combat_log.h"
+#include "game_protocol/game_protocol.h"
+#include "binary_io/memory_source.h"
+#include "binary_io/reader.h"
+#include "binary_io/vector_sink.h"
+#include "base/timer_queue.h"
+#include "shared/proto_data/project.h"
+#include "asio/io_service.hpp"
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace mmo;
+
+namespace
+{
+	/// Records the packets a player in the world would receive.
+	struct RecordingSubscriber final : TileSubscriber
+	{
+		explicit RecordingSubscriber(GameUnitS& unit)
+			: unit(unit)
+		{
+		}
+
+		GameUnitS& GetGameUnit() const override { return unit; }
+		void NotifyObjectsUpdated(const std::vector<GameObjectS*>&) override {}
+		void NotifyObjectsSpawned(const std::vector<GameObjectS*>&) override {}
+		void NotifyObjectsDespawned(const std::vector<GameObjectS*>&) override {}
+		GameTime ClientToServerTime(const GameTime clientTimestamp) const override { return clientTimestamp; }
+		GameTime ServerToClientTime(const GameTime serverTimestamp) const override { return serverTimestamp; }
+		bool HasReceivedTimeSyncResponse() const override { return true; }
+		void SendPacket(game::Protocol::OutgoingPacket&, const std::vector<char>& buffer, bool) override { packets.push_back(buffer); }
+
+		/// Decodes the events of all received CombatLog packets.
+		std::vector<CombatLogEvent> ReadEvents() const
+		{
+			std::vector<CombatLogEvent> events;
+			for (const std::vector<char>& packet : packets)
+			{
+				// Skip the packet id and size
+				io::MemorySource source(packet.data() + 6, packet.data() + packet.size());
+				io::Reader reader(source);
+
+				uint32 count = 0;
+				REQUIRE(reader >> io::read_var_uint(count));
+				for (uint32 i = 0; i < count; ++i)
+				{
+					CombatLogEvent event;
+					REQUIRE(reader >> event);
+					events.push_back(event);
+				}
+
+				CHECK(source.end());
+			}
+
+			return events;
+		}
+
+		GameUnitS& unit;
+		std::vector<std::vector<char>> packets;
+	};
+
+	struct CombatLogFixture
+	{
+		asio::io_service io;
+		TimerQueue timers{ io };
+		proto::Project project;
+		SolidVisibilityGrid grid{ makeVector(64, 64) };
+		CombatLogBuffer combatLog{ grid };
+		uint64 nextGuid = 1;
+
+		std::vector<std::shared_ptr<GamePlayerS>> units;
+		std::vector<std::unique_ptr<RecordingSubscriber>> subscribers;
+
+		~CombatLogFixture()
+		{
+			for (const auto& subscriber : subscribers)
+			{
+				Tile(subscriber->unit.GetPosition()).GetWatchers().remove(subscriber.get());
+			}
+		}
+
+		VisibilityTile& Tile(const Vector3& position)
+		{
+			TileIndex2D tileIndex;
+			REQUIRE(grid.GetTilePosition(position, tileIndex[0], tileIndex[1]));
+			return grid.RequireTile(tileIndex);
+		}
+
+		GamePlayerS& AddUnit(const Vector3& position)
+		{
+			auto unit = std::make_shared<GamePlayerS>(project, timers);
+			unit->Initialize();
+			unit->Set<uint64>(object_fields::Guid, nextGuid++);
+			unit->Relocate(position, Radian(0.0f));
+			units.push_back(unit);
+			return *unit;
+		}
+
+		RecordingSubscriber& AddPlayer(const Vector3& position)
+		{
+			subscribers.push_back(std::make_unique<RecordingSubscriber>(AddUnit(position)));
+			Tile(position).GetWatchers().add(subscribers.back().get());
+			return *subscribers.back();
+		}
+	};
+
+	CombatLogEvent MakeSwing(const GameUnitS& attacker, const GameUnitS& victim, const uint32 damage)
+	{
+		CombatLogEvent event;
+		event.type = combat_log_event::AttackerStateUpdate;
+		event.sourceGuid = attacker.GetGuid();
+		event.targetGuid = victim.GetGuid();
+		event.flags = 2;
+		event.victimState = 1;
+		event.amount = damage;
+		return event;
+	}
+
+	CombatLogEvent MakePeriodicTick(const GameUnitS& caster, const GameUnitS& target, const uint32 amount)
+	{
+		CombatLogEvent event;
+		event.type = combat_log_event::PeriodicAura;
+		event.sourceGuid = caster.GetGuid();
+		event.targetGuid = target.GetGuid();
+		event.spellId = 589;
+		event.subType = 3;
+		event.amount = amount;
+		return event;
+	}
+
+	/// Encodes a melee swing like the AttackerStateUpdate packet which was sent per event before batching.
+	std::vector<char> WriteLegacySwing(const CombatLogEvent& event)
+	{
+		std::vector<char> buffer;
+		io::VectorSink sink(buffer);
+		game::Protocol::OutgoingPacket packet(sink);
+		packet.Start(game::realm_client_packet::AttackerStateUpdate);
+		packet
+			<< io::write_packed_guid(event.sourceGuid)
+			<< io::write_packed_guid(event.targetGuid)
+			<< io::write<uint32>(event.flags)
+			<< io::write<uint32>(event.victimState)
+			<< io::write<uint32>(event.amount)
+			<< io::write<uint32>(event.school)
+			<< io::write<uint32>(event.absorbed)
+			<< io::write<uint32>(event.resisted)
+			<< io::write<uint32>(event.blocked);
+		packet.Finish();
+		return buffer;
+	}
+
+	/// Encodes a periodic damage tick like the PeriodicAuraLog packet which was sent per event before batching.
+	std::vector<char> WriteLegacyPeriodicTick(const CombatLogEvent& event)
+	{
+		std::vector<char> buffer;
+		io::VectorSink sink(buffer);
+		game::Protocol::OutgoingPacket packet(sink);
+		packet.Start(game::realm_client_packet::PeriodicAuraLog);
+		packet
+			<< io::write_packed_guid(event.targetGuid)
+			<< io::write_packed_guid(event.sourceGuid)
+			<< io::write<uint32>(event.spellId)
+			<< io::write<uint32>(event.subType)
+			<< io::write<uint32>(event.amount)
+			<< io::write<uint32>(event.school)
+			<< io::write<uint32>(0)
+			<< io::write<uint32>(0);
+		packet.Finish();
+		return buffer;
+	}
+}
+
+TEST_CASE("Events of a tick are sent as one packet per subscriber", "[combat_log]")
+{
+	CombatLogFixture f;
+	RecordingSubscriber& first = f.AddPlayer(Vector3(0.0f, 0.0f, 0.0f));
+	RecordingSubscriber& second = f.AddPlayer(Vector3(5.0f, 0.0f, 0.0f));
+	const GamePlayerS& boss = f.AddUnit(Vector3(2.0f, 0.0f, 2.0f));
+
+	f.combatLog.Add(boss, MakeSwing(first.unit, boss, 120));
+	f.combatLog.Add(boss, MakeSwing(second.unit, boss, 80));
+	f.combatLog.Add(boss, MakePeriodicTick(first.unit, boss, 300000));
+
+	CHECK(f.combatLog.GetPendingSubscriberCount() == 2);
+	CHECK(first.packets.empty());
+
+	f.combatLog.Flush();
+	CHECK(f.combatLog.GetPendingSubscriberCount() == 0);
+	REQUIRE(first.packets.size() == 1);
+	REQUIRE(second.packets.size() == 1);
+
+	const std::vector<CombatLogEvent> events = second.ReadEvents();
+	REQUIRE(events.size() == 3);
+	CHECK(events[0].type == combat_log_event::AttackerStateUpdate);
+	CHECK(events[0].sourceGuid == first.unit.GetGuid());
+	CHECK(events[0].targetGuid == boss.GetGuid());
+	CHECK(events[0].flags == 2);
+	CHECK(events[0].victimState == 1);
+	CHECK(events[0].amount == 120);
+	CHECK(events[1].amount == 80);
+	CHECK(events[2].type == combat_log_event::PeriodicAura);
+	CHECK(events[2].spellId == 589);
+	CHECK(events[2].subType == 3);
+	CHECK(events[2].amount == 300000);
+
+	// Nothing happened since the last flush
+	f.combatLog.Flush();
+	CHECK(first.packets.size() == 1);
+	CHECK(f.combatLog.GetCounters().packets == 2);
+}
+
+TEST_CASE("Uninvolved subscribers outside of the relevance radius don't receive events", "[combat_log]")
+{
+	CombatLogFixture f;
+	RecordingSubscriber& attacker = f.AddPlayer(Vector3(0.0f, 0.0f, 0.0f));
+	RecordingSubscriber& nearby = f.AddPlayer(Vector3(10.0f, 0.0f, 0.0f));
+	RecordingSubscriber& distant = f.AddPlayer(Vector3(80.0f, 0.0f, 0.0f));
+	const GamePlayerS& victim = f.AddUnit(Vector3(70.0f, 0.0f, 0.0f));
+
+	// The event happens at the victim, which is far away from the attacker
+	f.combatLog.Add(victim, MakeSwing(attacker.unit, victim, 10));
+	f.combatLog.Flush();
+
+	CHECK(attacker.packets.size() == 1);
+	CHECK(nearby.packets.empty());
+	CHECK(distant.packets.size() == 1);
+	CHECK(f.combatLog.GetCounters().irrelevant == 1);
+}
+
+TEST_CASE("Private events are only sent to their subscriber", "[combat_log]")
+{
+	CombatLogFixture f;
+	RecordingSubscriber& player = f.AddPlayer(Vector3(0.0f, 0.0f, 0.0f));
+	RecordingSubscriber& other = f.AddPlayer(Vector3(1.0f, 0.0f, 0.0f));
+
+	CombatLogEvent event;
+	event.type = combat_log_event::EnvironmentalDamage;
+	event.targetGuid = player.unit.GetGuid();
+	event.amount = 55;
+	event.subType = 2;
+	f.combatLog.Add(player, event);
+	f.combatLog.Flush();
+
+	CHECK(other.packets.empty());
+	const std::vector<CombatLogEvent> events = player.ReadEvents();
+	REQUIRE(events.size() == 1);
+	CHECK(events[0].type == combat_log_event::EnvironmentalDamage);
+	CHECK(events[0].amount == 55);
+	CHECK(events[0].subType == 2);
+}
+
+TEST_CASE("Removed subscribers don't receive their pending events", "[combat_log]")
+{
+	CombatLogFixture f;
+	RecordingSubscriber& leaving = f.AddPlayer(Vector3(0.0f, 0.0f, 0.0f));
+	RecordingSubscriber& staying = f.AddPlayer(Vector3(1.0f, 0.0f, 0.0f));
+
+	f.combatLog.Add(staying.unit, MakeSwing(leaving.unit, staying.unit, 10));
+	f.combatLog.RemoveSubscriber(leaving);
+	f.combatLog.Flush();
+
+	CHECK(leaving.packets.empty());
+	CHECK(staying.packets.size() == 1);
+}
+
+TEST_CASE("Benchmark combat log traffic of a raid encounter", "[combat_log][!benchmark]")
+{
+	CombatLogFixture f;
+
+	// 40 players around a boss, each swinging or casting every 1.5 seconds and keeping a damage over time effect
+	// ticking every 3 seconds. The boss swings at its target every 2 seconds.
+	constexpr size_t playerCount = 40;
+	constexpr uint32 ticksPerSecond = 20;
+	constexpr uint32 seconds = 30;
+
+	const GamePlayerS& boss = f.AddUnit(Vector3(0.0f, 0.0f, 0.0f));
+	for (size_t i = 0; i < playerCount; ++i)
+	{
+		const float angle = static_cast<float>(i) / static_cast<float>(playerCount) * 6.2831853f;
+		const float distance = (i % 2 == 0) ? 4.0f : 25.0f;
+		f.AddPlayer(Vector3(std::cos(angle) * distance, 0.0f, std::sin(angle) * distance));
+	}
+
+	// Every event used to be sent as its own packet to every subscriber in sight
+	size_t legacyPackets = 0;
+	size_t legacyBytes = 0;
+	const size_t subscriberCount = f.subscribers.size();
+	const auto sendLegacy = [&](const std::vector<char>& packet)
+	{
+		legacyPackets += subscriberCount;
+		legacyBytes += subscriberCount * packet.size();
+	};
+
+	for (uint32 tick = 0; tick < ticksPerSecond * seconds; ++tick)
+	{
+		for (size_t i = 0; i < playerCount; ++i)
+		{
+			const GameUnitS& player = f.subscribers[i]->unit;
+
+			// Spread the actions of the players over the ticks
+			if ((tick + i) % (ticksPerSecond * 3 / 2) == 0)
+			{
+				const CombatLogEvent event = MakeSwing(player, boss, 1500 + static_cast<uint32>(i));
+				f.combatLog.Add(boss, event);
+				sendLegacy(WriteLegacySwing(event));
+			}
+
+			if ((tick + i * 7) % (ticksPerSecond * 3) == 0)
+			{
+				const CombatLogEvent event = MakePeriodicTick(player, boss, 900);
+				f.combatLog.Add(boss, event);
+				sendLegacy(WriteLegacyPeriodicTick(event));
+			}
+		}
+
+		if (tick % (ticksPerSecond * 2) == 0)
+		{
+			const GameUnitS& tank = f.subscribers.front()->unit;
+			const CombatLogEvent event = MakeSwing(boss, tank, 12000);
+			f.combatLog.Add(tank, event);
+			sendLegacy(WriteLegacySwing(event));
+		}
+
+		f.combatLog.Flush();
+	}
+
+	// Count what the subscribers actually received
+	size_t batchedPackets = 0;
+	size_t batchedBytes = 0;
+	for (const auto& subscriber : f.subscribers)
+	{
+		batchedPackets += subscriber->packets.size();
+		for (const std::vector<char>& packet : subscriber->packets)
+		{
+			batchedBytes += packet.size();
+		}
+	}
+
+	const CombatLogBuffer::Counters& counters = f.combatLog.GetCounters();
+	CHECK(counters.packets == batchedPackets);
+	CHECK(counters.bytes == batchedBytes);
+
+	WARN("Per second, legacy: " << legacyPackets / seconds << " packets, " << legacyBytes / seconds << " bytes; batched: "
+		<< batchedPackets / seconds << " packets, " << batchedBytes / seconds << " bytes ("
+		<< counters.events / seconds << " events, " << counters.irrelevant / seconds << " skipped deliveries)");
+
+	CHECK(batchedPackets < legacyPackets);
+	CHECK(batchedBytes < legacyBytes);
+}
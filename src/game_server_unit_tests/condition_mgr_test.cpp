@@ -0,0 +1,402 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+// ConditionMgr tests.
+//
+// Conditions are compiled when the condition manager is created. These tests verify that the compiled conditions
+// give the same results as interpreting the condition data, that memoized results follow level and class changes
+// and compare the evaluation speed of both.
+
+#include "game_server/condition_mgr.h"
+#include "game_server/objects/game_player_s.h"
+#include "base/timer_queue.h"
+#include "shared/proto_data/project.h"
+#include "asio/io_service.hpp"
+
+#include "catch.hpp"
+
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace mmo;
+
+namespace
+{
+	/// Evaluates a condition by walking the condition data, like the condition manager did before conditions were
+	/// compiled.
+	bool InterpretCondition(const proto::ConditionManager& data, GamePlayerS& player, const uint32 conditionId)
+	{
+		const auto* cond = data.getById(conditionId);
+		if (!cond)
+		{
+			return false;
+		}
+
+		bool subResult = true;
+		if (!cond->subconditionids().empty())
+		{
+			switch (cond->logicoperator())
+			{
+			case proto::Condition_LogicOperator_AND:
+				for (const auto subId : cond->subconditionids())
+				{
+					if (!InterpretCondition(data, player, subId))
+					{
+						subResult = false;
+						break;
+					}
+				}
+				break;
+			case proto::Condition_LogicOperator_OR:
+				subResult = false;
+				for (const auto subId : cond->subconditionids())
+				{
+					if (InterpretCondition(data, player, subId))
+					{
+						subResult = true;
+						break;
+					}
+				}
+				break;
+			default:
+				break;
+			}
+		}
+
+		if (cond->conditiontype() == proto::Condition_ConditionType_NONE_TYPE)
+		{
+			return subResult;
+		}
+
+		bool selfResult = false;
+		switch (cond->conditiontype())
+		{
+		case proto::Condition_ConditionType_CLASS_CHECK:
+			selfResult = (player.GetClassEntry()->id() == cond->param1());
+			break;
+		case proto::Condition_ConditionType_LEVEL_CHECK:
+		{
+			const uint32 maxLevel = (cond->param2() == 0) ? 255 : cond->param2();
+			selfResult = player.GetLevel() >= cond->param1() && player.GetLevel() <= maxLevel;
+			break;
+		}
+		case proto::Condition_ConditionType_QUEST_CHECK:
+			selfResult = player.GetQuestStatus(cond->param1()) == cond->param2();
+			break;
+		default:
+			break;
+		}
+
+		return subResult && selfResult;
+	}
+
+	struct ConditionFixture
+	{
+		asio::io_service io;
+		TimerQueue timers{ io };
+		proto::Project project;
+		std::shared_ptr<GamePlayerS> player;
+
+		ConditionFixture()
+		{
+			for (uint32 classId = 1; classId <= 2; ++classId)
+			{
+				auto* cls = project.classes.add(classId);
+				cls->set_powertype(proto::ClassEntry_PowerType_MANA);
+				for (uint32 i = 0; i < 60; ++i)
+				{
+					auto* values = cls->add_levelbasevalues();
+					values->set_health(100);
+					values->set_mana(100);
+				}
+			}
+
+			project.races.add(1);
+
+			for (uint32 questId = 1; questId <= 4; ++questId)
+			{
+				auto* quest = project.quests.add(questId);
+				quest->set_name("Quest");
+				auto* req = quest->add_requirements();
+				req->set_creatureid(1);
+				req->set_creaturecount(1);
+			}
+
+			player = std::make_shared<GamePlayerS>(project, timers);
+			player->Initialize();
+			player->SetClass(*project.classes.getById(1));
+			player->SetRace(*project.races.getById(1));
+			player->SetLevel(1);
+		}
+
+		proto::Condition& Add(const uint32 id, const proto::Condition_ConditionType type, const uint32 param1 = 0, const uint32 param2 = 0)
+		{
+			auto* cond = project.conditions.add(id);
+			cond->set_name("Condition");
+			cond->set_conditiontype(type);
+			cond->set_param1(param1);
+			cond->set_param2(param2);
+			return *cond;
+		}
+
+		proto::Condition& AddGroup(const uint32 id, const proto::Condition_LogicOperator logic, const std::vector<uint32>& subConditions, const proto::Condition_ConditionType type = proto::Condition_ConditionType_NONE_TYPE, const uint32 param1 = 0, const uint32 param2 = 0)
+		{
+			proto::Condition& cond = Add(id, type, param1, param2);
+			cond.set_logicoperator(logic);
+			for (const uint32 subId : subConditions)
+			{
+				cond.add_subconditionids(subId);
+			}
+
+			return cond;
+		}
+	};
+}
+
+TEST_CASE("Compiled conditions check class, level and quest status", "[condition_mgr]")
+{
+	ConditionFixture f;
+	f.Add(1, proto::Condition_ConditionType_CLASS_CHECK, 1);
+	f.Add(2, proto::Condition_ConditionType_CLASS_CHECK, 2);
+	f.Add(3, proto::Condition_ConditionType_LEVEL_CHECK, 1, 10);
+	f.Add(4, proto::Condition_ConditionType_LEVEL_CHECK, 5);
+	f.Add(5, proto::Condition_ConditionType_QUEST_CHECK, 1, quest_status::Incomplete);
+	f.AddGroup(6, proto::Condition_LogicOperator_AND, { 1, 3 });
+	f.AddGroup(7, proto::Condition_LogicOperator_OR, { 2, 4 });
+	f.AddGroup(8, proto::Condition_LogicOperator_AND, { 6, 5 });
+	f.AddGroup(9, proto::Condition_LogicOperator_NONE_OPERATOR, { 2 });
+
+	const ConditionMgr conditions(f.project.conditions);
+	GamePlayerS& player = *f.player;
+
+	CHECK(conditions.PlayerMeetsCondition(player, 1));
+	CHECK_FALSE(conditions.PlayerMeetsCondition(player, 2));
+	CHECK(conditions.PlayerMeetsCondition(player, 3));
+	CHECK_FALSE(conditions.PlayerMeetsCondition(player, 4));
+	CHECK_FALSE(conditions.PlayerMeetsCondition(player, 5));
+	CHECK(conditions.PlayerMeetsCondition(player, 6));
+	CHECK_FALSE(conditions.PlayerMeetsCondition(player, 7));
+	CHECK_FALSE(conditions.PlayerMeetsCondition(player, 8));
+
+	// Sub-conditions without an operator are ignored
+	CHECK(conditions.PlayerMeetsCondition(player, 9));
+
+	CHECK_FALSE(conditions.PlayerMeetsCondition(player, 100));
+
+	// Quest checks are evaluated live
+	REQUIRE(player.AcceptQuest(1));
+	CHECK(conditions.PlayerMeetsCondition(player, 5));
+	CHECK(conditions.PlayerMeetsCondition(player, 8));
+}
+
+TEST_CASE("Memoized condition results follow level and class changes", "[condition_mgr]")
+{
+	ConditionFixture f;
+	f.Add(1, proto::Condition_ConditionType_CLASS_CHECK, 1);
+	f.Add(2, proto::Condition_ConditionType_LEVEL_CHECK, 1, 10);
+	f.AddGroup(3, proto::Condition_LogicOperator_AND, { 1, 2 });
+
+	const ConditionMgr conditions(f.project.conditions);
+	GamePlayerS& player = *f.player;
+
+	CHECK(conditions.PlayerMeetsCondition(player, 3));
+	CHECK(conditions.PlayerMeetsCondition(player, 3));
+
+	player.SetLevel(11);
+	CHECK_FALSE(conditions.PlayerMeetsCondition(player, 3));
+
+	player.SetLevel(10);
+	CHECK(conditions.PlayerMeetsCondition(player, 3));
+
+	player.SetClass(*f.project.classes.getById(2));
+	CHECK_FALSE(conditions.PlayerMeetsCondition(player, 3));
+
+	// Results of another condition manager are not mixed up with the memoized ones
+	f.project.conditions.getById(1)->set_param1(2);
+	const ConditionMgr changed(f.project.conditions);
+	CHECK(changed.PlayerMeetsCondition(player, 3));
+	CHECK_FALSE(conditions.PlayerMeetsCondition(player, 3));
+}
+
+TEST_CASE("Constant conditions are folded", "[condition_mgr]")
+{
+	ConditionFixture f;
+	f.Add(1, proto::Condition_ConditionType_LEVEL_CHECK, 10, 5);
+	f.Add(2, proto::Condition_ConditionType_CLASS_CHECK, 1);
+	f.AddGroup(3, proto::Condition_LogicOperator_AND, { 2, 1 });
+	f.AddGroup(4, proto::Condition_LogicOperator_OR, { 1, 2 });
+	f.AddGroup(5, proto::Condition_LogicOperator_OR, { 1, 99 });
+	f.AddGroup(6, proto::Condition_LogicOperator_AND, { 2, 7 });
+	f.AddGroup(7, proto::Condition_LogicOperator_AND, { 6 });
+	f.AddGroup(8, proto::Condition_LogicOperator_OR, { 1 }, proto::Condition_ConditionType_CLASS_CHECK, 1);
+	f.AddGroup(9, proto::Condition_LogicOperator_AND, { 4 }, proto::Condition_ConditionType_LEVEL_CHECK, 1, 10);
+
+	const ConditionMgr conditions(f.project.conditions);
+	GamePlayerS& player = *f.player;
+
+	// The always and never nodes, the class check and the level check of condition 9
+	CHECK(conditions.GetNodeCount() == 4);
+
+	CHECK_FALSE(conditions.PlayerMeetsCondition(player, 1));
+	CHECK_FALSE(conditions.PlayerMeetsCondition(player, 3));
+	CHECK(conditions.PlayerMeetsCondition(player, 4));
+
+	// Missing sub-conditions are never met
+	CHECK_FALSE(conditions.PlayerMeetsCondition(player, 5));
+
+	// Cyclic conditions are never met
+	CHECK_FALSE(conditions.PlayerMeetsCondition(player, 6));
+	CHECK_FALSE(conditions.PlayerMeetsCondition(player, 7));
+
+	// None of the alternatives can be met
+	CHECK_FALSE(conditions.PlayerMeetsCondition(player, 8));
+
+	CHECK(conditions.PlayerMeetsCondition(player, 9));
+}
+
+TEST_CASE("References closing a condition cycle are never met", "[condition_mgr]")
+{
+	ConditionFixture f;
+	f.Add(1, proto::Condition_ConditionType_CLASS_CHECK, 1);
+	f.AddGroup(2, proto::Condition_LogicOperator_OR, { 1, 3 });
+	f.AddGroup(3, proto::Condition_LogicOperator_AND, { 2 });
+
+	const ConditionMgr conditions(f.project.conditions);
+	GamePlayerS& player = *f.player;
+
+	// Condition 2 is compiled first, so its reference to condition 3 closes the cycle and condition 3 folds to false
+	CHECK(conditions.PlayerMeetsCondition(player, 2));
+	CHECK_FALSE(conditions.PlayerMeetsCondition(player, 3));
+
+	// The interpreter short-circuits on the class check before it reaches the cycle and meets both conditions
+	CHECK(InterpretCondition(f.project.conditions, player, 2));
+	CHECK(InterpretCondition(f.project.conditions, player, 3));
+}
+
+TEST_CASE("Compiled conditions match the interpreted condition data", "[condition_mgr]")
+{
+	ConditionFixture f;
+
+	// Random condition trees, where groups only reference conditions with lower ids so that there are no cycles
+	std::mt19937 rng(4711);
+	constexpr uint32 conditionCount = 300;
+	for (uint32 id = 1; id <= conditionCount; ++id)
+	{
+		const uint32 kind = (id <= 20) ? rng() % 4 : rng() % 7;
+		switch (kind)
+		{
+		case 0:
+			f.Add(id, proto::Condition_ConditionType_CLASS_CHECK, 1 + rng() % 2);
+			break;
+		case 1:
+			f.Add(id, proto::Condition_ConditionType_LEVEL_CHECK, rng() % 30, rng() % 40);
+			break;
+		case 2:
+			f.Add(id, proto::Condition_ConditionType_QUEST_CHECK, 1 + rng() % 4, rng() % 5);
+			break;
+		case 3:
+			f.Add(id, static_cast<proto::Condition_ConditionType>(0));
+			break;
+		default:
+		{
+			std::vector<uint32> subConditions;
+			const uint32 subCount = rng() % 4;
+			for (uint32 i = 0; i < subCount; ++i)
+			{
+				// Occasionally reference a condition which does not exist
+				subConditions.push_back((rng() % 20 == 0) ? conditionCount + 1 : 1 + rng() % (id - 1));
+			}
+
+			const auto logic = static_cast<proto::Condition_LogicOperator>(rng() % 3);
+			const auto type = static_cast<proto::Condition_ConditionType>(rng() % 4);
+			uint32 param1 = rng() % 30;
+			if (type == proto::Condition_ConditionType_CLASS_CHECK)
+			{
+				param1 = 1 + param1 % 2;
+			}
+			else if (type == proto::Condition_ConditionType_QUEST_CHECK)
+			{
+				param1 = 1 + param1 % 4;
+			}
+
+			f.AddGroup(id, logic, subConditions, type, param1, rng() % 40);
+			break;
+		}
+		}
+	}
+
+	const ConditionMgr conditions(f.project.conditions);
+	GamePlayerS& player = *f.player;
+
+	for (uint32 round = 0; round < 50; ++round)
+	{
+		player.SetClass(*f.project.classes.getById(1 + rng() % 2));
+		player.SetLevel(1 + rng() % 40);
+		if (rng() % 2 == 0)
+		{
+			player.AcceptQuest(1 + rng() % 4);
+		}
+		else
+		{
+			player.AbandonQuest(1 + rng() % 4);
+		}
+
+		for (uint32 id = 1; id <= conditionCount + 1; ++id)
+		{
+			INFO("Condition " << id << " in round " << round);
+			REQUIRE(conditions.PlayerMeetsCondition(player, id) == InterpretCondition(f.project.conditions, player, id));
+		}
+	}
+}
+
+TEST_CASE("Benchmark condition evaluations", "[condition_mgr][!benchmark]")
+{
+	ConditionFixture f;
+
+	// The gossip menus and vendor lists of a quest hub: each option is shown to some classes in a level range, or
+	// after a quest was done
+	constexpr uint32 optionCount = 50;
+	uint32 nextId = 1;
+	std::vector<uint32> options;
+	for (uint32 i = 0; i < optionCount; ++i)
+	{
+		const uint32 classCheck = nextId++;
+		f.Add(classCheck, proto::Condition_ConditionType_CLASS_CHECK, 1 + i % 2);
+		const uint32 levelCheck = nextId++;
+		f.Add(levelCheck, proto::Condition_ConditionType_LEVEL_CHECK, i % 10, 20 + i % 30);
+		const uint32 classGroup = nextId++;
+		f.AddGroup(classGroup, proto::Condition_LogicOperator_AND, { classCheck, levelCheck });
+		const uint32 questCheck = nextId++;
+		f.Add(questCheck, proto::Condition_ConditionType_QUEST_CHECK, 1 + i % 4, quest_status::Rewarded);
+		const uint32 option = nextId++;
+		f.AddGroup(option, proto::Condition_LogicOperator_OR, { classGroup, questCheck });
+		options.push_back(option);
+	}
+
+	const ConditionMgr conditions(f.project.conditions);
+	GamePlayerS& player = *f.player;
+	player.SetLevel(15);
+
+	constexpr uint32 rounds = 20000;
+	const auto measure = [&](const auto& evaluate)
+	{
+		uint32 met = 0;
+		const auto start = std::chrono::steady_clock::now();
+		for (uint32 round = 0; round < rounds; ++round)
+		{
+			for (const uint32 option : options)
+			{
+				met += evaluate(option) ? 1 : 0;
+			}
+		}
+
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		return std::make_pair(met, static_cast<double>(rounds * optionCount) / seconds);
+	};
+
+	const auto interpreted = measure([&](const uint32 id) { return InterpretCondition(f.project.conditions, player, id); });
+	const auto compiled = measure([&](const uint32 id) { return conditions.PlayerMeetsCondition(player, id); });
+
+	WARN("Interpreted: " << static_cast<uint64>(interpreted.second) << " evaluations/s, compiled: " << static_cast<uint64>(compiled.second) << " evaluations/s");
+	CHECK(interpreted.first == compiled.first);
+}
@@ -0,0 +1,180 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+// GameCreatureS memory footprint tests.
+//
+// Idle creatures share the spell set of their unit entry and only allocate a unit mover and cooldown storage once
+// they need them. These tests verify the sharing semantics and report the heap bytes per idle creature.
+
+#include "game_server/objects/game_creature_s.h"
+#include "game_server/world/regular_update.h"
+
+#include "world_fixture.h"
+#include "catch.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+using namespace mmo;
+
+namespace
+{
+	/// Bytes currently allocated through the global operator new of this test executable.
+	std::atomic<int64> s_liveHeapBytes { 0 };
+
+	/// Every allocation stores its size in front of the returned memory, so that deletes can be counted too.
+	constexpr size_t AllocationHeaderSize = 16;
+}
+
+void* operator new(const size_t size)
+{
+	void* memory = std::malloc(size + AllocationHeaderSize);
+	if (!memory)
+	{
+		throw std::bad_alloc();
+	}
+
+	*static_cast<size_t*>(memory) = size;
+	s_liveHeapBytes += static_cast<int64>(size);
+	return static_cast<char*>(memory) + AllocationHeaderSize;
+}
+
+void operator delete(void* pointer) noexcept
+{
+	if (!pointer)
+	{
+		return;
+	}
+
+	void* memory = static_cast<char*>(pointer) - AllocationHeaderSize;
+	s_liveHeapBytes -= static_cast<int64>(*static_cast<size_t*>(memory));
+	std::free(memory);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+	operator delete(pointer);
+}
+
+namespace
+{
+	struct CreatureFixture : WorldFixture
+	{
+		proto::UnitEntry* entry = nullptr;
+
+		CreatureFixture()
+		{
+			// A typical ambient creature: two spells, no trainer, vendor or quests
+			for (uint32 spellId = 1; spellId <= 2; ++spellId)
+			{
+				proto::SpellEntry* spell = project.spells.add(spellId);
+				spell->set_name("Creature Spell");
+				spell->add_attributes(0);
+			}
+
+			entry = project.units.add(1);
+			entry->set_name("Ambient Creature");
+			entry->set_minlevel(1);
+			entry->set_maxlevel(1);
+			entry->set_minlevelhealth(42);
+			entry->set_scale(1.0f);
+			entry->add_creaturespells()->set_spellid(1);
+			entry->add_creaturespells()->set_spellid(2);
+		}
+
+		std::shared_ptr<GameCreatureS> Spawn(const Vector3& position)
+		{
+			auto creature = world.CreateCreature(*entry, position, 0.0f, 0.0f);
+			world.AddGameObject(*creature);
+			return creature;
+		}
+
+		void Despawn(const std::vector<std::shared_ptr<GameCreatureS>>& creatures)
+		{
+			for (const auto& creature : creatures)
+			{
+				world.RemoveGameObject(*creature);
+			}
+		}
+
+		void Tick()
+		{
+			world.Update(RegularUpdate(GetAsyncTimeMs(), 0.03f));
+		}
+	};
+}
+
+TEST_CASE("Creatures of a unit entry share their initial spells until one of them changes", "[creature_memory]")
+{
+	CreatureFixture f;
+	auto first = f.Spawn(Vector3(0.0f, 0.0f, 0.0f));
+	auto second = f.Spawn(Vector3(5.0f, 0.0f, 0.0f));
+
+	REQUIRE(first->GetSpells().size() == 2);
+	CHECK(&first->GetSpells() == &second->GetSpells());
+	CHECK(first->HasSpell(1));
+	CHECK(second->HasSpell(2));
+
+	first->RemoveSpell(2);
+	CHECK(&first->GetSpells() != &second->GetSpells());
+	CHECK_FALSE(first->HasSpell(2));
+	CHECK(second->HasSpell(2));
+
+	// Creatures spawned later still start with the template spells
+	auto third = f.Spawn(Vector3(10.0f, 0.0f, 0.0f));
+	CHECK(third->HasSpell(2));
+	CHECK(&third->GetSpells() == &second->GetSpells());
+
+	f.Despawn({ first, second, third });
+}
+
+TEST_CASE("Idle creatures create a mover and cooldowns on first use", "[creature_memory]")
+{
+	CreatureFixture f;
+	auto creature = f.Spawn(Vector3(1.0f, 0.0f, 2.0f));
+	f.Tick();
+
+	CHECK_FALSE(creature->HasMover());
+	CHECK(creature->GetPosition() == Vector3(1.0f, 0.0f, 2.0f));
+	CHECK(creature->GetPersistentCooldowns().empty());
+	CHECK_FALSE(creature->SpellHasCooldown(1, 0, spell_cooldown_flags::NoGlobalCooldown));
+
+	creature->SetCooldown(1, 10000);
+	CHECK(creature->SpellHasCooldown(1, 0, spell_cooldown_flags::NoGlobalCooldown));
+	CHECK(creature->GetPersistentCooldowns().size() == 1);
+
+	CHECK_FALSE(creature->GetMover().IsMoving());
+	CHECK(creature->HasMover());
+	CHECK(creature->GetExactPosition() == Vector3(1.0f, 0.0f, 2.0f));
+
+	f.Despawn({ creature });
+}
+
+TEST_CASE("Benchmark heap bytes per idle creature", "[creature_memory][!benchmark]")
+{
+	CreatureFixture f;
+
+	// Roughly the creature density of a populated continent zone
+	constexpr size_t creatureCount = 5000;
+
+	std::vector<std::shared_ptr<GameCreatureS>> creatures;
+	creatures.reserve(creatureCount);
+
+	// Build the shared template data and grid tiles first, so that only per creature memory is measured
+	creatures.push_back(f.Spawn(Vector3(0.0f, 0.0f, 0.0f)));
+	f.Tick();
+
+	const int64 heapBefore = s_liveHeapBytes;
+	for (size_t i = 1; i < creatureCount; ++i)
+	{
+		creatures.push_back(f.Spawn(Vector3(static_cast<float>(i % 100) * 4.0f, 0.0f, static_cast<float>(i / 100) * 4.0f)));
+	}
+	f.Tick();
+
+	const int64 heapBytesPerCreature = (s_liveHeapBytes - heapBefore) / static_cast<int64>(creatureCount - 1);
+	WARN("Idle creature: " << sizeof(GameCreatureS) << " bytes object size, " << heapBytesPerCreature << " heap bytes including the object");
+	CHECK(heapBytesPerCreature > 0);
+
+	f.Despawn(creatures);
+}
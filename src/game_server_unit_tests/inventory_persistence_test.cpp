@@ -0,0 +1,312 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "game_server/inventory.h"
+#include "game_server/inventory_repository.h"
+#include "game_server/objects/game_item_s.h"
+#include "game_server/objects/game_player_s.h"
+#include "base/timer_queue.h"
+#include "shared/proto_data/project.h"
+#include "asio/io_service.hpp"
+
+#include <map>
+#include <memory>
+
+using namespace mmo;
+
+namespace
+{
+	/// Stores items in memory and counts the operations which reach it, so tests can tell delta saves from full saves.
+	class CountingInventoryRepository final : public IInventoryRepository
+	{
+	public:
+		std::vector<InventoryItemData> LoadItems(uint64 characterId) override { return m_storage.LoadItems(characterId); }
+		bool SaveItem(uint64 characterId, const InventoryItemData &item) override { ++savedItems; return m_storage.SaveItem(characterId, item); }
+		bool SaveAllItems(uint64 characterId, const std::vector<InventoryItemData> &items) override { ++fullSaves; return m_storage.SaveAllItems(characterId, items); }
+		bool DeleteItem(uint64 characterId, uint16 slot) override { ++deletedItems; return m_storage.DeleteItem(characterId, slot); }
+		bool DeleteAllItems(uint64 characterId) override { return m_storage.DeleteAllItems(characterId); }
+		bool BeginTransaction() override { return m_storage.BeginTransaction(); }
+		bool Commit() override { return m_storage.Commit(); }
+		bool Rollback() override { return m_storage.Rollback(); }
+
+		void ResetCounters()
+		{
+			savedItems = 0;
+			deletedItems = 0;
+			fullSaves = 0;
+		}
+
+	public:
+		size_t savedItems = 0;
+		size_t deletedItems = 0;
+		size_t fullSaves = 0;
+
+	private:
+		InMemoryInventoryRepository m_storage;
+	};
+
+	/// Stored items by slot, as the order of stored items differs between delta and full saves.
+	std::map<uint16, InventoryItemData> GetStoredItems(IInventoryRepository &repository, uint64 characterId)
+	{
+		std::map<uint16, InventoryItemData> items;
+		for (const auto &item : repository.LoadItems(characterId))
+		{
+			items[item.slot] = item;
+		}
+
+		return items;
+	}
+
+	uint16 PackSlot(uint8 index)
+	{
+		return InventorySlot::FromRelative(player_inventory_slots::Bag_0, player_inventory_pack_slots::Start + index).GetAbsolute();
+	}
+
+	struct InventoryFixture
+	{
+		static constexpr uint64 CharacterGuid = 1001;
+
+		asio::io_service ioService;
+		TimerQueue timerQueue{ ioService };
+		proto::Project project;
+		std::shared_ptr<GamePlayerS> player;
+		uint64 nextItemGuid = 1;
+
+		InventoryFixture()
+		{
+			for (uint32 id = 1; id <= 3; ++id)
+			{
+				auto *entry = project.items.add(id);
+				entry->set_id(id);
+				entry->set_maxstack(20);
+			}
+
+			player = std::make_shared<GamePlayerS>(project, timerQueue);
+			player->Initialize();
+			player->Set<uint64>(object_fields::Guid, CharacterGuid, false);
+		}
+
+		Inventory &GetInventory() const
+		{
+			return player->GetInventory();
+		}
+
+		std::shared_ptr<GameItemS> AddItem(uint32 entryId, uint16 slot, uint16 stacks = 1)
+		{
+			auto item = std::make_shared<GameItemS>(project, *project.items.getById(entryId));
+			item->Initialize();
+			item->Set<uint64>(object_fields::Guid, CreateEntryGUID(nextItemGuid++, entryId, GuidType::Item));
+			item->Set<uint64>(object_fields::ItemOwner, CharacterGuid);
+			item->Set<uint64>(object_fields::Contained, CharacterGuid);
+			(void)item->AddStacks(stacks - 1);
+
+			GetInventory().AddItemToSlot(item, slot);
+			return item;
+		}
+
+		void SetStacks(uint16 slot, uint16 stacks)
+		{
+			auto item = GetInventory().GetItemAtSlot(slot);
+			item->Set<uint32>(object_fields::StackCount, stacks);
+			GetInventory().NotifyItemUpdated(item, slot);
+		}
+
+		/// Saves the inventory into a second repository, replacing all items, and returns the stored result.
+		std::map<uint16, InventoryItemData> SaveFull(IInventoryRepository &deltaRepository)
+		{
+			InMemoryInventoryRepository fullRepository;
+
+			Inventory &inventory = GetInventory();
+			inventory.SetRepository(&fullRepository);
+			inventory.RequestFullSave();
+			REQUIRE(inventory.SaveToRepository());
+			inventory.SetRepository(&deltaRepository);
+
+			return GetStoredItems(fullRepository, CharacterGuid);
+		}
+	};
+}
+
+TEST_CASE("Inventory first save replaces all items", "[inventory][persistence]")
+{
+	InventoryFixture fixture;
+	CountingInventoryRepository repository;
+
+	fixture.AddItem(1, PackSlot(0), 5);
+	fixture.AddItem(2, PackSlot(1));
+
+	Inventory &inventory = fixture.GetInventory();
+	inventory.SetRepository(&repository);
+
+	REQUIRE(inventory.IsDirty());
+	REQUIRE(inventory.SaveToRepository());
+	CHECK(repository.fullSaves == 1);
+	CHECK(repository.savedItems == 0);
+	CHECK(inventory.GetSaveGeneration() == 1);
+	CHECK_FALSE(inventory.IsDirty());
+
+	const auto stored = GetStoredItems(repository, InventoryFixture::CharacterGuid);
+	REQUIRE(stored.size() == 2);
+	CHECK(stored.at(PackSlot(0)).stackCount == 5);
+	CHECK(stored.at(PackSlot(1)).entry == 2);
+}
+
+TEST_CASE("Inventory saves only changed and emptied slots", "[inventory][persistence]")
+{
+	InventoryFixture fixture;
+	CountingInventoryRepository repository;
+
+	for (uint8 i = 0; i < 10; ++i)
+	{
+		fixture.AddItem(1 + i % 3, PackSlot(i), 1 + i);
+	}
+
+	Inventory &inventory = fixture.GetInventory();
+	inventory.SetRepository(&repository);
+	REQUIRE(inventory.SaveToRepository());
+	repository.ResetCounters();
+
+	SECTION("A stack count change writes a single item")
+	{
+		fixture.SetStacks(PackSlot(3), 12);
+
+		REQUIRE(inventory.SaveToRepository());
+		CHECK(repository.fullSaves == 0);
+		CHECK(repository.savedItems == 1);
+		CHECK(repository.deletedItems == 0);
+		CHECK(GetStoredItems(repository, InventoryFixture::CharacterGuid).at(PackSlot(3)).stackCount == 12);
+	}
+
+	SECTION("A removed item deletes its slot")
+	{
+		REQUIRE(inventory.RemoveItem(PackSlot(4)) == inventory_change_failure::Okay);
+
+		REQUIRE(inventory.SaveToRepository());
+		CHECK(repository.savedItems == 0);
+		CHECK(repository.deletedItems == 1);
+		CHECK_FALSE(GetStoredItems(repository, InventoryFixture::CharacterGuid).contains(PackSlot(4)));
+	}
+
+	SECTION("Moving an item into an empty slot writes the new slot and deletes the old one")
+	{
+		inventory.SwapItemSlots(PackSlot(2), PackSlot(12));
+
+		REQUIRE(inventory.SaveToRepository());
+		CHECK(repository.savedItems == 1);
+		CHECK(repository.deletedItems == 1);
+
+		const auto stored = GetStoredItems(repository, InventoryFixture::CharacterGuid);
+		CHECK_FALSE(stored.contains(PackSlot(2)));
+		CHECK(stored.at(PackSlot(12)).stackCount == 3);
+	}
+
+	SECTION("A change which is reverted before the save writes nothing")
+	{
+		fixture.SetStacks(PackSlot(5), 2);
+		fixture.SetStacks(PackSlot(5), 6);
+
+		REQUIRE(inventory.IsDirty());
+		REQUIRE(inventory.SaveToRepository());
+		CHECK(repository.savedItems == 0);
+		CHECK(repository.deletedItems == 0);
+		CHECK(inventory.GetSaveGeneration() == 2);
+	}
+}
+
+TEST_CASE("Inventory delta saves and full saves store the same items", "[inventory][persistence]")
+{
+	InventoryFixture fixture;
+	CountingInventoryRepository repository;
+
+	for (uint8 i = 0; i < 8; ++i)
+	{
+		fixture.AddItem(1 + i % 3, PackSlot(i), 1 + i);
+	}
+
+	Inventory &inventory = fixture.GetInventory();
+	inventory.SetRepository(&repository);
+	REQUIRE(inventory.SaveToRepository());
+
+	// Every generation changes a few slots in a different way, and the result is compared after each save
+	for (uint8 generation = 0; generation < 6; ++generation)
+	{
+		repository.ResetCounters();
+
+		switch (generation)
+		{
+		case 0:
+			fixture.SetStacks(PackSlot(0), 20);
+			fixture.AddItem(3, PackSlot(10), 4);
+			break;
+		case 1:
+			REQUIRE(inventory.RemoveItem(PackSlot(1)) == inventory_change_failure::Okay);
+			REQUIRE(inventory.RemoveItem(PackSlot(2), 1) == inventory_change_failure::Okay);
+			break;
+		case 2:
+			inventory.SwapItemSlots(PackSlot(3), PackSlot(4));
+			inventory.SwapItemSlots(PackSlot(5), PackSlot(11));
+			break;
+		case 3:
+			// Refills a slot which was emptied by the previous generation with another item
+			fixture.AddItem(2, PackSlot(5), 7);
+			REQUIRE(inventory.RemoveItem(PackSlot(10)) == inventory_change_failure::Okay);
+			break;
+		case 4:
+			REQUIRE(inventory.RemoveItem(PackSlot(0)) == inventory_change_failure::Okay);
+			fixture.AddItem(1, PackSlot(0), 3);
+			break;
+		case 5:
+			for (uint8 i = 0; i < 12; ++i)
+			{
+				if (inventory.GetItemAtSlot(PackSlot(i)))
+				{
+					REQUIRE(inventory.RemoveItem(PackSlot(i)) == inventory_change_failure::Okay);
+				}
+			}
+			break;
+		}
+
+		REQUIRE(inventory.SaveToRepository());
+		CHECK(repository.fullSaves == 0);
+
+		const auto deltaItems = GetStoredItems(repository, InventoryFixture::CharacterGuid);
+		CHECK(deltaItems == fixture.SaveFull(repository));
+	}
+
+	CHECK(GetStoredItems(repository, InventoryFixture::CharacterGuid).empty());
+}
+
+TEST_CASE("Inventory falls back to a full save when requested", "[inventory][persistence]")
+{
+	InventoryFixture fixture;
+	CountingInventoryRepository repository;
+
+	fixture.AddItem(1, PackSlot(0));
+	fixture.AddItem(2, PackSlot(1));
+
+	Inventory &inventory = fixture.GetInventory();
+	inventory.SetRepository(&repository);
+	REQUIRE(inventory.SaveToRepository());
+	repository.ResetCounters();
+
+	// Simulates a realm which lost a delta, so the stored items no longer match the last save
+	repository.DeleteItem(InventoryFixture::CharacterGuid, PackSlot(1));
+	repository.SaveItem(InventoryFixture::CharacterGuid, []()
+	{
+		InventoryItemData stale;
+		stale.entry = 3;
+		stale.slot = PackSlot(9);
+		return stale;
+	}());
+
+	inventory.RequestFullSave();
+	REQUIRE(inventory.IsDirty());
+	REQUIRE(inventory.SaveToRepository());
+	CHECK(repository.fullSaves == 1);
+
+	const auto stored = GetStoredItems(repository, InventoryFixture::CharacterGuid);
+	REQUIRE(stored.size() == 2);
+	CHECK(stored.contains(PackSlot(0)));
+	CHECK(stored.contains(PackSlot(1)));
+}
@@ -3,6 +3,7 @@
 #include "catch.hpp"
 
 #include "game_server/loot_instance.h"
+#include "game_server/loot_table.h"
 #include "game_server/objects/game_player_s.h"
 #include "game_server/condition_mgr.h"
 #include "game/group.h"
@@ -12,6 +13,8 @@
 #include "shared/proto_data/loot_entry.pb.h"
 #include "asio/io_service.hpp"
 
+#include <chrono>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -52,6 +55,56 @@ namespace
 		player->Set<uint64>(object_fields::Guid, guid, false);
 		return player;
 	}
+
+	/// Adds a definition with the given item id and drop chance to a loot group.
+	void AddDefinition(proto::LootGroup& group, const uint32 item, const float dropChance, const uint32 condition = 0)
+	{
+		auto* def = group.add_definitions();
+		def->set_item(item);
+		def->set_dropchance(dropChance);
+		def->set_condition(condition);
+	}
+
+	/// Rolls a loot group the way loot instances did before loot tables were compiled.
+	/// @returns The dropped definition or nullptr if nothing dropped.
+	const proto::LootDefinition* ReferenceRollGroup(const proto::LootGroup& group, RandomnessGenerator& generator)
+	{
+		std::uniform_real_distribution<float> lootDistribution(0.0f, 100.0f);
+		const float groupRoll = lootDistribution(generator);
+
+		std::vector<const proto::LootDefinition*> equalChanced;
+		std::vector<const proto::LootDefinition*> nonEqualChanced;
+		for (const auto& def : group.definitions())
+		{
+			if (def.dropchance() == 0.0f)
+			{
+				equalChanced.push_back(&def);
+			}
+			else if (def.dropchance() > 0.0f && def.dropchance() >= groupRoll)
+			{
+				nonEqualChanced.push_back(&def);
+			}
+		}
+
+		const auto& candidates = nonEqualChanced.empty() ? equalChanced : nonEqualChanced;
+		if (candidates.empty())
+		{
+			return nullptr;
+		}
+
+		std::uniform_int_distribution<uint32> candidateDistribution(0, static_cast<uint32>(candidates.size()) - 1);
+		return candidates[candidateDistribution(generator)];
+	}
+
+	/// Rolls the only group of a compiled loot table.
+	const proto::LootDefinition* RollTableGroup(const LootTable& table, RandomnessGenerator& generator, const bool eligible = true)
+	{
+		const proto::LootDefinition* dropped = nullptr;
+		table.Roll(generator,
+			[eligible](const proto::LootDefinition&) { return eligible; },
+			[&dropped](const proto::LootDefinition& def) { dropped = &def; });
+		return dropped;
+	}
 }
 
 TEST_CASE("LootInstance MasterLoot enforcement", "[loot_instance]")
@@ -327,3 +380,295 @@ TEST_CASE("LootInstance combines multiple loot tables", "[loot_instance]")
 		REQUIRE(loot.GetItemCount() == 1);
 	}
 }
+
+TEST_CASE("LootTable drops items with the probabilities of the threshold roll", "[loot_instance]")
+{
+	proto::LootEntry entry;
+
+	// Drop chances which share thresholds
+	auto& tied = *entry.add_groups();
+	AddDefinition(tied, 1, 50.0f);
+	AddDefinition(tied, 2, 25.0f);
+	AddDefinition(tied, 3, 25.0f);
+	AddDefinition(tied, 4, 0.0f);
+	AddDefinition(tied, 5, 0.0f);
+
+	// A rare drop, nothing drops most of the time
+	auto& rare = *entry.add_groups();
+	AddDefinition(rare, 1, 10.0f);
+
+	// A guaranteed drop competing with a chanced one
+	auto& guaranteed = *entry.add_groups();
+	AddDefinition(guaranteed, 1, 100.0f);
+	AddDefinition(guaranteed, 2, 30.0f);
+
+	// Drop chances above 100 behave like 100
+	auto& above = *entry.add_groups();
+	AddDefinition(above, 1, 150.0f);
+	AddDefinition(above, 2, 0.0f);
+
+	// Only equal chanced definitions, and one which can never drop
+	auto& equal = *entry.add_groups();
+	AddDefinition(equal, 1, 0.0f);
+	AddDefinition(equal, 2, 0.0f);
+	AddDefinition(equal, 3, -1.0f);
+
+	constexpr uint32 rolls = 200000;
+	for (const auto& group : entry.groups())
+	{
+		proto::LootEntry single;
+		*single.add_groups() = group;
+		const LootTable table(single);
+
+		RandomnessGenerator referenceGenerator(1234);
+		RandomnessGenerator tableGenerator(5678);
+		std::map<uint32, uint32> referenceDrops;
+		std::map<uint32, uint32> tableDrops;
+		for (uint32 i = 0; i < rolls; ++i)
+		{
+			const auto* referenceDrop = ReferenceRollGroup(single.groups(0), referenceGenerator);
+			++referenceDrops[referenceDrop ? referenceDrop->item() : 0];
+
+			const auto* tableDrop = RollTableGroup(table, tableGenerator);
+			++tableDrops[tableDrop ? tableDrop->item() : 0];
+		}
+
+		for (uint32 item = 0; item <= 5; ++item)
+		{
+			INFO("Group with " << group.definitions_size() << " definitions, item " << item);
+			CHECK(static_cast<double>(tableDrops[item]) / rolls == Approx(static_cast<double>(referenceDrops[item]) / rolls).margin(0.01));
+		}
+	}
+}
+
+TEST_CASE("LootTable rolls are deterministic for a seeded generator", "[loot_instance]")
+{
+	proto::LootEntry entry;
+	auto& group = *entry.add_groups();
+	for (uint32 item = 1; item <= 8; ++item)
+	{
+		AddDefinition(group, item, static_cast<float>(item * 10));
+	}
+	AddDefinition(group, 9, 0.0f);
+	entry.set_minmoney(10);
+	entry.set_maxmoney(500);
+
+	const LootTable table(entry);
+
+	const auto rollSequence = [&table](const uint32 seed)
+	{
+		RandomnessGenerator generator(seed);
+		std::vector<uint32> sequence;
+		for (uint32 i = 0; i < 1000; ++i)
+		{
+			const auto* drop = RollTableGroup(table, generator);
+			sequence.push_back(drop ? drop->item() : 0);
+			sequence.push_back(table.RollGold(generator));
+		}
+
+		return sequence;
+	};
+
+	REQUIRE(rollSequence(42) == rollSequence(42));
+	REQUIRE(rollSequence(42) != rollSequence(43));
+}
+
+TEST_CASE("LootTable rolls groups with conditions for the recipients", "[loot_instance]")
+{
+	proto::LootEntry entry;
+	auto& group = *entry.add_groups();
+	AddDefinition(group, 1, 100.0f, 99);
+	AddDefinition(group, 2, 0.0f);
+
+	const LootTable table(entry);
+	RandomnessGenerator generator(7);
+
+	SECTION("LOOT-13: Quest items drop if a recipient meets their condition")
+	{
+		for (uint32 i = 0; i < 100; ++i)
+		{
+			const auto* drop = RollTableGroup(table, generator, true);
+			REQUIRE(drop);
+			REQUIRE(drop->item() == 1);
+		}
+	}
+
+	SECTION("LOOT-14: Quest items are skipped if no recipient meets their condition")
+	{
+		for (uint32 i = 0; i < 100; ++i)
+		{
+			const auto* drop = RollTableGroup(table, generator, false);
+			REQUIRE(drop);
+			REQUIRE(drop->item() == 2);
+		}
+	}
+}
+
+TEST_CASE("LootInstance rolls cached loot tables when generated", "[loot_instance]")
+{
+	asio::io_service ioService;
+	TimerQueue timerQueue(ioService);
+	proto::Project project;
+
+	auto* itemEntry = project.items.add(1);
+	itemEntry->set_id(1);
+	itemEntry->set_maxstack(20);
+
+	auto* lootEntry = project.unitLoot.add(5);
+	*lootEntry = MakeLootEntry(2);
+	lootEntry->set_id(5);
+	lootEntry->set_minmoney(10);
+	lootEntry->set_maxmoney(10);
+
+	auto* multiTableUnit = project.units.add(7);
+	multiTableUnit->set_id(7);
+	multiTableUnit->add_unitlootentries(5);
+	multiTableUnit->add_unitlootentries(5);
+	multiTableUnit->add_unitlootentries(6);
+
+	auto* legacyUnit = project.units.add(8);
+	legacyUnit->set_id(8);
+	legacyUnit->set_unitlootentry(5);
+
+	auto* lootlessUnit = project.units.add(9);
+	lootlessUnit->set_id(9);
+
+	ConditionMgr conditionMgr(project.conditions);
+	const LootTableCache lootTables(project);
+
+	const uint64 guidA = 1001;
+	const uint64 guidB = 1002;
+	auto playerA = MakePlayer(project, timerQueue, guidA);
+	auto playerB = MakePlayer(project, timerQueue, guidB);
+
+	SECTION("LOOT-15: Creature loot tables are resolved once, unknown tables are ignored")
+	{
+		REQUIRE(lootTables.GetTableCount() == 1);
+		REQUIRE(lootTables.GetCreatureLoot(*multiTableUnit).size() == 2);
+		REQUIRE(lootTables.GetCreatureLoot(*legacyUnit).size() == 1);
+		REQUIRE(lootTables.GetCreatureLoot(*lootlessUnit).empty());
+		REQUIRE(lootTables.GetLootTable(5).size() == 1);
+		REQUIRE(lootTables.GetLootTable(6).empty());
+	}
+
+	SECTION("LOOT-16: Nothing is rolled before the loot is generated")
+	{
+		LootInstance loot(project.items, conditionMgr, 42ULL, lootTables.GetCreatureLoot(*multiTableUnit), { playerA, playerB });
+
+		REQUIRE(loot.IsGenerated() == false);
+		REQUIRE(loot.GetItemCount() == 0);
+		REQUIRE(loot.GetGold() == 0);
+		REQUIRE(loot.GetRecipients() == std::vector<uint64>{ guidA, guidB });
+
+		loot.Generate();
+		REQUIRE(loot.IsGenerated());
+		REQUIRE(loot.GetItemCount() == 4);
+		REQUIRE(loot.GetGold() == 20);
+
+		// Generating again does not roll a second time
+		loot.Generate();
+		REQUIRE(loot.GetItemCount() == 4);
+		REQUIRE(loot.GetGold() == 20);
+	}
+
+	SECTION("LOOT-17: Group rolls set up before the loot was generated start with the generated items")
+	{
+		itemEntry->set_quality(item_quality::Uncommon);
+
+		LootInstance loot(project.items, conditionMgr, 43ULL, lootTables.GetCreatureLoot(*legacyUnit), { playerA, playerB },
+			loot_method::GroupLoot);
+		loot.SetupGroupRollItems({ guidA, guidB });
+		REQUIRE(loot.HasActiveRolls() == false);
+
+		loot.Generate();
+		REQUIRE(loot.GetItemCount() == 2);
+		REQUIRE(loot.GetRollDataMap().contains(0));
+		REQUIRE(loot.GetRollDataMap().contains(1));
+		REQUIRE(loot.CanLootItem(0, guidA) == false);
+	}
+}
+
+TEST_CASE("LootInstance checks quest item conditions when generated", "[loot_instance]")
+{
+	asio::io_service ioService;
+	TimerQueue timerQueue(ioService);
+	proto::Project project;
+
+	for (uint32 itemId = 1; itemId <= 2; ++itemId)
+	{
+		auto* itemEntry = project.items.add(itemId);
+		itemEntry->set_id(itemId);
+		itemEntry->set_maxstack(20);
+	}
+
+	// A condition without type and sub-conditions is met by every player
+	auto* condition = project.conditions.add(1);
+	condition->set_conditiontype(proto::Condition_ConditionType_NONE_TYPE);
+
+	auto* lootEntry = project.unitLoot.add(5);
+	lootEntry->set_id(5);
+	auto& group = *lootEntry->add_groups();
+	AddDefinition(group, 2, 100.0f, 1);
+	AddDefinition(group, 1, 0.0f);
+
+	ConditionMgr conditionMgr(project.conditions);
+	const LootTableCache lootTables(project);
+
+	auto playerA = MakePlayer(project, timerQueue, 1001);
+
+	SECTION("LOOT-18: Quest items drop if a recipient meets their condition when the loot is opened")
+	{
+		LootInstance loot(project.items, conditionMgr, 42ULL, lootTables.GetLootTable(5), { playerA });
+		loot.Generate();
+		REQUIRE(loot.GetItemCount() == 1);
+		REQUIRE(loot.GetLootDefinition(0)->definition.item() == 2);
+	}
+
+	SECTION("LOOT-19: Recipients who went offline before the loot was opened are not checked")
+	{
+		LootInstance loot(project.items, conditionMgr, 43ULL, lootTables.GetLootTable(5), { playerA });
+		playerA.reset();
+
+		loot.Generate();
+		REQUIRE(loot.GetItemCount() == 1);
+		REQUIRE(loot.GetLootDefinition(0)->definition.item() == 1);
+	}
+}
+
+TEST_CASE("Benchmark loot group rolls", "[loot_instance][!benchmark]")
+{
+	// A typical creature drop group: a handful of chanced drops and a long list of equal chanced junk and greens
+	proto::LootEntry entry;
+	auto& group = *entry.add_groups();
+	for (uint32 item = 1; item <= 40; ++item)
+	{
+		AddDefinition(group, item, item <= 8 ? static_cast<float>(item) * 2.5f : 0.0f);
+	}
+
+	const LootTable table(entry);
+
+	constexpr uint32 rolls = 1000000;
+	const auto measure = [](const auto& roll)
+	{
+		RandomnessGenerator generator(1);
+		uint64 itemSum = 0;
+		const auto start = std::chrono::steady_clock::now();
+		for (uint32 i = 0; i < rolls; ++i)
+		{
+			if (const auto* drop = roll(generator))
+			{
+				itemSum += drop->item();
+			}
+		}
+
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		return std::make_pair(itemSum, static_cast<double>(rolls) / seconds);
+	};
+
+	const auto reference = measure([&group](RandomnessGenerator& generator) { return ReferenceRollGroup(group, generator); });
+	const auto compiled = measure([&table](RandomnessGenerator& generator) { return RollTableGroup(table, generator); });
+
+	WARN("Threshold roll: " << static_cast<uint64>(reference.second) << " rolls/s, alias table: " << static_cast<uint64>(compiled.second) << " rolls/s");
+	CHECK(reference.first > 0);
+	CHECK(compiled.first > 0);
+}
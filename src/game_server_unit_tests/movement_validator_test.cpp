@@ -0,0 +1,172 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+// MovementValidator tests.
+//
+// Player movement is validated while the movement packets are handled. These tests verify that speed and water
+// violations are detected exactly like the former checks in the movement handler did, and that water geometry is only
+// queried once a swimmer leaves its verified water quad.
+
+#include "game_server/world/map_data.h"
+#include "game_server/world/movement_validator.h"
+#include "game_server/world/server_water_map.h"
+
+#include "catch.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+using namespace mmo;
+
+namespace
+{
+	/// Map data with water in all quads at negative x coordinates, which counts the water queries. Water is looked up
+	///	like the server water map does it: the page, then the quad mask of the tile, then the surface height.
+	struct LakeMapData final : MapData
+	{
+		static constexpr uint64 QuadsPerTile = 64;
+		static constexpr uint64 TilesPerPage = 16 * 16;
+
+		struct Page
+		{
+			std::unordered_map<uint16, uint64> quadMasks;
+			std::vector<float> heights;
+		};
+
+		LakeMapData()
+		{
+			// Pages west of the world origin are completely covered by water
+			for (const float z : { -1.0f, 1.0f })
+			{
+				const uint64 page = ServerWaterMap::GetQuadKey(-1.0f, z) / QuadsPerTile / TilesPerPage;
+				Page& lake = pages[page];
+				for (uint16 tile = 0; tile < TilesPerPage; ++tile)
+				{
+					lake.quadMasks[tile] = ~0ull;
+				}
+				lake.heights.assign(129 * 129, 2.0f);
+			}
+		}
+
+		bool IsInLineOfSight(const Vector3&, const Vector3&) override { return true; }
+
+		bool IsInLineOfSightEx(const Vector3&, const Vector3& posB, Vector3& hitPoint) override
+		{
+			hitPoint = posB;
+			return true;
+		}
+
+		bool CalculatePath(const Vector3&, const Vector3&, std::vector<Vector3>&) const override { return false; }
+
+		bool FindRandomPointAroundCircle(const Vector3&, float, Vector3&) const override { return false; }
+
+		bool GetWaterSurface(const Vector3& pos, float& outSurfaceY) const override
+		{
+			++waterQueries;
+
+			const uint64 quad = ServerWaterMap::GetQuadKey(pos.x, pos.z);
+			const auto pageIt = pages.find(quad / QuadsPerTile / TilesPerPage);
+			if (pageIt == pages.end())
+			{
+				return false;
+			}
+
+			const auto maskIt = pageIt->second.quadMasks.find(static_cast<uint16>(quad / QuadsPerTile % TilesPerPage));
+			if (maskIt == pageIt->second.quadMasks.end() || (maskIt->second & (1ull << (quad % QuadsPerTile))) == 0)
+			{
+				return false;
+			}
+
+			const size_t vertex = static_cast<size_t>(quad % (128 * 128));
+			const std::vector<float>& heights = pageIt->second.heights;
+			outSurfaceY = (heights[vertex] + heights[vertex + 1] + heights[vertex + 129] + heights[vertex + 130]) * 0.25f;
+			return true;
+		}
+
+		bool IsWaterDataAvailable() const override { return hasWater; }
+
+		std::unordered_map<uint64, Page> pages;
+		mutable size_t waterQueries = 0;
+		bool hasWater = true;
+	};
+}
+
+TEST_CASE("MovementValidator detects movement which exceeds the allowed speed", "[movement_validator]")
+{
+	MovementValidator validator;
+
+	float impliedSpeed = 0.0f;
+	CHECK(validator.CheckSpeed(Vector3(0.0f, 0.0f, 0.0f), Vector3(5.0f, 0.0f, 0.0f), 1.0f, 7.0f * 1.35f, impliedSpeed));
+	CHECK(validator.CheckSpeed(Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 0.0f, 0.0f), 1.0f, 7.0f * 1.35f, impliedSpeed));
+	CHECK(impliedSpeed == 0.0f);
+
+	// The distance is measured in all directions
+	CHECK_FALSE(validator.CheckSpeed(Vector3(0.0f, 0.0f, 0.0f), Vector3(12.0f, 0.0f, 16.0f), 1.0f, 7.0f * 1.35f, impliedSpeed));
+	CHECK(impliedSpeed == Approx(20.0f));
+
+	CHECK_FALSE(validator.CheckSpeed(Vector3(0.0f, 10.0f, 0.0f), Vector3(0.0f, 0.0f, 0.0f), 0.5f, 7.0f * 1.35f, impliedSpeed));
+	CHECK(impliedSpeed == Approx(20.0f));
+
+	CHECK(validator.GetCounters().speedChecks == 4);
+	CHECK(validator.GetCounters().violations == 2);
+
+	validator.ResetCounters();
+	CHECK(validator.GetCounters().speedChecks == 0);
+}
+
+TEST_CASE("MovementValidator only checks water geometry after leaving a verified quad", "[movement_validator]")
+{
+	MovementValidator validator;
+	LakeMapData map;
+
+	// The first position has to be checked, further positions in the same quad don't
+	CHECK(validator.CheckWater(1, Vector3(-50.1f, 0.0f, 10.1f), &map));
+	CHECK(validator.CheckWater(1, Vector3(-50.2f, 0.0f, 10.2f), &map));
+	CHECK(validator.CheckWater(1, Vector3(-50.3f, 0.0f, 10.3f), &map));
+	CHECK(map.waterQueries == 1);
+	CHECK(validator.GetCounters().waterChecksSkipped == 2);
+
+	// Swimming into another water quad needs a new check
+	CHECK(validator.CheckWater(1, Vector3(-70.0f, 0.0f, 10.0f), &map));
+	CHECK(map.waterQueries == 2);
+
+	// Verified quads are tracked per unit
+	CHECK(validator.CheckWater(2, Vector3(-70.1f, 0.0f, 10.1f), &map));
+	CHECK(map.waterQueries == 3);
+
+	// Leaving the water is detected right away
+	CHECK_FALSE(validator.CheckWater(1, Vector3(30.0f, 0.0f, 10.0f), &map));
+	CHECK(map.waterQueries == 4);
+	CHECK(validator.GetCounters().violations == 1);
+
+	// The rejected position did not replace the verified quad
+	CHECK(validator.CheckWater(1, Vector3(-70.1f, 0.0f, 10.1f), &map));
+	CHECK(map.waterQueries == 4);
+	CHECK(validator.GetCounters().waterChecks == 4);
+}
+
+TEST_CASE("MovementValidator skips water checks of confirmed water", "[movement_validator]")
+{
+	MovementValidator validator;
+	LakeMapData map;
+
+	validator.ConfirmWater(1, Vector3(-50.1f, 0.0f, 10.1f));
+	CHECK(validator.CheckWater(1, Vector3(-50.2f, 0.0f, 10.2f), &map));
+	CHECK(map.waterQueries == 0);
+
+	// Removed units have to be verified again
+	validator.Remove(1);
+	CHECK(validator.CheckWater(1, Vector3(-50.2f, 0.0f, 10.2f), &map));
+	CHECK(map.waterQueries == 1);
+}
+
+TEST_CASE("MovementValidator trusts swimmers on maps without water data", "[movement_validator]")
+{
+	MovementValidator validator;
+	LakeMapData map;
+	map.hasWater = false;
+
+	CHECK(validator.CheckWater(1, Vector3(30.0f, 0.0f, 10.0f), &map));
+	CHECK(validator.CheckWater(1, Vector3(30.0f, 0.0f, 10.0f), nullptr));
+
+	CHECK(map.waterQueries == 0);
+	CHECK(validator.GetCounters().violations == 0);
+}
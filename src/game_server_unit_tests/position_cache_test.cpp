@@ -0,0 +1,264 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+// GameUnitS per-tick position cache tests.
+//
+// GameUnitS::GetPosition caches the interpolated mover location per world update tick. These tests verify that the
+// cache is refreshed on every tick, on relocation and when a mover starts a new path, and that units outside of a
+// world are never cached.
+
+#include "game_server/objects/game_player_s.h"
+#include "game_server/world/regular_update.h"
+#include "game/movement_info.h"
+
+#include "world_fixture.h"
+#include "catch.hpp"
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace mmo;
+
+namespace
+{
+	struct PositionCacheFixture : WorldFixture
+	{
+
+		std::shared_ptr<GamePlayerS> MakeUnit(const Vector3& position)
+		{
+			auto unit = std::make_shared<GamePlayerS>(project, timers);
+			unit->Initialize();
+
+			MovementInfo info;
+			info.position = position;
+			unit->ApplyMovementInfo(info);
+			return unit;
+		}
+
+		/// Lets units of the world move along straight lines, as there is no navigation mesh in the tests.
+		void EnableMovement()
+		{
+			world.SetMapData(std::make_unique<SimpleMapData>());
+		}
+
+		/// Spawns a unit in the world which moves from the given position to the target at the given speed.
+		std::shared_ptr<GamePlayerS> MakeMovingUnit(const Vector3& position, const Vector3& target, const float speed)
+		{
+			auto unit = MakeUnit(position);
+			unit->Set<uint32>(object_fields::MaxHealth, 100);
+			unit->Set<uint32>(object_fields::Health, 100);
+			Spawn(*unit);
+			unit->GetMover().MoveTo(target, speed, 0.0f);
+			return unit;
+		}
+
+		void Spawn(GamePlayerS& unit)
+		{
+			unit.Set<uint64>(object_fields::Guid, objectIds.GenerateId());
+			world.AddGameObject(unit);
+		}
+
+		void Despawn(const std::vector<std::shared_ptr<GamePlayerS>>& units)
+		{
+			for (const auto& unit : units)
+			{
+				world.RemoveGameObject(*unit);
+			}
+		}
+
+		void Tick()
+		{
+			world.Update(RegularUpdate(GetAsyncTimeMs(), 0.03f));
+		}
+	};
+}
+
+TEST_CASE("GetPosition returns the movement position outside of a world", "[position_cache]")
+{
+	PositionCacheFixture f;
+	auto unit = f.MakeUnit(Vector3(1.0f, 2.0f, 3.0f));
+
+	CHECK(unit->GetPosition() == Vector3(1.0f, 2.0f, 3.0f));
+	CHECK(unit->GetExactPosition() == Vector3(1.0f, 2.0f, 3.0f));
+}
+
+TEST_CASE("World update ticks advance the update tick counter", "[position_cache]")
+{
+	PositionCacheFixture f;
+	const uint64 tick = f.world.GetUpdateTick();
+
+	f.Tick();
+	CHECK(f.world.GetUpdateTick() == tick + 1);
+}
+
+TEST_CASE("Relocating a unit invalidates its cached position within the same tick", "[position_cache]")
+{
+	PositionCacheFixture f;
+	auto unit = f.MakeUnit(Vector3(0.0f, 0.0f, 0.0f));
+	f.Spawn(*unit);
+
+	REQUIRE(unit->GetPosition() == Vector3(0.0f, 0.0f, 0.0f));
+
+	// Movement events must be visible immediately, not only on the next tick
+	MovementInfo info = unit->GetMovementInfo();
+	info.position = Vector3(5.0f, 0.0f, 0.0f);
+	unit->ApplyMovementInfo(info);
+	CHECK(unit->GetPosition() == Vector3(5.0f, 0.0f, 0.0f));
+
+	unit->Relocate(Vector3(7.0f, 0.0f, 1.0f), Radian(0.0f));
+	CHECK(unit->GetPosition() == Vector3(7.0f, 0.0f, 1.0f));
+
+	f.world.RemoveGameObject(*unit);
+}
+
+TEST_CASE("Cached position matches the exact position after a tick", "[position_cache]")
+{
+	PositionCacheFixture f;
+	auto unit = f.MakeUnit(Vector3(3.0f, 0.0f, -4.0f));
+	unit->SetWorldInstance(&f.world);
+
+	f.Tick();
+	CHECK(unit->GetPosition() == unit->GetExactPosition());
+
+	unit->SetWorldInstance(nullptr);
+}
+
+TEST_CASE("Moving units refresh their cached position once per tick", "[position_cache]")
+{
+	PositionCacheFixture f;
+	f.EnableMovement();
+
+	// 100 units per second, so the unit moves a few units while the test sleeps
+	auto unit = f.MakeMovingUnit(Vector3(0.0f, 0.0f, 0.0f), Vector3(1000.0f, 0.0f, 0.0f), 100.0f);
+	REQUIRE(unit->GetMover().IsMoving());
+
+	// Starting the path invalidated the cache
+	const Vector3 start = unit->GetPosition();
+	CHECK(start.x < 1.0f);
+
+	// Within a tick the cached position is kept, even though the mover advanced
+	std::this_thread::sleep_for(std::chrono::milliseconds(30));
+	CHECK(unit->GetPosition() == start);
+	CHECK(unit->GetExactPosition().x > start.x);
+
+	// The next tick picks up the interpolated location
+	f.Tick();
+	const Vector3 moved = unit->GetPosition();
+	CHECK(moved.x > start.x);
+	CHECK(moved.x <= unit->GetExactPosition().x);
+
+	// A new path takes effect immediately instead of on the next tick
+	REQUIRE(unit->GetMover().MoveTo(Vector3(-1000.0f, 0.0f, 0.0f), 100.0f, 0.0f));
+	const Vector3 turned = unit->GetPosition();
+	CHECK(turned.x >= moved.x);
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(30));
+	f.Tick();
+	CHECK(unit->GetPosition().x < turned.x);
+
+	// Stopping relocates the unit, which is visible right away as well
+	unit->GetMover().StopMovement();
+	CHECK(unit->GetPosition() == unit->GetExactPosition());
+
+	f.Despawn({ unit });
+}
+
+TEST_CASE("Benchmark position lookups for 5k units per world tick", "[position_cache][!benchmark]")
+{
+	PositionCacheFixture f;
+
+	constexpr size_t unitCount = 5000;
+
+	// Distance checks, visibility tests, AI decisions and area queries usually ask for a unit's position
+	// a few dozen times per tick
+	constexpr size_t lookupsPerUnit = 24;
+
+	std::vector<std::shared_ptr<GamePlayerS>> units;
+	units.reserve(unitCount);
+	for (size_t i = 0; i < unitCount; ++i)
+	{
+		units.push_back(f.MakeUnit(Vector3(static_cast<float>(i % 100), 0.0f, static_cast<float>(i / 100))));
+		units.back()->SetWorldInstance(&f.world);
+	}
+
+	BENCHMARK("Exact position per lookup")
+	{
+		float sum = 0.0f;
+		for (const auto& unit : units)
+		{
+			for (size_t i = 0; i < lookupsPerUnit; ++i)
+			{
+				sum += unit->GetExactPosition().x;
+			}
+		}
+		return sum;
+	};
+
+	BENCHMARK("Cached position per tick")
+	{
+		f.Tick();
+
+		float sum = 0.0f;
+		for (const auto& unit : units)
+		{
+			for (size_t i = 0; i < lookupsPerUnit; ++i)
+			{
+				sum += unit->GetPosition().x;
+			}
+		}
+		return sum;
+	};
+
+	for (const auto& unit : units)
+	{
+		unit->SetWorldInstance(nullptr);
+	}
+}
+
+TEST_CASE("Benchmark position lookups for 5k moving units per world tick", "[position_cache][!benchmark]")
+{
+	PositionCacheFixture f;
+	f.EnableMovement();
+
+	constexpr size_t unitCount = 5000;
+	constexpr size_t lookupsPerUnit = 24;
+
+	// Every unit walks along its own long path, so the mover has to interpolate on every exact lookup
+	std::vector<std::shared_ptr<GamePlayerS>> units;
+	units.reserve(unitCount);
+	for (size_t i = 0; i < unitCount; ++i)
+	{
+		const Vector3 start(static_cast<float>(i % 100), 0.0f, static_cast<float>(i / 100));
+		units.push_back(f.MakeMovingUnit(start, start + Vector3(10000.0f, 0.0f, 5000.0f), 7.0f));
+	}
+
+	BENCHMARK("Exact position per lookup")
+	{
+		float sum = 0.0f;
+		for (const auto& unit : units)
+		{
+			for (size_t i = 0; i < lookupsPerUnit; ++i)
+			{
+				sum += unit->GetExactPosition().x;
+			}
+		}
+		return sum;
+	};
+
+	BENCHMARK("Cached position per tick")
+	{
+		f.Tick();
+
+		float sum = 0.0f;
+		for (const auto& unit : units)
+		{
+			for (size_t i = 0; i < lookupsPerUnit; ++i)
+			{
+				sum += unit->GetPosition().x;
+			}
+		}
+		return sum;
+	};
+
+	f.Despawn(units);
+}
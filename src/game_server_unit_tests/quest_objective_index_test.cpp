@@ -0,0 +1,385 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+// Quest objective index tests.
+//
+// Kill, item and spell cast credit only visit the quests of the quest log which have an objective for the event's
+// entry. These tests verify that the index follows accepted, abandoned, rewarded and loaded quests and that the
+// resulting credit is the same as when scanning the whole quest log.
+
+#include "game_server/objects/game_player_s.h"
+
+#include "world_fixture.h"
+#include "catch.hpp"
+
+#include <array>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace mmo;
+
+namespace
+{
+	struct QuestFixture : WorldFixture
+	{
+		static constexpr uint64 CharacterGuid = 1001;
+
+		std::shared_ptr<GamePlayerS> player;
+
+		QuestFixture()
+		{
+			auto *cls = project.classes.add(1);
+			cls->set_powertype(proto::ClassEntry_PowerType_MANA);
+			for (uint32 i = 0; i < 2; ++i)
+			{
+				auto *values = cls->add_levelbasevalues();
+				values->set_health(100);
+				values->set_mana(100);
+			}
+
+			project.races.add(1);
+
+			player = std::make_shared<GamePlayerS>(project, timers);
+			player->Initialize();
+			player->Set<uint64>(object_fields::Guid, CharacterGuid, false);
+			player->SetClass(*cls);
+			player->SetRace(*project.races.getById(1));
+			player->SetLevel(1);
+			player->SetWorldInstance(&world);
+		}
+
+		~QuestFixture()
+		{
+			player->SetWorldInstance(nullptr);
+		}
+
+		proto::QuestEntry &AddQuest(const uint32 id)
+		{
+			auto *quest = project.quests.add(id);
+			quest->set_name("Quest");
+			return *quest;
+		}
+
+		const proto::UnitEntry &AddUnit(const uint32 id, const uint32 killCredit = 0)
+		{
+			auto *unit = project.units.add(id);
+			unit->set_name("Creature");
+			unit->set_killcredit(killCredit);
+			return *unit;
+		}
+
+		QuestField GetQuestLogSlot(const uint8 slot) const
+		{
+			return player->Get<QuestField>(object_fields::QuestLogSlot_1 + slot * (sizeof(QuestField) / sizeof(uint32)));
+		}
+	};
+
+	/// Quest log model which applies kill credit by scanning every quest and objective.
+	struct ReferenceQuestLog
+	{
+		struct Slot
+		{
+			uint32 questId = 0;
+			QuestStatus status = quest_status::Rewarded;
+			std::array<uint8, 4> counters {};
+		};
+
+		const proto::Project &project;
+		std::array<Slot, MaxQuestLogSize> slots {};
+
+		bool Accept(const uint32 questId)
+		{
+			for (const Slot &slot : slots)
+			{
+				if (slot.questId == questId)
+				{
+					return false;
+				}
+			}
+
+			for (Slot &slot : slots)
+			{
+				if (slot.questId == 0)
+				{
+					slot = Slot();
+					slot.questId = questId;
+					slot.status = quest_status::Incomplete;
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		bool Abandon(const uint32 questId)
+		{
+			for (Slot &slot : slots)
+			{
+				if (slot.questId == questId)
+				{
+					slot = Slot();
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		void KillCredit(const uint32 creditEntry)
+		{
+			for (Slot &slot : slots)
+			{
+				if (slot.questId == 0 || slot.status != quest_status::Incomplete)
+				{
+					continue;
+				}
+
+				const proto::QuestEntry &quest = *project.quests.getById(slot.questId);
+				for (int i = 0; i < quest.requirements_size(); ++i)
+				{
+					const auto &req = quest.requirements(i);
+					if (req.creatureid() == creditEntry && slot.counters[i] < req.creaturecount())
+					{
+						++slot.counters[i];
+					}
+				}
+
+				bool complete = true;
+				for (int i = 0; i < quest.requirements_size(); ++i)
+				{
+					complete &= slot.counters[i] >= quest.requirements(i).creaturecount();
+				}
+
+				if (complete)
+				{
+					slot.status = quest_status::Complete;
+				}
+			}
+		}
+	};
+}
+
+TEST_CASE("Kill credit only reaches quests of the quest log with a matching objective", "[quest_objective_index]")
+{
+	QuestFixture f;
+	const proto::UnitEntry &wolf = f.AddUnit(1);
+	const proto::UnitEntry &boar = f.AddUnit(2);
+	const proto::UnitEntry &youngWolf = f.AddUnit(3, 1);
+
+	proto::QuestEntry &wolves = f.AddQuest(100);
+	auto *wolfReq = wolves.add_requirements();
+	wolfReq->set_creatureid(1);
+	wolfReq->set_creaturecount(3);
+
+	proto::QuestEntry &hunt = f.AddQuest(101);
+	auto *boarReq = hunt.add_requirements();
+	boarReq->set_creatureid(2);
+	boarReq->set_creaturecount(1);
+	auto *huntWolfReq = hunt.add_requirements();
+	huntWolfReq->set_creatureid(1);
+	huntWolfReq->set_creaturecount(1);
+
+	// No quests, no credit
+	f.player->OnQuestKillCredit(1, wolf);
+	CHECK(f.GetQuestLogSlot(0).questId == 0);
+
+	REQUIRE(f.player->AcceptQuest(100));
+	REQUIRE(f.player->AcceptQuest(101));
+
+	// The kill credit entry of a unit counts for its credited creature
+	f.player->OnQuestKillCredit(2, youngWolf);
+	CHECK(f.GetQuestLogSlot(0).counters[0] == 1);
+	CHECK(f.GetQuestLogSlot(1).counters[1] == 1);
+	CHECK(f.GetQuestLogSlot(1).counters[0] == 0);
+
+	f.player->OnQuestKillCredit(3, boar);
+	CHECK(f.player->GetQuestStatus(101) == quest_status::Complete);
+	CHECK(f.player->GetQuestStatus(100) == quest_status::Incomplete);
+
+	// Abandoned quests are no longer credited
+	REQUIRE(f.player->AbandonQuest(100));
+	f.player->OnQuestKillCredit(4, wolf);
+	CHECK(f.GetQuestLogSlot(0).questId == 0);
+
+	// Accepting it again starts from scratch in the free slot
+	REQUIRE(f.player->AcceptQuest(100));
+	f.player->OnQuestKillCredit(5, wolf);
+	CHECK(f.GetQuestLogSlot(0).questId == 100);
+	CHECK(f.GetQuestLogSlot(0).counters[0] == 1);
+}
+
+TEST_CASE("Rewarded quests are no longer credited", "[quest_objective_index]")
+{
+	QuestFixture f;
+	const proto::UnitEntry &wolf = f.AddUnit(1);
+
+	for (const uint32 questId : { 100u, 101u })
+	{
+		auto *req = f.AddQuest(questId).add_requirements();
+		req->set_creatureid(1);
+		req->set_creaturecount(2);
+	}
+
+	REQUIRE(f.player->AcceptQuest(100));
+	f.player->OnQuestKillCredit(1, wolf);
+	f.player->OnQuestKillCredit(2, wolf);
+	REQUIRE(f.player->GetQuestStatus(100) == quest_status::Complete);
+
+	REQUIRE(f.player->RewardQuest(0, 100, 0));
+	CHECK(f.GetQuestLogSlot(0).questId == 0);
+
+	// The next quest takes over the slot of the rewarded one and is the only one credited
+	REQUIRE(f.player->AcceptQuest(101));
+	f.player->OnQuestKillCredit(3, wolf);
+	CHECK(f.GetQuestLogSlot(0).questId == 101);
+	CHECK(f.GetQuestLogSlot(0).counters[0] == 1);
+	CHECK(f.player->GetQuestStatus(100) == quest_status::Rewarded);
+}
+
+TEST_CASE("Quests loaded with the character are indexed", "[quest_objective_index]")
+{
+	QuestFixture f;
+	const proto::UnitEntry &wolf = f.AddUnit(1);
+
+	proto::QuestEntry &wolves = f.AddQuest(100);
+	auto *req = wolves.add_requirements();
+	req->set_creatureid(1);
+	req->set_creaturecount(3);
+
+	QuestStatusData data;
+	data.status = quest_status::Incomplete;
+	data.creatures[0] = 2;
+	f.player->SetQuestData(100, data);
+
+	f.player->OnQuestKillCredit(1, wolf);
+	CHECK(f.GetQuestLogSlot(0).counters[0] == 3);
+	CHECK(f.player->GetQuestStatus(100) == quest_status::Complete);
+}
+
+TEST_CASE("Item credit follows the item count of indexed quests", "[quest_objective_index]")
+{
+	QuestFixture f;
+	for (uint32 id = 1; id <= 2; ++id)
+	{
+		auto *item = f.project.items.add(id);
+		item->set_maxstack(20);
+	}
+
+	proto::QuestEntry &quest = f.AddQuest(100);
+	auto *req = quest.add_requirements();
+	req->set_itemid(1);
+	req->set_itemcount(3);
+
+	REQUIRE(f.player->AcceptQuest(100));
+
+	Inventory &inventory = f.player->GetInventory();
+	REQUIRE(inventory.CreateItems(*f.project.items.getById(2), 5) == inventory_change_failure::Okay);
+	CHECK(f.player->GetQuestStatus(100) == quest_status::Incomplete);
+
+	REQUIRE(inventory.CreateItems(*f.project.items.getById(1), 2) == inventory_change_failure::Okay);
+	CHECK(f.player->GetQuestStatus(100) == quest_status::Incomplete);
+
+	REQUIRE(inventory.CreateItems(*f.project.items.getById(1), 1) == inventory_change_failure::Okay);
+	CHECK(f.player->GetQuestStatus(100) == quest_status::Complete);
+
+	// Losing the items makes the quest incomplete again
+	REQUIRE(inventory.RemoveItems(*f.project.items.getById(1), 0) == inventory_change_failure::Okay);
+	CHECK(f.player->GetQuestStatus(100) == quest_status::Incomplete);
+}
+
+TEST_CASE("Spell cast credit reaches quests with an objective for the target", "[quest_objective_index]")
+{
+	QuestFixture f;
+
+	proto::QuestEntry &quest = f.AddQuest(100);
+	auto *req = quest.add_requirements();
+	req->set_objectid(7);
+	req->set_objectcount(2);
+	req->set_spellcast(42);
+
+	REQUIRE(f.player->AcceptQuest(100));
+
+	auto target = std::make_shared<GamePlayerS>(f.project, f.timers);
+	target->Initialize();
+	target->Set<uint32>(object_fields::Entry, 8);
+
+	f.player->OnQuestSpellCastCredit(42, *target);
+	CHECK(f.GetQuestLogSlot(0).counters[0] == 0);
+
+	target->Set<uint32>(object_fields::Entry, 7);
+	f.player->OnQuestSpellCastCredit(41, *target);
+	CHECK(f.GetQuestLogSlot(0).counters[0] == 0);
+
+	f.player->OnQuestSpellCastCredit(42, *target);
+	f.player->OnQuestSpellCastCredit(42, *target);
+	CHECK(f.GetQuestLogSlot(0).counters[0] == 2);
+	CHECK(f.player->GetQuestStatus(100) == quest_status::Complete);
+}
+
+TEST_CASE("Indexed kill credit matches a full quest log scan", "[quest_objective_index]")
+{
+	QuestFixture f;
+
+	constexpr uint32 creatureCount = 10;
+	constexpr uint32 questCount = 40;
+
+	std::vector<const proto::UnitEntry*> units;
+	for (uint32 id = 1; id <= creatureCount; ++id)
+	{
+		units.push_back(&f.AddUnit(id));
+	}
+
+	// Quests with up to four kill objectives for different creatures
+	std::mt19937 rng(1337);
+	for (uint32 id = 1; id <= questCount; ++id)
+	{
+		proto::QuestEntry &quest = f.AddQuest(id);
+		const uint32 objectiveCount = 1 + rng() % 4;
+		const uint32 firstCreature = 1 + rng() % creatureCount;
+		for (uint32 i = 0; i < objectiveCount; ++i)
+		{
+			auto *req = quest.add_requirements();
+			req->set_creatureid(1 + (firstCreature + i * 3) % creatureCount);
+			req->set_creaturecount(1 + rng() % 6);
+		}
+	}
+
+	ReferenceQuestLog reference { f.project };
+	for (uint32 step = 0; step < 5000; ++step)
+	{
+		const uint32 action = rng() % 10;
+		if (action == 0)
+		{
+			const uint32 questId = 1 + rng() % questCount;
+			const bool accepted = reference.Accept(questId);
+			REQUIRE(f.player->AcceptQuest(questId) == accepted);
+		}
+		else if (action == 1)
+		{
+			const uint32 questId = 1 + rng() % questCount;
+			REQUIRE(f.player->AbandonQuest(questId) == reference.Abandon(questId));
+		}
+		else
+		{
+			const proto::UnitEntry &unit = *units[rng() % creatureCount];
+			f.player->OnQuestKillCredit(step, unit);
+			reference.KillCredit(unit.id());
+		}
+
+		for (uint8 slot = 0; slot < MaxQuestLogSize; ++slot)
+		{
+			const QuestField field = f.GetQuestLogSlot(slot);
+			const ReferenceQuestLog::Slot &expected = reference.slots[slot];
+			REQUIRE(field.questId == expected.questId);
+			if (expected.questId == 0)
+			{
+				continue;
+			}
+
+			REQUIRE(field.status == expected.status);
+			for (uint8 i = 0; i < 4; ++i)
+			{
+				REQUIRE(field.counters[i] == expected.counters[i]);
+			}
+		}
+	}
+}
@@ -0,0 +1,178 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+// SpawnScheduler tests.
+//
+// Creature spawns are executed by the world's spawn scheduler at the start of a world tick. These tests verify that
+// the initial population is spread over several ticks by the time budget, that watchers receive a single spawn
+// notification per batch, that deactivating a spawner cancels its pending spawns and that disabling respawn keeps
+// the pending initial population.
+
+#include "game_server/objects/game_creature_s.h"
+#include "game_server/objects/game_player_s.h"
+#include "game_server/world/creature_spawner.h"
+#include "game_server/world/spawn_scheduler.h"
+#include "game_server/world/tile_subscriber.h"
+#include "game_server/world/visibility_grid.h"
+#include "game_server/world/visibility_tile.h"
+#include "game_server/world/regular_update.h"
+#include "shared/proto_data/maps.pb.h"
+#include "shared/proto_data/units.pb.h"
+
+#include "world_fixture.h"
+#include "catch.hpp"
+
+#include <memory>
+#include <vector>
+
+using namespace mmo;
+
+namespace
+{
+	/// Records the spawn notifications a player in the world would receive.
+	struct RecordingSubscriber final : TileSubscriber
+	{
+		explicit RecordingSubscriber(GameUnitS& unit)
+			: unit(unit)
+		{
+		}
+
+		GameUnitS& GetGameUnit() const override { return unit; }
+		void NotifyObjectsUpdated(const std::vector<GameObjectS*>&) override {}
+		void NotifyObjectsSpawned(const std::vector<GameObjectS*>& objects) override { spawnNotifications.push_back(objects.size()); }
+		void NotifyObjectsDespawned(const std::vector<GameObjectS*>&) override {}
+		GameTime ClientToServerTime(const GameTime clientTimestamp) const override { return clientTimestamp; }
+		GameTime ServerToClientTime(const GameTime serverTimestamp) const override { return serverTimestamp; }
+		bool HasReceivedTimeSyncResponse() const override { return true; }
+		void SendPacket(game::Protocol::OutgoingPacket&, const std::vector<char>&, bool) override {}
+
+		GameUnitS& unit;
+		std::vector<size_t> spawnNotifications;
+	};
+
+	struct SpawnFixture : WorldFixture
+	{
+		proto::UnitEntry unitEntry;
+		proto::UnitSpawnEntry spawnEntry;
+
+		SpawnFixture()
+		{
+			// Tests which don't care about the budget must not depend on the speed of the machine
+			world.GetSpawnScheduler().SetBudget(std::chrono::seconds(10));
+
+			unitEntry.set_id(1);
+			unitEntry.set_minlevel(1);
+			unitEntry.set_maxlevel(1);
+
+			spawnEntry.set_unitentry(1);
+			spawnEntry.set_isactive(true);
+			spawnEntry.set_respawn(true);
+			spawnEntry.set_respawndelay(30000);
+			spawnEntry.set_health_percent(1.0f);
+		}
+
+		std::unique_ptr<CreatureSpawner> MakeSpawner(const uint32 count)
+		{
+			spawnEntry.set_maxcount(count);
+			return std::make_unique<CreatureSpawner>(world, unitEntry, spawnEntry);
+		}
+
+		void Tick()
+		{
+			world.Update(RegularUpdate(GetAsyncTimeMs(), 0.03f));
+		}
+	};
+}
+
+TEST_CASE("Creature spawners do not spawn their population in the constructor", "[spawn_scheduler]")
+{
+	SpawnFixture f;
+	const auto spawner = f.MakeSpawner(4);
+
+	CHECK(spawner->GetCreatures().empty());
+	CHECK(f.world.GetSpawnScheduler().GetPendingCount() == 4);
+
+	f.Tick();
+	CHECK(spawner->GetCreatures().size() == 4);
+	CHECK(f.world.GetSpawnScheduler().GetPendingCount() == 0);
+}
+
+TEST_CASE("The spawn budget spreads the initial population over several ticks", "[spawn_scheduler]")
+{
+	SpawnFixture f;
+
+	// No budget at all still guarantees one spawn per tick
+	f.world.GetSpawnScheduler().SetBudget(std::chrono::steady_clock::duration::zero());
+	const auto spawner = f.MakeSpawner(3);
+
+	for (size_t tick = 1; tick <= 3; ++tick)
+	{
+		f.Tick();
+		CHECK(spawner->GetCreatures().size() == tick);
+	}
+
+	f.Tick();
+	CHECK(spawner->GetCreatures().size() == 3);
+}
+
+TEST_CASE("Watchers receive one spawn notification per batch", "[spawn_scheduler]")
+{
+	SpawnFixture f;
+
+	auto player = std::make_shared<GamePlayerS>(f.project, f.timers);
+	player->Initialize();
+	player->Set<uint64>(object_fields::Guid, f.objectIds.GenerateId());
+
+	TileIndex2D tileIndex;
+	REQUIRE(f.world.GetGrid().GetTilePosition(Vector3::Zero, tileIndex[0], tileIndex[1]));
+
+	RecordingSubscriber subscriber(*player);
+	f.world.GetGrid().RequireTile(tileIndex).GetWatchers().add(&subscriber);
+
+	const auto spawner = f.MakeSpawner(8);
+	f.Tick();
+
+	REQUIRE(subscriber.spawnNotifications.size() == 1);
+	CHECK(subscriber.spawnNotifications.front() == 8);
+
+	f.world.GetGrid().RequireTile(tileIndex).GetWatchers().remove(&subscriber);
+}
+
+TEST_CASE("Deactivating a spawner cancels its scheduled spawns", "[spawn_scheduler]")
+{
+	SpawnFixture f;
+	const auto spawner = f.MakeSpawner(5);
+	REQUIRE(f.world.GetSpawnScheduler().GetPendingCount() == 5);
+
+	spawner->SetState(false);
+	CHECK(f.world.GetSpawnScheduler().GetPendingCount() == 0);
+
+	f.Tick();
+	CHECK(spawner->GetCreatures().empty());
+
+	// Activating it again spawns the whole population right away
+	spawner->SetState(true);
+	CHECK(spawner->GetCreatures().size() == 5);
+}
+
+TEST_CASE("Disabling respawn only cancels scheduled respawns", "[spawn_scheduler]")
+{
+	SpawnFixture f;
+
+	// Spawn only one creature of the initial population per tick, so that the rest of it is still pending
+	f.world.GetSpawnScheduler().SetBudget(std::chrono::steady_clock::duration::zero());
+	const auto spawner = f.MakeSpawner(3);
+	f.Tick();
+	REQUIRE(spawner->GetCreatures().size() == 1);
+
+	// Keep the creature alive until the world is done removing it
+	const auto creature = spawner->GetCreatures().front();
+	f.world.RemoveGameObject(*creature);
+	REQUIRE(f.world.GetSpawnScheduler().GetPendingCount() == 3);
+
+	spawner->SetRespawn(false);
+	CHECK(f.world.GetSpawnScheduler().GetPendingCount() == 2);
+
+	f.Tick();
+	f.Tick();
+	CHECK(spawner->GetCreatures().size() == 2);
+	CHECK(f.world.GetSpawnScheduler().GetPendingCount() == 0);
+}
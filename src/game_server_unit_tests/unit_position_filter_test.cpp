@@ -0,0 +1,221 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "game_server/world/unit_position_filter.h"
+#include "game_server/world/tiled_unit_finder.h"
+#include "game_server/world/tiled_unit_finder_tile.h"
+#include "game_server/objects/game_player_s.h"
+#include "base/timer_queue.h"
+#include "game/circle.h"
+#include "game/movement_info.h"
+#include "shared/proto_data/project.h"
+#include "asio/io_service.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace mmo;
+
+namespace
+{
+	std::vector<uint32> NaiveRadius(const std::vector<float>& x, const std::vector<float>& z, const float cx, const float cz, const float radius)
+	{
+		std::vector<uint32> result;
+		for (size_t i = 0; i < x.size(); ++i)
+		{
+			if (Circle(cx, cz, radius).IsPointInside(Point(x[i], z[i])))
+			{
+				result.push_back(static_cast<uint32>(i));
+			}
+		}
+
+		return result;
+	}
+
+	struct UnitFinderFixture
+	{
+		asio::io_service io;
+		TimerQueue timers{ io };
+		proto::Project project;
+		TiledUnitFinder finder{ 33.3333f };
+		std::vector<std::shared_ptr<GamePlayerS>> units;
+
+		GamePlayerS& AddUnit(const Vector3& position, const Radian& facing = Radian(0.0f))
+		{
+			auto unit = std::make_shared<GamePlayerS>(project, timers);
+			unit->Initialize();
+
+			MovementInfo info;
+			info.position = position;
+			info.facing = facing;
+			unit->ApplyMovementInfo(info);
+
+			finder.AddUnit(*unit);
+			units.push_back(unit);
+			return *unit;
+		}
+
+		void SpawnRandomUnits(const size_t count, const float halfExtent, const uint32 seed)
+		{
+			std::mt19937 rng(seed);
+			std::uniform_real_distribution<float> dist(-halfExtent, halfExtent);
+			for (size_t i = 0; i < count; ++i)
+			{
+				AddUnit(Vector3(dist(rng), 0.0f, dist(rng)));
+			}
+		}
+	};
+}
+
+TEST_CASE("FilterPointsInRadius matches Circle::IsPointInside", "[unit_finder]")
+{
+	std::mt19937 rng(1337);
+	std::uniform_real_distribution<float> dist(-50.0f, 50.0f);
+
+	// Use an odd count so that the scalar tail after the vectorized loop is covered as well
+	std::vector<float> x(1027), z(1027);
+	for (size_t i = 0; i < x.size(); ++i)
+	{
+		x[i] = dist(rng);
+		z[i] = dist(rng);
+	}
+
+	std::vector<uint32> indices;
+	FilterPointsInRadius(x.data(), z.data(), x.size(), 3.0f, -7.5f, 20.0f, indices);
+
+	CHECK(indices == NaiveRadius(x, z, 3.0f, -7.5f, 20.0f));
+}
+
+TEST_CASE("FilterPointsInRadius excludes points on the border", "[unit_finder]")
+{
+	const std::vector<float> x = { 10.0f, 0.0f, -10.0f, 0.0f, 9.99f };
+	const std::vector<float> z = { 0.0f, 10.0f, 0.0f, -10.0f, 0.0f };
+
+	std::vector<uint32> indices;
+	FilterPointsInRadius(x.data(), z.data(), x.size(), 0.0f, 0.0f, 10.0f, indices);
+
+	REQUIRE(indices.size() == 1);
+	CHECK(indices[0] == 4);
+}
+
+TEST_CASE("FilterPointsInCone only returns points in front of the apex", "[unit_finder]")
+{
+	// In front, behind, left, right, apex, just inside a 90 degree cone, just outside, out of range
+	const std::vector<float> x = { 5.0f, -5.0f, 0.0f, 0.0f, 0.0f, 5.0f, 5.0f, 25.0f };
+	const std::vector<float> z = { 0.0f, 0.0f, -5.0f, 5.0f, 0.0f, 4.9f, 5.1f, 0.0f };
+
+	std::vector<uint32> indices;
+	FilterPointsInCone(x.data(), z.data(), x.size(), 0.0f, 0.0f, 20.0f, 1.0f, 0.0f, std::cos(Pi * 0.25f), indices);
+
+	CHECK(indices == std::vector<uint32>{ 0, 4, 5 });
+}
+
+TEST_CASE("TiledUnitFinder radius queries match callback queries", "[unit_finder]")
+{
+	UnitFinderFixture fixture;
+	fixture.SpawnRandomUnits(500, 150.0f, 42);
+
+	const Circle shape(12.0f, -20.0f, 45.0f);
+
+	std::vector<GameUnitS*> expected;
+	fixture.finder.FindUnits(shape, [&expected](GameUnitS& unit)
+	{
+		expected.push_back(&unit);
+		return true;
+	});
+
+	std::vector<GameUnitS*> found;
+	fixture.finder.FindUnitsInRadius(shape, found);
+
+	REQUIRE(!expected.empty());
+	CHECK(found == expected);
+}
+
+TEST_CASE("TiledUnitFinder snapshots follow unit movement", "[unit_finder]")
+{
+	UnitFinderFixture fixture;
+	GamePlayerS& unit = fixture.AddUnit(Vector3(0.0f, 0.0f, 0.0f));
+
+	std::vector<GameUnitS*> found;
+	fixture.finder.FindUnitsInRadius(Circle(0.0f, 0.0f, 5.0f), found);
+	REQUIRE(found.size() == 1);
+
+	// Move the unit within the same tile and report the movement like the world instance does
+	const Vector3 previous = unit.GetPosition();
+	MovementInfo info = unit.GetMovementInfo();
+	info.position = Vector3(10.0f, 0.0f, 0.0f);
+	unit.ApplyMovementInfo(info);
+	fixture.finder.UpdatePosition(unit, previous);
+
+	found.clear();
+	fixture.finder.FindUnitsInRadius(Circle(0.0f, 0.0f, 5.0f), found);
+	CHECK(found.empty());
+
+	fixture.finder.FindUnitsInRadius(Circle(10.0f, 0.0f, 5.0f), found);
+	CHECK(found.size() == 1);
+}
+
+TEST_CASE("TiledUnitFinder cone queries respect direction and arc", "[unit_finder]")
+{
+	UnitFinderFixture fixture;
+	GamePlayerS& front = fixture.AddUnit(Vector3(5.0f, 0.0f, 0.0f));
+	fixture.AddUnit(Vector3(-5.0f, 0.0f, 0.0f));
+	fixture.AddUnit(Vector3(0.0f, 0.0f, 8.0f));
+
+	std::vector<GameUnitS*> found;
+	fixture.finder.FindUnitsInCone(Circle(0.0f, 0.0f, 10.0f), Vector3::UnitX, Radian(Pi * 0.5f), found);
+
+	REQUIRE(found.size() == 1);
+	CHECK(found[0] == &front);
+}
+
+TEST_CASE("Benchmark 20-target AoE queries among 2k units", "[unit_finder][!benchmark]")
+{
+	UnitFinderFixture fixture;
+
+	// 2000 units on a 300x300 area with a radius of 17 yields about 20 units per query on average
+	fixture.SpawnRandomUnits(2000, 150.0f, 7);
+	constexpr float radius = 17.0f;
+
+	std::mt19937 rng(99);
+	std::uniform_real_distribution<float> dist(-130.0f, 130.0f);
+	std::vector<Circle> casts;
+	for (int i = 0; i < 256; ++i)
+	{
+		casts.emplace_back(dist(rng), dist(rng), radius);
+	}
+
+	BENCHMARK("FindUnits with callback")
+	{
+		size_t total = 0;
+		for (const Circle& cast : casts)
+		{
+			std::vector<GameUnitS*> targets;
+			fixture.finder.FindUnits(cast, [&targets](GameUnitS& unit)
+			{
+				targets.push_back(&unit);
+				return true;
+			});
+			total += targets.size();
+		}
+		return total;
+	};
+
+	std::vector<GameUnitS*> buffer;
+	BENCHMARK("FindUnitsInRadius with snapshot")
+	{
+		size_t total = 0;
+		fixture.finder.InvalidatePositionSnapshots();
+		for (const Circle& cast : casts)
+		{
+			buffer.clear();
+			fixture.finder.FindUnitsInRadius(cast, buffer);
+			total += buffer.size();
+		}
+		return total;
+	};
+}
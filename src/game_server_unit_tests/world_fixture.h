@@ -0,0 +1,38 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+// Minimal world instance setup shared by the game server unit tests.
+// Header-only — include in test translation units only.
+
+#pragma once
+
+#include "game_server/world/world_instance.h"
+#include "game_server/world/world_instance_manager.h"
+#include "game_server/world/universe.h"
+#include "game_server/trigger_handler.h"
+#include "game_server/condition_mgr.h"
+#include "base/timer_queue.h"
+#include "shared/proto_data/project.h"
+#include "asio/io_service.hpp"
+
+namespace mmo
+{
+	/// Trigger handler which ignores all triggers.
+	struct StubTriggerHandler final : ITriggerHandler
+	{
+		void ExecuteTrigger(const proto::TriggerEntry&, TriggerContext, uint32, bool) override {}
+	};
+
+	/// Owns an empty project and a single world instance of map 0 without map data. Tests derive from this to add
+	///	the project entries and objects they need.
+	struct WorldFixture
+	{
+		asio::io_service io;
+		TimerQueue timers{ io };
+		proto::Project project;
+		Universe universe{ io, timers };
+		IdGenerator<uint64> objectIds{ 1 };
+		StubTriggerHandler triggerHandler;
+		ConditionMgr conditionMgr{ project.conditions };
+		WorldInstanceManager manager{ io, universe, project, objectIds, triggerHandler, conditionMgr };
+		WorldInstance& world = manager.CreateInstance(0);
+	};
+}
@@ -57,6 +57,8 @@ int main(int argc, char *argv[])
 #include "updater/prepare_parameters.h"
 #include "updater/update_parameters.h"
 #include "updater/prepare_update.h"
+#include "updater/perform_update.h"
+#include "updater/prepared_update.h"
 #include "updater/updater_progress_handler.h"
 #include "updater/prepare_progress_handler.h"
 #include "updater/update_application.h"
@@ -131,23 +133,12 @@ namespace mmo
 			{
 				std::scoped_lock guiLock{ m_guiMutex };
 
-				// Increment download counter
-				if (loaded >= size)
-				{
-					updated += loaded;
-				}
-
 				// Status string
 				std::stringstream statusStream;
 				statusStream << "Updating...";
 				SetDlgItemTextA(dialogHandle, IDC_STATUS_LABEL, statusStream.str().c_str());
 
-				const auto loadedMB = static_cast<float>(loaded) / 1024.0f / 1024.0f;
-				const auto sizeMB = static_cast<float>(size) / 1024.0f / 1024.0f;
-
-				// Progress bar
-				int percent = static_cast<int>(static_cast<float>(updated) / static_cast<float>(updateSize) * 100.0f);
-				SendMessageA(GetDlgItem(dialogHandle, IDC_PROGRESS_BAR), PBM_SETPOS, percent, 0);
+				// The progress bar shows the progress of the whole update, see performUpdateThread
 
 				// Log file process
 				if (loaded >= size)
@@ -425,73 +416,53 @@ namespace mmo
 			}
 
 			{
-				asio::io_service dispatcher;
+				// Without self update, the launcher executable is skipped
+				mmo::updating::PreparedUpdate filesUpdate;
+				filesUpdate.estimates = preparedUpdate.estimates;
 				for (const auto & step : preparedUpdate.steps)
 				{
-					dispatcher.post(
-					    [&]()
+					if (!isSelfUpdateEnabled)
 					{
-						std::string errorMessage;
 						try
 						{
-							if (!isSelfUpdateEnabled)
+							if (std::filesystem::equivalent(
+							            step.destinationPath,
+							            selfExecutablePath
+							        ))
 							{
-								try
-								{
-									if (std::filesystem::equivalent(
-									            step.destinationPath,
-									            selfExecutablePath
-									        ))
-									{
-										return;
-									}
-								}
-								catch (const std::filesystem::filesystem_error &)
-								{
-									//ignore
-								}
+								continue;
 							}
-
-							while (!g_shouldQuit && step.step(updateParameters)) {
-								;
-							}
-
-							return;
 						}
-						catch (const std::exception &ex)
+						catch (const std::filesystem::filesystem_error &)
 						{
-							errorMessage = ex.what();
-						}
-						catch (...)
-						{
-							errorMessage = "Caught an exception not derived from std::exception";
+							//ignore
 						}
+					}
 
-						dispatcher.stop();
-						dispatcher.post([errorMessage]()
-						{
-							//throw std::runtime_error(errorMessage);
-						});
-					});
+					filesUpdate.steps.push_back(step);
 				}
 
-				std::vector<std::thread> threads;
-				std::generate_n(
-				    std::back_inserter(threads),
-				    updatePerformanceConcurrency,
-					[&dispatcher]() {
-						return std::thread([&dispatcher] {
-							dispatcher.run();
-						});
-					}
+				mmo::updating::PerformUpdateOptions updateOptions;
+				updateOptions.fetchConcurrency = updatePerformanceConcurrency;
+				updateOptions.isCancelled = []() -> bool
+				{
+					return g_shouldQuit;
+				};
+				updateOptions.progress = [](const mmo::updating::UpdateProgress &progress)
+				{
+					updated = progress.updatedBytes;
+
+					const int percent = progress.updateSize > 0 ?
+						static_cast<int>(static_cast<float>(progress.updatedBytes) / static_cast<float>(progress.updateSize) * 100.0f) :
+						100;
+					SendMessageA(GetDlgItem(dialogHandle, IDC_PROGRESS_BAR), PBM_SETPOS, percent, 0);
+				};
+
+				mmo::updating::performUpdate(
+				    filesUpdate,
+				    updateParameters,
+				    updateOptions
 				);
-
-				std::for_each(
-				    threads.begin(),
-				    threads.end(),
-				    std::bind(&std::thread::join, std::placeholders::_1));
-
-				dispatcher.run();
 			}
 
 			if (g_shouldQuit)
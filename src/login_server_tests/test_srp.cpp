@@ -3,6 +3,7 @@
 
 #include "catch.hpp"
 
+#include "auth_protocol/srp_client.h"
 #include "auth_protocol/srp_server.h"
 #include "base/big_number.h"
 #include "base/sha1.h"
@@ -254,4 +255,40 @@ TEST_CASE("SRP6-A round-trip survives leading-zero ephemerals", "[srp]")
     }
 }
 
+TEST_CASE("SrpClient round-trip: SrpServer accepts the proof and both derive the same key", "[srp]")
+{
+    auto [s, v] = deriveVerifier("TESTACCOUNT", "PASSWORD");
+
+    // The client uppercases the credentials itself, like the game client does
+    SrpClient client("testaccount", "password");
+    REQUIRE(client.GetAccountName() == "TESTACCOUNT");
+
+    for (int iteration = 0; iteration < 64; ++iteration)
+    {
+        SrpServer server(s, v);
+        const SrpChallenge challenge = server.GenerateChallenge();
+
+        const SrpProof proof = client.CalculateProof(challenge.B, challenge.s);
+        auto result = server.VerifyProof(proof.A, proof.m1, client.GetAccountName());
+
+        INFO("iteration " << iteration);
+        REQUIRE(result.has_value());
+        CHECK(client.VerifyServerProof(result->m2));
+        CHECK(client.GetSessionKey() == result->K);
+    }
+}
+
+TEST_CASE("SrpClient with a wrong password is rejected", "[srp]")
+{
+    auto [s, v] = deriveVerifier("TESTACCOUNT", "PASSWORD");
+
+    SrpServer server(s, v);
+    const SrpChallenge challenge = server.GenerateChallenge();
+
+    SrpClient client("TESTACCOUNT", "WRONG");
+    const SrpProof proof = client.CalculateProof(challenge.B, challenge.s);
+
+    CHECK_FALSE(server.VerifyProof(proof.A, proof.m1, client.GetAccountName()).has_value());
+}
+
 } // namespace mmo
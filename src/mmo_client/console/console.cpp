@@ -720,6 +720,18 @@ namespace mmo
 				yOffset += lineHeight;
 			}
 
+			// UI draw calls and lua event handler calls
+			{
+				const auto& uiStats = FrameManager::Get().GetBatcher().GetFrameStats();
+				const auto& eventStats = FrameManager::Get().GetEventStats();
+				std::ostringstream strm;
+				strm << "UI: " << uiStats.drawCalls << " draws, " << uiStats.uploadedBatches << " uploads, "
+					<< uiStats.cpuTimeMicroseconds << " us   Lua: " << eventStats.luaCalls << " calls for "
+					<< eventStats.triggeredEvents << " events";
+				s_consoleFont->DrawText(strm.str(), Point(xPadding, yOffset), *s_perfTextGeom, 1.0f, Color(0.7f, 0.7f, 0.7f));
+				yOffset += lineHeight;
+			}
+
 			// Separator
 			yOffset += 2.0f;
 			s_consoleFont->DrawText("----------------------------------------------", Point(xPadding, yOffset), *s_perfTextGeom, 1.0f, Color(0.4f, 0.4f, 0.4f));
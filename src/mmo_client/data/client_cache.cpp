@@ -3,7 +3,9 @@
 
 #include "stream_sink.h"
 #include "stream_source.h"
+#include "log/default_log_levels.h"
 #include "assets/asset_registry.h"
+#include "event_loop.h"
 #include "net/realm_connector.h"
 
 #include "game/item.h"
@@ -19,6 +21,51 @@ namespace mmo
 	static const char* const s_questCacheFilename = "Cache/Quests.db";
 	static const char* const s_objectCacheFilename = "Cache/Objects.db";
 
+	namespace
+	{
+		template<typename Cache>
+		void LoadCache(Cache& cache, const char* filename, uint64& dataVersion, bool& hasDataVersion)
+		{
+			const auto file = AssetRegistry::OpenFile(filename);
+			if (!file)
+			{
+				return;
+			}
+
+			io::StreamSource source(*file);
+			io::Reader reader(source);
+
+			uint64 fileDataVersion = 0;
+			if (!cache.Deserialize(reader, fileDataVersion))
+			{
+				cache.Clear();
+				return;
+			}
+
+			// All caches are saved together, so a cache from different realm data can only be left over from an
+			// incomplete save and is dropped
+			if (hasDataVersion && fileDataVersion != dataVersion)
+			{
+				cache.Clear();
+				return;
+			}
+
+			dataVersion = fileDataVersion;
+			hasDataVersion = true;
+		}
+
+		template<typename Cache>
+		void SaveCache(Cache& cache, const char* filename, const uint64 dataVersion)
+		{
+			if (const auto file = AssetRegistry::CreateNewFile(filename))
+			{
+				io::StreamSink sink(*file);
+				io::Writer writer(sink);
+				cache.Serialize(writer, dataVersion);
+			}
+		}
+	}
+
 	ClientCache::ClientCache(RealmConnector& connector)
 		: m_itemCache(connector)
 		, m_creatureCache(connector)
@@ -27,68 +74,63 @@ namespace mmo
 		, m_guildCache(connector)
 		, m_objectCache(connector)
 	{
+		m_connections += connector.DataVersionReceived.connect(this, &ClientCache::OnDataVersionReceived);
+		m_connections += EventLoop::Idle.connect([this](float, GameTime)
+			{
+				FlushRequests();
+			});
 	}
 
 	bool ClientCache::Load()
 	{
-		// Initialize item cache (TODO: Try loading cache from file so we maybe won't have to ask the server next time we run the client)
-		if (const auto itemCacheFile = AssetRegistry::OpenFile(s_itemCacheFilename))
-		{
-			io::StreamSource source(*itemCacheFile);
-			io::Reader reader(source);
-			m_itemCache.Deserialize(reader);
-		}
-
-		if (const auto creatureCacheFile = AssetRegistry::OpenFile(s_creatureCacheFilename))
-		{
-			io::StreamSource source(*creatureCacheFile);
-			io::Reader reader(source);
-			m_creatureCache.Deserialize(reader);
-		}
-
-		if (const auto questCacheFile = AssetRegistry::OpenFile(s_questCacheFilename))
-		{
-			io::StreamSource source(*questCacheFile);
-			io::Reader reader(source);
-			m_questCache.Deserialize(reader);
-		}
-
-		if (const auto objectCacheFile = AssetRegistry::OpenFile(s_objectCacheFilename))
-		{
-			io::StreamSource source(*objectCacheFile);
-			io::Reader reader(source);
-			m_objectCache.Deserialize(reader);
-		}
+		// Cached entries are kept until the realm announces different template data
+		bool hasDataVersion = false;
+		LoadCache(m_itemCache, s_itemCacheFilename, m_dataVersion, hasDataVersion);
+		LoadCache(m_creatureCache, s_creatureCacheFilename, m_dataVersion, hasDataVersion);
+		LoadCache(m_questCache, s_questCacheFilename, m_dataVersion, hasDataVersion);
+		LoadCache(m_objectCache, s_objectCacheFilename, m_dataVersion, hasDataVersion);
 
 		return true;
 	}
 
 	void ClientCache::Save()
 	{
-		// Serialize caches
-		if (const auto itemCacheFile = AssetRegistry::CreateNewFile(s_itemCacheFilename))
-		{
-			io::StreamSink sink(*itemCacheFile);
-			io::Writer writer(sink);
-			m_itemCache.Serialize(writer);
-		}
-		if (const auto creatureCacheFile = AssetRegistry::CreateNewFile(s_creatureCacheFilename))
-		{
-			io::StreamSink sink(*creatureCacheFile);
-			io::Writer writer(sink);
-			m_creatureCache.Serialize(writer);
-		}
-		if (const auto questCacheFile = AssetRegistry::CreateNewFile(s_questCacheFilename))
-		{
-			io::StreamSink sink(*questCacheFile);
-			io::Writer writer(sink);
-			m_questCache.Serialize(writer);
-		}
-		if (const auto objectCacheFile = AssetRegistry::CreateNewFile(s_objectCacheFilename))
+		SaveCache(m_itemCache, s_itemCacheFilename, m_dataVersion);
+		SaveCache(m_creatureCache, s_creatureCacheFilename, m_dataVersion);
+		SaveCache(m_questCache, s_questCacheFilename, m_dataVersion);
+		SaveCache(m_objectCache, s_objectCacheFilename, m_dataVersion);
+	}
+
+	void ClientCache::FlushRequests()
+	{
+		m_itemCache.FlushRequests();
+		m_creatureCache.FlushRequests();
+		m_questCache.FlushRequests();
+		m_nameCache.FlushRequests();
+		m_guildCache.FlushRequests();
+		m_objectCache.FlushRequests();
+	}
+
+	void ClientCache::OnDataVersionReceived(const uint64 dataVersion)
+	{
+		// Unanswered queries were sent over a previous connection and will never be answered
+		m_itemCache.ResetRequests();
+		m_creatureCache.ResetRequests();
+		m_questCache.ResetRequests();
+		m_nameCache.ResetRequests();
+		m_guildCache.ResetRequests();
+		m_objectCache.ResetRequests();
+
+		if (dataVersion == m_dataVersion)
 		{
-			io::StreamSink sink(*objectCacheFile);
-			io::Writer writer(sink);
-			m_objectCache.Serialize(writer);
+			return;
 		}
+
+		ILOG("Realm data changed, clearing the client cache");
+		m_itemCache.Clear();
+		m_creatureCache.Clear();
+		m_questCache.Clear();
+		m_objectCache.Clear();
+		m_dataVersion = dataVersion;
 	}
 }
@@ -2,6 +2,7 @@
 
 #include "cache_provider.h"
 #include "base/non_copyable.h"
+#include "base/signal.h"
 
 namespace mmo
 {
@@ -17,6 +18,9 @@ namespace mmo
 
 		void Save();
 
+		/// Sends the queries of all caches which were requested since the last call. Called once per frame.
+		void FlushRequests();
+
 	public:
 		[[nodiscard]] DBItemCache& GetItemCache() override { return m_itemCache; }
 		[[nodiscard]] DBCreatureCache& GetCreatureCache() override { return m_creatureCache; }
@@ -25,6 +29,11 @@ namespace mmo
 		[[nodiscard]] DBGuildCache& GetGuildCache() override { return m_guildCache; }
 		[[nodiscard]] DBObjectCache& GetObjectCache() override { return m_objectCache; }
 
+	private:
+		/// Drops cached entries which were received from different realm data, and forgets about unanswered
+		/// queries of the previous connection.
+		void OnDataVersionReceived(uint64 dataVersion);
+
 	private:
 		DBItemCache m_itemCache;
 		DBCreatureCache m_creatureCache;
@@ -32,5 +41,10 @@ namespace mmo
 		DBNameCache m_nameCache;
 		DBGuildCache m_guildCache;
 		DBObjectCache m_objectCache;
+
+		/// Version of the realm data which the cached entries were received from.
+		uint64 m_dataVersion = 0;
+
+		scoped_connection_container m_connections;
 	};
 }
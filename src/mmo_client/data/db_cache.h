@@ -6,8 +6,12 @@
 #include "binary_io/reader.h"
 #include "version.h"
 
+#include <algorithm>
 #include <functional>
+#include <optional>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "mmo_client/net/realm_connector.h"
 
@@ -15,12 +19,37 @@ namespace mmo
 {
 	class RealmConnector;
 
+	/// Gets the type of batch query which the realm answers for a single query op code, if any.
+	constexpr std::optional<game::db_query_type::Type> GetDbQueryBatchType(const game::client_realm_packet::Type opCode)
+	{
+		switch (opCode)
+		{
+		case game::client_realm_packet::CreatureQuery:
+			return game::db_query_type::Creature;
+		case game::client_realm_packet::ItemQuery:
+			return game::db_query_type::Item;
+		case game::client_realm_packet::QuestQuery:
+			return game::db_query_type::Quest;
+		case game::client_realm_packet::ObjectQuery:
+			return game::db_query_type::Object;
+		default:
+			return std::nullopt;
+		}
+	}
+
 	template<typename T, game::client_realm_packet::Type RequestOpCode>
 	class DBCache
 	{
 	public:
 		typedef std::function<void(uint64 guid, const T&)> QueryCallback;
 
+		/// Version of the file format written by Serialize. Needs to be increased whenever the serialization of T
+		/// changes, while changes of the template data itself are detected by the data version.
+		static constexpr uint32 FormatVersion = 2;
+
+		/// Maximum number of ids sent in a single batch query packet.
+		static constexpr size_t MaxBatchSize = 255;
+
 	public:
 		DBCache(RealmConnector& realmConnector)
 			: m_realmConnector(realmConnector)
@@ -36,18 +65,11 @@ namespace mmo
 				return &it->second;
 			}
 
-			// Enqueue pending request callback
-			const auto requestIt = m_pendingRequests.find(guid);
-			if (requestIt == m_pendingRequests.end())
+			// Queue a request unless the entry has already been requested. Queued requests are sent once per frame
+			// by FlushRequests, so that all entries requested during a frame share as few packets as possible.
+			if (m_requestedGuids.insert(guid).second)
 			{
-				// Send request to server asking for entry
-				m_realmConnector.sendSinglePacket([guid](game::OutgoingPacket& packet)
-					{
-						packet.Start(RequestOpCode);
-						packet
-							<< io::write_packed_guid(guid);
-						packet.Finish();
-					});
+				m_queuedRequests.push_back(guid);
 			}
 
 			return nullptr;
@@ -73,8 +95,68 @@ namespace mmo
 			return m_cache.find(guid) != m_cache.end();
 		}
 
+		/// Sends all queued requests to the realm.
+		void FlushRequests()
+		{
+			if (m_queuedRequests.empty())
+			{
+				return;
+			}
+
+			if constexpr (GetDbQueryBatchType(RequestOpCode).has_value())
+			{
+				for (size_t offset = 0; offset < m_queuedRequests.size(); offset += MaxBatchSize)
+				{
+					const size_t count = std::min(MaxBatchSize, m_queuedRequests.size() - offset);
+					m_realmConnector.sendSinglePacket([this, offset, count](game::OutgoingPacket& packet)
+						{
+							packet.Start(game::client_realm_packet::DbQueryBatch);
+							packet
+								<< io::write<uint8>(*GetDbQueryBatchType(RequestOpCode))
+								<< io::write<uint8>(count);
+							for (size_t i = offset; i < offset + count; ++i)
+							{
+								packet << io::write_packed_guid(m_queuedRequests[i]);
+							}
+							packet.Finish();
+						});
+				}
+			}
+			else
+			{
+				for (const uint64 guid : m_queuedRequests)
+				{
+					m_realmConnector.sendSinglePacket([guid](game::OutgoingPacket& packet)
+						{
+							packet.Start(RequestOpCode);
+							packet
+								<< io::write_packed_guid(guid);
+							packet.Finish();
+						});
+				}
+			}
+
+			m_queuedRequests.clear();
+		}
+
+		/// Forgets about requests which have been sent but not answered, for example because the connection to the
+		/// realm was lost. They will be sent again when the entries are requested the next time.
+		void ResetRequests()
+		{
+			m_queuedRequests.clear();
+			m_requestedGuids.clear();
+		}
+
+		/// Removes all cached entries.
+		void Clear()
+		{
+			m_cache.clear();
+		}
+
 		void NotifyObjectResponse(uint64 guid, const T& object)
 		{
+			m_requestedGuids.erase(guid);
+
 			m_cache[guid] = object;
 			const T& objectRef = m_cache[guid];
 
@@ -87,11 +169,13 @@ namespace mmo
 			m_pendingRequests.erase(range.first, range.second);
 		}
 
-		void Serialize(io::Writer& writer)
+		/// Writes all cached entries.
+		/// @param dataVersion Version of the realm data which the entries were received from.
+		void Serialize(io::Writer& writer, uint64 dataVersion)
 		{
-			// Read file format header
+			// Write file format header
 			constexpr uint32 header = 'CDBC';
-			writer << io::write<uint32>(header) << io::write<uint32>(Revision);
+			writer << io::write<uint32>(header) << io::write<uint32>(FormatVersion) << io::write<uint64>(dataVersion);
 
 			writer << io::write<uint32>(m_cache.size());
 			for (auto& [id, object] : m_cache)
@@ -101,7 +185,9 @@ namespace mmo
 			}
 		}
 
-		bool Deserialize(io::Reader& reader)
+		/// Reads cached entries which have been written by Serialize.
+		/// @param outDataVersion Receives the version of the realm data which the entries were received from.
+		bool Deserialize(io::Reader& reader, uint64& outDataVersion)
 		{
 			// Read file format header
 			uint32 header = 0;
@@ -110,15 +196,21 @@ namespace mmo
 				return false;
 			}
 
-			// Read build version number
-			uint32 build = 0;
-			if (!(reader >> io::read<uint32>(build)))
+			// Read file format version. The client build doesn't matter, so caches survive client updates which don't
+			// change the data of any cached entry.
+			uint32 formatVersion = 0;
+			if (!(reader >> io::read<uint32>(formatVersion)))
 			{
 				return false;
 			}
 
 			// If cache is incompatible with our version, refuse to load it
-			if (build != Revision)
+			if (formatVersion != FormatVersion)
+			{
+				return false;
+			}
+
+			if (!(reader >> io::read<uint64>(outDataVersion)))
 			{
 				return false;
 			}
@@ -160,5 +252,11 @@ namespace mmo
 		RealmConnector& m_realmConnector;
 		std::unordered_map<uint64, T> m_cache;
 		std::unordered_multimap<uint64, QueryCallback> m_pendingRequests;
+
+		/// Guids which are waiting to be sent by the next FlushRequests call.
+		std::vector<uint64> m_queuedRequests;
+
+		/// Guids which have been queued or sent and not yet answered.
+		std::unordered_set<uint64> m_requestedGuids;
 	};
 }
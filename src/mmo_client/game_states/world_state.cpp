@@ -133,6 +133,14 @@ namespace mmo
 		static ConsoleVar *s_chatBubblesYellVar = nullptr;
 		static ConsoleVar *s_chatBubblesPartyVar = nullptr;
 
+		// Lua events which are triggered for every combat log entry and unit update
+		CachedLuaEvent s_damageDoneEvent("DAMAGE_DONE");
+		CachedLuaEvent s_unitHealthUpdatedEvent("UNIT_HEALTH_UPDATED");
+		CachedLuaEvent s_unitPowerUpdatedEvent("UNIT_POWER_UPDATED");
+		CachedLuaEvent s_unitLevelUpdatedEvent("UNIT_LEVEL_UPDATED");
+		CachedLuaEvent s_unitAuraUpdatedEvent("UNIT_AURA_UPDATED");
+		CachedLuaEvent s_playerAuraUpdateEvent("PLAYER_AURA_UPDATE");
+
 		String MapMouseButton(const MouseButton button)
 		{
 			if ((button & MouseButton::Left) == MouseButton::Left)
@@ -967,13 +975,14 @@ namespace mmo
 
 	void WorldState::OnPaint()
 	{
-		FrameManager::Get().Draw();
-
-		// Draw world text frames
-		for (const auto &textFrame : m_worldTextFrames)
+		// World text frames are not part of the frame tree, but are drawn on top of it with the same batcher
+		FrameManager::Get().Draw([this]()
 		{
-			textFrame->Render();
-		}
+			for (const auto &textFrame : m_worldTextFrames)
+			{
+				textFrame->Render();
+			}
+		});
 
 		// Chat bubbles are NOT drawn here: they live in the frame tree under the WorldFrame
 		// (see m_chatBubbleLayer) so they render above the 3D world but beneath the rest of the UI.
@@ -1033,6 +1042,13 @@ namespace mmo
 		m_scene = std::make_unique<OctreeScene>();
 		m_scene->SetFogRange(60.0f, 500.0f);
 
+		// Cull the world scene on all available cores
+		if (!m_cullJobs)
+		{
+			m_cullJobs = std::make_unique<JobSystem>();
+		}
+		m_scene->SetJobSystem(m_cullJobs.get());
+
 		// Create sky component to manage the sky dome and day/night cycle
 		m_skyComponent = std::make_unique<SkyComponent>(*m_scene, &m_gameTime);
 
@@ -1366,9 +1382,7 @@ namespace mmo
 		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::AttackSwingError, *this, &WorldState::OnAttackSwingError);
 
 		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::XpLog, *this, &WorldState::OnXpLog);
-		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::SpellDamageLog, *this, &WorldState::OnSpellDamageLog);
-		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::NonSpellDamageLog, *this, &WorldState::OnNonSpellDamageLog);
-		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::EnvironmentalDamageLog, *this, &WorldState::OnLogEnvironmentalDamage);
+		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::CombatLog, *this, &WorldState::OnCombatLog);
 
 		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::CreatureQueryResult, *this, &WorldState::OnCreatureQueryResult);
 		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::ItemQueryResult, *this, &WorldState::OnItemQueryResult);
@@ -1396,11 +1410,9 @@ namespace mmo
 		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::LevelUp, *this, &WorldState::OnLevelUp);
 		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::CharacterPointsReset, *this, &WorldState::OnCharacterPointsReset);
 		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::AuraUpdate, *this, &WorldState::OnAuraUpdate);
-		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::PeriodicAuraLog, *this, &WorldState::OnPeriodicAuraLog);
 		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::ActionButtons, *this, &WorldState::OnActionButtons);
 		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::QuestGiverStatus, *this, &WorldState::OnQuestGiverStatus);
 
-		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::SpellEnergizeLog, *this, &WorldState::OnSpellEnergizeLog);
 		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::TransferPending, *this, &WorldState::OnTransferPending);
 
 		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::ItemPushResult, *this, &WorldState::OnItemPushResult);
@@ -1412,9 +1424,6 @@ namespace mmo
 		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::PartyPing, *this, &WorldState::OnPartyPing);
 
 		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::RandomRollResult, *this, &WorldState::OnRandomRollResult);
-		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::AttackerStateUpdate, *this, &WorldState::OnAttackerStateUpdate);
-
-		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::SpellHealLog, *this, &WorldState::OnSpellHealLog);
 
 		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::LogoutResponse, *this, &WorldState::OnLogoutResponse);
 		m_worldPacketHandlers += m_realmConnector.RegisterAutoPacketHandler(game::realm_client_packet::MessageOfTheDay, *this, &WorldState::OnMessageOfTheDay);
@@ -3105,20 +3114,64 @@ namespace mmo
 		return PacketParseResult::Pass;
 	}
 
-	PacketParseResult WorldState::OnSpellDamageLog(game::IncomingPacket &packet)
+	PacketParseResult WorldState::OnCombatLog(game::IncomingPacket &packet)
 	{
-		uint64 targetGuid;
-		uint32 amount;
-		SpellSchool school;
-		uint8 flags;
-		uint32 spellId;
-		uint32 blocked;
-
-		if (!(packet >> io::read_packed_guid(targetGuid) >> io::read<uint32>(spellId) >> io::read<uint32>(amount) >> io::read<uint8>(school) >> io::read<uint8>(flags) >> io::read<uint32>(blocked)))
+		uint32 eventCount;
+		if (!(packet >> io::read_var_uint(eventCount)))
 		{
+			ELOG("Failed to read CombatLog packet!");
 			return PacketParseResult::Disconnect;
 		}
 
+		CombatLogEvent event;
+		for (uint32 i = 0; i < eventCount; ++i)
+		{
+			if (!(packet >> event))
+			{
+				ELOG("Failed to read event " << i << " of CombatLog packet!");
+				return PacketParseResult::Disconnect;
+			}
+
+			switch (event.type)
+			{
+			case combat_log_event::AttackerStateUpdate:
+				OnAttackerStateUpdate(event);
+				break;
+			case combat_log_event::SpellDamage:
+				OnSpellDamageLog(event);
+				break;
+			case combat_log_event::NonSpellDamage:
+				OnNonSpellDamageLog(event);
+				break;
+			case combat_log_event::EnvironmentalDamage:
+				OnLogEnvironmentalDamage(event);
+				break;
+			case combat_log_event::PeriodicAura:
+				OnPeriodicAuraLog(event);
+				break;
+			case combat_log_event::SpellHeal:
+				OnSpellHealLog(event);
+				break;
+			case combat_log_event::SpellEnergize:
+				OnSpellEnergizeLog(event);
+				break;
+			default:
+				break;
+			}
+		}
+
+		return PacketParseResult::Pass;
+	}
+
+	void WorldState::OnSpellDamageLog(const CombatLogEvent& event)
+	{
+		const uint64 targetGuid = event.targetGuid;
+		const uint32 amount = event.amount;
+		const SpellSchool school = static_cast<SpellSchool>(event.school);
+		const uint32 flags = event.flags;
+		const uint32 spellId = event.spellId;
+		const uint32 blocked = event.blocked;
+
 		String spellName = "Unknown";
 		if (const auto *spell = m_project.spells.getById(spellId))
 		{
@@ -3191,7 +3244,7 @@ namespace mmo
 		{
 			if (const auto player = ObjectMgr::GetActivePlayer())
 			{
-				FrameManager::Get().TriggerLuaEvent("DAMAGE_DONE",
+				FrameManager::Get().TriggerLuaEvent(s_damageDoneEvent.GetId(),
 					ObjectMgr::GetActivePlayerGuid(),
 					player->GetName(),
 					targetGuid,
@@ -3200,20 +3253,13 @@ namespace mmo
 					"SPELL");
 			}
 		}
-
-		return PacketParseResult::Pass;
 	}
 
-	PacketParseResult WorldState::OnNonSpellDamageLog(game::IncomingPacket &packet)
+	void WorldState::OnNonSpellDamageLog(const CombatLogEvent& event)
 	{
-		uint64 targetGuid;
-		uint32 amount;
-		DamageFlags flags;
-
-		if (!(packet >> io::read_packed_guid(targetGuid) >> io::read<uint32>(amount) >> io::read<uint8>(flags)))
-		{
-			return PacketParseResult::Disconnect;
-		}
+		const uint64 targetGuid = event.targetGuid;
+		const uint32 amount = event.amount;
+		const uint32 flags = event.flags;
 
 		std::shared_ptr<GameObjectC> target = ObjectMgr::Get<GameObjectC>(targetGuid);
 		if (target)
@@ -3227,7 +3273,7 @@ namespace mmo
 		{
 			if (const auto player = ObjectMgr::GetActivePlayer())
 			{
-				FrameManager::Get().TriggerLuaEvent("DAMAGE_DONE",
+				FrameManager::Get().TriggerLuaEvent(s_damageDoneEvent.GetId(),
 					ObjectMgr::GetActivePlayerGuid(),
 					player->GetName(),
 					targetGuid,
@@ -3242,20 +3288,16 @@ namespace mmo
 		{
 			m_playerController->GetControlledUnit()->NotifyAttackSwingEvent();
 		}
-
-		return PacketParseResult::Pass;
 	}
 
-	PacketParseResult WorldState::OnAttackerStateUpdate(game::IncomingPacket &packet)
+	void WorldState::OnAttackerStateUpdate(const CombatLogEvent& event)
 	{
-		uint64 attackerGuid, attackedGuid;
-		uint32 totalDamage, school, absorbedDamage, resistedDamage, blockedDamage;
-		VictimState victimState;
-		HitInfo hitInfo;
-		if (!(packet >> io::read_packed_guid(attackerGuid) >> io::read_packed_guid(attackedGuid) >> io::read<uint32>(hitInfo) >> io::read<uint32>(victimState) >> io::read<uint32>(totalDamage) >> io::read<uint32>(school) >> io::read<uint32>(absorbedDamage) >> io::read<uint32>(resistedDamage) >> io::read<uint32>(blockedDamage)))
-		{
-			return PacketParseResult::Disconnect;
-		}
+		const uint64 attackerGuid = event.sourceGuid;
+		const uint64 attackedGuid = event.targetGuid;
+		const uint32 totalDamage = event.amount;
+		const uint32 blockedDamage = event.blocked;
+		const uint32 victimState = event.victimState;
+		const uint32 hitInfo = event.flags;
 
 		std::shared_ptr<GameUnitC> attacker = ObjectMgr::Get<GameUnitC>(attackerGuid);
 		const bool offhandSwing = (hitInfo & hit_info::LeftSwing) != 0;
@@ -3336,7 +3378,7 @@ namespace mmo
 
 				if (totalDamage > 0 && attackerIsPlayer)
 				{
-					FrameManager::Get().TriggerLuaEvent("DAMAGE_DONE",
+					FrameManager::Get().TriggerLuaEvent(s_damageDoneEvent.GetId(),
 						attackerGuid,
 						attackerName,
 						attackedGuid,
@@ -3362,7 +3404,7 @@ namespace mmo
 		{
 			// Attacker is the local player but the attacked unit isn't in the client's range —
 			// still fire the Lua event (no world text since there's no position to attach to).
-			FrameManager::Get().TriggerLuaEvent("DAMAGE_DONE",
+			FrameManager::Get().TriggerLuaEvent(s_damageDoneEvent.GetId(),
 				attackerGuid,
 				attacker->GetName(),
 				attackedGuid,
@@ -3370,30 +3412,17 @@ namespace mmo
 				totalDamage,
 				"MELEE");
 		}
-
-		return PacketParseResult::Pass;
 	}
 
-	PacketParseResult WorldState::OnLogEnvironmentalDamage(game::IncomingPacket &packet)
+	void WorldState::OnLogEnvironmentalDamage(const CombatLogEvent& event)
 	{
-		uint64 targetGuid;
-		uint32 amount;
-		uint8 damageType;
-
-		if (!(packet >> io::read_packed_guid(targetGuid) >> io::read<uint32>(amount) >> io::read<uint8>(damageType)))
-		{
-			return PacketParseResult::Disconnect;
-		}
-
 		// Find the target unit to display floating combat text
-		std::shared_ptr<GameObjectC> target = ObjectMgr::Get<GameObjectC>(targetGuid);
+		std::shared_ptr<GameObjectC> target = ObjectMgr::Get<GameObjectC>(event.targetGuid);
 		if (target)
 		{
 			// Environmental damage is displayed in red-orange to distinguish from regular damage
-			AddWorldTextFrame(target->GetPosition(), std::to_string(amount), Color(1.0f, 0.5f, 0.0f, 1.0f), 2.0f);
+			AddWorldTextFrame(target->GetPosition(), std::to_string(event.amount), Color(1.0f, 0.5f, 0.0f, 1.0f), 2.0f);
 		}
-
-		return PacketParseResult::Pass;
 	}
 
 	PacketParseResult WorldState::OnMovementSpeedChanged(game::IncomingPacket &packet)
@@ -3619,7 +3648,7 @@ namespace mmo
 
 		if (unit->GetGuid() == ObjectMgr::GetActivePlayerGuid())
 		{
-			FrameManager::Get().TriggerLuaEvent("PLAYER_AURA_UPDATE");
+			FrameManager::Get().TriggerLuaEvent(s_playerAuraUpdateEvent.GetId());
 		}
 
 		// Notify unit-scoped frames (e.g. the target frame) when the aura set of the
@@ -3627,24 +3656,18 @@ namespace mmo
 		// only when health/power happen to change.
 		if (unit->GetGuid() == ObjectMgr::GetSelectedObjectGuid())
 		{
-			FrameManager::Get().TriggerLuaEvent("UNIT_AURA_UPDATED", "target");
+			FrameManager::Get().TriggerLuaEvent(s_unitAuraUpdatedEvent.GetId(), "target");
 		}
 
 		return PacketParseResult::Pass;
 	}
 
-	PacketParseResult WorldState::OnPeriodicAuraLog(game::IncomingPacket &packet)
+	void WorldState::OnPeriodicAuraLog(const CombatLogEvent& event)
 	{
-		uint64 targetGuid;
-		uint64 casterGuid;
-		uint32 spellId;
-		uint32 auraType;
-
-		if (!(packet >> io::read_packed_guid(targetGuid) >> io::read_packed_guid(casterGuid) >> io::read<uint32>(spellId) >> io::read<uint32>(auraType)))
-		{
-			ELOG("Failed to read PeriodicAuraLog packet!");
-			return PacketParseResult::Disconnect;
-		}
+		const uint64 targetGuid = event.targetGuid;
+		const uint64 casterGuid = event.sourceGuid;
+		const uint32 spellId = event.spellId;
+		const uint32 auraType = event.subType;
 
 		// Trigger AuraTick visualization event
 		if (const auto* spell = m_project.spells.getById(spellId))
@@ -3675,13 +3698,7 @@ namespace mmo
 				color = Color(1.0f, 1.0f, 0.0f, 1.0f);
 			}
 
-			uint32 amount;
-			if (!(packet >> io::read<uint32>(amount)))
-			{
-				ELOG("Failed to read amount from PeriodicAuraLog packet!");
-				return PacketParseResult::Disconnect;
-			}
-
+			const uint32 amount = event.amount;
 			if (casterGuid == ObjectMgr::GetActivePlayerGuid() || targetGuid == ObjectMgr::GetActivePlayerGuid())
 			{
 				if (const std::shared_ptr<GameObjectC> target = ObjectMgr::Get<GameObjectC>(targetGuid))
@@ -3695,7 +3712,7 @@ namespace mmo
 				const std::shared_ptr<GameUnitC> caster = ObjectMgr::Get<GameUnitC>(casterGuid);
 				const std::shared_ptr<GameObjectC> target = ObjectMgr::Get<GameObjectC>(targetGuid);
 
-				FrameManager::Get().TriggerLuaEvent("DAMAGE_DONE",
+				FrameManager::Get().TriggerLuaEvent(s_damageDoneEvent.GetId(),
 					casterGuid,
 					caster ? caster->GetName() : String(),
 					targetGuid,
@@ -3704,8 +3721,6 @@ namespace mmo
 					"PERIODIC");
 			}
 		}
-
-		return PacketParseResult::Pass;
 	}
 
 	PacketParseResult WorldState::OnActionButtons(game::IncomingPacket &packet)
@@ -3747,19 +3762,9 @@ namespace mmo
 		return PacketParseResult::Pass;
 	}
 
-	PacketParseResult WorldState::OnSpellEnergizeLog(game::IncomingPacket &packet)
+	void WorldState::OnSpellEnergizeLog(const CombatLogEvent& event)
 	{
-		uint64 targetGuid, casterGuid;
-		uint32 spellId, powerType, power;
-		if (!(packet >> io::read_packed_guid(targetGuid) >> io::read_packed_guid(casterGuid) >> io::read<uint32>(spellId) >> io::read<uint32>(powerType) >> io::read<uint32>(power)))
-		{
-			ELOG("Failed to read SpellEnergizeLog packet!");
-			return PacketParseResult::Disconnect;
-		}
-
 		// TODO: Combat log event
-
-		return PacketParseResult::Pass;
 	}
 
 	PacketParseResult WorldState::OnTransferPending(game::IncomingPacket &packet)
@@ -4002,17 +4007,12 @@ namespace mmo
 		return PacketParseResult::Pass;
 	}
 
-	PacketParseResult WorldState::OnSpellHealLog(game::IncomingPacket &packet)
+	void WorldState::OnSpellHealLog(const CombatLogEvent& event)
 	{
-		uint64 targetGuid, casterGuid;
-		uint32 amount;
-		bool crit;
-		uint32 spellId;
-
-		if (!(packet >> io::read_packed_guid(targetGuid) >> io::read_packed_guid(casterGuid) >> io::read<uint32>(spellId) >> io::read<uint32>(amount) >> io::read<uint8>(crit)))
-		{
-			return PacketParseResult::Disconnect;
-		}
+		const uint64 targetGuid = event.targetGuid;
+		const uint64 casterGuid = event.sourceGuid;
+		const uint32 amount = event.amount;
+		const bool crit = event.flags != 0;
 
 		// If the target or the caster is our player, we want to display the heal amount
 		if (casterGuid == ObjectMgr::GetActivePlayerGuid() || targetGuid == ObjectMgr::GetActivePlayerGuid())
@@ -4025,8 +4025,6 @@ namespace mmo
 					crit ? WorldTextAnimation::Critical : WorldTextAnimation::Normal);
 			}
 		}
-
-		return PacketParseResult::Pass;
 	}
 
 	PacketParseResult WorldState::OnItemPushResult(game::IncomingPacket &packet)
@@ -4614,17 +4612,17 @@ namespace mmo
 
 	void WorldState::OnTargetHealthChanged(uint64 monitoredGuid)
 	{
-		FrameManager::Get().TriggerLuaEvent("UNIT_HEALTH_UPDATED", "target");
+		FrameManager::Get().TriggerLuaEvent(s_unitHealthUpdatedEvent.GetId(), "target");
 	}
 
 	void WorldState::OnTargetPowerChanged(uint64 monitoredGuid)
 	{
-		FrameManager::Get().TriggerLuaEvent("UNIT_POWER_UPDATED", "target");
+		FrameManager::Get().TriggerLuaEvent(s_unitPowerUpdatedEvent.GetId(), "target");
 	}
 
 	void WorldState::OnTargetLevelChanged(uint64 monitoredGuid)
 	{
-		FrameManager::Get().TriggerLuaEvent("UNIT_LEVEL_UPDATED", "target");
+		FrameManager::Get().TriggerLuaEvent(s_unitLevelUpdatedEvent.GetId(), "target");
 	}
 	void WorldState::OnRenderShadowsChanged(ConsoleVar &var, const std::string &oldValue)
 	{
@@ -26,10 +26,12 @@
 #include "game_client/projectile_manager.h"
 
 #include "base/id_generator.h"
+#include "base/job_system.h"
 #include "world_deserializer.h"
 #include "client_data/project.h"
 #include "frame_ui/frame.h"
 #include "game/auto_attack.h"
+#include "game/combat_log.h"
 #include "paging/loaded_page_section.h"
 #include "paging/page_loader_listener.h"
 #include "paging/page_pov_partitioner.h"
@@ -335,13 +337,16 @@ namespace mmo
 
 		PacketParseResult OnXpLog(game::IncomingPacket &packet);
 
-		PacketParseResult OnSpellDamageLog(game::IncomingPacket &packet);
+		/// Handles all combat log events of a server tick and dispatches them to the event handlers below.
+		PacketParseResult OnCombatLog(game::IncomingPacket &packet);
 
-		PacketParseResult OnNonSpellDamageLog(game::IncomingPacket &packet);
+		void OnSpellDamageLog(const CombatLogEvent& event);
 
-		PacketParseResult OnAttackerStateUpdate(game::IncomingPacket &packet);
+		void OnNonSpellDamageLog(const CombatLogEvent& event);
 
-		PacketParseResult OnLogEnvironmentalDamage(game::IncomingPacket &packet);
+		void OnAttackerStateUpdate(const CombatLogEvent& event);
+
+		void OnLogEnvironmentalDamage(const CombatLogEvent& event);
 
 		PacketParseResult OnMovementSpeedChanged(game::IncomingPacket &packet);
 
@@ -355,13 +360,13 @@ namespace mmo
 
 		PacketParseResult OnAuraUpdate(game::IncomingPacket &packet);
 
-		PacketParseResult OnPeriodicAuraLog(game::IncomingPacket &packet);
+		void OnPeriodicAuraLog(const CombatLogEvent& event);
 
 		PacketParseResult OnActionButtons(game::IncomingPacket &packet);
 
 		PacketParseResult OnQuestGiverStatus(game::IncomingPacket &packet);
 
-		PacketParseResult OnSpellEnergizeLog(game::IncomingPacket &packet);
+		void OnSpellEnergizeLog(const CombatLogEvent& event);
 
 		PacketParseResult OnTransferPending(game::IncomingPacket &packet);
 
@@ -380,7 +385,7 @@ namespace mmo
 
 		PacketParseResult OnRandomRollResult(game::IncomingPacket &packet);
 
-		PacketParseResult OnSpellHealLog(game::IncomingPacket &packet);
+		void OnSpellHealLog(const CombatLogEvent& event);
 
 		PacketParseResult OnItemPushResult(game::IncomingPacket &packet);
 
@@ -491,6 +496,9 @@ namespace mmo
 		ScreenLayerIt m_paintLayer;
 		scoped_connection_container m_realmConnections;
 		scoped_connection_container m_inputConnections;
+
+		/// Worker threads used by the world scene to cull in parallel. Declared before the scene so it outlives it.
+		std::unique_ptr<JobSystem> m_cullJobs;
 		std::unique_ptr<Scene> m_scene;
 		std::unique_ptr<PlayerController> m_playerController;
 		std::unique_ptr<AxisDisplay> m_debugAxis;
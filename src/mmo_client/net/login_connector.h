@@ -5,14 +5,15 @@
 #include "realm_data.h"
 
 #include "auth_protocol/auth_connector.h"
+#include "auth_protocol/srp_client.h"
 #include "base/big_number.h"
-#include "base/sha1.h"
 #include "base/signal.h"
 
 #include "asio/io_service.hpp"
 
 #include <algorithm>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -39,30 +40,14 @@ namespace mmo
 		// Internal io service
 		asio::io_service& m_ioService;
 
-		// Server srp6 numbers
-		BigNumber m_B;
-		BigNumber m_s;
-		BigNumber m_unk;
-
-		// Client srp6 numbers
-		BigNumber m_a;
-		BigNumber m_x;
-		BigNumber m_v;
-		BigNumber m_u;
-		BigNumber m_A;
-		BigNumber m_S;
+		/// Client side srp6 state of the current login attempt, created by the Connect method.
+		std::optional<SrpClient> m_srp;
 
 		// Session key
 		BigNumber m_sessionKey;
 
-		// Used for check
-		SHA1Hash M1hash;
-		SHA1Hash M2hash;
-
-		/// Username provided to the Connect method.
+		/// Uppercase username provided to the Connect method.
 		std::string m_accountName;
-		/// A hash that is built by the salted password provided to the Connect method.
-		SHA1Hash m_authHash;
 
 		/// Realm list infos.
 		std::vector<RealmData> m_realms;
@@ -103,9 +88,6 @@ namespace mmo
 		// ~ End IConnectorListener
 
 	private:
-		// Perform client-side srp6-a calculations after we received server values
-		void DoSRP6ACalculation();
-
 		// Handles the LogonChallenge packet from the server.
 		PacketParseResult OnLogonChallenge(auth::Protocol::IncomingPacket &packet);
 
@@ -7,6 +7,7 @@
 #include "base/constants.h"
 #include "base/random.h"
 #include "base/sha1.h"
+#include "base/utilities.h"
 #include "console/console_var.h"
 #include "game/spell_target_map.h"
 #include "game_states/login_state.h"
@@ -247,8 +248,16 @@ namespace mmo
 			m_disabledClasses.insert(classId);
 		}
 
+		uint64 dataVersion = 0;
+		if (!(packet >> io::read<uint64>(dataVersion)))
+		{
+			return PacketParseResult::Disconnect;
+		}
+
 		DLOG("Realm config received: " << static_cast<int>(numDisabledRaces) << " disabled race(s), "
-			<< static_cast<int>(numDisabledClasses) << " disabled class(es)");
+			<< static_cast<int>(numDisabledClasses) << " disabled class(es), data version " << log_hex_digit(dataVersion));
+
+		DataVersionReceived(dataVersion);
 
 		return PacketParseResult::Pass;
 	}
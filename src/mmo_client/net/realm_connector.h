@@ -38,6 +38,8 @@ namespace mmo
 		signal<void()> Disconnected;
 		/// Signal that is fired when the client failed to enter a world with a specific error reason.
 		signal<void(game::player_login_response::Type)> EnterWorldFailed;
+		/// Signal that is fired when the realm announced the version of its template data after authentication.
+		signal<void(uint64)> DataVersionReceived;
 
 		signal<void(uint32, Vector3, float)> VerifyNewWorld;
 
@@ -79,7 +81,7 @@ namespace mmo
 		///	@param packet The packet to parse.
 		PacketParseResult OnEnterWorldFailed(game::IncomingPacket& packet);
 
-		/// Handles the RealmConfig packet that carries disabled race and class IDs.
+		/// Handles the RealmConfig packet that carries disabled race and class IDs and the template data version.
 		///	@param packet The packet to parse.
 		PacketParseResult OnRealmConfig(game::IncomingPacket& packet);
 
@@ -6,6 +6,14 @@
 
 namespace mmo
 {
+	namespace
+	{
+		// Lua events which are triggered for every update of a party member or the target
+		CachedLuaEvent s_unitHealthUpdatedEvent("UNIT_HEALTH_UPDATED");
+		CachedLuaEvent s_unitPowerUpdatedEvent("UNIT_POWER_UPDATED");
+		CachedLuaEvent s_unitLevelUpdatedEvent("UNIT_LEVEL_UPDATED");
+	}
+
 	PartyInfo::PartyInfo(RealmConnector& realmConnector, DBNameCache& nameCache)
 		: m_realmConnector(realmConnector)
 		, m_nameCache(nameCache)
@@ -159,11 +167,11 @@ namespace mmo
 	{
 		ForMemberIndex(monitoredGuid, [monitoredGuid](int32 index)
 			{
-				FrameManager::Get().TriggerLuaEvent("UNIT_HEALTH_UPDATED", "party" + std::to_string(index + 1));
+				FrameManager::Get().TriggerLuaEvent(s_unitHealthUpdatedEvent.GetId(), "party" + std::to_string(index + 1));
 
 				if (monitoredGuid == ObjectMgr::GetSelectedObjectGuid())
 				{
-					FrameManager::Get().TriggerLuaEvent("UNIT_HEALTH_UPDATED", "target");
+					FrameManager::Get().TriggerLuaEvent(s_unitHealthUpdatedEvent.GetId(), "target");
 				}
 			});
 	}
@@ -172,11 +180,11 @@ namespace mmo
 	{
 		ForMemberIndex(monitoredGuid, [monitoredGuid](int32 index)
 			{
-				FrameManager::Get().TriggerLuaEvent("UNIT_POWER_UPDATED", "party" + std::to_string(index + 1));
+				FrameManager::Get().TriggerLuaEvent(s_unitPowerUpdatedEvent.GetId(), "party" + std::to_string(index + 1));
 
 				if (monitoredGuid == ObjectMgr::GetSelectedObjectGuid())
 				{
-					FrameManager::Get().TriggerLuaEvent("UNIT_POWER_UPDATED", "target");
+					FrameManager::Get().TriggerLuaEvent(s_unitPowerUpdatedEvent.GetId(), "target");
 				}
 			});
 	}
@@ -185,11 +193,11 @@ namespace mmo
 	{
 		ForMemberIndex(monitoredGuid, [monitoredGuid](int32 index)
 			{
-				FrameManager::Get().TriggerLuaEvent("UNIT_LEVEL_UPDATED", "party" + std::to_string(index + 1));
+				FrameManager::Get().TriggerLuaEvent(s_unitLevelUpdatedEvent.GetId(), "party" + std::to_string(index + 1));
 
 				if (monitoredGuid == ObjectMgr::GetSelectedObjectGuid())
 				{
-					FrameManager::Get().TriggerLuaEvent("UNIT_LEVEL_UPDATED", "target");
+					FrameManager::Get().TriggerLuaEvent(s_unitLevelUpdatedEvent.GetId(), "target");
 				}
 			});
 	}
@@ -427,31 +435,31 @@ namespace mmo
 
 				if (groupUpdateFlags & (group_update_flags::MaxHP | group_update_flags::CurrentHP))
 				{
-					FrameManager::Get().TriggerLuaEvent("UNIT_HEALTH_UPDATED", unitName);
+					FrameManager::Get().TriggerLuaEvent(s_unitHealthUpdatedEvent.GetId(), unitName);
 
 					if (playerGuid == ObjectMgr::GetSelectedObjectGuid())
 					{
-						FrameManager::Get().TriggerLuaEvent("UNIT_HEALTH_UPDATED", "target");
+						FrameManager::Get().TriggerLuaEvent(s_unitHealthUpdatedEvent.GetId(), "target");
 					}
 				}
 
 				if (groupUpdateFlags & (group_update_flags::PowerType | group_update_flags::MaxPower | group_update_flags::CurrentPower))
 				{
-					FrameManager::Get().TriggerLuaEvent("UNIT_POWER_UPDATED", unitName);
+					FrameManager::Get().TriggerLuaEvent(s_unitPowerUpdatedEvent.GetId(), unitName);
 
 					if (playerGuid == ObjectMgr::GetSelectedObjectGuid())
 					{
-						FrameManager::Get().TriggerLuaEvent("UNIT_POWER_UPDATED", "target");
+						FrameManager::Get().TriggerLuaEvent(s_unitPowerUpdatedEvent.GetId(), "target");
 					}
 				}
 
 				if (groupUpdateFlags & group_update_flags::Level)
 				{
-					FrameManager::Get().TriggerLuaEvent("UNIT_LEVEL_UPDATED", unitName);
+					FrameManager::Get().TriggerLuaEvent(s_unitLevelUpdatedEvent.GetId(), unitName);
 
 					if (playerGuid == ObjectMgr::GetSelectedObjectGuid())
 					{
-						FrameManager::Get().TriggerLuaEvent("UNIT_LEVEL_UPDATED", "target");
+						FrameManager::Get().TriggerLuaEvent(s_unitLevelUpdatedEvent.GetId(), "target");
 					}
 				}
 			});
@@ -2,6 +2,7 @@
 
 #include "cooldown_frame.h"
 
+#include "frame_ui/frame_mgr.h"
 #include "frame_ui/geometry_helper.h"
 #include "graphics/graphics_device.h"
 #include "scene_graph/material_manager.h"
@@ -71,6 +72,9 @@ namespace mmo
 		// Trigger recreation of geometry buffer if needed
 		BufferGeometry();
 
+		// Draw the ui geometry queued so far before drawing directly
+		FrameManager::Get().GetBatcher().Flush();
+
 		// Capture graphics state before applying UI material
 		GraphicsDevice::Get().CaptureState();
 
@@ -2,6 +2,7 @@
 #include "minimap_frame.h"
 
 #include "minimap.h"
+#include "frame_ui/frame_mgr.h"
 #include "frame_ui/geometry_helper.h"
 #include "graphics/material_instance.h"
 #include "scene_graph/material_manager.h"
@@ -29,6 +30,9 @@ namespace mmo
 
 	void MinimapFrame::DrawSelf()
 	{
+		// Draw the ui geometry queued so far before drawing directly
+		FrameManager::Get().GetBatcher().Flush();
+
 		if (IsVisible(false))
 		{
 			m_minimap.RenderMinimap();
@@ -3,6 +3,7 @@
 #include "model_renderer.h"
 
 #include "frame_ui/frame.h"
+#include "frame_ui/frame_mgr.h"
 #include "frame_ui/color.h"
 #include "frame_ui/geometry_helper.h"
 
@@ -68,6 +69,9 @@ namespace mmo
 			m_frame->GetGeometryBuffer().AppendGeometry(vertices, 6);
 		}
 
+		// Draw the ui geometry queued so far before drawing directly
+		FrameManager::Get().GetBatcher().Flush();
+
 		// Capture the old graphics state (including the render target)
 		gx.CaptureState();
 
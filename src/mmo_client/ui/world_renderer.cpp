@@ -5,6 +5,7 @@
 #include "scene_graph/camera.h"
 
 #include "frame_ui/frame.h"
+#include "frame_ui/frame_mgr.h"
 #include "frame_ui/color.h"
 #include "frame_ui/geometry_helper.h"
 
@@ -84,6 +85,9 @@ namespace mmo
 			m_frame->GetGeometryBuffer().AppendGeometry(vertices, 6);
 		}
 
+		// Draw the ui geometry queued so far before drawing directly
+		FrameManager::Get().GetBatcher().Flush();
+
 		// Capture the old graphics state (including the render target)
 		gx.CaptureState();
 		gx.Reset();
@@ -39,8 +39,6 @@
 #include "tex_v1_0/header_save.h"
 #include "graphics/render_texture.h"
 
-#include "stb_dxt.h"
-
 namespace mmo
 {
 	static const ChunkMagic versionChunk = MakeChunkMagic('MVER');
@@ -0,0 +1,239 @@
+#include "catch.hpp"
+#include "test_helpers/test_scene.h"
+#include "test_helpers/test_net_client.h"
+#include "test_helpers/test_game_unit.h"
+#include "test_helpers/triangle_collidable.h"
+#include "test_helpers/simulate_movement.h"
+#include "client_data/project.h"
+#include "game/movement_type.h"
+#include "game_server/world/map_data.h"
+#include "game_server/world/movement_validator.h"
+#include "game_server/world/server_water_map.h"
+#include "math/capsule.h"
+#include "math/vector3.h"
+
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+namespace mmo
+{
+	namespace
+	{
+		/// @brief Map data with water west of the world origin. Water is looked up like the server water map does it:
+		/// the page, then the quad mask of the tile, then the surface height.
+		class LakeMapData final : public MapData
+		{
+		public:
+			LakeMapData()
+			{
+				for (const float z : { -1.0f, 1.0f })
+				{
+					const uint64 page = ServerWaterMap::GetQuadKey(-1.0f, z) / QuadsPerTile / TilesPerPage;
+					Page& lake = m_pages[page];
+					for (uint16 tile = 0; tile < TilesPerPage; ++tile)
+					{
+						lake.quadMasks[tile] = ~0ull;
+					}
+					lake.heights.assign(129 * 129, 2.0f);
+				}
+			}
+
+			bool IsInLineOfSight(const Vector3&, const Vector3&) override { return true; }
+
+			bool IsInLineOfSightEx(const Vector3&, const Vector3& posB, Vector3& hitPoint) override
+			{
+				hitPoint = posB;
+				return true;
+			}
+
+			bool CalculatePath(const Vector3&, const Vector3&, std::vector<Vector3>&) const override { return false; }
+
+			bool FindRandomPointAroundCircle(const Vector3&, float, Vector3&) const override { return false; }
+
+			bool GetWaterSurface(const Vector3& pos, float& outSurfaceY) const override
+			{
+				const uint64 quad = ServerWaterMap::GetQuadKey(pos.x, pos.z);
+				const auto pageIt = m_pages.find(quad / QuadsPerTile / TilesPerPage);
+				if (pageIt == m_pages.end())
+				{
+					return false;
+				}
+
+				const auto maskIt = pageIt->second.quadMasks.find(static_cast<uint16>(quad / QuadsPerTile % TilesPerPage));
+				if (maskIt == pageIt->second.quadMasks.end() || (maskIt->second & (1ull << (quad % QuadsPerTile))) == 0)
+				{
+					return false;
+				}
+
+				const size_t vertex = static_cast<size_t>(quad % (128 * 128));
+				const std::vector<float>& heights = pageIt->second.heights;
+				outSurfaceY = (heights[vertex] + heights[vertex + 1] + heights[vertex + 129] + heights[vertex + 130]) * 0.25f;
+				return true;
+			}
+
+			bool IsWaterDataAvailable() const override { return true; }
+
+		private:
+			static constexpr uint64 QuadsPerTile = 64;
+			static constexpr uint64 TilesPerPage = 16 * 16;
+
+			struct Page
+			{
+				std::unordered_map<uint16, uint64> quadMasks;
+				std::vector<float> heights;
+			};
+
+			std::unordered_map<uint64, Page> m_pages;
+		};
+
+		/// @brief Records the positions of a unit running straight ahead on a flat floor, one per heartbeat interval.
+		std::vector<Vector3> RecordRunPath(const float runSpeed, const int heartbeats, const int ticksPerHeartbeat, const float dt)
+		{
+			proto_client::Project project;
+			TestScene scene;
+			TestNetClient net;
+
+			TriangleCollidable floor;
+			floor.AddTriangle(Vector3(-50.0f, 0.0f, -50.0f), Vector3(50.0f, 0.0f, -50.0f), Vector3(-50.0f, 0.0f, 50.0f));
+			floor.AddTriangle(Vector3(50.0f, 0.0f, -50.0f), Vector3(50.0f, 0.0f, 50.0f), Vector3(-50.0f, 0.0f, 50.0f));
+			scene.SetCollidables({ &floor });
+
+			auto unit = std::make_shared<TestGameUnit>(scene, net, project, 0);
+			unit->SetSpeed(movement_type::Run, runSpeed);
+			unit->SetSpeed(movement_type::Walk, runSpeed);
+
+			const float radius = 0.35f;
+			const float halfHeight = 0.9f;
+			unit->SetColliderForTest(Capsule(Vector3(0.0f, radius, 0.0f), Vector3(0.0f, radius + halfHeight * 2.0f, 0.0f), radius));
+			if (SceneNode* node = unit->GetSceneNode())
+			{
+				node->SetPosition(Vector3::Zero);
+			}
+
+			std::vector<Vector3> path { unit->GetPosition() };
+			for (int i = 0; i < heartbeats; ++i)
+			{
+				SimulateMovement(*unit, Vector3(0.0f, 0.0f, 1.0f), ticksPerHeartbeat, dt);
+				path.push_back(unit->GetPosition());
+			}
+
+			return path;
+		}
+	}
+
+	TEST_CASE("Benchmark movement validation of 1k bots", "[movement][movement_validation][!benchmark]")
+	{
+		// Bot load: every bot sends a heartbeat every 100 ms while running through the world, a third of them swims
+		// through a lake. The bots replay the path of a unit driven by the client movement code.
+		constexpr size_t BotCount = 1000;
+		constexpr float RunSpeed = 7.0f;
+		constexpr float HeartbeatSeconds = 0.1f;
+		constexpr float MaxSpeed = RunSpeed * 1.35f;
+
+		const std::vector<Vector3> path = RecordRunPath(RunSpeed, 20, 6, 1.0f / 60.0f);
+		REQUIRE(path.back().z > 10.0f);
+
+		struct Bot
+		{
+			uint64 guid;
+			Vector3 origin;
+			Vector3 forward;
+			Vector3 side;
+			bool swimming;
+		};
+
+		std::vector<Bot> bots;
+		bots.reserve(BotCount);
+		for (size_t i = 0; i < BotCount; ++i)
+		{
+			// Spread the bots over the lake west of the origin, each running in its own direction
+			const float angle = static_cast<float>(i) * 2.39996f;
+			const Vector3 forward(std::cos(angle), 0.0f, std::sin(angle));
+			const Vector3 origin(-40.0f - static_cast<float>(i % 25) * 14.0f, 0.0f, -180.0f + static_cast<float>(i / 25) * 9.0f);
+			bots.push_back({ i + 1, origin, forward, Vector3(-forward.z, 0.0f, forward.x), i % 3 == 0 });
+		}
+
+		// Bots run back and forth along the recorded path, and each one starts at another heartbeat of it. The
+		// heartbeats of a whole round trip are prepared up front, so that only the validation is measured.
+		const size_t segment = path.size() - 1;
+		const size_t roundTrip = segment * 2;
+		std::vector<Vector3> heartbeats(roundTrip * BotCount);
+		for (size_t step = 0; step < roundTrip; ++step)
+		{
+			for (size_t i = 0; i < BotCount; ++i)
+			{
+				const Bot& bot = bots[i];
+				const size_t phase = (step + i) % roundTrip;
+				const Vector3& local = path[phase <= segment ? phase : roundTrip - phase];
+				heartbeats[step * BotCount + i] = bot.origin + bot.forward * local.z + bot.side * local.x;
+			}
+		}
+
+		size_t tick = 0;
+		auto heartbeat = [&](const size_t bot, const size_t step)
+		{
+			return heartbeats[step % roundTrip * BotCount + bot];
+		};
+
+		LakeMapData map;
+
+		BENCHMARK("Per-packet speed and water checks")
+		{
+			size_t violations = 0;
+			for (size_t i = 0; i < BotCount; ++i)
+			{
+				const Bot& bot = bots[i];
+				const Vector3& previous = heartbeat(i, tick);
+				const Vector3& position = heartbeat(i, tick + 1);
+
+				if ((position - previous).GetLength() / HeartbeatSeconds > MaxSpeed)
+				{
+					++violations;
+				}
+
+				float surfaceY = 0.0f;
+				if (bot.swimming && !map.GetWaterSurface(position, surfaceY))
+				{
+					++violations;
+				}
+			}
+
+			++tick;
+			return violations;
+		};
+
+		MovementValidator validator;
+		tick = 0;
+
+		BENCHMARK("MovementValidator")
+		{
+			size_t violations = 0;
+			for (size_t i = 0; i < BotCount; ++i)
+			{
+				const Bot& bot = bots[i];
+				const Vector3& previous = heartbeat(i, tick);
+				const Vector3& position = heartbeat(i, tick + 1);
+
+				float impliedSpeed = 0.0f;
+				if (!validator.CheckSpeed(previous, position, HeartbeatSeconds, MaxSpeed, impliedSpeed))
+				{
+					++violations;
+				}
+
+				if (bot.swimming && !validator.CheckWater(bot.guid, position, &map))
+				{
+					++violations;
+				}
+			}
+
+			++tick;
+			return violations;
+		};
+
+		const MovementValidator::Counters& counters = validator.GetCounters();
+		WARN(counters.speedChecks << " speed checks, " << counters.waterChecks << " water checks, "
+			<< counters.waterChecksSkipped << " water checks skipped");
+		CHECK(counters.violations == 0);
+	}
+}
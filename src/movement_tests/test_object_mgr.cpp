@@ -0,0 +1,218 @@
+#include "catch.hpp"
+#include "test_helpers/test_scene.h"
+#include "test_helpers/test_net_client.h"
+#include "client_data/project.h"
+#include "game_client/object_mgr.h"
+#include "game_client/game_item_c.h"
+#include "game_client/game_unit_c.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace mmo
+{
+	namespace
+	{
+		/// @brief A plain object which counts its updates.
+		class TestObject final : public GameObjectC
+		{
+		public:
+			explicit TestObject(TestScene& scene, const proto_client::Project& project, const uint64 guid)
+				: GameObjectC(scene, project, 0)
+			{
+				InitializeFieldMap();
+				m_fieldMap.SetFieldValue<uint64>(object_fields::Guid, guid);
+			}
+
+			void Update(const float deltaTime) override
+			{
+				++updateCount;
+			}
+
+			uint32 updateCount = 0;
+		};
+
+		/// @brief A unit which counts its updates instead of moving.
+		class TestUnit final : public GameUnitC
+		{
+		public:
+			explicit TestUnit(TestScene& scene, TestNetClient& net, const proto_client::Project& project, const uint64 guid)
+				: GameUnitC(scene, net, project, 0)
+			{
+				InitializeFieldMap();
+				m_fieldMap.SetFieldValue<uint64>(object_fields::Guid, guid);
+			}
+
+			void Update(const float deltaTime) override
+			{
+				++updateCount;
+			}
+
+			uint32 updateCount = 0;
+		};
+
+		/// @brief Removes all objects from the ObjectMgr when a test is done, as its state is global.
+		struct ObjectMgrFixture
+		{
+			proto_client::Project project;
+			TestScene scene;
+			TestNetClient net;
+
+			ObjectMgrFixture()
+			{
+				ObjectMgr::RemoveAllObjects();
+			}
+
+			~ObjectMgrFixture()
+			{
+				ObjectMgr::RemoveAllObjects();
+			}
+
+			std::shared_ptr<TestObject> AddObject(const uint64 guid)
+			{
+				auto object = std::make_shared<TestObject>(scene, project, guid);
+				ObjectMgr::AddObject(object);
+				return object;
+			}
+
+			std::shared_ptr<TestUnit> AddUnit(const uint64 guid)
+			{
+				auto unit = std::make_shared<TestUnit>(scene, net, project, guid);
+				ObjectMgr::AddObject(unit);
+				return unit;
+			}
+		};
+
+		std::vector<uint64> GetUnitGuids()
+		{
+			std::vector<uint64> guids;
+			ObjectMgr::ForEachUnit([&guids](const GameUnitC& unit)
+			{
+				guids.push_back(unit.GetGuid());
+			});
+
+			std::sort(guids.begin(), guids.end());
+			return guids;
+		}
+	}
+
+	TEST_CASE("ObjectMgr finds added objects by guid and type", "[object_mgr]")
+	{
+		ObjectMgrFixture fixture;
+		const auto object = fixture.AddObject(1);
+		const auto unit = fixture.AddUnit(2);
+
+		CHECK(ObjectMgr::GetObjectCount() == 2);
+		CHECK(ObjectMgr::Get<GameObjectC>(1) == object);
+		CHECK(ObjectMgr::Get<GameObjectC>(2) == unit);
+		CHECK(ObjectMgr::Get<GameUnitC>(2) == unit);
+		CHECK(ObjectMgr::Get<TestUnit>(2) == unit);
+		CHECK(ObjectMgr::Get<GameObjectC>(3) == nullptr);
+
+		// Lookups of the wrong type don't return anything
+		CHECK(ObjectMgr::Get<GameUnitC>(1) == nullptr);
+		CHECK(ObjectMgr::Get<GamePlayerC>(2) == nullptr);
+		CHECK(ObjectMgr::Get<GameItemC>(2) == nullptr);
+
+		CHECK(GetUnitGuids() == std::vector<uint64>{ 2 });
+	}
+
+	TEST_CASE("ObjectMgr keeps remaining objects reachable after removing", "[object_mgr]")
+	{
+		ObjectMgrFixture fixture;
+		for (uint64 guid = 1; guid <= 5; ++guid)
+		{
+			fixture.AddUnit(guid);
+		}
+
+		// Remove an object from the middle, the last one and one which is not known
+		ObjectMgr::RemoveObject(3);
+		ObjectMgr::RemoveObject(5);
+		ObjectMgr::RemoveObject(42);
+
+		CHECK(ObjectMgr::GetObjectCount() == 3);
+		CHECK(ObjectMgr::Get<GameUnitC>(3) == nullptr);
+		CHECK(ObjectMgr::Get<GameUnitC>(5) == nullptr);
+		for (const uint64 guid : { 1, 2, 4 })
+		{
+			REQUIRE(ObjectMgr::Get<GameUnitC>(guid) != nullptr);
+			CHECK(ObjectMgr::Get<GameUnitC>(guid)->GetGuid() == guid);
+		}
+
+		CHECK(GetUnitGuids() == std::vector<uint64>{ 1, 2, 4 });
+
+		// Removed guids can be added again
+		fixture.AddObject(3);
+		CHECK(ObjectMgr::Get<GameObjectC>(3) != nullptr);
+		CHECK(ObjectMgr::Get<GameUnitC>(3) == nullptr);
+		CHECK(GetUnitGuids() == std::vector<uint64>{ 1, 2, 4 });
+	}
+
+	TEST_CASE("ObjectMgr updates every object once", "[object_mgr]")
+	{
+		ObjectMgrFixture fixture;
+		const auto first = fixture.AddObject(1);
+		const auto second = fixture.AddUnit(2);
+		const auto third = fixture.AddObject(3);
+
+		ObjectMgr::RemoveObject(1);
+		ObjectMgr::UpdateObjects(0.1f);
+
+		CHECK(first->updateCount == 0);
+		CHECK(second->updateCount == 1);
+		CHECK(third->updateCount == 1);
+
+		ObjectMgr::RemoveAllObjects();
+		ObjectMgr::UpdateObjects(0.1f);
+
+		CHECK(ObjectMgr::GetObjectCount() == 0);
+		CHECK(second->updateCount == 1);
+	}
+
+	TEST_CASE("Benchmark ObjectMgr with 2k objects", "[object_mgr][!benchmark]")
+	{
+		ObjectMgrFixture fixture;
+
+		// Every fourth object is a unit, like creatures among the items and world objects around a player
+		constexpr uint64 ObjectCount = 2000;
+		for (uint64 guid = 1; guid <= ObjectCount; ++guid)
+		{
+			if (guid % 4 == 0)
+			{
+				fixture.AddUnit(guid);
+			}
+			else
+			{
+				fixture.AddObject(guid);
+			}
+		}
+
+		BENCHMARK("Get<GameUnitC> of all objects")
+		{
+			size_t units = 0;
+			for (uint64 guid = 1; guid <= ObjectCount; ++guid)
+			{
+				if (ObjectMgr::Get<GameUnitC>(guid))
+				{
+					++units;
+				}
+			}
+			return units;
+		};
+
+		BENCHMARK("ForEachUnit")
+		{
+			uint64 total = 0;
+			ObjectMgr::ForEachUnit([&total](const GameUnitC& unit)
+			{
+				total += unit.GetGuid();
+			});
+			return total;
+		};
+
+		BENCHMARK("UpdateObjects")
+		{
+			ObjectMgr::UpdateObjects(0.016f);
+		};
+	}
+}
@@ -0,0 +1,188 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#include "character_name_cache.h"
+
+#include "base/clock.h"
+#include "log/default_log_levels.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace mmo
+{
+	CharacterNameCache::CharacterNameCache(AsyncCharacterDatabase& asyncDatabase)
+		: m_asyncDatabase(asyncDatabase)
+	{
+	}
+
+	void CharacterNameCache::LoadAll()
+	{
+		ILOG("Loading character names...");
+		const auto startTime = GetAsyncTimeMs();
+
+		auto handler = [this, startTime](const std::optional<std::vector<CharacterNameData>>& characters)
+			{
+				if (!characters)
+				{
+					ELOG("Failed to load character names!");
+					throw std::runtime_error("Failed to load character names!");
+				}
+
+				for (const auto& character : *characters)
+				{
+					AddOrUpdate(character);
+				}
+
+				ILOG("Successfully loaded " << characters->size() << " character names in " << (GetAsyncTimeMs() - startTime) << " ms");
+				m_loaded = true;
+			};
+
+		m_asyncDatabase.asyncRequest(std::move(handler), &ICharacterDatabase::LoadCharacterNames);
+	}
+
+	const CharacterNameData* CharacterNameCache::GetByGuid(const uint64 guid) const
+	{
+		const auto it = m_charactersByGuid.find(guid);
+		return it != m_charactersByGuid.end() ? &it->second : nullptr;
+	}
+
+	const CharacterNameData* CharacterNameCache::GetByName(const String& name) const
+	{
+		const auto it = m_guidsByName.find(NormalizeName(name));
+		return it != m_guidsByName.end() ? GetByGuid(it->second) : nullptr;
+	}
+
+	void CharacterNameCache::ResolveGuid(const uint64 guid, ResolveCallback callback)
+	{
+		// Once all characters are loaded, a miss means that there is no such character
+		const auto* character = GetByGuid(guid);
+		if (character || m_loaded)
+		{
+			callback(character);
+			return;
+		}
+
+		m_pendingGuids[guid].push_back(std::move(callback));
+		FlushMisses();
+	}
+
+	void CharacterNameCache::ResolveName(const String& name, ResolveCallback callback)
+	{
+		const auto* character = GetByName(name);
+		if (character || m_loaded)
+		{
+			callback(character);
+			return;
+		}
+
+		m_pendingNames[NormalizeName(name)].push_back(std::move(callback));
+		FlushMisses();
+	}
+
+	void CharacterNameCache::ResolveCharacterId(const String& name, std::function<void(std::optional<DatabaseId>)> callback)
+	{
+		ResolveName(name, [callback = std::move(callback)](const CharacterNameData* character)
+			{
+				callback(character ? std::optional<DatabaseId>(character->guid) : std::nullopt);
+			});
+	}
+
+	void CharacterNameCache::AddOrUpdate(const CharacterNameData& data)
+	{
+		auto& character = m_charactersByGuid[data.guid];
+
+		// Renamed characters must no longer be found by their previous name
+		if (!character.name.empty())
+		{
+			m_guidsByName.erase(NormalizeName(character.name));
+		}
+
+		character = data;
+		m_guidsByName[NormalizeName(data.name)] = data.guid;
+	}
+
+	void CharacterNameCache::Remove(const uint64 guid)
+	{
+		const auto it = m_charactersByGuid.find(guid);
+		if (it == m_charactersByGuid.end())
+		{
+			return;
+		}
+
+		m_guidsByName.erase(NormalizeName(it->second.name));
+		m_charactersByGuid.erase(it);
+	}
+
+	void CharacterNameCache::FlushMisses()
+	{
+		if (m_isQueryPending || (m_pendingGuids.empty() && m_pendingNames.empty()))
+		{
+			return;
+		}
+
+		std::vector<uint64> guids;
+		guids.reserve(m_pendingGuids.size());
+		for (const auto& [guid, callbacks] : m_pendingGuids)
+		{
+			guids.push_back(guid);
+		}
+
+		std::vector<String> names;
+		names.reserve(m_pendingNames.size());
+		for (const auto& [name, callbacks] : m_pendingNames)
+		{
+			names.push_back(name);
+		}
+
+		DLOG("Resolving " << guids.size() << " character guids and " << names.size() << " character names from the database...");
+
+		auto handler = [this, guidCallbacks = std::move(m_pendingGuids), nameCallbacks = std::move(m_pendingNames)](const std::optional<std::vector<CharacterNameData>>& characters)
+			{
+				m_isQueryPending = false;
+
+				if (characters)
+				{
+					for (const auto& character : *characters)
+					{
+						AddOrUpdate(character);
+					}
+				}
+				else
+				{
+					ELOG("Failed to resolve character names!");
+				}
+
+				for (const auto& [guid, callbacks] : guidCallbacks)
+				{
+					for (const auto& callback : callbacks)
+					{
+						callback(GetByGuid(guid));
+					}
+				}
+
+				for (const auto& [name, callbacks] : nameCallbacks)
+				{
+					for (const auto& callback : callbacks)
+					{
+						callback(GetByName(name));
+					}
+				}
+
+				// Send the misses which were collected while this query was running
+				FlushMisses();
+			};
+
+		m_pendingGuids.clear();
+		m_pendingNames.clear();
+		m_isQueryPending = true;
+
+		m_asyncDatabase.asyncRequest(std::move(handler), &ICharacterDatabase::FindCharacterNames, std::move(guids), std::move(names));
+	}
+
+	String CharacterNameCache::NormalizeName(const String& name)
+	{
+		String result = name;
+		std::transform(result.begin(), result.end(), result.begin(), [](const unsigned char c) { return static_cast<char>(std::tolower(c)); });
+		return result;
+	}
+}
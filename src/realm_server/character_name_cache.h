@@ -0,0 +1,87 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "database.h"
+#include "base/non_copyable.h"
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <unordered_map>
+
+namespace mmo
+{
+	/// Keeps the name, race and class of every character of the realm in memory, so that name queries, friend
+	/// lists and guild commands can resolve characters by guid or name without a database round trip.
+	/// Loaded at startup and kept current when characters are created or deleted, so once loaded, a character
+	/// which is not cached does not exist. Lookups which miss the cache before that are collected and sent to the
+	/// database as a single query per batch.
+	class CharacterNameCache final : public NonCopyable
+	{
+	public:
+		/// Called with the resolved character, or nullptr if no such character exists. The pointer is only valid
+		/// during the call.
+		typedef std::function<void(const CharacterNameData*)> ResolveCallback;
+
+	public:
+		/// Initializes a new instance of the CharacterNameCache class.
+		/// @param asyncDatabase The database to load characters from.
+		explicit CharacterNameCache(AsyncCharacterDatabase& asyncDatabase);
+
+	public:
+		/// Loads all characters from the database.
+		void LoadAll();
+
+		/// Checks if all characters have been loaded.
+		bool IsLoaded() const { return m_loaded; }
+
+		/// Gets a cached character by guid.
+		/// @return The character or nullptr if it is not cached.
+		const CharacterNameData* GetByGuid(uint64 guid) const;
+
+		/// Gets a cached character by name. Names are compared case insensitive.
+		/// @return The character or nullptr if it is not cached.
+		const CharacterNameData* GetByName(const String& name) const;
+
+		/// Resolves a character by guid. The callback is invoked immediately if the character is cached or the
+		/// cache is loaded, otherwise after the next batch query.
+		void ResolveGuid(uint64 guid, ResolveCallback callback);
+
+		/// Resolves a character by name. The callback is invoked immediately if the character is cached or the
+		/// cache is loaded, otherwise after the next batch query.
+		void ResolveName(const String& name, ResolveCallback callback);
+
+		/// Resolves a character id by name. Drop-in replacement for IDatabase::GetCharacterIdByName.
+		void ResolveCharacterId(const String& name, std::function<void(std::optional<DatabaseId>)> callback);
+
+		/// Adds a character or updates a cached character, for example after it has been created or renamed.
+		void AddOrUpdate(const CharacterNameData& data);
+
+		/// Removes a deleted character from the cache.
+		void Remove(uint64 guid);
+
+	private:
+		/// Sends all collected misses to the database, unless a batch query is still running. Misses which occur in
+		/// the meantime are sent when it completes.
+		void FlushMisses();
+
+		static String NormalizeName(const String& name);
+
+	private:
+		AsyncCharacterDatabase& m_asyncDatabase;
+
+		std::unordered_map<uint64, CharacterNameData> m_charactersByGuid;
+
+		/// Maps lower case character names to character guids.
+		std::unordered_map<String, uint64> m_guidsByName;
+
+		std::map<uint64, std::vector<ResolveCallback>> m_pendingGuids;
+
+		std::map<String, std::vector<ResolveCallback>> m_pendingNames;
+
+		bool m_isQueryPending = false;
+
+		std::atomic<bool> m_loaded { false };
+	};
+}
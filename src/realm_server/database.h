@@ -70,6 +70,20 @@ namespace mmo
 		Radian facing{0.0f};
 	};
 
+	/// Identity of a character which other players see, for example in name queries and on friend lists.
+	struct CharacterNameData
+	{
+		uint64 guid{0};
+
+		String name;
+
+		uint32 raceId{0};
+
+		uint32 classId{0};
+
+		uint8 gender{0};
+	};
+
 	struct GroupMemberData
 	{
 		uint64 guid;
@@ -222,9 +236,20 @@ namespace mmo
 		/// Gets a character name by GUID.
 		virtual std::optional<String> GetCharacterNameById(uint64 characterId) = 0;
 
-		/// Saves inventory items for a character.
+		/// Loads the names of all characters which have not been deleted.
+		virtual std::optional<std::vector<CharacterNameData>> LoadCharacterNames() = 0;
+
+		/// Finds the characters which have one of the given ids or names in a single query. Deleted characters are
+		/// not returned.
+		virtual std::optional<std::vector<CharacterNameData>> FindCharacterNames(std::vector<uint64> characterIds, std::vector<String> characterNames) = 0;
+
+		/// Saves inventory items for a character. Items replace the items stored in the same slots, all other items
+		/// are kept.
 		virtual void SaveInventoryItems(uint64 characterId, const std::vector<ItemData>& items) = 0;
 
+		/// Replaces all inventory items of a character.
+		virtual void ReplaceInventoryItems(uint64 characterId, const std::vector<ItemData>& items) = 0;
+
 		/// Deletes inventory items for a character by slot indices.
 		virtual void DeleteInventoryItems(uint64 characterId, const std::vector<uint16>& slots) = 0;
 	};
@@ -0,0 +1,324 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#include "db_query_cache.h"
+
+#include "base/macros.h"
+#include "base/sha1.h"
+#include "base/utilities.h"
+#include "binary_io/string_sink.h"
+#include "binary_io/writer.h"
+#include "game/item.h"
+#include "game/object_info.h"
+#include "game/quest_info.h"
+#include "log/default_log_levels.h"
+#include "proto_data/project.h"
+
+#include <cstring>
+
+namespace mmo
+{
+	DbQueryCache::DbQueryCache(const proto::Project &project)
+		: m_project(project)
+		, m_dataVersion(0)
+	{
+		m_dataVersion = CalculateDataVersion();
+		ILOG("Template data version is " << log_hex_digit(m_dataVersion));
+	}
+
+	const String &DbQueryCache::GetResponse(const game::db_query_type::Type type, const uint64 id)
+	{
+		ASSERT(type < game::db_query_type::Count_);
+
+		auto &responses = m_responses[type];
+		if (const auto it = responses.find(id); it != responses.end())
+		{
+			return it->second;
+		}
+
+		String response;
+		io::StringSink sink(response);
+		io::Writer writer(sink);
+
+		bool found = false;
+		switch (type)
+		{
+		case game::db_query_type::Creature:
+			found = WriteCreature(writer, id);
+			break;
+		case game::db_query_type::Item:
+			found = WriteItem(writer, id);
+			break;
+		case game::db_query_type::Quest:
+			found = WriteQuest(writer, id);
+			break;
+		case game::db_query_type::Object:
+			found = WriteObject(writer, id);
+			break;
+		default:
+			break;
+		}
+
+		if (!found)
+		{
+			WLOG("Queried template " << log_hex_digit(id) << " of type " << type << " does not exist");
+
+			m_missingResponse.clear();
+			io::StringSink missingSink(m_missingResponse);
+			io::Writer missingWriter(missingSink);
+			missingWriter
+				<< io::write_packed_guid(id)
+				<< io::write<uint8>(false);
+			return m_missingResponse;
+		}
+
+		return responses.emplace(id, std::move(response)).first->second;
+	}
+
+	game::realm_client_packet::Type DbQueryCache::GetResultOpCode(const game::db_query_type::Type type)
+	{
+		switch (type)
+		{
+		case game::db_query_type::Creature:
+			return game::realm_client_packet::CreatureQueryResult;
+		case game::db_query_type::Item:
+			return game::realm_client_packet::ItemQueryResult;
+		case game::db_query_type::Quest:
+			return game::realm_client_packet::QuestQueryResult;
+		case game::db_query_type::Object:
+			return game::realm_client_packet::ObjectQueryResult;
+		default:
+			UNREACHABLE();
+			return game::realm_client_packet::CreatureQueryResult;
+		}
+	}
+
+	bool DbQueryCache::WriteCreature(io::Writer &writer, const uint64 id) const
+	{
+		const proto::UnitEntry *unit = m_project.units.getById(id);
+		if (unit == nullptr)
+		{
+			return false;
+		}
+
+		writer
+			<< io::write_packed_guid(unit->id())
+			<< io::write<uint8>(true)
+			<< io::write_range(unit->name()) << io::write<uint8>(0)
+			<< io::write_range(unit->subname()) << io::write<uint8>(0);
+		return true;
+	}
+
+	bool DbQueryCache::WriteItem(io::Writer &writer, const uint64 id) const
+	{
+		const proto::ItemEntry *itemEntry = m_project.items.getById(id);
+		if (!itemEntry)
+		{
+			return false;
+		}
+
+		// Map item entry
+		ItemInfo info;
+		info.name = itemEntry->name();
+		info.description = itemEntry->description();
+		info.id = id;
+		info.itemClass = itemEntry->itemclass();
+		info.itemSubclass = itemEntry->subclass();
+		info.displayId = itemEntry->displayid();
+		info.quality = itemEntry->quality();
+		info.flags = itemEntry->flags();
+		info.buyCount = itemEntry->buycount();
+		info.buyPrice = itemEntry->buyprice();
+		info.sellPrice = itemEntry->sellprice();
+		info.inventoryType = itemEntry->inventorytype();
+		info.allowedClasses = itemEntry->allowedclasses();
+		info.allowedRaces = itemEntry->allowedraces();
+		info.itemlevel = itemEntry->itemlevel();
+		info.requiredlevel = itemEntry->requiredlevel();
+		info.requiredskill = itemEntry->requiredskill();
+		info.requiredskillrank = itemEntry->requiredskillrank();
+		info.requiredspell = itemEntry->requiredspell();
+		info.requiredrep = itemEntry->requiredrep();
+		info.requiredreprank = itemEntry->requiredreprank();
+		info.requiredcityrank = itemEntry->requiredcityrank();
+		info.maxcount = itemEntry->maxcount();
+		info.maxstack = itemEntry->maxstack();
+		info.containerslots = itemEntry->containerslots();
+
+		for (int i = 0; i < 10; ++i)
+		{
+			if (i >= itemEntry->stats_size())
+			{
+				info.stats[i].type = -1;
+				info.stats[i].value = 0;
+			}
+			else
+			{
+				const auto &stat = itemEntry->stats(i);
+				info.stats[i].type = stat.type();
+				info.stats[i].value = stat.value();
+			}
+		}
+
+		info.damage.type = itemEntry->damage().type();
+		info.damage.min = itemEntry->damage().mindmg();
+		info.damage.max = itemEntry->damage().maxdmg();
+		info.attackTime = itemEntry->delay();
+
+		for (int i = 0; i < 5; ++i)
+		{
+			if (i >= itemEntry->spells_size())
+			{
+				info.spells[i].spellId = -1;
+				info.spells[i].triggertype = 0;
+			}
+			else
+			{
+				const auto &spell = itemEntry->spells(i);
+				info.spells[i].spellId = spell.spell();
+				info.spells[i].triggertype = spell.trigger();
+			}
+		}
+
+		info.armor = itemEntry->armor();
+		info.resistance[0] = itemEntry->holyres();
+		info.resistance[1] = itemEntry->fireres();
+		info.resistance[2] = itemEntry->natureres();
+		info.resistance[3] = itemEntry->frostres();
+		info.resistance[4] = itemEntry->shadowres();
+		info.resistance[5] = itemEntry->arcaneres();
+		info.ammotype = itemEntry->ammotype();
+
+		info.bonding = itemEntry->bonding();
+		info.lockid = itemEntry->lockid();
+		info.sheath = itemEntry->sheath();
+		info.randomproperty = itemEntry->randomproperty();
+		info.randomsuffix = itemEntry->randomsuffix();
+		info.block = itemEntry->block();
+		info.itemset = itemEntry->itemset();
+		info.material = itemEntry->material();
+		info.maxdurability = itemEntry->durability();
+		info.area = itemEntry->area();
+		info.extraflags = itemEntry->extraflags();
+		info.startquestid = itemEntry->questentry();
+		info.skill = itemEntry->skill();
+
+		// Set required proficiency - check item first, then fall back to subclass
+		if (itemEntry->has_requiredproficiency() && itemEntry->requiredproficiency() > 0)
+		{
+			info.requiredProficiency = itemEntry->requiredproficiency();
+		}
+		else
+		{
+			// Look up subclass to get required proficiency
+			const auto* subclass = m_project.itemSubclasses.getById(itemEntry->subclass());
+			if (subclass && subclass->has_requiredproficiency())
+			{
+				info.requiredProficiency = subclass->requiredproficiency();
+			}
+			else
+			{
+				info.requiredProficiency = 0;
+			}
+		}
+
+		writer
+			<< io::write_packed_guid(id)
+			<< io::write<uint8>(true)
+			<< info;
+		return true;
+	}
+
+	bool DbQueryCache::WriteQuest(io::Writer &writer, const uint64 id) const
+	{
+		const proto::QuestEntry *questEntry = m_project.quests.getById(id);
+		if (!questEntry)
+		{
+			return false;
+		}
+
+		// Map quest info
+		QuestInfo quest;
+		quest.id = questEntry->id();
+		quest.title = questEntry->name();
+		quest.description = questEntry->detailstext();
+		quest.summary = questEntry->objectivestext();
+
+		quest.questLevel = questEntry->questlevel();
+		quest.rewardMoney = questEntry->rewardmoney();
+		quest.rewardXp = questEntry->rewardxp();
+
+		for (const auto &requirement : questEntry->requirements())
+		{
+			if (requirement.itemid() != 0)
+			{
+				quest.requiredItems.emplace_back(requirement.itemid(), requirement.itemcount());
+			}
+			else if (requirement.creatureid() != 0)
+			{
+				quest.requiredCreatures.emplace_back(requirement.creatureid(), requirement.creaturecount());
+			}
+		}
+
+		for (const auto &reward : questEntry->rewarditems())
+		{
+			quest.rewardItems.emplace_back(reward.itemid(), reward.count());
+		}
+
+		for (const auto &reward : questEntry->rewarditemschoice())
+		{
+			quest.optionalItems.emplace_back(reward.itemid(), reward.count());
+		}
+
+		writer
+			<< io::write_packed_guid(id)
+			<< io::write<uint8>(true)
+			<< quest;
+		return true;
+	}
+
+	bool DbQueryCache::WriteObject(io::Writer &writer, const uint64 id) const
+	{
+		const proto::ObjectEntry *object = m_project.objects.getById(id);
+		if (object == nullptr)
+		{
+			return false;
+		}
+
+		ObjectInfo info;
+		info.id = id;
+		info.type = object->type();
+		info.displayId = object->displayid();
+		info.name = object->name();
+		for (int32 i = 0; i < 16; ++i)
+		{
+			info.data[i] = object->data_size() <= i ? 0 : object->data(i);
+		}
+
+		writer
+			<< io::write_packed_guid(info.id)
+			<< io::write<uint8>(true)
+			<< info;
+		return true;
+	}
+
+	uint64 DbQueryCache::CalculateDataVersion() const
+	{
+		// Hashes exactly the templates which query responses are built from
+		HashGeneratorSha1 hashGen;
+		for (const String &data : {
+			m_project.units.getTemplates().SerializeAsString(),
+			m_project.items.getTemplates().SerializeAsString(),
+			m_project.itemSubclasses.getTemplates().SerializeAsString(),
+			m_project.quests.getTemplates().SerializeAsString(),
+			m_project.objects.getTemplates().SerializeAsString() })
+		{
+			hashGen.update(data.data(), data.size());
+		}
+
+		const SHA1Hash hash = hashGen.finalize();
+
+		uint64 version = 0;
+		std::memcpy(&version, hash.data(), sizeof(version));
+		return version;
+	}
+}
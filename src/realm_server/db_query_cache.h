@@ -0,0 +1,67 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/non_copyable.h"
+#include "base/typedefs.h"
+#include "game_protocol/game_protocol.h"
+
+#include <unordered_map>
+
+namespace io
+{
+	class Writer;
+}
+
+namespace mmo
+{
+	namespace proto
+	{
+		class Project;
+	}
+
+	/// Serializes the responses to client template queries (creatures, items, quests and objects) once and shares
+	/// them between all players of the realm. Responses are built on first request and kept until shutdown, as the
+	/// project is not reloaded while the realm is running. Only used from the realm's network thread.
+	class DbQueryCache final : public NonCopyable
+	{
+	public:
+		/// Initializes a new instance of the DbQueryCache class.
+		/// @param project The project to read templates from.
+		explicit DbQueryCache(const proto::Project &project);
+
+	public:
+		/// Gets the version of the queryable template data. Clients use it to keep their query caches as long as the
+		/// data they were filled from does not change.
+		uint64 GetDataVersion() const { return m_dataVersion; }
+
+		/// Gets the serialized response to a template query. The response contains the packed id, a success flag and
+		/// the template data if the template exists, and is written as is into the query result packet.
+		const String &GetResponse(game::db_query_type::Type type, uint64 id);
+
+		/// Gets the op code of the packet which carries responses to queries of the given type.
+		static game::realm_client_packet::Type GetResultOpCode(game::db_query_type::Type type);
+
+	private:
+		bool WriteCreature(io::Writer &writer, uint64 id) const;
+
+		bool WriteItem(io::Writer &writer, uint64 id) const;
+
+		bool WriteQuest(io::Writer &writer, uint64 id) const;
+
+		bool WriteObject(io::Writer &writer, uint64 id) const;
+
+		uint64 CalculateDataVersion() const;
+
+	private:
+		const proto::Project &m_project;
+
+		uint64 m_dataVersion;
+
+		/// Responses of existing templates by query type and id. Responses for unknown ids are not cached, so that
+		/// clients can't grow the cache by querying arbitrary ids.
+		std::unordered_map<uint64, String> m_responses[game::db_query_type::Count_];
+
+		String m_missingResponse;
+	};
+}
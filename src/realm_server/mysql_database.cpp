@@ -1798,6 +1798,79 @@ namespace mmo
 		return {};
 	}
 
+	std::optional<std::vector<CharacterNameData>> MySQLDatabase::LoadCharacterNames()
+	{
+		std::lock_guard<std::recursive_mutex> dbLock(m_databaseMutex);
+
+		return SelectCharacterNames("SELECT `id`, `name`, `race`, `class`, `gender` FROM `characters` WHERE `account_id` IS NOT NULL");
+	}
+
+	std::optional<std::vector<CharacterNameData>> MySQLDatabase::FindCharacterNames(std::vector<uint64> characterIds, std::vector<String> characterNames)
+	{
+		std::lock_guard<std::recursive_mutex> dbLock(m_databaseMutex);
+
+		if (characterIds.empty() && characterNames.empty())
+		{
+			return std::vector<CharacterNameData>();
+		}
+
+		std::ostringstream strm;
+		strm << "SELECT `id`, `name`, `race`, `class`, `gender` FROM `characters` WHERE `account_id` IS NOT NULL AND (";
+
+		if (!characterIds.empty())
+		{
+			strm << "`id` IN (";
+			for (size_t i = 0; i < characterIds.size(); ++i)
+			{
+				strm << (i > 0 ? "," : "") << characterIds[i];
+			}
+			strm << ")";
+		}
+
+		if (!characterNames.empty())
+		{
+			strm << (characterIds.empty() ? "" : " OR ") << "`name` IN (";
+			for (size_t i = 0; i < characterNames.size(); ++i)
+			{
+				strm << (i > 0 ? "," : "") << "'" << m_connection.EscapeString(characterNames[i]) << "'";
+			}
+			strm << ")";
+		}
+
+		strm << ")";
+		return SelectCharacterNames(strm.str());
+	}
+
+	std::optional<std::vector<CharacterNameData>> MySQLDatabase::SelectCharacterNames(const String& query)
+	{
+		mysql::Select select(m_connection, query);
+		if (!select.Success())
+		{
+			// There was an error
+			PrintDatabaseError();
+			return {};
+		}
+
+		std::vector<CharacterNameData> result;
+
+		mysql::Row row(select);
+		while (row)
+		{
+			CharacterNameData data;
+
+			uint32 index = 0;
+			row.GetField(index++, data.guid);
+			row.GetField(index++, data.name);
+			row.GetField(index++, data.raceId);
+			row.GetField(index++, data.classId);
+			row.GetField<uint8, uint16>(index++, data.gender);
+			result.push_back(std::move(data));
+
+			row = mysql::Row::Next(select);
+		}
+
+		return result;
+	}
 
 	void MySQLDatabase::CreateGuild(uint64 id, String name, uint64 leaderGuid, const std::vector<GuildRank>& ranks, const std::vector<GuildMember>& member)
 	{
@@ -2197,83 +2270,117 @@ namespace mmo
 		try
 		{
 			mysql::Transaction transaction(m_connection);
+			UpsertInventoryItems(characterId, items);
+			transaction.Commit();
+		}
+		catch (const mysql::Exception& e)
+		{
+			ELOG("Failed to save inventory items for character " << characterId << ": " << e.what());
+			throw;
+		}
+	}
 
-			// CRITICAL: First, delete ALL existing items for this character
-			// This ensures items that were sold/destroyed are removed
-			// Buyback slots are never saved, so they won't be affected
-			std::ostringstream deleteStrm;
-			deleteStrm << "DELETE FROM `character_items` WHERE `owner` = " << characterId << ";";
-			
-			if (!m_connection.Execute(deleteStrm.str()))
-			{
-				PrintDatabaseError();
-				throw mysql::Exception("Could not delete existing inventory items!");
-			}
+	void MySQLDatabase::ReplaceInventoryItems(uint64 characterId, const std::vector<ItemData>& items)
+	{
+		std::lock_guard<std::recursive_mutex> dbLock(m_databaseMutex);
 
-			// If no items to save (empty inventory), we're done after deletion
-			if (items.empty())
-			{
-				transaction.Commit();
-				return;
-			}
+		try
+		{
+			mysql::Transaction transaction(m_connection);
 
-			// Now insert the current inventory state
-			// Use INSERT instead of REPLACE since we just deleted everything
-			std::ostringstream insertStrm;
-			insertStrm << "INSERT INTO `character_items` (`owner`, `slot`, `entry`, `creator`, `count`, `durability`, `flags`) VALUES ";
+			// Remove the items which were sold or destroyed, all other rows are updated in place below.
+			// Buyback slots are never saved, so they won't be affected
+			std::ostringstream deleteStrm;
+			deleteStrm << "DELETE FROM `character_items` WHERE `owner` = " << characterId;
 
-			bool isFirstItem = true;
+			bool isFirstSlot = true;
 			for (const auto& item : items)
 			{
-				// Don't save buyback slots into the database!
 				if (InventorySlot::FromAbsolute(item.slot).IsBuyBack())
 				{
 					continue;
 				}
 
-				if (!isFirstItem)
-				{
-					insertStrm << ",";
-				}
-				else
-				{
-					isFirstItem = false;
-				}
-
-				insertStrm << "(" << characterId << "," << item.slot << "," << item.entry << ",";
-				if (item.creator == 0)
-				{
-					insertStrm << "NULL";
-				}
-				else
-				{
-					insertStrm << item.creator;
-				}
-				insertStrm << "," << static_cast<uint16>(item.stackCount) << "," << item.durability << "," << item.flags << ")";
+				deleteStrm << (isFirstSlot ? " AND `slot` NOT IN (" : ",") << item.slot;
+				isFirstSlot = false;
 			}
 
-			insertStrm << ";";
+			if (!isFirstSlot)
+			{
+				deleteStrm << ")";
+			}
+			deleteStrm << ";";
 
-			// Only execute if we have items to save (after filtering buyback slots)
-			if (!isFirstItem)
+			if (!m_connection.Execute(deleteStrm.str()))
 			{
-				if (!m_connection.Execute(insertStrm.str()))
-				{
-					PrintDatabaseError();
-					throw mysql::Exception("Could not save inventory items!");
-				}
-				ILOG("Successfully saved inventory items for character " << characterId);
+				PrintDatabaseError();
+				throw mysql::Exception("Could not delete existing inventory items!");
 			}
 
+			UpsertInventoryItems(characterId, items);
 			transaction.Commit();
 		}
 		catch (const mysql::Exception& e)
 		{
-			ELOG("Failed to save inventory items for character " << characterId << ": " << e.what());
+			ELOG("Failed to replace inventory items for character " << characterId << ": " << e.what());
 			throw;
 		}
 	}
 
+	void MySQLDatabase::UpsertInventoryItems(uint64 characterId, const std::vector<ItemData>& items)
+	{
+		// Rows are identified by (owner, slot), so items in slots which are already stored are updated in place
+		std::ostringstream insertStrm;
+		insertStrm << "INSERT INTO `character_items` (`owner`, `slot`, `entry`, `creator`, `count`, `durability`, `flags`) VALUES ";
+
+		bool isFirstItem = true;
+		for (const auto& item : items)
+		{
+			// Don't save buyback slots into the database!
+			if (InventorySlot::FromAbsolute(item.slot).IsBuyBack())
+			{
+				continue;
+			}
+
+			if (!isFirstItem)
+			{
+				insertStrm << ",";
+			}
+			else
+			{
+				isFirstItem = false;
+			}
+
+			insertStrm << "(" << characterId << "," << item.slot << "," << item.entry << ",";
+			if (item.creator == 0)
+			{
+				insertStrm << "NULL";
+			}
+			else
+			{
+				insertStrm << item.creator;
+			}
+			insertStrm << "," << static_cast<uint16>(item.stackCount) << "," << item.durability << "," << item.flags << ")";
+		}
+
+		// Nothing to save (after filtering buyback slots)
+		if (isFirstItem)
+		{
+			return;
+		}
+
+		insertStrm << " ON DUPLICATE KEY UPDATE `entry` = VALUES(`entry`), `creator` = VALUES(`creator`), `count` = VALUES(`count`), "
+			"`durability` = VALUES(`durability`), `flags` = VALUES(`flags`);";
+
+		if (!m_connection.Execute(insertStrm.str()))
+		{
+			PrintDatabaseError();
+			throw mysql::Exception("Could not save inventory items!");
+		}
+
+		DLOG("Saved " << items.size() << " inventory items for character " << characterId);
+	}
+
 	void MySQLDatabase::DeleteInventoryItems(uint64 characterId, const std::vector<uint16>& slots)
 	{
 		std::lock_guard<std::recursive_mutex> dbLock(m_databaseMutex);
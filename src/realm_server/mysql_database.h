@@ -117,6 +117,12 @@ namespace mmo
 		/// @copydoc IDatabase::GetCharacterNameById
 		std::optional<String> GetCharacterNameById(uint64 characterId) override;
 
+		/// @copydoc IDatabase::LoadCharacterNames
+		std::optional<std::vector<CharacterNameData>> LoadCharacterNames() override;
+
+		/// @copydoc IDatabase::FindCharacterNames
+		std::optional<std::vector<CharacterNameData>> FindCharacterNames(std::vector<uint64> characterIds, std::vector<String> characterNames) override;
+
 		/// @copydoc IDatabase::CreateGuild
 		void CreateGuild(uint64 id, String name, uint64 leaderGuid, const std::vector<GuildRank>& ranks, const std::vector<GuildMember>& member) override;
 
@@ -159,6 +165,9 @@ namespace mmo
 		/// @copydoc IDatabase::SaveInventoryItems
 		void SaveInventoryItems(uint64 characterId, const std::vector<ItemData>& items) override;
 
+		/// @copydoc IDatabase::ReplaceInventoryItems
+		void ReplaceInventoryItems(uint64 characterId, const std::vector<ItemData>& items) override;
+
 		/// @copydoc IDatabase::DeleteInventoryItems
 		void DeleteInventoryItems(uint64 characterId, const std::vector<uint16>& slots) override;
 
@@ -172,6 +181,12 @@ namespace mmo
 		/// Logs the last database error to the default logger.
 		void PrintDatabaseError();
 
+		/// Runs a select of character names and collects its rows.
+		std::optional<std::vector<CharacterNameData>> SelectCharacterNames(const String& query);
+
+		/// Inserts inventory items, or updates the stored items in the same slots. Runs in the transaction of the caller.
+		void UpsertInventoryItems(uint64 characterId, const std::vector<ItemData>& items);
+
 	private:
 		const proto::Project& m_project;
 		mysql::DatabaseInfo m_connectionInfo;
@@ -22,6 +22,8 @@
 #include "guild_mgr.h"
 #include "friend_mgr.h"
 #include "chat_channel_mgr.h"
+#include "character_name_cache.h"
+#include "db_query_cache.h"
 #include "player_group.h"
 #include "base/utilities.h"
 #include "game/chat_type.h"
@@ -45,8 +47,10 @@ namespace mmo
 		IdGenerator<uint64> &groupIdGenerator,
 		GuildMgr &guildMgr,
 		FriendMgr &friendMgr,
-		ChannelMgr &channelMgr)
-		: m_timerQueue(timerQueue), m_manager(playerManager), m_worldManager(worldManager), m_loginConnector(loginConnector), m_database(database), m_project(project), m_groupIdGenerator(groupIdGenerator), m_connection(std::move(connection)), m_address(std::move(address)), m_accountId(0), m_guildMgr(guildMgr), m_friendMgr(friendMgr), m_channelMgr(channelMgr)
+		ChannelMgr &channelMgr,
+		CharacterNameCache &characterNameCache,
+		DbQueryCache &dbQueryCache)
+		: m_timerQueue(timerQueue), m_manager(playerManager), m_worldManager(worldManager), m_loginConnector(loginConnector), m_database(database), m_project(project), m_groupIdGenerator(groupIdGenerator), m_connection(std::move(connection)), m_address(std::move(address)), m_accountId(0), m_guildMgr(guildMgr), m_friendMgr(friendMgr), m_channelMgr(channelMgr), m_characterNameCache(characterNameCache), m_dbQueryCache(dbQueryCache)
 	{
 		// Generate random seed for packet header encryption & decryption
 		std::uniform_int_distribution<uint32> dist;
@@ -138,6 +142,9 @@ namespace mmo
 						}
 
 						strongThis->m_characterViews[charView.GetGuid()] = charView;
+
+						// Picks up characters which have just been created
+						strongThis->m_characterNameCache.AddOrUpdate({ charView.GetGuid(), charView.GetName(), charView.GetRaceId(), charView.GetClassId(), charView.GetGender() });
 					}
 				}
 
@@ -700,7 +707,7 @@ namespace mmo
 
 		// Database callback handler
 		std::weak_ptr weakThis{shared_from_this()};
-		auto handler = [weakThis](const bool success)
+		auto handler = [weakThis, charGuid](const bool success)
 		{
 			if (const auto strongThis = weakThis.lock())
 			{
@@ -708,6 +715,10 @@ namespace mmo
 				{
 					ELOG("Failed to delete character!");
 				}
+				else
+				{
+					strongThis->m_characterNameCache.Remove(charGuid);
+				}
 
 				strongThis->DoCharEnum();
 			}
@@ -993,43 +1004,26 @@ namespace mmo
 
 		DLOG("Received CMSG_NAME_QUERY for unit " << log_hex_digit(guid) << "...");
 
-		const Player *player = m_manager.GetPlayerByCharacterGuid(guid);
-		if (player != nullptr)
-		{
-			String name = player->GetCharacterName();
-			m_connection->sendSinglePacket([guid, &name](game::OutgoingPacket &packet)
-										   {
-					packet.Start(game::realm_client_packet::NameQueryResult);
-					packet
-						<< io::write_packed_guid(guid)
-						<< io::write<uint8>(true)
-						<< io::write_range(name) << io::write<uint8>(0);
-					packet.Finish(); });
-		}
-		else
+		// Served from the name cache, which only has to ask the database for characters it doesn't know yet
+		std::weak_ptr weakThis = shared_from_this();
+		m_characterNameCache.ResolveGuid(guid, [weakThis, guid](const CharacterNameData *character)
 		{
-			// We have to look up the player name in the database
-			std::weak_ptr weakThis = shared_from_this();
-			auto handler = [weakThis, guid](std::optional<String> &playerName)
+			if (const auto strongThis = weakThis.lock())
 			{
-				if (const auto strongThis = weakThis.lock())
-				{
-					strongThis->m_connection->sendSinglePacket([guid, &playerName](game::OutgoingPacket &packet)
-															   {
-							packet.Start(game::realm_client_packet::NameQueryResult);
-							packet
-								<< io::write_packed_guid(guid)
-								<< io::write<uint8>(playerName ? true : false);
-								if (playerName)
-								{
-									packet
-										<< io::write_range(*playerName) << io::write<uint8>(0);
-								}
-							packet.Finish(); });
-				}
-			};
-			m_database.asyncRequest(std::move(handler), &IDatabase::GetCharacterNameById, guid);
-		}
+				strongThis->m_connection->sendSinglePacket([guid, character](game::OutgoingPacket &packet)
+														   {
+						packet.Start(game::realm_client_packet::NameQueryResult);
+						packet
+							<< io::write_packed_guid(guid)
+							<< io::write<uint8>(character ? true : false);
+							if (character)
+							{
+								packet
+									<< io::write_range(character->name) << io::write<uint8>(0);
+							}
+						packet.Finish(); });
+			}
+		});
 
 		return PacketParseResult::Pass;
 	}
@@ -1083,29 +1077,61 @@ namespace mmo
 			return PacketParseResult::Disconnect;
 		}
 
+		game::db_query_type::Type type;
 		switch (packet.GetId())
 		{
 		case game::client_realm_packet::CreatureQuery:
-			OnQueryCreature(guid);
+			type = game::db_query_type::Creature;
 			break;
 
 		case game::client_realm_packet::ItemQuery:
-			OnQueryItem(guid);
+			type = game::db_query_type::Item;
 			break;
 
 		case game::client_realm_packet::QuestQuery:
-			OnQueryQuest(guid);
+			type = game::db_query_type::Quest;
 			break;
 
 		case game::client_realm_packet::ObjectQuery:
-			OnQueryObject(guid);
+			type = game::db_query_type::Object;
 			break;
 
 		default:
 			ELOG("Player tried to query unsupported item, packet handler might be subscribed for wrong op code (" << packet.GetId() << ")");
-			break;
+			return PacketParseResult::Pass;
+		}
+
+		SendDbQueryResults(type, { guid });
+		return PacketParseResult::Pass;
+	}
+
+	PacketParseResult Player::OnDbQueryBatch(game::IncomingPacket &packet)
+	{
+		uint8 type;
+		uint8 count;
+		if (!(packet >> io::read<uint8>(type) >> io::read<uint8>(count)))
+		{
+			return PacketParseResult::Disconnect;
+		}
+
+		if (type >= game::db_query_type::Count_)
+		{
+			ELOG("Player tried to batch query unsupported type " << static_cast<uint32>(type));
+			return PacketParseResult::Disconnect;
+		}
+
+		std::vector<uint64> ids(count);
+		for (uint64 &id : ids)
+		{
+			if (!(packet >> io::read_packed_guid(id)))
+			{
+				return PacketParseResult::Disconnect;
+			}
 		}
 
+		DLOG("Received CMSG_DB_QUERY_BATCH for " << ids.size() << " entries of type " << static_cast<uint32>(type) << "...");
+
+		SendDbQueryResults(static_cast<game::db_query_type::Type>(type), ids);
 		return PacketParseResult::Pass;
 	}
 
@@ -1900,7 +1926,7 @@ namespace mmo
 		}
 		else
 		{
-			// Offline player path - lookup in database
+			// Offline player path - lookup in the name cache
 			auto handler = [this, targetName, myGuid](std::optional<DatabaseId> targetGuidOpt)
 			{
 				if (!targetGuidOpt.has_value())
@@ -1983,7 +2009,7 @@ namespace mmo
 				m_database.asyncRequest(std::move(addFriendHandler), &IDatabase::AddFriend, myGuid, targetGuid);
 			};
 
-			m_database.asyncRequest(std::move(handler), &IDatabase::GetCharacterIdByName, targetName);
+			m_characterNameCache.ResolveCharacterId(targetName, std::move(handler));
 		}
 	}
 
@@ -2783,7 +2809,7 @@ namespace mmo
 		m_connection->GetCrypt().SetKey(hash.data(), hash.size());
 		m_connection->GetCrypt().Init();
 
-		// Send RealmConfig: which races and classes are disabled
+		// Send RealmConfig: which races and classes are disabled and which template data clients may have cached
 		m_connection->sendSinglePacket([this](game::OutgoingPacket &packet)
 									   {
 			packet.Start(game::realm_client_packet::RealmConfig);
@@ -2816,6 +2842,7 @@ namespace mmo
 			{
 				packet << io::write<uint8>(id);
 			}
+			packet << io::write<uint64>(m_dbQueryCache.GetDataVersion());
 
 			packet.Finish(); });
 
@@ -3003,6 +3030,7 @@ namespace mmo
 			RegisterPacketHandler(game::client_realm_packet::ItemQuery, *this, &Player::OnDbQuery);
 			RegisterPacketHandler(game::client_realm_packet::QuestQuery, *this, &Player::OnDbQuery);
 			RegisterPacketHandler(game::client_realm_packet::ObjectQuery, *this, &Player::OnDbQuery);
+			RegisterPacketHandler(game::client_realm_packet::DbQueryBatch, *this, &Player::OnDbQueryBatch);
 			RegisterPacketHandler(game::client_realm_packet::SetActionBarButton, *this, &Player::OnSetActionBarButton);
 			RegisterPacketHandler(game::client_realm_packet::GroupInvite, *this, &Player::OnGroupInvite);
 			RegisterPacketHandler(game::client_realm_packet::GroupUninvite, *this, &Player::OnGroupUninvite);
@@ -3030,6 +3058,8 @@ namespace mmo
 			ClearPacketHandler(game::client_realm_packet::CreatureQuery);
 			ClearPacketHandler(game::client_realm_packet::ItemQuery);
 			ClearPacketHandler(game::client_realm_packet::QuestQuery);
+			ClearPacketHandler(game::client_realm_packet::ObjectQuery);
+			ClearPacketHandler(game::client_realm_packet::DbQueryBatch);
 			ClearPacketHandler(game::client_realm_packet::SetActionBarButton);
 			ClearPacketHandler(game::client_realm_packet::GroupInvite);
 			ClearPacketHandler(game::client_realm_packet::GroupUninvite);
@@ -3456,267 +3486,22 @@ namespace mmo
 		}
 	}
 
-	void Player::OnQueryCreature(uint64 entry)
-	{
-		DLOG("Querying for creature " << log_hex_digit(entry) << "...");
-
-		const proto::UnitEntry *unit = m_project.units.getById(entry);
-		if (unit == nullptr)
-		{
-			WLOG("Could not find creature entry " << log_hex_digit(entry));
-			m_connection->sendSinglePacket([entry](game::OutgoingPacket &packet)
-										   {
-					packet.Start(game::realm_client_packet::CreatureQueryResult);
-					packet
-						<< io::write_packed_guid(entry)
-						<< io::write<uint8>(false);
-					packet.Finish(); });
-			return;
-		}
-
-		m_connection->sendSinglePacket([unit](game::OutgoingPacket &packet)
-									   {
-				packet.Start(game::realm_client_packet::CreatureQueryResult);
-				packet
-					<< io::write_packed_guid(unit->id())
-					<< io::write<uint8>(true)
-					<< io::write_range(unit->name()) << io::write<uint8>(0)
-					<< io::write_range(unit->subname()) << io::write<uint8>(0);
-				packet.Finish(); });
-	}
-
-	void Player::OnQueryQuest(uint64 entry)
+	void Player::SendDbQueryResults(const game::db_query_type::Type type, const std::vector<uint64> &ids)
 	{
-		DLOG("Querying for quest " << log_hex_digit(entry) << "...");
+		const auto opCode = DbQueryCache::GetResultOpCode(type);
 
-		// Check for existing quest entry
-		const proto::QuestEntry *questEntry = m_project.quests.getById(entry);
-		if (!questEntry)
+		// Every response is its own packet so that clients parse batched and single queries the same way, but all of
+		// them are written into the send buffer before it is flushed
+		for (const uint64 id : ids)
 		{
-			m_connection->sendSinglePacket([entry](game::OutgoingPacket &packet)
+			m_connection->sendSinglePacket([this, opCode, type, id](game::OutgoingPacket &packet)
 										   {
-					packet.Start(game::realm_client_packet::QuestQueryResult);
-					packet
-						<< io::write_packed_guid(entry)
-						<< io::write<uint8>(false);
-					packet.Finish(); });
-			return;
+				packet.Start(opCode);
+				packet << io::write_range(m_dbQueryCache.GetResponse(type, id));
+				packet.Finish(); }, false);
 		}
 
-		// Map quest info
-		QuestInfo quest;
-		quest.id = questEntry->id();
-		quest.title = questEntry->name();
-		quest.description = questEntry->detailstext();
-		quest.summary = questEntry->objectivestext();
-
-		quest.questLevel = questEntry->questlevel();
-		quest.rewardMoney = questEntry->rewardmoney();
-		quest.rewardXp = questEntry->rewardxp();
-
-		for (const auto &requirement : questEntry->requirements())
-		{
-			if (requirement.itemid() != 0)
-			{
-				quest.requiredItems.emplace_back(requirement.itemid(), requirement.itemcount());
-			}
-			else if (requirement.creatureid() != 0)
-			{
-				quest.requiredCreatures.emplace_back(requirement.creatureid(), requirement.creaturecount());
-			}
-		}
-
-		for (const auto &reward : questEntry->rewarditems())
-		{
-			quest.rewardItems.emplace_back(reward.itemid(), reward.count());
-		}
-
-		for (const auto &reward : questEntry->rewarditemschoice())
-		{
-			quest.optionalItems.emplace_back(reward.itemid(), reward.count());
-		}
-
-		m_connection->sendSinglePacket([entry, &quest](game::OutgoingPacket &packet)
-									   {
-				packet.Start(game::realm_client_packet::QuestQueryResult);
-				packet
-					<< io::write_packed_guid(entry)
-					<< io::write<uint8>(true)
-					<< quest;
-				packet.Finish(); });
-	}
-
-	void Player::OnQueryItem(uint64 entry)
-	{
-		DLOG("Querying for item " << log_hex_digit(entry) << "...");
-
-		const proto::ItemEntry *itemEntry = m_project.items.getById(entry);
-		if (!itemEntry)
-		{
-			WLOG("Item with entry " << entry << " could not be found!");
-			m_connection->sendSinglePacket([entry](game::OutgoingPacket &packet)
-										   {
-					packet.Start(game::realm_client_packet::ItemQueryResult);
-					packet
-						<< io::write_packed_guid(entry)
-						<< io::write<uint8>(false);
-					packet.Finish(); });
-			return;
-		}
-
-		// Map item entry
-		ItemInfo info;
-		info.name = itemEntry->name();
-		info.description = itemEntry->description();
-		info.id = entry;
-		info.itemClass = itemEntry->itemclass();
-		info.itemSubclass = itemEntry->subclass();
-		info.displayId = itemEntry->displayid();
-		info.quality = itemEntry->quality();
-		info.flags = itemEntry->flags();
-		info.buyCount = itemEntry->buycount();
-		info.buyPrice = itemEntry->buyprice();
-		info.sellPrice = itemEntry->sellprice();
-		info.inventoryType = itemEntry->inventorytype();
-		info.allowedClasses = itemEntry->allowedclasses();
-		info.allowedRaces = itemEntry->allowedraces();
-		info.itemlevel = itemEntry->itemlevel();
-		info.requiredlevel = itemEntry->requiredlevel();
-		info.requiredskill = itemEntry->requiredskill();
-		info.requiredskillrank = itemEntry->requiredskillrank();
-		info.requiredspell = itemEntry->requiredspell();
-		info.requiredrep = itemEntry->requiredrep();
-		info.requiredreprank = itemEntry->requiredreprank();
-		info.requiredcityrank = itemEntry->requiredcityrank();
-		info.requiredrep = itemEntry->requiredrep();
-		info.requiredreprank = itemEntry->requiredreprank();
-		info.maxcount = itemEntry->maxcount();
-		info.maxstack = itemEntry->maxstack();
-		info.containerslots = itemEntry->containerslots();
-
-		for (int i = 0; i < 10; ++i)
-		{
-			if (i >= itemEntry->stats_size())
-			{
-				info.stats[i].type = -1;
-				info.stats[i].value = 0;
-			}
-			else
-			{
-				const auto &stat = itemEntry->stats(i);
-				info.stats[i].type = stat.type();
-				info.stats[i].value = stat.value();
-			}
-		}
-
-		info.damage.type = itemEntry->damage().type();
-		info.damage.min = itemEntry->damage().mindmg();
-		info.damage.max = itemEntry->damage().maxdmg();
-		info.attackTime = itemEntry->delay();
-
-		for (int i = 0; i < 5; ++i)
-		{
-			if (i >= itemEntry->spells_size())
-			{
-				info.spells[i].spellId = -1;
-				info.spells[i].triggertype = 0;
-			}
-			else
-			{
-				const auto &spell = itemEntry->spells(i);
-				info.spells[i].spellId = spell.spell();
-				info.spells[i].triggertype = spell.trigger();
-			}
-		}
-
-		info.armor = itemEntry->armor();
-		info.resistance[0] = itemEntry->holyres();
-		info.resistance[1] = itemEntry->fireres();
-		info.resistance[2] = itemEntry->natureres();
-		info.resistance[3] = itemEntry->frostres();
-		info.resistance[4] = itemEntry->shadowres();
-		info.resistance[5] = itemEntry->arcaneres();
-		info.ammotype = itemEntry->ammotype();
-
-		info.bonding = itemEntry->bonding();
-		info.lockid = itemEntry->lockid();
-		info.sheath = itemEntry->sheath();
-		info.randomproperty = itemEntry->randomproperty();
-		info.randomsuffix = itemEntry->randomsuffix();
-		info.block = itemEntry->block();
-		info.itemset = itemEntry->itemset();
-		info.material = itemEntry->material();
-		info.maxdurability = itemEntry->durability();
-		info.area = itemEntry->area();
-		info.extraflags = itemEntry->extraflags();
-		info.startquestid = itemEntry->questentry();
-		info.skill = itemEntry->skill();
-
-		// Set required proficiency - check item first, then fall back to subclass
-		if (itemEntry->has_requiredproficiency() && itemEntry->requiredproficiency() > 0)
-		{
-			info.requiredProficiency = itemEntry->requiredproficiency();
-		}
-		else
-		{
-			// Look up subclass to get required proficiency
-			const auto* subclass = m_project.itemSubclasses.getById(itemEntry->subclass());
-			if (subclass && subclass->has_requiredproficiency())
-			{
-				info.requiredProficiency = subclass->requiredproficiency();
-			}
-			else
-			{
-				info.requiredProficiency = 0;
-			}
-		}
-
-		m_connection->sendSinglePacket([entry, &info](game::OutgoingPacket &packet)
-									   {
-				packet.Start(game::realm_client_packet::ItemQueryResult);
-				packet
-					<< io::write_packed_guid(entry)
-					<< io::write<uint8>(true)
-					<< info;
-				packet.Finish(); });
-	}
-
-	void Player::OnQueryObject(uint64 entry)
-	{
-		DLOG("Querying for object " << log_hex_digit(entry) << "...");
-
-		const proto::ObjectEntry *object = m_project.objects.getById(entry);
-		if (object == nullptr)
-		{
-			WLOG("Could not find object entry " << log_hex_digit(entry));
-			m_connection->sendSinglePacket([entry](game::OutgoingPacket &packet)
-										   {
-					packet.Start(game::realm_client_packet::ObjectQueryResult);
-					packet
-						<< io::write_packed_guid(entry)
-						<< io::write<uint8>(false);
-					packet.Finish(); });
-			return;
-		}
-
-		ObjectInfo info;
-		info.id = entry;
-		info.type = object->type();
-		info.displayId = object->displayid();
-		info.name = object->name();
-		for (int32 i = 0; i < 16; ++i)
-		{
-			info.data[i] = object->data_size() <= i ? 0 : object->data(i);
-		}
-
-		m_connection->sendSinglePacket([&info](game::OutgoingPacket &packet)
-									   {
-				packet.Start(game::realm_client_packet::ObjectQueryResult);
-				packet
-					<< io::write_packed_guid(info.id)
-					<< io::write<uint8>(true)
-					<< info;
-				packet.Finish(); });
+		m_connection->flush();
 	}
 
 	void Player::OnActionButtons(const ActionButtons &actionButtons)
@@ -4191,7 +3976,7 @@ namespace mmo
 			strong->OnGuildRemoveCharacterIdResolve(*characterId, playerName);
 		};
 
-		m_database.asyncRequest(std::move(handler), &IDatabase::GetCharacterIdByName, playerName);
+		m_characterNameCache.ResolveCharacterId(playerName, std::move(handler));
 		return PacketParseResult::Pass;
 	}
 
@@ -30,6 +30,8 @@ namespace mmo
 	class FriendMgr;
 	class ChannelMgr;
 	class ChatChannel;
+	class CharacterNameCache;
+	class DbQueryCache;
 }
 
 namespace mmo
@@ -70,7 +72,9 @@ namespace mmo
 			IdGenerator<uint64> &groupIdGenerator,
 			GuildMgr &guildMgr,
 			FriendMgr &friendMgr,
-			ChannelMgr &channelMgr);
+			ChannelMgr &channelMgr,
+			CharacterNameCache &characterNameCache,
+			DbQueryCache &dbQueryCache);
 		/// Disconnects the player if still connected.
 		void Kick();
 
@@ -256,13 +260,8 @@ namespace mmo
 
 		void NotifyWorldNodeChanged(World *worldNode);
 
-		void OnQueryCreature(uint64 entry);
-
-		void OnQueryQuest(uint64 entry);
-
-		void OnQueryItem(uint64 entry);
-
-		void OnQueryObject(uint64 entry);
+		/// Sends the cached responses to template queries of one type, flushing the connection only once.
+		void SendDbQueryResults(game::db_query_type::Type type, const std::vector<uint64> &ids);
 
 		void OnActionButtons(const ActionButtons &actionButtons);
 
@@ -470,6 +469,12 @@ namespace mmo
 		/// Global ids of the chat channels this player is currently a member of.
 		std::set<uint32> m_chatChannels;
 
+		/// Resolves character names and guids without database round trips.
+		CharacterNameCache &m_characterNameCache;
+
+		/// Pre-serialized responses to template queries, shared by all players.
+		DbQueryCache &m_dbQueryCache;
+
 		/// Per-player dungeon instance bindings (mapId -> instanceId).
 		/// Used when the player is solo (not in a group).
 		std::map<MapId, InstanceId> m_dungeonBindings;
@@ -503,6 +508,7 @@ namespace mmo
 		PacketParseResult OnNameQuery(game::IncomingPacket &packet);
 		PacketParseResult OnGuildQuery(game::IncomingPacket &packet);
 		PacketParseResult OnDbQuery(game::IncomingPacket &packet);
+		PacketParseResult OnDbQueryBatch(game::IncomingPacket &packet);
 		PacketParseResult OnSetActionBarButton(game::IncomingPacket &packet);
 		PacketParseResult OnMoveWorldPortAck(game::IncomingPacket &packet);
 		PacketParseResult OnGroupInvite(game::IncomingPacket &packet);
@@ -13,6 +13,8 @@
 #include "guild_mgr.h"
 #include "friend_mgr.h"
 #include "chat_channel_mgr.h"
+#include "character_name_cache.h"
+#include "db_query_cache.h"
 #include "motd_manager.h"
 
 #include "asio.hpp"
@@ -159,6 +161,7 @@ namespace mmo
 		AsyncFriendDatabase asyncFriendDb{ *database, async, sync };
 		AsyncMOTDDatabase   asyncMotdDb{ *database, async, sync };
 		AsyncChatChannelDatabase asyncChatChannelDb{ *database, async, sync };
+		AsyncCharacterDatabase asyncCharacterDb{ *database, async, sync };
 
 		IdGenerator<uint64> groupIdGenerator{ 1 };
 
@@ -251,10 +254,15 @@ namespace mmo
 		ChannelMgr channelMgr{ project, asyncChatChannelDb, playerManager, timerQueue };
 		channelMgr.Initialize();
 
-		
+		// Load all character names, so that name lookups don't need the database
+		CharacterNameCache characterNameCache{ asyncCharacterDb };
+		characterNameCache.LoadAll();
+
+		// Template query responses are serialized once and shared by all players
+		DbQueryCache dbQueryCache{ project };
 
-		// Wait for all guilds to load
-		while (!guildMgr.GuildsLoaded())
+		// Wait for all guilds and character names to load
+		while (!guildMgr.GuildsLoaded() || !characterNameCache.IsLoaded())
 		{
 			dbService.run_one();
 			ioService.run_one();
@@ -295,7 +303,7 @@ namespace mmo
 		}
 
 		// Careful: Called by multiple threads!
-		const auto createPlayer = [&playerManager, &worldManager, &asyncDatabase, &loginConnector, &project, &timerQueue, &groupIdGenerator, &guildMgr, &friendMgr, &channelMgr](std::shared_ptr<Player::Client> connection)
+		const auto createPlayer = [&playerManager, &worldManager, &asyncDatabase, &loginConnector, &project, &timerQueue, &groupIdGenerator, &guildMgr, &friendMgr, &channelMgr, &characterNameCache, &dbQueryCache](std::shared_ptr<Player::Client> connection)
 		{
 			asio::ip::address address;
 
@@ -309,7 +317,7 @@ namespace mmo
 				return;
 			}
 
-			auto player = std::make_shared<Player>(timerQueue, playerManager, worldManager, *loginConnector, asyncDatabase, connection, address.to_string(), project, groupIdGenerator, guildMgr, friendMgr, channelMgr);
+			auto player = std::make_shared<Player>(timerQueue, playerManager, worldManager, *loginConnector, asyncDatabase, connection, address.to_string(), project, groupIdGenerator, guildMgr, friendMgr, channelMgr, characterNameCache, dbQueryCache);
 			ILOG("Incoming player connection from " << address);
 			playerManager.AddPlayer(std::move(player));
 
@@ -650,12 +650,11 @@ namespace mmo
 		uint64 characterGuid;
 		uint16 packetId;
 		uint32 packetSize;
-		std::vector<uint8> packetContent;
 		if (!(packet 
 			>> io::read<uint64>(characterGuid)
 			>> io::read<uint16>(packetId)
 			>> io::read<uint32>(packetSize)
-			>> io::read_container<uint32>(packetContent)
+			>> io::read_container<uint32>(m_proxyPacketContent)
 			))
 		{
 			return PacketParseResult::Disconnect;
@@ -668,13 +667,8 @@ namespace mmo
 			return PacketParseResult::Pass;
 		}
 
-		std::vector<char> outBuffer;
-		io::VectorSink sink { outBuffer };
-
-		game::OutgoingPacket proxyPacket(sink, true);
-		proxyPacket
-			<< io::write_range(packetContent);
-		player->SendProxyPacket(packetId, outBuffer);
+		// The content already is a complete client packet including its header, so it is forwarded as is
+		player->SendProxyPacket(packetId, m_proxyPacketContent);
 		
 		return PacketParseResult::Pass;
 	}
@@ -934,11 +928,13 @@ namespace mmo
 	{
 		uint64 characterGuid = 0;
 		uint32 operationId = 0;
+		uint8 replaceAll = 0;
 		uint16 itemCount = 0;
 
 		if (!(packet
 			>> io::read<uint64>(characterGuid)
 			>> io::read<uint32>(operationId)
+			>> io::read<uint8>(replaceAll)
 			>> io::read<uint16>(itemCount)))
 		{
 			ELOG("Failed to parse SAVE_INVENTORY_ITEMS packet header");
@@ -980,7 +976,14 @@ namespace mmo
 
 		// Call database to save items asynchronously
 		// CRITICAL: Pass items by value (copy) to ensure they persist through async operation
-		m_database.asyncRequest(std::move(sendResult), &IDatabase::SaveInventoryItems, characterGuid, items);
+		if (replaceAll != 0)
+		{
+			m_database.asyncRequest(std::move(sendResult), &IDatabase::ReplaceInventoryItems, characterGuid, items);
+		}
+		else
+		{
+			m_database.asyncRequest(std::move(sendResult), &IDatabase::SaveInventoryItems, characterGuid, items);
+		}
 
 		return PacketParseResult::Pass;
 	}
@@ -162,6 +162,9 @@ namespace mmo
 		std::map<uint64, JoinWorldCallback> m_joinCallbacks;
 		const proto::Project& m_project;
 
+		/// Content of the last proxy packet. Reused, so that forwarding proxy packets to clients doesn't allocate.
+		std::vector<char> m_proxyPacketContent;
+
 	private:
 		/// Closes the connection if still connected.
 		void Destroy();
@@ -5,6 +5,8 @@
 #pragma once
 
 #include "realm_server/database.h"
+#include <algorithm>
+#include <cctype>
 #include <optional>
 #include <vector>
 #include <string>
@@ -188,4 +190,79 @@ struct MockGroupDatabase : IGroupDatabase
     }
 };
 
+// -----------------------------------------------------------------------
+// MockCharacterDatabase
+// -----------------------------------------------------------------------
+
+struct MockCharacterDatabase : ICharacterDatabase
+{
+    /// Characters returned by LoadCharacterNames and searched by FindCharacterNames.
+    std::vector<CharacterNameData> characters;
+
+    /// Guids and names of every FindCharacterNames call.
+    std::vector<std::pair<std::vector<uint64>, std::vector<String>>> findCalls;
+
+    std::optional<std::vector<CharacterNameData>> LoadCharacterNames() override
+    {
+        return characters;
+    }
+
+    std::optional<std::vector<CharacterNameData>> FindCharacterNames(std::vector<uint64> characterIds, std::vector<String> characterNames) override
+    {
+        findCalls.emplace_back(characterIds, characterNames);
+
+        std::vector<CharacterNameData> result;
+        for (const auto& character : characters)
+        {
+            String name = character.name;
+            std::transform(name.begin(), name.end(), name.begin(), [](const unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+            if (std::find(characterIds.begin(), characterIds.end(), character.guid) != characterIds.end() ||
+                std::find(characterNames.begin(), characterNames.end(), name) != characterNames.end())
+            {
+                result.push_back(character);
+            }
+        }
+
+        return result;
+    }
+
+    std::optional<std::vector<CharacterView>> GetCharacterViewsByAccountId(uint64) override { return std::nullopt; }
+
+    void DeleteCharacter(uint64) override {}
+
+    std::optional<CharCreateResult> CreateCharacter(std::string, uint64, uint32, uint32, uint32, uint32, uint32, uint32, const Vector3&, const Degree&, std::vector<uint32>, uint32, uint32, uint32, std::map<uint8, ActionButton>, const AvatarConfiguration&,
+        const std::vector<ItemData>&) override { return std::nullopt; }
+
+    std::optional<CharacterData> CharacterEnterWorld(uint64, uint64) override { return std::nullopt; }
+
+    void UpdateCharacter(uint64, uint32, const Vector3&, const Radian&, uint32, uint32, uint32, uint32, uint32, uint32, uint32, uint32, const Vector3&, const Radian&, const std::vector<uint32>&, const std::vector<CharacterClassData>&, uint32, uint32) override {}
+
+    void UpdateCharacterAuras(uint64, const std::vector<PersistentAuraData>&) override {}
+
+    void UpdateCharacterCooldowns(uint64, const std::vector<std::pair<uint32, GameTime>>&) override {}
+
+    std::optional<ActionButtons> GetActionButtons(uint64, uint32) override { return std::nullopt; }
+
+    void SetCharacterActionButtons(DatabaseId, uint32, ActionButtons) override {}
+
+    void LearnSpell(DatabaseId, uint32) override {}
+
+    void SetQuestData(DatabaseId, uint32, const QuestStatusData&) override {}
+
+    std::optional<CharacterLocationData> GetCharacterLocationDataByName(String) override { return std::nullopt; }
+
+    std::optional<DatabaseId> GetCharacterIdByName(String) override { return std::nullopt; }
+
+    void TeleportCharacterByName(String, uint32, Vector3, Radian) override {}
+
+    std::optional<String> GetCharacterNameById(uint64) override { return std::nullopt; }
+
+    void SaveInventoryItems(uint64, const std::vector<ItemData>&) override {}
+
+    void ReplaceInventoryItems(uint64, const std::vector<ItemData>&) override {}
+
+    void DeleteInventoryItems(uint64, const std::vector<uint16>&) override {}
+};
+
 } // namespace mmo
@@ -0,0 +1,166 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+#include "mock_databases.h"
+
+#include "realm_server/character_name_cache.h"
+
+using namespace mmo;
+
+namespace
+{
+    void syncDispatch(const std::function<void()>& action) { action(); }
+
+    /// Queues database requests until the test runs them, so that requests can be observed while they are in flight.
+    struct DeferredWorker
+    {
+        std::vector<std::function<void()>> requests;
+
+        void RunAll()
+        {
+            while (!requests.empty())
+            {
+                const auto request = requests.front();
+                requests.erase(requests.begin());
+                request();
+            }
+        }
+    };
+
+    CharacterNameData MakeCharacter(const uint64 guid, const String& name)
+    {
+        CharacterNameData character;
+        character.guid = guid;
+        character.name = name;
+        character.raceId = 1;
+        character.classId = 2;
+        return character;
+    }
+
+    /// Remembers whether a resolve callback was invoked and with which character.
+    struct ResolveResult
+    {
+        bool called = false;
+        std::optional<uint64> guid;
+
+        CharacterNameCache::ResolveCallback Callback()
+        {
+            return [this](const CharacterNameData* character)
+            {
+                called = true;
+                guid = character ? std::optional<uint64>(character->guid) : std::nullopt;
+            };
+        }
+    };
+}
+
+TEST_CASE("CharacterNameCache finds characters by name case insensitive", "[character_name_cache]")
+{
+    MockCharacterDatabase mockDb;
+    mockDb.characters = { MakeCharacter(1, "Arthas"), MakeCharacter(2, "Jaina") };
+    AsyncCharacterDatabase asyncDb{ mockDb, syncDispatch, syncDispatch };
+
+    CharacterNameCache cache{ asyncDb };
+    cache.LoadAll();
+    REQUIRE(cache.IsLoaded());
+
+    REQUIRE(cache.GetByName("arthas") != nullptr);
+    REQUIRE(cache.GetByName("ARTHAS")->guid == 1);
+    REQUIRE(cache.GetByName("jAiNa")->guid == 2);
+    REQUIRE(cache.GetByGuid(2)->name == "Jaina");
+    REQUIRE(cache.GetByName("Thrall") == nullptr);
+}
+
+TEST_CASE("CharacterNameCache drops the previous name of a renamed character", "[character_name_cache]")
+{
+    MockCharacterDatabase mockDb;
+    mockDb.characters = { MakeCharacter(1, "Arthas") };
+    AsyncCharacterDatabase asyncDb{ mockDb, syncDispatch, syncDispatch };
+
+    CharacterNameCache cache{ asyncDb };
+    cache.LoadAll();
+
+    cache.AddOrUpdate(MakeCharacter(1, "Uther"));
+
+    REQUIRE(cache.GetByName("Arthas") == nullptr);
+    REQUIRE(cache.GetByName("uther")->guid == 1);
+    REQUIRE(cache.GetByGuid(1)->name == "Uther");
+}
+
+TEST_CASE("CharacterNameCache forgets removed characters", "[character_name_cache]")
+{
+    MockCharacterDatabase mockDb;
+    mockDb.characters = { MakeCharacter(1, "Arthas"), MakeCharacter(2, "Jaina") };
+    AsyncCharacterDatabase asyncDb{ mockDb, syncDispatch, syncDispatch };
+
+    CharacterNameCache cache{ asyncDb };
+    cache.LoadAll();
+
+    cache.Remove(1);
+    cache.Remove(42);
+
+    REQUIRE(cache.GetByGuid(1) == nullptr);
+    REQUIRE(cache.GetByName("Arthas") == nullptr);
+    REQUIRE(cache.GetByGuid(2) != nullptr);
+}
+
+TEST_CASE("CharacterNameCache answers misses without a query once loaded", "[character_name_cache]")
+{
+    MockCharacterDatabase mockDb;
+    mockDb.characters = { MakeCharacter(1, "Arthas") };
+    AsyncCharacterDatabase asyncDb{ mockDb, syncDispatch, syncDispatch };
+
+    CharacterNameCache cache{ asyncDb };
+    cache.LoadAll();
+
+    ResolveResult byGuid, byName;
+    cache.ResolveGuid(1234, byGuid.Callback());
+    cache.ResolveName("Nobody", byName.Callback());
+
+    REQUIRE(byGuid.called);
+    REQUIRE_FALSE(byGuid.guid.has_value());
+    REQUIRE(byName.called);
+    REQUIRE_FALSE(byName.guid.has_value());
+    REQUIRE(mockDb.findCalls.empty());
+}
+
+TEST_CASE("CharacterNameCache sends misses of an in-flight query as one follow-up batch", "[character_name_cache]")
+{
+    MockCharacterDatabase mockDb;
+    mockDb.characters = { MakeCharacter(1, "Arthas"), MakeCharacter(2, "Jaina"), MakeCharacter(3, "Thrall") };
+
+    // The cache isn't loaded, so misses are resolved through the database
+    DeferredWorker worker;
+    AsyncCharacterDatabase asyncDb{ mockDb,
+        [&worker](const std::function<void()>& action) { worker.requests.push_back(action); },
+        syncDispatch };
+
+    CharacterNameCache cache{ asyncDb };
+
+    ResolveResult first, second, third, missing;
+    cache.ResolveGuid(1, first.Callback());
+    REQUIRE(worker.requests.size() == 1);
+
+    // These arrive while the first query is running
+    cache.ResolveGuid(2, second.Callback());
+    cache.ResolveName("THRALL", third.Callback());
+    cache.ResolveGuid(99, missing.Callback());
+    REQUIRE(worker.requests.size() == 1);
+
+    worker.RunAll();
+
+    REQUIRE(mockDb.findCalls.size() == 2);
+    REQUIRE(mockDb.findCalls[0].first == std::vector<uint64>{ 1 });
+    REQUIRE(mockDb.findCalls[0].second.empty());
+    REQUIRE(mockDb.findCalls[1].first == std::vector<uint64>{ 2, 99 });
+    REQUIRE(mockDb.findCalls[1].second == std::vector<String>{ "thrall" });
+
+    REQUIRE(first.guid == 1);
+    REQUIRE(second.guid == 2);
+    REQUIRE(third.guid == 3);
+    REQUIRE(missing.called);
+    REQUIRE_FALSE(missing.guid.has_value());
+
+    // Resolved characters are cached
+    REQUIRE(cache.GetByName("jaina") != nullptr);
+}
@@ -0,0 +1,347 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "test_objects.h"
+
+#include "base/job_system.h"
+#include "scene_graph/animation.h"
+#include "scene_graph/animation_state.h"
+#include "scene_graph/entity.h"
+#include "scene_graph/mesh.h"
+#include "scene_graph/scene.h"
+#include "scene_graph/scene_node.h"
+#include "scene_graph/skeleton_instance.h"
+#include "scene_graph/tag_point.h"
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace mmo;
+
+namespace
+{
+	constexpr float FrameTime = 1.0f / 60.0f;
+
+	/// Creates a skeleton with a spine of bones and two arms, and two animations which move all of them.
+	SkeletonPtr MakeCharacterSkeleton(const uint16 boneCount)
+	{
+		auto skeleton = std::make_shared<Skeleton>("Character");
+
+		std::vector<Bone*> bones;
+		for (uint16 i = 0; i < boneCount; ++i)
+		{
+			Bone* bone = skeleton->CreateBone("Bone" + std::to_string(i));
+			bone->SetPosition(Vector3(0.1f * (i % 3), 0.5f, 0.05f * (i % 5)));
+			bone->SetOrientation(Quaternion(Radian(0.1f * i), Vector3::UnitY));
+			bone->SetScale(Vector3(1.0f, 1.0f + 0.01f * (i % 4), 1.0f));
+
+			// Bones branch off the spine every few bones, so the hierarchy is not a plain chain
+			if (i > 0)
+			{
+				bones[(i % 4 == 0) ? i / 2 : i - 1]->AddChild(*bone);
+			}
+
+			bones.push_back(bone);
+		}
+
+		skeleton->SetBindingPose();
+
+		Animation& walk = skeleton->CreateAnimation("Walk", 1.0f);
+		for (uint16 i = 0; i < boneCount; ++i)
+		{
+			NodeAnimationTrack* track = walk.CreateNodeTrack(i);
+			for (int key = 0; key <= 8; ++key)
+			{
+				const float phase = key * 0.785f + i;
+				const auto keyFrame = track->CreateNodeKeyFrame(key * 0.125f);
+				keyFrame->SetTranslate(Vector3(0.05f * std::sin(phase), 0.02f * std::cos(phase), 0.0f));
+				keyFrame->SetRotation(Quaternion(Radian(0.5f * std::sin(phase)), Vector3(0.0f, 0.6f, 0.8f)));
+				keyFrame->SetScale(Vector3(1.0f + 0.1f * std::cos(phase), 1.0f, 1.0f));
+			}
+		}
+
+		// Only animates every other bone and has its key frames at other times than the walk animation
+		Animation& wave = skeleton->CreateAnimation("Wave", 2.0f);
+		for (uint16 i = 1; i < boneCount; i += 2)
+		{
+			NodeAnimationTrack* track = wave.CreateNodeTrack(i);
+			for (int key = 0; key < 5; ++key)
+			{
+				const auto keyFrame = track->CreateNodeKeyFrame(0.1f + key * 0.45f);
+				keyFrame->SetTranslate(Vector3(0.0f, 0.03f * key, 0.0f));
+				keyFrame->SetRotation(Quaternion(Radian(0.3f * key - 0.6f), Vector3::UnitX));
+			}
+		}
+
+		return skeleton;
+	}
+
+	struct AnimationFixture
+	{
+		Scene scene;
+		SkeletonPtr skeleton;
+		MeshPtr mesh;
+
+		explicit AnimationFixture(const uint16 boneCount = 24)
+			: skeleton(MakeCharacterSkeleton(boneCount))
+			, mesh(std::make_shared<Mesh>("Character"))
+		{
+			mesh->SetSkeleton(skeleton);
+		}
+
+		~AnimationFixture()
+		{
+			scene.Clear();
+		}
+
+		Entity& CreateCharacter(const std::string& name, const Vector3& position)
+		{
+			Entity& entity = *scene.CreateEntity(name, mesh);
+			scene.GetRootSceneNode().CreateChildSceneNode(position)->AttachObject(entity);
+
+			AnimationState* walk = entity.GetAnimationState("Walk");
+			walk->SetEnabled(true);
+			walk->SetLoop(true);
+			return entity;
+		}
+
+		/// Animates the given entities like a frame of Scene::Render would.
+		void Update(const std::vector<Entity*>& entities, const Vector3& viewerPosition = Vector3::Zero)
+		{
+			scene.BeginAnimationFrame(viewerPosition);
+			for (Entity* entity : entities)
+			{
+				scene.QueueAnimationUpdate(*entity);
+			}
+			scene.UpdateQueuedAnimations();
+		}
+	};
+
+	/// Evaluates the animation states of the entity on the bone nodes of a separate skeleton instance.
+	std::vector<Matrix4> EvaluateOnBoneNodes(SkeletonInstance& reference, const Entity& entity)
+	{
+		std::vector<Matrix4> matrices(reference.GetNumBones());
+		reference.SetAnimationState(*entity.GetAllAnimationStates());
+		reference.GetBoneMatrices(matrices.data());
+		return matrices;
+	}
+
+	void CheckMatricesEqual(const std::vector<Matrix4>& actual, const std::vector<Matrix4>& expected)
+	{
+		REQUIRE(actual.size() == expected.size());
+		for (size_t bone = 0; bone < actual.size(); ++bone)
+		{
+			for (size_t row = 0; row < 4; ++row)
+			{
+				for (size_t column = 0; column < 4; ++column)
+				{
+					CHECK(actual[bone][row][column] == Approx(expected[bone][row][column]).margin(1e-4f));
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("Skeleton poses match the evaluation on the bone nodes", "[animation]")
+{
+	AnimationFixture fixture;
+	Entity& entity = fixture.CreateCharacter("Character", Vector3::Zero);
+
+	SkeletonInstance reference(fixture.skeleton);
+	reference.Load();
+
+	TestMovable weapon("Weapon");
+	const TagPoint* tagPoint = entity.AttachObjectToBone("Bone9", weapon);
+
+	// Both animations together exceed a total weight of 1, so the weights are rebalanced
+	AnimationState* walk = entity.GetAnimationState("Walk");
+	walk->SetWeight(0.8f);
+	AnimationState* wave = entity.GetAnimationState("Wave");
+	wave->SetEnabled(true);
+	wave->SetLoop(true);
+	wave->SetWeight(0.6f);
+	wave->CreateBlendMask(fixture.skeleton->GetNumBones());
+	wave->SetBlendMaskEntry(3, 0.25f);
+	wave->SetBlendMaskEntry(5, 0.0f);
+
+	// Covers sampling between key frames, exactly on key frames, past the last key frame and looping
+	for (const float timeStep : { 0.0f, 0.05f, 0.07f, 0.125f, 0.5f, 0.3f, 0.9f, 0.4f, 1.3f })
+	{
+		walk->AddTime(timeStep);
+		wave->AddTime(timeStep);
+		fixture.Update({ &entity });
+
+		INFO("walk time " << walk->GetTimePosition() << ", wave time " << wave->GetTimePosition());
+		CheckMatricesEqual(entity.GetBoneMatrices(), EvaluateOnBoneNodes(reference, entity));
+
+		// Bone nodes and tag points see the evaluated pose as well
+		const Bone* bone = entity.GetSkeleton()->GetBone("Bone9");
+		const Vector3 expected = reference.GetBone("Bone9")->GetDerivedPosition();
+		CHECK(bone->GetDerivedPosition().IsNearlyEqual(expected, 1e-4f));
+		CHECK(tagPoint->GetDerivedPosition().IsNearlyEqual(expected, 1e-4f));
+	}
+
+	entity.DetachAllObjectsFromBone();
+}
+
+TEST_CASE("Spline animations are evaluated on the bone nodes", "[animation]")
+{
+	AnimationFixture fixture;
+	fixture.skeleton->GetAnimation("Walk")->SetInterpolationMode(Animation::InterpolationMode::Spline);
+
+	Entity& entity = fixture.CreateCharacter("Character", Vector3::Zero);
+
+	SkeletonInstance reference(fixture.skeleton);
+	reference.Load();
+
+	for (int frame = 0; frame < 10; ++frame)
+	{
+		entity.GetAnimationState("Walk")->AddTime(0.07f);
+		fixture.Update({ &entity });
+		CheckMatricesEqual(entity.GetBoneMatrices(), EvaluateOnBoneNodes(reference, entity));
+	}
+}
+
+TEST_CASE("Distant and off screen entities are animated less often", "[animation]")
+{
+	AnimationFixture fixture;
+	fixture.scene.SetAnimationLod(50.0f, 4);
+
+	Entity& near = fixture.CreateCharacter("Near", Vector3(0.0f, 0.0f, 10.0f));
+	Entity& medium = fixture.CreateCharacter("Medium", Vector3(0.0f, 0.0f, 120.0f));
+	Entity& far = fixture.CreateCharacter("Far", Vector3(0.0f, 0.0f, 500.0f));
+	const std::vector<Entity*> entities { &near, &medium, &far };
+
+	std::vector<int> updates(entities.size(), 0);
+	for (int frame = 0; frame < 12; ++frame)
+	{
+		std::vector<std::vector<Matrix4>> previous;
+		for (Entity* entity : entities)
+		{
+			entity->GetAnimationState("Walk")->AddTime(FrameTime);
+			previous.push_back(entity->GetBoneMatrices());
+		}
+
+		fixture.Update(entities);
+
+		for (size_t i = 0; i < entities.size(); ++i)
+		{
+			updates[i] += (entities[i]->GetBoneMatrices() != previous[i]) ? 1 : 0;
+		}
+	}
+
+	CHECK(updates[0] == 12);
+	CHECK(updates[1] == 6);
+	CHECK(updates[2] == 3);
+
+	// An entity is animated at most once per frame, even if its animations change in between
+	near.GetAnimationState("Walk")->AddTime(FrameTime);
+	const std::vector<Matrix4> before = near.GetBoneMatrices();
+	fixture.scene.QueueAnimationUpdate(near);
+	fixture.scene.UpdateQueuedAnimations();
+	CHECK(near.GetBoneMatrices() == before);
+}
+
+TEST_CASE("Animations evaluated on a job system match the single threaded evaluation", "[animation]")
+{
+	constexpr int CharacterCount = 16;
+
+	const auto animate = [](JobSystem* jobSystem)
+	{
+		AnimationFixture fixture;
+		fixture.scene.SetJobSystem(jobSystem);
+
+		std::vector<Entity*> entities;
+		for (int i = 0; i < CharacterCount; ++i)
+		{
+			Entity& entity = fixture.CreateCharacter("Character" + std::to_string(i), Vector3(i * 2.0f, 0.0f, 0.0f));
+			entity.GetAnimationState("Walk")->SetTimePosition(0.05f * i);
+			entities.push_back(&entity);
+		}
+
+		std::vector<std::vector<Matrix4>> matrices;
+		for (int frame = 0; frame < 30; ++frame)
+		{
+			for (Entity* entity : entities)
+			{
+				entity->GetAnimationState("Walk")->AddTime(FrameTime);
+			}
+
+			fixture.Update(entities);
+		}
+
+		for (const Entity* entity : entities)
+		{
+			matrices.push_back(entity->GetBoneMatrices());
+		}
+		return matrices;
+	};
+
+	const auto serial = animate(nullptr);
+
+	JobSystem jobs(3);
+	const auto parallel = animate(&jobs);
+
+	REQUIRE(serial.size() == parallel.size());
+	for (size_t i = 0; i < serial.size(); ++i)
+	{
+		CHECK(serial[i] == parallel[i]);
+	}
+}
+
+TEST_CASE("Skeletal animation benchmark", "[animation][!benchmark]")
+{
+	constexpr int CharacterCount = 200;
+
+	AnimationFixture fixture(64);
+
+	std::vector<Entity*> entities;
+	std::vector<std::unique_ptr<SkeletonInstance>> references;
+	for (int i = 0; i < CharacterCount; ++i)
+	{
+		Entity& entity = fixture.CreateCharacter("Character" + std::to_string(i), Vector3((i % 20) * 2.0f, 0.0f, (i / 20) * 2.0f));
+		entity.GetAnimationState("Walk")->SetTimePosition(0.01f * i);
+		entities.push_back(&entity);
+
+		references.push_back(std::make_unique<SkeletonInstance>(fixture.skeleton));
+		references.back()->Load();
+	}
+
+	std::vector<Matrix4> matrices(fixture.skeleton->GetNumBones());
+	const auto advance = [&entities]()
+	{
+		for (Entity* entity : entities)
+		{
+			entity->GetAnimationState("Walk")->AddTime(FrameTime);
+		}
+	};
+
+	BENCHMARK("200 characters, bone nodes")
+	{
+		advance();
+		for (int i = 0; i < CharacterCount; ++i)
+		{
+			references[i]->SetAnimationState(*entities[i]->GetAllAnimationStates());
+			references[i]->GetBoneMatrices(matrices.data());
+		}
+	};
+
+	BENCHMARK("200 characters, skeleton pose")
+	{
+		advance();
+		fixture.Update(entities);
+	};
+
+	JobSystem jobs;
+	fixture.scene.SetJobSystem(&jobs);
+	BENCHMARK("200 characters, skeleton pose on job system")
+	{
+		advance();
+		fixture.Update(entities);
+	};
+
+	fixture.scene.SetJobSystem(nullptr);
+}
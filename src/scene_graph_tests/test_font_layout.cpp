@@ -0,0 +1,77 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "assets/asset_registry.h"
+#include "frame_ui/font.h"
+
+#include <string>
+
+using namespace mmo;
+
+namespace
+{
+	/// A glyph of the test font (U+F000). The font only contains icon glyphs in the private use area.
+	const std::string Glyph = "\xef\x80\x80";
+
+	/// Loads a font which ships with the freetype documentation through the asset registry.
+	struct FontFixture
+	{
+		Font font;
+
+		FontFixture()
+		{
+			AssetRegistry::Initialize(MMO_TEST_FONT_DIR, {});
+			REQUIRE(font.Initialize("FontAwesome.ttf", 12.0f));
+		}
+
+		~FontFixture()
+		{
+			AssetRegistry::Destroy();
+		}
+	};
+}
+
+TEST_CASE("Text layouts are cached per text and scale", "[font]")
+{
+	FontFixture fixture;
+	Font& font = fixture.font;
+
+	const TextLayout& layout = font.GetTextLayout(Glyph + Glyph);
+	REQUIRE(layout.glyphs.size() == 2);
+	CHECK(layout.width > 0.0f);
+
+	// Asking for the same text again returns the cached layout
+	CHECK(&font.GetTextLayout(Glyph + Glyph) == &layout);
+	CHECK(font.GetTextWidth(Glyph + Glyph) == layout.width);
+
+	// Other scales are laid out separately
+	const TextLayout& scaled = font.GetTextLayout(Glyph + Glyph, 2.0f);
+	CHECK(&scaled != &layout);
+	CHECK(scaled.width == Approx(layout.width * 2.0f));
+	CHECK(scaled.glyphs[1].position.x == Approx(layout.glyphs[1].position.x * 2.0f));
+}
+
+TEST_CASE("Multi-line text layouts advance by the line height", "[font]")
+{
+	FontFixture fixture;
+	Font& font = fixture.font;
+
+	const TextLayout& singleLine = font.GetTextLayout(Glyph + Glyph);
+	const float singleLineWidth = singleLine.width;
+
+	const TextLayout& layout = font.GetTextLayout(Glyph + Glyph + "\n" + Glyph + "\n\n" + Glyph);
+	REQUIRE(layout.glyphs.size() == 4);
+
+	// Every line starts at the left edge
+	CHECK(layout.glyphs[2].position.x == Approx(layout.glyphs[0].position.x));
+	CHECK(layout.glyphs[3].position.x == Approx(layout.glyphs[0].position.x));
+
+	// Glyphs of a line share their baseline, each line break moves it down by one line height
+	CHECK(layout.glyphs[1].position.y == Approx(layout.glyphs[0].position.y));
+	CHECK(layout.glyphs[2].position.y == Approx(layout.glyphs[0].position.y + font.GetHeight()));
+	CHECK(layout.glyphs[3].position.y == Approx(layout.glyphs[0].position.y + font.GetHeight() * 3.0f));
+
+	// The width is the width of the longest line
+	CHECK(layout.width == Approx(singleLineWidth));
+}
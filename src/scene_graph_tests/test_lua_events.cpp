@@ -0,0 +1,237 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "frame_ui/frame_mgr.h"
+
+#include "lua/lua.hpp"
+#include "luabind/luabind.hpp"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace mmo;
+
+namespace
+{
+	/// Called by the lua function RunTestAction, so that handlers can change subscriptions while they are dispatched.
+	std::function<void()> s_testAction;
+
+	int RunTestAction(lua_State*)
+	{
+		if (s_testAction)
+		{
+			s_testAction();
+		}
+
+		return 0;
+	}
+
+	/// Sets up a lua state with a frame manager and records the texts of the frames whose handlers were called.
+	class LuaEventFixture
+	{
+	public:
+		LuaEventFixture()
+			: m_luaState(luaL_newstate())
+		{
+			luaL_openlibs(m_luaState);
+			luabind::open(m_luaState);
+			FrameManager::Initialize(m_luaState, m_localization);
+
+			lua_register(m_luaState, "RunTestAction", &RunTestAction);
+			FrameManager::Get().ExecuteLua(
+				"calls = {}\n"
+				"function RecordCall(self) table.insert(calls, self:GetText()) end\n"
+				"function RecordCallAndRunAction(self) table.insert(calls, self:GetText()); RunTestAction() end\n"
+				"function RecordBatch(self, batch) table.insert(calls, self:GetText() .. ':' .. #batch .. ':' .. batch[1][1] .. ':' .. batch[#batch][1]) end\n");
+		}
+
+		~LuaEventFixture()
+		{
+			s_testAction = nullptr;
+			m_frames.clear();
+
+			FrameManager::Destroy();
+			lua_close(m_luaState);
+		}
+
+	protected:
+		FramePtr CreateFrame(const std::string& text)
+		{
+			FramePtr frame = FrameManager::Get().Create("Frame", "");
+			frame->SetText(text);
+			m_frames.push_back(frame);
+			return frame;
+		}
+
+		luabind::object Global(const char* name) const
+		{
+			return luabind::globals(m_luaState)[name];
+		}
+
+		std::vector<std::string> TakeCalls()
+		{
+			std::vector<std::string> result;
+			const luabind::object calls = Global("calls");
+			for (luabind::iterator it(calls), end; it != end; ++it)
+			{
+				result.push_back(luabind::object_cast<std::string>(*it));
+			}
+
+			FrameManager::Get().ExecuteLua("calls = {}");
+			return result;
+		}
+
+	protected:
+		Localization m_localization;
+		lua_State* m_luaState;
+		std::vector<FramePtr> m_frames;
+	};
+}
+
+TEST_CASE_METHOD(LuaEventFixture, "Lua event handlers are called in registration order", "[lua_events]")
+{
+	const FramePtr first = CreateFrame("first");
+	const FramePtr second = CreateFrame("second");
+	const FramePtr third = CreateFrame("third");
+
+	first->RegisterEvent("TEST_EVENT", Global("RecordCall"));
+	second->RegisterEvent("TEST_EVENT", Global("RecordCall"));
+	third->RegisterEvent("TEST_EVENT", Global("RecordCall"));
+
+	// Registering again replaces the handler but keeps the position
+	second->RegisterEvent("TEST_EVENT", Global("RecordCall"));
+
+	FrameManager::Get().TriggerLuaEvent("TEST_EVENT");
+	CHECK(TakeCalls() == std::vector<std::string>{ "first", "second", "third" });
+
+	// The interned id reaches the same handlers
+	CachedLuaEvent event("TEST_EVENT");
+	FrameManager::Get().TriggerLuaEvent(event.GetId());
+	CHECK(TakeCalls() == std::vector<std::string>{ "first", "second", "third" });
+
+	// Events nobody ever registered for are ignored
+	FrameManager::Get().TriggerLuaEvent("UNKNOWN_EVENT");
+	CHECK(TakeCalls().empty());
+}
+
+TEST_CASE_METHOD(LuaEventFixture, "Lua event subscriptions may change while the event is dispatched", "[lua_events]")
+{
+	const FramePtr first = CreateFrame("first");
+	const FramePtr second = CreateFrame("second");
+	const FramePtr third = CreateFrame("third");
+	const FramePtr late = CreateFrame("late");
+
+	first->RegisterEvent("TEST_EVENT", Global("RecordCallAndRunAction"));
+	second->RegisterEvent("TEST_EVENT", Global("RecordCall"));
+	third->RegisterEvent("TEST_EVENT", Global("RecordCall"));
+
+	int depth = 0;
+	s_testAction = [&]()
+	{
+		if (depth++ > 0)
+		{
+			return;
+		}
+
+		// Remove a subscriber which wasn't called yet and add a new one, then dispatch the same event again
+		second->UnregisterEvent("TEST_EVENT");
+		late->RegisterEvent("TEST_EVENT", Global("RecordCall"));
+		FrameManager::Get().TriggerLuaEvent("TEST_EVENT");
+	};
+
+	FrameManager::Get().TriggerLuaEvent("TEST_EVENT");
+
+	// The nested dispatch already reaches the new subscriber, the outer one only the subscribers it started with
+	CHECK(TakeCalls() == std::vector<std::string>{ "first", "first", "third", "late", "third" });
+
+	// Removed entries are compacted once no dispatch is running
+	s_testAction = nullptr;
+	FrameManager::Get().TriggerLuaEvent("TEST_EVENT");
+	CHECK(TakeCalls() == std::vector<std::string>{ "first", "third", "late" });
+
+	// A frame can subscribe again after it was removed
+	second->RegisterEvent("TEST_EVENT", Global("RecordCall"));
+	FrameManager::Get().TriggerLuaEvent("TEST_EVENT");
+	CHECK(TakeCalls() == std::vector<std::string>{ "first", "third", "late", "second" });
+}
+
+TEST_CASE_METHOD(LuaEventFixture, "Lua event handlers may destroy their own frame", "[lua_events]")
+{
+	// Only the test holds a reference to this frame
+	FramePtr doomed = FrameManager::Get().Create("Frame", "");
+	doomed->SetText("doomed");
+
+	const FramePtr survivor = CreateFrame("survivor");
+
+	FrameManager::Get().ExecuteLua("function DestroyAndRecord(self) RunTestAction(); table.insert(calls, self:GetText()) end");
+	doomed->RegisterEvent("TEST_EVENT", Global("DestroyAndRecord"));
+	survivor->RegisterEvent("TEST_EVENT", Global("RecordCall"));
+
+	s_testAction = [&]() { doomed.reset(); };
+
+	// The frame is kept alive until its handler returned
+	FrameManager::Get().TriggerLuaEvent("TEST_EVENT");
+	CHECK(doomed == nullptr);
+	CHECK(TakeCalls() == std::vector<std::string>{ "doomed", "survivor" });
+
+	FrameManager::Get().TriggerLuaEvent("TEST_EVENT");
+	CHECK(TakeCalls() == std::vector<std::string>{ "survivor" });
+}
+
+TEST_CASE_METHOD(LuaEventFixture, "Batched lua event handlers receive all events of an update at once", "[lua_events]")
+{
+	const FramePtr immediate = CreateFrame("immediate");
+	const FramePtr batched = CreateFrame("batched");
+
+	immediate->RegisterEvent("TEST_EVENT", Global("RecordCall"));
+	batched->RegisterBatchedEvent("TEST_EVENT", Global("RecordBatch"));
+
+	for (int i = 1; i <= 3; ++i)
+	{
+		FrameManager::Get().TriggerLuaEvent("TEST_EVENT", i);
+	}
+
+	// Only the immediate handler was called so far
+	CHECK(TakeCalls() == std::vector<std::string>{ "immediate", "immediate", "immediate" });
+
+	FrameManager::Get().Update(0.0f);
+	CHECK(TakeCalls() == std::vector<std::string>{ "batched:3:1:3" });
+	CHECK(FrameManager::Get().GetEventStats().batchedEvents == 3);
+
+	// Nothing is delivered for an update without events
+	FrameManager::Get().Update(0.0f);
+	CHECK(TakeCalls().empty());
+
+	// Switching back to an immediate handler
+	batched->RegisterEvent("TEST_EVENT", Global("RecordCall"));
+	FrameManager::Get().TriggerLuaEvent("TEST_EVENT", 4);
+	FrameManager::Get().FlushBatchedEvents();
+	CHECK(TakeCalls() == std::vector<std::string>{ "immediate", "batched" });
+}
+
+TEST_CASE("Cached lua event ids are interned again for a new frame manager", "[lua_events]")
+{
+	CachedLuaEvent event("SECOND_EVENT");
+
+	for (int i = 0; i < 2; ++i)
+	{
+		lua_State* luaState = luaL_newstate();
+		luabind::open(luaState);
+
+		Localization localization;
+		FrameManager::Initialize(luaState, localization);
+
+		// The event gets a different id depending on which names were interned before
+		if (i == 0)
+		{
+			FrameManager::Get().InternEvent("FIRST_EVENT");
+		}
+
+		CHECK(event.GetId() == FrameManager::Get().InternEvent("SECOND_EVENT"));
+
+		FrameManager::Destroy();
+		lua_close(luaState);
+	}
+}
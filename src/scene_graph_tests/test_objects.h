@@ -0,0 +1,93 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "scene_graph/movable_object.h"
+#include "scene_graph/queued_renderable_visitor.h"
+#include "scene_graph/render_queue.h"
+#include "scene_graph/renderable.h"
+#include "graphics/material.h"
+#include "math/aabb.h"
+#include "math/matrix4.h"
+
+#include <utility>
+#include <vector>
+
+namespace mmo
+{
+	/// A renderable which only carries a material, for render queue tests.
+	class TestRenderable final : public Renderable
+	{
+	public:
+		explicit TestRenderable(MaterialPtr material = nullptr)
+			: m_material(std::move(material))
+		{
+		}
+
+		void PrepareRenderOperation(RenderOperation& /*operation*/) override {}
+		const Matrix4& GetWorldTransform() const override { return Matrix4::Identity; }
+		float GetSquaredViewDepth(const Camera& /*camera*/) const override { return 0.0f; }
+		MaterialPtr GetMaterial() const override { return m_material; }
+
+	private:
+		MaterialPtr m_material;
+	};
+
+	/// A unit sized box which queues a single renderable when it is visible.
+	class TestMovable final : public MovableObject
+	{
+	public:
+		explicit TestMovable(const String& name)
+			: MovableObject(name)
+		{
+		}
+
+		const String& GetMovableType() const override
+		{
+			static const String s_type = "TestMovable";
+			return s_type;
+		}
+
+		const AABB& GetBoundingBox() const override
+		{
+			static const AABB s_aabb{ Vector3(-0.5f, -0.5f, -0.5f), Vector3(0.5f, 0.5f, 0.5f) };
+			return s_aabb;
+		}
+
+		float GetBoundingRadius() const override { return 0.87f; }
+
+		void VisitRenderables(Renderable::Visitor& visitor, bool /*debugRenderables*/ = false) override { visitor.Visit(m_renderable, 0, false); }
+
+		void PopulateRenderQueue(RenderQueue& queue) override { queue.AddRenderable(m_renderable, GetRenderQueueGroup()); }
+
+		TestRenderable& GetRenderable() { return m_renderable; }
+
+	private:
+		TestRenderable m_renderable;
+	};
+
+	/// Records the renderables of a render queue in the order in which they would be rendered.
+	struct RecordingVisitor final : QueuedRenderableVisitor
+	{
+		void Visit(RenderablePass& /*rp*/) override {}
+		bool Visit(const Pass& /*p*/) override { return true; }
+		void Visit(Renderable& r, const uint32 groupId) override { visited.emplace_back(groupId, &r); }
+
+		std::vector<std::pair<uint32, Renderable*>> visited;
+	};
+
+	/// Gets all renderables of a render queue in the order in which they would be rendered.
+	inline std::vector<std::pair<uint32, Renderable*>> GetQueuedRenderables(RenderQueue& queue)
+	{
+		RecordingVisitor visitor;
+		for (auto& [groupId, group] : queue)
+		{
+			for (const auto& [priority, priorityGroup] : *group)
+			{
+				priorityGroup->GetSolids().AcceptVisitor(visitor);
+			}
+		}
+
+		return visitor.visited;
+	}
+}
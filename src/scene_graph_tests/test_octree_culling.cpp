@@ -0,0 +1,129 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "test_objects.h"
+
+#include "base/job_system.h"
+#include "scene_graph/camera.h"
+#include "scene_graph/octree_scene.h"
+#include "scene_graph/scene_node.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace mmo;
+
+namespace
+{
+	/// Exposes the culling pass of the octree scene, which is normally only run as part of Render.
+	class CullingTestScene final : public OctreeScene
+	{
+	public:
+		using OctreeScene::FindVisibleObjects;
+	};
+
+	/// An octree scene filled with a grid of small objects around a camera at the origin.
+	struct CullingFixture
+	{
+		CullingTestScene scene;
+		Camera* camera { nullptr };
+		std::vector<std::unique_ptr<TestMovable>> objects;
+
+		explicit CullingFixture(const int halfExtent, const float spacing)
+		{
+			camera = scene.CreateCamera("Camera");
+			camera->SetFarClipDistance(halfExtent * spacing * 0.75f);
+			scene.GetRootSceneNode().CreateChildSceneNode(Vector3(0.0f, 2.0f, 0.0f))->AttachObject(*camera);
+
+			for (int x = -halfExtent; x <= halfExtent; ++x)
+			{
+				for (int z = -halfExtent; z <= halfExtent; ++z)
+				{
+					auto& object = objects.emplace_back(std::make_unique<TestMovable>("Object" + std::to_string(objects.size())));
+					scene.GetRootSceneNode().CreateChildSceneNode(Vector3(x * spacing, 0.0f, z * spacing))->AttachObject(*object);
+				}
+			}
+
+			scene.UpdateSceneGraph();
+		}
+
+		~CullingFixture()
+		{
+			// Remove all nodes while the octree still exists, the scene destructor would only do so after the
+			// octree has been destroyed
+			objects.clear();
+			scene.Clear();
+		}
+
+		std::vector<std::pair<uint32, Renderable*>> Cull()
+		{
+			VisibleObjectsBoundsInfo bounds;
+			scene.FindVisibleObjects(*camera, bounds, false);
+			return GetQueuedRenderables(scene.GetRenderQueue());
+		}
+	};
+}
+
+TEST_CASE("Parallel octree culling queues the same renderables in the same order", "[octree_culling]")
+{
+	CullingFixture fixture(20, 12.0f);
+
+	const auto serial = fixture.Cull();
+
+	// Only the objects in front of the camera are visible
+	CHECK(!serial.empty());
+	CHECK(serial.size() < fixture.objects.size() / 2);
+
+	JobSystem jobs(3);
+	fixture.scene.SetJobSystem(&jobs);
+
+	const auto parallel = fixture.Cull();
+	CHECK(parallel == serial);
+
+	// Culling again reuses the cull tasks of the previous frame
+	CHECK(fixture.Cull() == serial);
+
+	fixture.scene.SetJobSystem(nullptr);
+}
+
+TEST_CASE("Octree culling only queues objects inside the camera frustum", "[octree_culling]")
+{
+	CullingFixture fixture(10, 8.0f);
+
+	JobSystem jobs(2);
+	fixture.scene.SetJobSystem(&jobs);
+
+	const auto queued = fixture.Cull();
+	REQUIRE(!queued.empty());
+
+	for (const auto& object : fixture.objects)
+	{
+		const bool isQueued = std::find(queued.begin(), queued.end(), std::make_pair(static_cast<uint32>(Main), static_cast<Renderable*>(&object->GetRenderable()))) != queued.end();
+		CHECK(isQueued == fixture.camera->IsVisible(object->GetWorldBoundingBox(true)));
+	}
+
+	fixture.scene.SetJobSystem(nullptr);
+}
+
+TEST_CASE("Benchmark octree culling", "[!benchmark]")
+{
+	CullingFixture fixture(60, 4.0f);
+	JobSystem jobs;
+
+	BENCHMARK("Single threaded")
+	{
+		fixture.scene.SetJobSystem(nullptr);
+		return fixture.Cull().size();
+	};
+
+	BENCHMARK("Job system")
+	{
+		fixture.scene.SetJobSystem(&jobs);
+		return fixture.Cull().size();
+	};
+
+	fixture.scene.SetJobSystem(nullptr);
+}
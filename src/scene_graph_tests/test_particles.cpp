@@ -0,0 +1,277 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "base/job_system.h"
+#include "base/random.h"
+#include "graphics/material.h"
+#include "scene_graph/camera.h"
+#include "scene_graph/particle_emitter.h"
+#include "scene_graph/scene.h"
+#include "scene_graph/scene_node.h"
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace mmo;
+
+namespace
+{
+	constexpr float FrameTime = 1.0f / 60.0f;
+
+	/// Emitter parameters which spawn a single burst of particles that neither move nor die during a test.
+	EmitterParameters MakeStaticBurst(const uint32 count)
+	{
+		EmitterParameters params;
+		params.spawnRate = 0.0f;
+		params.maxParticles = count;
+		params.loop = false;
+		params.bursts.push_back(EmitterBurst{ 0.0f, count });
+		params.minLifetime = params.maxLifetime = 100.0f;
+		params.minVelocity = params.maxVelocity = Vector3::Zero;
+		params.gravity = Vector3::Zero;
+		params.shape = EmitterShape::Box;
+		params.shapeExtents = Vector3(20.0f, 20.0f, 20.0f);
+		return params;
+	}
+
+	/// Emitter parameters which exercise all forces and spawn and kill particles continuously.
+	EmitterParameters MakeBusyEmitter()
+	{
+		EmitterParameters params;
+		params.spawnRate = 60.0f;
+		params.maxParticles = 256;
+		params.minLifetime = 0.5f;
+		params.maxLifetime = 2.0f;
+		params.shape = EmitterShape::Sphere;
+		params.shapeExtents = Vector3(2.0f, 0.0f, 0.0f);
+		params.drag = 0.5f;
+		params.radialAcceleration = 1.0f;
+		params.orbitalSpeed = 0.5f;
+		params.noiseAmplitude = 0.3f;
+		params.sizeOverLife = FloatCurve(0.5f, 2.0f);
+		return params;
+	}
+
+	struct ParticleFixture
+	{
+		Scene scene;
+		Camera* camera { nullptr };
+		SceneNode* cameraNode { nullptr };
+
+		ParticleFixture()
+		{
+			camera = scene.CreateCamera("Camera");
+			cameraNode = scene.GetRootSceneNode().CreateChildSceneNode(Vector3::Zero);
+			cameraNode->AttachObject(*camera);
+		}
+
+		ParticleSystem& CreateSystem(const std::string& name, const EmitterParameters& params, const Vector3& position)
+		{
+			ParticleSystem& system = *scene.CreateParticleEmitter(name);
+			system.SetParameters(params);
+			system.Play();
+			scene.GetRootSceneNode().CreateChildSceneNode(position)->AttachObject(system);
+			return system;
+		}
+	};
+
+	bool IsSortedBackToFront(const EmitterInstance& emitter, const Vector3& cameraPosition)
+	{
+		const ParticleStore& particles = emitter.GetParticles();
+
+		float lastDistance = std::numeric_limits<float>::max();
+		for (size_t i = 0; i < particles.GetCount(); ++i)
+		{
+			const Vector3 position = emitter.GetWorldTransform().TransformAffine(particles.Get(i).position);
+			const float distance = (position - cameraPosition).GetSquaredLength();
+			if (distance > lastDistance)
+			{
+				return false;
+			}
+			lastDistance = distance;
+		}
+
+		return true;
+	}
+}
+
+TEST_CASE("Expired particles are removed without changing the order of the others", "[particles]")
+{
+	ParticleStore store;
+	for (int i = 0; i < 6; ++i)
+	{
+		Particle particle {};
+		particle.position = Vector3(static_cast<float>(i), 0.0f, 0.0f);
+		particle.lifetime = 1.0f;
+		particle.age = (i % 2 == 0) ? 1.0f : 0.5f;
+		particle.spriteIndex = i;
+		store.Push(particle);
+	}
+
+	store.RemoveExpired();
+
+	REQUIRE(store.GetCount() == 3);
+	CHECK(store.Get(0).spriteIndex == 1);
+	CHECK(store.Get(1).spriteIndex == 3);
+	CHECK(store.Get(2).spriteIndex == 5);
+	CHECK(store.positionX == std::vector<float>{ 1.0f, 3.0f, 5.0f });
+
+	std::vector<float> floatScratch;
+	std::vector<uint32> indexScratch;
+	store.Permute({ 2, 0, 1 }, floatScratch, indexScratch);
+	CHECK(store.positionX == std::vector<float>{ 5.0f, 1.0f, 3.0f });
+	CHECK(store.spriteIndex == std::vector<uint32>{ 5, 1, 3 });
+}
+
+TEST_CASE("Particles are integrated and follow their size curve", "[particles]")
+{
+	ParticleFixture fixture;
+
+	EmitterParameters params = MakeStaticBurst(1);
+	params.shape = EmitterShape::Point;
+	params.minLifetime = params.maxLifetime = 1.0f;
+	params.minVelocity = params.maxVelocity = Vector3(1.0f, 0.0f, 0.0f);
+	params.gravity = Vector3(0.0f, -10.0f, 0.0f);
+	params.sizeOverLife = FloatCurve(1.0f, 3.0f);
+	ParticleSystem& system = fixture.CreateSystem("Particles", params, Vector3::Zero);
+
+	float time = 0.0f;
+	for (int frame = 0; frame < 30; ++frame)
+	{
+		fixture.scene.UpdateParticleEmitters(FrameTime);
+		time += FrameTime;
+	}
+
+	const EmitterInstance& emitter = *system.GetEmitter(0);
+	REQUIRE(emitter.GetParticleCount() == 1);
+
+	// Semi-implicit euler with a constant acceleration
+	const Particle particle = emitter.GetParticles().Get(0);
+	CHECK(particle.position.x == Approx(time).margin(1e-4f));
+	CHECK(particle.velocity.y == Approx(-10.0f * time).margin(1e-4f));
+	CHECK(particle.position.y == Approx(-10.0f * FrameTime * FrameTime * 30.0f * 31.0f / 2.0f).margin(1e-4f));
+	CHECK(particle.age == Approx(time));
+	CHECK(particle.size == Approx(params.sizeOverLife.Evaluate(particle.age / particle.lifetime)).margin(1e-2f));
+
+	for (int frame = 0; frame < 40; ++frame)
+	{
+		fixture.scene.UpdateParticleEmitters(FrameTime);
+	}
+
+	CHECK(emitter.GetParticleCount() == 0);
+}
+
+TEST_CASE("Translucent particles are sorted back to front", "[particles]")
+{
+	ParticleFixture fixture;
+
+	const auto material = std::make_shared<Material>("Translucent");
+	material->SetType(MaterialType::Translucent);
+
+	ParticleSystem& system = fixture.CreateSystem("Particles", MakeStaticBurst(64), Vector3(0.0f, 0.0f, -15.0f));
+	system.SetMaterial(material);
+
+	fixture.scene.UpdateParticleEmitters(FrameTime);
+	REQUIRE(system.GetTotalParticleCount() == 64);
+	CHECK(IsSortedBackToFront(*system.GetEmitter(0), fixture.camera->GetDerivedPosition()));
+
+	// Small camera movements keep the order of the last frame and only repair it
+	for (int i = 1; i <= 10; ++i)
+	{
+		fixture.cameraNode->SetPosition(Vector3(0.04f * i, 0.0f, -0.04f * i));
+		fixture.scene.UpdateParticleEmitters(FrameTime);
+		CHECK(IsSortedBackToFront(*system.GetEmitter(0), fixture.camera->GetDerivedPosition()));
+	}
+
+	// Moving to the other side of the particles reverses the order
+	fixture.cameraNode->SetPosition(Vector3(0.0f, 0.0f, -40.0f));
+	fixture.scene.UpdateParticleEmitters(FrameTime);
+	CHECK(IsSortedBackToFront(*system.GetEmitter(0), fixture.camera->GetDerivedPosition()));
+
+	// So does moving the particles to the other side of a camera that stays in place
+	system.GetParentSceneNode()->SetPosition(Vector3(0.0f, 0.0f, -65.0f));
+	fixture.scene.UpdateParticleEmitters(FrameTime);
+	CHECK(IsSortedBackToFront(*system.GetEmitter(0), fixture.camera->GetDerivedPosition()));
+}
+
+TEST_CASE("Particle systems simulated on a job system match the single threaded simulation", "[particles]")
+{
+	constexpr int SystemCount = 16;
+
+	const auto simulate = [](JobSystem* jobSystem)
+	{
+		RandomGenerator.seed(1234);
+
+		auto fixture = std::make_unique<ParticleFixture>();
+		fixture->scene.SetJobSystem(jobSystem);
+
+		std::vector<ParticleSystem*> systems;
+		for (int i = 0; i < SystemCount; ++i)
+		{
+			systems.push_back(&fixture->CreateSystem("Particles" + std::to_string(i), MakeBusyEmitter(), Vector3(i * 5.0f, 0.0f, -10.0f)));
+		}
+
+		for (int frame = 0; frame < 90; ++frame)
+		{
+			fixture->scene.UpdateParticleEmitters(FrameTime);
+		}
+
+		std::vector<std::vector<float>> positions;
+		for (const ParticleSystem* system : systems)
+		{
+			const ParticleStore& particles = system->GetEmitter(0)->GetParticles();
+			positions.push_back(particles.positionX);
+			positions.push_back(particles.positionY);
+			positions.push_back(particles.positionZ);
+			positions.push_back(particles.size);
+		}
+		return positions;
+	};
+
+	const auto serial = simulate(nullptr);
+
+	JobSystem jobs(3);
+	const auto parallel = simulate(&jobs);
+
+	REQUIRE(serial.size() == parallel.size());
+	CHECK(!serial.front().empty());
+	for (size_t i = 0; i < serial.size(); ++i)
+	{
+		CHECK(serial[i] == parallel[i]);
+	}
+}
+
+TEST_CASE("Particle simulation benchmark", "[particles][!benchmark]")
+{
+	constexpr int SystemCount = 2000;
+
+	ParticleFixture fixture;
+	for (int i = 0; i < SystemCount; ++i)
+	{
+		fixture.CreateSystem("Particles" + std::to_string(i), MakeBusyEmitter(), Vector3((i % 50) * 5.0f, 0.0f, (i / 50) * -5.0f));
+	}
+
+	// Fill the emitters before measuring
+	for (int frame = 0; frame < 120; ++frame)
+	{
+		fixture.scene.UpdateParticleEmitters(FrameTime);
+	}
+
+	BENCHMARK("2000 emitters, single threaded")
+	{
+		fixture.scene.SetJobSystem(nullptr);
+		fixture.scene.UpdateParticleEmitters(FrameTime);
+	};
+
+	JobSystem jobs;
+	BENCHMARK("2000 emitters, job system")
+	{
+		fixture.scene.SetJobSystem(&jobs);
+		fixture.scene.UpdateParticleEmitters(FrameTime);
+	};
+
+	fixture.scene.SetJobSystem(nullptr);
+}
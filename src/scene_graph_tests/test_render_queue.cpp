@@ -0,0 +1,116 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "test_objects.h"
+
+#include <memory>
+
+using namespace mmo;
+
+TEST_CASE("Render queue groups are iterated in ascending id order", "[render_queue]")
+{
+	RenderQueue queue;
+	TestRenderable overlay, sky, main, transparent;
+
+	queue.AddRenderable(overlay, Overlay);
+	queue.AddRenderable(transparent, Transparent);
+	queue.AddRenderable(sky, SkiesEarly);
+	queue.AddRenderable(main, Main);
+
+	std::vector<uint8> groupIds;
+	for (const auto& [groupId, group] : queue)
+	{
+		groupIds.push_back(groupId);
+		CHECK(group->GetGroupId() == groupId);
+	}
+
+	CHECK(groupIds == std::vector<uint8>{ SkiesEarly, Main, Transparent, Overlay });
+	CHECK(queue.GetQueueGroup(Overlay) == queue.GetQueueGroup(Overlay));
+
+	const auto queued = GetQueuedRenderables(queue);
+	REQUIRE(queued.size() == 4);
+	CHECK(queued[0].second == &sky);
+	CHECK(queued[1].second == &main);
+	CHECK(queued[2].second == &transparent);
+	CHECK(queued[3].second == &overlay);
+}
+
+TEST_CASE("Priority groups are iterated in ascending priority order", "[render_queue]")
+{
+	RenderQueue queue;
+	TestRenderable late, early, normal;
+
+	queue.AddRenderable(late, Main, 200);
+	queue.AddRenderable(early, Main, 0);
+	queue.AddRenderable(normal, Main);
+
+	const auto queued = GetQueuedRenderables(queue);
+	REQUIRE(queued.size() == 3);
+	CHECK(queued[0].second == &early);
+	CHECK(queued[1].second == &normal);
+	CHECK(queued[2].second == &late);
+}
+
+TEST_CASE("Sorting by material groups renderables and keeps renderables without material last", "[render_queue]")
+{
+	const MaterialPtr first = std::make_shared<Material>("First");
+	const MaterialPtr second = std::make_shared<Material>("Second");
+
+	TestRenderable noMaterial, a1(first), b1(second), a2(first), b2(second), a3(first), b3(second), a4(first);
+
+	RenderQueue queue;
+	for (TestRenderable* renderable : { &noMaterial, &a1, &b1, &a2, &b2, &a3, &b3, &a4 })
+	{
+		queue.AddRenderable(*renderable);
+	}
+
+	queue.SortByMaterial(1);
+
+	const auto queued = GetQueuedRenderables(queue);
+	REQUIRE(queued.size() == 8);
+
+	// Same material is contiguous and keeps its queue order, renderables without material come last
+	const bool firstIsLower = first.get() < second.get();
+	const std::vector<Renderable*> firstGroup = { &a1, &a2, &a3, &a4 };
+	const std::vector<Renderable*> secondGroup = { &b1, &b2, &b3 };
+
+	std::vector<Renderable*> expected = firstIsLower ? firstGroup : secondGroup;
+	const auto& tail = firstIsLower ? secondGroup : firstGroup;
+	expected.insert(expected.end(), tail.begin(), tail.end());
+	expected.push_back(&noMaterial);
+
+	for (size_t i = 0; i < expected.size(); ++i)
+	{
+		CHECK(queued[i].second == expected[i]);
+	}
+}
+
+TEST_CASE("Combining render queues appends renderables by group and priority", "[render_queue]")
+{
+	RenderQueue queue, other;
+	TestRenderable main1, main2, sky, late;
+
+	queue.AddRenderable(main1, Main);
+	queue.AddRenderable(late, Main, 500);
+	other.AddRenderable(main2, Main);
+	other.AddRenderable(sky, SkiesEarly);
+
+	size_t signalled = 0;
+	queue.renderableQueued.connect([&signalled](Renderable&, uint8, uint16, RenderQueue&) { ++signalled; return true; });
+
+	queue.Combine(other);
+
+	// Merged renderables have already been announced by the queue they were added to
+	CHECK(signalled == 0);
+
+	const auto queued = GetQueuedRenderables(queue);
+	REQUIRE(queued.size() == 4);
+	CHECK(queued[0] == std::make_pair(static_cast<uint32>(SkiesEarly), static_cast<Renderable*>(&sky)));
+	CHECK(queued[1].second == &main1);
+	CHECK(queued[2].second == &main2);
+	CHECK(queued[3].second == &late);
+
+	// The other queue is left untouched
+	CHECK(GetQueuedRenderables(other).size() == 2);
+}
@@ -0,0 +1,220 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "frame_ui/geometry_buffer.h"
+#include "frame_ui/ui_batcher.h"
+#include "graphics/graphics_device.h"
+
+#include <memory>
+#include <vector>
+
+using namespace mmo;
+
+namespace
+{
+	/// Appends a quad to the geometry buffer using the given texture.
+	void AppendQuad(GeometryBuffer& buffer, const TexturePtr& texture, const float x, const float y)
+	{
+		const GeometryBuffer::Vertex vertices[6]{
+			{ { x,			y,			0.0f }, 0xffffffff, { 0.0f, 0.0f } },
+			{ { x,			y + 16.0f,	0.0f }, 0xffffffff, { 0.0f, 1.0f } },
+			{ { x + 16.0f,	y + 16.0f,	0.0f }, 0xffffffff, { 1.0f, 1.0f } },
+			{ { x + 16.0f,	y + 16.0f,	0.0f }, 0xffffffff, { 1.0f, 1.0f } },
+			{ { x + 16.0f,	y,			0.0f }, 0xffffffff, { 1.0f, 0.0f } },
+			{ { x,			y,			0.0f }, 0xffffffff, { 0.0f, 0.0f } }
+		};
+
+		buffer.SetActiveTexture(texture);
+		buffer.AppendGeometry(vertices, 6);
+	}
+
+	/// Renders the buffers in order like the frame tree would and returns the number of draw calls reported by the
+	/// graphics device.
+	uint64 RenderFrame(UiBatcher& batcher, const std::vector<std::unique_ptr<GeometryBuffer>>& buffers)
+	{
+		auto& gx = GraphicsDevice::Get();
+		gx.Reset();
+
+		batcher.Begin();
+		for (const auto& buffer : buffers)
+		{
+			batcher.Queue(*buffer);
+		}
+		batcher.End();
+
+		gx.Reset();
+		return gx.GetBatchCount();
+	}
+}
+
+TEST_CASE("Consecutive geometry sharing a texture and clip rect is drawn at once", "[ui_batching]")
+{
+	auto& gx = GraphicsDevice::Get();
+	const TexturePtr atlas = gx.CreateTexture(256, 256);
+	const TexturePtr other = gx.CreateTexture(256, 256);
+
+	std::vector<std::unique_ptr<GeometryBuffer>> buffers;
+	for (int i = 0; i < 10; ++i)
+	{
+		buffers.push_back(std::make_unique<GeometryBuffer>());
+		AppendQuad(*buffers.back(), atlas, i * 16.0f, 0.0f);
+	}
+
+	UiBatcher batcher;
+	CHECK(RenderFrame(batcher, buffers) == 1);
+	CHECK(batcher.GetFrameStats().queuedBatches == 10);
+	CHECK(batcher.GetFrameStats().drawCalls == 1);
+	CHECK(batcher.GetFrameStats().uploadedVertices == 60);
+
+	// A different texture in between splits the geometry
+	AppendQuad(*buffers[4], other, 0.0f, 32.0f);
+	CHECK(RenderFrame(batcher, buffers) == 3);
+
+	// So does a clip rect, which is only applied for the geometry queued after it
+	gx.Reset();
+	batcher.Begin();
+	batcher.Queue(*buffers[0]);
+	batcher.SetClipRect(Rect(0.0f, 0.0f, 64.0f, 64.0f));
+	batcher.Queue(*buffers[1]);
+	batcher.Queue(*buffers[2]);
+	batcher.ResetClipRect();
+	batcher.Queue(*buffers[3]);
+	batcher.End();
+	CHECK(batcher.GetFrameStats().drawCalls == 3);
+}
+
+TEST_CASE("Unchanged batches are not uploaded again", "[ui_batching]")
+{
+	auto& gx = GraphicsDevice::Get();
+	const TexturePtr atlas = gx.CreateTexture(256, 256);
+	const TexturePtr other = gx.CreateTexture(256, 256);
+
+	std::vector<std::unique_ptr<GeometryBuffer>> buffers;
+	for (int i = 0; i < 6; ++i)
+	{
+		buffers.push_back(std::make_unique<GeometryBuffer>());
+		AppendQuad(*buffers.back(), i < 3 ? atlas : other, i * 16.0f, 0.0f);
+	}
+
+	UiBatcher batcher;
+	RenderFrame(batcher, buffers);
+	CHECK(batcher.GetFrameStats().drawCalls == 2);
+	CHECK(batcher.GetFrameStats().uploadedBatches == 2);
+
+	RenderFrame(batcher, buffers);
+	CHECK(batcher.GetFrameStats().drawCalls == 2);
+	CHECK(batcher.GetFrameStats().uploadedBatches == 0);
+	CHECK(batcher.GetFrameStats().uploadedVertices == 0);
+
+	// Rebuilding the geometry of a single frame only uploads the batch it belongs to
+	buffers[4]->Reset();
+	AppendQuad(*buffers[4], other, 100.0f, 100.0f);
+	RenderFrame(batcher, buffers);
+	CHECK(batcher.GetFrameStats().uploadedBatches == 1);
+	CHECK(batcher.GetFrameStats().uploadedVertices == 18);
+
+	// Replacing a buffer with another one with the same contents still uploads, as the vertices may differ
+	buffers[0] = std::make_unique<GeometryBuffer>();
+	AppendQuad(*buffers[0], atlas, 0.0f, 0.0f);
+	RenderFrame(batcher, buffers);
+	CHECK(batcher.GetFrameStats().uploadedBatches == 1);
+}
+
+TEST_CASE("Flushing the batcher keeps the drawing order intact", "[ui_batching]")
+{
+	auto& gx = GraphicsDevice::Get();
+	const TexturePtr atlas = gx.CreateTexture(256, 256);
+
+	GeometryBuffer first, second;
+	AppendQuad(first, atlas, 0.0f, 0.0f);
+	AppendQuad(second, atlas, 16.0f, 0.0f);
+
+	UiBatcher batcher;
+	gx.Reset();
+	batcher.Begin();
+	batcher.Queue(first);
+	batcher.Flush();
+
+	// Geometry queued after a flush is never merged into batches which have already been drawn
+	batcher.Queue(second);
+	batcher.End();
+
+	CHECK(batcher.GetFrameStats().drawCalls == 2);
+	gx.Reset();
+	CHECK(gx.GetBatchCount() == 2);
+}
+
+TEST_CASE("Overlay geometry is drawn in the frame of the frame tree", "[ui_batching]")
+{
+	auto& gx = GraphicsDevice::Get();
+	const TexturePtr atlas = gx.CreateTexture(256, 256);
+
+	GeometryBuffer tree, overlay;
+	AppendQuad(tree, atlas, 0.0f, 0.0f);
+	AppendQuad(overlay, atlas, 16.0f, 0.0f);
+
+	// Like FrameManager::Draw, which renders frames outside of the frame tree (such as world text) after the top
+	// frame but before the batcher frame ends
+	UiBatcher batcher;
+	CHECK_FALSE(batcher.IsActive());
+
+	gx.Reset();
+	batcher.Begin();
+	CHECK(batcher.IsActive());
+	batcher.Queue(tree);
+	batcher.Queue(overlay);
+	batcher.End();
+	CHECK_FALSE(batcher.IsActive());
+
+	CHECK(batcher.GetFrameStats().queuedBatches == 2);
+	CHECK(batcher.GetFrameStats().drawCalls == 1);
+	CHECK(batcher.GetFrameStats().uploadedVertices == 12);
+	gx.Reset();
+	CHECK(gx.GetBatchCount() == 1);
+}
+
+TEST_CASE("UI batching benchmark", "[ui_batching][!benchmark]")
+{
+	constexpr int FrameCount = 500;
+
+	auto& gx = GraphicsDevice::Get();
+	const TexturePtr atlas = gx.CreateTexture(1024, 1024);
+	const TexturePtr font = gx.CreateTexture(1024, 1024);
+
+	// Lines of text like in a chat window, with a background from the atlas every now and then
+	std::vector<std::unique_ptr<GeometryBuffer>> buffers;
+	for (int i = 0; i < FrameCount; ++i)
+	{
+		auto buffer = std::make_unique<GeometryBuffer>();
+		if (i % 50 == 0)
+		{
+			AppendQuad(*buffer, atlas, 0.0f, i * 16.0f);
+		}
+		for (int glyph = 0; glyph < 20; ++glyph)
+		{
+			AppendQuad(*buffer, font, glyph * 8.0f, i * 16.0f);
+		}
+		buffers.push_back(std::move(buffer));
+	}
+
+	uint64 drawCalls = 0;
+	BENCHMARK("500 frames, drawn one by one")
+	{
+		gx.Reset();
+		for (const auto& buffer : buffers)
+		{
+			buffer->Draw();
+		}
+		gx.Reset();
+		drawCalls = gx.GetBatchCount();
+	};
+	WARN("Draw calls per frame without batching: " << drawCalls);
+
+	UiBatcher batcher;
+	BENCHMARK("500 frames, batched")
+	{
+		drawCalls = RenderFrame(batcher, buffers);
+	};
+	WARN("Draw calls per frame with batching: " << drawCalls << ", cpu time: " << batcher.GetFrameStats().cpuTimeMicroseconds << " us");
+}
@@ -4,7 +4,6 @@
 
 #include "auth_protocol.h"
 #include "network/connection.h"
-#include "network/send_sink.h"
 
 namespace mmo
 {
@@ -12,6 +11,5 @@ namespace mmo
 	{
 		typedef mmo::Connection<Protocol> Connection;
 		typedef mmo::IConnectionListener<Protocol> IConnectionListener;
-		typedef mmo::SendSink<Protocol> SendSink;
 	}
 }
@@ -182,7 +182,8 @@ namespace mmo
 
 				PlayerGroupUpdate,
 
-				/// Batch save inventory items in single transaction.
+				/// Batch save inventory items in single transaction. Items replace the items in the same slots, and if
+				/// the replace flag is set, all other items of the character are removed.
 				SaveInventoryItems,
 
 				/// Delete specific inventory items by slot.
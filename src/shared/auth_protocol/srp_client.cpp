@@ -0,0 +1,108 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "srp_client.h"
+
+#include "base/constants.h"
+
+#include <algorithm>
+
+namespace mmo
+{
+	SrpClient::SrpClient(std::string accountName, std::string password)
+		: m_accountName(std::move(accountName))
+	{
+		std::transform(m_accountName.begin(), m_accountName.end(), m_accountName.begin(), ::toupper);
+		std::transform(password.begin(), password.end(), password.begin(), ::toupper);
+
+		const std::string authString = m_accountName + ":" + password;
+		m_authHash = sha1(authString.c_str(), authString.size());
+	}
+
+	SrpProof SrpClient::CalculateProof(const BigNumber& B, const BigNumber& s)
+	{
+		// Randomise the client private ephemeral (19 bytes = 152 bits) and compute A = g^a mod N.
+		BigNumber a;
+		a.setRand(19 * 8);
+		const BigNumber A = constants::srp::g.modExp(a, constants::srp::N);
+
+		// x = H(s | H(ACCOUNT:PASSWORD))
+		HashGeneratorSha1 gen;
+		gen.update(reinterpret_cast<const char*>(s.asByteArray().data()), s.getNumBytes());
+		gen.update(reinterpret_cast<const char*>(m_authHash.data()), m_authHash.size());
+		SHA1Hash hash = gen.finalize();
+		BigNumber x{ hash.data(), hash.size() };
+
+		// u = H(A | B)
+		hash = Sha1_BigNumbers({ A, B });
+		BigNumber u{ hash.data(), hash.size() };
+
+		// S = (B - 3*g^x) ^ (a + u*x)  mod N
+		// 3*g^x is reduced mod N first. B and the reduced value are both below N, so B + N - 3*g^x stays positive.
+		// BigNumber operators are not const-qualified, so work on local copies.
+		BigNumber N = constants::srp::N;
+		BigNumber base = B;
+		BigNumber k3gx = (constants::srp::g.modExp(x, N) * BigNumber(3)) % N;
+		base = (base + N - k3gx) % N;
+		const BigNumber S = base.modExp(a + u * x, N);
+
+		// Interleave-hash S into the 40-byte session key vK, exactly like SrpServer does.
+		const std::vector<uint8> t = S.asByteArray(32);
+
+		std::array<uint8, 16> t1;
+		std::array<uint8, 40> vK;
+		for (size_t half = 0; half < 2; ++half)
+		{
+			for (size_t i = 0; i < t1.size(); ++i)
+			{
+				t1[i] = t[i * 2 + half];
+			}
+
+			hash = sha1(reinterpret_cast<const char*>(t1.data()), t1.size());
+			for (size_t i = 0; i < 20; ++i)
+			{
+				vK[i * 2 + half] = hash[i];
+			}
+		}
+
+		m_sessionKey.setBinary(vK.data(), vK.size());
+
+		// t3 = H(N) XOR H(g)
+		SHA1Hash h = Sha1_BigNumbers({ constants::srp::N });
+		hash = Sha1_BigNumbers({ constants::srp::g });
+		for (size_t i = 0; i < h.size(); ++i)
+		{
+			h[i] ^= hash[i];
+		}
+		const BigNumber t3{ h.data(), h.size() };
+
+		// M1 = H(t3 | H(account) | s | A | B | K)
+		// K is hashed as the full, fixed-size 40-byte key, see SrpServer::VerifyProof for the reasoning.
+		HashGeneratorSha1 m1gen;
+		Sha1_Add_BigNumbers(m1gen, { t3 });
+		const auto t4 = sha1(m_accountName.c_str(), m_accountName.size());
+		m1gen.update(reinterpret_cast<const char*>(t4.data()), t4.size());
+		Sha1_Add_BigNumbers(m1gen, { s, A, B });
+		m1gen.update(reinterpret_cast<const char*>(vK.data()), vK.size());
+		const SHA1Hash m1 = m1gen.finalize();
+
+		// M2 = H(A | M1 | K)
+		HashGeneratorSha1 m2gen;
+		Sha1_Add_BigNumbers(m2gen, { A });
+		m2gen.update(reinterpret_cast<const char*>(m1.data()), m1.size());
+		m2gen.update(reinterpret_cast<const char*>(vK.data()), vK.size());
+		m_m2 = m2gen.finalize();
+
+		// A is always sent as a fixed 32-byte value so that leading zero bytes are not stripped.
+		SrpProof proof;
+		const std::vector<uint8> aBytes = A.asByteArray(32);
+		std::copy(aBytes.begin(), aBytes.end(), proof.A.begin());
+		std::copy(m1.begin(), m1.end(), proof.m1.begin());
+		return proof;
+	}
+
+	bool SrpClient::VerifyServerProof(const SHA1Hash& m2) const
+	{
+		return std::equal(m_m2.begin(), m_m2.end(), m2.begin());
+	}
+
+} // namespace mmo
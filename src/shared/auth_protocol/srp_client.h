@@ -0,0 +1,54 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/big_number.h"
+#include "base/sha1.h"
+
+#include <array>
+#include <string>
+
+namespace mmo
+{
+	/// Holds the client-side SRP6-A proof values sent to the server in the LogonProof packet.
+	struct SrpProof
+	{
+		std::array<uint8, 32> A;
+		std::array<uint8, 20> m1;
+	};
+
+	/// Standalone SRP6-A client state machine, the counterpart of SrpServer (pure value type, no async/network deps).
+	/// Usage:
+	///   1. Construct with the account name and password.
+	///   2. Call CalculateProof() with B and s received in the LogonChallenge answer and send {A, M1} to the server.
+	///   3. Call VerifyServerProof() with the M2 received in the LogonProof answer.
+	///   4. Use GetSessionKey() to authenticate at a realm.
+	class SrpClient
+	{
+	public:
+		/// Construct the client state. Account name and password are converted to uppercase letters.
+		SrpClient(std::string accountName, std::string password);
+
+		/// Generate the client ephemeral and calculate the session key and proof hashes.
+		/// @param B  Server public ephemeral received in the challenge.
+		/// @param s  Account salt received in the challenge.
+		/// @return A and M1 to be sent to the server.
+		SrpProof CalculateProof(const BigNumber& B, const BigNumber& s);
+
+		/// Compares the server proof hash against the expected M2 value. Only valid after CalculateProof().
+		[[nodiscard]] bool VerifyServerProof(const SHA1Hash& m2) const;
+
+		/// Gets the session key. Only valid after CalculateProof().
+		[[nodiscard]] const BigNumber& GetSessionKey() const { return m_sessionKey; }
+
+		/// Gets the uppercase account name.
+		[[nodiscard]] const std::string& GetAccountName() const { return m_accountName; }
+
+	private:
+		std::string m_accountName;  ///< Uppercase account name
+		SHA1Hash m_authHash;        ///< H(ACCOUNT:PASSWORD)
+		BigNumber m_sessionKey;     ///< Interleaved 40-byte session key K
+		SHA1Hash m_m2;              ///< Expected server proof hash
+	};
+
+} // namespace mmo
@@ -0,0 +1,53 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#pragma once
+
+#include <memory>
+
+namespace mmo
+{
+	/// Holds an immutable value which can be shared between many owners, for example data derived from a template
+	/// which all instances of the template start with. The value is copied the first time an owner modifies it, so
+	/// owners never see each other's changes. An empty holder doesn't allocate anything.
+	/// Sharing a value between threads is safe, but a single holder must not be used by multiple threads.
+	template<class T>
+	class CopyOnWrite final
+	{
+	public:
+		CopyOnWrite() = default;
+
+		/// Gets the current value for reading.
+		[[nodiscard]] const T& Get() const
+		{
+			static const T s_empty{};
+			return m_value ? *m_value : s_empty;
+		}
+
+		/// Gets the value for modification, copying it first if it is shared with another owner.
+		[[nodiscard]] T& Edit()
+		{
+			if (!m_value)
+			{
+				m_value = std::make_shared<T>();
+			}
+			else if (m_value.use_count() > 1)
+			{
+				m_value = std::make_shared<T>(*m_value);
+			}
+
+			return *m_value;
+		}
+
+		/// Shares the value of another holder instead of the current value.
+		void Share(const CopyOnWrite& other) { m_value = other.m_value; }
+
+		/// Drops the current value without copying it.
+		void Reset() { m_value.reset(); }
+
+		/// Determines whether the value is shared with another owner.
+		[[nodiscard]] bool IsShared() const { return m_value && m_value.use_count() > 1; }
+
+	private:
+		std::shared_ptr<T> m_value;
+	};
+}
@@ -3,6 +3,7 @@
 #include "countdown.h"
 #include "timer_queue.h"
 #include "macros.h"
+#include "small_object_pool.h"
 
 
 namespace mmo
@@ -83,6 +84,12 @@ namespace mmo
 	{
 	}
 
+	Countdown::Countdown(TimerQueue& timers, SmallObjectPool* pool)
+		: m_running(false)
+		, m_impl(MakePooled<Impl>(pool, timers, *this))
+	{
+	}
+
 	Countdown::~Countdown()
 	{
 		m_impl->Kill();
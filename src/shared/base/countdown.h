@@ -11,6 +11,7 @@
 namespace mmo
 {
 	class TimerQueue;
+	class SmallObjectPool;
 
 
 	class Countdown
@@ -22,6 +23,11 @@ namespace mmo
 
 	public:
 		explicit Countdown(TimerQueue& timers);
+
+		/// Creates a countdown whose shared timer state is allocated from the given pool. Falls back to the heap
+		/// if no pool is provided.
+		Countdown(TimerQueue& timers, SmallObjectPool* pool);
+
 		~Countdown();
 
 	public:
@@ -0,0 +1,201 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "typedefs.h"
+#include "macros.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace mmo
+{
+	/// Maps non-zero 64 bit guids to 32 bit indices into a dense array, using open addressing with linear probing.
+	/// All entries are stored in a single flat array, so lookups touch one or two cache lines instead of walking a
+	/// tree. Erased entries are removed by shifting following entries back, so no tombstones accumulate.
+	class GuidIndex final
+	{
+	public:
+		/// Returned by Find if a guid is not indexed.
+		static constexpr uint32 NotFound = std::numeric_limits<uint32>::max();
+
+	public:
+		/// Initializes an empty index.
+		/// @param capacity Number of guids which can be indexed without growing.
+		explicit GuidIndex(const size_t capacity = 0)
+		{
+			Reserve(capacity);
+		}
+
+	public:
+		/// Gets the index of a guid, or NotFound if the guid is not indexed.
+		[[nodiscard]] uint32 Find(const uint64 guid) const
+		{
+			if (guid == 0 || m_size == 0)
+			{
+				return NotFound;
+			}
+
+			for (size_t bucket = GetBucket(guid); ; bucket = (bucket + 1) & m_mask)
+			{
+				const Entry& entry = m_entries[bucket];
+				if (entry.guid == guid)
+				{
+					return entry.index;
+				}
+
+				if (entry.guid == 0)
+				{
+					return NotFound;
+				}
+			}
+		}
+
+		/// Checks whether a guid is indexed.
+		[[nodiscard]] bool Contains(const uint64 guid) const
+		{
+			return Find(guid) != NotFound;
+		}
+
+		/// Sets the index of a guid, adding the guid if it is not indexed yet.
+		void Set(const uint64 guid, const uint32 index)
+		{
+			ASSERT(guid != 0);
+			ASSERT(index != NotFound);
+
+			// Keep the load factor at or below one half, so that probe sequences stay short
+			if ((m_size + 1) * 2 > m_entries.size())
+			{
+				Rehash(m_entries.empty() ? 16 : m_entries.size() * 2);
+			}
+
+			for (size_t bucket = GetBucket(guid); ; bucket = (bucket + 1) & m_mask)
+			{
+				Entry& entry = m_entries[bucket];
+				if (entry.guid == guid)
+				{
+					entry.index = index;
+					return;
+				}
+
+				if (entry.guid == 0)
+				{
+					entry.guid = guid;
+					entry.index = index;
+					++m_size;
+					return;
+				}
+			}
+		}
+
+		/// Removes a guid from the index.
+		/// @returns false if the guid was not indexed.
+		bool Erase(const uint64 guid)
+		{
+			if (guid == 0 || m_size == 0)
+			{
+				return false;
+			}
+
+			size_t bucket = GetBucket(guid);
+			while (m_entries[bucket].guid != guid)
+			{
+				if (m_entries[bucket].guid == 0)
+				{
+					return false;
+				}
+
+				bucket = (bucket + 1) & m_mask;
+			}
+
+			// Shift following entries of the probe sequence back into the gap, unless they would end up in front of
+			// their own home bucket
+			size_t gap = bucket;
+			for (size_t next = (gap + 1) & m_mask; m_entries[next].guid != 0; next = (next + 1) & m_mask)
+			{
+				const size_t home = GetBucket(m_entries[next].guid);
+				if (((next - home) & m_mask) >= ((next - gap) & m_mask))
+				{
+					m_entries[gap] = m_entries[next];
+					gap = next;
+				}
+			}
+
+			m_entries[gap] = Entry();
+			--m_size;
+			return true;
+		}
+
+		/// Removes all guids, keeping the allocated buckets.
+		void Clear()
+		{
+			std::fill(m_entries.begin(), m_entries.end(), Entry());
+			m_size = 0;
+		}
+
+		/// Makes sure that the given number of guids can be indexed without growing.
+		void Reserve(const size_t capacity)
+		{
+			size_t bucketCount = 16;
+			while (bucketCount < capacity * 2)
+			{
+				bucketCount *= 2;
+			}
+
+			if (bucketCount > m_entries.size())
+			{
+				Rehash(bucketCount);
+			}
+		}
+
+		/// Gets the number of indexed guids.
+		[[nodiscard]] size_t Size() const { return m_size; }
+
+		[[nodiscard]] bool IsEmpty() const { return m_size == 0; }
+
+	private:
+		struct Entry
+		{
+			uint64 guid = 0;
+			uint32 index = 0;
+		};
+
+		[[nodiscard]] size_t GetBucket(const uint64 guid) const
+		{
+			// Fibonacci hashing: guids differ mostly in their low bits, which the multiplication spreads over the
+			// high bits that select the bucket
+			return static_cast<size_t>((guid * 0x9E3779B97F4A7C15ull) >> m_shift);
+		}
+
+		void Rehash(const size_t bucketCount)
+		{
+			ASSERT((bucketCount & (bucketCount - 1)) == 0);
+
+			std::vector<Entry> entries(bucketCount);
+			entries.swap(m_entries);
+
+			m_mask = bucketCount - 1;
+			m_shift = 64;
+			for (size_t count = bucketCount; count > 1; count >>= 1)
+			{
+				--m_shift;
+			}
+
+			m_size = 0;
+			for (const Entry& entry : entries)
+			{
+				if (entry.guid != 0)
+				{
+					Set(entry.guid, entry.index);
+				}
+			}
+		}
+
+	private:
+		std::vector<Entry> m_entries;
+		size_t m_size = 0;
+		size_t m_mask = 0;
+		uint32 m_shift = 64;
+	};
+}
@@ -0,0 +1,115 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "job_system.h"
+
+#include <algorithm>
+
+namespace mmo
+{
+	JobSystem::JobSystem(const size_t workerCount)
+	{
+		m_workers.reserve(workerCount);
+		for (size_t i = 0; i < workerCount; ++i)
+		{
+			m_workers.emplace_back(&JobSystem::WorkerThread, this);
+		}
+	}
+
+	JobSystem::~JobSystem()
+	{
+		{
+			std::scoped_lock lock{ m_mutex };
+			m_stop = true;
+		}
+
+		m_wakeUp.notify_all();
+
+		for (auto& worker : m_workers)
+		{
+			worker.join();
+		}
+	}
+
+	size_t JobSystem::GetDefaultWorkerCount()
+	{
+		const size_t hardwareThreads = std::thread::hardware_concurrency();
+		return std::max<size_t>(hardwareThreads, 2) - 1;
+	}
+
+	void JobSystem::ParallelFor(const size_t count, const std::function<void(size_t)>& job)
+	{
+		// Not worth waking up the workers
+		if (m_workers.empty() || count <= 1)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				job(i);
+			}
+
+			return;
+		}
+
+		std::scoped_lock dispatchLock{ m_dispatchMutex };
+
+		uint64 generation;
+		{
+			std::scoped_lock lock{ m_mutex };
+			generation = ++m_generation;
+			m_job = &job;
+			m_jobCount = count;
+			m_nextJob = 0;
+			m_pending = count;
+		}
+
+		m_wakeUp.notify_all();
+
+		// Work on the jobs as well instead of just waiting for the workers
+		RunJobs(generation);
+
+		std::unique_lock lock{ m_mutex };
+		m_done.wait(lock, [this]() { return m_pending == 0; });
+		m_job = nullptr;
+	}
+
+	void JobSystem::WorkerThread()
+	{
+		uint64 lastGeneration = 0;
+
+		for (;;)
+		{
+			{
+				std::unique_lock lock{ m_mutex };
+				m_wakeUp.wait(lock, [this, lastGeneration]() { return m_stop || m_generation != lastGeneration; });
+
+				if (m_stop)
+				{
+					return;
+				}
+
+				lastGeneration = m_generation;
+			}
+
+			RunJobs(lastGeneration);
+		}
+	}
+
+	void JobSystem::RunJobs(const uint64 generation)
+	{
+		std::unique_lock lock{ m_mutex };
+
+		while (m_generation == generation && m_nextJob < m_jobCount)
+		{
+			const size_t index = m_nextJob++;
+			const auto& job = *m_job;
+
+			lock.unlock();
+			job(index);
+			lock.lock();
+
+			if (--m_pending == 0)
+			{
+				m_done.notify_all();
+			}
+		}
+	}
+}
@@ -0,0 +1,71 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "typedefs.h"
+#include "non_copyable.h"
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mmo
+{
+	/// Small pool of worker threads which executes independent jobs of a frame in parallel. The jobs of one dispatch
+	///	are handed out by index, so each job can write its results into its own slot without any locking, and the caller
+	///	can merge the slots in a deterministic order after the dispatch returned.
+	///
+	///	Only one dispatch is executed at a time. Jobs must not throw and must not dispatch jobs themselves.
+	class JobSystem final : public NonCopyable
+	{
+	public:
+		/// Creates a new job system.
+		///	@param workerCount Number of worker threads. The thread which dispatches jobs works on them as well, so
+		///	                   zero workers makes the job system execute all jobs on the calling thread.
+		explicit JobSystem(size_t workerCount = GetDefaultWorkerCount());
+
+		/// Stops and joins all worker threads.
+		~JobSystem() override;
+
+	public:
+		/// Gets the number of workers which keeps one hardware thread free for the calling thread.
+		[[nodiscard]] static size_t GetDefaultWorkerCount();
+
+		/// Gets the number of worker threads, not counting the calling thread.
+		[[nodiscard]] size_t GetWorkerCount() const { return m_workers.size(); }
+
+		/// Executes job(0) to job(count - 1) on the worker threads and the calling thread and returns once all of
+		///	them have been executed. The order in which the jobs are executed is undefined.
+		///	@param count Number of jobs.
+		///	@param job Function which executes the job with the given index.
+		void ParallelFor(size_t count, const std::function<void(size_t)>& job);
+
+	private:
+		void WorkerThread();
+
+		/// Executes jobs of the given dispatch until there are none left.
+		void RunJobs(uint64 generation);
+
+	private:
+		std::vector<std::thread> m_workers;
+
+		/// Serializes dispatches from different threads.
+		std::mutex m_dispatchMutex;
+
+		/// Protects the state of the current dispatch. Jobs are expected to be coarse, so claiming them under a lock
+		///	costs nothing compared to executing them.
+		std::mutex m_mutex;
+		std::condition_variable m_wakeUp;
+		std::condition_variable m_done;
+		bool m_stop { false };
+
+		/// Incremented on every dispatch, so that workers which are late for a dispatch don't claim jobs of the next.
+		uint64 m_generation { 0 };
+		const std::function<void(size_t)>* m_job { nullptr };
+		size_t m_jobCount { 0 };
+		size_t m_nextJob { 0 };
+		size_t m_pending { 0 };
+	};
+}
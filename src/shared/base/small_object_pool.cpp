@@ -0,0 +1,113 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "small_object_pool.h"
+#include "macros.h"
+
+#include <algorithm>
+
+namespace mmo
+{
+	SmallObjectPool::SmallObjectPool(const size_t chunkSize)
+		: m_chunkSize(std::max(chunkSize, MaxBlockSize))
+	{
+	}
+
+	SmallObjectPool::~SmallObjectPool()
+	{
+		// Blocks still in use at this point would dangle. Use Create() for pools whose blocks may outlive the owner.
+		ASSERT(m_stats.liveBlocks == 0);
+	}
+
+	SmallObjectPool::Ptr SmallObjectPool::Create(const size_t chunkSize)
+	{
+		return Ptr(new SmallObjectPool(chunkSize));
+	}
+
+	void* SmallObjectPool::Allocate(const size_t size)
+	{
+		if (size == 0 || size > MaxBlockSize)
+		{
+			++m_stats.heapAllocations;
+			return ::operator new(size);
+		}
+
+		const size_t sizeClass = GetSizeClass(size);
+		if (!m_freeLists[sizeClass])
+		{
+			AllocateChunk(sizeClass);
+		}
+
+		FreeBlock* block = m_freeLists[sizeClass];
+		m_freeLists[sizeClass] = block->next;
+
+		++m_stats.allocations;
+		++m_stats.liveBlocks;
+		return block;
+	}
+
+	void SmallObjectPool::Deallocate(void* block, const size_t size) noexcept
+	{
+		if (!block)
+		{
+			return;
+		}
+
+		if (size == 0 || size > MaxBlockSize)
+		{
+			::operator delete(block);
+			return;
+		}
+
+		const size_t sizeClass = GetSizeClass(size);
+		auto* freeBlock = static_cast<FreeBlock*>(block);
+		freeBlock->next = m_freeLists[sizeClass];
+		m_freeLists[sizeClass] = freeBlock;
+
+		ASSERT(m_stats.liveBlocks > 0);
+		--m_stats.liveBlocks;
+
+		// The owner is already gone and this was the last block in use
+		if (m_released && m_stats.liveBlocks == 0)
+		{
+			delete this;
+		}
+	}
+
+	SmallObjectPool::Stats SmallObjectPool::GetStats() const
+	{
+		return m_stats;
+	}
+
+	void SmallObjectPool::AllocateChunk(const size_t sizeClass)
+	{
+		const size_t blockSize = (sizeClass + 1) * Granularity;
+		const size_t blockCount = m_chunkSize / blockSize;
+
+		// operator new[] returns memory aligned to at least __STDCPP_DEFAULT_NEW_ALIGNMENT__, which is 16 on all
+		// supported platforms, and every block size is a multiple of Granularity
+		auto& chunk = m_chunks.emplace_back(new std::byte[blockCount * blockSize]);
+		++m_stats.chunkAllocations;
+
+		// Thread the new blocks onto the free list in address order
+		FreeBlock* head = m_freeLists[sizeClass];
+		for (size_t i = blockCount; i > 0; --i)
+		{
+			auto* block = reinterpret_cast<FreeBlock*>(chunk.get() + (i - 1) * blockSize);
+			block->next = head;
+			head = block;
+		}
+
+		m_freeLists[sizeClass] = head;
+	}
+
+	void SmallObjectPool::Release()
+	{
+		ASSERT(!m_released);
+		m_released = true;
+
+		if (m_stats.liveBlocks == 0)
+		{
+			delete this;
+		}
+	}
+}
@@ -0,0 +1,171 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "typedefs.h"
+#include "non_copyable.h"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace mmo
+{
+	/// Pool for small, frequently allocated objects. Memory is carved from larger chunks and split into size classes.
+	/// Released blocks are put on a free list of their size class and handed out again on the next allocation of
+	/// that size, so that steady allocation patterns stop hitting the heap after warming up. Chunks are only returned
+	/// to the heap when the pool is destroyed.
+	///
+	/// Pools created with Create() outlive their owner: if blocks are still in use when the owner releases the pool,
+	/// the pool is destroyed together with the last returned block. This keeps objects safe which are still referenced
+	/// by pending timer callbacks after their world instance has been destroyed.
+	///
+	/// The pool is not thread safe. Like the rest of the world instance state, it must only be used from the thread
+	/// which runs the world instance.
+	class SmallObjectPool final : public NonCopyable
+	{
+	public:
+		/// Size classes are multiples of this value. Also the guaranteed alignment of pooled blocks.
+		static constexpr size_t Granularity = 16;
+
+		/// Largest block size served by the pool. Larger requests are forwarded to the heap.
+		static constexpr size_t MaxBlockSize = 1024;
+
+		/// Allocation statistics of a pool.
+		struct Stats
+		{
+			/// Total number of blocks handed out by the pool.
+			uint64 allocations = 0;
+
+			/// Number of chunks which had to be allocated from the heap.
+			uint64 chunkAllocations = 0;
+
+			/// Number of requests which were too large for the pool and were forwarded to the heap.
+			uint64 heapAllocations = 0;
+
+			/// Number of blocks which are currently in use.
+			size_t liveBlocks = 0;
+		};
+
+		/// Releases an owned pool instead of deleting it right away.
+		struct Releaser
+		{
+			void operator()(SmallObjectPool* pool) const { pool->Release(); }
+		};
+
+		typedef std::unique_ptr<SmallObjectPool, Releaser> Ptr;
+
+	public:
+		/// Creates a new, empty pool.
+		/// @param chunkSize Size in bytes of the chunks which are allocated when a size class runs out of blocks.
+		explicit SmallObjectPool(size_t chunkSize = 16 * 1024);
+
+		~SmallObjectPool();
+
+		/// Creates a new pool which stays alive until it has been released by its owner and all blocks are returned.
+		static Ptr Create(size_t chunkSize = 16 * 1024);
+
+	public:
+		/// Allocates a block of at least the given size, aligned to Granularity.
+		[[nodiscard]] void* Allocate(size_t size);
+
+		/// Returns a block to the pool. The size has to match the size which was passed to Allocate.
+		void Deallocate(void* block, size_t size) noexcept;
+
+		/// Gets a copy of the current allocation statistics.
+		[[nodiscard]] Stats GetStats() const;
+
+	private:
+		struct FreeBlock
+		{
+			FreeBlock* next;
+		};
+
+		static constexpr size_t SizeClassCount = MaxBlockSize / Granularity;
+
+		static size_t GetSizeClass(const size_t size) { return (size + Granularity - 1) / Granularity - 1; }
+
+		void AllocateChunk(size_t sizeClass);
+
+		/// Called by the owner of a pool created with Create(). Destroys the pool if no blocks are in use anymore,
+		/// otherwise the last call to Deallocate will.
+		void Release();
+
+	private:
+		size_t m_chunkSize;
+		bool m_released = false;
+		std::array<FreeBlock*, SizeClassCount> m_freeLists {};
+		std::vector<std::unique_ptr<std::byte[]>> m_chunks;
+		Stats m_stats;
+	};
+
+	/// Standard allocator which draws memory from a SmallObjectPool. Intended for std::allocate_shared, which also
+	/// places the control block into the pool.
+	template<class T>
+	class PoolAllocator
+	{
+		template<class U>
+		friend class PoolAllocator;
+
+	public:
+		typedef T value_type;
+
+	public:
+		explicit PoolAllocator(SmallObjectPool& pool) noexcept
+			: m_pool(&pool)
+		{
+		}
+
+		template<class U>
+		PoolAllocator(const PoolAllocator<U>& other) noexcept
+			: m_pool(other.m_pool)
+		{
+		}
+
+	public:
+		[[nodiscard]] T* allocate(const size_t count)
+		{
+			if (count != 1 || alignof(T) > SmallObjectPool::Granularity)
+			{
+				return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(alignof(T))));
+			}
+
+			return static_cast<T*>(m_pool->Allocate(sizeof(T)));
+		}
+
+		void deallocate(T* block, const size_t count) noexcept
+		{
+			if (count != 1 || alignof(T) > SmallObjectPool::Granularity)
+			{
+				::operator delete(block, std::align_val_t(alignof(T)));
+				return;
+			}
+
+			m_pool->Deallocate(block, sizeof(T));
+		}
+
+		template<class U>
+		bool operator==(const PoolAllocator<U>& other) const noexcept { return m_pool == other.m_pool; }
+
+		template<class U>
+		bool operator!=(const PoolAllocator<U>& other) const noexcept { return m_pool != other.m_pool; }
+
+	private:
+		SmallObjectPool* m_pool;
+	};
+
+	/// Creates a shared object whose memory (including the shared_ptr control block) is taken from the given pool.
+	/// Falls back to std::make_shared if no pool is provided.
+	template<class T, class... Args>
+	std::shared_ptr<T> MakePooled(SmallObjectPool* pool, Args&&... args)
+	{
+		if (!pool)
+		{
+			return std::make_shared<T>(std::forward<Args>(args)...);
+		}
+
+		return std::allocate_shared<T>(PoolAllocator<T>(*pool), std::forward<Args>(args)...);
+	}
+}
@@ -11,7 +11,7 @@
 
 namespace io
 {
-	class MemorySource : public ISource
+	class MemorySource final : public ISource
 	{
 	public:
 
@@ -0,0 +1,24 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace io
+{
+	namespace detail
+	{
+		/// Types which are serialized as their plain in-memory representation, so that contiguous arrays of them
+		/// can be read and written with a single call.
+		template <class T>
+		inline constexpr bool IsPlainSerializable =
+			(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) || std::is_same_v<T, std::byte>;
+
+		/// Iterators over contiguous memory of plain serializable elements.
+		template <class I>
+		inline constexpr bool IsPlainContiguousIterator =
+			std::contiguous_iterator<I> && IsPlainSerializable<std::iter_value_t<I>>;
+	}
+}
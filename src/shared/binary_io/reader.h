@@ -3,10 +3,15 @@
 #pragma once
 
 #include "source.h"
+#include "memory_source.h"
+#include "plain_serializable.h"
 #include <string>
 #include <cstddef>
 #include <cmath>
 #include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
 
 namespace io
 {
@@ -21,12 +26,14 @@ namespace io
 
 		Reader()
 			: m_source(nullptr)
+			, m_memorySource(nullptr)
 			, m_success(true)
 		{
 		}
 
 		explicit Reader(ISource &source)
 			: m_source(&source)
+			, m_memorySource(dynamic_cast<MemorySource *>(&source))
 			, m_success(true)
 		{
 		}
@@ -39,14 +46,33 @@ namespace io
 		void setSource(ISource *source)
 		{
 			m_source = source;
+			m_memorySource = dynamic_cast<MemorySource *>(source);
 			m_success = true;
 		}
 
 		void skip(std::size_t size)
 		{
+			if (m_memorySource)
+			{
+				m_memorySource->skip(size);
+				return;
+			}
+
 			m_source->skip(size);
 		}
 
+		/// Reads raw bytes from the source. Packet bodies and files loaded into memory are read from a
+		/// MemorySource, which is final, so these reads are not dispatched virtually and can be inlined.
+		std::size_t readRaw(char *dest, std::size_t size)
+		{
+			if (m_memorySource)
+			{
+				return m_memorySource->read(dest, size);
+			}
+
+			return m_source->read(dest, size);
+		}
+
 		template <class T>
 		void readPOD(T &pod)
 		{
@@ -56,7 +82,7 @@ namespace io
 			}
 
 			const size_t size = sizeof(pod);
-			const size_t read = m_source->read(
+			const size_t read = readRaw(
 			                        reinterpret_cast<char *>(&pod),
 			                        size);
 
@@ -71,7 +97,7 @@ namespace io
 			}
 
 			const size_t size = sizeof(pod);
-			const size_t read = m_source->read(
+			const size_t read = readRaw(
 				reinterpret_cast<char *>(&pod),
 				size);
 
@@ -89,7 +115,7 @@ namespace io
 			}
 
 			const size_t size = sizeof(pod);
-			const size_t read = m_source->read(
+			const size_t read = readRaw(
 				reinterpret_cast<char *>(&pod),
 				size);
 
@@ -99,6 +125,44 @@ namespace io
 				m_success = (size == read);
 		}
 
+		/// Reads a contiguous array of plain values with a single read call. Produces the same result as
+		/// reading the values one by one, including the rejection of non-finite floating point values.
+		template <class T>
+		void readPODRange(T *dest, std::size_t count)
+		{
+			if (!m_success || count == 0)
+			{
+				return;
+			}
+
+			const size_t size = sizeof(T) * count;
+			const size_t read = readRaw(
+				reinterpret_cast<char *>(dest),
+				size);
+
+			m_success = (size == read);
+
+			if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+			{
+				for (std::size_t i = 0; m_success && i < count; ++i)
+				{
+					m_success = std::isfinite(dest[i]);
+				}
+			}
+		}
+
+		/// Skips a number of bytes and fails if the source does not contain enough data.
+		void skipPOD(std::size_t size)
+		{
+			if (!m_success || size == 0)
+			{
+				return;
+			}
+
+			const size_t skipped = m_memorySource ? m_memorySource->skip(size) : m_source->skip(size);
+			m_success = (size == skipped);
+		}
+
 		operator bool () const
 		{
 			return m_success;
@@ -117,6 +181,7 @@ namespace io
 	private:
 
 		ISource *m_source;
+		MemorySource *m_memorySource;
 		bool m_success;
 	};
 
@@ -225,9 +290,16 @@ namespace io
 		template <class I>
 		Reader &operator >> (Reader &r, const ReadRange<I> &range)
 		{
-			for (I i = range.begin; i != range.end; ++i)
+			if constexpr (IsPlainContiguousIterator<I>)
+			{
+				r.readPODRange(std::to_address(range.begin), static_cast<std::size_t>(range.end - range.begin));
+			}
+			else
 			{
-				r >> *i;
+				for (I i = range.begin; i != range.end; ++i)
+				{
+					r >> *i;
+				}
 			}
 
 			return r;
@@ -325,7 +397,9 @@ namespace io
 
 	namespace detail
 	{
-		template <class L, class C, class ReadElement>
+		/// Reads a length prefixed container. E is the type of a serialized element, which differs from the
+		/// container's element type when the elements are converted.
+		template <class L, class E, class C, class ReadElement>
 		void readContainer(Reader &r, C &destination, L maxLength, const ReadElement &readElement)
 		{
 			typedef typename C::value_type Element;
@@ -338,16 +412,29 @@ namespace io
 				const size_t skipSize = length - readSize;
 
 				destination.resize(readSize);
-				for (size_t i = 0; i < readSize; ++i)
+				if constexpr (std::is_same_v<E, Element> && IsPlainContiguousIterator<typename C::iterator>)
 				{
-					readElement(destination[i]);
+					r.readPODRange(std::to_address(destination.begin()), readSize);
+				}
+				else
+				{
+					for (size_t i = 0; i < readSize; ++i)
+					{
+						readElement(destination[i]);
+					}
 				}
 
-				//TODO: optimize for primitives
-				Element dummy;
-				for (size_t i = 0; i < skipSize; ++i)
+				if constexpr (IsPlainSerializable<E>)
+				{
+					r.skipPOD(skipSize * sizeof(E));
+				}
+				else
 				{
-					r >> dummy;
+					E dummy;
+					for (size_t i = 0; i < skipSize; ++i)
+					{
+						r >> dummy;
+					}
 				}
 			}
 		}
@@ -372,7 +459,7 @@ namespace io
 		{
 			typedef typename C::value_type Element;
 
-			readContainer(r,
+			readContainer<L, Element>(r,
 			              surr.dest,
 			              surr.maxLength,
 			              [&r](Element & e)
@@ -402,7 +489,7 @@ namespace io
 		{
 			typedef typename C::value_type Element;
 
-			readContainer(r,
+			readContainer<L, E>(r,
 			              surr.dest,
 			              surr.maxLength,
 			              [&r](Element & e)
@@ -553,4 +640,62 @@ namespace io
 	{
 		return detail::ReadablePackedGuid(plain_guid);
 	}
+
+	namespace detail
+	{
+		template <class T>
+		struct ReadableVarUInt
+		{
+			T& value;
+
+			explicit ReadableVarUInt(T& value_)
+				: value(value_)
+			{
+			}
+		};
+
+		template <class T>
+		Reader &operator >> (Reader &r, const ReadableVarUInt<T> &surr)
+		{
+			std::uint64_t value = 0;
+			for (std::uint8_t shift = 0; ; shift += 7)
+			{
+				std::uint8_t byte = 0;
+				if (!(r >> io::read<std::uint8_t>(byte)))
+				{
+					return r;
+				}
+
+				// Reject encodings which are longer than the target type allows
+				if (shift >= std::numeric_limits<T>::digits || (static_cast<std::uint64_t>(byte & 0x7F) << shift) >> shift != (byte & 0x7F))
+				{
+					r.setFailure();
+					return r;
+				}
+
+				value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+				if ((byte & 0x80) == 0)
+				{
+					break;
+				}
+			}
+
+			if (value > std::numeric_limits<T>::max())
+			{
+				r.setFailure();
+				return r;
+			}
+
+			surr.value = static_cast<T>(value);
+			return r;
+		}
+	}
+
+	/// Reads an unsigned integer written by io::write_var_uint. Fails if the value does not fit into T.
+	template <class T>
+	detail::ReadableVarUInt<T> read_var_uint(T& value)
+	{
+		static_assert(std::is_unsigned_v<T>, "read_var_uint requires an unsigned type");
+		return detail::ReadableVarUInt<T>(value);
+	}
 }
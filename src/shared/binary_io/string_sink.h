@@ -6,10 +6,11 @@
 
 #include <string>
 #include <cassert>
+#include <cstring>
 
 namespace io
 {
-	class StringSink : public ISink
+	class StringSink final : public ISink
 	{
 	public:
 
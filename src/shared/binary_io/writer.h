@@ -3,8 +3,15 @@
 #pragma once
 
 #include "sink.h"
+#include "plain_serializable.h"
+#include "string_sink.h"
+#include "vector_sink.h"
 #include "base/non_copyable.h"
 
+#include <cstddef>
+#include <memory>
+#include <string>
+
 
 namespace io
 {
@@ -14,6 +21,8 @@ namespace io
 	public:
 		explicit Writer(ISink &sink)
 			: m_sink(sink)
+			, m_stringSink(dynamic_cast<StringSink *>(&sink))
+			, m_vectorSink(dynamic_cast<VectorSink<char> *>(&sink))
 		{
 		}
 		virtual ~Writer() = default;
@@ -23,14 +32,41 @@ namespace io
 		ISink &Sink() { return m_sink; }
 		[[nodiscard]] const ISink &Sink() const { return m_sink; }
 
+		/// Writes raw bytes to the sink. Packets are written to a StringSink and most other buffers to a
+		/// VectorSink, both of which are final, so these writes are not dispatched virtually and can be inlined.
+		void WriteRaw(const char *src, std::size_t size)
+		{
+			if (m_stringSink)
+			{
+				m_stringSink->Write(src, size);
+			}
+			else if (m_vectorSink)
+			{
+				m_vectorSink->Write(src, size);
+			}
+			else
+			{
+				m_sink.Write(src, size);
+			}
+		}
+
 		template <class T>
 		void WritePOD(const T &pod)
 		{
-			m_sink.Write(
+			WriteRaw(
 			    reinterpret_cast<const char *>(&pod),
 			    sizeof(pod));
 		}
 
+		/// Writes a contiguous array of plain values with a single write call.
+		template <class T>
+		void WritePODRange(const T *src, std::size_t count)
+		{
+			WriteRaw(
+			    reinterpret_cast<const char *>(src),
+			    sizeof(T) * count);
+		}
+
 		template <class T>
 		void WritePOD(std::size_t position, const T &pod)
 		{
@@ -43,6 +79,8 @@ namespace io
 	private:
 
 		ISink &m_sink;
+		StringSink *m_stringSink;
+		VectorSink<char> *m_vectorSink;
 	};
 
 
@@ -156,9 +194,16 @@ namespace io
 		template <class I>
 		Writer &operator << (Writer &w, const WriteRange<I> &range)
 		{
-			for (I i = range.begin; i != range.end; ++i)
+			if constexpr (IsPlainContiguousIterator<I>)
 			{
-				w << *i;
+				w.WritePODRange(std::to_address(range.begin), static_cast<std::size_t>(range.end - range.begin));
+			}
+			else
+			{
+				for (I i = range.begin; i != range.end; ++i)
+				{
+					w << *i;
+				}
 			}
 
 			return w;
@@ -213,9 +258,16 @@ namespace io
 
 			w << length;
 
-			for (I i = range.begin; i != range.end; ++i)
+			if constexpr (IsPlainContiguousIterator<I>)
+			{
+				w.WritePODRange(std::to_address(range.begin), static_cast<std::size_t>(range.end - range.begin));
+			}
+			else
 			{
-				w << *i;
+				for (I i = range.begin; i != range.end; ++i)
+				{
+					w << *i;
+				}
 			}
 
 			return w;
@@ -320,6 +372,46 @@ namespace io
 		return detail::WritablePackedGuid(plain_guid);
 	}
 
+	namespace detail
+	{
+		struct WritableVarUInt
+		{
+			std::uint64_t value;
+
+			explicit WritableVarUInt(const std::uint64_t value_)
+				: value(value_)
+			{
+			}
+		};
+
+		inline Writer &operator << (Writer &w, const WritableVarUInt &surr)
+		{
+			std::uint64_t value = surr.value;
+
+			std::uint8_t bytes[10];
+			size_t size = 0;
+
+			// Seven bits per byte, the high bit marks that another byte follows
+			while (value >= 0x80)
+			{
+				bytes[size++] = static_cast<std::uint8_t>(value | 0x80);
+				value >>= 7;
+			}
+
+			bytes[size++] = static_cast<std::uint8_t>(value);
+
+			return w
+				<< io::write_range(&bytes[0], &bytes[size]);
+		}
+	}
+
+	/// Writes an unsigned integer using one byte per seven bits, so that small values only take a single byte.
+	///	Symmetric with io::read_var_uint.
+	inline detail::WritableVarUInt write_var_uint(const std::uint64_t value)
+	{
+		return detail::WritableVarUInt(value);
+	}
+
 	namespace detail
 	{
 		/// Writes a null-terminated string (matches io::read_string on the reader side).
@@ -331,11 +423,8 @@ namespace io
 
 		inline Writer& operator<<(Writer& w, const WriteString& surr)
 		{
-			for (char c : surr.value)
-			{
-				w << c;
-			}
-			w << static_cast<char>(0);
+			// c_str() includes the terminating null character
+			w.WriteRaw(surr.value.c_str(), surr.value.size() + 1);
 			return w;
 		}
 	}
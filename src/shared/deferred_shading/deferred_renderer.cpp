@@ -10,6 +10,7 @@
 #include "scene_graph/camera.h"
 #include "scene_graph/render_queue.h"
 #include "log/default_log_levels.h"
+#include "base/job_system.h"
 #include "base/profiler.h"
 
 #ifdef WIN32
@@ -687,6 +688,48 @@ namespace mmo
 
         scene.GatherShadowCasters(gatherRegion, m_shadowCasterCache);
 
+        // Cull the gathered list against every scheduled cascade concurrently. This only runs the bounds
+        // tests, so rendering below still sets up the per-camera object state one cascade at a time, but
+        // on a much smaller list.
+        std::array<uint32, NUM_SHADOW_CASCADES> scheduledCascades{};
+        uint32 scheduledCount = 0;
+        for (uint32 i = 0; i < activeCascades; ++i)
+        {
+            if (m_shadowCameras[i] && (updateMask & (1u << i)) != 0u)
+            {
+                // Cameras update their view and frustum lazily from their scene node; do that here so the
+                // jobs only read shared scene graph state.
+                (void)m_shadowCameras[i]->GetFrustumPlane(0);
+                scheduledCascades[scheduledCount++] = i;
+            }
+        }
+
+        const auto cullCascade = [this, &scheduledCascades, &cascades](const size_t index)
+        {
+            const uint32 cascade = scheduledCascades[index];
+
+            // Sub-texel small-object culling: a caster whose full world extent is below one shadow
+            // texel casts a shadow under a single texel — blurred away entirely by the 16-tap PCF —
+            // so skipping it has no visible effect. We compare the world half-extent against half a
+            // texel (full extent < 1 texel) to stay strictly on the lossless side. worldTexelSize
+            // grows with cascade distance, so distant cascades naturally skip more tiny casters while
+            // the near cascade keeps virtually everything.
+            const float minCasterWorldRadius = cascades[cascade].worldTexelSize * 0.5f;
+            Scene::CullShadowCasters(*m_shadowCameras[cascade], m_shadowCasterCache, minCasterWorldRadius, m_cascadeCasters[cascade]);
+        };
+
+        if (JobSystem* jobSystem = scene.GetJobSystem())
+        {
+            jobSystem->ParallelFor(scheduledCount, cullCascade);
+        }
+        else
+        {
+            for (uint32 i = 0; i < scheduledCount; ++i)
+            {
+                cullCascade(i);
+            }
+        }
+
         // Setup depth bias
         m_device.SetDepthBias(m_depthBias);
         m_device.SetSlopeScaledDepthBias(m_slopeScaledDepthBias);
@@ -704,14 +747,8 @@ namespace mmo
             m_cascadeShadowMaps[i]->Activate();
             m_cascadeShadowMaps[i]->Clear(ClearFlags::Depth);
 
-            // Sub-texel small-object culling: a caster whose full world extent is below one shadow
-            // texel casts a shadow under a single texel — blurred away entirely by the 16-tap PCF —
-            // so skipping it has no visible effect. We compare the world half-extent against half a
-            // texel (full extent < 1 texel) to stay strictly on the lossless side. worldTexelSize
-            // grows with cascade distance, so distant cascades naturally skip more tiny casters while
-            // the near cascade keeps virtually everything.
             const float minCasterWorldRadius = cascades[i].worldTexelSize * 0.5f;
-            scene.RenderShadowCasters(*m_shadowCameras[i], m_shadowCasterCache, minCasterWorldRadius);
+            scene.RenderShadowCasters(*m_shadowCameras[i], m_cascadeCasters[i], minCasterWorldRadius);
 
             m_cascadeShadowMaps[i]->Update();
         }
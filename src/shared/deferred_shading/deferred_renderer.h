@@ -295,6 +295,10 @@ namespace mmo
         ///        retained between frames instead of reallocating every frame.
         std::vector<MovableObject*> m_shadowCasterCache;
 
+        /// @brief Per-cascade subsets of m_shadowCasterCache, culled concurrently for all cascades
+        ///        scheduled in a frame before the cascades are rendered one after another.
+        std::array<std::vector<MovableObject*>, NUM_SHADOW_CASCADES> m_cascadeCasters;
+
 #ifdef _WIN32
         // --- Per-pass GPU timing (only active while the profiler/perf overlay is enabled) ---
         // Timestamp points: 0 = start, 1 = after shadows, 2 = after G-Buffer, 3 = after lighting,
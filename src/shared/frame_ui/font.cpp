@@ -24,6 +24,11 @@ namespace mmo
 	static constexpr uint32 GLYPHS_PER_PAGE = 256;
 	/// Amount of bits in a uint32.
 	static constexpr uint32 BITS_PER_UINT = sizeof(uint32) * 8;
+	/// Number of codepoints which are looked up in a flat table instead of the glyph map. Covers latin, greek and
+	/// cyrillic scripts. Must be a multiple of GLYPHS_PER_PAGE.
+	static constexpr uint32 GLYPH_TABLE_SIZE = 0x800;
+	/// Maximum number of text layouts which are cached per font.
+	static constexpr size_t LAYOUT_CACHE_SIZE = 512;
 
 
 	/// FreeType library handle.
@@ -38,6 +43,7 @@ namespace mmo
 		, m_height(0)
 		, m_outlineWidth(0.0f)
 		, m_maxCodepoint(0)
+		, m_layoutCache(LAYOUT_CACHE_SIZE)
 	{
 		// Initializes the free type library if not already done and also increase
 		// the reference counter.
@@ -168,6 +174,8 @@ namespace mmo
 
 		// Update the amount of code points
 		SetMaxCodepoint(maxCodepoint);
+		m_glyphTable.assign(std::min<uint32>(GLYPH_TABLE_SIZE, maxCodepoint + 1), nullptr);
+		m_layoutCache.Clear();
 
 		// TODO: This is a hack to initialize some commonly used glyph pages
 		GetGlyphData('a');
@@ -523,17 +531,45 @@ namespace mmo
 	}
 
 	float Font::GetTextWidth(const std::string & text, float scale)
+	{
+		return GetTextLayout(text, scale).width;
+	}
+
+	const TextLayout& Font::GetTextLayout(const std::string& text, float scale)
+	{
+		TextLayoutKey key { text, scale };
+		if (const TextLayout* layout = m_layoutCache.Get(key))
+		{
+			return *layout;
+		}
+
+		auto layout = std::make_unique<TextLayout>();
+		LayoutText(text, scale, *layout);
+
+		const TextLayout& result = *layout;
+		m_layoutCache.Put(key, std::move(layout));
+		return result;
+	}
+
+	void Font::LayoutText(const std::string& text, float scale, TextLayout& layout)
 	{
 		float curLineWidth = 0.0f; // longest line so far
 		float advWidth = 0.0f; // running width of current line
+		const float lineHeight = GetHeight(scale);
+		float glyphY = GetBaseline(scale) + 4.0f;
 
-		argb_t dummyColour = 0;    // not used - needed for helper signature
+		argb_t currentColour = 0;
+		bool useDefaultColour = true;
 
 		for (std::size_t byteIndex = 0; byteIndex < text.length(); /* increment inside loop */)
 		{
-			// Skip any inline‑colour directive
-			if (ConsumeColourTag(text, byteIndex, dummyColour, dummyColour))
+			// Remember inline-colour directives per glyph, so the layout can be drawn with any default colour
+			const std::size_t tagIndex = byteIndex;
+			if (ConsumeColourTag(text, byteIndex, currentColour, 0))
+			{
+				useDefaultColour = text[tagIndex + 1] == 'r' || text[tagIndex + 1] == 'R';
 				continue;
+			}
 
 			std::size_t iterations = 1;
 			uint32 codepoint;
@@ -549,6 +585,7 @@ namespace mmo
 			{
 				curLineWidth = std::max(curLineWidth, advWidth);
 				advWidth = 0.0f;
+				glyphY += lineHeight;
 				byteIndex++;
 				continue;
 			}
@@ -567,6 +604,14 @@ namespace mmo
 
 			if (const FontGlyph* glyph = GetGlyphData(codepoint))
 			{
+				const FontImage* img = glyph->GetImage();
+				layout.glyphs.push_back(ShapedGlyph{
+					img,
+					Point(advWidth, glyphY - (img->GetOffsetY() - img->GetOffsetY() * scale)),
+					img->GetSize() * scale,
+					currentColour,
+					useDefaultColour });
+
 				const float width = glyph->GetRenderedAdvance(scale);
 
 				for (std::size_t i = 0; i < iterations; ++i)
@@ -577,11 +622,34 @@ namespace mmo
 			}
 		}
 
-		return std::max(curLineWidth, advWidth);
+		layout.width = std::max(curLineWidth, advWidth);
+	}
+
+	void Font::DrawGlyphs(const ShapedGlyph* glyphs, const size_t count, const Point& position, GeometryBuffer& buffer, const argb_t color) const
+	{
+		const bool hasShadow = m_shadowX != 0.0f || m_shadowY != 0.0f;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const ShapedGlyph& glyph = glyphs[i];
+			const argb_t glyphColor = glyph.useDefaultColor ? color : glyph.color;
+			const Point drawPos = position + glyph.position;
+
+			if (hasShadow)
+			{
+				glyph.image->Draw(drawPos + Point(m_shadowX, m_shadowY), glyph.size, buffer,
+					Color(0.0f, 0.0f, 0.0f, Color(glyphColor).GetAlpha()));
+			}
+
+			glyph.image->Draw(drawPos, glyph.size, buffer, glyphColor);
+		}
 	}
 
 	const FontGlyph * Font::GetGlyphData(const uint32 codepoint)
 	{
+		if (codepoint < m_glyphTable.size() && m_glyphTable[codepoint])
+			return m_glyphTable[codepoint];
+
 		if (codepoint > m_maxCodepoint)
 			return nullptr;
 
@@ -595,6 +663,13 @@ namespace mmo
 			Rasterize(
 				codepoint & ~(GLYPHS_PER_PAGE - 1),
 				codepoint | (GLYPHS_PER_PAGE - 1));
+
+			// The glyphs of the page won't change anymore, so they can be looked up directly from now on
+			for (auto it = m_glyphMap.lower_bound(codepoint & ~(GLYPHS_PER_PAGE - 1));
+				it != m_glyphMap.end() && it->first < m_glyphTable.size() && it->first <= (codepoint | (GLYPHS_PER_PAGE - 1)); ++it)
+			{
+				m_glyphTable[it->first] = &it->second;
+			}
 		}
 
 		// Find the glyph data
@@ -604,65 +679,8 @@ namespace mmo
 
 	void Font::DrawText(const std::string & text, const Point & position, GeometryBuffer& buffer, float scale, argb_t color)
 	{
-		const float baseline = position.y + GetBaseline(scale);
-		Point glyphPos(position);
-
-		argb_t currentColour = color;
-
-		for (std::size_t byteIndex = 0; byteIndex < text.length(); /* increment inside loop */)
-		{
-			if (ConsumeColourTag(text, byteIndex, currentColour, color))
-				continue;
-
-			std::size_t iterations = 1;
-			uint32 codepoint;
-			
-			// Handle special ASCII control characters
-			if (text[byteIndex] == '\t')
-			{
-				codepoint = ' ';
-				iterations = 4;
-				byteIndex++;
-			}
-			else if (text[byteIndex] == '\n')
-			{
-				glyphPos.x = position.x;
-				glyphPos.y = (glyphPos.y - baseline) + GetHeight(scale) + baseline;
-				byteIndex++;
-				continue;
-			}
-			else
-			{
-				// Process UTF-8 character
-				size_t startPos = byteIndex;
-				codepoint = utf8::next_codepoint(text, byteIndex);
-				
-				// If we couldn't decode a valid codepoint, skip this byte
-				if (codepoint == 0 && startPos < byteIndex)
-				{
-					continue;
-				}
-			}
-
-			if (const FontGlyph* glyph = GetGlyphData(codepoint))
-			{
-				const FontImage* img = glyph->GetImage();
-				const Point drawPos = {
-					glyphPos.x,
-					baseline - (img->GetOffsetY() - img->GetOffsetY() * scale) + 4.0f
-				};
-
-				if (m_shadowX != 0.0f || m_shadowY != 0.0f)
-				{
-					img->Draw(drawPos + Point(m_shadowX, m_shadowY), img->GetSize() * scale, buffer,
-						Color(0.0f, 0.0f, 0.0f, Color(currentColour).GetAlpha()));
-				}
-
-				img->Draw(drawPos, img->GetSize() * scale, buffer, currentColour);
-
-				glyphPos.x += glyph->GetAdvance(scale) * iterations;
-			}
-		}
+		const TextLayout& layout = GetTextLayout(text, scale);
+		DrawGlyphs(layout.glyphs.data(), layout.glyphs.size(), position, buffer, color);
 	}
 
 	int Font::DrawText(const std::string& text, const Rect& area, GeometryBuffer* buffer, float scale, argb_t color)
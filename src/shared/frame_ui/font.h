@@ -9,11 +9,13 @@
 #include "hyperlink.h"
 
 #include "base/typedefs.h"
+#include "base/lru_cache.h"
 
 #include <map>
 #include <list>
 #include <vector>
 #include <memory>
+#include <string>
 
 #include "ft2build.h"
 #include FT_FREETYPE_H
@@ -23,6 +25,57 @@ namespace mmo
 {
 	class GeometryBuffer;
 
+	/// A glyph of a laid out text, positioned relative to the position the text is drawn at.
+	struct ShapedGlyph
+	{
+		/// The image which is drawn for the glyph.
+		const FontImage* image;
+		/// Position of the image relative to the text position.
+		Point position;
+		/// The scaled size of the image.
+		Size size;
+		/// The color set by an inline color tag. Only used if useDefaultColor is false.
+		argb_t color;
+		/// Whether the glyph is drawn with the color the text is drawn with.
+		bool useDefaultColor;
+	};
+
+	/// A laid out text which can be drawn at any position and with any color without measuring it again.
+	struct TextLayout
+	{
+		/// The glyphs of the text in drawing order.
+		std::vector<ShapedGlyph> glyphs;
+		/// The width of the longest line in pixels.
+		float width = 0.0f;
+	};
+
+	/// Identifies a cached text layout of a font.
+	struct TextLayoutKey
+	{
+		std::string text;
+		float scale;
+
+		bool operator==(const TextLayoutKey& other) const
+		{
+			return scale == other.scale && text == other.text;
+		}
+	};
+}
+
+namespace std
+{
+	template<>
+	struct hash<mmo::TextLayoutKey>
+	{
+		size_t operator()(const mmo::TextLayoutKey& key) const noexcept
+		{
+			return std::hash<std::string>{}(key.text) ^ (std::hash<float>{}(key.scale) * 31);
+		}
+	};
+}
+
+namespace mmo
+{
 	/// This class is used to load a font from a true type font file. It utilizes the freetype
 	/// library to do this. It can also be used to measure text width and queue geometry for 
 	/// drawing text to a GeometryBuffer object.
@@ -94,6 +147,9 @@ namespace mmo
 		/// Performs internal initialization.
 		bool InitializeInternal();
 
+		/// Lays out a single text run like DrawText(text, position, ...) draws it.
+		void LayoutText(const std::string& text, float scale, TextLayout& layout);
+
 		/// Calculates the required texture size to display the given glyphs.
 		/// @param start The start codepoint.
 		/// @param end The end codepoint.
@@ -126,6 +182,21 @@ namespace mmo
 		/// @return nullptr if the data isn't available in this font.
 		const FontGlyph* GetGlyphData(uint32 codepoint);
 
+		/// Gets the layout of a single text run, which is what DrawText(text, position, ...) draws. Layouts are kept
+		/// in a least recently used cache, so texts which are drawn or measured repeatedly are only laid out once.
+		/// @param text The text, which may contain inline color tags.
+		/// @param scale A scaling factor. Keep in mind that upscaling will result in a loss of quality.
+		/// @return The layout, which is valid until the next call to GetTextLayout.
+		const TextLayout& GetTextLayout(const std::string& text, float scale = 1.0f);
+
+		/// Draws laid out glyphs by appending geometry to a given GeometryBuffer object.
+		/// @param glyphs The glyphs to be drawn.
+		/// @param count The number of glyphs.
+		/// @param position The position (in pixels) which the glyph positions are relative to.
+		/// @param buffer The geometry buffer which will receive the generated geometry.
+		/// @param color The argb color value of glyphs without an inline color.
+		void DrawGlyphs(const ShapedGlyph* glyphs, size_t count, const Point& position, GeometryBuffer& buffer, argb_t color = 0xFFFFFFFF) const;
+
 		/// Draws a given text by appending geometry to a given GeometryBuffer object.
 		/// @param text The text to be drawn.
 		/// @param position The position (in pixels) where to draw the text on screen.
@@ -201,6 +272,11 @@ namespace mmo
 
 		/// A map of loaded glyph data.
 		GlyphMap m_glyphMap;
+		/// Rasterized glyphs of the most common codepoints, indexed by codepoint, so that looking them up doesn't need
+		/// to search the glyph map. Entries are nullptr until the page of the glyph has been rasterized.
+		std::vector<const FontGlyph*> m_glyphTable;
+		/// Recently used text layouts.
+		LRUCache<TextLayoutKey, TextLayout> m_layoutCache;
 		/// The maximum supported codepoint of this font.
 		uint32 m_maxCodepoint;
 		/// The loaded glyph pages.
@@ -39,6 +39,18 @@ namespace mmo
 		m_propConnections += AddProperty("DropEnabled").Changed.connect(this, &Frame::OnDropEnabledPropertyChanged);
 	}
 
+	Frame::~Frame()
+	{
+		// Make sure the frame manager doesn't dispatch events to this frame anymore
+		if (!m_registeredEventIds.empty() && FrameManager::IsInitialized())
+		{
+			for (const uint32 eventId : m_registeredEventIds)
+			{
+				FrameManager::Get().FrameUnregisterEvent(*this, eventId);
+			}
+		}
+	}
+
 	void Frame::Copy(Frame & other)
 	{
 		if (m_renderer)
@@ -237,7 +249,23 @@ namespace mmo
 	{
 		m_eventFunctionsByName[name] = fn;
 
-		FrameManager::Get().FrameRegisterEvent(shared_from_this(), name);
+		const uint32 eventId = FrameManager::Get().FrameRegisterEvent(*this, name, fn, false);
+		if (std::find(m_registeredEventIds.begin(), m_registeredEventIds.end(), eventId) == m_registeredEventIds.end())
+		{
+			m_registeredEventIds.push_back(eventId);
+		}
+	}
+
+	void Frame::RegisterBatchedEvent(const std::string& name, const luabind::object& fn)
+	{
+		// Batched handlers expect an argument batch, so they can't be triggered by name on this frame
+		m_eventFunctionsByName.erase(name);
+
+		const uint32 eventId = FrameManager::Get().FrameRegisterEvent(*this, name, fn, true);
+		if (std::find(m_registeredEventIds.begin(), m_registeredEventIds.end(), eventId) == m_registeredEventIds.end())
+		{
+			m_registeredEventIds.push_back(eventId);
+		}
 	}
 
 	void Frame::UnregisterEvent(const std::string & name)
@@ -248,7 +276,9 @@ namespace mmo
 			m_eventFunctionsByName.erase(it);
 		}
 
-		FrameManager::Get().FrameUnregisterEvent(shared_from_this(), name);
+		const uint32 eventId = FrameManager::Get().InternEvent(name);
+		std::erase(m_registeredEventIds, eventId);
+		FrameManager::Get().FrameUnregisterEvent(*this, eventId);
 	}
 
 	void Frame::SetOnLoad(const luabind::object& fn)
@@ -873,10 +903,12 @@ namespace mmo
 		DrawSelf();
 
 		// Whether a clip rect has been set by this function call to avoid calling ResetClipRect on
-		// the graphics library more often than needed
+		// the batcher more often than needed
 		bool hasClipRectSet = false;
 
-		// Draw children
+		// Draw children. Clip rects are recorded by the batcher and only applied to the graphics device when a
+		// batch with a different clip rect is drawn.
+		UiBatcher& batcher = FrameManager::Get().GetBatcher();
 		for (const auto& child : m_children)
 		{
 			if (child->IsClippedByParent())
@@ -884,13 +916,12 @@ namespace mmo
 				hasClipRectSet = true;
 
 				// Set clip rect
-				const Rect clipRect = GetAbsoluteFrameRect();
-				gx.SetClipRect(clipRect.left, clipRect.top, clipRect.right - clipRect.left, clipRect.bottom - clipRect.top);
+				batcher.SetClipRect(GetAbsoluteFrameRect());
 			}
 			else if (hasClipRectSet)
 			{
 				// Reset clip rect
-				gx.ResetClipRect();
+				batcher.ResetClipRect();
 				hasClipRectSet = false;
 			}
 
@@ -900,7 +931,7 @@ namespace mmo
 
 		if (hasClipRectSet)
 		{
-			gx.ResetClipRect();
+			batcher.ResetClipRect();
 		}
 	}
 
@@ -1536,8 +1567,8 @@ namespace mmo
 
 	void Frame::QueueGeometry()
 	{
-		// Draw the geometry buffer
-		m_geometryBuffer.Draw();
+		// Queue the geometry buffer so that it can be merged with the geometry of other frames
+		FrameManager::Get().GetBatcher().Queue(m_geometryBuffer);
 	}
 
 	Rect Frame::GetParentRect()
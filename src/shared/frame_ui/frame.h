@@ -97,7 +97,7 @@ namespace mmo
 
 	public:
 		Frame(const std::string& type, const std::string& name);
-		virtual ~Frame() override = default;
+		virtual ~Frame() override;
 
 	public:
 		/// Called to copy this frame's properties over to another frame.
@@ -127,6 +127,10 @@ namespace mmo
 		/// Register a lua function as an event handler.
 		void RegisterEvent(const std::string& name, const luabind::object& fn);
 
+		/// Register a lua function as an event handler which is called once per update with a table that contains
+		///	the argument lists of all events of this name raised since the last update.
+		void RegisterBatchedEvent(const std::string& name, const luabind::object& fn);
+
 		/// Removes a registered event function for a given event name.
 		void UnregisterEvent(const std::string& name);
 
@@ -620,6 +624,8 @@ namespace mmo
 		std::map<std::string, ImagerySection> m_sectionsByName;
 		/// Event function callbacks by name.
 		std::map<std::string, luabind::object, StrCaseIComp> m_eventFunctionsByName;
+		/// Interned ids of the frame manager events this frame is subscribed to.
+		std::vector<uint32> m_registeredEventIds;
 		/// 
 		std::map<std::string, Property, StrCaseIComp> m_propertiesByName;
 		/// Whether this frame can receive the input focus on click.
@@ -325,6 +325,9 @@ namespace mmo
 
 	static std::unique_ptr<FrameManager> s_frameMgr;
 
+	/// Number of frame manager instances created so far.
+	static uint32 s_frameMgrGeneration = 0;
+
 	FrameManager::FrameManager(const Localization& localization)
 		: m_localization(localization)
 	{
@@ -336,6 +339,11 @@ namespace mmo
 		return *s_frameMgr;
 	}
 
+	bool FrameManager::IsInitialized()
+	{
+		return s_frameMgr != nullptr;
+	}
+
 	namespace
 	{
 		const std::string& LuaLocalize(const std::string& id)
@@ -377,6 +385,9 @@ namespace mmo
 		ASSERT(!s_frameMgr);
 		s_frameMgr = std::make_unique<FrameManager>(localization);
 
+		// Event ids cached for an earlier instance have to be interned again
+		s_frameMgr->m_generation = ++s_frameMgrGeneration;
+
 		// Verify and register lua state
 		ASSERT(luaState);
 		s_frameMgr->m_luaState = luaState;
@@ -428,6 +439,7 @@ namespace mmo
 					.def("Enable", &Frame::Enable)
 					.def("Disable", &Frame::Disable)
 					.def("RegisterEvent", &Frame::RegisterEvent)
+					.def("RegisterBatchedEvent", &Frame::RegisterBatchedEvent)
 					.def("GetName", &Frame::GetName)
 					.def("IsHovered", &Frame::IsHovered)
 					.def("IsVisible", &Frame::Lua_IsVisible)
@@ -771,7 +783,17 @@ namespace mmo
 
 	void FrameManager::ResetTopFrame()
 	{
-		m_eventFrames.clear();
+		// Event ids stay valid, only the subscriptions are dropped
+		for (auto& event : m_events)
+		{
+			event.subscribers.clear();
+			event.removedCount = 0;
+			event.batchedCount = 0;
+			event.pendingBatch = luabind::object();
+			event.pendingCount = 0;
+		}
+		m_pendingBatchedEvents.clear();
+
 		m_fontMaps.clear();
 		m_hoverFrame = nullptr;
 		m_inputCapture = nullptr;
@@ -784,19 +806,28 @@ namespace mmo
 		m_topFrame.reset();
 	}
 
-	void FrameManager::Draw()
+	void FrameManager::Draw(const std::function<void()>& drawOverlay)
 	{
 		// Disable depth test & write
 		GraphicsDevice::Get().SetDepthEnabled(false);
 		GraphicsDevice::Get().SetDepthWriteEnabled(false);
 		GraphicsDevice::Get().SetFaceCullMode(FaceCullMode::None);
 
+		m_batcher.Begin();
+
 		// Render top frame if there is any
 		if (m_topFrame != nullptr)
 		{
 			m_topFrame->Render();
 		}
 
+		if (drawOverlay)
+		{
+			drawOverlay();
+		}
+
+		m_batcher.End();
+
 		if (m_cursorIconTexture)
 		{
 			// Ensure the cursor icon is drawn at the cursor location
@@ -808,10 +839,16 @@ namespace mmo
 
 	void FrameManager::Update(float elapsedSeconds)
 	{
+		// Deliver the events raised since the last update to batched handlers
+		FlushBatchedEvents();
+
 		if (m_topFrame)
 		{
 			m_topFrame->Update(elapsedSeconds);
 		}
+
+		m_lastEventStats = m_eventStats;
+		m_eventStats = EventStats();
 	}
 
 	void FrameManager::NotifyMouseMoved(const Point & position)
@@ -1098,34 +1135,141 @@ namespace mmo
 		}
 	}
 
-	void FrameManager::FrameRegisterEvent(FramePtr frame, const std::string & eventName)
+	FrameManager::EventId FrameManager::InternEvent(const std::string& eventName)
+	{
+		const auto [it, inserted] = m_eventIds.emplace(eventName, static_cast<EventId>(m_events.size()));
+		if (inserted)
+		{
+			m_events.emplace_back().name = eventName;
+		}
+
+		return it->second;
+	}
+
+	FrameManager::EventId CachedLuaEvent::GetId()
+	{
+		FrameManager& frameMgr = FrameManager::Get();
+		if (m_generation != frameMgr.GetGeneration())
+		{
+			m_id = frameMgr.InternEvent(m_name);
+			m_generation = frameMgr.GetGeneration();
+		}
+
+		return m_id;
+	}
+
+	FrameManager::EventId FrameManager::FrameRegisterEvent(Frame& frame, const std::string & eventName, const luabind::object& handler, const bool batched)
+	{
+		const EventId eventId = InternEvent(eventName);
+		EventSubscribers& event = m_events[eventId];
+
+		for (auto& subscriber : event.subscribers)
+		{
+			if (subscriber.frame == &frame)
+			{
+				if (subscriber.batched != batched)
+				{
+					event.batchedCount += batched ? 1 : -1;
+				}
+
+				subscriber.handler = handler;
+				subscriber.batched = batched;
+				return eventId;
+			}
+		}
+
+		event.subscribers.push_back({ &frame, frame.weak_from_this(), handler, batched });
+		if (batched)
+		{
+			event.batchedCount++;
+		}
+
+		return eventId;
+	}
+
+	void FrameManager::FrameUnregisterEvent(const Frame& frame, const EventId eventId)
 	{
-		m_eventFrames[eventName].emplace_back(std::move(frame));
+		if (eventId >= m_events.size())
+		{
+			return;
+		}
+
+		EventSubscribers& event = m_events[eventId];
+		for (auto& subscriber : event.subscribers)
+		{
+			if (subscriber.frame == &frame)
+			{
+				if (subscriber.batched)
+				{
+					event.batchedCount--;
+				}
+
+				// Only mark the entry as removed, as the event might currently be dispatched
+				subscriber.frame = nullptr;
+				event.removedCount++;
+				return;
+			}
+		}
 	}
 
-	void FrameManager::FrameUnregisterEvent(FramePtr frame, const std::string & eventName)
+	void FrameManager::CompactSubscribers(EventSubscribers& event)
 	{
-		auto it = m_eventFrames.find(eventName);
-		if (it != m_eventFrames.end())
+		std::erase_if(event.subscribers, [](const EventSubscriber& subscriber) { return subscriber.frame == nullptr; });
+		event.removedCount = 0;
+	}
+
+	void FrameManager::FlushBatchedEvents()
+	{
+		// Handlers might raise batched events again, which are delivered with the next flush
+		std::vector<EventId> pendingEvents;
+		pendingEvents.swap(m_pendingBatchedEvents);
+
+		m_dispatchDepth++;
+		for (const EventId eventId : pendingEvents)
 		{
-			for (auto frameIt = it->second.begin(); frameIt != it->second.end();)
+			EventSubscribers& event = m_events[eventId];
+
+			const luabind::object batch = std::move(event.pendingBatch);
+			event.pendingBatch = luabind::object();
+			event.pendingCount = 0;
+
+			const size_t count = event.subscribers.size();
+			for (size_t i = 0; i < count; ++i)
 			{
-				auto strongFrame = frameIt->lock();
-				if (!strongFrame)
+				const EventSubscriber& subscriber = event.subscribers[i];
+				if (subscriber.frame == nullptr || !subscriber.batched)
 				{
-					frameIt = it->second.erase(frameIt);
 					continue;
 				}
 
-				if (strongFrame.get() == frame.get())
+				const FramePtr frame = subscriber.weakFrame.lock();
+				if (!frame)
 				{
-					frameIt = it->second.erase(frameIt);
-					return;
+					continue;
+				}
+
+				luabind::object handler = subscriber.handler;
+				const luabind::object self = luabind::object(m_luaState, frame.get());
+
+				m_eventStats.luaCalls++;
+				try
+				{
+					handler(self, batch);
+				}
+				catch (const luabind::error& e)
+				{
+					ELOG("Lua error: " << e.what());
 				}
-				
-				frameIt++;
 			}
 		}
+		m_dispatchDepth--;
+
+		// Keep the vector's capacity for the next frame
+		if (m_pendingBatchedEvents.empty())
+		{
+			pendingEvents.clear();
+			m_pendingBatchedEvents.swap(pendingEvents);
+		}
 	}
 
 	luabind::object FrameManager::GetGlobal(const std::string& name)
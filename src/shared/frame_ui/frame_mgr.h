@@ -6,14 +6,17 @@
 #include "key.h"
 #include "localization.h"
 #include "localizer.h"
+#include "ui_batcher.h"
 
 #include "base/non_copyable.h"
 #include "base/utilities.h"
 
+#include <deque>
 #include <string>
 #include <functional>
 #include <map>
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 
 extern "C"
@@ -35,6 +38,19 @@ namespace mmo
 		typedef std::function<FramePtr(const std::string& name)> FrameFactory;
 		/// Type for a frame renderer factory.
 		typedef std::function<std::unique_ptr<FrameRenderer>(const std::string& name)> RendererFactory;
+		/// Type of an interned event name.
+		typedef uint32 EventId;
+
+		/// Counters of the lua event dispatch of the last frame.
+		struct EventStats
+		{
+			/// Number of events triggered.
+			uint32 triggeredEvents = 0;
+			/// Number of event handlers called in lua.
+			uint32 luaCalls = 0;
+			/// Number of events which were coalesced into argument batches.
+			uint32 batchedEvents = 0;
+		};
 
 	private:
 		/// Contains a hash map of all registered frame factories.
@@ -42,7 +58,47 @@ namespace mmo
 		/// Contains a hash map of all registered frame renderer facotries.
 		std::map<std::string, RendererFactory, StrCaseIComp> m_rendererFactories;
 
-		std::map<std::string, std::vector<std::weak_ptr<Frame>>> m_eventFrames;
+		/// A frame which is subscribed to an event.
+		struct EventSubscriber
+		{
+			/// The subscribed frame or nullptr if the frame unsubscribed. Identifies the subscriber, as frames
+			///	unsubscribe in their destructor when they can no longer be locked.
+			const Frame* frame;
+			/// Locked for every call, so that a handler which hides or destroys its own frame can't free it while
+			///	the handler is still running.
+			std::weak_ptr<Frame> weakFrame;
+			luabind::object handler;
+			/// Whether the handler receives all events raised since the last update at once.
+			bool batched;
+		};
+
+		/// The subscribers of an interned event.
+		struct EventSubscribers
+		{
+			std::string name;
+			/// Subscribers in registration order. Unsubscribed entries are only removed when the event is dispatched
+			/// the next time, so that unsubscribing while the event is dispatched is safe.
+			std::vector<EventSubscriber> subscribers;
+			uint32 removedCount = 0;
+			uint32 batchedCount = 0;
+			/// Argument lists of the events raised since the batched subscribers were called the last time.
+			luabind::object pendingBatch;
+			int32 pendingCount = 0;
+		};
+
+		/// Interned event ids by event name.
+		std::unordered_map<std::string, EventId> m_eventIds;
+		/// Subscribers by event id. A deque keeps references valid when lua interns new events during a dispatch.
+		std::deque<EventSubscribers> m_events;
+		/// Ids of the events which have pending argument batches.
+		std::vector<EventId> m_pendingBatchedEvents;
+		/// Number of dispatches in progress. Subscriber lists are not compacted while events are dispatched.
+		uint32 m_dispatchDepth = 0;
+
+		EventStats m_eventStats;
+		EventStats m_lastEventStats;
+
+		uint32 m_generation = 0;
 
 	private:
 		friend std::unique_ptr<FrameManager> std::make_unique<FrameManager, const Localization&>(const Localization&);
@@ -109,9 +165,16 @@ namespace mmo
 
 		void ResetTopFrame();
 
-		void Draw();
+		/// Renders the top frame and the cursor icon.
+		/// @param drawOverlay Optional function which renders frames that are not part of the frame tree. It is called
+		///	       after the top frame was rendered and before the cursor icon, while the batcher still collects geometry.
+		void Draw(const std::function<void()>& drawOverlay = nullptr);
 
 		void Update(float elapsedSeconds);
+
+		/// Gets the batcher which draws the geometry of all frames. Frames which draw to the graphics device directly
+		/// have to flush it first.
+		UiBatcher& GetBatcher() { return m_batcher; }
 		
 		/// Gets the currently hovered frame.
 		inline FramePtr GetHoveredFrame() const { return m_hoverFrame; }
@@ -155,26 +218,81 @@ namespace mmo
 		/// Executes lua code.
 		void ExecuteLua(const std::string& code);
 
+		/// Gets the interned id of an event name, creating a new one if the name wasn't used before. Ids stay valid
+		///	for the lifetime of the frame manager, so callers which trigger an event very often can look it up once.
+		///	See CachedLuaEvent.
+		EventId InternEvent(const std::string& eventName);
+
+		/// Gets a number which is different for every frame manager instance, so that cached event ids can tell
+		///	whether they were interned by the current one.
+		uint32 GetGeneration() const { return m_generation; }
+
 		/// Triggers a lua event.
 		template<typename ...Args>
 		void TriggerLuaEvent(const std::string & eventName, Args&&... args)
 		{
-			auto eventIt = m_eventFrames.find(eventName);
-			if (eventIt == m_eventFrames.end())
+			const auto idIt = m_eventIds.find(eventName);
+			if (idIt == m_eventIds.end())
 				return;
 
-			// Iterate through every frame
-			for (const auto& weakFrame : eventIt->second)
+			TriggerLuaEvent(idIt->second, std::forward<Args>(args)...);
+		}
+
+		/// Triggers a lua event by its interned id. Handlers registered with RegisterBatchedEvent are not called
+		///	immediately, they receive the arguments of all events raised until the next update as a single table.
+		template<typename ...Args>
+		void TriggerLuaEvent(const EventId eventId, Args&&... args)
+		{
+			if (eventId >= m_events.size())
+				return;
+
+			EventSubscribers& event = m_events[eventId];
+			if (event.subscribers.empty())
+				return;
+
+			m_eventStats.triggeredEvents++;
+
+			if (m_dispatchDepth == 0 && event.removedCount > 0)
 			{
-				if (auto strongFrame = weakFrame.lock())
-				{
-					// Push this variable
-					luabind::object o = luabind::object(m_luaState, strongFrame.get());
+				CompactSubscribers(event);
+			}
+
+			if (event.batchedCount > 0)
+			{
+				QueueBatchedEvent(eventId, event, args...);
+			}
 
-					// Raise event script
-					strongFrame->TriggerEvent(eventName, o, args...);
+			if (event.batchedCount == event.subscribers.size() - event.removedCount)
+				return;
+
+			// Subscribers added by a handler will receive the next event
+			m_dispatchDepth++;
+			const size_t count = event.subscribers.size();
+			for (size_t i = 0; i < count; ++i)
+			{
+				const EventSubscriber& subscriber = event.subscribers[i];
+				if (subscriber.frame == nullptr || subscriber.batched)
+					continue;
+
+				const FramePtr frame = subscriber.weakFrame.lock();
+				if (!frame)
+					continue;
+
+				// Copy the handler, as the handler might replace itself or add subscribers
+				luabind::object handler = subscriber.handler;
+				const luabind::object self = luabind::object(m_luaState, frame.get());
+
+				m_eventStats.luaCalls++;
+				try
+				{
+					handler(self, args...);
+				}
+				catch (const luabind::error& e)
+				{
+					ELOG("Lua error: " << e.what());
 				}
 			}
+			m_dispatchDepth--;
 		}
 
 		/// Sets the frame that is currently capturing the input.
@@ -188,15 +306,48 @@ namespace mmo
 		/// previously-active combo cannot accidentally clear a newer one.
 		void ClearActiveComboBox(const ComboBox* combo);
 
-		void FrameRegisterEvent(FramePtr frame, const std::string& eventName);
+		/// Subscribes a frame to an event. Registering an event again replaces the handler.
+		/// @returns The interned id of the event.
+		EventId FrameRegisterEvent(Frame& frame, const std::string& eventName, const luabind::object& handler, bool batched);
+
+		void FrameUnregisterEvent(const Frame& frame, EventId eventId);
+
+		/// Calls the batched event handlers with the arguments of all events raised since the last call.
+		void FlushBatchedEvents();
 
-		void FrameUnregisterEvent(FramePtr frame, const std::string& eventName);
+		/// Gets the event dispatch counters of the last frame.
+		const EventStats& GetEventStats() const { return m_lastEventStats; }
 
 		static luabind::object GetGlobal(const std::string& name);
 
 		/// Returns the raw Lua state. Use sparingly — prefer RegisterGlobal / TriggerLuaEvent.
 		lua_State* GetLuaState() const { return m_luaState; }
 
+		/// Determines whether the frame manager singleton currently exists.
+		static bool IsInitialized();
+
+	private:
+		/// Appends the arguments of an event to the pending argument batch of the event.
+		template<typename ...Args>
+		void QueueBatchedEvent(const EventId eventId, EventSubscribers& event, const Args&... args)
+		{
+			if (event.pendingCount == 0)
+			{
+				event.pendingBatch = luabind::newtable(m_luaState);
+				m_pendingBatchedEvents.push_back(eventId);
+			}
+
+			luabind::object arguments = luabind::newtable(m_luaState);
+			int32 index = 1;
+			((arguments[index++] = args), ...);
+			event.pendingBatch[++event.pendingCount] = arguments;
+
+			m_eventStats.batchedEvents++;
+		}
+
+		/// Removes unsubscribed entries from the subscriber list of an event.
+		void CompactSubscribers(EventSubscribers& event);
+
 	public:
 		/// Registers a new factory for a certain frame type.
 		void RegisterFrameFactory(const std::string& elementName, FrameFactory factory);
@@ -264,10 +415,32 @@ namespace mmo
 
 		GeometryBuffer m_cursorIconBuffer;
 
+		UiBatcher m_batcher;
+
 		/// Set of currently pressed keys to support modifier-aware controls.
 		std::unordered_set<Key> m_pressedKeys;
 
 		/// The ComboBox that is currently open and waiting for an outside-click dismiss.
 		std::weak_ptr<ComboBox> m_activeComboBox;
 	};
+
+	/// The name of a lua event which is triggered very often, together with its interned id. The id is interned once
+	///	per frame manager instance, so triggering the event doesn't look up its name.
+	class CachedLuaEvent final
+	{
+	public:
+		explicit CachedLuaEvent(std::string name)
+			: m_name(std::move(name))
+		{
+		}
+
+	public:
+		/// Gets the interned id of the event in the current frame manager.
+		FrameManager::EventId GetId();
+
+	private:
+		std::string m_name;
+		uint32 m_generation = 0;
+		FrameManager::EventId m_id = 0;
+	};
 }
@@ -7,8 +7,12 @@
 
 namespace mmo
 {
+	/// The last version assigned to the contents of any geometry buffer.
+	static uint64 s_lastVersion = 0;
+
 	GeometryBuffer::GeometryBuffer()
 		: m_sync(false)
+		, m_version(++s_lastVersion)
 	{
 		m_hwBuffer = GraphicsDevice::Get().CreateVertexBuffer(64, sizeof(Vertex), BufferUsage::DynamicWriteOnlyDiscardable, nullptr);
 	}
@@ -70,19 +74,13 @@ namespace mmo
 		// Update size of current batch
 		m_batches.back().second += count;
 
-		// Buffer these vertices
-		m_vertices.reserve(m_vertices.size() + count);
-		for (uint32 i = 0; i < count; ++i)
-		{
-			const Vertex& vs = buffer[i];
-
-			// TODO: If needed, modify vertex data in here
-
-			m_vertices.push_back(vs);
-		}
+		// Buffer these vertices. Text appends a single quad per glyph, so let the vector grow geometrically instead
+		// of reserving exactly the appended amount every time.
+		m_vertices.insert(m_vertices.end(), buffer, buffer + count);
 
 		// Buffer is out of sync now
 		m_sync = false;
+		m_version = ++s_lastVersion;
 	}
 
 	void GeometryBuffer::SetActiveTexture(const TexturePtr& texture)
@@ -96,6 +94,7 @@ namespace mmo
 		m_batches.clear();
 		m_activeTexture = nullptr;
 		m_sync = false;
+		m_version = ++s_lastVersion;
 	}
 
 	TexturePtr GeometryBuffer::GetActiveTexture() const
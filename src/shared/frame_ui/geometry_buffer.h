@@ -24,6 +24,10 @@ namespace mmo
 	public:
 		/// Shortcut for better readability
 		typedef POS_COL_TEX_VERTEX Vertex;
+		/// type to track info for per-texture sub batches of geometry
+		typedef std::pair<TexturePtr, uint32> BatchInfo;
+		/// type of container that tracks BatchInfos.
+		typedef std::vector<BatchInfo> BatchList;
 		
 	public:
 		/// Default constructor initializes an empty default vertex buffer.
@@ -62,6 +66,16 @@ namespace mmo
 		/// Gets the number of batches in the buffer.
 		uint32 GetBatchCount() const;
 
+		/// Gets the per-texture batches of the buffer in drawing order.
+		const BatchList& GetBatches() const { return m_batches; }
+
+		/// Gets the buffered vertices of all batches.
+		const Vertex* GetVertices() const { return m_vertices.data(); }
+
+		/// Gets a value which changes whenever the contents of the buffer change. Versions are unique across all
+		/// geometry buffers, so comparing versions also tells apart different buffers.
+		uint64 GetVersion() const { return m_version; }
+
 	private:
 		/// Copies the contents of the vertices over to the hardware buffer, eventally
 		/// reallocating it if there isn't enough space for the required vertices.
@@ -71,10 +85,9 @@ namespace mmo
 		/// whether the hw buffer is in sync with the added geometry
 		bool m_sync;
 
-		/// type to track info for per-texture sub batches of geometry
-		typedef std::pair<TexturePtr, uint32> BatchInfo;
-		/// type of container that tracks BatchInfos.
-		typedef std::vector<BatchInfo> BatchList;
+		/// the version of the current contents
+		uint64 m_version;
+
 		/// list of texture batches added to the geometry buffer
 		BatchList m_batches;
 
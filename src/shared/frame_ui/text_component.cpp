@@ -49,12 +49,20 @@ namespace mmo
 
 	void TextComponent::SetHorizontalAlignment(HorizontalAlignment alignment)
 	{
-		m_horzAlignment = alignment;
+		if (m_horzAlignment != alignment)
+		{
+			m_horzAlignment = alignment;
+			m_layoutValid = false;
+		}
 	}
 
 	void TextComponent::SetVerticalAlignment(VerticalAlignment alignment)
 	{
-		m_vertAlignment = alignment;
+		if (m_vertAlignment != alignment)
+		{
+			m_vertAlignment = alignment;
+			m_layoutValid = false;
+		}
 	}
 
 	void TextComponent::SetColor(const Color & color)
@@ -288,10 +296,26 @@ namespace mmo
 			// Get frame area rect of this component
 			const Rect frameRect = GetArea(area);
 
-			// TODO: Right now, we get the area passed in the render function. This requires us to
-			// invalidate (or check) the cache every time the component is rendered! It would be better
-			// to have the area as a member variable and change it if needed.
-			CacheText(frameRect);
+			// The layout only depends on the size of the area, so moving the frame or changing its color only
+			// draws the cached glyphs again
+			const std::string& text = m_frame->GetVisualText();
+			if (!IsLayoutCached(text, *font, frameRect.GetSize(), textScale))
+			{
+				CacheText(frameRect);
+
+				m_glyphCache.clear();
+				if (m_parsedText.hyperlinks.empty())
+				{
+					LayoutTraditional(frameRect, textScale);
+				}
+
+				m_layoutText = text;
+				m_layoutFont = font.get();
+				m_layoutAreaSize = frameRect.GetSize();
+				m_layoutScale = textScale;
+				m_layoutColor = m_color.GetARGB();
+				m_layoutValid = true;
+			}
 
 			// Apply color multiplication
 			Color c = color;
@@ -306,12 +330,24 @@ namespace mmo
 			else
 			{
 				// No hyperlinks - use traditional rendering with full alignment support
-				RenderTraditional(frameRect, c, textScale);
+				font->DrawGlyphs(m_glyphCache.data(), m_glyphCache.size(), frameRect.GetPosition(), m_frame->GetGeometryBuffer(), c.GetARGB());
 			}
 		}
 	}
 
-	void TextComponent::RenderTraditional(const Rect& area, const Color& color, float textScale)
+	bool TextComponent::IsLayoutCached(const std::string& text, const Font& font, const Size& areaSize, const float textScale) const
+	{
+		// Hyperlink colors are parsed with the component color as default color, so they are the only part of the
+		// layout which depends on it
+		return m_layoutValid &&
+			m_layoutFont == &font &&
+			m_layoutScale == textScale &&
+			m_layoutAreaSize == areaSize &&
+			(m_parsedText.hyperlinks.empty() || m_layoutColor == m_color.GetARGB()) &&
+			m_layoutText == text;
+	}
+
+	void TextComponent::LayoutTraditional(const Rect& area, const float textScale)
 	{
 		FontPtr font = m_frame->GetFont();
 		if (!font)
@@ -339,27 +375,27 @@ namespace mmo
 			if (line.empty())
 				continue;
 
+			const TextLayout& layout = font->GetTextLayout(line, textScale);
+
 			// Calculate horizontal position based on alignment
 			float xOffset = 0.0f;
 			if (m_horzAlignment == HorizontalAlignment::Center)
 			{
-				const float lineWidth = font->GetTextWidth(line, textScale);
-				xOffset = (area.GetWidth() - lineWidth) * 0.5f;
+				xOffset = (area.GetWidth() - layout.width) * 0.5f;
 			}
 			else if (m_horzAlignment == HorizontalAlignment::Right)
 			{
-				const float lineWidth = font->GetTextWidth(line, textScale);
-				xOffset = area.GetWidth() - lineWidth;
+				xOffset = area.GetWidth() - layout.width;
 			}
 
 			// Calculate final position for this line
-			Point linePosition(
-				area.left + xOffset,
-				area.top + yOffset + lineIndex * lineHeight
-			);
+			const Point linePosition(xOffset, yOffset + lineIndex * lineHeight);
 
-			// Render the line
-			font->DrawText(line, linePosition, m_frame->GetGeometryBuffer(), textScale, color.GetARGB());
+			for (const ShapedGlyph& glyph : layout.glyphs)
+			{
+				m_glyphCache.push_back(glyph);
+				m_glyphCache.back().position += linePosition;
+			}
 		}
 	}
 
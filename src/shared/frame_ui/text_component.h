@@ -97,8 +97,11 @@ namespace mmo
 		void CacheText(const Rect& area);
 		/// Applies text wrapping to the line cache.
 		void ApplyWrapping(const Rect& frameRect);
-		/// Renders text using traditional alignment (no hyperlinks)
-		void RenderTraditional(const Rect& area, const Color& color, float textScale);
+		/// Determines whether the cached layout was made for the given text, font, area size and scale.
+		bool IsLayoutCached(const std::string& text, const Font& font, const Size& areaSize, float textScale) const;
+		/// Lays out the cached lines using traditional alignment (no hyperlinks), relative to the top left corner of
+		/// the area.
+		void LayoutTraditional(const Rect& area, float textScale);
 		/// Renders text with hyperlink support (limited alignment)
 		void RenderWithHyperlinks(const Rect& area, const Color& color, float textScale);
 
@@ -119,6 +122,17 @@ namespace mmo
 		/// Cache for parsed text including hyperlinks
 		ParsedText m_parsedText;
 
+		/// The laid out glyphs of all lines, relative to the top left corner of the area. Rendering the same text
+		///	at another position or in another color only draws these glyphs again.
+		std::vector<ShapedGlyph> m_glyphCache;
+		/// Whether the line cache, parsed text and glyph cache are valid for the layout parameters below.
+		bool m_layoutValid = false;
+		std::string m_layoutText;
+		const Font* m_layoutFont = nullptr;
+		Size m_layoutAreaSize;
+		float m_layoutScale = 0.0f;
+		argb_t m_layoutColor = 0;
+
 		std::string m_horzAlignPropertyName;
 
 		std::string m_vertAlignPropertyName;
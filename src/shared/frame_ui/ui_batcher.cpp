@@ -0,0 +1,180 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "ui_batcher.h"
+
+#include "base/macros.h"
+
+#include <algorithm>
+
+
+namespace mmo
+{
+	void UiBatcher::Begin()
+	{
+		ASSERT(!m_active);
+		m_active = true;
+
+		m_frameStart = std::chrono::steady_clock::now();
+		m_frameStats = FrameStats();
+
+		m_batchCount = 0;
+		m_firstPending = 0;
+
+		m_clipped = false;
+		m_deviceClipped = false;
+	}
+
+	void UiBatcher::Queue(const GeometryBuffer& buffer)
+	{
+		ASSERT(m_active);
+
+		const GeometryBuffer::Vertex* vertices = buffer.GetVertices();
+
+		uint32 start = 0;
+		for (const auto& [texture, count] : buffer.GetBatches())
+		{
+			if (count == 0)
+			{
+				continue;
+			}
+
+			m_frameStats.queuedBatches++;
+
+			// Merge into the last batch if it has not been drawn yet and would be drawn with the same state
+			const bool canMerge = m_batchCount > m_firstPending &&
+				m_batches[m_batchCount - 1].texture == texture &&
+				m_batches[m_batchCount - 1].clipped == m_clipped &&
+				(!m_clipped || m_batches[m_batchCount - 1].clipRect == m_clipRect);
+
+			if (!canMerge)
+			{
+				if (m_batchCount == m_batches.size())
+				{
+					m_batches.emplace_back();
+				}
+
+				Batch& batch = m_batches[m_batchCount++];
+				batch.texture = texture;
+				batch.clipped = m_clipped;
+				batch.clipRect = m_clipRect;
+				batch.sources.clear();
+				batch.vertexCount = 0;
+			}
+
+			Batch& batch = m_batches[m_batchCount - 1];
+			batch.sources.push_back({ buffer.GetVersion(), start, count, vertices + start });
+			batch.vertexCount += count;
+
+			start += count;
+		}
+	}
+
+	void UiBatcher::SetClipRect(const Rect& clipRect)
+	{
+		m_clipped = true;
+		m_clipRect = clipRect;
+	}
+
+	void UiBatcher::ResetClipRect()
+	{
+		m_clipped = false;
+	}
+
+	void UiBatcher::Flush()
+	{
+		if (m_firstPending < m_batchCount)
+		{
+			auto& gx = GraphicsDevice::Get();
+			gx.SetBlendMode(BlendMode::Alpha);
+			gx.SetVertexFormat(VertexFormat::PosColorTex1);
+
+			for (size_t i = m_firstPending; i < m_batchCount; ++i)
+			{
+				Batch& batch = m_batches[i];
+				Upload(batch);
+
+				ApplyClipRect(batch.clipped, batch.clipRect);
+				gx.BindTexture(batch.texture, ShaderType::PixelShader, 0);
+				batch.hwBuffer->Set(0);
+				gx.Draw(batch.vertexCount, 0);
+
+				m_frameStats.drawCalls++;
+			}
+
+			m_firstPending = m_batchCount;
+		}
+
+		// Whatever is drawn directly after this call expects the clip rect of the frame it belongs to
+		ApplyClipRect(m_clipped, m_clipRect);
+	}
+
+	void UiBatcher::End()
+	{
+		ASSERT(m_active);
+
+		m_clipped = false;
+		Flush();
+		m_active = false;
+
+		// Batches which were not used in this frame only hold on to vertex buffers
+		m_batches.resize(m_batchCount);
+
+		m_frameStats.cpuTimeMicroseconds = static_cast<uint64>(std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now() - m_frameStart).count());
+		m_lastFrameStats = m_frameStats;
+	}
+
+	void UiBatcher::Upload(Batch& batch)
+	{
+		if (batch.hwBuffer && batch.sources == batch.uploadedSources)
+		{
+			return;
+		}
+
+		// Grow the buffer by doubling its size, so that growing batches don't reallocate it every frame
+		size_t size = batch.hwBuffer ? batch.hwBuffer->GetVertexCount() : 64;
+		while (size < batch.vertexCount)
+		{
+			size *= 2;
+		}
+
+		if (!batch.hwBuffer || size != batch.hwBuffer->GetVertexCount())
+		{
+			batch.hwBuffer = GraphicsDevice::Get().CreateVertexBuffer(size, sizeof(GeometryBuffer::Vertex), BufferUsage::DynamicWriteOnlyDiscardable, nullptr);
+		}
+
+		auto* target = static_cast<GeometryBuffer::Vertex*>(batch.hwBuffer->Map(LockOptions::Discard));
+		for (const Source& source : batch.sources)
+		{
+			std::copy_n(source.vertices, source.count, target);
+			target += source.count;
+		}
+		batch.hwBuffer->Unmap();
+
+		batch.uploadedSources = batch.sources;
+
+		m_frameStats.uploadedBatches++;
+		m_frameStats.uploadedVertices += batch.vertexCount;
+	}
+
+	void UiBatcher::ApplyClipRect(const bool clipped, const Rect& clipRect)
+	{
+		if (clipped == m_deviceClipped && (!clipped || clipRect == m_deviceClipRect))
+		{
+			return;
+		}
+
+		auto& gx = GraphicsDevice::Get();
+		if (clipped)
+		{
+			gx.SetClipRect(clipRect.left, clipRect.top, clipRect.right - clipRect.left, clipRect.bottom - clipRect.top);
+		}
+		else
+		{
+			gx.ResetClipRect();
+		}
+
+		m_deviceClipped = clipped;
+		m_deviceClipRect = clipRect;
+	}
+}
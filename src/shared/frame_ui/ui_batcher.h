@@ -0,0 +1,128 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "geometry_buffer.h"
+#include "rect.h"
+
+#include "base/non_copyable.h"
+#include "graphics/graphics_device.h"
+
+#include <chrono>
+#include <vector>
+
+
+namespace mmo
+{
+	/// Collects the geometry of all frames rendered in a frame and draws consecutive batches which share the same
+	/// texture and clip rect with a single draw call. Every merged batch owns its own dynamic vertex buffer, which is
+	/// only uploaded again when the geometry that was merged into it changed since the last frame. As frames only
+	/// rebuild their geometry buffers when they need a redraw, unchanged regions of the ui are not uploaded again.
+	///
+	/// All frame geometry is drawn with alpha blending, so the blend mode is not part of the batch key.
+	class UiBatcher final : public NonCopyable
+	{
+	public:
+		/// Statistics of the last rendered frame.
+		struct FrameStats
+		{
+			/// Number of geometry buffer batches queued.
+			uint32 queuedBatches = 0;
+			/// Number of draw calls issued by the batcher.
+			uint32 drawCalls = 0;
+			/// Number of merged batches whose vertex buffer had to be uploaded.
+			uint32 uploadedBatches = 0;
+			/// Number of vertices uploaded.
+			uint32 uploadedVertices = 0;
+			/// Time spent between Begin and End in microseconds, including the time spent by frames to rebuild
+			/// their geometry.
+			uint64 cpuTimeMicroseconds = 0;
+		};
+
+	public:
+		UiBatcher() = default;
+
+	public:
+		/// Starts a new frame. The device clip rect is expected to be reset.
+		void Begin();
+
+		/// Queues all batches of a geometry buffer. The buffer has to stay alive and unchanged until the next call
+		/// to Flush or End. Has to be called between Begin and End, geometry queued outside of a frame is never drawn.
+		void Queue(const GeometryBuffer& buffer);
+
+		/// Sets the clip rect for all geometry queued after this call.
+		void SetClipRect(const Rect& clipRect);
+
+		/// Disables clipping for all geometry queued after this call.
+		void ResetClipRect();
+
+		/// Draws all queued geometry and applies the current clip rect to the graphics device. Has to be called
+		/// before anything is drawn to the graphics device directly while the ui is rendered, so that the draw
+		/// order is kept intact.
+		void Flush();
+
+		/// Draws all queued geometry, resets the device clip rect and finishes the frame statistics.
+		void End();
+
+		/// Determines whether a frame has been started by Begin and not been finished by End yet.
+		[[nodiscard]] bool IsActive() const { return m_active; }
+
+		/// Gets the statistics of the last frame.
+		[[nodiscard]] const FrameStats& GetFrameStats() const { return m_lastFrameStats; }
+
+	private:
+		/// A range of vertices of a geometry buffer merged into a batch.
+		struct Source
+		{
+			uint64 version;
+			uint32 start;
+			uint32 count;
+			const GeometryBuffer::Vertex* vertices;
+
+			bool operator==(const Source& other) const
+			{
+				// Versions are unique, so the vertices did not change if the version and range are the same
+				return version == other.version && start == other.start && count == other.count;
+			}
+		};
+
+		/// A merged batch. Batches are reused by their index in the frame, so a ui which did not change produces the
+		/// same batches with the same sources every frame.
+		struct Batch
+		{
+			TexturePtr texture;
+			bool clipped = false;
+			Rect clipRect;
+			/// Sources merged into this batch in the current frame.
+			std::vector<Source> sources;
+			/// Sources which are currently uploaded to the vertex buffer.
+			std::vector<Source> uploadedSources;
+			uint32 vertexCount = 0;
+			VertexBufferPtr hwBuffer;
+		};
+
+	private:
+		/// Makes sure the vertex buffer of the batch contains the vertices of its sources.
+		void Upload(Batch& batch);
+
+		/// Applies the current clip rect to the graphics device if it differs from the applied one.
+		void ApplyClipRect(bool clipped, const Rect& clipRect);
+
+	private:
+		std::vector<Batch> m_batches;
+		/// Number of batches used in the current frame.
+		size_t m_batchCount = 0;
+		/// Index of the first batch which has not been drawn yet.
+		size_t m_firstPending = 0;
+		bool m_active = false;
+
+		bool m_clipped = false;
+		Rect m_clipRect;
+		bool m_deviceClipped = false;
+		Rect m_deviceClipRect;
+
+		std::chrono::steady_clock::time_point m_frameStart;
+		FrameStats m_frameStats;
+		FrameStats m_lastFrameStats;
+	};
+}
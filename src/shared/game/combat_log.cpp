@@ -0,0 +1,137 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#include "combat_log.h"
+#include "binary_io/reader.h"
+#include "binary_io/writer.h"
+
+namespace mmo
+{
+	io::Writer& operator<<(io::Writer& writer, const CombatLogEvent& event)
+	{
+		writer
+			<< io::write<uint8>(event.type);
+
+		switch (event.type)
+		{
+		case combat_log_event::AttackerStateUpdate:
+			writer
+				<< io::write_packed_guid(event.sourceGuid)
+				<< io::write_packed_guid(event.targetGuid)
+				<< io::write_var_uint(event.flags)
+				<< io::write_var_uint(event.victimState)
+				<< io::write_var_uint(event.amount)
+				<< io::write_var_uint(event.school)
+				<< io::write_var_uint(event.absorbed)
+				<< io::write_var_uint(event.resisted)
+				<< io::write_var_uint(event.blocked);
+			break;
+		case combat_log_event::SpellDamage:
+			writer
+				<< io::write_packed_guid(event.targetGuid)
+				<< io::write_var_uint(event.spellId)
+				<< io::write_var_uint(event.amount)
+				<< io::write_var_uint(event.school)
+				<< io::write_var_uint(event.flags)
+				<< io::write_var_uint(event.blocked);
+			break;
+		case combat_log_event::NonSpellDamage:
+			writer
+				<< io::write_packed_guid(event.targetGuid)
+				<< io::write_var_uint(event.amount)
+				<< io::write_var_uint(event.flags);
+			break;
+		case combat_log_event::EnvironmentalDamage:
+			writer
+				<< io::write_packed_guid(event.targetGuid)
+				<< io::write_var_uint(event.amount)
+				<< io::write_var_uint(event.subType);
+			break;
+		case combat_log_event::PeriodicAura:
+		case combat_log_event::SpellEnergize:
+			writer
+				<< io::write_packed_guid(event.sourceGuid)
+				<< io::write_packed_guid(event.targetGuid)
+				<< io::write_var_uint(event.spellId)
+				<< io::write_var_uint(event.subType)
+				<< io::write_var_uint(event.amount);
+			break;
+		case combat_log_event::SpellHeal:
+			writer
+				<< io::write_packed_guid(event.sourceGuid)
+				<< io::write_packed_guid(event.targetGuid)
+				<< io::write_var_uint(event.spellId)
+				<< io::write_var_uint(event.amount)
+				<< io::write_var_uint(event.flags);
+			break;
+		default:
+			break;
+		}
+
+		return writer;
+	}
+
+	io::Reader& operator>>(io::Reader& reader, CombatLogEvent& event)
+	{
+		event = CombatLogEvent();
+
+		uint8 type = 0;
+		if (!(reader >> io::read<uint8>(type)))
+		{
+			return reader;
+		}
+
+		event.type = static_cast<CombatLogEventType>(type);
+
+		switch (event.type)
+		{
+		case combat_log_event::AttackerStateUpdate:
+			return reader
+				>> io::read_packed_guid(event.sourceGuid)
+				>> io::read_packed_guid(event.targetGuid)
+				>> io::read_var_uint(event.flags)
+				>> io::read_var_uint(event.victimState)
+				>> io::read_var_uint(event.amount)
+				>> io::read_var_uint(event.school)
+				>> io::read_var_uint(event.absorbed)
+				>> io::read_var_uint(event.resisted)
+				>> io::read_var_uint(event.blocked);
+		case combat_log_event::SpellDamage:
+			return reader
+				>> io::read_packed_guid(event.targetGuid)
+				>> io::read_var_uint(event.spellId)
+				>> io::read_var_uint(event.amount)
+				>> io::read_var_uint(event.school)
+				>> io::read_var_uint(event.flags)
+				>> io::read_var_uint(event.blocked);
+		case combat_log_event::NonSpellDamage:
+			return reader
+				>> io::read_packed_guid(event.targetGuid)
+				>> io::read_var_uint(event.amount)
+				>> io::read_var_uint(event.flags);
+		case combat_log_event::EnvironmentalDamage:
+			return reader
+				>> io::read_packed_guid(event.targetGuid)
+				>> io::read_var_uint(event.amount)
+				>> io::read_var_uint(event.subType);
+		case combat_log_event::PeriodicAura:
+		case combat_log_event::SpellEnergize:
+			return reader
+				>> io::read_packed_guid(event.sourceGuid)
+				>> io::read_packed_guid(event.targetGuid)
+				>> io::read_var_uint(event.spellId)
+				>> io::read_var_uint(event.subType)
+				>> io::read_var_uint(event.amount);
+		case combat_log_event::SpellHeal:
+			return reader
+				>> io::read_packed_guid(event.sourceGuid)
+				>> io::read_packed_guid(event.targetGuid)
+				>> io::read_var_uint(event.spellId)
+				>> io::read_var_uint(event.amount)
+				>> io::read_var_uint(event.flags);
+		default:
+			// Unknown events can't be skipped since their size is unknown
+			reader.setFailure();
+			return reader;
+		}
+	}
+}
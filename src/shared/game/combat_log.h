@@ -0,0 +1,84 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/typedefs.h"
+
+namespace io
+{
+	class Reader;
+	class Writer;
+}
+
+namespace mmo
+{
+	/// Enumerates the events which are sent in a CombatLog packet.
+	namespace combat_log_event
+	{
+		enum Type : uint8
+		{
+			/// Melee white damage, misses, dodges and parries. Uses source, target, flags (hit info), victimState,
+			///	amount, school, absorbed, resisted and blocked.
+			AttackerStateUpdate,
+
+			/// Spell damage dealt by the receiving player. Uses target, spellId, amount, school, flags (damage flags)
+			///	and blocked.
+			SpellDamage,
+
+			/// Non-spell damage dealt by the receiving player. Uses target, amount and flags (damage flags).
+			NonSpellDamage,
+
+			/// Environmental damage taken by the receiving player. Uses target, amount and subType (environmental
+			///	damage type).
+			EnvironmentalDamage,
+
+			/// A periodic aura tick. Uses source (caster), target, spellId, subType (aura type) and amount.
+			PeriodicAura,
+
+			/// A direct heal. Uses source (caster), target, spellId, amount and flags (1 if critical).
+			SpellHeal,
+
+			/// A direct power gain. Uses source (caster), target, spellId, subType (power type) and amount.
+			SpellEnergize,
+
+			Count_
+		};
+	}
+
+	typedef combat_log_event::Type CombatLogEventType;
+
+	/// A single combat log event. Only the fields used by the event type are serialized, all of them as variable
+	///	length integers, so that a typical event only takes a few bytes.
+	struct CombatLogEvent final
+	{
+		CombatLogEventType type = combat_log_event::AttackerStateUpdate;
+
+		uint64 sourceGuid = 0;
+
+		uint64 targetGuid = 0;
+
+		uint32 spellId = 0;
+
+		uint32 amount = 0;
+
+		uint32 school = 0;
+
+		/// Hit info, damage flags or critical flag, depending on the type.
+		uint32 flags = 0;
+
+		uint32 victimState = 0;
+
+		uint32 absorbed = 0;
+
+		uint32 resisted = 0;
+
+		uint32 blocked = 0;
+
+		/// Aura type, power type or environmental damage type, depending on the type.
+		uint32 subType = 0;
+	};
+
+	io::Writer& operator<<(io::Writer& writer, const CombatLogEvent& event);
+
+	io::Reader& operator>>(io::Reader& reader, CombatLogEvent& event);
+}
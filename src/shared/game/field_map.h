@@ -2,7 +2,9 @@
 
 #pragma once
 
-#include <bitset>
+#include <algorithm>
+#include <bit>
+#include <limits>
 #include <type_traits>
 #include <vector>
 
@@ -13,7 +15,8 @@
 
 namespace mmo
 {
-	/// A map for managing flexible fields.
+	/// A map for managing flexible fields. Change flags are stored as one bit per field, so the map only costs
+	/// memory for the fields it was initialized with.
 	template<class TFieldBase, std::enable_if_t<std::is_unsigned_v<TFieldBase>>* = nullptr>
 	class FieldMap final
 	{
@@ -35,7 +38,7 @@ namespace mmo
 			ASSERT(numFields > 0);
 			ASSERT(numFields <= MaxFieldCount);
 			
-			m_changes.reset();
+			m_changes.assign((numFields + BitsPerWord - 1) / BitsPerWord, 0);
 			m_data.resize(numFields, 0);
 		}
 	
@@ -80,17 +83,21 @@ namespace mmo
 		}
 
 		/// Determines whether the given field is marked as changed.
-		[[nodiscard]] bool IsFieldMarkedAsChanged(const FieldIndexType index) const { return m_changes[index]; }
+		[[nodiscard]] bool IsFieldMarkedAsChanged(const FieldIndexType index) const
+		{
+			// Fields behind the end of the map are never changed
+			return index < m_data.size() && ((m_changes[index / BitsPerWord] >> (index % BitsPerWord)) & 1) != 0;
+		}
 
 		[[nodiscard]] size_t GetFieldCount() const { return m_data.size(); }
 
 		int32 GetFirstChangedField() const
 		{
-			for (uint32 i = 0; i < m_data.size(); ++i)
+			for (size_t word = 0; word < m_changes.size(); ++word)
 			{
-				if (m_changes[i])
+				if (m_changes[word] != 0)
 				{
-					return i;
+					return static_cast<int32>(word * BitsPerWord + std::countr_zero(m_changes[word]));
 				}
 			}
 
@@ -99,11 +106,11 @@ namespace mmo
 
 		int32 GetLastChangedField() const
 		{
-			for (int32 i = m_data.size() - 1; i >= 0; --i)
+			for (size_t word = m_changes.size(); word-- > 0; )
 			{
-				if (m_changes[i])
+				if (m_changes[word] != 0)
 				{
-					return i;
+					return static_cast<int32>(word * BitsPerWord + BitsPerWord - 1 - std::countl_zero(m_changes[word]));
 				}
 			}
 
@@ -111,18 +118,34 @@ namespace mmo
 		}
 
 		/// Marks all fields as changed.
-		void MarkAllAsChanged() { m_changes.set(); }
+		void MarkAllAsChanged()
+		{
+			std::fill(m_changes.begin(), m_changes.end(), ~ChangeWord(0));
+
+			// Keep the bits behind the last field cleared
+			if (const size_t usedBits = m_data.size() % BitsPerWord; usedBits != 0)
+			{
+				m_changes.back() = (ChangeWord(1) << usedBits) - 1;
+			}
+		}
 
 		/// Marks all fields as changed.
-		void MarkAllAsUnchanged() { m_changes.reset(); }
+		void MarkAllAsUnchanged() { MarkAsUnchanged(); }
 
 		/// Marks a specific field as changed.
-		void MarkAsChanged(const FieldIndexType index) { m_changes.set(index); }
+		void MarkAsChanged(const FieldIndexType index)
+		{
+			ASSERT(index < m_data.size());
+			m_changes[index / BitsPerWord] |= ChangeWord(1) << (index % BitsPerWord);
+		}
 		
 		/// Marks all fields as unchanged.
-		void MarkAsUnchanged() { m_changes.reset(); }
+		void MarkAsUnchanged() { std::fill(m_changes.begin(), m_changes.end(), 0); }
 
-		bool HasChanges() const { return m_changes.any(); }
+		bool HasChanges() const
+		{
+			return std::any_of(m_changes.begin(), m_changes.end(), [](const ChangeWord word) { return word != 0; });
+		}
 
 	public:
 		/// Serializes the whole field map, regardless of change flags.
@@ -144,7 +167,7 @@ namespace mmo
 				{
 					if (i + j < m_data.size())
 					{
-						if (m_changes[i + j]) flag |= 1 << j;
+						if (IsFieldMarkedAsChanged(static_cast<FieldIndexType>(i + j))) flag |= 1 << j;
 					}
 				}
 
@@ -153,7 +176,7 @@ namespace mmo
 
 			for (size_t i = 0; i < m_data.size(); ++i)
 			{
-				if (m_changes[i])
+				if (IsFieldMarkedAsChanged(static_cast<FieldIndexType>(i)))
 				{
 					w << io::write<TFieldBase>(m_data[i]);
 				}
@@ -166,7 +189,7 @@ namespace mmo
 		///	@param r The reader to use.
 		io::Reader& DeserializeComplete(io::Reader& r)
 		{
-			m_changes.reset();
+			MarkAsUnchanged();
 			return r
 				>> io::read_range(m_data);
 		}
@@ -175,7 +198,7 @@ namespace mmo
 		///	@param r The reader to use.
 		io::Reader& DeserializeChanges(io::Reader& r)
 		{
-			m_changes.reset();
+			MarkAsUnchanged();
 
 			for (size_t i = 0; i < m_data.size(); i += 8)
 			{
@@ -187,9 +210,9 @@ namespace mmo
 
 				for (size_t j = 0; j < 8; ++j)
 				{
-					if (flag & (1 << j))
+					if ((flag & (1 << j)) && i + j < m_data.size())
 					{
-						m_changes.set(j + i);
+						MarkAsChanged(static_cast<FieldIndexType>(i + j));
 					}
 				}
 			}
@@ -209,7 +232,11 @@ namespace mmo
 		}
 	
 	private:
-		std::bitset<MaxFieldCount> m_changes{};
+		typedef uint64 ChangeWord;
+
+		static constexpr size_t BitsPerWord = std::numeric_limits<ChangeWord>::digits;
+
+		std::vector<ChangeWord> m_changes{};
 		std::vector<TFieldBase> m_data{};
 	};
 
@@ -11,14 +11,20 @@
 
 namespace mmo
 {
-	std::map<uint64, std::shared_ptr<GameObjectC>> ObjectMgr::ms_objectyByGuid;
+	GuidIndex ObjectMgr::ms_objectIndex{ 2048 };
+	std::vector<ObjectMgr::ObjectSlot> ObjectMgr::ms_objects;
+	std::vector<std::shared_ptr<GameUnitC>> ObjectMgr::ms_units;
+	std::vector<std::shared_ptr<GamePlayerC>> ObjectMgr::ms_players;
+	std::vector<std::shared_ptr<GameItemC>> ObjectMgr::ms_items;
+	std::vector<std::shared_ptr<GameWorldObjectC>> ObjectMgr::ms_worldObjects;
+	bool ObjectMgr::ms_updatingObjects = false;
 	uint64 ObjectMgr::ms_activePlayerGuid = 0;
 	uint64 ObjectMgr::ms_selectedObjectGuid = 0;
 	uint64 ObjectMgr::ms_hoveredObjectGuid = 0;
 	const proto_client::Project* ObjectMgr::ms_project = nullptr;
 
-	std::map<uint32, uint32> ObjectMgr::ms_itemCount;
-	std::map<uint64, scoped_connection> ObjectMgr::ms_itemConnections;
+	std::unordered_map<uint32, uint32> ObjectMgr::ms_itemCount;
+	std::unordered_map<uint64, ObjectMgr::CountedItem> ObjectMgr::ms_countedItems;
 	PartyInfo* ObjectMgr::ms_partyInfo = nullptr;
 
 	FontPtr ObjectMgr::ms_unitNameFont = nullptr;
@@ -27,11 +33,9 @@ namespace mmo
 	void ObjectMgr::Initialize(const proto_client::Project& project, PartyInfo& partyInfo)
 	{
 		ms_project = &project;
-		ms_objectyByGuid.clear();
-		ms_activePlayerGuid = 0;
+		RemoveAllObjects();
 		ms_selectedObjectGuid = 0;
 		ms_hoveredObjectGuid = 0;
-		ms_itemCount.clear();
 		ms_partyInfo = &partyInfo;
 	}
 
@@ -45,71 +49,98 @@ namespace mmo
 
 	void ObjectMgr::UpdateObjects(float deltaTime)
 	{
-		for (const auto& [guid, object] : ms_objectyByGuid)
+		// Objects which are added during the update are appended and updated as well. Removing objects would move
+		// the last object into the gap, which is then skipped, so this is not allowed while updating.
+		ms_updatingObjects = true;
+		for (size_t i = 0; i < ms_objects.size(); ++i)
 		{
-			object->Update(deltaTime);
+			ms_objects[i].object->Update(deltaTime);
 		}
+		ms_updatingObjects = false;
 	}
 
 	void ObjectMgr::AddObject(std::shared_ptr<GameObjectC> object)
 	{
 		ASSERT(object);
-		ASSERT(!ms_objectyByGuid.contains(object->GetGuid()));
-		ms_objectyByGuid[object->GetGuid()] = object;
+		ASSERT(!ms_objectIndex.Contains(object->GetGuid()));
+
+		const uint64 guid = object->GetGuid();
+		ms_objectIndex.Set(guid, static_cast<uint32>(ms_objects.size()));
 
-		if (object->GetTypeId() == ObjectTypeId::Item ||
-			object->GetTypeId() == ObjectTypeId::Container)
+		ObjectSlot& slot = ms_objects.emplace_back();
+		slot.object = std::move(object);
+		slot.categoryIndices.fill(GuidIndex::NotFound);
+
+		const GameObjectC& added = *slot.object;
+		if (added.IsUnit())
+		{
+			AddToCategory(ms_units, UnitCategory, slot);
+		}
+		if (added.IsPlayer())
 		{
+			AddToCategory(ms_players, PlayerCategory, slot);
+		}
+		if (added.IsItem())
+		{
+			AddToCategory(ms_items, ItemCategory, slot);
+
 			// Initial items count for active player (TODO: This seems wrong!)
 			if (ms_activePlayerGuid == 0 ||
-				object->Get<uint64>(object_fields::ItemOwner) == ms_activePlayerGuid)
+				added.Get<uint64>(object_fields::ItemOwner) == ms_activePlayerGuid)
 			{
-				const uint32 itemId = object->Get<uint32>(object_fields::Entry);
-				const uint32 stackCount = object->Get<uint32>(object_fields::StackCount);
+				CountedItem& counted = ms_countedItems[guid];
+				counted.entry = added.Get<uint32>(object_fields::Entry);
+				counted.stackCount = added.Get<uint32>(object_fields::StackCount);
+				counted.stackCountChanged = slot.object->RegisterMirrorHandler(object_fields::StackCount, 1, &ObjectMgr::OnItemStackCountChanged);
 
-				if (ms_itemCount.contains(itemId))
-				{
-					ms_itemCount[itemId] += stackCount;
-				}
-				else
-				{
-					ms_itemCount[itemId] = stackCount;
-				}
-
-				ms_itemConnections[object->GetGuid()] = object->RegisterMirrorHandler(object_fields::StackCount, 1, &ObjectMgr::OnItemStackCountChanged);
+				ms_itemCount[counted.entry] += counted.stackCount;
 			}
 		}
+		else if (added.IsWorldObject() && dynamic_cast<const GameWorldObjectC*>(&added))
+		{
+			AddToCategory(ms_worldObjects, WorldObjectCategory, slot);
+		}
 	}
 
 	void ObjectMgr::RemoveObject(const uint64 guid)
 	{
-		const auto it = ms_objectyByGuid.find(guid);
-		if (it != ms_objectyByGuid.end())
+		ASSERT(!ms_updatingObjects);
+
+		const uint32 index = ms_objectIndex.Find(guid);
+		if (index == GuidIndex::NotFound)
 		{
-			if (it->second->GetTypeId() == ObjectTypeId::Item ||
-				it->second->GetTypeId() == ObjectTypeId::Container)
-			{
-				if (it->second->Get<uint64>(object_fields::ItemOwner) == ms_activePlayerGuid)
-				{
-					const uint32 itemId = it->second->Get<uint32>(object_fields::Entry);
-					const uint32 stackCount = it->second->Get<uint32>(object_fields::StackCount);
-					
-					ASSERT(ms_itemCount.contains(itemId));
-					ms_itemCount[itemId] -= stackCount;
+			return;
+		}
 
-					// Remove the connection for this specific item instance
-					ms_itemConnections.erase(guid);
+		if (const auto countedIt = ms_countedItems.find(guid); countedIt != ms_countedItems.end())
+		{
+			const auto countIt = ms_itemCount.find(countedIt->second.entry);
+			ASSERT(countIt != ms_itemCount.end());
+			countIt->second -= countedIt->second.stackCount;
 
-					// If this was the last item of this type, remove the item count entry
-					if (ms_itemCount[itemId] == 0)
-					{
-						ms_itemCount.erase(itemId);
-					}
-				}
+			// If this was the last item of this type, remove the item count entry
+			if (countIt->second == 0)
+			{
+				ms_itemCount.erase(countIt);
 			}
 
-			ms_objectyByGuid.erase(it);
+			ms_countedItems.erase(countedIt);
+		}
+
+		RemoveFromCategory(ms_units, UnitCategory, ms_objects[index]);
+		RemoveFromCategory(ms_players, PlayerCategory, ms_objects[index]);
+		RemoveFromCategory(ms_items, ItemCategory, ms_objects[index]);
+		RemoveFromCategory(ms_worldObjects, WorldObjectCategory, ms_objects[index]);
+
+		// Fill the gap with the last object, so that all objects stay in one contiguous array
+		if (index + 1 != ms_objects.size())
+		{
+			ms_objects[index] = std::move(ms_objects.back());
+			ms_objectIndex.Set(ms_objects[index].object->GetGuid(), index);
 		}
+
+		ms_objects.pop_back();
+		ms_objectIndex.Erase(guid);
 	}
 
 	std::shared_ptr<UnitHandle> ObjectMgr::GetUnitHandleByName(const std::string& unitName)
@@ -177,6 +208,12 @@ namespace mmo
 
 	bool ObjectMgr::FindItem(uint32 entryId, uint8& out_bag, uint8& out_slot, uint64& out_guid)
 	{
+		// The item count covers all items of the active player, so there is nothing to search for without any
+		if (GetItemCount(entryId) == 0)
+		{
+			return false;
+		}
+
 		const auto player = GetActivePlayer();
 		if (!player)
 		{
@@ -231,9 +268,16 @@ namespace mmo
 
 	void ObjectMgr::RemoveAllObjects()
 	{
+		ASSERT(!ms_updatingObjects);
+
 		ms_itemCount.clear();
-		ms_itemConnections.clear();
-		ms_objectyByGuid.clear();
+		ms_countedItems.clear();
+		ms_units.clear();
+		ms_players.clear();
+		ms_items.clear();
+		ms_worldObjects.clear();
+		ms_objects.clear();
+		ms_objectIndex.Clear();
 		ms_activePlayerGuid = 0;
 	}
 
@@ -298,12 +342,8 @@ namespace mmo
 
 	uint32 ObjectMgr::GetItemCount(const uint32 itemId)
 	{
-		if (ms_itemCount.contains(itemId))
-		{
-			return ms_itemCount[itemId];
-		}
-
-		return 0;
+		const auto it = ms_itemCount.find(itemId);
+		return it != ms_itemCount.end() ? it->second : 0;
 	}
 
 	std::shared_ptr<GamePlayerC> ObjectMgr::GetActivePlayer()
@@ -331,29 +371,18 @@ namespace mmo
 		const auto item = Get<GameItemC>(itemGuid);
 		ASSERT(item);
 
-		if (item->Get<uint64>(object_fields::ItemOwner) != ms_activePlayerGuid)
+		const auto countedIt = ms_countedItems.find(itemGuid);
+		if (countedIt == ms_countedItems.end())
 		{
 			return;
 		}
 
-		// Reset counter
-		const uint32 affectedEntry = item->Get<uint32>(object_fields::Entry);
-		ms_itemCount[item->Get<uint32>(object_fields::Entry)] = 0;
-
-		ForEachObject<GameItemC>([affectedEntry](const std::shared_ptr<GameItemC>& object)
-			{
-				if (object->Get<uint64>(object_fields::ItemOwner) != ms_activePlayerGuid)
-				{
-					return;
-				}
-
-				// This is a different entry, skip it
-				if (object->Get<uint32>(object_fields::Entry) != affectedEntry)
-				{
-					return;
-				}
+		// Only apply the difference to the total, instead of counting all items of this entry again
+		CountedItem& counted = countedIt->second;
+		const uint32 stackCount = item->Get<uint32>(object_fields::StackCount);
 
-				ms_itemCount[object->Get<uint32>(object_fields::Entry)] += object->Get<uint32>(object_fields::StackCount);
-			});
+		uint32& total = ms_itemCount[counted.entry];
+		total = total - counted.stackCount + stackCount;
+		counted.stackCount = stackCount;
 	}
 }
@@ -1,11 +1,18 @@
 #pragma once
 
 #include "base/typedefs.h"
+#include "base/guid_index.h"
 
+#include <array>
 #include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
 
+#include "game_client/game_bag_c.h"
 #include "game_client/game_object_c.h"
 #include "game_client/game_player_c.h"
+#include "game_client/game_world_object_c_base.h"
 
 namespace mmo
 {
@@ -32,19 +39,41 @@ namespace mmo
 		template<typename TObject>
 		static std::shared_ptr<TObject> Get(uint64 guid)
 		{
-			if (guid == 0)
+			const uint32 index = ms_objectIndex.Find(guid);
+			if (index == GuidIndex::NotFound)
 			{
 				return nullptr;
 			}
 
-			if (const auto it = ms_objectyByGuid.find(guid); it != ms_objectyByGuid.end())
+			// The common object types are identified by their type id, which is much cheaper than a dynamic cast
+			const std::shared_ptr<GameObjectC>& object = ms_objects[index].object;
+			if constexpr (std::is_same_v<TObject, GameObjectC>)
 			{
-				return std::dynamic_pointer_cast<TObject>(it->second);
+				return object;
+			}
+			else if constexpr (std::is_same_v<TObject, GameUnitC>)
+			{
+				return object->IsUnit() ? std::static_pointer_cast<GameUnitC>(object) : nullptr;
+			}
+			else if constexpr (std::is_same_v<TObject, GamePlayerC>)
+			{
+				return object->IsPlayer() ? std::static_pointer_cast<GamePlayerC>(object) : nullptr;
+			}
+			else if constexpr (std::is_same_v<TObject, GameItemC>)
+			{
+				return object->IsItem() ? std::static_pointer_cast<GameItemC>(object) : nullptr;
+			}
+			else if constexpr (std::is_same_v<TObject, GameBagC>)
+			{
+				return object->IsContainer() ? std::static_pointer_cast<GameBagC>(object) : nullptr;
+			}
+			else
+			{
+				return std::dynamic_pointer_cast<TObject>(object);
 			}
-
-			return nullptr;
 		}
 
+		/// Updates all objects. Objects may be added but not removed by their update.
 		static void UpdateObjects(float deltaTime);
 
 		static void AddObject(std::shared_ptr<GameObjectC> object);
@@ -79,18 +108,15 @@ namespace mmo
 
 		static bool FindItem(uint32 entryId, uint8& out_bag, uint8& out_slot, uint64& out_guid);
 
+		/// Gets the number of known objects.
+		static size_t GetObjectCount() { return ms_objects.size(); }
+
 		template<typename C>
 		static void ForEachUnit(const C& callback)
 		{
-			for (const auto& [guid, object] : ms_objectyByGuid)
+			for (size_t i = 0; i < ms_units.size(); ++i)
 			{
-				if (!object->IsUnit())
-				{
-					continue;
-				}
-
-				GameUnitC& unit = object->AsUnit();
-				callback(unit);
+				callback(*ms_units[i]);
 			}
 		}
 
@@ -102,24 +128,126 @@ namespace mmo
 		template<typename U, typename T>
 		static void ForEachObject(T callback)
 		{
-			for (const auto& [guid, object] : ms_objectyByGuid)
+			if constexpr (std::is_same_v<U, GameObjectC>)
+			{
+				for (size_t i = 0; i < ms_objects.size(); ++i)
+				{
+					callback(ms_objects[i].object);
+				}
+			}
+			else if constexpr (std::is_same_v<U, GameUnitC>)
+			{
+				ForEachInCategory(ms_units, callback);
+			}
+			else if constexpr (std::is_same_v<U, GamePlayerC>)
 			{
-				if (std::shared_ptr<U> unit = std::dynamic_pointer_cast<U>(object))
+				ForEachInCategory(ms_players, callback);
+			}
+			else if constexpr (std::is_same_v<U, GameItemC>)
+			{
+				ForEachInCategory(ms_items, callback);
+			}
+			else if constexpr (std::is_same_v<U, GameWorldObjectC>)
+			{
+				ForEachInCategory(ms_worldObjects, callback);
+			}
+			else
+			{
+				for (size_t i = 0; i < ms_objects.size(); ++i)
 				{
-					callback(unit);
+					if (std::shared_ptr<U> object = std::dynamic_pointer_cast<U>(ms_objects[i].object))
+					{
+						callback(object);
+					}
 				}
 			}
 		}
 
 	private:
-		static std::map<uint64, std::shared_ptr<GameObjectC>> ms_objectyByGuid;
+		/// Object types which are kept in their own dense array, so that iterating them doesn't visit or cast
+		/// unrelated objects.
+		enum ObjectCategory
+		{
+			UnitCategory,
+			PlayerCategory,
+			ItemCategory,
+			WorldObjectCategory,
+
+			CategoryCount
+		};
+
+		struct ObjectSlot
+		{
+			std::shared_ptr<GameObjectC> object;
+
+			/// Position of the object in the array of each category, or GuidIndex::NotFound.
+			std::array<uint32, CategoryCount> categoryIndices;
+		};
+
+		/// An item of the active player which is counted by GetItemCount.
+		struct CountedItem
+		{
+			uint32 entry = 0;
+			uint32 stackCount = 0;
+			scoped_connection stackCountChanged;
+		};
+
+		template<typename T, typename C>
+		static void ForEachInCategory(const std::vector<std::shared_ptr<T>>& objects, C& callback)
+		{
+			for (size_t i = 0; i < objects.size(); ++i)
+			{
+				callback(objects[i]);
+			}
+		}
+
+		template<typename T>
+		static void AddToCategory(std::vector<std::shared_ptr<T>>& objects, ObjectCategory category, ObjectSlot& slot)
+		{
+			slot.categoryIndices[category] = static_cast<uint32>(objects.size());
+			objects.push_back(std::static_pointer_cast<T>(slot.object));
+		}
+
+		template<typename T>
+		static void RemoveFromCategory(std::vector<std::shared_ptr<T>>& objects, ObjectCategory category, const ObjectSlot& slot)
+		{
+			const uint32 index = slot.categoryIndices[category];
+			if (index == GuidIndex::NotFound)
+			{
+				return;
+			}
+
+			// Fill the gap with the last object of the category
+			if (index + 1 != objects.size())
+			{
+				objects[index] = std::move(objects.back());
+				ms_objects[ms_objectIndex.Find(objects[index]->GetGuid())].categoryIndices[category] = index;
+			}
+
+			objects.pop_back();
+		}
+
+	private:
+		/// Maps guids to positions in ms_objects.
+		static GuidIndex ms_objectIndex;
+		static std::vector<ObjectSlot> ms_objects;
+
+		static std::vector<std::shared_ptr<GameUnitC>> ms_units;
+		static std::vector<std::shared_ptr<GamePlayerC>> ms_players;
+		static std::vector<std::shared_ptr<GameItemC>> ms_items;
+		static std::vector<std::shared_ptr<GameWorldObjectC>> ms_worldObjects;
+
+		/// Set while UpdateObjects runs, during which objects must not be removed.
+		static bool ms_updatingObjects;
+
 		static uint64 ms_activePlayerGuid;
 		static uint64 ms_selectedObjectGuid;
 		static uint64 ms_hoveredObjectGuid;
 		static const proto_client::Project* ms_project;
 
-		static std::map<uint32, uint32> ms_itemCount;
-		static std::map<uint64, scoped_connection> ms_itemConnections;
+		/// Total stack count of the active player's items by item entry.
+		static std::unordered_map<uint32, uint32> ms_itemCount;
+		static std::unordered_map<uint64, CountedItem> ms_countedItems;
 
 		static PartyInfo* ms_partyInfo;
 
@@ -8,7 +8,6 @@
 #include "base/non_copyable.h"
 #include "base/macros.h"
 #include "network/connection.h"
-#include "network/send_sink.h"
 
 #include "asio.hpp"
 
@@ -45,7 +44,7 @@ namespace mmo
 
 		public:
 			template<class F>
-			void sendSinglePacket(F generator)
+			void sendSinglePacket(F generator, bool autoFlush = true)
 			{
 				{
 					io::StringSink sink(getSendBuffer());
@@ -58,7 +57,10 @@ namespace mmo
 					m_crypt.EncryptSend(reinterpret_cast<uint8*>(&m_sendBuffer[bufferPos]), game::Crypt::CryptedSendLength);
 				}
 				
-				flush();
+				if (autoFlush)
+				{
+					flush();
+				}
 			}
 			
 			inline bool IsConnected() const 
@@ -381,6 +383,5 @@ namespace mmo
 
 		typedef mmo::game::EncryptedConnection<Protocol> Connection;
 		typedef mmo::IConnectionListener<Protocol> IConnectionListener;
-		typedef mmo::SendSink<Protocol> SendSink;
 	}
 }
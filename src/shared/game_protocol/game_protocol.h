@@ -318,6 +318,11 @@ namespace mmo
 				/// declining a revival offered by another player's revive spell.
 				ReviveResponse,
 
+				/// Sent by the client to query multiple templates of the same kind at once. The realm answers
+				/// with one query result packet per id. Payload: uint8 type (see db_query_type), uint8 count,
+				/// then count packed uint64 ids.
+				DbQueryBatch,
+
 				/// Counter constant
 				Count_,
 			};
@@ -343,7 +348,8 @@ namespace mmo
 				/// Entering the world failed.
 				EnterWorldFailed = 0x06,
 
-				/// Sent right after successful auth; contains disabled race and class IDs.
+				/// Sent right after successful auth; contains disabled race and class IDs and the uint64 version
+				/// of the realm's template data, which clients use to keep their query caches.
 				RealmConfig = 0x07,
 
 				/// [PROXY] Update game objects.
@@ -612,11 +618,34 @@ namespace mmo
 				/// uint8 classLevel. The currently active class is the one in object_fields::Class.
 				KnownClasses,
 
+				/// All combat log events of one world tick which are relevant to the client (damage, heals, power
+				///	gains and periodic aura ticks). Payload: var_uint eventCount, then eventCount CombatLogEvents
+				///	(see game/combat_log.h).
+				CombatLog,
+
 				/// Counter constant
 				Count_,
 			};
 		}
 
+		/// Identifies which kind of template is queried in a DbQueryBatch packet.
+		namespace db_query_type
+		{
+			enum Type
+			{
+				/// Answered with CreatureQueryResult packets.
+				Creature,
+				/// Answered with ItemQueryResult packets.
+				Item,
+				/// Answered with QuestQueryResult packets.
+				Quest,
+				/// Answered with ObjectQueryResult packets.
+				Object,
+
+				Count_
+			};
+		}
+
 		/// Identifies which kind of character points were reset in a CharacterPointsReset packet.
 		namespace character_points_reset_type
 		{
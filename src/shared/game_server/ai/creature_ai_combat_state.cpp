@@ -553,14 +553,14 @@ namespace mmo
 		return true; // Need to initiate or update movement
 	}
 
-	Vector3 CreatureAICombatState::PredictTargetPosition(const GameUnitS& target) const
+	Vector3 CreatureAICombatState::PredictTargetPosition(GameUnitS& target) const
 	{
 		Vector3 predictedPosition = target.GetPosition();
 		
-		// If target is moving, predict where they'll be
-		const auto& targetMover = target.GetMover();
-		if (targetMover.IsMoving())
+		// If target is moving, predict where they'll be. A target without mover is not moving.
+		if (target.HasMover() && target.GetMover().IsMoving())
 		{
+			const auto& targetMover = target.GetMover();
 			const Vector3 currentPos = target.GetPosition();
 			const Vector3 targetDestination = targetMover.GetTarget();
 			const Vector3 direction = (targetDestination - currentPos).NormalizedCopy();
@@ -1026,7 +1026,7 @@ namespace mmo
 
 			m_onMoveTargetChanged = controlled.GetMover().targetChanged.connect([this]()
 			{
-				const auto& controlled = GetControlled();
+				auto& controlled = GetControlled();
 				
 				// Don't interfere with movement while casting
 				if (m_isCasting)
@@ -1256,7 +1256,7 @@ namespace mmo
 		const auto currentPower = controlled.GetPower();
 		// Use the mover's interpolated position so range checks are accurate while
 		// the NPC is in motion — m_movementInfo.position is only updated every 500 ms.
-		const float distanceToTarget = (controlled.GetMover().GetCurrentLocation() - target.GetPosition()).GetSquaredLength();
+		const float distanceToTarget = (controlled.GetExactPosition() - target.GetPosition()).GetSquaredLength();
 		
 		const CreatureSpell* bestSpell = nullptr;
 		uint32 highestPriority = 0;
@@ -312,7 +312,7 @@ namespace mmo
 		 * @param target The unit to predict position for.
 		 * @return Predicted position of the target.
 		 */
-		Vector3 PredictTargetPosition(const GameUnitS& target) const;
+		Vector3 PredictTargetPosition(GameUnitS& target) const;
 
 		/**
 		 * @brief Handles movement failure and stuck detection.
@@ -9,6 +9,7 @@
 #include "game_server/player_group.h"
 #include "game_server/inventory_types.h"
 #include "game_server/world/tile_subscriber.h"
+#include "game_server/world/world_instance_manager.h"
 #include "binary_io/vector_sink.h"
 #include "game/experience.h"
 #include "log/default_log_levels.h"
@@ -185,31 +186,15 @@ namespace mmo
 						(static_cast<float>(character.second->GetLevel()) / static_cast<float>(sumLevel)));
 			}
 
-			// Resolve the loot tables assigned to this creature. Loot tables act as reusable modules and
-			// multiple can be assigned to a single creature. For backwards compatibility, a creature that
-			// still uses the legacy single 'unitlootentry' field is treated as having a single loot table.
-			const auto& unitLoot = controlled.GetProject().unitLoot;
-			std::vector<const proto::LootEntry*> lootEntries;
-			if (entry.unitlootentries_size() > 0)
+			// Loot tables act as reusable modules and multiple can be assigned to a single creature. They
+			// are resolved and compiled when the world server is set up. Nothing is rolled here: the loot
+			// is generated when it is opened for the first time.
+			ASSERT(controlled.GetWorldInstance());
+			const LootTableCache::TableList lootTables = controlled.GetWorldInstance()->GetManager().GetLootTables().GetCreatureLoot(entry);
+			if (!lootTables.empty())
 			{
-				lootEntries.reserve(entry.unitlootentries_size());
-				for (int i = 0; i < entry.unitlootentries_size(); ++i)
-				{
-					if (const auto* loot = unitLoot.getById(entry.unitlootentries(i)))
-					{
-						lootEntries.push_back(loot);
-					}
-				}
-			}
-			else if (const auto* legacyLoot = unitLoot.getById(entry.unitlootentry()))
-			{
-				lootEntries.push_back(legacyLoot);
-			}
-
-			if (!lootEntries.empty())
-			{
-				// Generate loot
 				std::vector<std::weak_ptr<GamePlayerS>> weakRecipients;
+				weakRecipients.reserve(lootRecipients.size());
 				for (const auto& recipient : lootRecipients)
 				{
 					weakRecipients.push_back(recipient.second);
@@ -235,13 +220,13 @@ namespace mmo
 					}
 				}
 
-				ASSERT(controlled.GetWorldInstance());
-				auto loot = std::make_unique<LootInstance>(
+				auto loot = MakePooled<LootInstance>(
+					controlled.GetObjectPool(),
 					controlled.GetProject().items,
 					controlled.GetWorldInstance()->GetConditionMgr(),
 					controlled.GetGuid(),
-					lootEntries,
-					weakRecipients,
+					lootTables,
+					std::move(weakRecipients),
 					groupLootMethod,
 					lootMasterGuid);
 
@@ -23,7 +23,6 @@ namespace mmo
 		GetControlled().SetMovementMode(unit_movement_mode::Walk);
 
 		m_connections += m_waitCountdown.ended.connect(*this, &CreatureAIIdleState::OnWaitCountdownExpired);
-		m_connections += GetAI().GetControlled().GetMover().targetReached.connect(*this, &CreatureAIIdleState::OnTargetReached);
 		m_connections += GetAI().GetControlled().threatened.connect([ai = &GetAI()]<typename T0, typename T1>(T0&& instigator, T1&& threat)
 		{
 			ai->OnThreatened(std::forward<T0>(instigator), std::forward<T1>(threat));
@@ -170,9 +169,10 @@ namespace mmo
 
 		m_waitCountdown.Cancel();
 		m_connections.disconnect();
+		m_onTargetReached.disconnect();
 
 		// Save the world position so the reset state can return here instead of spawn.
-		GetAI().SavePatrolReturnPosition(GetControlled().GetMover().GetCurrentLocation());
+		GetAI().SavePatrolReturnPosition(GetControlled().GetExactPosition());
 
 		// Determine which waypoint the creature should resume from.
 		// m_chainProgressIndex tracks which waypoint in the chain the creature is heading
@@ -203,7 +203,7 @@ namespace mmo
 
 		if (GetControlled().GetMovementType() == creature_movement::None)
 		{
-			GetControlled().GetMover().StopMovement();
+			StopIdleMovement();
 			return;
 		}
 
@@ -211,6 +211,8 @@ namespace mmo
 		{
 			if (GetControlled().HasPatrolWaypoints())
 			{
+				WatchTargetReached();
+
 				if (GetAI().HasSavedPatrolWaypointIndex())
 				{
 					// Restore the chain start recorded when we left idle so the creature
@@ -226,7 +228,7 @@ namespace mmo
 			}
 			else
 			{
-				GetControlled().GetMover().StopMovement();
+				StopIdleMovement();
 			}
 
 			return;
@@ -234,10 +236,28 @@ namespace mmo
 
 		if (GetControlled().GetMovementType() == creature_movement::Random)
 		{
+			WatchTargetReached();
 			OnTargetReached();
 		}
 	}
 
+	void CreatureAIIdleState::WatchTargetReached()
+	{
+		// Creatures which don't move on their own never need a mover while idle, so it is only created here
+		if (!m_onTargetReached.connected())
+		{
+			m_onTargetReached = GetControlled().GetMover().targetReached.connect(*this, &CreatureAIIdleState::OnTargetReached);
+		}
+	}
+
+	void CreatureAIIdleState::StopIdleMovement()
+	{
+		if (GetControlled().HasMover())
+		{
+			GetControlled().GetMover().StopMovement();
+		}
+	}
+
 	void CreatureAIIdleState::OnControlledMoved()
 	{
 		if (m_unitWatcher)
@@ -54,6 +54,12 @@ namespace mmo
 		/// @param waitTimeMs Delay before the next idle movement step.
 		void StartWait(uint32 waitTimeMs);
 
+		/// @brief Connects to the mover's target reached signal, creating the mover if needed.
+		void WatchTargetReached();
+
+		/// @brief Stops idle movement without creating a mover.
+		void StopIdleMovement();
+
 		void OnWaitCountdownExpired();
 
 		void OnTargetReached();
@@ -65,6 +71,7 @@ namespace mmo
 		Countdown m_waitCountdown;
 
 		scoped_connection_container m_connections;
+		scoped_connection m_onTargetReached;
 
 		std::unique_ptr<UnitWatcher> m_unitWatcher;
 		size_t m_nextPatrolWaypointIndex = 0;
@@ -7,100 +7,254 @@
 namespace mmo
 {
 	ConditionMgr::ConditionMgr(const proto::ConditionManager& data)
-		: m_data(data)
 	{
-		DLOG("Condition Manager set up - loaded " << m_data.count() << " conditions!");
+		Node always;
+		m_nodes.push_back(always);
+
+		Node never;
+		never.check = Check::Never;
+		m_nodes.push_back(never);
+
+		std::unordered_set<uint32> compiling;
+		for (const auto& condition : data.getTemplates().entry())
+		{
+			Compile(data, condition.id(), compiling);
+		}
+
+		DLOG("Condition Manager set up - compiled " << data.count() << " conditions into " << m_nodes.size() << " nodes!");
 	}
 
-	bool ConditionMgr::PlayerMeetsCondition(GamePlayerS& player, uint32 conditionId) const
+	bool ConditionMgr::PlayerMeetsCondition(GamePlayerS& player, const uint32 conditionId) const
 	{
-        auto* cond = m_data.getById(conditionId);
-        if (!cond)
-        {
+		const auto it = m_nodeIndexById.find(conditionId);
+		if (it == m_nodeIndexById.end())
+		{
 			ELOG("Tried to validate non existent condition " << conditionId);
-            return false;
-        }
-
-        // Evaluate sub-conditions first, if any
-        bool subResult = true; // or false if logicOperator == OR
-        if (!cond->subconditionids().empty())
-        {
-            switch (cond->logicoperator())
-            {
-            case proto::Condition_LogicOperator_AND:
-            {
-                for (const auto subId : cond->subconditionids())
-                {
-                    if (!PlayerMeetsCondition(player, subId))
-                    {
-                        subResult = false;
-                        break;
-                    }
-                }
-                break;
-            }
-            case proto::Condition_LogicOperator_OR:
-            {
-                subResult = false;
-                for (const auto subId : cond->subconditionids())
-                {
-                    if (PlayerMeetsCondition(player, subId))
-                    {
-                        subResult = true;
-                        break;
-                    }
-                }
-                break;
-            }
-            default:
-                // If logicOperator=NONE but we have subConditionIds,
-                // decide how you want to handle that. 
-                break;
-            }
-        }
-
-        // If it's a group condition, subResult is your final result
-        // *unless* you also want to combine it with the main type check:
-        if (cond->conditiontype() == proto::Condition_ConditionType_NONE_TYPE)
-        {
-            // It's just a container for subconditions
-            return subResult;
-        }
-
-        // Evaluate the "main" condition
-        bool selfResult = false;
-        switch (cond->conditiontype())
-        {
-        case proto::Condition_ConditionType_CLASS_CHECK:
-            // e.g. param1 = required class ID
-            ASSERT(player.GetClassEntry());
-            selfResult = (player.GetClassEntry()->id() == cond->param1());
-            break;
-
-        case proto::Condition_ConditionType_LEVEL_CHECK:
-            // e.g. param1 = minLevel, param2 = maxLevel
-        {
-            const uint32 lvl = player.GetLevel();
-            const uint32 minLvl = cond->param1();
-            uint32 maxLvl = cond->param2();
-            if (maxLvl == 0)
-            {
-                maxLvl = 255;
-            }
-            selfResult = (lvl >= minLvl && lvl <= maxLvl);
-        }
-        break;
+			return false;
+		}
+
+		return Evaluate(player, it->second);
+	}
+
+	uint32 ConditionMgr::Compile(const proto::ConditionManager& data, const uint32 conditionId, std::unordered_set<uint32>& compiling)
+	{
+		if (const auto it = m_nodeIndexById.find(conditionId); it != m_nodeIndexById.end())
+		{
+			return it->second;
+		}
+
+		const auto* cond = data.getById(conditionId);
+		if (!cond)
+		{
+			ELOG("Condition references non existent sub-condition " << conditionId);
+			return NeverNode;
+		}
+
+		if (!compiling.insert(conditionId).second)
+		{
+			ELOG("Condition " << conditionId << " references itself through its sub-conditions, the reference is never met");
+			return NeverNode;
+		}
+
+		Node node;
+		switch (cond->conditiontype())
+		{
+		case proto::Condition_ConditionType_NONE_TYPE:
+			break;
+
+		case proto::Condition_ConditionType_CLASS_CHECK:
+			node.check = Check::Class;
+			node.param1 = cond->param1();
+			break;
+
+		case proto::Condition_ConditionType_LEVEL_CHECK:
+			node.check = Check::Level;
+			node.param1 = cond->param1();
+			node.param2 = (cond->param2() == 0) ? 255 : cond->param2();
+			if (node.param1 > node.param2)
+			{
+				node.check = Check::Never;
+			}
+			break;
 
 		case proto::Condition_ConditionType_QUEST_CHECK:
-			// e.g. param1 = required quest ID, param2 = QuestStatus
-			selfResult = player.GetQuestStatus(cond->param1()) == cond->param2();
+			node.check = Check::Quest;
+			node.param1 = cond->param1();
+			node.param2 = cond->param2();
+			node.isStatic = false;
 			break;
 
-        default:
-            // no known condition type
-            break;
-        }
+		default:
+			// No known condition type
+			node.check = Check::Never;
+			break;
+		}
+
+		// Sub-conditions are only combined with an explicit operator
+		std::vector<uint32> children;
+		bool subResultKnown = false;
+		bool subResult = true;
+		const proto::Condition_LogicOperator logic = cond->logicoperator();
+		if (!cond->subconditionids().empty() && (logic == proto::Condition_LogicOperator_AND || logic == proto::Condition_LogicOperator_OR))
+		{
+			node.logic = (logic == proto::Condition_LogicOperator_AND) ? Logic::And : Logic::Or;
+
+			// Constant sub-conditions either decide the group or can be skipped
+			const uint32 deciding = (node.logic == Logic::And) ? NeverNode : AlwaysNode;
+			const uint32 neutral = (node.logic == Logic::And) ? AlwaysNode : NeverNode;
+			for (const auto subId : cond->subconditionids())
+			{
+				const uint32 child = Compile(data, subId, compiling);
+				if (child == deciding)
+				{
+					subResultKnown = true;
+					subResult = (node.logic == Logic::Or);
+					break;
+				}
+
+				if (child != neutral)
+				{
+					children.push_back(child);
+				}
+			}
+
+			if (!subResultKnown && children.empty())
+			{
+				// Every sub-condition was neutral
+				subResultKnown = true;
+				subResult = (node.logic == Logic::And);
+			}
+
+			if (subResultKnown)
+			{
+				node.logic = Logic::None;
+				children.clear();
+			}
+		}
+
+		compiling.erase(conditionId);
+
+		uint32 index;
+		if (!subResult || node.check == Check::Never)
+		{
+			index = NeverNode;
+		}
+		else if (node.check == Check::None && node.logic == Logic::None)
+		{
+			index = AlwaysNode;
+		}
+		else if (node.check == Check::None && children.size() == 1)
+		{
+			// A group with a single remaining sub-condition
+			index = children.front();
+		}
+		else
+		{
+			index = static_cast<uint32>(m_nodes.size());
+		}
+
+		if (index == m_nodes.size())
+		{
+			node.firstChild = static_cast<uint32>(m_children.size());
+			node.childCount = static_cast<uint32>(children.size());
+			for (const uint32 child : children)
+			{
+				node.isStatic = node.isStatic && m_nodes[child].isStatic;
+				m_children.push_back(child);
+			}
+
+			m_nodes.push_back(node);
+		}
+
+		m_nodeIndexById[conditionId] = index;
+		return index;
+	}
+
+	bool ConditionMgr::Evaluate(GamePlayerS& player, const uint32 index) const
+	{
+		const Node& node = m_nodes[index];
+		if (node.logic == Logic::None)
+		{
+			return EvaluateCheck(player, node);
+		}
+
+		// Only groups are memoized, a single check is as cheap as the lookup
+		ConditionResultCache* cache = nullptr;
+		if (node.isStatic)
+		{
+			cache = &player.GetConditionResultCache();
+			cache->Validate(*this, player.GetClassEntry(), player.GetLevel());
+			if (const ConditionResultCache::Result cached = cache->Get(index); cached != ConditionResultCache::Unknown)
+			{
+				return cached == ConditionResultCache::True;
+			}
+		}
+
+		const bool result = EvaluateChildren(player, node) && EvaluateCheck(player, node);
+		if (cache)
+		{
+			cache->Set(index, result);
+		}
+
+		return result;
+	}
+
+	bool ConditionMgr::EvaluateChildren(GamePlayerS& player, const Node& node) const
+	{
+		const uint32* child = m_children.data() + node.firstChild;
+		const uint32* end = child + node.childCount;
+
+		if (node.logic == Logic::And)
+		{
+			for (; child != end; ++child)
+			{
+				if (!Evaluate(player, *child))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		if (node.logic == Logic::Or)
+		{
+			for (; child != end; ++child)
+			{
+				if (Evaluate(player, *child))
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		return true;
+	}
+
+	bool ConditionMgr::EvaluateCheck(GamePlayerS& player, const Node& node)
+	{
+		switch (node.check)
+		{
+		case Check::None:
+			return true;
+
+		case Check::Class:
+			ASSERT(player.GetClassEntry());
+			return player.GetClassEntry()->id() == node.param1;
+
+		case Check::Level:
+		{
+			const uint32 level = player.GetLevel();
+			return level >= node.param1 && level <= node.param2;
+		}
+
+		case Check::Quest:
+			return player.GetQuestStatus(node.param1) == node.param2;
 
-        return subResult && selfResult;
+		default:
+			return false;
+		}
 	}
 }
@@ -5,14 +5,27 @@
 #include "base/non_copyable.h"
 #include "proto_data/project.h"
 
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 namespace mmo
 {
 	class GamePlayerS;
 
 	/// Manages game conditions and offers methods to check whether a given condition is fulfilled by a player.
+	///	All conditions are compiled once on construction into a flat list of nodes: sub-conditions are referenced by
+	///	index instead of being looked up by id, parameters are validated and conditions with a constant result (for
+	///	example an AND group with a condition that can never be met) are folded away. Results of groups which only
+	///	depend on the class and level of a player are memoized in the player's ConditionResultCache.
+	///
+	///	A sub-condition reference which closes a cycle is compiled as never fulfilled. Which reference closes the
+	///	cycle depends on the condition that is compiled first, so a condition can be unfulfilled even though walking
+	///	the condition data would have short-circuited before reaching the cycle.
 	class ConditionMgr final : public NonCopyable
 	{
 	public:
+		/// Compiles all conditions of the given data. Conditions added to the data afterwards are unknown.
 		explicit ConditionMgr(const proto::ConditionManager& data);
 
 	public:
@@ -22,7 +35,76 @@ namespace mmo
 		/// @returns true if condition is fulfilled, false if not or condition does not exist.
 		bool PlayerMeetsCondition(GamePlayerS& player, uint32 conditionId) const;
 
+		/// Gets the number of distinct compiled condition nodes, including the constant true and false nodes.
+		[[nodiscard]] size_t GetNodeCount() const { return m_nodes.size(); }
+
+	private:
+		enum class Check : uint8
+		{
+			/// No own check, the result is the result of the sub-conditions.
+			None,
+
+			/// Never fulfilled.
+			Never,
+
+			/// param1 is the class id.
+			Class,
+
+			/// param1 is the minimum and param2 the maximum level.
+			Level,
+
+			/// param1 is the quest id and param2 the required quest status.
+			Quest
+		};
+
+		enum class Logic : uint8
+		{
+			None,
+			And,
+			Or
+		};
+
+		struct Node
+		{
+			Check check = Check::None;
+
+			Logic logic = Logic::None;
+
+			/// Whether the result only depends on the class and level of the player.
+			bool isStatic = true;
+
+			uint32 param1 = 0;
+
+			uint32 param2 = 0;
+
+			/// Range of the sub-condition node indices in m_children.
+			uint32 firstChild = 0;
+
+			uint32 childCount = 0;
+		};
+
+		/// Index of the node which is always fulfilled.
+		static constexpr uint32 AlwaysNode = 0;
+
+		/// Index of the node which is never fulfilled.
+		static constexpr uint32 NeverNode = 1;
+
+		/// Compiles a condition and its sub-conditions, if not already done.
+		/// @returns The index of the node to evaluate for the condition.
+		uint32 Compile(const proto::ConditionManager& data, uint32 conditionId, std::unordered_set<uint32>& compiling);
+
+		bool Evaluate(GamePlayerS& player, uint32 index) const;
+
+		bool EvaluateChildren(GamePlayerS& player, const Node& node) const;
+
+		static bool EvaluateCheck(GamePlayerS& player, const Node& node);
+
 	private:
-		const proto::ConditionManager& m_data;
+		std::vector<Node> m_nodes;
+
+		std::vector<uint32> m_children;
+
+		/// Node index per condition id. Conditions may share a node, for example when they were folded to a constant.
+		std::unordered_map<uint32, uint32> m_nodeIndexById;
 	};
 }
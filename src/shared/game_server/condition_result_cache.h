@@ -0,0 +1,71 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/typedefs.h"
+
+#include <vector>
+
+namespace mmo
+{
+	namespace proto
+	{
+		class ClassEntry;
+	}
+
+	class ConditionMgr;
+
+	/// Remembers the results of compiled conditions which only depend on the class and level of a player. Each player
+	///	owns one. The results are dropped as soon as they are validated against another condition manager or another
+	///	class or level than the one they were evaluated for, so no explicit invalidation is needed on level ups or
+	///	class changes.
+	class ConditionResultCache final
+	{
+	public:
+		enum Result : uint8
+		{
+			Unknown,
+			False,
+			True
+		};
+
+	public:
+		/// Drops all cached results if they don't belong to the given condition manager, class and level.
+		void Validate(const ConditionMgr& owner, const proto::ClassEntry* classEntry, const uint32 level)
+		{
+			if (&owner != m_owner || classEntry != m_classEntry || level != m_level)
+			{
+				m_owner = &owner;
+				m_classEntry = classEntry;
+				m_level = level;
+				m_results.clear();
+			}
+		}
+
+		/// Gets the cached result of a compiled condition. Only valid after Validate has been called.
+		[[nodiscard]] Result Get(const uint32 index) const
+		{
+			return index < m_results.size() ? m_results[index] : Unknown;
+		}
+
+		void Set(const uint32 index, const bool result)
+		{
+			if (index >= m_results.size())
+			{
+				m_results.resize(index + 1, Unknown);
+			}
+
+			m_results[index] = result ? True : False;
+		}
+
+	private:
+		const ConditionMgr* m_owner = nullptr;
+
+		const proto::ClassEntry* m_classEntry = nullptr;
+
+		uint32 m_level = 0;
+
+		/// Results indexed by compiled condition.
+		std::vector<Result> m_results;
+	};
+}
@@ -6,6 +6,7 @@
 #include "game_server/objects/game_item_s.h"
 #include "game_server/objects/game_player_s.h"
 #include "inventory_repository.h"
+#include "inventory_unit_of_work.h"
 #include "base/linear_set.h"
 #include "base/utilities.h"
 #include "binary_io/reader.h"
@@ -33,7 +34,7 @@ namespace mmo
 	Inventory::Inventory(GamePlayerS &owner)
 		: m_owner(owner), m_freeSlots(player_inventory_pack_slots::End - player_inventory_pack_slots::Start) // Default slot count with only a backpack
 		  ,
-		  m_nextBuyBackSlot(player_buy_back_slots::Start), m_repository(nullptr), m_isDirty(false), m_validator(std::make_unique<ItemValidator>(owner, owner.GetProject())), m_slotManager(std::make_unique<SlotManager>(*this)), m_commandFactory(std::make_unique<InventoryCommandFactory>(*this, *this, *this)), m_commandLogger(std::make_unique<InventoryCommandLogger>()), m_itemFactory(std::make_unique<ItemFactory>(*this)), m_equipmentManager(std::make_unique<EquipmentManager>(*this)), m_bagManager(std::make_unique<BagManager>(*this))
+		  m_nextBuyBackSlot(player_buy_back_slots::Start), m_repository(nullptr), m_isDirty(false), m_hasSavedState(false), m_saveGeneration(0), m_validator(std::make_unique<ItemValidator>(owner, owner.GetProject())), m_slotManager(std::make_unique<SlotManager>(*this)), m_commandFactory(std::make_unique<InventoryCommandFactory>(*this, *this, *this)), m_commandLogger(std::make_unique<InventoryCommandLogger>()), m_itemFactory(std::make_unique<ItemFactory>(*this)), m_equipmentManager(std::make_unique<EquipmentManager>(*this)), m_bagManager(std::make_unique<BagManager>(*this))
 	{
 		// Connect to item change signals to automatically mark inventory as dirty
 		m_inventoryConnections += itemInstanceCreated.connect([this](std::shared_ptr<GameItemS>, uint16)
@@ -1054,6 +1055,10 @@ InventoryChangeFailure Inventory::IsValidSlot(uint16 slot, const proto::ItemEntr
 					bag->ClearFieldChanges();
 				}
 			}
+
+			// The loaded items are what the realm has stored, so the first save only has to write what changed since
+			m_savedItems = BuildSavedItems();
+			m_hasSavedState = true;
 		}
 	}
 
@@ -1604,10 +1609,120 @@ InventoryChangeFailure Inventory::IsValidSlot(uint16 slot, const proto::ItemEntr
 			return true;
 		}
 
-		ILOG("Saving inventory to repository (dirty flag set)");
-		// Convert current inventory state to InventoryItemData
-		std::vector<InventoryItemData> items;
-		items.reserve(m_itemsBySlot.size());
+		std::map<uint16, InventoryItemData> items = BuildSavedItems();
+		const uint64 characterId = m_owner.GetGuid();
+
+		if (!m_hasSavedState)
+		{
+			ILOG("Saving all " << items.size() << " inventory items to repository");
+
+			std::vector<InventoryItemData> allItems;
+			allItems.reserve(items.size());
+			for (const auto &[slot, data] : items)
+			{
+				allItems.push_back(data);
+			}
+
+			// Use transaction for atomicity
+			if (!m_repository->BeginTransaction())
+			{
+				ELOG("Failed to begin inventory transaction");
+				return false;
+			}
+
+			// Replaces all items, so items which were sold or destroyed are removed as well
+			if (!m_repository->SaveAllItems(characterId, allItems))
+			{
+				m_repository->Rollback();
+				ELOG("Failed to save inventory items");
+				return false;
+			}
+
+			if (!m_repository->Commit())
+			{
+				ELOG("Failed to commit inventory transaction");
+				return false;
+			}
+		}
+		else
+		{
+			// Only write the slots which differ from the last save
+			InventoryUnitOfWork unitOfWork(*m_repository);
+			size_t savedCount = 0, deletedCount = 0;
+
+			for (const auto &[slot, data] : items)
+			{
+				const auto saved = m_savedItems.find(slot);
+				if (saved != m_savedItems.end() && saved->second == data)
+				{
+					continue;
+				}
+
+				auto save = [this, characterId, data]()
+				{
+					if (!m_repository->SaveItem(characterId, data))
+					{
+						throw std::runtime_error("Failed to save inventory item");
+					}
+				};
+
+				if (saved == m_savedItems.end())
+				{
+					unitOfWork.RegisterNew(std::move(save));
+				}
+				else
+				{
+					unitOfWork.RegisterDirty(std::move(save));
+				}
+
+				++savedCount;
+			}
+
+			for (const auto &[slot, data] : m_savedItems)
+			{
+				if (items.contains(slot))
+				{
+					continue;
+				}
+
+				unitOfWork.RegisterDeleted([this, characterId, slot]()
+				{
+					if (!m_repository->DeleteItem(characterId, slot))
+					{
+						throw std::runtime_error("Failed to delete inventory item");
+					}
+				});
+
+				++deletedCount;
+			}
+
+			DLOG("Saving inventory changes to repository: " << savedCount << " items changed, " << deletedCount << " removed");
+
+			if (unitOfWork.HasChanges() && !unitOfWork.Commit())
+			{
+				ELOG("Failed to save inventory changes");
+				return false;
+			}
+		}
+
+		m_savedItems = std::move(items);
+		m_hasSavedState = true;
+		++m_saveGeneration;
+
+		// Clear dirty flag
+		m_isDirty = false;
+		return true;
+	}
+
+	void Inventory::RequestFullSave() noexcept
+	{
+		m_hasSavedState = false;
+		m_isDirty = true;
+	}
+
+	std::map<uint16, InventoryItemData> Inventory::BuildSavedItems() const
+	{
+		std::map<uint16, InventoryItemData> items;
 
 		for (const auto &[slot, item] : m_itemsBySlot)
 		{
@@ -1617,7 +1732,7 @@ InventoryChangeFailure Inventory::IsValidSlot(uint16 slot, const proto::ItemEntr
 				continue;
 			}
 
-			InventoryItemData data;
+			InventoryItemData &data = items[slot];
 			data.entry = item->GetEntry().id();
 			data.slot = slot;
 			data.stackCount = static_cast<uint16>(item->Get<int32>(object_fields::StackCount));
@@ -1627,41 +1742,9 @@ InventoryChangeFailure Inventory::IsValidSlot(uint16 slot, const proto::ItemEntr
 			data.randomPropertyIndex = 0; // TODO: Implement if needed
 			data.randomSuffixIndex = 0;	  // TODO: Implement if needed
 			data.itemFlags = item->Get<uint32>(object_fields::ItemFlags);
-
-			items.push_back(data);
 		}
 
-		ILOG("Prepared " << items.size() << " items to save (filtered from " << m_itemsBySlot.size() << " total slots)");
-
-		// Use transaction for atomicity
-		if (!m_repository->BeginTransaction())
-		{
-			ELOG("Failed to begin inventory transaction");
-			return false;
-		}
-
-		// Save all items (Realm Server will delete-then-insert for clean state)
-		const bool success = m_repository->SaveAllItems(m_owner.GetGuid(), items);
-		if (success)
-		{
-			// Commit transaction
-			if (!m_repository->Commit())
-			{
-				ELOG("Failed to commit inventory transaction");
-				return false;
-			}
-
-			// Clear dirty flag
-			m_isDirty = false;
-			return true;
-		}
-
-		// Rollback on failure
-		m_repository->Rollback();
-
-		ELOG("Failed to save inventory items");
-
-		return false;
+		return items;
 	}
 
 	void Inventory::MarkDirty() noexcept
@@ -20,6 +20,7 @@
 #include "i_equipment_manager_context.h"
 #include "i_bag_manager_context.h"
 #include "inventory_types.h"
+#include "inventory_repository.h"
 
 #include <memory>
 #include <map>
@@ -229,18 +230,29 @@ namespace mmo
 		void SetRepository(IInventoryRepository *repository) noexcept;
 
 		/// Saves current inventory state to the repository.
-		/// Uses a transaction to ensure atomicity.
+		/// Uses a transaction to ensure atomicity. Only slots which changed or were emptied since the last save are
+		/// written, unless there is no saved state to compare with, in which case all items are replaced.
 		/// @return True if save succeeded, false otherwise.
 		bool SaveToRepository();
 
+		/// Makes the next save replace all items in the repository instead of writing only the changed slots. Used
+		/// when the persisted state is unknown, for example after the realm failed to apply a save.
+		void RequestFullSave() noexcept;
+
 		/// Checks if inventory has unsaved changes.
 		/// @return True if inventory needs saving.
 		bool IsDirty() const noexcept;
 
+		/// Gets the number of saves which have been committed to the repository.
+		uint32 GetSaveGeneration() const noexcept { return m_saveGeneration; }
+
 	private:
 		/// Marks inventory as dirty (needs saving).
 		void MarkDirty() noexcept;
 
+		/// Builds the persisted state of all items, by absolute slot. Buyback slots are not persisted.
+		std::map<uint16, InventoryItemData> BuildSavedItems() const;
+
 	public:
 		// IAddItemCommandContext / IRemoveItemCommandContext / ISwapItemsCommandContext implementations
 		// Note: AddItemToSlot and GetItemAtSlot already exist in the class, we just mark them as override
@@ -327,6 +339,16 @@ namespace mmo
 		/// Tracks whether inventory has unsaved changes.
 		bool m_isDirty;
 
+		/// Items as of the last committed save, by absolute slot. Saves compare against it to find the slots which
+		/// are dirty or were emptied.
+		std::map<uint16, InventoryItemData> m_savedItems;
+
+		/// Whether m_savedItems matches the repository. If not, the next save replaces all items.
+		bool m_hasSavedState;
+
+		/// Number of committed saves.
+		uint32 m_saveGeneration;
+
 		/// Command infrastructure for extensible operations
 		std::unique_ptr<ItemValidator> m_validator;
 		std::unique_ptr<SlotManager> m_slotManager;
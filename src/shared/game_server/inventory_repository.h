@@ -37,6 +37,9 @@ namespace mmo
             : entry(0), slot(0), stackCount(1), creator(0), contained(0), durability(0), randomPropertyIndex(0), randomSuffixIndex(0), itemFlags(0)
         {
         }
+
+        /** @brief Used to find the slots which changed since the last save. */
+        bool operator==(const InventoryItemData &other) const noexcept = default;
     };
 
     /**
@@ -66,7 +69,7 @@ namespace mmo
         virtual std::vector<InventoryItemData> LoadItems(uint64 characterId) = 0;
 
         /**
-         * @brief Saves a single item.
+         * @brief Saves a single item, replacing the item stored in the same slot.
          * @param characterId The character's database ID.
          * @param item The item to save.
          * @return True if save succeeded, false otherwise.
@@ -74,7 +77,10 @@ namespace mmo
         virtual bool SaveItem(uint64 characterId, const InventoryItemData &item) = 0;
 
         /**
-         * @brief Saves all items for a character.
+         * @brief Replaces all items of a character.
+         *
+         * Items of the character which are not part of the given items are removed.
+         *
          * @param characterId The character's database ID.
          * @param items All items to save.
          * @return True if save succeeded, false otherwise.
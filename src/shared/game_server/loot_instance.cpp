@@ -37,7 +37,7 @@ namespace mmo
 		
 		if (entry)
 		{
-			GenerateItemsFromEntry(*entry, lootRecipients);
+			GenerateItemsFromTable(LootTable(*entry), lootRecipients);
 		}
 
 		// Generate gold
@@ -76,80 +76,88 @@ namespace mmo
 				continue;
 			}
 
-			GenerateItemsFromEntry(*entry, lootRecipients);
-
-			std::uniform_int_distribution<uint32> goldDistribution(entry->minmoney(), entry->maxmoney());
-			totalGold += goldDistribution(randomGenerator);
+			const LootTable table(*entry);
+			GenerateItemsFromTable(table, lootRecipients);
+			totalGold += table.RollGold(randomGenerator);
 		}
 
 		m_gold = totalGold;
 	}
 
-	void LootInstance::GenerateItemsFromEntry(const proto::LootEntry& entry, const std::vector<std::weak_ptr<GamePlayerS>>& lootRecipients)
+	LootInstance::LootInstance(const proto::ItemManager& items, const ConditionMgr& conditionMgr, const uint64 lootGuid,
+		const LootTableCache::TableList tables,
+		std::vector<std::weak_ptr<GamePlayerS>> lootRecipients,
+		const LootMethod lootMethod, const uint64 lootMasterGuid)
+		: m_itemManager(items)
+		, m_conditionMgr(conditionMgr)
+		, m_lootGuid(lootGuid)
+		, m_gold(0)
+		, m_lootMethod(lootMethod)
+		, m_lootMasterGuid(lootMasterGuid)
+		, m_pendingTables(tables)
+		, m_pendingRecipients(std::move(lootRecipients))
 	{
-		for (int i = 0; i < entry.groups_size(); ++i)
+		m_recipients.reserve(m_pendingRecipients.size());
+		for (const auto& character : m_pendingRecipients)
 		{
-			const auto& group = entry.groups(i);
-
-			std::uniform_real_distribution<float> lootDistribution(0.0f, 100.0f);
-			float groupRoll = lootDistribution(randomGenerator);
-
-			std::vector<const proto::LootDefinition*> equalChanced;
-			std::vector<const proto::LootDefinition*> nonEqualChanced;
-			for (int i = 0; i < group.definitions_size(); ++i)
+			if (const auto strongChar = character.lock())
 			{
-				const auto& def = group.definitions(i);
+				m_recipients.push_back(strongChar->GetGuid());
+			}
+		}
+	}
 
-				// Is quest item?
-				if (def.condition() != 0)
-				{
-					bool skipItem = true;
-					for (const auto& weakPlayer : lootRecipients)
-					{
-						if (auto strongPlayer = weakPlayer.lock())
-						{
-							if (m_conditionMgr.PlayerMeetsCondition(*strongPlayer, def.condition()))
-							{
-								// At least one player meets the condition - do not skip the item
-								skipItem = false;
-								break;
-							}
-						}
-					}
+	void LootInstance::Generate()
+	{
+		if (IsGenerated())
+		{
+			return;
+		}
 
-					// Skip this item if no eligible player meets the condition at all
-					if (skipItem)
-					{
-						continue;
-					}
-				}
+		// Roll each assigned loot table independently and combine the results, summing up the gold
+		// contributed by every loot table.
+		uint32 totalGold = 0;
+		for (const LootTable* table : m_pendingTables)
+		{
+			GenerateItemsFromTable(*table, m_pendingRecipients);
+			totalGold += table->RollGold(randomGenerator);
+		}
 
-				if (def.dropchance() == 0.0f)
-				{
-					equalChanced.push_back(&def);
-					continue;
-				}
+		m_gold = totalGold;
+		m_pendingTables = {};
+		m_pendingRecipients.clear();
 
-				if (def.dropchance() > 0.0f &&
-					def.dropchance() >= groupRoll)
+		if (m_groupRollsPending)
+		{
+			m_groupRollsPending = false;
+			SetupGroupRollItems(m_pendingRollPlayers);
+			m_pendingRollPlayers.clear();
+		}
+	}
+
+	void LootInstance::GenerateItemsFromTable(const LootTable& table, const std::vector<std::weak_ptr<GamePlayerS>>& lootRecipients)
+	{
+		// Quest items only drop if at least one eligible player meets their condition
+		const auto isEligible = [this, &lootRecipients](const proto::LootDefinition& def)
+		{
+			for (const auto& weakPlayer : lootRecipients)
+			{
+				if (auto strongPlayer = weakPlayer.lock())
 				{
-					nonEqualChanced.push_back(&def);
+					if (m_conditionMgr.PlayerMeetsCondition(*strongPlayer, def.condition()))
+					{
+						return true;
+					}
 				}
 			}
 
-			if (nonEqualChanced.empty() && !equalChanced.empty())
-			{
-				std::uniform_int_distribution<uint32> equalDistribution(0, equalChanced.size() - 1);
-				uint32 index = equalDistribution(randomGenerator);
-				AddLootItem(*equalChanced[index]);
-			}
-			else if (!nonEqualChanced.empty())
-			{
-				std::uniform_int_distribution<uint32> nonEqualDistribution(0, nonEqualChanced.size() - 1);
-				uint32 index = nonEqualDistribution(randomGenerator);
-				AddLootItem(*nonEqualChanced[index]);
-			}
-		}
+			return false;
+		};
+
+		table.Roll(randomGenerator, isEligible, [this](const proto::LootDefinition& def)
+		{
+			AddLootItem(def);
+		});
 	}
 
 	bool LootInstance::IsEmpty() const
@@ -291,6 +299,13 @@ namespace mmo
 			return;
 		}
 
+		if (!IsGenerated())
+		{
+			m_pendingRollPlayers = nearbyPlayers;
+			m_groupRollsPending = true;
+			return;
+		}
+
 		for (uint8 slot = 0; slot < m_items.size(); ++slot)
 		{
 			auto& item = m_items[slot];
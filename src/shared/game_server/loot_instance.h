@@ -11,6 +11,7 @@
 #include <set>
 
 #include "condition_mgr.h"
+#include "loot_table.h"
 #include "proto_data/project.h"
 #include "game/group.h"
 #include "game/item.h"
@@ -151,7 +152,31 @@ namespace mmo
 			LootMethod lootMethod = loot_method::FreeForAll,
 			uint64 lootMasterGuid = 0);
 
+		/// Initializes a new instance of the loot instance from compiled loot tables. Items and gold are not rolled
+		/// before Generate is called, which should be done when the loot is opened for the first time. This way
+		/// nothing is rolled for loot nobody looks at. Quest item conditions are checked by Generate, so only
+		/// recipients who are still online at that time can make quest items drop.
+		/// @param items The item manager used to look up item templates.
+		/// @param conditionMgr The condition manager used to evaluate quest item conditions.
+		/// @param lootGuid The unique GUID of the loot source object.
+		/// @param tables The compiled loot tables defining possible drops. Have to outlive this instance.
+		/// @param lootRecipients The list of eligible loot recipients.
+		/// @param lootMethod The loot distribution method to enforce. Defaults to FreeForAll.
+		/// @param lootMasterGuid The GUID of the loot master (only meaningful for MasterLoot). Defaults to 0.
+		explicit LootInstance(const proto::ItemManager& items, const ConditionMgr& conditionMgr, uint64 lootGuid,
+			LootTableCache::TableList tables,
+			std::vector<std::weak_ptr<GamePlayerS>> lootRecipients,
+			LootMethod lootMethod = loot_method::FreeForAll,
+			uint64 lootMasterGuid = 0);
+
 	public:
+		/// Rolls the items and gold of the loot tables, if not already done. Instances which were not created from
+		/// compiled loot tables are always generated.
+		void Generate();
+
+		/// Determines whether the items and gold of this instance have been rolled.
+		[[nodiscard]] bool IsGenerated() const noexcept { return m_pendingTables.empty(); }
+
 		/// Returns the id of this loot instance.
 		[[nodiscard]] uint64 GetLootGuid() const { return m_lootGuid; }
 
@@ -209,7 +234,8 @@ namespace mmo
 		/// Gets the loot quality threshold used by this loot instance.
 		[[nodiscard]] uint8 GetLootThreshold() const noexcept { return m_lootThreshold; }
 
-		/// Marks items at or above the quality threshold as requiring a group roll.
+		/// Marks items at or above the quality threshold as requiring a group roll. If the loot has not been generated
+		/// yet, this is done as soon as it is, so the rolls only start when the loot is opened for the first time.
 		/// @param nearbyPlayers The nearby eligible players who may vote on the roll.
 		void SetupGroupRollItems(const std::set<uint64>& nearbyPlayers);
 
@@ -245,10 +271,10 @@ namespace mmo
 
 		void AddLootItem(const proto::LootDefinition& def);
 
-		/// Rolls a single loot entry's groups and adds the resulting items to this instance.
-		/// @param entry The loot entry to roll.
+		/// Rolls a single loot table's groups and adds the resulting items to this instance.
+		/// @param table The loot table to roll.
 		/// @param lootRecipients The eligible loot recipients (used to evaluate item conditions).
-		void GenerateItemsFromEntry(const proto::LootEntry& entry, const std::vector<std::weak_ptr<GamePlayerS>>& lootRecipients);
+		void GenerateItemsFromTable(const LootTable& table, const std::vector<std::weak_ptr<GamePlayerS>>& lootRecipients);
 
 		[[nodiscard]] uint8 GetSlotType(uint8 slot, uint64 receiver) const;
 
@@ -269,5 +295,13 @@ namespace mmo
 		uint64 m_lootMasterGuid = 0;
 		std::map<uint8, LootRollData> m_rollData;
 		bool m_rollsStarted = false;
+
+		/// Loot tables and recipients which are rolled by Generate.
+		LootTableCache::TableList m_pendingTables;
+		std::vector<std::weak_ptr<GamePlayerS>> m_pendingRecipients;
+
+		/// Players passed to SetupGroupRollItems before the loot was generated.
+		std::set<uint64> m_pendingRollPlayers;
+		bool m_groupRollsPending = false;
 	};
 }
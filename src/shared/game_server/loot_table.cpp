@@ -0,0 +1,274 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#include "game_server/loot_table.h"
+
+#include "proto_data/project.h"
+#include "log/default_log_levels.h"
+
+#include <algorithm>
+
+namespace mmo
+{
+	LootTable::LootTable(const proto::LootEntry& entry)
+		: m_entry(&entry)
+	{
+		m_groups.reserve(entry.groups_size());
+		for (const auto& group : entry.groups())
+		{
+			CompileGroup(group);
+		}
+	}
+
+	uint32 LootTable::RollGold(RandomnessGenerator& generator) const
+	{
+		std::uniform_int_distribution<uint32> goldDistribution(m_entry->minmoney(), m_entry->maxmoney());
+		return goldDistribution(generator);
+	}
+
+	void LootTable::CompileGroup(const proto::LootGroup& source)
+	{
+		Group group;
+		group.source = &source;
+		group.firstOutcome = static_cast<uint32>(m_outcomes.size());
+
+		for (const auto& def : source.definitions())
+		{
+			if (def.condition() != 0)
+			{
+				group.hasConditions = true;
+				m_groups.push_back(group);
+				return;
+			}
+		}
+
+		std::vector<const proto::LootDefinition*> chanced;
+		std::vector<const proto::LootDefinition*> equalChanced;
+		for (const auto& def : source.definitions())
+		{
+			if (def.dropchance() == 0.0f)
+			{
+				equalChanced.push_back(&def);
+			}
+			else if (def.dropchance() > 0.0f)
+			{
+				chanced.push_back(&def);
+			}
+		}
+
+		// The group roll is below 100, so higher drop chances behave like 100
+		const auto getChance = [](const proto::LootDefinition* def)
+		{
+			return std::min(static_cast<double>(def->dropchance()), 100.0);
+		};
+
+		std::sort(chanced.begin(), chanced.end(), [&getChance](const proto::LootDefinition* a, const proto::LootDefinition* b)
+		{
+			return getChance(a) < getChance(b);
+		});
+
+		// A group roll between the previous and the current drop chance selects the current definition and all
+		// definitions with a higher drop chance, one of which is picked with equal probability.
+		std::vector<double> probabilities;
+		double share = 0.0;
+		double previousChance = 0.0;
+		for (size_t i = 0; i < chanced.size(); ++i)
+		{
+			const double chance = getChance(chanced[i]);
+			share += (chance - previousChance) / static_cast<double>(chanced.size() - i);
+			previousChance = chance;
+
+			Outcome outcome;
+			outcome.definition = chanced[i];
+			m_outcomes.push_back(outcome);
+			probabilities.push_back(share / 100.0);
+		}
+
+		// Group rolls above the highest drop chance fall back to the equal chanced definitions
+		if (const double remaining = (100.0 - previousChance) / 100.0; remaining > 0.0)
+		{
+			if (equalChanced.empty())
+			{
+				m_outcomes.emplace_back();
+				probabilities.push_back(remaining);
+			}
+
+			for (const auto* def : equalChanced)
+			{
+				Outcome outcome;
+				outcome.definition = def;
+				m_outcomes.push_back(outcome);
+				probabilities.push_back(remaining / static_cast<double>(equalChanced.size()));
+			}
+		}
+
+		group.outcomeCount = static_cast<uint32>(m_outcomes.size()) - group.firstOutcome;
+
+		// Groups which can never drop anything don't need to be rolled at all
+		const auto first = m_outcomes.begin() + group.firstOutcome;
+		if (std::none_of(first, m_outcomes.end(), [](const Outcome& outcome) { return outcome.definition != nullptr; }))
+		{
+			m_outcomes.erase(first, m_outcomes.end());
+			return;
+		}
+
+		// Build the alias table
+		double total = 0.0;
+		for (const double probability : probabilities)
+		{
+			total += probability;
+		}
+
+		const uint32 count = group.outcomeCount;
+		std::vector<uint32> small;
+		std::vector<uint32> large;
+		for (uint32 i = 0; i < count; ++i)
+		{
+			probabilities[i] = probabilities[i] * static_cast<double>(count) / total;
+			(probabilities[i] < 1.0 ? small : large).push_back(i);
+		}
+
+		while (!small.empty() && !large.empty())
+		{
+			const uint32 less = small.back();
+			small.pop_back();
+			const uint32 more = large.back();
+			large.pop_back();
+
+			Outcome& outcome = m_outcomes[group.firstOutcome + less];
+			outcome.probability = probabilities[less];
+			outcome.alias = more;
+
+			probabilities[more] = (probabilities[more] + probabilities[less]) - 1.0;
+			(probabilities[more] < 1.0 ? small : large).push_back(more);
+		}
+
+		// Whatever is left over only differs from 1 by rounding errors
+		for (const uint32 i : small)
+		{
+			m_outcomes[group.firstOutcome + i].probability = 1.0;
+		}
+
+		for (const uint32 i : large)
+		{
+			m_outcomes[group.firstOutcome + i].probability = 1.0;
+		}
+
+		m_groups.push_back(group);
+	}
+
+	const proto::LootDefinition* LootTable::RollAlias(const Group& group, RandomnessGenerator& generator) const
+	{
+		const Outcome* outcomes = m_outcomes.data() + group.firstOutcome;
+		if (group.outcomeCount == 1)
+		{
+			return outcomes->definition;
+		}
+
+		std::uniform_real_distribution<double> columnDistribution(0.0, static_cast<double>(group.outcomeCount));
+		const double roll = columnDistribution(generator);
+		const uint32 column = std::min(static_cast<uint32>(roll), group.outcomeCount - 1);
+
+		const Outcome& outcome = outcomes[column];
+		if (roll - static_cast<double>(column) < outcome.probability)
+		{
+			return outcome.definition;
+		}
+
+		return outcomes[outcome.alias].definition;
+	}
+
+	LootTableCache::LootTableCache(const proto::Project& project)
+	{
+		const auto& entries = project.unitLoot.getTemplates().entry();
+
+		// Tables are referenced by pointer, so the storage must not grow afterwards
+		m_tables.reserve(entries.size());
+		for (const auto& entry : entries)
+		{
+			const LootTable& table = m_tables.emplace_back(entry);
+			m_tableLists[table.GetId()] = ListRange{ static_cast<uint32>(m_lists.size()), 1 };
+			m_lists.push_back(&table);
+		}
+
+		const auto addTable = [this](const uint32 lootEntryId)
+		{
+			if (const auto it = m_tableLists.find(lootEntryId); it != m_tableLists.end())
+			{
+				m_lists.push_back(m_lists[it->second.first]);
+			}
+		};
+
+		// Creatures and objects that still use the legacy single loot entry field are treated as having a single table
+		for (const auto& unit : project.units.getTemplates().entry())
+		{
+			ListRange range{ static_cast<uint32>(m_lists.size()), 0 };
+			if (unit.unitlootentries_size() > 0)
+			{
+				for (const uint32 lootEntryId : unit.unitlootentries())
+				{
+					addTable(lootEntryId);
+				}
+			}
+			else
+			{
+				addTable(unit.unitlootentry());
+			}
+
+			range.count = static_cast<uint32>(m_lists.size()) - range.first;
+			if (range.count > 0)
+			{
+				m_unitLists[unit.id()] = range;
+			}
+		}
+
+		for (const auto& object : project.objects.getTemplates().entry())
+		{
+			ListRange range{ static_cast<uint32>(m_lists.size()), 0 };
+			if (object.objectlootentries_size() > 0)
+			{
+				for (const uint32 lootEntryId : object.objectlootentries())
+				{
+					addTable(lootEntryId);
+				}
+			}
+			else
+			{
+				addTable(object.objectlootentry());
+			}
+
+			range.count = static_cast<uint32>(m_lists.size()) - range.first;
+			if (range.count > 0)
+			{
+				m_objectLists[object.id()] = range;
+			}
+		}
+
+		DLOG("Loot table cache set up - compiled " << m_tables.size() << " loot tables for " << m_unitLists.size() << " creatures and " << m_objectLists.size() << " objects");
+	}
+
+	LootTableCache::TableList LootTableCache::GetLootTable(const uint32 lootEntryId) const
+	{
+		return GetList(m_tableLists, lootEntryId);
+	}
+
+	LootTableCache::TableList LootTableCache::GetCreatureLoot(const proto::UnitEntry& unit) const
+	{
+		return GetList(m_unitLists, unit.id());
+	}
+
+	LootTableCache::TableList LootTableCache::GetObjectLoot(const proto::ObjectEntry& object) const
+	{
+		return GetList(m_objectLists, object.id());
+	}
+
+	LootTableCache::TableList LootTableCache::GetList(const std::unordered_map<uint32, ListRange>& lists, const uint32 id) const
+	{
+		const auto it = lists.find(id);
+		if (it == lists.end())
+		{
+			return {};
+		}
+
+		return TableList(m_lists.data() + it->second.first, it->second.count);
+	}
+}
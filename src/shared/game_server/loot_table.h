@@ -0,0 +1,202 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/typedefs.h"
+#include "base/non_copyable.h"
+#include "base/random.h"
+
+#include "shared/proto_data/loot_entry.pb.h"
+
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace mmo
+{
+	namespace proto
+	{
+		class Project;
+		class UnitEntry;
+		class ObjectEntry;
+	}
+
+	/// A loot entry which has been compiled for fast rolling. Every group of the entry is turned into an alias table
+	///	(Vose's alias method) over the definitions that can drop, so that rolling a group takes a single random number
+	///	and a constant amount of work, no matter how many definitions it contains. The resulting distribution is the
+	///	same as the one of the threshold roll described by the loot entry: a roll between 0 and 100 selects all
+	///	definitions with at least this drop chance, of which one is picked at random, and definitions with a drop
+	///	chance of zero are picked at random if no other definition was selected.
+	///
+	///	Groups with a definition that has a condition can not be precomputed, as the condition depends on the loot
+	///	recipients. These groups are rolled with the threshold roll instead.
+	class LootTable final
+	{
+	public:
+		/// Compiles a loot entry. The entry has to outlive the compiled table.
+		explicit LootTable(const proto::LootEntry& entry);
+
+	public:
+		[[nodiscard]] uint32 GetId() const { return m_entry->id(); }
+
+		[[nodiscard]] const proto::LootEntry& GetEntry() const { return *m_entry; }
+
+		/// Rolls the amount of gold dropped by this table.
+		[[nodiscard]] uint32 RollGold(RandomnessGenerator& generator) const;
+
+		/// Rolls every group of the table once and passes each dropped definition to a callback. Does not allocate.
+		/// @param generator The random number generator to use.
+		/// @param isEligible Called as bool(const proto::LootDefinition&) for definitions with a condition. Returns
+		///	       whether at least one recipient meets the condition of the definition.
+		/// @param onDrop Called as void(const proto::LootDefinition&) for every dropped definition.
+		template<class EligiblePredicate, class DropCallback>
+		void Roll(RandomnessGenerator& generator, const EligiblePredicate& isEligible, const DropCallback& onDrop) const
+		{
+			for (const Group& group : m_groups)
+			{
+				const proto::LootDefinition* definition = group.hasConditions
+					? RollThreshold(*group.source, generator, isEligible)
+					: RollAlias(group, generator);
+				if (definition)
+				{
+					onDrop(*definition);
+				}
+			}
+		}
+
+	private:
+		/// A possible result of a group roll. An outcome without definition means that nothing drops.
+		struct Outcome
+		{
+			/// Probability to keep this outcome instead of switching to its alias once its column was selected.
+			double probability = 1.0;
+
+			/// Index of the alias outcome, relative to the first outcome of the group.
+			uint32 alias = 0;
+
+			const proto::LootDefinition* definition = nullptr;
+		};
+
+		struct Group
+		{
+			const proto::LootGroup* source = nullptr;
+
+			bool hasConditions = false;
+
+			/// Range of the outcomes of this group in m_outcomes.
+			uint32 firstOutcome = 0;
+
+			uint32 outcomeCount = 0;
+		};
+
+		void CompileGroup(const proto::LootGroup& source);
+
+		[[nodiscard]] const proto::LootDefinition* RollAlias(const Group& group, RandomnessGenerator& generator) const;
+
+		/// Rolls a group like described by the loot entry, skipping definitions whose condition is not met.
+		template<class EligiblePredicate>
+		static const proto::LootDefinition* RollThreshold(const proto::LootGroup& group, RandomnessGenerator& generator, const EligiblePredicate& isEligible)
+		{
+			std::uniform_real_distribution<float> lootDistribution(0.0f, 100.0f);
+			const float groupRoll = lootDistribution(generator);
+
+			// Definitions with a drop chance are preferred over equal chanced definitions
+			const auto isCandidate = [groupRoll, &isEligible](const proto::LootDefinition& def, const bool equalChanced)
+			{
+				if (equalChanced ? def.dropchance() != 0.0f : !(def.dropchance() > 0.0f && def.dropchance() >= groupRoll))
+				{
+					return false;
+				}
+
+				return def.condition() == 0 || isEligible(def);
+			};
+
+			uint32 candidateCount = 0;
+			bool equalChanced = false;
+			for (const auto& def : group.definitions())
+			{
+				candidateCount += isCandidate(def, equalChanced) ? 1 : 0;
+			}
+
+			if (candidateCount == 0)
+			{
+				equalChanced = true;
+				for (const auto& def : group.definitions())
+				{
+					candidateCount += isCandidate(def, equalChanced) ? 1 : 0;
+				}
+
+				if (candidateCount == 0)
+				{
+					return nullptr;
+				}
+			}
+
+			std::uniform_int_distribution<uint32> candidateDistribution(0, candidateCount - 1);
+			uint32 index = candidateDistribution(generator);
+			for (const auto& def : group.definitions())
+			{
+				if (isCandidate(def, equalChanced) && index-- == 0)
+				{
+					return &def;
+				}
+			}
+
+			return nullptr;
+		}
+
+	private:
+		const proto::LootEntry* m_entry;
+
+		std::vector<Group> m_groups;
+
+		std::vector<Outcome> m_outcomes;
+	};
+
+	/// Holds the compiled loot tables of a project and the loot tables assigned to each creature and object, so that
+	///	nothing has to be resolved when loot is generated. Built once when the world server is set up.
+	class LootTableCache final : public NonCopyable
+	{
+	public:
+		typedef std::span<const LootTable* const> TableList;
+
+	public:
+		/// Compiles all unit loot entries of the project and resolves the loot tables of all creatures and objects.
+		explicit LootTableCache(const proto::Project& project);
+
+	public:
+		/// Gets a single compiled loot table by its id. Empty if the loot table does not exist.
+		[[nodiscard]] TableList GetLootTable(uint32 lootEntryId) const;
+
+		/// Gets the loot tables assigned to a creature. Empty if the creature has no loot.
+		[[nodiscard]] TableList GetCreatureLoot(const proto::UnitEntry& unit) const;
+
+		/// Gets the loot tables assigned to an object. Empty if the object has no loot.
+		[[nodiscard]] TableList GetObjectLoot(const proto::ObjectEntry& object) const;
+
+		[[nodiscard]] size_t GetTableCount() const { return m_tables.size(); }
+
+	private:
+		/// Range of a table list in m_lists.
+		struct ListRange
+		{
+			uint32 first = 0;
+
+			uint32 count = 0;
+		};
+
+		[[nodiscard]] TableList GetList(const std::unordered_map<uint32, ListRange>& lists, uint32 id) const;
+
+	private:
+		std::vector<LootTable> m_tables;
+
+		/// Table lists of all loot tables, creatures and objects, stored back to back.
+		std::vector<const LootTable*> m_lists;
+
+		std::unordered_map<uint32, ListRange> m_tableLists;
+
+		std::unordered_map<uint32, ListRange> m_unitLists;
+
+		std::unordered_map<uint32, ListRange> m_objectLists;
+	};
+}
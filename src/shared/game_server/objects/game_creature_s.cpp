@@ -94,10 +94,18 @@ namespace mmo
 		// Setup new entry
 		m_entry = &entry;
 
-		// Add all creature spells (defer passive activation until spawned)
-		for (const auto& spell : m_entry->creaturespells())
+		if (firstInitialization && GetSpells().empty() && GetWorldInstance())
 		{
-			AddSpell(spell.spellid(), false);
+			// Share the spell set of the entry instead of building a copy per creature. Passives are activated on spawn.
+			ShareSpells(GetWorldInstance()->GetCreatureSpells(entry));
+		}
+		else
+		{
+			// Add all creature spells (defer passive activation until spawned)
+			for (const auto& spell : m_entry->creaturespells())
+			{
+				AddSpell(spell.spellid(), false);
+			}
 		}
 
 		// Use base npc flags from entry
@@ -182,7 +190,7 @@ namespace mmo
 		Set<uint32>(object_fields::Health, static_cast<uint32>(static_cast<float>(GetMaxHealth()) * percent));
 	}
 
-	void GameCreatureS::SetUnitLoot(std::unique_ptr<LootInstance> unitLoot)
+	void GameCreatureS::SetUnitLoot(std::shared_ptr<LootInstance> unitLoot)
 	{
 		m_loot = std::move(unitLoot);
 
@@ -101,7 +101,7 @@ namespace mmo
 
 		void SetHealthPercent(float percent);
 
-		void SetUnitLoot(std::unique_ptr<LootInstance> unitLoot);
+		void SetUnitLoot(std::shared_ptr<LootInstance> unitLoot);
 
 		/// Gets the number of loot recipients.
 		uint32 GetLootRecipientCount() const { return m_lootRecipients.size(); }
@@ -371,6 +371,13 @@ namespace mmo
 		/// is not in any world.
 		void SetWorldInstance(WorldInstance* instance);
 
+		/// Gets the object pool of the world instance of this object. May be nullptr, if the object
+		/// is not in any world.
+		SmallObjectPool* GetObjectPool() const
+		{
+			return m_worldInstance ? m_worldInstance->GetObjectPool() : nullptr;
+		}
+
 		virtual bool HasMovementInfo() const { return false; }
 
 		void NotifyTriggerRunning(const uint32 triggerId) { m_runningTriggers.insert(triggerId); }
@@ -631,6 +631,7 @@ namespace mmo
 
 				// Update quest log field value
 				Set<QuestField>(object_fields::QuestLogSlot_1 + i * (sizeof(QuestField) / sizeof(uint32)), field);
+				RebuildQuestObjectiveIndex();
 				if (m_netPlayerWatcher)
 					m_netPlayerWatcher->OnQuestDataChanged(quest, data);
 
@@ -661,6 +662,7 @@ namespace mmo
 
 				// Reset quest log
 				Set<QuestField>(object_fields::QuestLogSlot_1 + i * (sizeof(QuestField) / sizeof(uint32)), QuestField());
+				RebuildQuestObjectiveIndex();
 				if (m_netPlayerWatcher)
 					m_netPlayerWatcher->OnQuestDataChanged(quest, QuestStatusData());
 
@@ -996,6 +998,7 @@ namespace mmo
 			if (field.questId == entry->id())
 			{
 				Set<QuestField>(object_fields::QuestLogSlot_1 + i * (sizeof(QuestField) / sizeof(uint32)), QuestField());
+				RebuildQuestObjectiveIndex();
 				break;
 			}
 		}
@@ -1048,11 +1051,18 @@ namespace mmo
 	{
 		const uint32 creditEntry = (entry.killcredit() != 0) ? entry.killcredit() : entry.id();
 
-		// Check all quests in the quest log
-		for (uint8 i = 0; i < MaxQuestLogSize; ++i)
+		const auto indexIt = m_questKillObjectives.find(creditEntry);
+		if (indexIt == m_questKillObjectives.end())
 		{
+			return;
+		}
+
+		// Only visit the quests with an objective for this creature
+		for (const QuestLogRef &ref : indexIt->second)
+		{
+			const uint8 i = ref.slot;
 			QuestField field = Get<QuestField>(object_fields::QuestLogSlot_1 + i * (sizeof(QuestField) / sizeof(uint32)));
-			if (field.questId == 0)
+			if (field.questId != ref.questId)
 			{
 				continue;
 			}
@@ -1196,6 +1206,63 @@ namespace mmo
 		return true;
 	}
 
+	void GamePlayerS::RebuildQuestObjectiveIndex()
+	{
+		m_questKillObjectives.clear();
+		m_questItemObjectives.clear();
+		m_questSpellCastObjectives.clear();
+
+		const auto addQuest = [](QuestObjectiveIndex &index, const uint32 entry, const QuestLogRef &ref)
+		{
+			std::vector<QuestLogRef> &quests = index[entry];
+
+			// A quest may have several objectives for the same entry, but is handled once per event
+			if (quests.empty() || quests.back().slot != ref.slot)
+			{
+				quests.push_back(ref);
+			}
+		};
+
+		for (uint8 i = 0; i < MaxQuestLogSize; ++i)
+		{
+			const QuestField field = Get<QuestField>(object_fields::QuestLogSlot_1 + i * (sizeof(QuestField) / sizeof(uint32)));
+			if (field.questId == 0)
+			{
+				continue;
+			}
+
+			const auto *quest = GetProject().quests.getById(field.questId);
+			if (!quest)
+			{
+				continue;
+			}
+
+			const QuestLogRef ref { field.questId, i };
+			for (const auto &req : quest->requirements())
+			{
+				if (req.creatureid() != 0)
+				{
+					addQuest(m_questKillObjectives, req.creatureid(), ref);
+				}
+
+				if (req.itemid() != 0)
+				{
+					addQuest(m_questItemObjectives, req.itemid(), ref);
+				}
+
+				if (req.sourceid() != 0)
+				{
+					addQuest(m_questItemObjectives, req.sourceid(), ref);
+				}
+
+				if (req.spellcast() != 0 && req.objectid() != 0)
+				{
+					addQuest(m_questSpellCastObjectives, req.objectid(), ref);
+				}
+			}
+		}
+	}
+
 	void GamePlayerS::OnQuestExploration(uint32 questId)
 	{
 		// TODO
@@ -1206,11 +1273,18 @@ namespace mmo
 		const uint32 currentTotal = m_inventory.GetItemCount(entry.id());
 		const uint32 previousTotal = (currentTotal >= amount) ? (currentTotal - amount) : 0;
 
-		// If this is set to true, all nearby objects will be updated
-		for (uint8 i = 0; i < MaxQuestLogSize; ++i)
+		const auto indexIt = m_questItemObjectives.find(entry.id());
+		if (indexIt == m_questItemObjectives.end())
+		{
+			return;
+		}
+
+		// Only visit the quests with an objective for this item
+		for (const QuestLogRef &ref : indexIt->second)
 		{
+			const uint8 i = ref.slot;
 			QuestField field = Get<QuestField>(object_fields::QuestLogSlot_1 + i * (sizeof(QuestField) / sizeof(uint32)));
-			if (field.questId == 0)
+			if (field.questId != ref.questId)
 			{
 				continue;
 			}
@@ -1297,11 +1371,18 @@ namespace mmo
 
 	void GamePlayerS::OnQuestItemRemovedCredit(const proto::ItemEntry &entry, uint32 amount)
 	{
-		// If this is set to true, all nearby objects will be updated
-		for (uint8 i = 0; i < MaxQuestLogSize; ++i)
+		const auto indexIt = m_questItemObjectives.find(entry.id());
+		if (indexIt == m_questItemObjectives.end())
+		{
+			return;
+		}
+
+		// Only visit the quests with an objective for this item
+		for (const QuestLogRef &ref : indexIt->second)
 		{
+			const uint8 i = ref.slot;
 			QuestField field = Get<QuestField>(object_fields::QuestLogSlot_1 + i * (sizeof(QuestField) / sizeof(uint32)));
-			if (field.questId == 0)
+			if (field.questId != ref.questId)
 			{
 				continue;
 			}
@@ -1371,10 +1452,18 @@ namespace mmo
 	{
 		const uint32 targetEntry = target.Get<uint32>(object_fields::Entry);
 
-		for (uint8 i = 0; i < MaxQuestLogSize; ++i)
+		const auto indexIt = m_questSpellCastObjectives.find(targetEntry);
+		if (indexIt == m_questSpellCastObjectives.end())
+		{
+			return;
+		}
+
+		// Only visit the quests with an objective for this object
+		for (const QuestLogRef &ref : indexIt->second)
 		{
+			const uint8 i = ref.slot;
 			QuestField field = Get<QuestField>(object_fields::QuestLogSlot_1 + i * (sizeof(QuestField) / sizeof(uint32)));
-			if (field.questId == 0)
+			if (field.questId != ref.questId)
 			{
 				continue;
 			}
@@ -1681,6 +1770,8 @@ namespace mmo
 				break;
 			}
 		}
+
+		RebuildQuestObjectiveIndex();
 	}
 
 	bool GamePlayerS::LearnTalent(uint32 talentId, uint32 rank, bool enforceRequirements)
@@ -2568,7 +2659,7 @@ namespace mmo
 
 	void GamePlayerS::SetKnownSpells(const std::vector<uint32>& spellIds)
 	{
-		m_spells.clear();
+		m_spells.Reset();
 		m_knownSpellIds.clear();
 
 		for (const uint32 spellId : spellIds)
@@ -2591,7 +2682,7 @@ namespace mmo
 			m_knownSpellIds.insert(spellId);
 			if (IsSpellActiveForCurrentClass(*spell))
 			{
-				m_spells.insert(spell);
+				m_spells.Edit().insert(spell);
 			}
 		}
 	}
@@ -2603,7 +2694,7 @@ namespace mmo
 		// a previous class's proficiency spell would linger in the spellbook and keep granting its
 		// proficiency.
 		std::vector<uint32> toRemove;
-		for (const auto* spell : m_spells)
+		for (const auto* spell : m_spells.Get())
 		{
 			if (!spell)
 			{
@@ -2625,7 +2716,7 @@ namespace mmo
 		for (const uint32 spellId : m_knownSpellIds)
 		{
 			const auto* spell = m_project.spells.getById(spellId);
-			if (!spell || m_spells.contains(spell))
+			if (!spell || m_spells.Get().contains(spell))
 			{
 				continue;
 			}
@@ -2644,7 +2735,7 @@ namespace mmo
 		// Proficiency effect; deactivating a class's spells on a class switch must therefore drop the
 		// proficiencies they granted, which the per-spell removal path does not do on its own.
 		std::set<uint32> desired;
-		for (const auto* spell : m_spells)
+		for (const auto* spell : m_spells.Get())
 		{
 			if (!spell || !(spell->attributes(0) & spell_attributes::Passive))
 			{
@@ -2923,8 +3014,8 @@ namespace mmo
 		w << io::write_range(object.m_attributePointEnhancements);
 
 		// Write known spell ids
-		w << io::write<uint32>(object.m_spells.size());
-		for (const auto &spell : object.m_spells)
+		w << io::write<uint32>(object.m_spells.Get().size());
+		for (const auto &spell : object.m_spells.Get())
 		{
 			w << io::write<uint32>(spell->id());
 		}
@@ -2980,7 +3071,7 @@ namespace mmo
 		// Read spells
 		uint32 spellCount;
 		r >> io::read<uint32>(spellCount);
-		object.m_spells.clear();
+		object.m_spells.Reset();
 		for (uint32 i = 0; i < spellCount; ++i)
 		{
 			uint32 spellId;
@@ -2989,7 +3080,7 @@ namespace mmo
 			const auto *spell = object.GetProject().spells.getById(spellId);
 			if (spell)
 			{
-				object.m_spells.emplace(spell);
+				object.m_spells.Edit().emplace(spell);
 			}
 		}
 
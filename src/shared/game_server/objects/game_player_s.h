@@ -6,10 +6,12 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <unordered_map>
 
 #include "game_unit_s.h"
 #include "game_server/inventory.h"
 #include "game_server/character_data.h"
+#include "game_server/condition_result_cache.h"
 #include "game_server/quest_status_data.h"
 #include "game/quest.h"
 #include "game/group.h"
@@ -133,6 +135,9 @@ namespace mmo
 
 		const proto::ClassEntry *GetClassEntry() const { return m_classEntry; }
 
+		/// Gets the memoized condition results of this player. Only used by the ConditionMgr.
+		ConditionResultCache &GetConditionResultCache() { return m_conditionResults; }
+
 		const proto::RaceEntry *GetRaceEntry() const { return m_raceEntry; }
 
 		bool AddAttributePoint(uint32 attribute);
@@ -455,6 +460,25 @@ namespace mmo
 		/// Fails all quests in the quest log that have the StayAlive flag set. Called on death.
 		void FailQuestsOnDeath();
 
+		/// Rebuilds the quest objective indices from the quest log. Must be called whenever a quest enters or
+		/// leaves the quest log.
+		void RebuildQuestObjectiveIndex();
+
+	private:
+		/// A quest in the quest log with at least one objective for an indexed entry.
+		struct QuestLogRef
+		{
+			uint32 questId;
+
+			/// Quest log slot of the quest.
+			uint8 slot;
+		};
+
+		/// Maps an entry id to the quests in the quest log with an objective for it, in quest log order, so that
+		/// kill, item and spell cast events only visit the quests they affect. The quest status is still checked
+		/// per event, as it changes without the quest leaving the quest log.
+		typedef std::unordered_map<uint32, std::vector<QuestLogRef>> QuestObjectiveIndex;
+
 	private:
 		String m_name;
 		Inventory m_inventory;
@@ -477,6 +501,17 @@ namespace mmo
 		std::map<uint32, QuestStatusData> m_quests;
 		std::set<uint32> m_rewardedQuestIds;
 
+		/// Quests with kill credit objectives, keyed by the credited creature entry.
+		QuestObjectiveIndex m_questKillObjectives;
+
+		/// Quests with item objectives, keyed by the required item or quest source item entry.
+		QuestObjectiveIndex m_questItemObjectives;
+
+		/// Quests with spell cast objectives, keyed by the target object entry.
+		QuestObjectiveIndex m_questSpellCastObjectives;
+
+		ConditionResultCache m_conditionResults;
+
 		/// Daily/weekly quests that have been rewarded, mapped to the unix timestamp (seconds) at
 		/// which they become available again.
 		std::map<uint32, GameTime> m_repeatableResets;
@@ -60,8 +60,12 @@ namespace mmo
 	GameUnitS::GameUnitS(const proto::Project &project, TimerQueue &timers)
 		: GameObjectS(project), m_timers(timers), m_despawnCountdown(timers), m_attackSwingCountdown(timers), m_offhandSwingCountdown(timers), m_regenCountdown(timers), m_pvpCombatCountdown(timers)
 	{
-		// Setup unit mover
-		m_mover = make_unique<UnitMover>(*this);
+		// The unit mover is created on first use by GetMover
+
+		for (size_t type = 0; type < movement_type::Count; ++type)
+		{
+			m_baseSpeeds[type] = GetDefaultBaseSpeed(static_cast<MovementType>(type));
+		}
 
 		// Create CC movement controller (drives wander for feared/disoriented NPCs)
 		m_ccMovementController = std::make_unique<CCMovementController>(*this);
@@ -170,10 +174,41 @@ namespace mmo
 
 	const Vector3 &GameUnitS::GetPosition() const
 	{
-		m_lastPosition = m_mover->GetCurrentLocation();
+		const WorldInstance* world = m_worldInstance;
+		if (!world)
+		{
+			// Not in a world, so there are no ticks to cache against
+			m_positionCacheWorld = nullptr;
+			m_lastPosition = GetExactPosition();
+			return m_lastPosition;
+		}
+
+		if (m_positionCacheWorld != world || m_positionCacheTick != world->GetUpdateTick())
+		{
+			m_lastPosition = GetExactPosition();
+			m_positionCacheWorld = world;
+			m_positionCacheTick = world->GetUpdateTick();
+		}
+
 		return m_lastPosition;
 	}
 
+	Vector3 GameUnitS::GetExactPosition() const
+	{
+		// Without a mover the unit never moved along a server controlled path
+		return m_mover ? m_mover->GetCurrentLocation() : m_movementInfo.position;
+	}
+
+	UnitMover& GameUnitS::GetMover()
+	{
+		if (!m_mover)
+		{
+			m_mover = std::make_unique<UnitMover>(*this);
+		}
+
+		return *m_mover;
+	}
+
 	float GameUnitS::GetModifierValue(UnitMods mod, UnitModType type) const
 	{
 		return m_unitMods[mod][type];
@@ -362,6 +397,8 @@ namespace mmo
 			m_spellCast->StopCast(spell_interrupt_flags::Movement);
 		}
 
+		// Invalidate before the base class notifies the world, which already queries the new position
+		InvalidatePositionCache();
 		GameObjectS::Relocate(position, facing);
 	}
 
@@ -377,6 +414,7 @@ namespace mmo
 			m_spellCast->StopCast(spell_interrupt_flags::Movement);
 		}
 
+		InvalidatePositionCache();
 		GameObjectS::ApplyMovementInfo(info);
 	}
 
@@ -460,12 +498,17 @@ namespace mmo
 			return true;
 		}
 
-		if (const auto it = m_spellCooldowns.find(spellId); it != m_spellCooldowns.end() && it->second > now)
+		if (!m_cooldowns)
+		{
+			return false;
+		}
+
+		if (const auto it = m_cooldowns->spells.find(spellId); it != m_cooldowns->spells.end() && it->second > now)
 		{
 			return true;
 		}
 
-		if (const auto it2 = m_spellCategoryCooldowns.find(spellCategory); it2 != m_spellCategoryCooldowns.end() && it2->second > now)
+		if (const auto it2 = m_cooldowns->categories.find(spellCategory); it2 != m_cooldowns->categories.end() && it2->second > now)
 		{
 			return true;
 		}
@@ -475,14 +518,15 @@ namespace mmo
 
 	bool GameUnitS::HasSpell(uint32 spellId) const
 	{
-		return std::find_if(m_spells.begin(), m_spells.end(), [spellId](const auto &spell)
-							{ return spell->id() == spellId; }) != m_spells.end();
+		const SpellSet &spells = m_spells.Get();
+		return std::find_if(spells.begin(), spells.end(), [spellId](const auto &spell)
+							{ return spell->id() == spellId; }) != spells.end();
 	}
 
 	void GameUnitS::SetInitialSpells(const std::vector<uint32> &spellIds)
 	{
-		ASSERT(m_spells.empty());
-		m_spells.clear();
+		ASSERT(m_spells.Get().empty());
+		m_spells.Reset();
 
 		for (const auto &spellId : spellIds)
 		{
@@ -511,7 +555,7 @@ namespace mmo
 				}
 			}
 
-			m_spells.insert(spell);
+			m_spells.Edit().insert(spell);
 		}
 	}
 
@@ -524,7 +568,7 @@ namespace mmo
 			return;
 		}
 
-		if (m_spells.contains(spell))
+		if (m_spells.Get().contains(spell))
 		{
 			return;
 		}
@@ -547,7 +591,7 @@ namespace mmo
 			}
 		}
 
-		auto it = m_spells.insert(spell);
+		auto it = m_spells.Edit().insert(spell);
 		if (!it.second)
 		{
 			WLOG("Unit did already know this spell!");
@@ -574,11 +618,13 @@ namespace mmo
 			return;
 		}
 
-		if (m_spells.erase(spell) < 1)
+		if (!m_spells.Get().contains(spell))
 		{
 			return;
 		}
 
+		m_spells.Edit().erase(spell);
+
 		// Remove applied auras due to spell removal
 		RemoveAllAurasFromCaster(GetGuid(), spellId);
 
@@ -611,7 +657,7 @@ namespace mmo
 	void GameUnitS::ActivatePassiveSpells()
 	{
 		// Iterate through all known spells and activate passive ones
-		for (const auto* spell : m_spells)
+		for (const auto* spell : m_spells.Get())
 		{
 			if (spell && (spell->attributes(0) & spell_attributes::Passive))
 			{
@@ -624,30 +670,57 @@ namespace mmo
 
 	const std::unordered_set<const proto::SpellEntry *> &GameUnitS::GetSpells() const
 	{
-		return m_spells;
+		return m_spells.Get();
+	}
+
+	void GameUnitS::ShareSpells(const CopyOnWrite<SpellSet> &spells)
+	{
+		ASSERT(m_spells.Get().empty());
+		m_spells.Share(spells);
+
+		for (const auto* spell : m_spells.Get())
+		{
+			OnSpellLearned(*spell);
+		}
 	}
 
 	void GameUnitS::SetCooldown(const uint32 spellId, const GameTime cooldownTimeMs)
 	{
 		if (cooldownTimeMs == 0)
 		{
-			m_spellCooldowns.erase(spellId);
+			if (m_cooldowns)
+			{
+				m_cooldowns->spells.erase(spellId);
+			}
 		}
 		else
 		{
-			m_spellCooldowns[spellId] = GetAsyncTimeMs() + cooldownTimeMs;
+			GetCooldowns().spells[spellId] = GetAsyncTimeMs() + cooldownTimeMs;
 		}
 	}
 
+	GameUnitS::SpellCooldowns& GameUnitS::GetCooldowns()
+	{
+		if (!m_cooldowns)
+		{
+			m_cooldowns = std::make_unique<SpellCooldowns>();
+		}
+
+		return *m_cooldowns;
+	}
+
 	void GameUnitS::SetSpellCategoryCooldown(const uint32 spellCategory, const GameTime cooldownTimeMs)
 	{
 		if (cooldownTimeMs == 0)
 		{
-			m_spellCategoryCooldowns.erase(spellCategory);
+			if (m_cooldowns)
+			{
+				m_cooldowns->categories.erase(spellCategory);
+			}
 		}
 		else
 		{
-			m_spellCategoryCooldowns[spellCategory] = GetAsyncTimeMs() + cooldownTimeMs;
+			GetCooldowns().categories[spellCategory] = GetAsyncTimeMs() + cooldownTimeMs;
 		}
 	}
 
@@ -888,26 +961,23 @@ namespace mmo
 	void GameUnitS::SendAttackerStateUpdate(uint64 victimGuid, uint32 hitInfo, uint32 victimState,
 		uint32 totalDamage, uint32 school, uint32 absorbedDamage, uint32 resistedDamage, uint32 blockedDamage)
 	{
-		std::vector<char> buffer;
-		io::VectorSink sink(buffer);
-		game::Protocol::OutgoingPacket packet(sink);
-		packet.Start(game::realm_client_packet::AttackerStateUpdate);
-		packet
-			<< io::write_packed_guid(GetGuid())
-			<< io::write_packed_guid(victimGuid)
-			<< io::write<uint32>(hitInfo)
-			<< io::write<uint32>(victimState)
-			<< io::write<uint32>(totalDamage)
-			<< io::write<uint32>(school)
-			<< io::write<uint32>(absorbedDamage)
-			<< io::write<uint32>(resistedDamage)
-			<< io::write<uint32>(blockedDamage);
-		packet.Finish();
-		ForEachSubscriberInSight(
-			[&packet, &buffer](TileSubscriber& subscriber)
-			{
-				subscriber.SendPacket(packet, buffer);
-			});
+		if (!m_worldInstance)
+		{
+			return;
+		}
+
+		CombatLogEvent event;
+		event.type = combat_log_event::AttackerStateUpdate;
+		event.sourceGuid = GetGuid();
+		event.targetGuid = victimGuid;
+		event.flags = hitInfo;
+		event.victimState = victimState;
+		event.amount = totalDamage;
+		event.school = school;
+		event.absorbed = absorbedDamage;
+		event.resisted = resistedDamage;
+		event.blocked = blockedDamage;
+		m_worldInstance->GetCombatLog().Add(*this, event);
 	}
 
 	void GameUnitS::EnvironmentalDamageLog(uint64 targetGuid, uint32 amount, EnvironmentalDamageType type)
@@ -1256,9 +1326,13 @@ namespace mmo
 	std::vector<PersistentCooldownData> GameUnitS::GetPersistentCooldowns() const
 	{
 		std::vector<PersistentCooldownData> result;
+		if (!m_cooldowns)
+		{
+			return result;
+		}
 
 		const GameTime now = GetAsyncTimeMs();
-		for (const auto& [spellId, end] : m_spellCooldowns)
+		for (const auto& [spellId, end] : m_cooldowns->spells)
 		{
 			if (end <= now)
 			{
@@ -1285,7 +1359,7 @@ namespace mmo
 				continue;
 			}
 
-			auto container = std::make_shared<AuraContainer>(*this, data.casterId, *spell, data.remainingDuration, 0);
+			auto container = MakePooled<AuraContainer>(GetObjectPool(), *this, data.casterId, *spell, data.remainingDuration, 0);
 
 			for (const auto& effectData : data.effects)
 			{
@@ -1540,7 +1614,7 @@ namespace mmo
 		else if (!wasRooted && isRooted)
 		{
 			// Stop unit movement immediately
-			m_mover->StopMovement();
+			if (m_mover) m_mover->StopMovement();
 
 			if (m_netUnitWatcher)
 			{
@@ -2362,7 +2436,7 @@ namespace mmo
 
 	bool GameUnitS::HasSpellEffect(const SpellEffect type) const
 	{
-		for (const auto &spell : m_spells)
+		for (const auto &spell : m_spells.Get())
 		{
 			if (SpellHasEffect(*spell, type))
 			{
@@ -2536,11 +2610,12 @@ namespace mmo
 
 	float GameUnitS::GetBaseSpeed(const MovementType type) const
 	{
-		if (const auto it = m_baseSpeeds.find(static_cast<uint8>(type)); it != m_baseSpeeds.end())
-		{
-			return it->second;
-		}
+		ASSERT(type < movement_type::Count);
+		return m_baseSpeeds[type];
+	}
 
+	float GameUnitS::GetDefaultBaseSpeed(const MovementType type)
+	{
 		switch (type)
 		{
 		case movement_type::Walk:
@@ -2744,7 +2819,10 @@ namespace mmo
 		}
 
 		// Notify the unit mover about this change
-		m_mover->OnMoveSpeedChanged(type);
+		if (m_mover)
+		{
+			m_mover->OnMoveSpeedChanged(type);
+		}
 	}
 
 	uint32 GameUnitS::CalculateArmorReducedDamage(const uint32 attackerLevel, const uint32 damage) const
@@ -3313,7 +3391,7 @@ namespace mmo
 		// effective range by a small bonus so auto-attacks connect reliably instead
 		// of the attacker perpetually trailing just outside range.
 		const float attackRange = GetMeleeReach() + victim->GetMeleeReach();
-		const bool bothMoving = GetMover().IsMoving() && victim->GetMover().IsMoving();
+		const bool bothMoving = HasMover() && GetMover().IsMoving() && victim->HasMover() && victim->GetMover().IsMoving();
 		const float effectiveRange = attackRange + (bothMoving ? MELEE_CHASE_RANGE_BONUS : 0.0f);
 		if (victim->GetSquaredDistanceTo(GetPosition(), false) > (effectiveRange * effectiveRange))
 		{
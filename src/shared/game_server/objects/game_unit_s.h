@@ -5,6 +5,7 @@
 #include <memory>
 #include <set>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "game_server/spells/aura_container.h"
 #include "game_server/persistent_aura.h"
@@ -14,6 +15,7 @@
 #include "game_server/spells/spell_cast.h"
 #include "game/spell_target_map.h"
 #include "game_server/unit_mover.h"
+#include "base/copy_on_write.h"
 #include "base/countdown.h"
 #include "game/chat_type.h"
 #include "game/damage_school.h"
@@ -487,6 +489,10 @@ namespace mmo
 		: public GameObjectS
 		, public IPlayerValidatorContext
 	{
+	public:
+		/// Set of spells known by a unit.
+		typedef std::unordered_set<const proto::SpellEntry *> SpellSet;
+
 	public:
 		/// Signal fired when this unit is killed.
 		/// @param killer The unit that killed this unit (may be nullptr).
@@ -560,10 +566,19 @@ namespace mmo
 		/// Gets the network watcher of this unit (the owning client connection), or nullptr if none.
 		NetUnitWatcherS *GetNetUnitWatcher() const { return m_netUnitWatcher; }
 
-		/// Gets the current position of the unit.
+		/// Gets the current position of the unit. While the unit is in a world instance, the interpolated mover
+		///	location is computed at most once per world tick and whenever the unit is relocated, so repeated calls
+		///	within the same tick are cheap. Use GetExactPosition if sub-tick precision is required.
 		/// @returns The position vector of the unit.
 		const Vector3 &GetPosition() const override;
 
+		/// Gets the exact interpolated position of the unit at this very moment, bypassing the per-tick cache.
+		/// @returns The position vector of the unit.
+		Vector3 GetExactPosition() const;
+
+		/// Discards the cached position, so that the next call to GetPosition recomputes it.
+		void InvalidatePositionCache() const { m_positionCacheWorld = nullptr; }
+
 		/// Gets the specified unit modifier value.
 		/// @param mod The unit modifier to retrieve.
 		/// @param type The type of the modifier value to retrieve.
@@ -709,7 +724,7 @@ namespace mmo
 
 		/// Gets the set of spells known by the unit.
 		/// @returns A set of pointers to spell entries.
-		const std::unordered_set<const proto::SpellEntry *> &GetSpells() const;
+		const SpellSet &GetSpells() const;
 
 		/// Sets the cooldown for a spell.
 		/// @param spellId The ID of the spell.
@@ -782,7 +797,7 @@ namespace mmo
 		/// @param blocked The amount of damage that was blocked (0 if not blocked).
 		void SpellDamageLog(uint64 targetGuid, uint32 amount, uint8 school, DamageFlags flags, const proto::SpellEntry &spell, uint32 blocked = 0);
 
-		/// Sends the AttackerStateUpdate packet (melee white damage) to all nearby subscribers.
+		/// Adds an AttackerStateUpdate event (melee white damage) to the combat log of nearby subscribers.
 		/// @param victimGuid The GUID of the victim unit.
 		/// @param hitInfo Bitmask of HitInfo flags describing the attack outcome.
 		/// @param victimState The VictimState value for the attack.
@@ -1286,6 +1301,9 @@ public:
 		/// @returns The base speed as a float.
 		float GetBaseSpeed(const MovementType type) const;
 
+		/// Gets the base speed of a movement type for units without a custom base speed.
+		static float GetDefaultBaseSpeed(MovementType type);
+
 		/// Sets the base speed for a specific movement type.
 		/// @param type The movement type.
 		/// @param speed The new base speed.
@@ -1380,6 +1398,11 @@ public:
 		/// @param spell The spell entry that was unlearned.
 		virtual void OnSpellUnlearned(const proto::SpellEntry &spell) {}
 
+		/// Replaces the known spells of a unit which doesn't know any spells yet with a shared spell set. The set
+		/// is copied as soon as the unit learns or unlearns a spell. Passive spells are not activated.
+		/// @param spells The spells to share.
+		void ShareSpells(const CopyOnWrite<SpellSet> &spells);
+
 		/// Called when a spell cast ends.
 		/// @param succeeded Whether the spell cast succeeded.
 		virtual void OnSpellCastEnded(bool succeeded);
@@ -1501,9 +1524,13 @@ public:
 		/// @returns A reference to the timer queue.
 		TimerQueue &GetTimers() const { return m_timers; }
 
-		/// Gets the unit mover for the unit.
+		/// Gets the unit mover for the unit. The mover is created on first use, so that units which never move
+		/// don't allocate one.
 		/// @returns A reference to the unit mover.
-		UnitMover &GetMover() const { return *m_mover; }
+		UnitMover &GetMover();
+
+		/// Determines whether the unit mover was already created. A unit without mover is not moving.
+		bool HasMover() const { return m_mover != nullptr; }
 
 		/// Generates the next client ack ID for the unit.
 		/// @returns The next client ack ID as a uint32.
@@ -1512,6 +1539,16 @@ public:
 	protected:
 		typedef LinearSet<const GameUnitS *> AttackingUnitSet;
 
+		/// Cooldowns of a unit, allocated when the first cooldown is set.
+		struct SpellCooldowns
+		{
+			std::map<uint32, GameTime> spells;
+			std::map<uint32, GameTime> categories;
+		};
+
+		/// Gets the cooldowns of the unit, allocating them if needed.
+		SpellCooldowns &GetCooldowns();
+
 		TimerQueue &m_timers;
 		Countdown m_despawnCountdown;
 		std::unique_ptr<UnitMover> m_mover;
@@ -1526,17 +1563,21 @@ public:
 
 		std::weak_ptr<GameUnitS> m_victim;
 
-		std::unordered_set<const proto::SpellEntry *> m_spells;
+		CopyOnWrite<SpellSet> m_spells;
 		std::unique_ptr<SpellCast> m_spellCast;
 
-		std::map<uint32, GameTime> m_spellCooldowns;
-		std::map<uint32, GameTime> m_spellCategoryCooldowns;
+		/// Null until the first cooldown is set, since most creatures never cast a spell with a cooldown.
+		std::unique_ptr<SpellCooldowns> m_cooldowns;
 		GameTime m_globalCooldownEnd = 0;
 
 		AttackingUnitSet m_attackingUnits;
 
 		NetUnitWatcherS *m_netUnitWatcher = nullptr;
 		mutable Vector3 m_lastPosition;
+		/// World instance in which m_lastPosition was cached, or nullptr if the cache is invalid.
+		mutable const WorldInstance* m_positionCacheWorld = nullptr;
+		/// World update tick in which m_lastPosition was cached.
+		mutable uint64 m_positionCacheTick = 0;
 
 		stable_list<std::shared_ptr<AuraContainer>> m_auras;
 
@@ -1574,7 +1615,7 @@ public:
 		/// Accumulated flat dodge chance bonus in percent from auras (ModDodgeChance).
 		float m_dodgeChanceBonus = 0.0f;
 
-		std::map<uint8, float> m_baseSpeeds;
+		std::array<float, movement_type::Count> m_baseSpeeds;
 
 		uint32 m_regeneration = regeneration_flags::None;
 
@@ -3,6 +3,7 @@
 #include "game_world_object_s.h"
 
 #include "game_player_s.h"
+#include "game_server/world/world_instance_manager.h"
 #include "shared/proto_data/objects.pb.h"
 #include "game/quest.h"
 
@@ -97,31 +98,13 @@ namespace mmo
 				// tables. Loot tables act as reusable modules and multiple can be assigned to an object.
 				// For backwards compatibility, an object that still uses the legacy single
 				// 'objectlootentry' field is treated as having a single loot table.
-				std::vector<const proto::LootEntry*> lootEntries;
-				if (m_lootEntryOverride != 0)
-				{
-					if (const auto* loot = m_project.unitLoot.getById(m_lootEntryOverride))
-					{
-						lootEntries.push_back(loot);
-					}
-				}
-				else if (m_entry.objectlootentries_size() > 0)
-				{
-					lootEntries.reserve(m_entry.objectlootentries_size());
-					for (int i = 0; i < m_entry.objectlootentries_size(); ++i)
-					{
-						if (const auto* loot = m_project.unitLoot.getById(m_entry.objectlootentries(i)))
-						{
-							lootEntries.push_back(loot);
-						}
-					}
-				}
-				else if (const auto* legacyLoot = m_project.unitLoot.getById(m_entry.objectlootentry()))
-				{
-					lootEntries.push_back(legacyLoot);
-				}
+				ASSERT(m_worldInstance);
+				const LootTableCache& lootTables = m_worldInstance->GetManager().GetLootTables();
+				const LootTableCache::TableList tables = (m_lootEntryOverride != 0)
+					? lootTables.GetLootTable(m_lootEntryOverride)
+					: lootTables.GetObjectLoot(m_entry);
 
-				if (lootEntries.empty())
+				if (tables.empty())
 				{
 					DLOG("Chest has no loot entry configured - no loot window opened");
 					return;
@@ -129,12 +112,11 @@ namespace mmo
 
 				if (!m_loot)
 				{
-					ASSERT(m_worldInstance);
-
 					const auto weakPlayer = std::weak_ptr(std::dynamic_pointer_cast<GamePlayerS>(player.shared_from_this()));
-					m_loot = std::make_shared<LootInstance>(
+					m_loot = MakePooled<LootInstance>(
+						m_worldInstance->GetObjectPool(),
 						m_project.items, m_worldInstance->GetConditionMgr(), GetGuid(),
-						lootEntries,
+						tables,
 						std::vector{ weakPlayer });
 
 					// TODO: wire trigger_id — fire a specific trigger on chest open when trigger_id != 0
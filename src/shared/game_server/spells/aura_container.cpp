@@ -39,9 +39,9 @@ namespace mmo
 		, m_casterId(casterId)
 		, m_spell(spell)
 		, m_duration(duration)
-		, m_expirationCountdown(owner.GetTimers())
+		, m_expirationCountdown(owner.GetTimers(), owner.GetObjectPool())
 		, m_itemGuid(itemGuid)
-		, m_areaAuraTick(owner.GetTimers())
+		, m_areaAuraTick(owner.GetTimers(), owner.GetObjectPool())
 		, m_stackingCategoryId(spell.stacking_category_id())
 	{
 		m_areaAuraTickConnection = m_areaAuraTick.ended.connect(this, &AuraContainer::HandleAreaAuraTick);
@@ -85,7 +85,8 @@ namespace mmo
 		}
 
 		// Add aura to the list of effective auras
-		m_auras.emplace_back(std::make_shared<AuraEffect>(
+		m_auras.emplace_back(MakePooled<AuraEffect>(
+			m_owner.GetObjectPool(),
 			*this,
 			effect,
 			m_owner.GetTimers(),
@@ -361,7 +362,7 @@ namespace mmo
 							if (!player.HasAuraSpellFromCaster(m_spell.id(), m_casterId))
 							{
 								// Apply the aura
-								auto container = std::make_shared<AuraContainer>(player, m_casterId, m_spell, m_duration, m_itemGuid);
+								auto container = MakePooled<AuraContainer>(player.GetObjectPool(), player, m_casterId, m_spell, m_duration, m_itemGuid);
 								for (const auto& effect : m_auras)
 								{
 									container->AddAuraEffect(effect->GetEffect(), effect->GetBasePoints());
@@ -8,7 +8,6 @@
 
 #include "aura_container.h"
 #include "spell_cast.h"
-#include "vector_sink.h"
 #include "base/utilities.h"
 #include "log/default_log_levels.h"
 #include "objects/game_player_s.h"
@@ -22,7 +21,7 @@ namespace mmo
 		, m_basePoints(basePoints)
 		, m_tickInterval(effect.amplitude())
 		, m_effect(effect)
-		, m_tickCountdown(timers)
+		, m_tickCountdown(timers, container.GetOwner().GetObjectPool())
 	{
 		if (const auto* caster = m_container.GetCaster())
 		{
@@ -454,6 +453,25 @@ namespace mmo
 		m_container.GetOwner().ModifyDodgeChanceBonus(static_cast<float>(GetBasePoints()), apply);
 	}
 
+	void AuraEffect::LogPeriodicTick(const uint32 amount) const
+	{
+		GameUnitS& owner = m_container.GetOwner();
+		WorldInstance* world = owner.GetWorldInstance();
+		if (!world)
+		{
+			return;
+		}
+
+		CombatLogEvent event;
+		event.type = combat_log_event::PeriodicAura;
+		event.sourceGuid = m_container.GetCasterId();
+		event.targetGuid = owner.GetGuid();
+		event.spellId = m_container.GetSpell().id();
+		event.subType = GetType();
+		event.amount = amount;
+		world->GetCombatLog().Add(owner, event);
+	}
+
 	void AuraEffect::HandlePeriodicDamage() const
 	{
 		auto strongContainer = m_container.shared_from_this();
@@ -475,27 +493,8 @@ namespace mmo
 
 		// Apply damage bonus from casters spell power
 
-		// Send event to all subscribers in sight
-		std::vector<char> buffer;
-		io::VectorSink sink(buffer);
-		game::OutgoingPacket packet(sink);
-
-		packet.Start(game::realm_client_packet::PeriodicAuraLog);
-		packet
-			<< io::write_packed_guid(strongContainer->GetOwner().GetGuid())
-			<< io::write_packed_guid(strongContainer->GetCasterId())
-			<< io::write<uint32>(strongContainer->GetSpell().id())
-			<< io::write<uint32>(GetType())
-			<< io::write<uint32>(damage)
-			<< io::write<uint32>(school)
-			<< io::write<uint32>(0) // Absorbed
-			<< io::write<uint32>(0); // Resisted
-		packet.Finish();
-
-		strongContainer->GetOwner().ForEachSubscriberInSight([&packet, &buffer](TileSubscriber& subscriber)
-			{
-				subscriber.SendPacket(packet, buffer, true);
-			});
+		// Log the tick for all subscribers in sight
+		LogPeriodicTick(static_cast<uint32>(damage));
 
 		// Update health
 		if (strongContainer->GetOwner().Damage(damage, school, strongContainer->GetCaster(), damage_type::Periodic) > 0)
@@ -535,24 +534,8 @@ namespace mmo
 
 		heal = std::max(heal, 0);
 
-		// Send event to all subscribers in sight
-		std::vector<char> buffer;
-		io::VectorSink sink(buffer);
-		game::OutgoingPacket packet(sink);
-
-		packet.Start(game::realm_client_packet::PeriodicAuraLog);
-		packet
-			<< io::write_packed_guid(m_container.GetOwner().GetGuid())
-			<< io::write_packed_guid(m_container.GetCasterId())
-			<< io::write<uint32>(m_container.GetSpell().id())
-			<< io::write<uint32>(GetType())
-			<< io::write<uint32>(heal);
-		packet.Finish();
-
-		m_container.GetOwner().ForEachSubscriberInSight([&packet, &buffer](TileSubscriber& subscriber)
-			{
-				subscriber.SendPacket(packet, buffer, true);
-			});
+		// Log the tick for all subscribers in sight
+		LogPeriodicTick(static_cast<uint32>(heal));
 
 		// Update health
 		const int32 effectiveHealing = m_container.GetOwner().Heal(heal, m_container.GetCaster());
@@ -596,25 +579,8 @@ namespace mmo
 
 		m_container.GetOwner().Set<uint32>(object_fields::Mana + powerType, curPower);
 
-		// Send event to all subscribers in sight
-		std::vector<char> buffer;
-		io::VectorSink sink(buffer);
-		game::OutgoingPacket packet(sink);
-
-		packet.Start(game::realm_client_packet::PeriodicAuraLog);
-		packet
-			<< io::write_packed_guid(m_container.GetOwner().GetGuid())
-			<< io::write_packed_guid(m_container.GetCasterId())
-			<< io::write<uint32>(m_container.GetSpell().id())
-			<< io::write<uint32>(GetType())
-			<< io::write<uint32>(power);
-		packet.Finish();
-
-		m_container.GetOwner().ForEachSubscriberInSight([&packet, &buffer](TileSubscriber& subscriber)
-			{
-				subscriber.SendPacket(packet, buffer, true);
-			});
-
+		// Log the tick for all subscribers in sight
+		LogPeriodicTick(power);
 	}
 
 	void AuraEffect::HandlePeriodicTriggerSpell() const
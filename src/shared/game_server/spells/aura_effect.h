@@ -122,6 +122,9 @@ namespace mmo
 
 		void HandlePeriodicEnergize();
 
+		/// Adds a periodic tick of this effect to the combat log of the owner's world instance.
+		void LogPeriodicTick(uint32 amount) const;
+
 		void HandlePeriodicTriggerSpell() const;
 
 		void HandleProcForUnitTarget(GameUnitS& unit);
@@ -21,8 +21,8 @@ namespace mmo
 		, m_spell(spell)
 		, m_target(target)
 		, m_hasFinished(false)
-		, m_countdown(cast.GetTimerQueue())
-		, m_impactCountdown(cast.GetTimerQueue())
+		, m_countdown(cast.GetTimerQueue(), cast.GetExecuter().GetObjectPool())
+		, m_impactCountdown(cast.GetTimerQueue(), cast.GetExecuter().GetObjectPool())
 		, m_castTime(castTime)
 		, m_castEnd(0)
 		, m_isProc(isProc)
@@ -1052,7 +1052,7 @@ namespace mmo
 			m_cast.GetExecuter().ApplySpellMod(spell_mod_op::Duration, m_spell.id(), duration);
 		}
 
-		auto& container = (m_targetAuraContainers[targetGuid] = std::make_unique<AuraContainer>(target, m_cast.GetExecuter().GetGuid(), m_spell, duration, m_itemGuid));
+		auto& container = (m_targetAuraContainers[targetGuid] = MakePooled<AuraContainer>(target.GetObjectPool(), target, m_cast.GetExecuter().GetGuid(), m_spell, duration, m_itemGuid));
 		return *container;
 	}
 
@@ -161,7 +161,7 @@ namespace mmo
 		void OnUserDamaged();
 		void ExecuteMeleeAttack();
 
-		std::unordered_map<uint64, std::unique_ptr<AuraContainer>> m_targetAuraContainers;
+		std::unordered_map<uint64, std::shared_ptr<AuraContainer>> m_targetAuraContainers;
 		uint64 m_itemGuid;
 		SpellCastContext m_context;
 		SpellTargetResolver m_targetResolver;
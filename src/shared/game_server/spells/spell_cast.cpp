@@ -12,7 +12,7 @@ namespace mmo
 {
 	void CastSpell(SpellCast& cast, const proto::SpellEntry& spell, const SpellTargetMap& target, GameTime castTime, uint64 itemGuid, bool isProc)
 	{
-		auto newState = std::make_shared<SingleCastState>(cast, spell, target, castTime, isProc, itemGuid);
+		auto newState = MakePooled<SingleCastState>(cast.GetExecuter().GetObjectPool(), cast, spell, target, castTime, isProc, itemGuid);
 
 		cast.SetState(std::move(newState));
 	}
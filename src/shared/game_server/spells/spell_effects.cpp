@@ -374,19 +374,17 @@ namespace mmo
 				executer.TriggerProcEvent(spell_proc_flags::DoneSpellMagicDmgClassPos, &unitTarget, healingAmount, procFlags, spell.spellschool(), false, spell.familyflags());
 				unitTarget.TriggerProcEvent(spell_proc_flags::TakenSpellMagicDmgClassPos, &executer, healingAmount, procFlags, spell.spellschool(), false, spell.familyflags());
 
-				const uint32 spellId = spell.id();
-				ctx.castContext.SendPacketFromCaster(
-					[&unitTarget, &executer, spellId, healingAmount, isCrit](game::OutgoingPacket& out_packet)
-					{
-						out_packet.Start(game::realm_client_packet::SpellHealLog);
-						out_packet
-							<< io::write_packed_guid(unitTarget.GetGuid())
-							<< io::write_packed_guid(executer.GetGuid())
-							<< io::write<uint32>(spellId)
-							<< io::write<uint32>(healingAmount)
-							<< io::write<uint8>(isCrit);
-						out_packet.Finish();
-					});
+				if (WorldInstance* world = ctx.castContext.GetWorldInstance())
+				{
+					CombatLogEvent event;
+					event.type = combat_log_event::SpellHeal;
+					event.sourceGuid = executer.GetGuid();
+					event.targetGuid = unitTarget.GetGuid();
+					event.spellId = spell.id();
+					event.amount = healingAmount;
+					event.flags = isCrit ? 1 : 0;
+					world->GetCombatLog().Add(executer, event);
+				}
 			}
 		}
 
@@ -507,20 +505,17 @@ namespace mmo
 
 				unitTarget.Set<uint32>(object_fields::Mana + powerType, curPower);
 
-				const uint32 finalPower = power;
-				const int32_t finalPowerType = powerType;
-				ctx.castContext.SendPacketFromCaster(
-					[&unitTarget, &executer, spellId, finalPowerType, finalPower](game::OutgoingPacket& out_packet)
-					{
-						out_packet.Start(game::realm_client_packet::SpellEnergizeLog);
-						out_packet
-							<< io::write_packed_guid(unitTarget.GetGuid())
-							<< io::write_packed_guid(executer.GetGuid())
-							<< io::write<uint32>(spellId)
-							<< io::write<uint32>(finalPowerType)
-							<< io::write<uint32>(finalPower);
-						out_packet.Finish();
-					});
+				if (WorldInstance* world = ctx.castContext.GetWorldInstance())
+				{
+					CombatLogEvent event;
+					event.type = combat_log_event::SpellEnergize;
+					event.sourceGuid = executer.GetGuid();
+					event.targetGuid = unitTarget.GetGuid();
+					event.spellId = spellId;
+					event.subType = static_cast<uint32>(powerType);
+					event.amount = power;
+					world->GetCombatLog().Add(executer, event);
+				}
 			}
 		}
 
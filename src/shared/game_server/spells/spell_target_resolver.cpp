@@ -157,7 +157,8 @@ namespace mmo
 			return false;
 		}
 
-		// Area-of-effect LOS check: each candidate must be visible from the caster.
+		// Area-of-effect LOS check: each candidate must be visible from the caster. This is the most expensive
+		// check, so callers should run their faction filters before calling this method.
 		// Skipped for the caster themselves, passive spells, and spells with IgnoreLineOfSight.
 		const bool isSelf     = (&unit == &m_context.GetExecutor());
 		const bool isPassive  = (m_context.GetSpell().attributes(0) & spell_attributes::Passive) != 0;
@@ -207,45 +208,44 @@ namespace mmo
 		}
 
 		const auto& position = m_context.GetExecutor().GetPosition();
-		world->GetUnitFinder().FindUnits(Circle(position.x, position.z, effect.radius()), [this, &effect, &targets, isPartyTargetType](GameUnitS& unit)
-		{
-			if (!CanAddUnitTarget(targets, unit))
-			{
-				return true;
-			}
 
+		// Geometric cull first, then the cheap faction and group checks, and only then the line of sight test
+		m_candidateUnits.clear();
+		world->GetUnitFinder().FindUnitsInRadius(Circle(position.x, position.z, effect.radius()), m_candidateUnits);
+
+		for (GameUnitS* unit : m_candidateUnits)
+		{
 			if (isPartyTargetType)
 			{
-				if (unit.IsPlayer() && unit.AsPlayer().GetGroupId() == m_context.GetExecutor().AsPlayer().GetGroupId())
+				if (!unit->IsPlayer() || unit->AsPlayer().GetGroupId() != m_context.GetExecutor().AsPlayer().GetGroupId())
 				{
-					targets.push_back(&unit);
+					continue;
 				}
-				return true;
 			}
-
-			if (effect.targeta() == spell_effect_targets::NearbyAlly)
+			else if (effect.targeta() == spell_effect_targets::NearbyAlly)
 			{
-				if (!m_context.GetExecutor().UnitIsFriendly(unit))
+				if (!m_context.GetExecutor().UnitIsFriendly(*unit))
 				{
-					return true;
+					continue;
 				}
-
-				targets.push_back(&unit);
-				return true;
 			}
-
-			if (effect.targeta() == spell_effect_targets::NearbyEnemy)
+			else if (effect.targeta() == spell_effect_targets::NearbyEnemy)
 			{
-				if (m_context.GetExecutor().UnitIsFriendly(unit))
+				if (m_context.GetExecutor().UnitIsFriendly(*unit))
 				{
-					return true;
+					continue;
 				}
-
-				targets.push_back(&unit);
+			}
+			else
+			{
+				continue;
 			}
 
-			return true;
-		});
+			if (CanAddUnitTarget(targets, *unit))
+			{
+				targets.push_back(unit);
+			}
+		}
 
 		return true;
 	}
@@ -263,21 +263,21 @@ namespace mmo
 			return false;
 		}
 
-		world->GetUnitFinder().FindUnits(Circle(centerX, centerZ, effect.radius()), [this, &targets](GameUnitS& unit)
+		m_candidateUnits.clear();
+		world->GetUnitFinder().FindUnitsInRadius(Circle(centerX, centerZ, effect.radius()), m_candidateUnits);
+
+		for (GameUnitS* unit : m_candidateUnits)
 		{
-			if (!CanAddUnitTarget(targets, unit))
+			if (m_context.GetExecutor().UnitIsFriendly(*unit))
 			{
-				return true;
+				continue;
 			}
 
-			if (m_context.GetExecutor().UnitIsFriendly(unit))
+			if (CanAddUnitTarget(targets, *unit))
 			{
-				return true;
+				targets.push_back(unit);
 			}
-
-			targets.push_back(&unit);
-			return true;
-		});
+		}
 
 		return true;
 	}
@@ -338,30 +338,32 @@ namespace mmo
 		// primary target itself) together with its squared distance to the primary,
 		// then sort nearest-first. Deterministic ordering guarantees that two effects
 		// using this target type within the same cast pick the same unit(s).
+		m_candidateUnits.clear();
+		world->GetUnitFinder().FindUnitsInRadius(Circle(primaryPos.x, primaryPos.z, effect.radius()), m_candidateUnits);
+
 		std::vector<std::pair<float, GameUnitS*>> candidates;
-		world->GetUnitFinder().FindUnits(Circle(primaryPos.x, primaryPos.z, effect.radius()), [this, &targets, &candidates, primaryGuid, &primaryPos](GameUnitS& unit)
+		for (GameUnitS* unit : m_candidateUnits)
 		{
-			if (unit.GetGuid() == primaryGuid)
+			if (unit->GetGuid() == primaryGuid)
 			{
-				return true;
+				continue;
 			}
 
-			if (m_context.GetExecutor().UnitIsFriendly(unit))
+			if (m_context.GetExecutor().UnitIsFriendly(*unit))
 			{
-				return true;
+				continue;
 			}
 
-			if (!CanAddUnitTarget(targets, unit))
+			if (!CanAddUnitTarget(targets, *unit))
 			{
-				return true;
+				continue;
 			}
 
-			const Vector3& unitPos = unit.GetPosition();
+			const Vector3& unitPos = unit->GetPosition();
 			const float dx = unitPos.x - primaryPos.x;
 			const float dz = unitPos.z - primaryPos.z;
-			candidates.emplace_back(dx * dx + dz * dz, &unit);
-			return true;
-		});
+			candidates.emplace_back(dx * dx + dz * dz, unit);
+		}
 
 		std::sort(candidates.begin(), candidates.end(),
 			[](const std::pair<float, GameUnitS*>& a, const std::pair<float, GameUnitS*>& b)
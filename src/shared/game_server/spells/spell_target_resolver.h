@@ -35,5 +35,8 @@ namespace mmo
 		bool ValidateEffectRadius(const proto::SpellEffect& effect) const;
 
 		const SpellCastContext& m_context;
+
+		/// Reusable buffer for the geometric candidates of area target queries.
+		mutable std::vector<GameUnitS*> m_candidateUnits;
 	};
 }
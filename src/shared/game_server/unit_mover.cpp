@@ -265,6 +265,9 @@ namespace mmo
 		// Calculate time of arrival
 		m_moveEnd = moveTime;
 
+		// The interpolated location is now driven by the new path
+		moved.InvalidatePositionCache();
+
 		auto movementInfo = moved.GetMovementInfo();
 		movementInfo.movementFlags &= movement_flags::WalkMode;
 		moved.ApplyMovementInfo(movementInfo);
@@ -437,6 +440,9 @@ namespace mmo
 		m_target = fullPath.back();
 		m_moveEnd = moveTime;
 
+		// The interpolated location is now driven by the new path
+		moved.InvalidatePositionCache();
+
 		auto movementInfo = moved.GetMovementInfo();
 		movementInfo.movementFlags &= movement_flags::WalkMode;
 		moved.ApplyMovementInfo(movementInfo);
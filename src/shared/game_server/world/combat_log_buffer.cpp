@@ -0,0 +1,103 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#include "combat_log_buffer.h"
+#include "each_tile_in_sight.h"
+#include "game_server/objects/game_unit_s.h"
+#include "binary_io/vector_sink.h"
+#include "game_protocol/game_protocol.h"
+
+namespace mmo
+{
+	CombatLogBuffer::CombatLogBuffer(VisibilityGrid& grid, const float relevanceRadius)
+		: m_grid(grid)
+		, m_relevanceRadiusSq(relevanceRadius * relevanceRadius)
+	{
+	}
+
+	void CombatLogBuffer::Add(const GameObjectS& origin, const CombatLogEvent& event)
+	{
+		TileIndex2D tileIndex;
+		if (!m_grid.GetTilePosition(origin.GetPosition(), tileIndex[0], tileIndex[1]))
+		{
+			return;
+		}
+
+		++m_counters.events;
+		Encode(event);
+
+		const Vector3& position = origin.GetPosition();
+		ForEachSubscriberInSight(m_grid, tileIndex, [this, &event, &position](TileSubscriber& subscriber)
+			{
+				const GameUnitS& unit = subscriber.GetGameUnit();
+				const uint64 guid = unit.GetGuid();
+				if (guid != event.sourceGuid && guid != event.targetGuid && unit.GetPosition().GetSquaredDistanceTo(position) > m_relevanceRadiusSq)
+				{
+					++m_counters.irrelevant;
+					return;
+				}
+
+				Append(subscriber);
+			});
+	}
+
+	void CombatLogBuffer::Add(TileSubscriber& subscriber, const CombatLogEvent& event)
+	{
+		++m_counters.events;
+		Encode(event);
+		Append(subscriber);
+	}
+
+	void CombatLogBuffer::RemoveSubscriber(TileSubscriber& subscriber)
+	{
+		m_pending.erase(&subscriber);
+		std::erase(m_pendingSubscribers, &subscriber);
+	}
+
+	void CombatLogBuffer::Flush()
+	{
+		for (TileSubscriber* subscriber : m_pendingSubscribers)
+		{
+			PendingEvents& pending = m_pending[subscriber];
+
+			m_packetBuffer.clear();
+			io::VectorSink sink(m_packetBuffer);
+			game::Protocol::OutgoingPacket packet(sink);
+			packet.Start(game::realm_client_packet::CombatLog);
+			packet
+				<< io::write_var_uint(pending.count)
+				<< io::write_range(pending.data);
+			packet.Finish();
+
+			subscriber->SendPacket(packet, m_packetBuffer);
+
+			++m_counters.packets;
+			m_counters.bytes += m_packetBuffer.size();
+
+			pending.data.clear();
+			pending.count = 0;
+		}
+
+		m_pendingSubscribers.clear();
+	}
+
+	void CombatLogBuffer::Encode(const CombatLogEvent& event)
+	{
+		m_encodedEvent.clear();
+		io::VectorSink sink(m_encodedEvent);
+		io::Writer writer(sink);
+		writer << event;
+	}
+
+	void CombatLogBuffer::Append(TileSubscriber& subscriber)
+	{
+		PendingEvents& pending = m_pending[&subscriber];
+		if (pending.count == 0)
+		{
+			m_pendingSubscribers.push_back(&subscriber);
+		}
+
+		pending.data.insert(pending.data.end(), m_encodedEvent.begin(), m_encodedEvent.end());
+		++pending.count;
+		++m_counters.deliveries;
+	}
+}
@@ -0,0 +1,111 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/typedefs.h"
+#include "base/non_copyable.h"
+#include "game/combat_log.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace mmo
+{
+	class GameObjectS;
+	class TileSubscriber;
+	class VisibilityGrid;
+
+	/// Collects the combat log events of a world instance (damage, heals, power gains and periodic aura ticks) and
+	///	sends them once per tick as a single CombatLog packet per subscriber, instead of one packet per event and
+	///	subscriber. Events are encoded once when they are added and then copied to the pending events of each
+	///	subscriber.
+	///	Subscribers which are farther away from an event than the relevance radius and not involved in it don't
+	///	receive the event at all. They still see the resulting health changes through the regular object updates,
+	///	which are already aggregated per tick.
+	///	Only used from the world's update thread.
+	class CombatLogBuffer final : public NonCopyable
+	{
+	public:
+		/// Default distance in which subscribers receive combat log events of units they are not involved with.
+		static constexpr float DefaultRelevanceRadius = 50.0f;
+
+		/// Counters for monitoring the combat log traffic. Accumulated until ResetCounters is called.
+		struct Counters
+		{
+			/// Number of added events.
+			uint64 events { 0 };
+
+			/// Number of events which were queued for a subscriber.
+			uint64 deliveries { 0 };
+
+			/// Number of events which were not sent to a subscriber in sight because it was too far away.
+			uint64 irrelevant { 0 };
+
+			/// Number of sent CombatLog packets.
+			uint64 packets { 0 };
+
+			/// Number of sent bytes including packet headers.
+			uint64 bytes { 0 };
+		};
+
+	public:
+		explicit CombatLogBuffer(VisibilityGrid& grid, float relevanceRadius = DefaultRelevanceRadius);
+
+	public:
+		/// Queues an event for all subscribers in sight of the given object which are involved in the event or
+		///	within the relevance radius.
+		///	@param origin The object at which the event happened, usually the target of the event.
+		///	@param event The event.
+		void Add(const GameObjectS& origin, const CombatLogEvent& event);
+
+		/// Queues an event only for the given subscriber.
+		void Add(TileSubscriber& subscriber, const CombatLogEvent& event);
+
+		/// Drops all pending events of a subscriber. Must be called before a subscriber is destroyed.
+		void RemoveSubscriber(TileSubscriber& subscriber);
+
+		/// Sends the pending events of each subscriber as one CombatLog packet.
+		void Flush();
+
+		/// Gets the number of subscribers with pending events.
+		[[nodiscard]] size_t GetPendingSubscriberCount() const { return m_pendingSubscribers.size(); }
+
+		[[nodiscard]] const Counters& GetCounters() const { return m_counters; }
+
+		void ResetCounters() { m_counters = Counters(); }
+
+		void SetRelevanceRadius(const float radius) { m_relevanceRadiusSq = radius * radius; }
+
+	private:
+		struct PendingEvents
+		{
+			/// Encoded events.
+			std::vector<char> data;
+
+			uint32 count { 0 };
+		};
+
+		/// Encodes an event into m_encodedEvent.
+		void Encode(const CombatLogEvent& event);
+
+		/// Appends m_encodedEvent to the pending events of a subscriber.
+		void Append(TileSubscriber& subscriber);
+
+	private:
+		VisibilityGrid& m_grid;
+
+		float m_relevanceRadiusSq;
+
+		/// Pending events per subscriber. Entries are kept after a flush, so that their buffers are reused.
+		std::unordered_map<TileSubscriber*, PendingEvents> m_pending;
+
+		/// Subscribers with pending events in the order in which they received their first event.
+		std::vector<TileSubscriber*> m_pendingSubscribers;
+
+		std::vector<char> m_encodedEvent;
+
+		std::vector<char> m_packetBuffer;
+
+		Counters m_counters;
+	};
+}
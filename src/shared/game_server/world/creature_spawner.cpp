@@ -1,6 +1,7 @@
 // Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
 
 #include "creature_spawner.h"
+#include "spawn_scheduler.h"
 #include "world_instance.h"
 #include "world_instance_manager.h"
 #include "objects/game_unit_s.h"
@@ -59,24 +60,23 @@ namespace mmo
 		, m_active(spawnEntry.isactive())
 		, m_respawn(spawnEntry.respawn())
 		, m_currentlySpawned(0)
-		, m_respawnCountdown(world.GetUniverse().GetTimers())
+		, m_scheduledSpawns(0)
+		, m_scheduledRespawns(0)
 		, m_location(spawnEntry.positionx(), spawnEntry.positiony(), spawnEntry.positionz())
 	{
+		// The initial population is spawned by the world's spawn scheduler, which spreads large maps over several ticks
 		if (m_active)
 		{
-			for (size_t i = 0; i < m_spawnEntry.maxcount(); ++i)
-			{
-				SpawnOne();
-			}
+			ScheduleSpawns(m_spawnEntry.maxcount(), GetAsyncTimeMs(), false);
 		}
-
-		m_respawnCountdown.ended.connect(*this, &CreatureSpawner::OnSpawnTime);
 	}
 
 	CreatureSpawner::~CreatureSpawner()
-	= default;
+	{
+		CancelScheduledSpawns();
+	}
 
-	void CreatureSpawner::SpawnOne()
+	std::shared_ptr<GameCreatureS> CreatureSpawner::CreateCreature()
 	{
 		// TODO: Generate random point and if needed, random rotation
 		const Vector3 location(m_spawnEntry.positionx(), m_spawnEntry.positiony(), m_spawnEntry.positionz());
@@ -110,7 +110,6 @@ namespace mmo
 
 		// watch for destruction
 		spawned->destroy = [this]<typename TUnit>(TUnit&& destroyedUnit) { OnRemoval(std::forward<TUnit>(destroyedUnit)); };
-		m_world.AddGameObject(*spawned);
 
 		// Creates are bound to their spawn point
 		spawned->SetBinding(m_world.GetMapId(), location, Radian(o));
@@ -118,12 +117,68 @@ namespace mmo
 		// Remember that creature
 		m_creatures.emplace_back(spawned);
 		++m_currentlySpawned;
+
+		return spawned;
 	}
 
-	void CreatureSpawner::OnSpawnTime()
+	GameCreatureS* CreatureSpawner::CreateScheduledSpawn(const bool respawn)
 	{
-		SpawnOne();
-		SetRespawnTimer();
+		ASSERT(m_scheduledSpawns > 0);
+		--m_scheduledSpawns;
+
+		if (respawn)
+		{
+			ASSERT(m_scheduledRespawns > 0);
+			--m_scheduledRespawns;
+		}
+
+		if (!m_active || m_currentlySpawned >= m_spawnEntry.maxcount())
+		{
+			return nullptr;
+		}
+
+		return CreateCreature().get();
+	}
+
+	void CreatureSpawner::ScheduleSpawns(const size_t count, const GameTime dueTime, const bool respawn)
+	{
+		SpawnScheduler& scheduler = m_world.GetSpawnScheduler();
+		for (size_t i = 0; i < count; ++i)
+		{
+			scheduler.Schedule(*this, dueTime, respawn);
+		}
+
+		m_scheduledSpawns += count;
+		if (respawn)
+		{
+			m_scheduledRespawns += count;
+		}
+	}
+
+	void CreatureSpawner::CancelScheduledSpawns()
+	{
+		if (m_scheduledSpawns == 0)
+		{
+			return;
+		}
+
+		m_world.GetSpawnScheduler().Cancel(*this);
+		m_scheduledSpawns = 0;
+		m_scheduledRespawns = 0;
+	}
+
+	void CreatureSpawner::CancelScheduledRespawns()
+	{
+		if (m_scheduledRespawns == 0)
+		{
+			return;
+		}
+
+		const size_t removed = m_world.GetSpawnScheduler().Cancel(*this, true);
+		ASSERT(removed == m_scheduledRespawns);
+
+		m_scheduledSpawns -= removed;
+		m_scheduledRespawns = 0;
 	}
 
 	void CreatureSpawner::OnRemoval(GameObjectS& removed)
@@ -151,13 +206,13 @@ namespace mmo
 			return;
 		}
 
-		if (m_currentlySpawned >= m_spawnEntry.maxcount())
+		const size_t expected = m_currentlySpawned + m_scheduledSpawns;
+		if (expected >= m_spawnEntry.maxcount())
 		{
 			return;
 		}
 
-		m_respawnCountdown.SetEnd(
-			GetAsyncTimeMs() + m_spawnEntry.respawndelay());
+		ScheduleSpawns(m_spawnEntry.maxcount() - expected, GetAsyncTimeMs() + m_spawnEntry.respawndelay(), true);
 	}
 
 	const Vector3& CreatureSpawner::RandomPoint()
@@ -182,15 +237,21 @@ namespace mmo
 
 		if (active && !m_currentlySpawned)
 		{
-			m_respawnCountdown.Cancel();
+			CancelScheduledSpawns();
+
+			// Spawned right away since triggers may refer to the creatures immediately, but still added as one batch
+			std::vector<GameObjectS*> spawned;
+			spawned.reserve(m_spawnEntry.maxcount());
 			for (size_t i = 0; i < m_spawnEntry.maxcount(); ++i)
 			{
-				SpawnOne();
+				spawned.push_back(CreateCreature().get());
 			}
+
+			m_world.AddGameObjects(spawned);
 		}
 		else if (!active)
 		{
-			m_respawnCountdown.Cancel();
+			CancelScheduledSpawns();
 		}
 	}
 
@@ -200,7 +261,7 @@ namespace mmo
 		{
 			if (!enabled)
 			{
-				m_respawnCountdown.Cancel();
+				CancelScheduledRespawns();
 			}
 			else
 			{
@@ -3,9 +3,11 @@
 #pragma once
 
 #include "base/typedefs.h"
-#include "base/countdown.h"
 #include "math/vector3.h"
 
+#include <memory>
+#include <vector>
+
 namespace mmo
 {
 	class WorldInstance;
@@ -60,17 +62,29 @@ namespace mmo
 		/// Gets a random movement point in the spawn radius.
 		const Vector3& RandomPoint();
 
+		/// Called by the world's SpawnScheduler when a scheduled spawn of this spawner is executed. The returned
+		///	creature is owned by this spawner but still needs to be added to the world by the caller.
+		///	@param respawn Whether the executed spawn was scheduled as a respawn.
+		///	@returns The new creature or nullptr, if the spawner is inactive or already at its maximum count.
+		GameCreatureS* CreateScheduledSpawn(bool respawn);
+
 	private:
-		/// Spawns one more creature and adds it to the world.
-		void SpawnOne();
+		/// Creates one more creature and takes ownership of it. The creature is not added to the world.
+		std::shared_ptr<GameCreatureS> CreateCreature();
+
+		/// Schedules the given number of spawns at the world's SpawnScheduler.
+		void ScheduleSpawns(size_t count, GameTime dueTime, bool respawn);
+
+		/// Cancels all scheduled spawns of this spawner.
+		void CancelScheduledSpawns();
 
-		/// Callback which is fired after a respawn delay invalidated.
-		void OnSpawnTime();
+		/// Cancels the scheduled respawns of this spawner, but keeps the spawns of the initial population.
+		void CancelScheduledRespawns();
 
 		/// Callback which is fired after a creature despawned.
 		void OnRemoval(GameObjectS& removed);
 
-		/// Setup a new respawn timer.
+		/// Schedules respawns for all creatures which are missing and not yet scheduled.
 		void SetRespawnTimer();
 
 	private:
@@ -81,8 +95,9 @@ namespace mmo
 		bool m_active;
 		bool m_respawn;
 		size_t m_currentlySpawned;
+		size_t m_scheduledSpawns;
+		size_t m_scheduledRespawns;
 		OwnedCreatures m_creatures;
-		Countdown m_respawnCountdown;
 		Vector3 m_location;
 		Vector3 m_randomPoint;
 	};
@@ -0,0 +1,40 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "math/vector3.h"
+
+#include <vector>
+
+namespace mmo
+{
+	class MapData
+	{
+	public:
+		virtual ~MapData() = default;
+
+		/// @brief Checks whether posA can see posB without obstruction.
+		virtual bool IsInLineOfSight(const Vector3& posA, const Vector3& posB) = 0;
+
+		/// @brief Like IsInLineOfSight but also reports the hit position when blocked.
+		/// @param posA Source position.
+		/// @param posB Destination position.
+		/// @param hitPoint Set to the obstruction point when returning false, or to posB when returning true.
+		/// @return true when the ray reaches posB unobstructed.
+		virtual bool IsInLineOfSightEx(const Vector3& posA, const Vector3& posB, Vector3& hitPoint) = 0;
+
+		virtual bool CalculatePath(const Vector3& start, const Vector3& destination, std::vector<Vector3>& out_path) const = 0;
+
+		virtual bool FindRandomPointAroundCircle(const Vector3& centerPosition, float radius, Vector3& randomPoint) const = 0;
+
+		/// @brief Gets the water surface height at the given world position, if water is present.
+		/// @param pos World position to query (only X/Z are used).
+		/// @param outSurfaceY Receives the water surface height (Y) when water is present.
+		/// @return True when there is water at the position, false otherwise.
+		virtual bool GetWaterSurface(const Vector3& pos, float& outSurfaceY) const = 0;
+
+		/// @brief Returns true if server-side water data is loaded for this map. When false, swim
+		/// validation is skipped (the server trusts the client) rather than rejecting all swimming.
+		virtual bool IsWaterDataAvailable() const = 0;
+	};
+}
@@ -0,0 +1,73 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#include "movement_validator.h"
+#include "map_data.h"
+
+#include <cmath>
+
+namespace mmo
+{
+	bool MovementValidator::CheckSpeed(const Vector3& from, const Vector3& to, const float elapsedSeconds, const float maxSpeed, float& outImpliedSpeed)
+	{
+		++m_counters.speedChecks;
+
+		// Compare squared distances, so that only violations need a square root
+		const float maxDistance = maxSpeed * elapsedSeconds;
+		const float distanceSq = (to - from).GetSquaredLength();
+		if (distanceSq <= maxDistance * maxDistance)
+		{
+			return true;
+		}
+
+		++m_counters.violations;
+		outImpliedSpeed = std::sqrt(distanceSq) / elapsedSeconds;
+		return false;
+	}
+
+	bool MovementValidator::CheckWater(const uint64 guid, const Vector3& position, MapData* mapData)
+	{
+		// Without water data the server trusts the client, like it did before water data was available
+		if (!mapData || !mapData->IsWaterDataAvailable())
+		{
+			return true;
+		}
+
+		// Water presence is stored per quad, so a unit which stays inside its verified quad can't have left the water.
+		// Positions outside of the terrain have no quad and are always checked.
+		const uint64 quad = ServerWaterMap::GetQuadKey(position.x, position.z);
+		if (quad != ServerWaterMap::InvalidQuadKey)
+		{
+			if (const auto it = m_verifiedWaterQuads.find(guid); it != m_verifiedWaterQuads.end() && it->second == quad)
+			{
+				++m_counters.waterChecksSkipped;
+				return true;
+			}
+		}
+
+		++m_counters.waterChecks;
+
+		float surfaceY = 0.0f;
+		if (mapData->GetWaterSurface(position, surfaceY))
+		{
+			if (quad != ServerWaterMap::InvalidQuadKey)
+			{
+				m_verifiedWaterQuads[guid] = quad;
+			}
+
+			return true;
+		}
+
+		++m_counters.violations;
+		return false;
+	}
+
+	void MovementValidator::ConfirmWater(const uint64 guid, const Vector3& position)
+	{
+		m_verifiedWaterQuads[guid] = ServerWaterMap::GetQuadKey(position.x, position.z);
+	}
+
+	void MovementValidator::Remove(const uint64 guid)
+	{
+		m_verifiedWaterQuads.erase(guid);
+	}
+}
@@ -0,0 +1,73 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/typedefs.h"
+#include "base/non_copyable.h"
+#include "math/vector3.h"
+#include "server_water_map.h"
+
+#include <unordered_map>
+
+namespace mmo
+{
+	class MapData;
+
+	/// Validates the client movement of the players in a world instance while their movement packets are handled.
+	///	Water presence is stored per quad, so a swimming player is only checked against the water geometry once they
+	///	left the water quad that was last verified for them. Only used from the world's update thread.
+	class MovementValidator final : public NonCopyable
+	{
+	public:
+		/// Counters for monitoring the validation cost. Accumulated until ResetCounters is called.
+		struct Counters
+		{
+			/// Number of executed speed checks.
+			uint64 speedChecks { 0 };
+
+			/// Number of swimming positions which stayed in an already verified water quad.
+			uint64 waterChecksSkipped { 0 };
+
+			/// Number of executed water geometry checks.
+			uint64 waterChecks { 0 };
+
+			/// Number of detected violations.
+			uint64 violations { 0 };
+		};
+
+	public:
+		/// Checks whether a movement exceeds the allowed speed.
+		///	@param from The position of the previous position update.
+		///	@param to The position reported by the client.
+		///	@param elapsedSeconds Seconds passed since the previous position update. Must be greater than zero.
+		///	@param maxSpeed The allowed speed including tolerance.
+		///	@param outImpliedSpeed Receives the speed implied by the movement if it is too fast.
+		///	@returns false if the movement is too fast.
+		bool CheckSpeed(const Vector3& from, const Vector3& to, float elapsedSeconds, float maxSpeed, float& outImpliedSpeed);
+
+		/// Checks whether a swimming unit is over water.
+		///	@param guid Guid of the swimming unit.
+		///	@param position The position reported by the client.
+		///	@param mapData Map data used for the check. Every position is accepted if null or if the map has no water
+		///	               data.
+		///	@returns false if the unit is not over water, in which case the movement has to be rejected.
+		bool CheckWater(uint64 guid, const Vector3& position, MapData* mapData);
+
+		/// Marks the water at the given position as verified for a unit, so that further swimming positions inside the
+		///	same water quad don't need a geometry check.
+		void ConfirmWater(uint64 guid, const Vector3& position);
+
+		/// Removes the verified water quad of a unit.
+		void Remove(uint64 guid);
+
+		[[nodiscard]] const Counters& GetCounters() const { return m_counters; }
+
+		void ResetCounters() { m_counters = Counters(); }
+
+	private:
+		/// Last water quad in which each unit was verified to be over water.
+		std::unordered_map<uint64, uint64> m_verifiedWaterQuads;
+
+		Counters m_counters;
+	};
+}
@@ -147,7 +147,7 @@ namespace mmo
 		return (it != m_pages.end()) ? &it->second : nullptr;
 	}
 
-	bool ServerWaterMap::HasWater(const float x, const float z) const
+	bool ServerWaterMap::LocateQuad(const float x, const float z, QuadLocation& outLocation)
 	{
 		const float halfW = static_cast<float>(PageGridSize * constants::PageSize) * 0.5f;
 		const int32 pageX = static_cast<int32>(std::floor((x + halfW) / constants::PageSize));
@@ -157,12 +157,6 @@ namespace mmo
 			return false;
 		}
 
-		const PageWater* page = GetPage(static_cast<uint32>(pageX), static_cast<uint32>(pageZ));
-		if (!page)
-		{
-			return false;
-		}
-
 		const float pageOriginX = static_cast<float>((pageX - PageCenter) * constants::PageSize);
 		const float pageOriginZ = static_cast<float>((pageZ - PageCenter) * constants::PageSize);
 		const float tileSizeF = static_cast<float>(constants::TileSize);
@@ -177,16 +171,50 @@ namespace mmo
 
 		const float tileLocalX = (x - pageOriginX) - tileX * tileSizeF;
 		const float tileLocalZ = (z - pageOriginZ) - tileZ * tileSizeF;
-		const uint32 qx = std::min(static_cast<uint32>(tileLocalX / quadSizeF), 7u);
-		const uint32 qz = std::min(static_cast<uint32>(tileLocalZ / quadSizeF), 7u);
+		outLocation.pageX = pageX;
+		outLocation.pageZ = pageZ;
+		outLocation.tileX = tileX;
+		outLocation.tileZ = tileZ;
+		outLocation.quadX = std::min(static_cast<uint32>(tileLocalX / quadSizeF), 7u);
+		outLocation.quadZ = std::min(static_cast<uint32>(tileLocalZ / quadSizeF), 7u);
+		return true;
+	}
+
+	bool ServerWaterMap::HasWater(const float x, const float z) const
+	{
+		QuadLocation location;
+		if (!LocateQuad(x, z, location))
+		{
+			return false;
+		}
+
+		const PageWater* page = GetPage(static_cast<uint32>(location.pageX), static_cast<uint32>(location.pageZ));
+		if (!page)
+		{
+			return false;
+		}
 
-		const auto maskIt = page->quadMasks.find(static_cast<uint16>(tileX + tileZ * constants::TilesPerPage));
+		const auto maskIt = page->quadMasks.find(static_cast<uint16>(location.tileX + location.tileZ * constants::TilesPerPage));
 		if (maskIt == page->quadMasks.end())
 		{
 			return false;
 		}
 
-		return (maskIt->second & (1ULL << (qx + qz * 8))) != 0;
+		return (maskIt->second & (1ULL << (location.quadX + location.quadZ * 8))) != 0;
+	}
+
+	uint64 ServerWaterMap::GetQuadKey(const float x, const float z)
+	{
+		QuadLocation location;
+		if (!LocateQuad(x, z, location))
+		{
+			return InvalidQuadKey;
+		}
+
+		const uint64 page = static_cast<uint64>(location.pageX) + static_cast<uint64>(location.pageZ) * constants::MaxPages;
+		const uint64 tile = location.tileX + location.tileZ * constants::TilesPerPage;
+		const uint64 quad = location.quadX + location.quadZ * 8;
+		return (page * constants::TilesPerPage * constants::TilesPerPage + tile) * 64 + quad;
 	}
 
 	bool ServerWaterMap::GetWaterSurface(const float x, const float z, float& outSurfaceY) const
@@ -22,6 +22,10 @@ namespace mmo
 	/// Modeled on ServerCollisionMap: pages are loaded once on construction and absent pages skipped.
 	class ServerWaterMap final : public NonCopyable
 	{
+	public:
+		/// Returned by GetQuadKey for positions outside of the terrain.
+		static constexpr uint64 InvalidQuadKey = ~0ull;
+
 	public:
 		/// @brief Loads all water data for the given map.
 		/// @param mapName The map directory name (same as proto::MapEntry::directory()).
@@ -39,7 +43,27 @@ namespace mmo
 		/// @return True when there is water at the position, false otherwise.
 		[[nodiscard]] bool GetWaterSurface(float x, float z, float& outSurfaceY) const;
 
+		/// @brief Gets a key which identifies the water quad containing the given world XZ position.
+		/// Water presence is stored per quad, so all positions with the same key share the same HasWater result and
+		/// a water check only has to be repeated once a position moves into another quad.
+		/// @return The quad key, or InvalidQuadKey if the position is outside of the terrain.
+		[[nodiscard]] static uint64 GetQuadKey(float x, float z);
+
 	private:
+		/// @brief Location of a water quad within the terrain page grid.
+		struct QuadLocation
+		{
+			int32 pageX;
+			int32 pageZ;
+			uint32 tileX;
+			uint32 tileZ;
+			uint32 quadX;
+			uint32 quadZ;
+		};
+
+		/// Locates the water quad containing the given world XZ position. Returns false if outside of the terrain.
+		static bool LocateQuad(float x, float z, QuadLocation& outLocation);
+
 		/// @brief Water data for a single terrain page.
 		struct PageWater
 		{
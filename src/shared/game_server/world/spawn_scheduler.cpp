@@ -0,0 +1,82 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "spawn_scheduler.h"
+#include "creature_spawner.h"
+#include "world_instance.h"
+#include "game_server/objects/game_creature_s.h"
+
+#include <algorithm>
+
+namespace mmo
+{
+	SpawnScheduler::SpawnScheduler(WorldInstance& world, const std::chrono::steady_clock::duration budget)
+		: m_world(world)
+		, m_budget(budget)
+	{
+	}
+
+	void SpawnScheduler::Schedule(CreatureSpawner& spawner, const GameTime dueTime, const bool respawn)
+	{
+		// Buckets are due once they begin, so that spawns which are due right away are executed on the next tick. Other
+		// spawns may be executed up to one bucket early, which is negligible compared to respawn delays.
+		const GameTime bucket = dueTime / BucketSize * BucketSize;
+		m_buckets[bucket].push_back({ &spawner, respawn });
+		++m_pendingCount;
+	}
+
+	size_t SpawnScheduler::Cancel(const CreatureSpawner& spawner, const bool respawnsOnly)
+	{
+		const auto matches = [&spawner, respawnsOnly](const PendingSpawn& pending)
+		{
+			return pending.spawner == &spawner && (pending.respawn || !respawnsOnly);
+		};
+
+		size_t removed = std::erase_if(m_ready, matches);
+
+		for (auto it = m_buckets.begin(); it != m_buckets.end(); )
+		{
+			removed += std::erase_if(it->second, matches);
+			it = it->second.empty() ? m_buckets.erase(it) : std::next(it);
+		}
+
+		m_pendingCount -= removed;
+		return removed;
+	}
+
+	size_t SpawnScheduler::Update(const GameTime now)
+	{
+		// Queue all due buckets behind the spawns which did not fit into the budget of the last tick
+		while (!m_buckets.empty() && m_buckets.begin()->first <= now)
+		{
+			const Bucket& due = m_buckets.begin()->second;
+			m_ready.insert(m_ready.end(), due.begin(), due.end());
+			m_buckets.erase(m_buckets.begin());
+		}
+
+		if (m_ready.empty())
+		{
+			return 0;
+		}
+
+		const auto deadline = std::chrono::steady_clock::now() + m_budget;
+
+		std::vector<GameObjectS*> batch;
+		do
+		{
+			const PendingSpawn pending = m_ready.front();
+			m_ready.pop_front();
+			--m_pendingCount;
+
+			if (GameCreatureS* creature = pending.spawner->CreateScheduledSpawn(pending.respawn))
+			{
+				batch.push_back(creature);
+			}
+		}
+		while (!m_ready.empty() && std::chrono::steady_clock::now() < deadline);
+
+		// Add all creatures at once so that watchers receive a single spawn notification
+		m_world.AddGameObjects(batch);
+
+		return batch.size();
+	}
+}
@@ -0,0 +1,86 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/typedefs.h"
+#include "base/non_copyable.h"
+
+#include <chrono>
+#include <deque>
+#include <map>
+#include <vector>
+
+namespace mmo
+{
+	class WorldInstance;
+	class CreatureSpawner;
+
+	/// Collects the creature spawns of a world instance and executes them in batches at the start of a world tick.
+	///	Spawns which become due in the same tick are added to the world together, so that every watcher receives one
+	///	spawn notification for all new creatures in sight instead of one per creature. The time spent on spawning per
+	///	tick is limited by a budget, so the initial population of a map is spread over several ticks.
+	class SpawnScheduler final : public NonCopyable
+	{
+	public:
+		/// Granularity of the due time buckets in milliseconds. Spawns which are due within the same bucket are
+		///	executed together.
+		static constexpr GameTime BucketSize = 100;
+
+		/// Default time that may be spent on spawning creatures per tick.
+		static constexpr std::chrono::microseconds DefaultBudget { 4000 };
+
+	public:
+		/// Creates a new spawn scheduler for the given world instance.
+		///	@param world The world instance to add spawned creatures to.
+		///	@param budget Time that may be spent on spawning creatures per tick. At least one creature is spawned
+		///	              per tick, no matter how small the budget is.
+		explicit SpawnScheduler(WorldInstance& world, std::chrono::steady_clock::duration budget = DefaultBudget);
+
+	public:
+		/// Schedules a single spawn of the given spawner.
+		///	@param spawner The spawner which should spawn a creature.
+		///	@param dueTime The earliest time at which the creature should be spawned.
+		///	@param respawn Whether this spawn replaces a creature that died or despawned, as opposed to a spawn
+		///	               of the initial population.
+		void Schedule(CreatureSpawner& spawner, GameTime dueTime, bool respawn = false);
+
+		/// Removes pending spawns of the given spawner.
+		///	@param spawner The spawner whose spawns should be removed.
+		///	@param respawnsOnly If true, only respawns are removed and the initial population is still spawned.
+		///	@returns Number of removed spawns.
+		size_t Cancel(const CreatureSpawner& spawner, bool respawnsOnly = false);
+
+		/// Executes all spawns which are due at the given time, as long as the time budget allows it. Due spawns
+		///	which exceed the budget are executed in the next call.
+		///	@param now The current time.
+		///	@returns Number of spawned creatures.
+		size_t Update(GameTime now);
+
+		/// Gets the number of spawns which have not been executed yet, including spawns which are not due yet.
+		[[nodiscard]] size_t GetPendingCount() const { return m_pendingCount; }
+
+		/// Sets the time that may be spent on spawning creatures per tick.
+		void SetBudget(const std::chrono::steady_clock::duration budget) { m_budget = budget; }
+
+	private:
+		struct PendingSpawn
+		{
+			CreatureSpawner* spawner;
+
+			bool respawn;
+		};
+
+		typedef std::vector<PendingSpawn> Bucket;
+
+		WorldInstance& m_world;
+		std::chrono::steady_clock::duration m_budget;
+
+		/// Spawns which are not due yet, keyed by the start of their due time bucket.
+		std::map<GameTime, Bucket> m_buckets;
+
+		/// Spawns which are due but did not fit into the budget of a previous tick, in order of their due time.
+		std::deque<PendingSpawn> m_ready;
+
+		size_t m_pendingCount { 0 };
+	};
+}
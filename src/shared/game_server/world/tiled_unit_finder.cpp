@@ -6,6 +6,8 @@
 #include "tiled_unit_finder_tile.h"
 #include "tiled_unit_watcher.h"
 
+#include <cmath>
+
 namespace mmo
 {
 	namespace
@@ -67,26 +69,11 @@ namespace mmo
 		const Circle& shape,
 		const std::function<bool(GameUnitS&)>& resultHandler)
 	{
-		const auto boundingBox = shape.GetBoundingRect();
-		auto topLeft = GetTilePosition(boundingBox[1]);
-		auto bottomRight = GetTilePosition(boundingBox[0]);
+		TileIndex2D topLeft, bottomRight;
+		GetTileRange(shape, topLeft, bottomRight);
 
 		Tile::UnitSet iterationCopyTile;
 
-		// Crash protection
-		if (topLeft[0] < 0) {
-			topLeft[0] = 0;
-		}
-		if (topLeft[1] < 0) {
-			topLeft[1] = 0;
-		}
-		if (bottomRight[0] >= m_grid.width()) {
-			bottomRight[0] = m_grid.width() - 1;
-		}
-		if (bottomRight[1] >= m_grid.height()) {
-			bottomRight[1] = m_grid.height() - 1;
-		}
-
 		for (auto x = topLeft[0]; x <= bottomRight[0]; ++x)
 		{
 			for (auto y = topLeft[1]; y <= bottomRight[1]; ++y)
@@ -109,6 +96,80 @@ namespace mmo
 		}
 	}
 
+	void TiledUnitFinder::FindUnitsInRadius(const Circle& shape, std::vector<GameUnitS*>& out_units)
+	{
+		TileIndex2D topLeft, bottomRight;
+		GetTileRange(shape, topLeft, bottomRight);
+
+		for (auto x = topLeft[0]; x <= bottomRight[0]; ++x)
+		{
+			for (auto y = topLeft[1]; y <= bottomRight[1]; ++y)
+			{
+				const auto& tile = m_grid(x, y);
+				if (!tile || tile->GetUnits().empty())
+				{
+					continue;
+				}
+
+				const Tile::PositionSnapshot& snapshot = tile->GetPositionSnapshot(m_snapshotGeneration);
+
+				m_indexBuffer.clear();
+				FilterPointsInRadius(snapshot.x.data(), snapshot.z.data(), snapshot.Size(), shape.x, shape.y, shape.radius, m_indexBuffer);
+
+				for (const uint32 index : m_indexBuffer)
+				{
+					out_units.push_back(snapshot.entries[index]);
+				}
+			}
+		}
+	}
+
+	void TiledUnitFinder::FindUnitsInCone(const Circle& shape, const Vector3& direction, const Radian& arc, std::vector<GameUnitS*>& out_units)
+	{
+		Vector<float, 2> planarDirection(direction.x, direction.z);
+		const float directionLength = std::sqrt(planarDirection.lengthSq());
+		if (directionLength <= 0.0f)
+		{
+			return;
+		}
+
+		planarDirection[0] /= directionLength;
+		planarDirection[1] /= directionLength;
+
+		const float cosHalfArc = std::cos(arc.GetValueRadians() * 0.5f);
+
+		TileIndex2D topLeft, bottomRight;
+		GetTileRange(shape, topLeft, bottomRight);
+
+		for (auto x = topLeft[0]; x <= bottomRight[0]; ++x)
+		{
+			for (auto y = topLeft[1]; y <= bottomRight[1]; ++y)
+			{
+				const auto& tile = m_grid(x, y);
+				if (!tile || tile->GetUnits().empty())
+				{
+					continue;
+				}
+
+				const Tile::PositionSnapshot& snapshot = tile->GetPositionSnapshot(m_snapshotGeneration);
+
+				m_indexBuffer.clear();
+				FilterPointsInCone(snapshot.x.data(), snapshot.z.data(), snapshot.Size(), shape.x, shape.y, shape.radius,
+					planarDirection[0], planarDirection[1], cosHalfArc, m_indexBuffer);
+
+				for (const uint32 index : m_indexBuffer)
+				{
+					out_units.push_back(snapshot.entries[index]);
+				}
+			}
+		}
+	}
+
+	void TiledUnitFinder::InvalidatePositionSnapshots()
+	{
+		++m_snapshotGeneration;
+	}
+
 	std::unique_ptr<UnitWatcher> TiledUnitFinder::WatchUnits(const Circle& shape, std::function<bool(GameUnitS&, bool)> visibilityChanged)
 	{
 		return std::make_unique<TiledUnitWatcher>(shape, *this, std::move(visibilityChanged));
@@ -135,6 +196,27 @@ namespace mmo
 		return output;
 	}
 
+	void TiledUnitFinder::GetTileRange(const Circle& shape, TileIndex2D& out_topLeft, TileIndex2D& out_bottomRight) const
+	{
+		const auto boundingBox = shape.GetBoundingRect();
+		out_topLeft = GetTilePosition(boundingBox[1]);
+		out_bottomRight = GetTilePosition(boundingBox[0]);
+
+		// Crash protection
+		if (out_topLeft[0] < 0) {
+			out_topLeft[0] = 0;
+		}
+		if (out_topLeft[1] < 0) {
+			out_topLeft[1] = 0;
+		}
+		if (out_bottomRight[0] >= m_grid.width()) {
+			out_bottomRight[0] = m_grid.width() - 1;
+		}
+		if (out_bottomRight[1] >= m_grid.height()) {
+			out_bottomRight[1] = m_grid.height() - 1;
+		}
+	}
+
 	TiledUnitFinder::Tile& TiledUnitFinder::GetUnitsTile(const GameUnitS& findable)
 	{
 		const Vector3& position = findable.GetPosition();
@@ -148,6 +230,7 @@ namespace mmo
 		UnitRecord& record = RequireRecord(findable);
 		if (&currentTile == record.lastTile)
 		{
+			currentTile.InvalidatePositionSnapshot();
 			(*currentTile.moved)(findable);
 			return;
 		}
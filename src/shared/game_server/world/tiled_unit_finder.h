@@ -19,6 +19,9 @@ namespace mmo
 		void RemoveUnit(GameUnitS& findable) override;
 		void UpdatePosition(GameUnitS& updated, const Vector3& previousPos) override;
 		void FindUnits(const Circle& shape, const std::function<bool(GameUnitS&)>& resultHandler) override;
+		void FindUnitsInRadius(const Circle& shape, std::vector<GameUnitS*>& out_units) override;
+		void FindUnitsInCone(const Circle& shape, const Vector3& direction, const Radian& arc, std::vector<GameUnitS*>& out_units) override;
+		void InvalidatePositionSnapshots() override;
 		std::unique_ptr<UnitWatcher> WatchUnits(const Circle& shape, std::function<bool(GameUnitS&, bool)> visibilityChanged) override;
 
 	private:
@@ -39,11 +42,20 @@ namespace mmo
 		UnitRecordsByIdentity m_units;
 		const float m_tileWidth;
 
+		/// Incremented once per tick. Tile snapshots taken in an older generation are rebuilt on next access.
+		uint64 m_snapshotGeneration = 1;
+
+		/// Reusable index buffer for the vectorized position filters.
+		std::vector<uint32> m_indexBuffer;
+
 		Tile& GetTile(const TileIndex2D& position);
 
 		//const Tile &getTile(const TileIndex2D &position) const;
 		TileIndex2D GetTilePosition(const Vector<float, 2>& point) const;
 
+		/// Gets the clamped tile range covered by the bounding rect of a circle.
+		void GetTileRange(const Circle& shape, TileIndex2D& out_topLeft, TileIndex2D& out_bottomRight) const;
+
 		Tile& GetUnitsTile(const GameUnitS& findable);
 
 		void OnUnitMoved(GameUnitS& findable);
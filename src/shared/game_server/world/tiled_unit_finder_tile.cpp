@@ -2,6 +2,8 @@
 
 #include "tiled_unit_finder_tile.h"
 
+#include "game_server/objects/game_unit_s.h"
+
 namespace mmo
 {
 	TiledUnitFinder::Tile::Tile()
@@ -24,6 +26,8 @@ namespace mmo
 	{
 		moved.swap(other.moved);
 		m_units.swap(other.m_units);
+		std::swap(m_snapshot, other.m_snapshot);
+		std::swap(m_snapshotGeneration, other.m_snapshotGeneration);
 	}
 
 	const TiledUnitFinder::Tile::UnitSet& TiledUnitFinder::Tile::GetUnits() const
@@ -34,11 +38,32 @@ namespace mmo
 	void TiledUnitFinder::Tile::AddUnit(GameUnitS& unit)
 	{
 		m_units.add(&unit);
+		InvalidatePositionSnapshot();
 		(*moved)(unit);
 	}
 
 	void TiledUnitFinder::Tile::RemoveUnit(GameUnitS& unit)
 	{
 		m_units.remove(&unit);
+		InvalidatePositionSnapshot();
+	}
+
+	const TiledUnitFinder::Tile::PositionSnapshot& TiledUnitFinder::Tile::GetPositionSnapshot(const uint64 generation)
+	{
+		if (m_snapshotGeneration == generation)
+		{
+			return m_snapshot;
+		}
+
+		m_snapshot.Clear();
+		m_snapshot.Reserve(m_units.size());
+		for (GameUnitS* const unit : m_units.getElements())
+		{
+			const Vector3& position = unit->GetPosition();
+			m_snapshot.Add(position.x, position.z, unit);
+		}
+
+		m_snapshotGeneration = generation;
+		return m_snapshot;
 	}
 }
\ No newline at end of file
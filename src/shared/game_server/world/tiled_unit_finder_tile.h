@@ -3,6 +3,7 @@
 #pragma once
 
 #include "tiled_unit_finder.h"
+#include "unit_position_filter.h"
 #include "base/linear_set.h"
 
 namespace mmo
@@ -13,6 +14,7 @@ namespace mmo
 
 		typedef LinearSet<GameUnitS*> UnitSet;
 		typedef signal<void(GameUnitS&)> MoveSignal;
+		typedef PlanarPositionSnapshot<GameUnitS*> PositionSnapshot;
 
 		//unique_ptr, so that Tile is movable
 		std::unique_ptr<MoveSignal> moved;
@@ -26,8 +28,16 @@ namespace mmo
 		void AddUnit(GameUnitS& unit);
 		void RemoveUnit(GameUnitS& unit);
 
+		/// Gets the position snapshot of all units in this tile, rebuilding it if it was taken in an older generation.
+		const PositionSnapshot& GetPositionSnapshot(uint64 generation);
+
+		/// Forces the position snapshot to be rebuilt on next access.
+		void InvalidatePositionSnapshot() { m_snapshotGeneration = 0; }
+
 	private:
 
 		UnitSet m_units;
+		PositionSnapshot m_snapshot;
+		uint64 m_snapshotGeneration = 0;
 	};
 }
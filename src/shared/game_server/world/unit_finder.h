@@ -8,6 +8,7 @@
 
 #include <functional>
 #include <memory>
+#include <vector>
 
 namespace mmo
 {
@@ -35,6 +36,23 @@ namespace mmo
 		/// @param resultHandler
 		virtual void FindUnits(const Circle& shape, const std::function<bool(GameUnitS&)>& resultHandler) = 0;
 
+		/// Appends all units inside the given circle to a caller-owned buffer. Unlike FindUnits, this only performs
+		///	the geometric test, so any further filtering (faction, visibility, line of sight) is up to the caller.
+		///	@param shape The circle to search in.
+		///	@param out_units Receives the found units. Is not cleared, so callers can reuse the buffer.
+		virtual void FindUnitsInRadius(const Circle& shape, std::vector<GameUnitS*>& out_units) = 0;
+
+		/// Appends all units inside the given circle sector to a caller-owned buffer.
+		///	@param shape The circle which contains the cone. The circle center is the cone apex.
+		///	@param direction The planar direction of the cone. Only x and z are used.
+		///	@param arc The full opening angle of the cone.
+		///	@param out_units Receives the found units. Is not cleared, so callers can reuse the buffer.
+		virtual void FindUnitsInCone(const Circle& shape, const Vector3& direction, const Radian& arc, std::vector<GameUnitS*>& out_units) = 0;
+
+		/// Marks all cached unit position snapshots as outdated. Should be called once per world tick, so that
+		///	position queries see each unit's position at most once per tick.
+		virtual void InvalidatePositionSnapshots() = 0;
+
 		/// @param shape
 		virtual std::unique_ptr<UnitWatcher> WatchUnits(const Circle& shape, std::function<bool(GameUnitS&, bool)> visibilityChanged) = 0;
 	};
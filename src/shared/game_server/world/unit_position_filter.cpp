@@ -0,0 +1,128 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "unit_position_filter.h"
+
+#include <cmath>
+
+// SSE2 is part of every x86-64 target we build for. ARM builds (Apple Silicon) use the scalar path.
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386) || defined(_M_IX86)
+#include <emmintrin.h>
+#define MMO_USE_SSE_POSITION_FILTER
+#endif
+
+namespace mmo
+{
+	namespace
+	{
+		inline bool IsInRadiusScalar(const float x, const float z, const float centerX, const float centerZ, const float radiusSq)
+		{
+			const float dx = x - centerX;
+			const float dz = z - centerZ;
+			return dx * dx + dz * dz < radiusSq;
+		}
+
+		inline bool IsInConeScalar(const float x, const float z, const float centerX, const float centerZ, const float radiusSq, const float directionX, const float directionZ, const float cosHalfArc)
+		{
+			const float dx = x - centerX;
+			const float dz = z - centerZ;
+			const float distSq = dx * dx + dz * dz;
+			if (distSq >= radiusSq)
+			{
+				return false;
+			}
+
+			return dx * directionX + dz * directionZ >= cosHalfArc * std::sqrt(distSq);
+		}
+
+#ifdef MMO_USE_SSE_POSITION_FILTER
+		inline void AppendMaskedIndices(const int mask, const uint32 base, std::vector<uint32>& out_indices)
+		{
+			for (uint32 lane = 0; lane < 4; ++lane)
+			{
+				if (mask & (1 << lane))
+				{
+					out_indices.push_back(base + lane);
+				}
+			}
+		}
+#endif
+	}
+
+	void FilterPointsInRadius(const float* x, const float* z, const size_t count, const float centerX, const float centerZ, const float radius, std::vector<uint32>& out_indices)
+	{
+		const float radiusSq = radius * radius;
+		size_t i = 0;
+
+#ifdef MMO_USE_SSE_POSITION_FILTER
+		const __m128 cx = _mm_set1_ps(centerX);
+		const __m128 cz = _mm_set1_ps(centerZ);
+		const __m128 r2 = _mm_set1_ps(radiusSq);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + i), cx);
+			const __m128 dz = _mm_sub_ps(_mm_loadu_ps(z + i), cz);
+			const __m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dz, dz));
+
+			const int mask = _mm_movemask_ps(_mm_cmplt_ps(distSq, r2));
+			if (mask != 0)
+			{
+				AppendMaskedIndices(mask, static_cast<uint32>(i), out_indices);
+			}
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			if (IsInRadiusScalar(x[i], z[i], centerX, centerZ, radiusSq))
+			{
+				out_indices.push_back(static_cast<uint32>(i));
+			}
+		}
+	}
+
+	void FilterPointsInCone(const float* x, const float* z, const size_t count, const float centerX, const float centerZ, const float radius, const float directionX, const float directionZ, const float cosHalfArc, std::vector<uint32>& out_indices)
+	{
+		const float radiusSq = radius * radius;
+		size_t i = 0;
+
+#ifdef MMO_USE_SSE_POSITION_FILTER
+		const __m128 cx = _mm_set1_ps(centerX);
+		const __m128 cz = _mm_set1_ps(centerZ);
+		const __m128 r2 = _mm_set1_ps(radiusSq);
+		const __m128 dirX = _mm_set1_ps(directionX);
+		const __m128 dirZ = _mm_set1_ps(directionZ);
+		const __m128 cosArc = _mm_set1_ps(cosHalfArc);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + i), cx);
+			const __m128 dz = _mm_sub_ps(_mm_loadu_ps(z + i), cz);
+			const __m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dz, dz));
+
+			const __m128 inRadius = _mm_cmplt_ps(distSq, r2);
+			if (_mm_movemask_ps(inRadius) == 0)
+			{
+				continue;
+			}
+
+			const __m128 dot = _mm_add_ps(_mm_mul_ps(dx, dirX), _mm_mul_ps(dz, dirZ));
+			const __m128 inArc = _mm_cmpge_ps(dot, _mm_mul_ps(cosArc, _mm_sqrt_ps(distSq)));
+
+			const int mask = _mm_movemask_ps(_mm_and_ps(inRadius, inArc));
+			if (mask != 0)
+			{
+				AppendMaskedIndices(mask, static_cast<uint32>(i), out_indices);
+			}
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			if (IsInConeScalar(x[i], z[i], centerX, centerZ, radiusSq, directionX, directionZ, cosHalfArc))
+			{
+				out_indices.push_back(static_cast<uint32>(i));
+			}
+		}
+	}
+}
@@ -0,0 +1,74 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/typedefs.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace mmo
+{
+	/// Structure-of-arrays snapshot of planar unit positions. Used by unit finders to run distance
+	/// tests over contiguous float arrays instead of chasing unit pointers.
+	template<class T>
+	struct PlanarPositionSnapshot
+	{
+		/// X coordinates of the entries.
+		std::vector<float> x;
+
+		/// Z coordinates of the entries.
+		std::vector<float> z;
+
+		/// The payload of each entry, index-aligned with x and z.
+		std::vector<T> entries;
+
+		void Clear()
+		{
+			x.clear();
+			z.clear();
+			entries.clear();
+		}
+
+		void Reserve(const size_t count)
+		{
+			x.reserve(count);
+			z.reserve(count);
+			entries.reserve(count);
+		}
+
+		void Add(const float posX, const float posZ, T entry)
+		{
+			x.push_back(posX);
+			z.push_back(posZ);
+			entries.push_back(entry);
+		}
+
+		[[nodiscard]] size_t Size() const { return entries.size(); }
+	};
+
+	/// Appends the indices of all points which are inside the given circle to the output buffer. Points exactly on
+	/// the circle border are considered outside, matching Circle::IsPointInside.
+	/// @param x Array of x coordinates.
+	/// @param z Array of z coordinates.
+	/// @param count Number of points in both arrays.
+	/// @param centerX X coordinate of the circle center.
+	/// @param centerZ Z coordinate of the circle center.
+	/// @param radius Radius of the circle.
+	/// @param out_indices Receives the indices of all matching points. Is not cleared.
+	void FilterPointsInRadius(const float* x, const float* z, size_t count, float centerX, float centerZ, float radius, std::vector<uint32>& out_indices);
+
+	/// Appends the indices of all points which are inside the given circle sector to the output buffer. A point at the
+	/// exact apex of the cone is considered inside.
+	/// @param x Array of x coordinates.
+	/// @param z Array of z coordinates.
+	/// @param count Number of points in both arrays.
+	/// @param centerX X coordinate of the cone apex.
+	/// @param centerZ Z coordinate of the cone apex.
+	/// @param radius Length of the cone.
+	/// @param directionX X component of the normalized cone direction.
+	/// @param directionZ Z component of the normalized cone direction.
+	/// @param cosHalfArc Cosine of half of the cone's opening angle.
+	/// @param out_indices Receives the indices of all matching points. Is not cleared.
+	void FilterPointsInCone(const float* x, const float* z, size_t count, float centerX, float centerZ, float radius, float directionX, float directionZ, float cosHalfArc, std::vector<uint32>& out_indices);
+}
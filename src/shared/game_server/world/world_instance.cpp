@@ -165,8 +165,11 @@ namespace mmo
 		, m_project(project)
 		, m_visibilityGrid(std::move(visibilityGrid))
 		, m_unitFinder(std::move(unitFinder))
+		, m_objectPool(SmallObjectPool::Create())
 		, m_gameTime(0, 1.0f)
+		, m_combatLog(*m_visibilityGrid)
 		, m_triggerHandler(triggerHandler)
+		, m_spawnScheduler(*this)
 		, m_conditionMgr(conditionMgr) // Initialize with default time (midnight) and normal speed
 	{
 		uuids::uuid_system_generator generator;
@@ -253,8 +256,27 @@ namespace mmo
 
 	void WorldInstance::Update(const RegularUpdate& update)
 	{
+		// Creatures can only be added to the world outside of object updates
+		m_spawnScheduler.Update(update.GetTimestamp());
+
+		constexpr GameTime MovementStatsInterval = 5 * constants::OneMinute;
+		if (update.GetTimestamp() - m_lastMovementStatsLog >= MovementStatsInterval)
+		{
+			LogMovementValidationStats();
+			LogCombatLogStats(update.GetTimestamp() - m_lastMovementStatsLog);
+			m_lastMovementStatsLog = update.GetTimestamp();
+		}
+
+		// Send the combat events since the last tick before the health changes they caused
+		m_combatLog.Flush();
+
 		m_updating = true;
 
+		// Unit positions may have changed since the last tick, so cached positions and area query
+		// snapshots need to be refreshed
+		++m_updateTick;
+		m_unitFinder->InvalidatePositionSnapshots();
+
 		// Update game time
 		m_gameTime.Update(update.GetTimestamp());
 
@@ -288,86 +310,173 @@ namespace mmo
 
 	void WorldInstance::AddGameObject(GameObjectS& added)
 	{
-		ASSERT(!m_updating);
-		m_objectsByGuid.emplace(added.GetGuid(), &added);
-
-		// No need for visibility updates for item objects
-		if (added.GetTypeId() == ObjectTypeId::Item ||
-			added.GetTypeId() == ObjectTypeId::Container)
+		VisibilityTile* tile = InsertGameObject(added);
+		if (!tile)
 		{
 			return;
 		}
 
-		const auto& position = added.GetPosition();
+		ForEachTileInSight(
+			*m_visibilityGrid,
+			tile->GetPosition(),
+			[&added](VisibilityTile& tile)
+		{
+			const std::vector objects { &added };
+			for (auto* subscriber : tile.GetWatchers())
+			{
+				if (subscriber->GetGameUnit().GetGuid() == added.GetGuid())
+				{
+					continue;
+				}
 
-		TileIndex2D gridIndex;
-		if (!m_visibilityGrid->GetTilePosition(position, gridIndex[0], gridIndex[1]))
+				if (added.IsUnit() && !added.AsUnit().CanBeSeenBy(subscriber->GetGameUnit()))
+				{
+					continue; // Skip subscribers that cannot see this unit
+				}
+
+				subscriber->NotifyObjectsSpawned(objects);
+			}
+		});
+
+		ActivateGameObject(added);
+	}
+
+	void WorldInstance::AddGameObjects(const std::vector<GameObjectS*>& added)
+	{
+		if (added.size() == 1)
 		{
-			ELOG("Could not resolve grid location!");
+			AddGameObject(*added.front());
 			return;
 		}
-		
-		auto &tile = m_visibilityGrid->RequireTile(gridIndex);
-		tile.GetGameObjects().add(&added);
-		added.SetWorldInstance(this);
 
-	added.spawned(*this);
-	
-	ForEachTileInSight(
-	    *m_visibilityGrid,
-	    tile.GetPosition(),
-	    [&added](VisibilityTile & tile)
-	{
-	    const std::vector objects { &added };
-	    for (auto *subscriber : tile.GetWatchers())
+		// Group the new objects by their visibility tile, since all objects of a tile share the same watchers
+		std::vector<std::pair<VisibilityTile*, std::vector<GameObjectS*>>> objectsByTile;
+		std::vector<GameObjectS*> inserted;
+		inserted.reserve(added.size());
+
+		for (GameObjectS* object : added)
 		{
-			if (subscriber->GetGameUnit().GetGuid() == added.GetGuid())
+			VisibilityTile* tile = InsertGameObject(*object);
+			if (!tile)
 			{
 				continue;
 			}
 
-			if (added.IsUnit() && !added.AsUnit().CanBeSeenBy(subscriber->GetGameUnit()))
+			inserted.push_back(object);
+
+			auto it = std::find_if(objectsByTile.begin(), objectsByTile.end(), [tile](const auto& entry) { return entry.first == tile; });
+			if (it == objectsByTile.end())
 			{
-				continue; // Skip subscribers that cannot see this unit
+				it = objectsByTile.emplace(objectsByTile.end(), tile, std::vector<GameObjectS*>());
 			}
 
+			it->second.push_back(object);
+		}
+
+		// Collect the objects every watcher is able to see, so that each watcher is notified only once
+		std::unordered_map<TileSubscriber*, std::vector<GameObjectS*>> spawnedBySubscriber;
+		for (const auto& [tile, objects] : objectsByTile)
+		{
+			ForEachTileInSight(
+				*m_visibilityGrid,
+				tile->GetPosition(),
+				[&objects, &spawnedBySubscriber](VisibilityTile& sightTile)
+			{
+				for (auto* subscriber : sightTile.GetWatchers())
+				{
+					GameUnitS& watcher = subscriber->GetGameUnit();
+					for (GameObjectS* object : objects)
+					{
+						if (watcher.GetGuid() == object->GetGuid())
+						{
+							continue;
+						}
+
+						if (object->IsUnit() && !object->AsUnit().CanBeSeenBy(watcher))
+						{
+							continue; // Skip subscribers that cannot see this unit
+						}
+
+						spawnedBySubscriber[subscriber].push_back(object);
+					}
+				}
+			});
+		}
+
+		for (const auto& [subscriber, objects] : spawnedBySubscriber)
+		{
 			subscriber->NotifyObjectsSpawned(objects);
 		}
-	});
 
-	if (const auto addedUnit = dynamic_cast<GameUnitS*>(&added))
-	{
-		m_unitFinder->AddUnit(*addedUnit);
+		for (GameObjectS* object : inserted)
+		{
+			ActivateGameObject(*object);
+		}
 	}
 
-	// Activate passive spells AFTER spawn notifications have been sent
-	// This ensures clients receive the spawn packet before any stat updates from passive effects
-	if (const auto unit = dynamic_cast<GameUnitS*>(&added))
+	VisibilityTile* WorldInstance::InsertGameObject(GameObjectS& added)
 	{
-		unit->ActivatePassiveSpells();
-		added.AsUnit().unitTrigger.connect([this](const proto::TriggerEntry& trigger, GameUnitS& owner, GameUnitS* triggeringUnit) {
-			m_triggerHandler.ExecuteTrigger(trigger, TriggerContext(&owner, triggeringUnit), 0);
-			});
+		ASSERT(!m_updating);
+		m_objectsByGuid.emplace(added.GetGuid(), &added);
+
+		// No need for visibility updates for item objects
+		if (added.GetTypeId() == ObjectTypeId::Item ||
+			added.GetTypeId() == ObjectTypeId::Container)
+		{
+			return nullptr;
 		}
 
-	if (added.GetTypeId() == ObjectTypeId::Player)
-	{
-		++m_playerCount;
+		const auto& position = added.GetPosition();
 
-		// Start instance-wide periodic timers once the first player is present.
-		if (m_playerCount == 1)
+		TileIndex2D gridIndex;
+		if (!m_visibilityGrid->GetTilePosition(position, gridIndex[0], gridIndex[1]))
 		{
-			StartInstanceTimers();
+			ELOG("Could not resolve grid location!");
+			return nullptr;
 		}
 
-		FireInstanceTriggerEvent(trigger_event::OnPlayerEnterInstance, nullptr);
+		auto& tile = m_visibilityGrid->RequireTile(gridIndex);
+		tile.GetGameObjects().add(&added);
+		added.SetWorldInstance(this);
+
+		added.spawned(*this);
+		return &tile;
+	}
+
+	void WorldInstance::ActivateGameObject(GameObjectS& added)
+	{
+		if (const auto addedUnit = dynamic_cast<GameUnitS*>(&added))
+		{
+			m_unitFinder->AddUnit(*addedUnit);
+
+			// Activate passive spells AFTER spawn notifications have been sent
+			// This ensures clients receive the spawn packet before any stat updates from passive effects
+			addedUnit->ActivatePassiveSpells();
+			addedUnit->unitTrigger.connect([this](const proto::TriggerEntry& trigger, GameUnitS& owner, GameUnitS* triggeringUnit) {
+				m_triggerHandler.ExecuteTrigger(trigger, TriggerContext(&owner, triggeringUnit), 0);
+				});
+		}
+
+		if (added.GetTypeId() == ObjectTypeId::Player)
+		{
+			++m_playerCount;
+
+			// Start instance-wide periodic timers once the first player is present.
+			if (m_playerCount == 1)
+			{
+				StartInstanceTimers();
+			}
+
+			FireInstanceTriggerEvent(trigger_event::OnPlayerEnterInstance, nullptr);
+		}
 	}
-}
 
 	void WorldInstance::RemoveGameObject(GameObjectS& remove)
 	{
 		ASSERT(!m_updating);
 
+		m_movementValidator.Remove(remove.GetGuid());
+
 		if (const auto removedUnit = dynamic_cast<GameUnitS*>(&remove))
 		{
 			m_unitFinder->RemoveUnit(*removedUnit);
@@ -564,6 +673,30 @@ namespace mmo
 		return spawned;
 	}
 
+	const WorldInstance::CreatureSpells& WorldInstance::GetCreatureSpells(const proto::UnitEntry& entry)
+	{
+		const auto it = m_creatureSpells.find(&entry);
+		if (it != m_creatureSpells.end())
+		{
+			return it->second;
+		}
+
+		CreatureSpells& spells = m_creatureSpells[&entry];
+		for (const auto& creatureSpell : entry.creaturespells())
+		{
+			const auto* spell = m_project.spells.getById(creatureSpell.spellid());
+			if (!spell)
+			{
+				WLOG("Unknown spell " << creatureSpell.spellid() << " in spell list of unit entry " << entry.id());
+				continue;
+			}
+
+			spells.Edit().insert(spell);
+		}
+
+		return spells;
+	}
+
 	std::shared_ptr<GameWorldObjectS> WorldInstance::SpawnWorldObject(const proto::ObjectEntry& entry, const Vector3& position)
 	{
 		// Create the object
@@ -603,6 +736,36 @@ namespace mmo
 		m_temporaryCreatures.erase(it);
 	}
 
+	void WorldInstance::LogMovementValidationStats()
+	{
+		const MovementValidator::Counters& counters = m_movementValidator.GetCounters();
+		if (counters.speedChecks == 0 && counters.waterChecks == 0 && counters.waterChecksSkipped == 0)
+		{
+			return;
+		}
+
+		DLOG("Movement validation of map " << m_mapId << ": " << counters.speedChecks << " speed checks, "
+			<< counters.waterChecks << " water checks (" << counters.waterChecksSkipped << " skipped), "
+			<< counters.violations << " violations");
+
+		m_movementValidator.ResetCounters();
+	}
+
+	void WorldInstance::LogCombatLogStats(const GameTime elapsed)
+	{
+		const CombatLogBuffer::Counters& counters = m_combatLog.GetCounters();
+		if (counters.events == 0 || elapsed == 0)
+		{
+			return;
+		}
+
+		const uint64 seconds = std::max<uint64>(1, elapsed / constants::OneSecond);
+		DLOG("Combat log of map " << m_mapId << ": " << counters.events << " events, " << counters.deliveries << " deliveries ("
+			<< counters.irrelevant << " out of range), " << counters.packets / seconds << " packets/s, " << counters.bytes / seconds << " bytes/s");
+
+		m_combatLog.ResetCounters();
+	}
+
 	void WorldInstance::UpdateObject(GameObjectS& object) const
 	{
 		const std::vector objects{ &object };
@@ -8,14 +8,20 @@
 #include <vector>
 #include <memory>
 
+#include "combat_log_buffer.h"
 #include "creature_spawner.h"
+#include "map_data.h"
+#include "spawn_scheduler.h"
+#include "movement_validator.h"
 #include "unit_finder.h"
 #include "game/game.h"
 #include "game/game_time_component.h"
 #include "visibility_grid.h"
 #include "world_object_spawner.h"
+#include "base/copy_on_write.h"
 #include "base/id_generator.h"
 #include "base/countdown.h"
+#include "base/small_object_pool.h"
 #include "shared/proto_data/maps.pb.h"
 #include "shared/proto_data/trigger_helper.h"
 
@@ -29,42 +35,13 @@ namespace mmo
 
 	namespace proto
 	{
+		class SpellEntry;
 		class TriggerEntry;
 	}
 }
 
 namespace mmo
 {
-	class MapData
-	{
-	public:
-		virtual ~MapData() = default;
-
-		/// @brief Checks whether posA can see posB without obstruction.
-		virtual bool IsInLineOfSight(const Vector3& posA, const Vector3& posB) = 0;
-
-		/// @brief Like IsInLineOfSight but also reports the hit position when blocked.
-		/// @param posA Source position.
-		/// @param posB Destination position.
-		/// @param hitPoint Set to the obstruction point when returning false, or to posB when returning true.
-		/// @return true when the ray reaches posB unobstructed.
-		virtual bool IsInLineOfSightEx(const Vector3& posA, const Vector3& posB, Vector3& hitPoint) = 0;
-
-		virtual bool CalculatePath(const Vector3& start, const Vector3& destination, std::vector<Vector3>& out_path) const = 0;
-
-		virtual bool FindRandomPointAroundCircle(const Vector3& centerPosition, float radius, Vector3& randomPoint) const = 0;
-
-		/// @brief Gets the water surface height at the given world position, if water is present.
-		/// @param pos World position to query (only X/Z are used).
-		/// @param outSurfaceY Receives the water surface height (Y) when water is present.
-		/// @return True when there is water at the position, false otherwise.
-		virtual bool GetWaterSurface(const Vector3& pos, float& outSurfaceY) const = 0;
-
-		/// @brief Returns true if server-side water data is loaded for this map. When false, swim
-		/// validation is skipped (the server trusts the client) rather than rejecting all swimming.
-		virtual bool IsWaterDataAvailable() const = 0;
-	};
-
 	class SimpleMapData final : public MapData
 	{
 	public:
@@ -149,6 +126,7 @@ namespace mmo
 	class WorldInstanceManager;
 	class RegularUpdate;
 	class VisibilityGrid;
+	class VisibilityTile;
 	
 	/// Represents a single world instance at the world server.
 	class WorldInstance
@@ -163,6 +141,10 @@ namespace mmo
 		
 		/// Gets the id of this world instance.
 		[[nodiscard]] InstanceId GetId() const { return m_id; }
+
+		/// Gets the number of the current update tick. Incremented at the start of every Update call and used
+		///	to cache per-tick data like interpolated unit positions.
+		[[nodiscard]] uint64 GetUpdateTick() const { return m_updateTick; }
 		
 		/// Gets the map id of this world instance.
 		[[nodiscard]] MapId GetMapId() const { return m_mapId; }
@@ -174,6 +156,10 @@ namespace mmo
 		/// Adds a game object to this world instance.
 		void AddGameObject(GameObjectS &added);
 
+		/// Adds multiple game objects to this world instance at once. Objects are grouped by their visibility tile
+		///	and every watcher receives a single spawn notification containing all new objects it can see.
+		void AddGameObjects(const std::vector<GameObjectS*>& added);
+
 		/// Removes a specific game object from this world.
 		void RemoveGameObject(GameObjectS &remove);
 
@@ -217,10 +203,21 @@ namespace mmo
 
 		std::shared_ptr<GameCreatureS> CreateCreature(const proto::UnitEntry& entry, const Vector3& position, float o, float randomWalkRadius);
 
+		/// Spells which all creatures of a unit entry start with. Shared by the creatures until one of them learns or
+		///	unlearns a spell.
+		typedef CopyOnWrite<std::unordered_set<const proto::SpellEntry*>> CreatureSpells;
+
+		/// Gets the initial spells of creatures of a unit entry. Built when the first creature of the entry is created.
+		const CreatureSpells& GetCreatureSpells(const proto::UnitEntry& entry);
+
 		std::shared_ptr<GameWorldObjectS> SpawnWorldObject(const proto::ObjectEntry& entry, const Vector3& position);
 
 		MapData* GetMapData() const { return m_mapData.get(); }
 
+		/// Replaces the map data used for path finding, line of sight and water checks. Worlds without a map entry
+		///	have no map data at all, so this is mainly used to drive movers in worlds that were created without one.
+		void SetMapData(std::unique_ptr<MapData> mapData) { m_mapData = std::move(mapData); }
+
 		/// Creates a temporary creature that the world instance will also keep a strong reference to. The creature will not be spawned and thus
 		///	needs to be spawned using the AddGameObject method.
 		std::shared_ptr<GameCreatureS> CreateTemporaryCreature(const proto::UnitEntry& entry, const Vector3& position, float o, float randomWalkRadius);
@@ -228,13 +225,13 @@ namespace mmo
 		/// Removes the reference to a creature that was created using CreateTemporaryCreature. The creature needs to be despawned before this call.
 		void DestroyTemporaryCreature(uint64 guid);
 
-		bool IsDungeon() const { return m_mapEntry->instancetype() == proto::MapEntry_MapInstanceType_DUNGEON; }
+		bool IsDungeon() const { return m_mapEntry && m_mapEntry->instancetype() == proto::MapEntry_MapInstanceType_DUNGEON; }
 
-		bool IsRaid() const { return m_mapEntry->instancetype() == proto::MapEntry_MapInstanceType_RAID; }
+		bool IsRaid() const { return m_mapEntry && m_mapEntry->instancetype() == proto::MapEntry_MapInstanceType_RAID; }
 
 		bool IsInstancedPvE() const { return IsDungeon() || IsRaid(); }
 
-		bool IsPersistent() const { return m_mapEntry->instancetype() == proto::MapEntry_MapInstanceType_GLOBAL; }
+		bool IsPersistent() const { return m_mapEntry && m_mapEntry->instancetype() == proto::MapEntry_MapInstanceType_GLOBAL; }
 
 		/// Iterates all game objects currently in this world instance.
 		///	@param callback Callable receiving `GameObjectS&`; return false to stop early.
@@ -293,6 +290,19 @@ namespace mmo
 		/// @brief Gets the number of players currently in this instance.
 		uint32 GetPlayerCount() const { return m_playerCount; }
 
+		/// Gets the pool used for short-lived combat objects of this instance like spell casts, auras and loot.
+		/// Objects allocated from it may safely outlive the instance.
+		SmallObjectPool* GetObjectPool() const { return m_objectPool.get(); }
+
+		/// Gets the scheduler which executes creature spawns of this world instance in batches.
+		SpawnScheduler& GetSpawnScheduler() { return m_spawnScheduler; }
+
+		/// Gets the validator which checks the client movement of the players of this world instance.
+		MovementValidator& GetMovementValidator() { return m_movementValidator; }
+
+		/// Gets the buffer which collects the combat log events of this world instance and sends them once per tick.
+		CombatLogBuffer& GetCombatLog() { return m_combatLog; }
+
 		/// Raises an instance-owned (map-global) trigger event. Used for events that originate outside
 		/// of the standard player enter/leave flow, such as a summoned creature death for an
 		/// ownerless instance trigger.
@@ -310,6 +320,13 @@ namespace mmo
 		void OnObjectMoved(GameObjectS& object, const MovementInfo& oldMovementInfo) const;
 
 	private:
+		/// Registers a new game object and inserts it into its visibility tile.
+		///	@returns The visibility tile of the object or nullptr, if the object is not part of the visibility grid.
+		VisibilityTile* InsertGameObject(GameObjectS& added);
+
+		/// Activates a new game object after its spawn notifications have been sent.
+		void ActivateGameObject(GameObjectS& added);
+
 		void FireInstanceTriggerEvent(trigger_event::Type eventType, GameUnitS* triggeringUnit);
 
 		/// Fires a specific instance trigger only if it listens for the given event (with optional data match).
@@ -324,6 +341,13 @@ namespace mmo
 		/// Stops and clears all instance-owned OnTimer timers.
 		void StopInstanceTimers();
 
+		/// Logs and resets the counters of the movement validator.
+		void LogMovementValidationStats();
+
+		/// Logs and resets the counters of the combat log buffer.
+		///	@param elapsed Time since the counters were reset.
+		void LogCombatLogStats(GameTime elapsed);
+
 		/// (Re)schedules the next firing of an instance OnTimer timer based on its interval data.
 		void ScheduleInstanceTimer(Countdown& countdown, const proto::TriggerEntry& entry);
 
@@ -338,21 +362,34 @@ namespace mmo
 		const proto::Project& m_project;
 		const proto::MapEntry* m_mapEntry{nullptr};
 		volatile bool m_updating { false };
+		uint64 m_updateTick { 1 };
 		std::unordered_set<GameObjectS*> m_objectUpdates;
 		std::unordered_set<GameObjectS*> m_queuedObjectUpdates;
 		std::unique_ptr<VisibilityGrid> m_visibilityGrid;
 		std::unique_ptr<UnitFinder> m_unitFinder;
+		SmallObjectPool::Ptr m_objectPool;
 		GameTimeComponent m_gameTime;
 		
 		/// Last time when game time update was broadcast to players
 		GameTime m_lastTimeUpdateBroadcast { 0 };
 
+		MovementValidator m_movementValidator;
+
+		/// Last time when the movement validation counters were logged
+		GameTime m_lastMovementStatsLog { 0 };
+
+		CombatLogBuffer m_combatLog;
+
 		std::map<uint64, std::shared_ptr<GameCreatureS>> m_temporaryCreatures;
+		std::unordered_map<const proto::UnitEntry*, CreatureSpells> m_creatureSpells;
 		ITriggerHandler& m_triggerHandler;
 
 		typedef std::unordered_map<uint64, GameObjectS*> GameObjectsByGuid;
 		GameObjectsByGuid m_objectsByGuid;
 
+		/// Declared before the spawners so that they can cancel their scheduled spawns on destruction.
+		SpawnScheduler m_spawnScheduler;
+
 		typedef std::vector<std::unique_ptr<CreatureSpawner>> CreatureSpawners;
 		typedef std::vector<std::unique_ptr<WorldObjectSpawner>> ObjectSpawners;
 		CreatureSpawners m_creatureSpawners;
@@ -23,9 +23,11 @@ namespace mmo
 		, m_project(project)
 		, m_objectIdGenerator(objectIdGenerator)
 		, m_conditionMgr(conditionMgr)
+		, m_lootTables(project)
 		, m_updateTimer(ioContext)
 		, m_lastTick(GetAsyncTimeMs())
 		, m_triggerHandler(triggerHandler)
+		, m_lastTickReport(GetAsyncTimeMs())
 	{
 		ScheduleNextUpdate();
 	}
@@ -166,11 +168,34 @@ namespace mmo
 		m_lastTick = timestamp;
 		
 		const RegularUpdate update{ timestamp, deltaSeconds };
+		const auto updateStart = std::chrono::steady_clock::now();
 		Update(update);
+		RecordTickDuration(std::chrono::steady_clock::now() - updateStart, timestamp);
 		
 		ScheduleNextUpdate();
 	}
 
+	void WorldInstanceManager::RecordTickDuration(const std::chrono::steady_clock::duration duration, const GameTime timestamp)
+	{
+		m_tickDurationSum += duration;
+		m_tickDurationMax = std::max(m_tickDurationMax, duration);
+		++m_tickCount;
+
+		if (timestamp - m_lastTickReport < TickReportInterval)
+		{
+			return;
+		}
+
+		typedef std::chrono::duration<double, std::milli> Milliseconds;
+		ILOG("World update: " << m_tickCount << " ticks, avg " << Milliseconds(m_tickDurationSum).count() / m_tickCount
+			<< " ms, max " << Milliseconds(m_tickDurationMax).count() << " ms");
+
+		m_tickDurationSum = std::chrono::steady_clock::duration::zero();
+		m_tickDurationMax = std::chrono::steady_clock::duration::zero();
+		m_tickCount = 0;
+		m_lastTickReport = timestamp;
+	}
+
 	void WorldInstanceManager::Update(const RegularUpdate& update)
 	{
 		std::unique_lock lock{ m_worldInstanceMutex };
@@ -8,12 +8,14 @@
 
 #include "asio.hpp"
 
+#include <chrono>
 #include <memory>
 #include <vector>
 #include <mutex>
 #include <map>
 
 #include "game_server/trigger_handler.h"
+#include "game_server/loot_table.h"
 #include "base/signal.h"
 
 namespace mmo
@@ -57,6 +59,9 @@ namespace mmo
 		/// @param instanceId The id of the instance to destroy.
 		void DestroyInstance(InstanceId instanceId);
 
+		/// Gets the compiled loot tables of the project, shared by all world instances.
+		[[nodiscard]] const LootTableCache& GetLootTables() const { return m_lootTables; }
+
 	private:
 		void OnUpdate();
 
@@ -67,11 +72,15 @@ namespace mmo
 
 		void ScheduleNextUpdate();
 
+		/// Accumulates the duration of a single update tick and periodically logs the average and worst tick duration.
+		void RecordTickDuration(std::chrono::steady_clock::duration duration, GameTime timestamp);
+
 	private:
 		Universe& m_universe;
 		const proto::Project& m_project;
 		IdGenerator<uint64>& m_objectIdGenerator;
 		const ConditionMgr& m_conditionMgr;
+		LootTableCache m_lootTables;
 
 		typedef std::vector<std::unique_ptr<WorldInstance>> WorldInstances;
 		asio::high_resolution_timer m_updateTimer;
@@ -88,5 +97,14 @@ namespace mmo
 
 		/// How long an empty dungeon instance survives before being destroyed (in milliseconds).
 		static constexpr GameTime EmptyDungeonTimeout = 15 * 60 * 1000; // 15 minutes
+
+		/// Tick duration statistics since the last report.
+		std::chrono::steady_clock::duration m_tickDurationSum { 0 };
+		std::chrono::steady_clock::duration m_tickDurationMax { 0 };
+		uint32 m_tickCount { 0 };
+		GameTime m_lastTickReport;
+
+		/// How often tick duration statistics are logged (in milliseconds).
+		static constexpr GameTime TickReportInterval = 60 * 1000; // 1 minute
 	};
 }
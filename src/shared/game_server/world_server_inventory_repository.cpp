@@ -40,7 +40,7 @@ namespace mmo
     WorldServerInventoryRepository::WorldServerInventoryRepository(
         RealmConnector &realmConnector,
         uint64 characterId) noexcept
-        : m_realmConnector(realmConnector), m_characterId(characterId), m_inTransaction(false)
+        : m_realmConnector(realmConnector), m_characterId(characterId), m_inTransaction(false), m_replaceAll(false)
     {
     }
 
@@ -78,6 +78,7 @@ bool WorldServerInventoryRepository::SaveAllItems(uint64 characterId, const std:
         {
             m_pendingOperations.emplace_back(OperationType::Save, item);
         }
+        m_replaceAll = true;
         DLOG("Buffered " << items.size() << " items for transaction");
         return true;
     }
@@ -90,7 +91,7 @@ bool WorldServerInventoryRepository::SaveAllItems(uint64 characterId, const std:
             ops.emplace_back(OperationType::Save, item);
         }
         DLOG("Sending " << ops.size() << " operations immediately");
-        return SendBatchOperationsPacket(characterId, ops);
+        return SendBatchOperationsPacket(characterId, ops, true);
     }
 }    bool WorldServerInventoryRepository::DeleteItem(uint64 characterId, uint16 slot)
     {
@@ -122,6 +123,7 @@ bool WorldServerInventoryRepository::SaveAllItems(uint64 characterId, const std:
         }
 
         m_inTransaction = true;
+        m_replaceAll = false;
         m_pendingOperations.clear();
         return true;
     }
@@ -137,9 +139,10 @@ bool WorldServerInventoryRepository::Commit()
     DLOG("Committing transaction with " << m_pendingOperations.size() << " pending operations");
 
     // Send all buffered operations to realm server
-    const bool success = SendBatchOperationsPacket(m_characterId, m_pendingOperations);
+    const bool success = SendBatchOperationsPacket(m_characterId, m_pendingOperations, m_replaceAll);
 
     m_inTransaction = false;
+    m_replaceAll = false;
     m_pendingOperations.clear();
 
     return success;
@@ -152,6 +155,7 @@ bool WorldServerInventoryRepository::Commit()
 
         // Simply discard buffered operations
         m_inTransaction = false;
+        m_replaceAll = false;
         m_pendingOperations.clear();
         return true;
     }
@@ -176,7 +180,7 @@ bool WorldServerInventoryRepository::Commit()
         const uint32 operationId = 0;
 
         // Send to realm server via RealmConnector
-        m_realmConnector.SendSaveInventoryItems(characterId, operationId, items);
+        m_realmConnector.SendSaveInventoryItems(characterId, operationId, items, false);
         return true;
     }
 
@@ -195,9 +199,11 @@ bool WorldServerInventoryRepository::Commit()
 
     bool WorldServerInventoryRepository::SendBatchOperationsPacket(
         uint64 characterId,
-        const std::vector<PendingOperation> &operations)
+        const std::vector<PendingOperation> &operations,
+        bool replaceAll)
     {
-        if (operations.empty())
+        // Replacing all items with an empty inventory still has to reach the realm
+        if (operations.empty() && !replaceAll)
         {
             return true;
         }
@@ -221,10 +227,10 @@ bool WorldServerInventoryRepository::Commit()
         // Generate operation ID (for now, use 0 - will be enhanced with proper tracking)
         const uint32 operationId = 0;
 
-        // Send batch save packet if any saves
-        if (!itemsToSave.empty())
+        // Send batch save packet if any saves. The realm applies them as upserts, so only changed slots need to be sent.
+        if (!itemsToSave.empty() || replaceAll)
         {
-            m_realmConnector.SendSaveInventoryItems(characterId, operationId, itemsToSave);
+            m_realmConnector.SendSaveInventoryItems(characterId, operationId, itemsToSave, replaceAll);
         }
 
         // Send batch delete packet if any deletes
@@ -60,7 +60,7 @@ namespace mmo
         bool SaveItem(uint64 characterId, const InventoryItemData &item) override;
 
         /**
-         * @brief Saves all items as a batch operation.
+         * @brief Saves all items as a batch operation, which replaces all items stored on the realm.
          */
         bool SaveAllItems(uint64 characterId, const std::vector<InventoryItemData> &items) override;
 
@@ -144,13 +144,16 @@ namespace mmo
 
         /**
          * @brief Sends batch of operations to realm server.
+         * @param replaceAll If set, the realm removes all items of the character which are not saved by the batch.
          */
-        bool SendBatchOperationsPacket(uint64 characterId, const std::vector<PendingOperation> &operations);
+        bool SendBatchOperationsPacket(uint64 characterId, const std::vector<PendingOperation> &operations, bool replaceAll);
 
     private:
         RealmConnector &m_realmConnector;
         uint64 m_characterId;
         bool m_inTransaction;
+        /// Set if SaveAllItems was called during the current transaction.
+        bool m_replaceAll;
         std::vector<PendingOperation> m_pendingOperations;
     };
 }
\ No newline at end of file
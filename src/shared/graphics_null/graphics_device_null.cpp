@@ -69,6 +69,8 @@ namespace mmo
 
 	void GraphicsDeviceNull::Reset()
 	{
+		m_lastFrameBatchCount = m_batchCount;
+		m_batchCount = 0;
 	}
 
 	void GraphicsDeviceNull::SetClearColor(const uint32 clearColor)
@@ -124,14 +126,17 @@ namespace mmo
 	
 	void GraphicsDeviceNull::Draw(uint32 vertexCount, uint32 start)
 	{
+		m_batchCount++;
 	}
 
 	void GraphicsDeviceNull::DrawIndexed(const uint32 startIndex, const uint32 endIndex)
 	{
+		m_batchCount++;
 	}
 
 	void GraphicsDeviceNull::DrawIndexedInstanced(const uint32 indexCount, const uint32 instanceCount, const uint32 startIndex, const int32 baseVertex, const uint32 startInstance)
 	{
+		m_batchCount++;
 	}
 	
 	void GraphicsDeviceNull::SetTopologyType(TopologyType InType)
@@ -98,11 +98,17 @@ namespace mmo
 
 		void* GetHardwareCursor() override;
 
-		uint64 GetBatchCount() const override { return 0; }
+		uint64 GetBatchCount() const override { return m_lastFrameBatchCount; }
 
 		std::string GetPrimaryMonitorResolution() const override;
 
 		bool ValidateFullscreenResolution(uint16 width, uint16 height) const override;
 		// ~ End GraphicsDevice
+
+	private:
+		/// Number of draw calls since the last reset, counted like the d3d11 device does so that headless tests and
+		/// benchmarks can report them.
+		uint64 m_batchCount = 0;
+		uint64 m_lastFrameBatchCount = 0;
 	};
 }
@@ -64,6 +64,10 @@ namespace mmo
 				*connection << "GET " << escapePath(request.document) << " HTTP/1.0\r\n";
 				*connection << "Host: " << request.host << "\r\n";
 				*connection << "Accept: */*\r\n";
+				if (request.rangeBegin > 0)
+				{
+					*connection << "Range: bytes=" << request.rangeBegin << "-\r\n";
+				}
 				*connection << "Connection: close\r\n";
 				*connection << "\r\n";
 
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <string>
+#include <cstdint>
 
 namespace mmo
 {
@@ -14,6 +15,9 @@ namespace mmo
 			{
 				std::string host;
 				std::string document;
+				/// Offset of the first requested byte of the document. Servers which support range requests answer
+				/// with PartialContent if this is not zero.
+				std::uintmax_t rangeBegin = 0;
 			};
 		}
 	}
@@ -115,6 +115,10 @@ namespace mmo
 				request_stream << "GET " << escapePath(request.document) << " HTTP/1.0\r\n";
 				request_stream << "Host: " << request.host << "\r\n";
 				request_stream << "Accept: */*\r\n";
+				if (request.rangeBegin > 0)
+				{
+					request_stream << "Range: bytes=" << request.rangeBegin << "-\r\n";
+				}
 				request_stream << "Connection: close\r\n";
 				request_stream << "\r\n";
 
@@ -118,6 +118,7 @@ namespace mmo
 	{
 		ASSERT(!HasNodeTrack(handle));
 
+		KeyFrameListChanged();
 		return (m_nodeTrackList[handle] = std::make_unique<NodeAnimationTrack>(*this, handle)).get();
 	}
 
@@ -203,6 +204,18 @@ namespace mmo
 		}
 	}
 
+	const AnimationKeyData& Animation::PrepareKeyData()
+	{
+		ApplyBaseKeyFrame();
+
+		if (m_keyDataDirty)
+		{
+			BuildKeyData();
+		}
+
+		return m_keyData;
+	}
+
 	void Animation::DestroyNodeTrack(const uint16 handle)
 	{
 		if (const auto it = m_nodeTrackList.find(handle); it != m_nodeTrackList.end())
@@ -244,6 +257,37 @@ namespace mmo
 		m_keyFrameTimesDirty = false;
 	}
 
+	void Animation::BuildKeyData()
+	{
+		m_keyData.tracks.clear();
+		m_keyData.times.clear();
+		m_keyData.translations.clear();
+		m_keyData.rotations.clear();
+		m_keyData.scales.clear();
+
+		for (const auto& [handle, nodeTrack] : m_nodeTrackList)
+		{
+			const uint16 keyCount = nodeTrack->GetNumKeyFrames();
+			if (keyCount == 0)
+			{
+				continue;
+			}
+
+			m_keyData.tracks.push_back({ handle, static_cast<uint32>(m_keyData.times.size()), keyCount, nodeTrack->UsesShortestRotationPath() });
+
+			for (uint16 i = 0; i < keyCount; ++i)
+			{
+				const auto keyFrame = nodeTrack->GetNodeKeyFrame(i);
+				m_keyData.times.push_back(keyFrame->GetTime());
+				m_keyData.translations.push_back(keyFrame->GetTranslate());
+				m_keyData.rotations.push_back(keyFrame->GetRotation());
+				m_keyData.scales.push_back(keyFrame->GetScale());
+			}
+		}
+
+		m_keyDataDirty = false;
+	}
+
 	void Animation::OptimizeNodeTracks(const bool discardIdentityTracks)
 	{
 		// Iterate over the node tracks and identify those with no useful keyframes
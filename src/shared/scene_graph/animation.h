@@ -14,6 +14,28 @@ namespace mmo
 	class Animation;
 	class Skeleton;
 
+	/// Key frames of all node tracks of an animation in flat arrays, so that the animation can be sampled without
+	///	going through the key frame objects of its tracks.
+	struct AnimationKeyData
+	{
+		struct Track
+		{
+			uint16 handle;
+			/// Index of the first key frame of the track in the key frame arrays.
+			uint32 firstKey;
+			uint32 keyCount;
+			bool useShortestRotationPath;
+		};
+
+		/// Tracks with at least one key frame, ordered by handle.
+		std::vector<Track> tracks;
+
+		std::vector<float> times;
+		std::vector<Vector3> translations;
+		std::vector<Quaternion> rotations;
+		std::vector<Vector3> scales;
+	};
+
 	class AnimationContainer
 	{
 	public:
@@ -91,7 +113,17 @@ namespace mmo
 
 		NodeAnimationTrack* GetNodeTrack(uint16 handle) const;
 
-		void KeyFrameListChanged() const { m_keyFrameTimesDirty = true; }
+		void KeyFrameListChanged() const { m_keyFrameTimesDirty = true; m_keyDataDirty = true; }
+
+		/// Called by the tracks whenever a key frame of the animation was modified.
+		void KeyFrameDataChanged() const { m_keyDataDirty = true; }
+
+		/// Applies a pending base key frame and rebuilds the flat key frame data if a key frame changed since the
+		///	last call. Not thread safe, has to be called before the animation is sampled through GetKeyData.
+		const AnimationKeyData& PrepareKeyData();
+
+		/// Gets the flat key frame data as of the last call to PrepareKeyData. Safe to call from multiple threads.
+		[[nodiscard]] const AnimationKeyData& GetKeyData() const { return m_keyData; }
 
 		void DestroyAllNodeTracks();
 		void DestroyAllTracks();
@@ -165,6 +197,10 @@ namespace mmo
 		/// Dirty flag indicate that keyframe time list need to rebuild
 		mutable bool m_keyFrameTimesDirty;
 
+		AnimationKeyData m_keyData;
+		/// Dirty flag indicate that the flat key frame data need to rebuild
+		mutable bool m_keyDataDirty { true };
+
 		bool m_useBaseKeyFrame;
 		float m_baseKeyFrameTime;
 		String m_baseKeyFrameAnimationName;
@@ -179,6 +215,8 @@ namespace mmo
 	protected:
 		void BuildKeyFrameTimeList() const;
 
+		void BuildKeyData();
+
 		void OptimizeNodeTracks(bool discardIdentityTracks = true);
 	};
 }
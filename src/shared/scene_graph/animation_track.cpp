@@ -264,6 +264,7 @@ namespace mmo
 	void NodeAnimationTrack::SetUseShortestRotationPath(bool useShortestPath)
 	{
 		m_useShortestRotationPath = useShortestPath;
+		m_parent.KeyFrameDataChanged();
 	}
 
 	bool NodeAnimationTrack::UsesShortestRotationPath() const
@@ -343,6 +344,7 @@ namespace mmo
 	void NodeAnimationTrack::KeyFrameDataChanged() const
 	{
 		m_splineBuildNeeded = true;
+		m_parent.KeyFrameDataChanged();
 	}
 
 	std::shared_ptr<TransformKeyFrame> NodeAnimationTrack::GetNodeKeyFrame(const uint16 index) const
@@ -83,6 +83,21 @@ namespace mmo
         m.MakeTransform(locTranslate, locScale, locRotate);
     }
 
+    void Bone::SetPoseTransform(const Vector3& position, const Quaternion& orientation, const Vector3& scale,
+        const Vector3& derivedPosition, const Quaternion& derivedOrientation, const Vector3& derivedScale)
+    {
+        m_position = position;
+        m_orientation = orientation;
+        m_scale = scale;
+
+        m_derivedPosition = derivedPosition;
+        m_derivedOrientation = derivedOrientation;
+        m_derivedScale = derivedScale;
+
+        m_needParentUpdate = false;
+        m_cachedTransformInvalid = true;
+    }
+
     unsigned short Bone::GetHandle(void) const
     {
         return m_handle;
@@ -39,6 +39,12 @@ namespace mmo
 
 		void NeedUpdate(bool forceParentUpdate = false) override;
 
+		/// Sets the local and the derived transform of the bone at once, as evaluated by a SkeletonPose. Unlike the
+		///	regular setters, this does not flag the bone for an update, as the derived transform is already valid.
+		///	Children which are not part of the pose (like tag points) have to be notified by the caller.
+		void SetPoseTransform(const Vector3& position, const Quaternion& orientation, const Vector3& scale,
+			const Vector3& derivedPosition, const Quaternion& derivedOrientation, const Vector3& derivedScale);
+
 	protected:
 		Node* CreateChildImpl() override;
 
@@ -4,6 +4,7 @@
 
 #include "animation_state.h"
 #include "scene_graph/render_queue.h"
+#include "scene_graph/scene.h"
 #include "scene_graph/scene_node.h"
 #include "skeleton_instance.h"
 #include "tag_point.h"
@@ -141,7 +142,15 @@ namespace mmo
 
 		if (HasSkeleton())
 		{
-			UpdateAnimations();
+			// The scene evaluates the animations of all visible entities at once after the render queue is complete
+			if (m_scene)
+			{
+				m_scene->QueueAnimationUpdate(*this);
+			}
+			else
+			{
+				UpdateAnimations();
+			}
 
 			for (const auto& childIt : m_childObjects)
 			{
@@ -229,36 +238,83 @@ namespace mmo
 	}
 	
 	void Entity::UpdateAnimations()
+	{
+		if (PrepareAnimationUpdate())
+		{
+			EvaluateAnimations();
+			FinishAnimationUpdate();
+		}
+	}
+
+	bool Entity::PrepareAnimationUpdate()
 	{
 		ASSERT(m_skeleton);
 		ASSERT(m_animationStates);
 
 		// Check if animations have been updated this frame already
-		const uint64 currentAnimationFrame = m_animationStates->GetDirtyFrameNumber();
-		if (m_lastAnimationUpdateFrame == currentAnimationFrame && !m_animationsNeedUpdate)
+		if (m_animationUpdatePending ||
+			(m_lastAnimationUpdateFrame == m_animationStates->GetDirtyFrameNumber() && !m_animationsNeedUpdate))
 		{
-			// Animations are already up to date for this frame
-			return;
+			return false;
 		}
 
-		// Apply animation states
-		m_skeleton->SetAnimationState(*m_animationStates);
-
-		const uint16 numBones = m_skeleton->GetNumBones();
-		const size_t requiredSize = static_cast<size_t>(numBones);
-
+		const size_t requiredSize = static_cast<size_t>(m_skeleton->GetNumBones());
 		if (m_boneMatrices.size() != requiredSize)
 		{
 			m_boneMatrices.resize(requiredSize, Matrix4::Identity);
 			m_boneMatrixBuffer = GraphicsDevice::Get().CreateConstantBuffer(sizeof(Matrix4) * requiredSize, m_boneMatrices.data());
 		}
 
-		m_skeleton->GetBoneMatrices(m_boneMatrices.data());
-		m_boneMatrixBuffer->Update(m_boneMatrices.data());
+		m_evaluatePose = m_skeleton->GetPose().Prepare(*m_skeleton, *m_animationStates);
+		m_animationUpdatePending = true;
+		return true;
+	}
+
+	void Entity::EvaluateAnimations()
+	{
+		ASSERT(m_animationUpdatePending);
+
+		// Spline animations and manual bones are applied to the bone nodes in FinishAnimationUpdate, because
+		// the bone nodes share lazily built data with other skeleton instances
+		if (m_evaluatePose)
+		{
+			m_skeleton->GetPose().Evaluate(m_boneMatrices.data());
+		}
+	}
+
+	void Entity::FinishAnimationUpdate()
+	{
+		ASSERT(m_animationUpdatePending);
+
+		if (m_evaluatePose)
+		{
+			m_skeleton->GetPose().ApplyToBones();
+
+			// Tag points are not part of the pose, so they have to pick up the new bone transforms themselves
+			for (const auto& [name, object] : m_childObjects)
+			{
+				if (Node* tagPoint = object->GetParentNode())
+				{
+					tagPoint->NeedUpdate();
+				}
+			}
+		}
+		else
+		{
+			m_skeleton->SetAnimationState(*m_animationStates);
+			m_skeleton->GetBoneMatrices(m_boneMatrices.data());
+		}
+
+		// The null graphics device of headless applications doesn't create constant buffers
+		if (m_boneMatrixBuffer)
+		{
+			m_boneMatrixBuffer->Update(m_boneMatrices.data());
+		}
 
 		// Update cache information
-		m_lastAnimationUpdateFrame = currentAnimationFrame;
+		m_lastAnimationUpdateFrame = m_animationStates->GetDirtyFrameNumber();
 		m_animationsNeedUpdate = false;
+		m_animationUpdatePending = false;
 	}
 
 	void Entity::AttachObjectImpl(MovableObject& pMovable, TagPoint& pAttachingPoint)
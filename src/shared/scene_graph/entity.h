@@ -18,6 +18,7 @@ namespace mmo
 	class Entity : public MovableObject, public ICollidable
 	{
 		friend class SubEntity;
+		friend class Scene;
 
 	public:
 
@@ -51,6 +52,9 @@ namespace mmo
 
 		AnimationStateSet* GetAllAnimationStates() const;
 
+		/// Gets the skinning matrices of the last animation update, indexed by bone handle.
+		[[nodiscard]] const std::vector<Matrix4>& GetBoneMatrices() const { return m_boneMatrices; }
+
 		void SetMesh(MeshPtr mesh);
 
 		ICollidable* GetCollidable() override { return this; }
@@ -82,6 +86,19 @@ namespace mmo
 		/// Uses frame-based caching to ensure animations are only computed once per frame.
 		void UpdateAnimations();
 
+		/// @brief First step of UpdateAnimations, executed on the main thread. Checks whether the animations
+		/// changed since the bone matrices were computed last and captures the animation states to evaluate.
+		/// @return true if EvaluateAnimations and FinishAnimationUpdate have to be called.
+		bool PrepareAnimationUpdate();
+
+		/// @brief Second step of UpdateAnimations, which computes the bone matrices. Only touches the entity's own
+		/// skeleton instance, so the animations of different entities can be evaluated in parallel.
+		void EvaluateAnimations();
+
+		/// @brief Last step of UpdateAnimations, executed on the main thread. Uploads the bone matrices and
+		/// updates the bone nodes for tag points and bone queries.
+		void FinishAnimationUpdate();
+
 		void AttachObjectImpl(MovableObject& pMovable, TagPoint& pAttachingPoint);
 
 		void DetachObjectImpl(MovableObject& pObject) const;
@@ -115,6 +132,16 @@ namespace mmo
 		/// @brief Cached flag to check if animations need updating this frame
 		mutable bool m_animationsNeedUpdate{ true };
 
+		/// @brief Whether the prepared animation update is evaluated by the skeleton pose instead of the bone nodes.
+		bool m_evaluatePose{ false };
+
+		/// @brief Set between PrepareAnimationUpdate and FinishAnimationUpdate.
+		bool m_animationUpdatePending{ false };
+
+		/// @brief Scene animation frame in which the bone matrices were computed last, used to reduce the update
+		/// rate of distant entities.
+		uint64 m_lastSceneAnimationFrame{ 0 };
+
 	public:
 
 		/// @brief Invalidates the animation cache, forcing an update on next render
@@ -1,12 +1,47 @@
 #include "octree_scene.h"
 #include "octree_node.h"
 #include "camera.h"
+#include "base/job_system.h"
+#include "base/profiler.h"
 #include "log/default_log_levels.h"
 
 #include <algorithm>
 
 namespace mmo
 {
+	namespace
+	{
+		/// Calls the given function for all child octants of an octant, starting with the ones closest to the camera.
+		template<typename Func>
+		void ForEachChildFrontToBack(const Octree& octant, const Vector3& cameraPosition, Func&& func)
+		{
+			const Vector3 octantCenter = (octant.m_box.min + octant.m_box.max) * 0.5f;
+			const bool camIsInFront[3] = {
+				cameraPosition.x <= octantCenter.x,
+				cameraPosition.y <= octantCenter.y,
+				cameraPosition.z <= octantCenter.z
+			};
+
+			for (int i = 0; i < 2; ++i)
+			{
+				const int x = camIsInFront[0] ? i : 1 - i;
+				for (int j = 0; j < 2; ++j)
+				{
+					const int y = camIsInFront[1] ? j : 1 - j;
+					for (int k = 0; k < 2; ++k)
+					{
+						const int z = camIsInFront[2] ? k : 1 - k;
+
+						if (Octree* child = octant.m_children[x][y][z].get())
+						{
+							func(*child);
+						}
+					}
+				}
+			}
+		}
+	}
+
 	// Implementation of CachedFrustumPlanes
 	CachedFrustumPlanes::CachedFrustumPlanes(const Camera& camera)
 		: farDistance(camera.GetFarClipDistance())
@@ -392,102 +427,133 @@ namespace mmo
 
 	void OctreeScene::FindVisibleObjects(Camera& camera, VisibleObjectsBoundsInfo& visibleObjectBounds, bool onlyShadowCasters)
 	{
-		GetRenderQueue().Clear();
+		PROFILE_SCOPE("OctreeScene::FindVisibleObjects");
 
-		// Cache the camera frustum planes for this frame to avoid recomputing them
-		CachedFrustumPlanes cachedPlanes(camera);
-		
-		// Walk the octree, adding all visible Octree nodes to the render queue
-		WalkOctree(camera, GetRenderQueue(), *m_octree, visibleObjectBounds, false, onlyShadowCasters, cachedPlanes);
+		RenderQueue& queue = GetRenderQueue();
+		queue.Clear();
+
+		// Cache the camera frustum planes and position for this frame to avoid recomputing them. The camera
+		// updates these lazily, so they must not be queried from the cull jobs.
+		const CachedFrustumPlanes cachedPlanes(camera);
+		const Vector3 cameraPosition = camera.GetDerivedPosition();
+
+		// Split the octree into subtrees and find the visible octree nodes of all subtrees in parallel
+		m_cullTaskCount = 0;
+		CollectCullTasks(*m_octree, false, 0, cachedPlanes, cameraPosition);
+
+		const auto cull = [this, &cachedPlanes, &cameraPosition](const size_t index)
+		{
+			CullTask& task = m_cullTasks[index];
+			CullOctree(*task.octant, task.visibility, task.includeChildren, cachedPlanes, cameraPosition, task.visibleNodes);
+		};
+
+		if (JobSystem* jobSystem = GetJobSystem())
+		{
+			jobSystem->ParallelFor(m_cullTaskCount, cull);
+		}
+		else
+		{
+			for (size_t i = 0; i < m_cullTaskCount; ++i)
+			{
+				cull(i);
+			}
+		}
+
+		// Populating the render queue updates per-camera object state, animations and occlusion queries and is
+		// therefore done on this thread. Tasks are processed in traversal order, so the queue has the same
+		// front-to-back order as with a single threaded traversal.
+		for (size_t i = 0; i < m_cullTaskCount; ++i)
+		{
+			for (OctreeNode* node : m_cullTasks[i].visibleNodes)
+			{
+				node->AddToRenderQueue(camera, queue, visibleObjectBounds, onlyShadowCasters);
+			}
+		}
 	}
 
-	void OctreeScene::WalkOctree(Camera& camera, RenderQueue& queue, Octree& octant, 
-		VisibleObjectsBoundsInfo& visibleBounds, const bool foundVisible, 
-		const bool onlyShadowCasters, const CachedFrustumPlanes& cachedPlanes)
+	AABBVisibility OctreeScene::GetOctantVisibility(const Octree& octant, const bool foundVisible, const CachedFrustumPlanes& cachedPlanes) const
 	{
 		if (octant.GetNumNodes() == 0)
 		{
-			return;
+			return aabb_visibility::None;
 		}
 
-		// Determine visibility using cached frustum planes
-		AABBVisibility v = aabb_visibility::None;
 		if (foundVisible)
 		{
-			v = aabb_visibility::Full;
-		}
-		else if (&octant == m_octree.get())
-		{
-			v = aabb_visibility::Partial;
+			return aabb_visibility::Full;
 		}
-		else
+
+		if (&octant == m_octree.get())
 		{
-			AABB box;
-			octant.GetCullBounds(box);
-			v = cachedPlanes.GetVisibility(box);
+			return aabb_visibility::Partial;
 		}
 
-		// Not visible, nothing to do
-		if (v == aabb_visibility::None)
+		AABB box;
+		octant.GetCullBounds(box);
+		return cachedPlanes.GetVisibility(box);
+	}
+
+	void OctreeScene::CollectCullTasks(Octree& octant, const bool foundVisible, const size_t depth, const CachedFrustumPlanes& cachedPlanes, const Vector3& cameraPosition)
+	{
+		const AABBVisibility visibility = GetOctantVisibility(octant, foundVisible, cachedPlanes);
+		if (visibility == aabb_visibility::None)
 		{
 			return;
 		}
 
-		// Add stuff to be rendered
-		bool vis = true;
-
-		// Process nodes in this octant
-		auto it = octant.m_nodes.begin();
-		while (it != octant.m_nodes.end())
+		const bool includeChildren = depth >= ParallelCullDepth;
+		if (includeChildren || !octant.m_nodes.empty())
 		{
-			OctreeNode* sn = *it;
-
-			// if this octree is partially visible, manually cull all
-			// scene nodes attached directly to this level.
-			if (v == aabb_visibility::Partial)
+			if (m_cullTaskCount == m_cullTasks.size())
 			{
-				vis = cachedPlanes.IsVisible(sn->GetWorldAABB());
+				m_cullTasks.emplace_back();
 			}
 
-			if (vis)
+			CullTask& task = m_cullTasks[m_cullTaskCount++];
+			task.octant = &octant;
+			task.visibility = visibility;
+			task.includeChildren = includeChildren;
+			task.visibleNodes.clear();
+		}
+
+		if (includeChildren)
+		{
+			return;
+		}
+
+		ForEachChildFrontToBack(octant, cameraPosition, [&](Octree& child)
+		{
+			CollectCullTasks(child, visibility == aabb_visibility::Full, depth + 1, cachedPlanes, cameraPosition);
+		});
+	}
+
+	void OctreeScene::CullOctree(const Octree& octant, const AABBVisibility visibility, const bool includeChildren,
+		const CachedFrustumPlanes& cachedPlanes, const Vector3& cameraPosition, std::vector<OctreeNode*>& outNodes) const
+	{
+		// If this octant is only partially visible, manually cull all scene nodes attached directly to this level
+		for (OctreeNode* node : octant.m_nodes)
+		{
+			if (visibility == aabb_visibility::Full || cachedPlanes.IsVisible(node->GetWorldAABB()))
 			{
-				sn->AddToRenderQueue(camera, queue, visibleBounds, onlyShadowCasters);
+				outNodes.push_back(node);
 			}
-
-			++it;
 		}
 
-		// Recursively process child octants
-		const bool childFoundVisible = (v == aabb_visibility::Full);
-		
-		// Calculate camera position relative to octant center for front-to-back traversal
-		const Vector3 octantCenter = (octant.m_box.min + octant.m_box.max) * 0.5f;
-		const Vector3 camPos = camera.GetDerivedPosition();
-		const bool camIsInFront[3] = {
-			camPos.x <= octantCenter.x,
-			camPos.y <= octantCenter.y,
-			camPos.z <= octantCenter.z
-		};
+		if (!includeChildren)
+		{
+			return;
+		}
 
 		// Visit children in front-to-back order based on camera position
 		// This improves culling efficiency by processing closer nodes first
-		for (int i = 0; i < 2; ++i)
+		ForEachChildFrontToBack(octant, cameraPosition, [&](const Octree& child)
 		{
-			const int x = camIsInFront[0] ? i : 1 - i;
-			for (int j = 0; j < 2; ++j)
+			const AABBVisibility childVisibility = GetOctantVisibility(child, visibility == aabb_visibility::Full, cachedPlanes);
+			if (childVisibility != aabb_visibility::None)
 			{
-				const int y = camIsInFront[1] ? j : 1 - j;
-				for (int k = 0; k < 2; ++k)
-				{
-					const int z = camIsInFront[2] ? k : 1 - k;
-					
-					if (Octree* child = octant.m_children[x][y][z].get())
-					{
-						WalkOctree(camera, queue, *child, visibleBounds, childFoundVisible, onlyShadowCasters, cachedPlanes);
-					}
-				}
+				CullOctree(child, childVisibility, true, cachedPlanes, cameraPosition, outNodes);
 			}
-		}
+		});
 	}
 
 	void OctreeScene::GatherShadowCasters(const AABB& worldRegion, std::vector<MovableObject*>& outCasters)
@@ -164,17 +164,47 @@ namespace mmo
 		/// the region.
 		void GatherShadowCastersRecursive(Octree& octant, const AABB& worldRegion, std::vector<MovableObject*>& outCasters) const;
 
-		void WalkOctree(Camera& camera, RenderQueue& queue, Octree& octant, VisibleObjectsBoundsInfo& visibleBounds, 
-			bool foundVisible, bool onlyShadowCasters, const CachedFrustumPlanes& cachedPlanes);
+		/// Gets the visibility of an octant, or None if it is empty.
+		AABBVisibility GetOctantVisibility(const Octree& octant, bool foundVisible, const CachedFrustumPlanes& cachedPlanes) const;
+
+		/// Splits the visible part of the octree into subtrees which are culled independently. Octants above
+		///	ParallelCullDepth get a task for their own nodes, octants at that depth get a task for their whole
+		///	subtree. Tasks are created in the order in which the serial traversal would visit them.
+		void CollectCullTasks(Octree& octant, bool foundVisible, size_t depth, const CachedFrustumPlanes& cachedPlanes, const Vector3& cameraPosition);
+
+		/// Collects the visible scene nodes of an octant and, if requested, of all its child octants in
+		///	front-to-back order. Only reads octree and node bounds, so different subtrees can be culled concurrently.
+		void CullOctree(const Octree& octant, AABBVisibility visibility, bool includeChildren, const CachedFrustumPlanes& cachedPlanes,
+			const Vector3& cameraPosition, std::vector<OctreeNode*>& outNodes) const;
 
 		std::unique_ptr<SceneNode> CreateSceneNodeImpl() override;
 
 		std::unique_ptr<SceneNode> CreateSceneNodeImpl(const String& name) override;
 
 	protected:
+		/// Depth of the octants whose subtrees are culled as one job. Depth 2 yields up to 64 jobs, which is
+		///	enough to keep all workers busy while keeping the per-job overhead low.
+		static constexpr size_t ParallelCullDepth = 2;
+
+		/// A part of the octree which is culled by a single job.
+		struct CullTask
+		{
+			const Octree* octant { nullptr };
+			AABBVisibility visibility { aabb_visibility::None };
+			bool includeChildren { false };
+
+			/// Visible scene nodes found by the job, in traversal order.
+			std::vector<OctreeNode*> visibleNodes;
+		};
+
 		/// The root octree
 		std::unique_ptr<Octree> m_octree;
 
+		/// Cull tasks of the current traversal. Only the first m_cullTaskCount entries are in use; the rest are
+		///	kept so that their node lists don't need to be reallocated every frame.
+		std::vector<CullTask> m_cullTasks;
+		size_t m_cullTaskCount { 0 };
+
 		/// Max depth for the tree
 		size_t m_maxDepth;
 
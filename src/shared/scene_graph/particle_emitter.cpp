@@ -19,12 +19,14 @@
 #include "math/matrix4.h"
 #include "math/quaternion.h"
 #include "math/radian.h"
+#include "base/macros.h"
 #include "base/random.h"
 #include "log/default_log_levels.h"
 
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <numeric>
 #include <random>
 
 namespace mmo
@@ -33,7 +35,7 @@ namespace mmo
 
 	namespace
 	{
-		float RandomRange(float minValue, float maxValue)
+		float RandomRange(RandomnessGenerator& generator, float minValue, float maxValue)
 		{
 			if (maxValue <= minValue)
 			{
@@ -41,15 +43,15 @@ namespace mmo
 			}
 
 			std::uniform_real_distribution<float> dist(minValue, maxValue);
-			return dist(RandomGenerator);
+			return dist(generator);
 		}
 
-		Vector3 RandomRange(const Vector3& minValue, const Vector3& maxValue)
+		Vector3 RandomRange(RandomnessGenerator& generator, const Vector3& minValue, const Vector3& maxValue)
 		{
 			return Vector3(
-				RandomRange(minValue.x, maxValue.x),
-				RandomRange(minValue.y, maxValue.y),
-				RandomRange(minValue.z, maxValue.z));
+				RandomRange(generator, minValue.x, maxValue.x),
+				RandomRange(generator, minValue.y, maxValue.y),
+				RandomRange(generator, minValue.z, maxValue.z));
 		}
 
 		/// @brief Cheap, smooth, roughly divergence-free turbulence field. No texture lookups.
@@ -70,6 +72,212 @@ namespace mmo
 				(static_cast<uint32>(clamp01(color.y) * 255.0f) << 8) |
 				(static_cast<uint32>(clamp01(color.x) * 255.0f));
 		}
+
+		/// @brief Linearly interpolates between two neighbouring entries of a curve table.
+		float SampleCurve(const std::array<float, ParticleCurveTable::SampleCount + 1>& table, uint32 index, float fraction)
+		{
+			return table[index] + (table[index + 1] - table[index]) * fraction;
+		}
+
+		template<typename T>
+		void Gather(std::vector<T>& values, const std::vector<uint32>& order, std::vector<T>& scratch)
+		{
+			scratch.resize(values.size());
+			for (size_t i = 0; i < order.size(); ++i)
+			{
+				scratch[i] = values[order[i]];
+			}
+			values.swap(scratch);
+		}
+
+		/// @brief Distance above which the camera is considered moved, so particles are sorted from scratch.
+		constexpr float SortCameraMoveThreshold = 0.5f;
+	}
+
+	// ========================================================================
+	// ParticleStore
+	// ========================================================================
+
+	void ParticleStore::Reserve(size_t capacity)
+	{
+		positionX.reserve(capacity);
+		positionY.reserve(capacity);
+		positionZ.reserve(capacity);
+		velocityX.reserve(capacity);
+		velocityY.reserve(capacity);
+		velocityZ.reserve(capacity);
+		colorR.reserve(capacity);
+		colorG.reserve(capacity);
+		colorB.reserve(capacity);
+		colorA.reserve(capacity);
+		size.reserve(capacity);
+		rotation.reserve(capacity);
+		age.reserve(capacity);
+		lifetime.reserve(capacity);
+		angularVelocity.reserve(capacity);
+		baseSize.reserve(capacity);
+		randomPhase.reserve(capacity);
+		spriteIndex.reserve(capacity);
+	}
+
+	void ParticleStore::Clear()
+	{
+		Truncate(0);
+	}
+
+	void ParticleStore::Truncate(size_t count)
+	{
+		if (count >= GetCount())
+		{
+			return;
+		}
+
+		positionX.resize(count);
+		positionY.resize(count);
+		positionZ.resize(count);
+		velocityX.resize(count);
+		velocityY.resize(count);
+		velocityZ.resize(count);
+		colorR.resize(count);
+		colorG.resize(count);
+		colorB.resize(count);
+		colorA.resize(count);
+		size.resize(count);
+		rotation.resize(count);
+		age.resize(count);
+		lifetime.resize(count);
+		angularVelocity.resize(count);
+		baseSize.resize(count);
+		randomPhase.resize(count);
+		spriteIndex.resize(count);
+	}
+
+	void ParticleStore::Push(const Particle& particle)
+	{
+		positionX.push_back(particle.position.x);
+		positionY.push_back(particle.position.y);
+		positionZ.push_back(particle.position.z);
+		velocityX.push_back(particle.velocity.x);
+		velocityY.push_back(particle.velocity.y);
+		velocityZ.push_back(particle.velocity.z);
+		colorR.push_back(particle.color.x);
+		colorG.push_back(particle.color.y);
+		colorB.push_back(particle.color.z);
+		colorA.push_back(particle.color.w);
+		size.push_back(particle.size);
+		rotation.push_back(particle.rotation);
+		age.push_back(particle.age);
+		lifetime.push_back(particle.lifetime);
+		angularVelocity.push_back(particle.angularVelocity);
+		baseSize.push_back(particle.baseSize);
+		randomPhase.push_back(particle.randomPhase);
+		spriteIndex.push_back(particle.spriteIndex);
+	}
+
+	Particle ParticleStore::Get(size_t index) const
+	{
+		Particle particle;
+		particle.position = Vector3(positionX[index], positionY[index], positionZ[index]);
+		particle.velocity = Vector3(velocityX[index], velocityY[index], velocityZ[index]);
+		particle.color = Vector4(colorR[index], colorG[index], colorB[index], colorA[index]);
+		particle.size = size[index];
+		particle.rotation = rotation[index];
+		particle.age = age[index];
+		particle.lifetime = lifetime[index];
+		particle.angularVelocity = angularVelocity[index];
+		particle.spriteIndex = spriteIndex[index];
+		particle.baseSize = baseSize[index];
+		particle.randomPhase = randomPhase[index];
+		particle.pad0 = 0.0f;
+		particle.pad1 = 0.0f;
+		return particle;
+	}
+
+	void ParticleStore::RemoveExpired()
+	{
+		const size_t count = GetCount();
+
+		size_t kept = 0;
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (age[i] >= lifetime[i])
+			{
+				continue;
+			}
+
+			if (kept != i)
+			{
+				Move(i, kept);
+			}
+			++kept;
+		}
+
+		Truncate(kept);
+	}
+
+	void ParticleStore::Permute(const std::vector<uint32>& order, std::vector<float>& floatScratch, std::vector<uint32>& indexScratch)
+	{
+		ASSERT(order.size() == GetCount());
+
+		Gather(positionX, order, floatScratch);
+		Gather(positionY, order, floatScratch);
+		Gather(positionZ, order, floatScratch);
+		Gather(velocityX, order, floatScratch);
+		Gather(velocityY, order, floatScratch);
+		Gather(velocityZ, order, floatScratch);
+		Gather(colorR, order, floatScratch);
+		Gather(colorG, order, floatScratch);
+		Gather(colorB, order, floatScratch);
+		Gather(colorA, order, floatScratch);
+		Gather(size, order, floatScratch);
+		Gather(rotation, order, floatScratch);
+		Gather(age, order, floatScratch);
+		Gather(lifetime, order, floatScratch);
+		Gather(angularVelocity, order, floatScratch);
+		Gather(baseSize, order, floatScratch);
+		Gather(randomPhase, order, floatScratch);
+		Gather(spriteIndex, order, indexScratch);
+	}
+
+	void ParticleStore::Move(size_t from, size_t to)
+	{
+		positionX[to] = positionX[from];
+		positionY[to] = positionY[from];
+		positionZ[to] = positionZ[from];
+		velocityX[to] = velocityX[from];
+		velocityY[to] = velocityY[from];
+		velocityZ[to] = velocityZ[from];
+		colorR[to] = colorR[from];
+		colorG[to] = colorG[from];
+		colorB[to] = colorB[from];
+		colorA[to] = colorA[from];
+		size[to] = size[from];
+		rotation[to] = rotation[from];
+		age[to] = age[from];
+		lifetime[to] = lifetime[from];
+		angularVelocity[to] = angularVelocity[from];
+		baseSize[to] = baseSize[from];
+		randomPhase[to] = randomPhase[from];
+		spriteIndex[to] = spriteIndex[from];
+	}
+
+	// ========================================================================
+	// ParticleCurveTable
+	// ========================================================================
+
+	void ParticleCurveTable::Bake(const FloatCurve& sizeCurve, const ColorCurve& colorCurve)
+	{
+		for (uint32 i = 0; i <= SampleCount; ++i)
+		{
+			const float t = static_cast<float>(i) / static_cast<float>(SampleCount);
+			const Vector4 color = colorCurve.Evaluate(t);
+
+			size[i] = sizeCurve.Evaluate(t);
+			colorR[i] = color.x;
+			colorG[i] = color.y;
+			colorB[i] = color.z;
+			colorA[i] = color.w;
+		}
 	}
 
 	// ========================================================================
@@ -126,9 +334,9 @@ namespace mmo
 		return m_parent.GetMaterial();
 	}
 
-	void ParticleRenderable::RebuildBuffers(const std::vector<Particle>& particles, const Camera& camera)
+	void ParticleRenderable::RebuildBuffers(const ParticleStore& particles, const Camera& camera)
 	{
-		const size_t particleCount = particles.size();
+		const size_t particleCount = particles.GetCount();
 		if (particleCount == 0)
 		{
 			m_vertexData->vertexCount = 0;
@@ -186,11 +394,10 @@ namespace mmo
 
 		for (size_t i = 0; i < particleCount; ++i)
 		{
-			const Particle& particle = particles[i];
-
-			const Vector3 worldPos = bake.TransformAffine(particle.position);
-			const Vector3 worldVel = bake.TransformDirectionAffine(particle.velocity);
-			const float halfSize = particle.size * 0.5f;
+			const Vector3 worldPos = bake.TransformAffine(Vector3(particles.positionX[i], particles.positionY[i], particles.positionZ[i]));
+			const Vector3 worldVel = bake.TransformDirectionAffine(Vector3(particles.velocityX[i], particles.velocityY[i], particles.velocityZ[i]));
+			const float halfSize = particles.size[i] * 0.5f;
+			const float rotation = particles.rotation[i];
 
 			Vector3 rightOffset;
 			Vector3 upOffset;
@@ -234,10 +441,10 @@ namespace mmo
 			{
 				Vector3 right = Vector3::UnitX;
 				Vector3 up = Vector3::UnitZ;
-				if (particle.rotation != 0.0f)
+				if (rotation != 0.0f)
 				{
-					const float c = std::cos(particle.rotation);
-					const float s = std::sin(particle.rotation);
+					const float c = std::cos(rotation);
+					const float s = std::sin(rotation);
 					const Vector3 r2 = right * c + up * s;
 					const Vector3 u2 = right * (-s) + up * c;
 					right = r2;
@@ -253,10 +460,10 @@ namespace mmo
 			{
 				Vector3 right = camRight;
 				Vector3 up = camUp;
-				if (particle.rotation != 0.0f)
+				if (rotation != 0.0f)
 				{
-					const float c = std::cos(particle.rotation);
-					const float s = std::sin(particle.rotation);
+					const float c = std::cos(rotation);
+					const float s = std::sin(rotation);
 					const Vector3 r2 = right * c + up * s;
 					const Vector3 u2 = right * (-s) + up * c;
 					right = r2;
@@ -268,9 +475,9 @@ namespace mmo
 			}
 			}
 
-			const uint32 color = PackColorAbgr(particle.color);
+			const uint32 color = PackColorAbgr(Vector4(particles.colorR[i], particles.colorG[i], particles.colorB[i], particles.colorA[i]));
 
-			const uint32 frame = (spriteTotal > 0) ? (particle.spriteIndex % spriteTotal) : 0;
+			const uint32 frame = (spriteTotal > 0) ? (particles.spriteIndex[i] % spriteTotal) : 0;
 			const uint32 col = frame % spriteCols;
 			const uint32 row = frame / spriteCols;
 			const float uMin = col * du;
@@ -328,25 +535,6 @@ namespace mmo
 		m_indexData->indexStart = 0;
 	}
 
-	void ParticleRenderable::SortParticles(std::vector<Particle>& particles, const Camera& camera) const
-	{
-		if (particles.empty())
-		{
-			return;
-		}
-
-		const Vector3 cameraPos = camera.GetDerivedPosition();
-		const Matrix4& bake = m_parent.GetWorldTransform();
-
-		std::sort(particles.begin(), particles.end(),
-			[&cameraPos, &bake](const Particle& a, const Particle& b) -> bool
-			{
-				const float distA = (bake.TransformAffine(a.position) - cameraPos).GetSquaredLength();
-				const float distB = (bake.TransformAffine(b.position) - cameraPos).GetSquaredLength();
-				return distA > distB;
-			});
-	}
-
 	void ParticleRenderable::EnsureIndexBuffer(size_t particleCount)
 	{
 		const size_t requiredIndexCount = particleCount * 6;
@@ -446,22 +634,22 @@ namespace mmo
 	EmitterInstance::EmitterInstance(GraphicsDevice& device, ParticleSystem& system)
 		: m_device(device)
 		, m_system(system)
+		, m_random(RandomGenerator())
 	{
 		m_renderable = std::make_unique<ParticleRenderable>(m_device, *this);
 		m_boundingBox.min = Vector3::Zero;
 		m_boundingBox.max = Vector3::Zero;
-		m_particles.reserve(m_parameters.maxParticles);
+		m_particles.Reserve(m_parameters.maxParticles);
+		m_curves.Bake(m_parameters.sizeOverLife, m_parameters.colorOverLifetime);
 		m_burstFired.resize(m_parameters.bursts.size(), 0);
 	}
 
 	void EmitterInstance::SetParameters(const EmitterParameters& params)
 	{
 		m_parameters = params;
-		m_particles.reserve(params.maxParticles);
-		if (m_particles.size() > params.maxParticles)
-		{
-			m_particles.resize(params.maxParticles);
-		}
+		m_particles.Reserve(params.maxParticles);
+		m_particles.Truncate(params.maxParticles);
+		m_curves.Bake(m_parameters.sizeOverLife, m_parameters.colorOverLifetime);
 
 		m_burstFired.assign(params.bursts.size(), 0);
 
@@ -568,23 +756,16 @@ namespace mmo
 		}
 	}
 
-	void EmitterInstance::RebuildInstanceBuffer(const Camera& camera)
+	void EmitterInstance::RebuildInstanceBuffer()
 	{
 		m_instanceCount = 0;
 
-		const size_t particleCount = m_particles.size();
+		const size_t particleCount = m_particles.GetCount();
 		if (particleCount == 0)
 		{
 			return;
 		}
 
-		// Back-to-front sort for translucent mesh materials so per-particle alpha blends correctly.
-		const MaterialPtr firstMaterial = m_meshRenderables.empty() ? nullptr : m_meshRenderables.front()->GetMaterial();
-		if (firstMaterial && firstMaterial->IsTranslucent())
-		{
-			m_renderable->SortParticles(m_particles, camera);
-		}
-
 		if (!m_instanceBuffer || m_instanceBufferCapacity < particleCount)
 		{
 			size_t newCapacity = particleCount;
@@ -606,13 +787,12 @@ namespace mmo
 		auto* instances = static_cast<ParticleMeshInstance*>(m_instanceBuffer->Map(LockOptions::Discard));
 		for (size_t i = 0; i < particleCount; ++i)
 		{
-			const Particle& particle = m_particles[i];
-			const Vector3 worldPos = bake.TransformAffine(particle.position);
-			const Quaternion rotation(Radian(particle.rotation), Vector3::UnitY);
-			const float scale = (particle.size > 1e-4f) ? particle.size : 1e-4f;
+			const Vector3 worldPos = bake.TransformAffine(Vector3(m_particles.positionX[i], m_particles.positionY[i], m_particles.positionZ[i]));
+			const Quaternion rotation(Radian(m_particles.rotation[i]), Vector3::UnitY);
+			const float scale = (m_particles.size[i] > 1e-4f) ? m_particles.size[i] : 1e-4f;
 
 			instances[i].world.MakeTransform(worldPos, Vector3(scale, scale, scale), rotation);
-			instances[i].color = particle.color;
+			instances[i].color = Vector4(m_particles.colorR[i], m_particles.colorG[i], m_particles.colorB[i], m_particles.colorA[i]);
 		}
 		m_instanceBuffer->Unmap();
 
@@ -621,7 +801,8 @@ namespace mmo
 
 	void EmitterInstance::Reset()
 	{
-		m_particles.clear();
+		m_particles.Clear();
+		m_hasSorted = false;
 		m_spawnAccumulator = 0.0f;
 		m_age = 0.0f;
 		m_cycleTime = 0.0f;
@@ -637,10 +818,10 @@ namespace mmo
 			return false;
 		}
 
-		return (m_age >= (m_parameters.startDelay + m_parameters.duration)) && m_particles.empty();
+		return (m_age >= (m_parameters.startDelay + m_parameters.duration)) && m_particles.IsEmpty();
 	}
 
-	Vector3 EmitterInstance::GetSpawnPosition(Vector3& outDirection) const
+	Vector3 EmitterInstance::GetSpawnPosition(Vector3& outDirection)
 	{
 		switch (m_parameters.shape)
 		{
@@ -650,7 +831,7 @@ namespace mmo
 			Vector3 offset;
 			do
 			{
-				offset = Vector3(RandomRange(-1.0f, 1.0f), RandomRange(-1.0f, 1.0f), RandomRange(-1.0f, 1.0f));
+				offset = Vector3(RandomRange(m_random, -1.0f, 1.0f), RandomRange(m_random, -1.0f, 1.0f), RandomRange(m_random, -1.0f, 1.0f));
 			} while (offset.GetSquaredLength() > 1.0f);
 
 			outDirection = offset.GetSquaredLength() > 1e-6f ? offset.NormalizedCopy() : Vector3::UnitY;
@@ -662,9 +843,9 @@ namespace mmo
 			const Vector3 halfExtents = m_parameters.shapeExtents * 0.5f;
 			outDirection = Vector3::UnitY;
 			return Vector3(
-				RandomRange(-halfExtents.x, halfExtents.x),
-				RandomRange(-halfExtents.y, halfExtents.y),
-				RandomRange(-halfExtents.z, halfExtents.z));
+				RandomRange(m_random, -halfExtents.x, halfExtents.x),
+				RandomRange(m_random, -halfExtents.y, halfExtents.y),
+				RandomRange(m_random, -halfExtents.z, halfExtents.z));
 		}
 
 		case EmitterShape::Cone:
@@ -672,10 +853,10 @@ namespace mmo
 			const float height = m_parameters.shapeExtents.y;
 			const float baseRadius = m_parameters.shapeExtents.z;
 
-			const float t = RandomRange(0.0f, 1.0f);
+			const float t = RandomRange(m_random, 0.0f, 1.0f);
 			const float currentHeight = height * t;
 			const float currentRadius = baseRadius * t;
-			const float theta = RandomRange(0.0f, 2.0f * 3.14159265f);
+			const float theta = RandomRange(m_random, 0.0f, 2.0f * 3.14159265f);
 
 			const Vector3 offset(currentRadius * std::cos(theta), currentHeight, currentRadius * std::sin(theta));
 			outDirection = offset.GetSquaredLength() > 1e-6f ? offset.NormalizedCopy() : Vector3::UnitY;
@@ -691,7 +872,7 @@ namespace mmo
 
 	void EmitterInstance::SpawnOne(const Matrix4& systemWorld, const Vector3& systemWorldPos, const Vector3& systemVelocity)
 	{
-		if (m_particles.size() >= m_parameters.maxParticles)
+		if (m_particles.GetCount() >= m_parameters.maxParticles)
 		{
 			return;
 		}
@@ -701,8 +882,8 @@ namespace mmo
 		Vector3 spawnDir;
 		Vector3 localPos = GetSpawnPosition(spawnDir);
 
-		const float startSpeed = RandomRange(m_parameters.minStartSpeed, m_parameters.maxStartSpeed);
-		Vector3 localVel = RandomRange(m_parameters.minVelocity, m_parameters.maxVelocity) + spawnDir * startSpeed;
+		const float startSpeed = RandomRange(m_random, m_parameters.minStartSpeed, m_parameters.maxStartSpeed);
+		Vector3 localVel = RandomRange(m_random, m_parameters.minVelocity, m_parameters.maxVelocity) + spawnDir * startSpeed;
 
 		if (m_parameters.simulationSpace == SimulationSpace::World)
 		{
@@ -717,36 +898,55 @@ namespace mmo
 			particle.velocity = localVel;
 		}
 
-		particle.lifetime = RandomRange(m_parameters.minLifetime, m_parameters.maxLifetime);
+		particle.lifetime = RandomRange(m_random, m_parameters.minLifetime, m_parameters.maxLifetime);
 		if (particle.lifetime <= 0.0f)
 		{
 			particle.lifetime = 0.0001f;
 		}
 		particle.age = 0.0f;
-		particle.baseSize = RandomRange(m_parameters.minStartSize, m_parameters.maxStartSize);
-		particle.size = particle.baseSize * m_parameters.sizeOverLife.Evaluate(0.0f);
-		particle.rotation = RandomRange(m_parameters.minStartRotation, m_parameters.maxStartRotation);
-		particle.angularVelocity = RandomRange(m_parameters.minAngularVelocity, m_parameters.maxAngularVelocity);
-		particle.color = m_parameters.colorOverLifetime.Evaluate(0.0f);
-		particle.randomPhase = RandomRange(0.0f, 1.0f);
+		particle.baseSize = RandomRange(m_random, m_parameters.minStartSize, m_parameters.maxStartSize);
+		particle.size = particle.baseSize * m_curves.size[0];
+		particle.rotation = RandomRange(m_random, m_parameters.minStartRotation, m_parameters.maxStartRotation);
+		particle.angularVelocity = RandomRange(m_random, m_parameters.minAngularVelocity, m_parameters.maxAngularVelocity);
+		particle.color = Vector4(m_curves.colorR[0], m_curves.colorG[0], m_curves.colorB[0], m_curves.colorA[0]);
+		particle.randomPhase = RandomRange(m_random, 0.0f, 1.0f);
 		particle.pad0 = 0.0f;
 		particle.pad1 = 0.0f;
 
 		const uint32 spriteTotal = std::max<uint32>(1, m_parameters.spriteSheetColumns) * std::max<uint32>(1, m_parameters.spriteSheetRows);
 		if (m_parameters.spriteAnimation == SpriteAnimationMode::RandomStatic && spriteTotal > 1)
 		{
-			particle.spriteIndex = static_cast<uint32>(RandomRange(0.0f, static_cast<float>(spriteTotal))) % spriteTotal;
+			particle.spriteIndex = static_cast<uint32>(RandomRange(m_random, 0.0f, static_cast<float>(spriteTotal))) % spriteTotal;
 		}
 		else
 		{
 			particle.spriteIndex = 0;
 		}
 
-		m_particles.push_back(particle);
+		m_particles.Push(particle);
 	}
 
 	void EmitterInstance::UpdateParticles(float deltaTime)
 	{
+		ParticleStore& p = m_particles;
+
+		// Age first and drop the expired particles, so the following passes only process live particles
+		{
+			float* age = p.age.data();
+			const size_t count = p.GetCount();
+			for (size_t i = 0; i < count; ++i)
+			{
+				age[i] += deltaTime;
+			}
+		}
+		p.RemoveExpired();
+
+		const size_t count = p.GetCount();
+		if (count == 0)
+		{
+			return;
+		}
+
 		const bool localSpace = (m_parameters.simulationSpace == SimulationSpace::Local);
 		const Vector3 forceCenter = localSpace ? Vector3::Zero : m_emitterWorldPos;
 		const Vector3 attractorWorld = localSpace ? m_parameters.attractorPosition : (m_emitterWorldPos + m_parameters.attractorPosition);
@@ -757,109 +957,175 @@ namespace mmo
 		const bool useNoise = m_parameters.noiseAmplitude > 1e-6f;
 		const bool useDrag = m_parameters.drag > 1e-6f;
 
-		const uint32 spriteTotal = std::max<uint32>(1, m_parameters.spriteSheetColumns) * std::max<uint32>(1, m_parameters.spriteSheetRows);
-
-		const float orbitAngle = m_parameters.orbitalSpeed * deltaTime;
-		const float cosA = std::cos(orbitAngle);
-		const float sinA = std::sin(orbitAngle);
+		// Each pass below is a plain loop over a few arrays without calls or data dependent control flow, so the
+		// compiler can vectorize it.
+		float* px = p.positionX.data();
+		float* py = p.positionY.data();
+		float* pz = p.positionZ.data();
+		float* vx = p.velocityX.data();
+		float* vy = p.velocityY.data();
+		float* vz = p.velocityZ.data();
 
-		for (auto& particle : m_particles)
+		// Gravity
 		{
-			particle.age += deltaTime;
-			if (particle.age >= particle.lifetime)
+			const Vector3 gravity = m_parameters.gravity * deltaTime;
+			for (size_t i = 0; i < count; ++i)
 			{
-				continue;
+				vx[i] += gravity.x;
+				vy[i] += gravity.y;
+				vz[i] += gravity.z;
 			}
+		}
 
-			// Gravity
-			particle.velocity += m_parameters.gravity * deltaTime;
-
-			// Radial acceleration (outward / inward from the emitter center)
-			if (useRadial)
+		// Radial acceleration (outward / inward from the emitter center)
+		if (useRadial)
+		{
+			const float acceleration = m_parameters.radialAcceleration * deltaTime;
+			for (size_t i = 0; i < count; ++i)
 			{
-				Vector3 radial = particle.position - forceCenter;
-				if (radial.GetSquaredLength() > 1e-6f)
-				{
-					radial.Normalize();
-					particle.velocity += radial * (m_parameters.radialAcceleration * deltaTime);
-				}
+				const float dx = px[i] - forceCenter.x;
+				const float dy = py[i] - forceCenter.y;
+				const float dz = pz[i] - forceCenter.z;
+				const float lengthSq = dx * dx + dy * dy + dz * dz;
+				const float scale = (lengthSq > 1e-6f) ? acceleration / std::sqrt(lengthSq) : 0.0f;
+				vx[i] += dx * scale;
+				vy[i] += dy * scale;
+				vz[i] += dz * scale;
 			}
+		}
 
-			// Point attractor
-			if (useAttractor)
+		// Point attractor
+		if (useAttractor)
+		{
+			const float acceleration = m_parameters.attractorStrength * deltaTime;
+			for (size_t i = 0; i < count; ++i)
 			{
-				Vector3 toAttractor = attractorWorld - particle.position;
-				if (toAttractor.GetSquaredLength() > 1e-6f)
-				{
-					toAttractor.Normalize();
-					particle.velocity += toAttractor * (m_parameters.attractorStrength * deltaTime);
-				}
+				const float dx = attractorWorld.x - px[i];
+				const float dy = attractorWorld.y - py[i];
+				const float dz = attractorWorld.z - pz[i];
+				const float lengthSq = dx * dx + dy * dy + dz * dz;
+				const float scale = (lengthSq > 1e-6f) ? acceleration / std::sqrt(lengthSq) : 0.0f;
+				vx[i] += dx * scale;
+				vy[i] += dy * scale;
+				vz[i] += dz * scale;
 			}
+		}
 
-			// Turbulence / curl noise
-			if (useNoise)
+		// Turbulence / curl noise
+		if (useNoise)
+		{
+			const float frequency = m_parameters.noiseFrequency;
+			const float amplitude = m_parameters.noiseAmplitude * deltaTime;
+			const float* phase = p.randomPhase.data();
+			for (size_t i = 0; i < count; ++i)
 			{
-				const Vector3 samplePos = particle.position * m_parameters.noiseFrequency + Vector3(particle.randomPhase * 13.0f, 0.0f, 0.0f);
-				particle.velocity += CurlNoise(samplePos, m_noiseTime) * (m_parameters.noiseAmplitude * deltaTime);
+				const Vector3 samplePos = Vector3(px[i], py[i], pz[i]) * frequency + Vector3(phase[i] * 13.0f, 0.0f, 0.0f);
+				const Vector3 noise = CurlNoise(samplePos, m_noiseTime) * amplitude;
+				vx[i] += noise.x;
+				vy[i] += noise.y;
+				vz[i] += noise.z;
 			}
+		}
 
-			// Linear drag
-			if (useDrag)
+		// Linear drag
+		if (useDrag)
+		{
+			const float damp = std::max(1.0f - m_parameters.drag * deltaTime, 0.0f);
+			for (size_t i = 0; i < count; ++i)
 			{
-				const float damp = 1.0f - m_parameters.drag * deltaTime;
-				particle.velocity *= (damp < 0.0f) ? 0.0f : damp;
+				vx[i] *= damp;
+				vy[i] *= damp;
+				vz[i] *= damp;
 			}
+		}
 
-			// Integrate position
-			particle.position += particle.velocity * deltaTime;
+		// Integrate position
+		for (size_t i = 0; i < count; ++i)
+		{
+			px[i] += vx[i] * deltaTime;
+			py[i] += vy[i] * deltaTime;
+			pz[i] += vz[i] * deltaTime;
+		}
 
-			// Orbital swirl around the emitter's Y axis (position-based)
-			if (useOrbital)
+		// Orbital swirl around the emitter's Y axis (position-based)
+		if (useOrbital)
+		{
+			const float orbitAngle = m_parameters.orbitalSpeed * deltaTime;
+			const float cosA = std::cos(orbitAngle);
+			const float sinA = std::sin(orbitAngle);
+			for (size_t i = 0; i < count; ++i)
 			{
-				const Vector3 offset = particle.position - forceCenter;
-				const float rx = offset.x * cosA - offset.z * sinA;
-				const float rz = offset.x * sinA + offset.z * cosA;
-				particle.position = forceCenter + Vector3(rx, offset.y, rz);
+				const float ox = px[i] - forceCenter.x;
+				const float oz = pz[i] - forceCenter.z;
+				px[i] = forceCenter.x + ox * cosA - oz * sinA;
+				pz[i] = forceCenter.z + ox * sinA + oz * cosA;
 			}
+		}
 
-			// Rotation
-			particle.rotation += particle.angularVelocity * deltaTime;
+		// Rotation
+		{
+			float* rotation = p.rotation.data();
+			const float* angularVelocity = p.angularVelocity.data();
+			for (size_t i = 0; i < count; ++i)
+			{
+				rotation[i] += angularVelocity[i] * deltaTime;
+			}
+		}
 
-			const float t = particle.age / particle.lifetime;
+		// Size & colour over life
+		{
+			const float* age = p.age.data();
+			const float* lifetime = p.lifetime.data();
+			const float* baseSize = p.baseSize.data();
+			float* size = p.size.data();
+			float* r = p.colorR.data();
+			float* g = p.colorG.data();
+			float* b = p.colorB.data();
+			float* a = p.colorA.data();
+
+			constexpr uint32 sampleCount = ParticleCurveTable::SampleCount;
+			for (size_t i = 0; i < count; ++i)
+			{
+				const float t = std::min(age[i] / lifetime[i], 1.0f) * static_cast<float>(sampleCount);
+				const uint32 index = std::min(static_cast<uint32>(t), sampleCount - 1);
+				const float fraction = t - static_cast<float>(index);
+
+				size[i] = baseSize[i] * SampleCurve(m_curves.size, index, fraction);
+				r[i] = SampleCurve(m_curves.colorR, index, fraction);
+				g[i] = SampleCurve(m_curves.colorG, index, fraction);
+				b[i] = SampleCurve(m_curves.colorB, index, fraction);
+				a[i] = SampleCurve(m_curves.colorA, index, fraction);
+			}
+		}
 
-			// Size & colour over life
-			particle.size = particle.baseSize * m_parameters.sizeOverLife.Evaluate(t);
-			particle.color = m_parameters.colorOverLifetime.Evaluate(t);
+		// Sprite-sheet animation
+		const uint32 spriteTotal = std::max<uint32>(1, m_parameters.spriteSheetColumns) * std::max<uint32>(1, m_parameters.spriteSheetRows);
+		if (m_parameters.spriteAnimation == SpriteAnimationMode::AnimateOverLife && spriteTotal > 1)
+		{
+			const float* age = p.age.data();
+			const float* lifetime = p.lifetime.data();
+			uint32* spriteIndex = p.spriteIndex.data();
 
-			// Sprite-sheet animation
-			if (m_parameters.spriteAnimation == SpriteAnimationMode::AnimateOverLife && spriteTotal > 1)
+			if (m_parameters.spriteAnimationFps > 0.0f)
 			{
-				uint32 frame;
-				if (m_parameters.spriteAnimationFps > 0.0f)
+				for (size_t i = 0; i < count; ++i)
 				{
-					frame = static_cast<uint32>(particle.age * m_parameters.spriteAnimationFps) % spriteTotal;
+					spriteIndex[i] = static_cast<uint32>(age[i] * m_parameters.spriteAnimationFps) % spriteTotal;
 				}
-				else
+			}
+			else
+			{
+				for (size_t i = 0; i < count; ++i)
 				{
-					frame = static_cast<uint32>(t * static_cast<float>(spriteTotal));
-					if (frame >= spriteTotal)
-					{
-						frame = spriteTotal - 1;
-					}
+					spriteIndex[i] = std::min(static_cast<uint32>(age[i] / lifetime[i] * static_cast<float>(spriteTotal)), spriteTotal - 1);
 				}
-				particle.spriteIndex = frame;
 			}
 		}
-
-		m_particles.erase(
-			std::remove_if(m_particles.begin(), m_particles.end(),
-				[](const Particle& p) { return p.age >= p.lifetime; }),
-			m_particles.end());
 	}
 
 	void EmitterInstance::UpdateBoundingBox()
 	{
-		if (m_particles.empty())
+		if (m_particles.IsEmpty())
 		{
 			m_boundingBox.min = m_emitterWorldPos;
 			m_boundingBox.max = m_emitterWorldPos;
@@ -867,28 +1133,104 @@ namespace mmo
 		}
 
 		const Matrix4& bake = m_renderTransform;
-		Vector3 minPos = bake.TransformAffine(m_particles[0].position);
+		Vector3 minPos = bake.TransformAffine(Vector3(m_particles.positionX[0], m_particles.positionY[0], m_particles.positionZ[0]));
 		Vector3 maxPos = minPos;
 
-		for (const auto& particle : m_particles)
+		const size_t count = m_particles.GetCount();
+		for (size_t i = 0; i < count; ++i)
 		{
-			const Vector3 world = bake.TransformAffine(particle.position);
-			const Vector3 halfSize(particle.size * 0.5f, particle.size * 0.5f, particle.size * 0.5f);
-			const Vector3 pMin = world - halfSize;
-			const Vector3 pMax = world + halfSize;
+			const Vector3 world = bake.TransformAffine(Vector3(m_particles.positionX[i], m_particles.positionY[i], m_particles.positionZ[i]));
+			const float halfSize = m_particles.size[i] * 0.5f;
 
-			minPos.x = std::min(minPos.x, pMin.x);
-			minPos.y = std::min(minPos.y, pMin.y);
-			minPos.z = std::min(minPos.z, pMin.z);
-			maxPos.x = std::max(maxPos.x, pMax.x);
-			maxPos.y = std::max(maxPos.y, pMax.y);
-			maxPos.z = std::max(maxPos.z, pMax.z);
+			minPos.x = std::min(minPos.x, world.x - halfSize);
+			minPos.y = std::min(minPos.y, world.y - halfSize);
+			minPos.z = std::min(minPos.z, world.z - halfSize);
+			maxPos.x = std::max(maxPos.x, world.x + halfSize);
+			maxPos.y = std::max(maxPos.y, world.y + halfSize);
+			maxPos.z = std::max(maxPos.z, world.z + halfSize);
 		}
 
 		m_boundingBox.min = minPos;
 		m_boundingBox.max = maxPos;
 	}
 
+	bool EmitterInstance::NeedsSorting() const
+	{
+		// Back-to-front sort for translucent materials so per-particle alpha blends correctly.
+		if (IsMeshMode())
+		{
+			const MaterialPtr firstMaterial = m_meshRenderables.front()->GetMaterial();
+			return firstMaterial && firstMaterial->IsTranslucent();
+		}
+
+		return m_material && m_material->IsTranslucent();
+	}
+
+	void EmitterInstance::SortParticles(const Vector3& cameraPosition)
+	{
+		const size_t count = m_particles.GetCount();
+		if (count < 2)
+		{
+			return;
+		}
+
+		// Squared world space distance of every particle to the camera
+		const Matrix4& bake = m_renderTransform;
+		const float* px = m_particles.positionX.data();
+		const float* py = m_particles.positionY.data();
+		const float* pz = m_particles.positionZ.data();
+
+		m_sortKeys.resize(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			const float dx = bake[0][0] * px[i] + bake[0][1] * py[i] + bake[0][2] * pz[i] + bake[0][3] - cameraPosition.x;
+			const float dy = bake[1][0] * px[i] + bake[1][1] * py[i] + bake[1][2] * pz[i] + bake[1][3] - cameraPosition.y;
+			const float dz = bake[2][0] * px[i] + bake[2][1] * py[i] + bake[2][2] * pz[i] + bake[2][3] - cameraPosition.z;
+			m_sortKeys[i] = dx * dx + dy * dy + dz * dz;
+		}
+
+		m_sortOrder.resize(count);
+		std::iota(m_sortOrder.begin(), m_sortOrder.end(), 0u);
+
+		const auto isFarther = [this](const uint32 a, const uint32 b) { return m_sortKeys[a] > m_sortKeys[b]; };
+
+		// Compare the camera position relative to the emitter, so that moving or rotating a local space emitter
+		// triggers a full sort as well
+		const Vector3 localCameraPosition = bake.InverseAffine().TransformAffine(cameraPosition);
+		const bool cameraMoved = !m_hasSorted ||
+			(localCameraPosition - m_lastSortCameraPos).GetSquaredLength() > SortCameraMoveThreshold * SortCameraMoveThreshold;
+		if (cameraMoved)
+		{
+			std::sort(m_sortOrder.begin(), m_sortOrder.end(), isFarther);
+			m_lastSortCameraPos = localCameraPosition;
+			m_hasSorted = true;
+		}
+		else
+		{
+			for (size_t i = 1; i < count; ++i)
+			{
+				const uint32 index = m_sortOrder[i];
+				size_t j = i;
+				while (j > 0 && isFarther(index, m_sortOrder[j - 1]))
+				{
+					m_sortOrder[j] = m_sortOrder[j - 1];
+					--j;
+				}
+				m_sortOrder[j] = index;
+			}
+		}
+
+		// Most frames only change the order of a few particles, if at all
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (m_sortOrder[i] != i)
+			{
+				m_particles.Permute(m_sortOrder, m_sortScratch, m_sortIndexScratch);
+				break;
+			}
+		}
+	}
+
 	void EmitterInstance::SimulateWarmup(const Matrix4& systemWorld, const Vector3& systemWorldPos, const Vector3& systemVelocity)
 	{
 		m_warmedUp = true;
@@ -906,16 +1248,16 @@ namespace mmo
 		{
 			const float dt = std::min(step, remaining);
 			remaining -= dt;
-			Update(dt, systemWorld, systemWorldPos, systemVelocity, nullptr);
+			Simulate(dt, systemWorld, systemWorldPos, systemVelocity, nullptr);
 		}
 	}
 
-	void EmitterInstance::Update(float deltaTime, const Matrix4& systemWorld, const Vector3& systemWorldPos,
-		const Vector3& systemVelocity, const Camera* camera)
+	void EmitterInstance::Simulate(float deltaTime, const Matrix4& systemWorld, const Vector3& systemWorldPos,
+		const Vector3& systemVelocity, const Vector3* cameraPosition)
 	{
 		if (!m_parameters.enabled)
 		{
-			m_particles.clear();
+			m_particles.Clear();
 			return;
 		}
 
@@ -959,7 +1301,7 @@ namespace mmo
 			if (m_parameters.spawnRate > 0.0f)
 			{
 				m_spawnAccumulator += deltaTime * m_parameters.spawnRate;
-				while (m_spawnAccumulator >= 1.0f && m_particles.size() < m_parameters.maxParticles)
+				while (m_spawnAccumulator >= 1.0f && m_particles.GetCount() < m_parameters.maxParticles)
 				{
 					SpawnOne(systemWorld, systemWorldPos, systemVelocity);
 					m_spawnAccumulator -= 1.0f;
@@ -976,7 +1318,7 @@ namespace mmo
 				if (!m_burstFired[i] && cycleTimeForBurst >= m_parameters.bursts[i].time)
 				{
 					const uint32 count = m_parameters.bursts[i].count;
-					for (uint32 c = 0; c < count && m_particles.size() < m_parameters.maxParticles; ++c)
+					for (uint32 c = 0; c < count && m_particles.GetCount() < m_parameters.maxParticles; ++c)
 					{
 						SpawnOne(systemWorld, systemWorldPos, systemVelocity);
 					}
@@ -988,22 +1330,28 @@ namespace mmo
 		UpdateParticles(deltaTime);
 		UpdateBoundingBox();
 
-		// Only (re)build GPU buffers when a camera is available (skipped during head-less warm-up).
+		// Sorting is skipped during head-less warm-up.
+		if (cameraPosition && NeedsSorting())
+		{
+			SortParticles(*cameraPosition);
+		}
+	}
+
+	void EmitterInstance::UpdateRenderData(const Camera& camera)
+	{
+		if (!m_parameters.enabled)
+		{
+			return;
+		}
+
 		// RebuildBuffers safely clears the buffers when the particle list is empty.
-		if (camera)
+		if (IsMeshMode())
 		{
-			if (IsMeshMode())
-			{
-				RebuildInstanceBuffer(*camera);
-			}
-			else
-			{
-				if (!m_particles.empty() && m_material && m_material->IsTranslucent())
-				{
-					m_renderable->SortParticles(m_particles, *camera);
-				}
-				m_renderable->RebuildBuffers(m_particles, *camera);
-			}
+			RebuildInstanceBuffer();
+		}
+		else
+		{
+			m_renderable->RebuildBuffers(m_particles, camera);
 		}
 	}
 
@@ -1204,36 +1552,66 @@ namespace mmo
 	}
 
 	void ParticleSystem::Update(float deltaTime)
+	{
+		PrepareUpdate(deltaTime);
+		Simulate();
+		FinishUpdate();
+	}
+
+	void ParticleSystem::PrepareUpdate(float deltaTime)
 	{
 		// Clamp to avoid huge jumps (debugger pauses, hitches).
-		const float dt = std::min(std::max(deltaTime, 0.0f), 0.1f);
+		m_updateDelta = std::min(std::max(deltaTime, 0.0f), 0.1f);
 
-		Matrix4 worldMatrix = Matrix4::Identity;
-		Vector3 worldPos = Vector3::Zero;
+		m_updateWorld = Matrix4::Identity;
+		m_updateWorldPos = Vector3::Zero;
 		if (m_parentNode)
 		{
-			worldMatrix = m_parentNode->GetFullTransform();
-			worldPos = m_parentNode->GetDerivedPosition();
+			m_updateWorld = m_parentNode->GetFullTransform();
+			m_updateWorldPos = m_parentNode->GetDerivedPosition();
 		}
 
-		Vector3 systemVelocity = Vector3::Zero;
-		if (m_hasLastWorldPos && dt > 1e-5f)
+		m_updateVelocity = Vector3::Zero;
+		if (m_hasLastWorldPos && m_updateDelta > 1e-5f)
 		{
-			systemVelocity = (worldPos - m_lastWorldPos) / dt;
+			m_updateVelocity = (m_updateWorldPos - m_lastWorldPos) / m_updateDelta;
 		}
-		m_lastWorldPos = worldPos;
+		m_lastWorldPos = m_updateWorldPos;
 		m_hasLastWorldPos = true;
 
-		Camera* camera = m_scene ? m_scene->GetCamera(0) : nullptr;
+		// The derived camera position is cached lazily, so it is read here rather than during the simulation.
+		m_updateCamera = m_scene ? m_scene->GetCamera(0) : nullptr;
+		if (m_updateCamera)
+		{
+			m_updateCameraPos = m_updateCamera->GetDerivedPosition();
+		}
+	}
 
+	void ParticleSystem::Simulate()
+	{
 		for (auto& emitter : m_emitters)
 		{
-			emitter->Update(dt, worldMatrix, worldPos, systemVelocity, camera);
+			emitter->Simulate(m_updateDelta, m_updateWorld, m_updateWorldPos, m_updateVelocity,
+				m_updateCamera ? &m_updateCameraPos : nullptr);
 		}
 
 		UpdateBoundingBox();
 	}
 
+	void ParticleSystem::FinishUpdate()
+	{
+		// Only (re)build GPU buffers when a camera is available.
+		if (!m_updateCamera)
+		{
+			return;
+		}
+
+		for (auto& emitter : m_emitters)
+		{
+			emitter->UpdateRenderData(*m_updateCamera);
+		}
+	}
+
 	void ParticleSystem::Update()
 	{
 		const auto currentTime = std::chrono::high_resolution_clock::now();
@@ -1342,9 +1720,9 @@ namespace mmo
 		}
 		else
 		{
-			const Vector3 pos = GetDerivedPosition();
-			m_boundingBox.min = pos;
-			m_boundingBox.max = pos;
+			// Uses the position captured by PrepareUpdate, as this runs as part of the simulation
+			m_boundingBox.min = m_updateWorldPos;
+			m_boundingBox.max = m_updateWorldPos;
 		}
 	}
 
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "base/typedefs.h"
+#include "base/random.h"
 #include "math/vector3.h"
 #include "math/vector4.h"
 #include "math/matrix4.h"
@@ -28,6 +29,7 @@
 #include "graphics/vertex_index_data.h"
 #include "movable_object.h"
 
+#include <array>
 #include <chrono>
 #include <cstddef>
 #include <vector>
@@ -45,7 +47,7 @@ namespace mmo
 
 	/**
 	 * @struct Particle
-	 * @brief Represents a single particle in the system. Two cache lines (80 bytes).
+	 * @brief A single particle as it is spawned into or read back from a @ref ParticleStore.
 	 */
 	struct Particle
 	{
@@ -72,6 +74,84 @@ namespace mmo
 
 	static_assert(sizeof(Particle) == 80, "Particle struct expected to be 80 bytes");
 
+	/**
+	 * @struct ParticleStore
+	 * @brief The live particles of an emitter in structure-of-arrays layout.
+	 *
+	 * Every attribute is stored in its own contiguous array, so each simulation pass only touches the
+	 * attributes it needs and its loop can be vectorized by the compiler. All arrays always have the
+	 * same length.
+	 */
+	struct ParticleStore
+	{
+		std::vector<float> positionX;
+		std::vector<float> positionY;
+		std::vector<float> positionZ;
+		std::vector<float> velocityX;
+		std::vector<float> velocityY;
+		std::vector<float> velocityZ;
+		std::vector<float> colorR;
+		std::vector<float> colorG;
+		std::vector<float> colorB;
+		std::vector<float> colorA;
+		std::vector<float> size;
+		std::vector<float> rotation;
+		std::vector<float> age;
+		std::vector<float> lifetime;
+		std::vector<float> angularVelocity;
+		std::vector<float> baseSize;
+		std::vector<float> randomPhase;
+		std::vector<uint32> spriteIndex;
+
+		[[nodiscard]] size_t GetCount() const { return age.size(); }
+		[[nodiscard]] bool IsEmpty() const { return age.empty(); }
+
+		void Reserve(size_t capacity);
+		void Clear();
+
+		/// @brief Removes all particles at and after the given index.
+		void Truncate(size_t count);
+
+		/// @brief Appends a particle.
+		void Push(const Particle& particle);
+
+		/// @brief Assembles the particle at the given index.
+		[[nodiscard]] Particle Get(size_t index) const;
+
+		/// @brief Removes all particles whose age reached their lifetime, keeping the order of the others.
+		void RemoveExpired();
+
+		/// @brief Reorders the particles, so that particle i is the particle which was at order[i] before.
+		/// @param order Permutation of all particle indices.
+		/// @param floatScratch Scratch buffer, reused between calls to avoid allocations.
+		/// @param indexScratch Scratch buffer, reused between calls to avoid allocations.
+		void Permute(const std::vector<uint32>& order, std::vector<float>& floatScratch, std::vector<uint32>& indexScratch);
+
+	private:
+		void Move(size_t from, size_t to);
+	};
+
+	/**
+	 * @struct ParticleCurveTable
+	 * @brief The size and colour curves of an emitter, sampled at regular intervals of the normalized lifetime.
+	 *
+	 * Evaluating a curve per particle is a key search plus a Hermite interpolation. The simulation instead
+	 * interpolates linearly between two table entries, which is branch free and visually identical.
+	 */
+	struct ParticleCurveTable
+	{
+		static constexpr uint32 SampleCount = 64;
+
+		std::array<float, SampleCount + 1> size {};
+		std::array<float, SampleCount + 1> colorR {};
+		std::array<float, SampleCount + 1> colorG {};
+		std::array<float, SampleCount + 1> colorB {};
+		std::array<float, SampleCount + 1> colorA {};
+
+		/// @brief Samples the given curves.
+		void Bake(const FloatCurve& sizeCurve, const ColorCurve& colorCurve);
+	};
+
 	/// @brief Shape from which particles are spawned.
 	enum class EmitterShape : uint8
 	{
@@ -225,10 +305,7 @@ namespace mmo
 
 	public:
 		/// @brief Rebuilds the GPU buffers from current particle data for the given camera.
-		void RebuildBuffers(const std::vector<Particle>& particles, const Camera& camera);
-
-		/// @brief Sorts particles back-to-front relative to the camera (for alpha blending).
-		void SortParticles(std::vector<Particle>& particles, const Camera& camera) const;
+		void RebuildBuffers(const ParticleStore& particles, const Camera& camera);
 
 		[[nodiscard]] bool IsReady() const { return m_vertexData != nullptr && m_vertexData->vertexCount > 0; }
 
@@ -303,19 +380,26 @@ namespace mmo
 	public:
 		void SetParameters(const EmitterParameters& params);
 		[[nodiscard]] const EmitterParameters& GetParameters() const { return m_parameters; }
+
+		/// @brief Changes to the curves only take effect after the next call to SetParameters.
 		[[nodiscard]] EmitterParameters& GetParametersMutable() { return m_parameters; }
 
 		void SetMaterial(const MaterialPtr& material) { m_material = material; }
 		[[nodiscard]] MaterialPtr GetMaterial() const { return m_material; }
 
-		/// @brief Advances the simulation.
+		/// @brief Advances the simulation and sorts translucent particles back-to-front. Touches neither the
+		/// scene graph nor the graphics device, so different emitters may be simulated on different threads.
 		/// @param deltaTime Frame time in seconds.
 		/// @param systemWorld World transform of the owning system's node.
 		/// @param systemWorldPos World position of the owning system.
 		/// @param systemVelocity World-space velocity of the owning system (for inheritance).
-		/// @param camera Camera used for sorting and billboard orientation (may be null).
-		void Update(float deltaTime, const Matrix4& systemWorld, const Vector3& systemWorldPos,
-			const Vector3& systemVelocity, const Camera* camera);
+		/// @param cameraPosition World position of the camera used for sorting (may be null).
+		void Simulate(float deltaTime, const Matrix4& systemWorld, const Vector3& systemWorldPos,
+			const Vector3& systemVelocity, const Vector3* cameraPosition);
+
+		/// @brief Uploads the simulated particles to the GPU buffers.
+		/// @param camera Camera used for billboard orientation.
+		void UpdateRenderData(const Camera& camera);
 
 		void Reset();
 		void Play() { m_emitting = true; }
@@ -325,8 +409,8 @@ namespace mmo
 		/// @brief True when a non-looping emitter has finished and all its particles are dead.
 		[[nodiscard]] bool IsFinished() const;
 
-		[[nodiscard]] const std::vector<Particle>& GetParticles() const { return m_particles; }
-		[[nodiscard]] size_t GetParticleCount() const { return m_particles.size(); }
+		[[nodiscard]] const ParticleStore& GetParticles() const { return m_particles; }
+		[[nodiscard]] size_t GetParticleCount() const { return m_particles.GetCount(); }
 
 		[[nodiscard]] const Matrix4& GetWorldTransform() const { return m_renderTransform; }
 		[[nodiscard]] Vector3 GetEmitterWorldPosition() const { return m_emitterWorldPos; }
@@ -350,23 +434,45 @@ namespace mmo
 		void SpawnOne(const Matrix4& systemWorld, const Vector3& systemWorldPos, const Vector3& systemVelocity);
 		void UpdateParticles(float deltaTime);
 		void UpdateBoundingBox();
-		[[nodiscard]] Vector3 GetSpawnPosition(Vector3& outDirection) const;
+		[[nodiscard]] Vector3 GetSpawnPosition(Vector3& outDirection);
 		void SimulateWarmup(const Matrix4& systemWorld, const Vector3& systemWorldPos, const Vector3& systemVelocity);
 
+		/// @brief Whether the particles are blended and therefore have to be drawn back-to-front.
+		[[nodiscard]] bool NeedsSorting() const;
+
+		/// @brief Sorts the particles back-to-front relative to the camera. After a meaningful camera movement the
+		/// particles are sorted from scratch. Otherwise the order of the last frame is nearly correct, since only
+		/// new particles and the movement of the particles themselves change it, and an insertion sort restores
+		/// it in close to linear time.
+		void SortParticles(const Vector3& cameraPosition);
+
 		/// @brief (Re)loads the source mesh and clones its submesh geometry for instanced rendering.
 		void RebuildMeshResources();
 
 		/// @brief Rebuilds the per-particle GPU instance buffer (transform + tint) from live particles.
-		void RebuildInstanceBuffer(const Camera& camera);
+		void RebuildInstanceBuffer();
 
 	private:
 		GraphicsDevice& m_device;
 		ParticleSystem& m_system;
 		EmitterParameters m_parameters;
-		std::vector<Particle> m_particles;
+		ParticleCurveTable m_curves;
+		ParticleStore m_particles;
 		std::unique_ptr<ParticleRenderable> m_renderable;
 		MaterialPtr m_material;
 
+		/// Each emitter has its own generator, so that emitters can be simulated in parallel.
+		RandomnessGenerator m_random;
+
+		// --- Sorting state, reused between frames ---
+		std::vector<float> m_sortKeys;
+		std::vector<uint32> m_sortOrder;
+		std::vector<float> m_sortScratch;
+		std::vector<uint32> m_sortIndexScratch;
+		/// Camera position of the last full sort, relative to the emitter's render transform.
+		Vector3 m_lastSortCameraPos { Vector3::Zero };
+		bool m_hasSorted { false };
+
 		float m_spawnAccumulator { 0.0f };
 		float m_age { 0.0f };          ///< Total time since (re)start (drives one-shot completion)
 		float m_cycleTime { 0.0f };    ///< Time within the current cycle (drives bursts / looping)
@@ -413,12 +519,24 @@ namespace mmo
 		void VisitRenderables(Renderable::Visitor& visitor, bool debugRenderables) override;
 
 	public:
-		/// @brief Advances all emitters. Called once per frame by the scene.
+		/// @brief Advances all emitters. Equivalent to calling PrepareUpdate, Simulate and FinishUpdate.
 		void Update(float deltaTime);
 
 		/// @brief Self-timed overload kept for callers that don't have a frame delta.
 		void Update();
 
+		/// @brief First step of an update: captures the transforms of the parent node and the camera. Has to be
+		/// called on the thread which owns the scene graph.
+		void PrepareUpdate(float deltaTime);
+
+		/// @brief Second step of an update: advances the simulation of all emitters. Only touches the state of
+		/// this system, so the systems of a scene may be simulated in parallel.
+		void Simulate();
+
+		/// @brief Last step of an update: uploads the particles to the graphics device. Has to be called on the
+		/// rendering thread.
+		void FinishUpdate();
+
 		// --- Multi-emitter API ---
 		void SetSystemParameters(const ParticleSystemParameters& params);
 		[[nodiscard]] ParticleSystemParameters GetSystemParameters() const;
@@ -468,6 +586,14 @@ namespace mmo
 		Vector3 m_lastWorldPos { Vector3::Zero };
 		bool m_hasLastWorldPos { false };
 
+		// --- State captured by PrepareUpdate for the following steps ---
+		float m_updateDelta { 0.0f };
+		Matrix4 m_updateWorld { Matrix4::Identity };
+		Vector3 m_updateWorldPos { Vector3::Zero };
+		Vector3 m_updateVelocity { Vector3::Zero };
+		const Camera* m_updateCamera { nullptr };
+		Vector3 m_updateCameraPos { Vector3::Zero };
+
 		static const String TYPE_NAME;
 	};
 
@@ -5,12 +5,22 @@
 #include "movable_object.h"
 #include "camera.h"
 #include <algorithm>
+#include <limits>
 
 namespace mmo
 {
 	void QueuedRenderableCollection::AddRenderable(Renderable& rend)
 	{
-		m_renderables.push_back(&rend);
+		// Renderables without a material are sorted to the end
+		const auto material = rend.GetMaterial();
+		const uintptr_t materialKey = material ? reinterpret_cast<uintptr_t>(material.get()) : std::numeric_limits<uintptr_t>::max();
+
+		m_renderables.push_back({ materialKey, &rend });
+	}
+
+	void QueuedRenderableCollection::Append(const QueuedRenderableCollection& other)
+	{
+		m_renderables.insert(m_renderables.end(), other.m_renderables.begin(), other.m_renderables.end());
 	}
 
 	void QueuedRenderableCollection::Clear()
@@ -20,9 +30,9 @@ namespace mmo
 
 	void QueuedRenderableCollection::AcceptVisitor(QueuedRenderableVisitor& visitor) const
 	{
-		for(auto& renderable : m_renderables)
+		for(const auto& queued : m_renderables)
 		{
-			visitor.Visit(*renderable, m_groupId);
+			visitor.Visit(*queued.renderable, m_groupId);
 		}
 	}
 
@@ -34,22 +44,12 @@ namespace mmo
 			return;
 		}
 
-		// Sort by material pointer for fast comparison and minimal overhead
-		// Using stable_sort to preserve original order for renderables with same material
+		// Sort by the material key computed when the renderable was queued, so no material needs to be
+		// looked up while sorting. Using stable_sort to preserve original order for renderables with same material
 		std::stable_sort(m_renderables.begin(), m_renderables.end(),
-			[](const Renderable* a, const Renderable* b) -> bool
+			[](const QueuedRenderable& a, const QueuedRenderable& b) -> bool
 			{
-				// Compare material pointers directly for fastest possible comparison
-				const auto materialA = a->GetMaterial();
-				const auto materialB = b->GetMaterial();
-				
-				// Handle null materials (put them at the end)
-				if (!materialA && !materialB) return false;
-				if (!materialA) return false;
-				if (!materialB) return true;
-				
-				// Compare by raw pointer value for fastest sorting
-				return materialA.get() < materialB.get();
+				return a.materialKey < b.materialKey;
 			});
 	}
 
@@ -60,6 +60,11 @@ namespace mmo
 		AddSolidRenderable(renderable);
 	}
 
+	void RenderPriorityGroup::Append(const RenderPriorityGroup& other)
+	{
+		m_solidCollection.Append(other.m_solidCollection);
+	}
+
 	void RenderPriorityGroup::Clear()
 	{
 		m_solidCollection.Clear();
@@ -121,15 +126,29 @@ namespace mmo
 		}
 	}
 
-	void RenderQueueGroup::AddRenderable(Renderable& renderable, uint16 priority)
+	void RenderQueueGroup::AddRenderable(Renderable& renderable, const uint16 priority)
+	{
+		GetPriorityGroup(priority).AddRenderable(renderable);
+	}
+
+	void RenderQueueGroup::Merge(const RenderQueueGroup& other)
 	{
-		auto it = m_priorityGroups.find(priority);
-		if (it == m_priorityGroups.end())
+		for (const auto& [priority, group] : other.m_priorityGroups)
 		{
-			it = m_priorityGroups.insert(std::make_pair(priority, std::make_unique<RenderPriorityGroup>(m_groupId))).first;
+			GetPriorityGroup(priority).Append(*group);
+		}
+	}
+
+	RenderPriorityGroup& RenderQueueGroup::GetPriorityGroup(const uint16 priority)
+	{
+		const auto it = std::lower_bound(m_priorityGroups.begin(), m_priorityGroups.end(), priority,
+			[](const PriorityGroupEntry& entry, const uint16 value) { return entry.priority < value; });
+		if (it != m_priorityGroups.end() && it->priority == priority)
+		{
+			return *it->group;
 		}
 
-		it->second->AddRenderable(renderable);
+		return *m_priorityGroups.insert(it, { priority, std::make_unique<RenderPriorityGroup>(m_groupId) })->group;
 	}
 
 	void RenderQueueGroup::SortByMaterial(size_t minRenderablesForSorting)
@@ -144,7 +163,7 @@ namespace mmo
 		: m_defaultGroup(Main)
 		, m_defaultRenderablePriority(100)
 	{
-		m_groups[Main] = std::make_unique<RenderQueueGroup>(*this, Main);
+		(void)GetQueueGroup(Main);
 	}
 
 	RenderQueue::~RenderQueue()
@@ -154,9 +173,9 @@ namespace mmo
 
 	void RenderQueue::Clear()
 	{
-		for (const auto& group : m_groups)
+		for (const auto& [groupId, group] : m_groups)
 		{
-			group.second->Clear();
+			group->Clear();
 		}
 	}
 
@@ -186,20 +205,26 @@ namespace mmo
 
 	RenderQueueGroup* RenderQueue::GetQueueGroup(const uint8 groupId)
 	{
-		const auto groupIt = m_groups.find(groupId);
-		if (groupIt == m_groups.end())
+		if (RenderQueueGroup* group = m_groupLookup[groupId])
 		{
-			m_groups[groupId] = std::make_unique<RenderQueueGroup>(*this, groupId);
-			return m_groups[groupId].get();
+			return group;
 		}
 
-		return groupIt->second.get();
+		// Keep the groups sorted by id so that they are rendered in order
+		const auto it = std::lower_bound(m_groups.begin(), m_groups.end(), groupId,
+			[](const QueueGroupEntry& entry, const uint8 value) { return entry.groupId < value; });
+		RenderQueueGroup* group = m_groups.insert(it, { groupId, std::make_unique<RenderQueueGroup>(*this, groupId) })->group.get();
 
+		m_groupLookup[groupId] = group;
+		return group;
 	}
 
 	void RenderQueue::Combine(const RenderQueue& other)
 	{
-		// TODO
+		for (const auto& [groupId, group] : other.m_groups)
+		{
+			GetQueueGroup(groupId)->Merge(*group);
+		}
 	}
 
 	void RenderQueue::ProcessVisibleObject(MovableObject& movableObject, Camera& camera, VisibleObjectsBoundsInfo& visibleBounds, bool onlyShadowCasters)
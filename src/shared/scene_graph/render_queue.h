@@ -2,8 +2,9 @@
 
 #pragma once
 
-#include <map>
+#include <array>
 #include <memory>
+#include <vector>
 
 #include "math/aabb.h"
 #include "renderable.h"
@@ -73,6 +74,9 @@ namespace mmo
 		
 		void AddRenderable(Renderable& rend);
 
+		/// @brief Appends all renderables of another collection, keeping their order and sort keys.
+		void Append(const QueuedRenderableCollection& other);
+
 		void Clear();
 
 		/// @brief Sorts renderables by material to reduce state changes during rendering.
@@ -88,8 +92,16 @@ namespace mmo
 		[[nodiscard]] size_t GetRenderableCount() const { return m_renderables.size(); }
 
 	protected:
+		/// A queued renderable together with its material sort key, which is computed once when the renderable
+		/// is queued instead of on every comparison while sorting.
+		struct QueuedRenderable
+		{
+			uintptr_t materialKey;
+			Renderable* renderable;
+		};
+
 		uint32 m_groupId;
-		std::vector<Renderable*> m_renderables;
+		std::vector<QueuedRenderable> m_renderables;
 	};
 
 	class RenderPriorityGroup
@@ -104,6 +116,9 @@ namespace mmo
 	public:
 		void AddRenderable(Renderable& renderable);
 
+		/// @brief Appends all renderables of another priority group.
+		void Append(const RenderPriorityGroup& other);
+
 		void Clear();
 
 		/// @brief Sorts solid renderables by material to reduce GPU state changes.
@@ -146,7 +161,15 @@ namespace mmo
 	class RenderQueueGroup
 	{
     public:
-        typedef std::map<uint16, std::unique_ptr<RenderPriorityGroup>, std::less<> > PriorityMap;
+		/// Priority groups are kept in a flat array sorted by priority. Queues only ever use a handful of
+		/// priorities, so a linear scan beats a tree lookup and iteration touches contiguous memory.
+		struct PriorityGroupEntry
+		{
+			uint16 priority;
+			std::unique_ptr<RenderPriorityGroup> group;
+		};
+
+        typedef std::vector<PriorityGroupEntry> PriorityGroups;
 
 	public:
 		explicit RenderQueueGroup(RenderQueue& queue, uint32 groupId);
@@ -156,6 +179,9 @@ namespace mmo
 
 		void AddRenderable(Renderable& renderable, uint16 priority);
 
+		/// @brief Appends all renderables of another queue group, keeping their priorities.
+		void Merge(const RenderQueueGroup& other);
+
 		/// @brief Sorts all renderables in all priority groups by material to reduce GPU state changes.
 		/// Only sorts collections that have more than minRenderablesForSorting items.
 		/// @param minRenderablesForSorting The minimum number of renderables before sorting is applied (default: 8)
@@ -163,13 +189,18 @@ namespace mmo
 
 		uint32 GetGroupId() const { return m_groupId; }
 
-		PriorityMap::iterator begin() { return m_priorityGroups.begin(); }
-		PriorityMap::iterator end() { return m_priorityGroups.end(); }
+		PriorityGroups::iterator begin() { return m_priorityGroups.begin(); }
+		PriorityGroups::iterator end() { return m_priorityGroups.end(); }
+		PriorityGroups::const_iterator begin() const { return m_priorityGroups.begin(); }
+		PriorityGroups::const_iterator end() const { return m_priorityGroups.end(); }
+
+	private:
+		RenderPriorityGroup& GetPriorityGroup(uint16 priority);
 
 	private:
 		uint32 m_groupId;
 		RenderQueue& m_queue;
-		PriorityMap m_priorityGroups;
+		PriorityGroups m_priorityGroups;
 	};
 
 	class RenderQueue
@@ -178,10 +209,21 @@ namespace mmo
 		signal<bool(Renderable& renderable, uint8 groupID, uint16 priority, RenderQueue& queue)> renderableQueued;
 
 	public:
-        typedef std::map<uint8, std::unique_ptr<RenderQueueGroup>> RenderQueueGroupMap;
+		/// Queue groups are kept in a flat array sorted by group id, so that rendering iterates them in order.
+		struct QueueGroupEntry
+		{
+			uint8 groupId;
+			std::unique_ptr<RenderQueueGroup> group;
+		};
+
+        typedef std::vector<QueueGroupEntry> RenderQueueGroups;
 
 	protected:
-		RenderQueueGroupMap m_groups;
+		RenderQueueGroups m_groups;
+
+		/// Direct lookup of the queue groups by id.
+		std::array<RenderQueueGroup*, 256> m_groupLookup {};
+
 		uint8 m_defaultGroup;
 		uint16 m_defaultRenderablePriority;
 		
@@ -213,12 +255,17 @@ namespace mmo
 
 		void SetDefaultQueueGroup(const uint8 group) { m_defaultGroup = group; }
 
+		/// @brief Appends all renderables queued in another render queue, keeping their groups and priorities.
+		///	Used to merge queues which have been populated independently, e.g. on different threads. The
+		///	renderableQueued signal is not raised again for the merged renderables.
 		void Combine(const RenderQueue& other);
 
 		void ProcessVisibleObject(MovableObject& movableObject, Camera& camera, VisibleObjectsBoundsInfo& visibleBounds, bool onlyShadowCasters);
 
 
-		RenderQueueGroupMap::iterator begin() { return m_groups.begin(); }
-		RenderQueueGroupMap::iterator end() { return m_groups.end(); }
+		RenderQueueGroups::iterator begin() { return m_groups.begin(); }
+		RenderQueueGroups::iterator end() { return m_groups.end(); }
+		RenderQueueGroups::const_iterator begin() const { return m_groups.begin(); }
+		RenderQueueGroups::const_iterator end() const { return m_groups.end(); }
 	};
 }
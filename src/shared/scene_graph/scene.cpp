@@ -13,6 +13,7 @@
 #include "world_model_instance.h"
 
 #include "light.h"
+#include "base/job_system.h"
 #include "base/macros.h"
 #include "base/profiler.h"
 #include "graphics/graphics_device.h"
@@ -21,6 +22,28 @@
 
 namespace mmo
 {
+	namespace
+	{
+		/// Bounds tests of a shadow caster against a cascade. Only reads the caster bounds, so that different
+		///	cascades can be tested concurrently.
+		bool IsCasterInCascade(const AABB& worldBounds, const Camera& cascadeCamera, const float minCasterWorldRadius)
+		{
+			// Sub-texel small-object culling: a caster smaller than the cascade's world texel size
+			// produces a shadow under one shadow-map texel, i.e. invisible. Skipping it is free.
+			if (minCasterWorldRadius > 0.0f)
+			{
+				const Vector3 extents = worldBounds.GetExtents();
+				const float worldRadius = std::max(extents.x, std::max(extents.y, extents.z));
+				if (worldRadius < minCasterWorldRadius)
+				{
+					return false;
+				}
+			}
+
+			return cascadeCamera.IsVisible(worldBounds);
+		}
+	}
+
 	void SceneQueuedRenderableVisitor::Visit(RenderablePass& rp)
 	{
 	}
@@ -73,6 +96,7 @@ namespace mmo
 		m_lights.clear();
 		m_particleEmitters.clear();
 		m_worldModelInstances.clear();
+		m_queuedAnimations.clear();
 
 		m_sceneNodes.clear();
 		m_rootNode = nullptr;
@@ -196,6 +220,125 @@ namespace mmo
 		return emitters;
 	}
 
+	void Scene::UpdateParticleEmitters(const float deltaTime)
+	{
+		PROFILE_SCOPE("ParticleEmitters::Update");
+
+		m_updatedParticleEmitters.clear();
+		for (auto& [name, emitter] : m_particleEmitters)
+		{
+			// Systems flagged for manual update (e.g. the particle editor) advance themselves.
+			if (emitter->IsAutoUpdate())
+			{
+				emitter->PrepareUpdate(deltaTime);
+				m_updatedParticleEmitters.push_back(emitter.get());
+			}
+		}
+
+		// The simulation of a particle system only touches its own state, so the systems are simulated in parallel
+		const auto simulate = [this](const size_t index)
+		{
+			m_updatedParticleEmitters[index]->Simulate();
+		};
+
+		if (m_jobSystem && m_updatedParticleEmitters.size() > 1)
+		{
+			m_jobSystem->ParallelFor(m_updatedParticleEmitters.size(), simulate);
+		}
+		else
+		{
+			for (size_t i = 0; i < m_updatedParticleEmitters.size(); ++i)
+			{
+				simulate(i);
+			}
+		}
+
+		// Buffer uploads go through the graphics device and stay on this thread
+		for (ParticleEmitter* emitter : m_updatedParticleEmitters)
+		{
+			emitter->FinishUpdate();
+		}
+	}
+
+	void Scene::BeginAnimationFrame(const Vector3& viewerPosition)
+	{
+		++m_animationFrame;
+		m_animationViewerPosition = viewerPosition;
+	}
+
+	void Scene::QueueAnimationUpdate(Entity& entity)
+	{
+		if (entity.m_lastSceneAnimationFrame != 0)
+		{
+			// Entities which are only visible in a shadow map are off screen and use the lowest update rate
+			uint32 interval = m_maxAnimationUpdateInterval;
+			if (!m_shadowPass)
+			{
+				interval = 1;
+
+				const Node* node = entity.GetParentNode();
+				if (node && m_fullRateAnimationDistance > 0.0f)
+				{
+					const float distance = (node->GetDerivedPosition() - m_animationViewerPosition).GetLength();
+					interval = std::clamp(static_cast<uint32>(distance / m_fullRateAnimationDistance), 1u, m_maxAnimationUpdateInterval);
+				}
+			}
+
+			if (m_animationFrame < entity.m_lastSceneAnimationFrame + interval)
+			{
+				return;
+			}
+		}
+
+		if (entity.PrepareAnimationUpdate())
+		{
+			entity.m_lastSceneAnimationFrame = m_animationFrame;
+			m_queuedAnimations.push_back(&entity);
+		}
+	}
+
+	void Scene::UpdateQueuedAnimations()
+	{
+		if (m_queuedAnimations.empty())
+		{
+			return;
+		}
+
+		PROFILE_SCOPE("Scene::UpdateAnimations");
+
+		// Evaluating an animation only touches the pose of the entity's own skeleton instance
+		const auto evaluate = [this](const size_t index)
+		{
+			m_queuedAnimations[index]->EvaluateAnimations();
+		};
+
+		if (m_jobSystem && m_queuedAnimations.size() > 1)
+		{
+			m_jobSystem->ParallelFor(m_queuedAnimations.size(), evaluate);
+		}
+		else
+		{
+			for (size_t i = 0; i < m_queuedAnimations.size(); ++i)
+			{
+				evaluate(i);
+			}
+		}
+
+		// Buffer uploads go through the graphics device and stay on this thread
+		for (Entity* entity : m_queuedAnimations)
+		{
+			entity->FinishAnimationUpdate();
+		}
+
+		m_queuedAnimations.clear();
+	}
+
+	void Scene::SetAnimationLod(const float fullRateDistance, const uint32 maxUpdateInterval)
+	{
+		m_fullRateAnimationDistance = fullRateDistance;
+		m_maxAnimationUpdateInterval = std::max(maxUpdateInterval, 1u);
+	}
+
 	RibbonTrail* Scene::CreateRibbonTrail(const String& name)
 	{
 		ASSERT(!name.empty());
@@ -297,6 +440,10 @@ namespace mmo
 		m_renderableVisitor.targetScene = this;
 		m_renderableVisitor.scissoring = false;
 
+		// A shadow cascade pass is a ShadowMap-typed pass that is not the main-view depth pre-pass.
+		const bool isShadowCascadePass = (shaderType == PixelShaderType::ShadowMap) && !m_depthPrepass;
+		m_shadowPass = isShadowCascadePass;
+
 		UpdateSceneGraph();
 
 		// In the deferred renderer, scene.Render is called twice per frame:
@@ -322,12 +469,10 @@ namespace mmo
 			// Update() advances the system and re-sorts/re-uploads its GPU buffers. It must run
 			// exactly once per frame — during the primary opaque queue-build pass — and never during
 			// the shadow cascade passes (which would otherwise re-simulate and re-sort every emitter
-			// up to NUM_SHADOW_CASCADES extra times each frame). A shadow cascade pass is a
-			// ShadowMap-typed pass that is not the main-view depth pre-pass.
-			const bool isShadowCascadePass = (shaderType == PixelShaderType::ShadowMap) && !m_depthPrepass;
+			// up to NUM_SHADOW_CASCADES extra times each frame).
 			if (!isShadowCascadePass)
 			{
-				PROFILE_SCOPE("ParticleEmitters::Update");
+				BeginAnimationFrame(camera.GetDerivedPosition());
 
 				// Compute a single shared deltaTime for all particle systems this frame.
 				const auto particleNow = std::chrono::high_resolution_clock::now();
@@ -340,14 +485,7 @@ namespace mmo
 				m_lastParticleUpdate = particleNow;
 				m_particleTimerInitialized = true;
 
-				for (auto& [name, emitter] : m_particleEmitters)
-				{
-					// Systems flagged for manual update (e.g. the particle editor) advance themselves.
-					if (emitter->IsAutoUpdate())
-					{
-						emitter->Update(particleDelta);
-					}
-				}
+				UpdateParticleEmitters(particleDelta);
 
 				for (auto& [name, trail] : m_ribbonTrails)
 				{
@@ -388,6 +526,8 @@ namespace mmo
 			{
 				trail->PopulateRenderQueue(GetRenderQueue());
 			}
+
+			UpdateQueuedAnimations();
 		}
 		
 		// Clear current render target
@@ -673,11 +813,26 @@ namespace mmo
 		}
 	}
 
+	void Scene::CullShadowCasters(const Camera& cascadeCamera, const std::vector<MovableObject*>& casters, const float minCasterWorldRadius, std::vector<MovableObject*>& outCasters)
+	{
+		outCasters.clear();
+
+		for (MovableObject* caster : casters)
+		{
+			// Bounds have already been derived while gathering, so this only reads the cached box
+			if (IsCasterInCascade(caster->GetWorldBoundingBox(false), cascadeCamera, minCasterWorldRadius))
+			{
+				outCasters.push_back(caster);
+			}
+		}
+	}
+
 	void Scene::RenderShadowCasters(Camera& cascadeCamera, const std::vector<MovableObject*>& casters, float minCasterWorldRadius)
 	{
 		PROFILE_SCOPE("Scene::RenderShadowCasters");
 
 		m_pixelShaderType = PixelShaderType::ShadowMap;
+		m_shadowPass = true;
 		m_activeCamera = &cascadeCamera;
 		m_renderableVisitor.targetScene = this;
 		m_renderableVisitor.scissoring = false;
@@ -698,21 +853,7 @@ namespace mmo
 				continue;
 			}
 
-			const AABB& worldBounds = caster->GetWorldBoundingBox(true);
-
-			// Sub-texel small-object culling: a caster smaller than the cascade's world texel size
-			// produces a shadow under one shadow-map texel, i.e. invisible. Skipping it is free.
-			if (minCasterWorldRadius > 0.0f)
-			{
-				const Vector3 extents = worldBounds.GetExtents();
-				const float worldRadius = std::max(extents.x, std::max(extents.y, extents.z));
-				if (worldRadius < minCasterWorldRadius)
-				{
-					continue;
-				}
-			}
-
-			if (!cascadeCamera.IsVisible(worldBounds))
+			if (!IsCasterInCascade(caster->GetWorldBoundingBox(true), cascadeCamera, minCasterWorldRadius))
 			{
 				continue;
 			}
@@ -720,6 +861,9 @@ namespace mmo
 			caster->PopulateRenderQueue(queue);
 		}
 
+		UpdateQueuedAnimations();
+		m_shadowPass = false;
+
 		// Shadow passes write depth with the cascade camera; match the state Scene::Render sets for a
 		// ShadowMap pass.
 		auto& gx = GraphicsDevice::Get();
@@ -906,6 +1050,7 @@ namespace mmo
 		ASSERT(m_entities.find(entityName) == m_entities.end());
 
 		auto [entityIt, created] = m_entities.emplace(entityName, std::make_unique<Entity>(entityName, mesh));
+		entityIt->second->SetScene(this);
 
 		return entityIt->second.get();
 	}
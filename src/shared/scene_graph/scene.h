@@ -33,6 +33,7 @@ namespace mmo
 	class Scene;
 	class Material;
 	class WorldModelInstance;
+	class JobSystem;
 
 	class SceneQueuedRenderableVisitor final : public QueuedRenderableVisitor
 	{
@@ -330,6 +331,27 @@ namespace mmo
 
 		std::vector<Entity*> GetAllEntities() const;
 
+		/// @brief Starts a new animation frame. Entities are animated at most once per animation frame, and entities
+		/// far away from the viewer less often. Called by Render once per frame for the main view.
+		/// @param viewerPosition World position which is used to determine the update rate of entity animations.
+		void BeginAnimationFrame(const Vector3& viewerPosition);
+
+		/// @brief Queues the animation update of a visible entity, unless its animations are up to date or it is
+		/// not due yet. Called by entities while the render queue is populated.
+		void QueueAnimationUpdate(Entity& entity);
+
+		/// @brief Evaluates the animations of all queued entities and uploads their bone matrices. The animations
+		/// are evaluated on the job system, if one is set. Called by Render after the render queue is complete.
+		void UpdateQueuedAnimations();
+
+		/// @brief Sets how the animation update rate of entities is reduced with their distance to the viewer.
+		/// @param fullRateDistance Entities closer than twice this distance are animated every frame, entities
+		///	farther away every n-th frame, where n is their distance divided by this distance. Zero animates all
+		///	entities every frame.
+		/// @param maxUpdateInterval Maximum number of frames between two animation updates of an entity. Entities
+		///	which are only visible in a shadow map use this interval as well.
+		void SetAnimationLod(float fullRateDistance, uint32 maxUpdateInterval);
+
 		/// @brief Registers a WorldModelInstance for pre-render portal culling updates.
 		/// @param instance The instance to register.
 		void RegisterWorldModelInstance(WorldModelInstance* instance);
@@ -388,6 +410,14 @@ namespace mmo
 		/// be reused by the following G-Buffer pass without dropping non-shadow-casting objects.
 		void SetDepthPrepass(bool value) { m_depthPrepass = value; }
 
+		/// @brief Sets the job system used to cull the scene, simulate particle emitters and evaluate animations on
+		///	multiple threads.
+		///	Without a job system, all of this happens on the calling thread. The job system has to outlive the scene.
+		void SetJobSystem(JobSystem* jobSystem) { m_jobSystem = jobSystem; }
+
+		/// @brief Gets the job system used by the scene, or nullptr if the scene is updated single threaded.
+		[[nodiscard]] JobSystem* GetJobSystem() const { return m_jobSystem; }
+
 		void UpdateSceneGraph();
 
 		void RenderSingleObject(Renderable& renderable, uint32 groupId);
@@ -411,6 +441,16 @@ namespace mmo
 		/// @param minCasterWorldRadius Skip casters whose world half-extent is smaller than this (0 = keep all).
 		void RenderShadowCasters(Camera& cascadeCamera, const std::vector<MovableObject*>& casters, float minCasterWorldRadius);
 
+		/// @brief Filters a gathered caster list by the bounds tests of RenderShadowCasters, without touching any
+		///        per-camera object state. Different cascades may be culled concurrently, as long as the caster
+		///        bounds have been derived by GatherShadowCasters and the scene graph is not modified meanwhile.
+		///        Passing the result to RenderShadowCasters renders the same casters as the unfiltered list.
+		/// @param cascadeCamera The orthographic shadow camera of the cascade.
+		/// @param casters The list produced by GatherShadowCasters.
+		/// @param minCasterWorldRadius Skip casters whose world half-extent is smaller than this (0 = keep all).
+		/// @param outCasters Receives the casters which may be rendered into the cascade (cleared first).
+		static void CullShadowCasters(const Camera& cascadeCamera, const std::vector<MovableObject*>& casters, float minCasterWorldRadius, std::vector<MovableObject*>& outCasters);
+
 		ManualRenderObject* CreateManualRenderObject(const String& name);
 
 		void DestroyManualRenderObject(const ManualRenderObject& object);
@@ -478,6 +518,11 @@ namespace mmo
 		/// @return A vector of all particle emitters in the scene.
 		std::vector<ParticleEmitter*> GetAllParticleEmitters() const;
 
+		/// @brief Advances all particle emitters which are updated automatically. Called once per frame by Render.
+		///	The simulation of the emitters runs on the job system, if one is set.
+		/// @param deltaTime Time since the last update in seconds.
+		void UpdateParticleEmitters(float deltaTime);
+
 		// Ribbon trail management
 
 		/// Creates a new ribbon trail using the specified name.
@@ -646,6 +691,21 @@ namespace mmo
 		std::chrono::high_resolution_clock::time_point m_lastParticleUpdate;
 		bool m_particleTimerInitialized { false };
 
+		/// Particle emitters updated by the current call to UpdateParticleEmitters, reused between frames.
+		std::vector<ParticleEmitter*> m_updatedParticleEmitters;
+
+		/// Entities whose animations are evaluated by the next call to UpdateQueuedAnimations.
+		std::vector<Entity*> m_queuedAnimations;
+
+		/// Starts at one, so that zero marks entities which were never animated.
+		uint64 m_animationFrame { 1 };
+		Vector3 m_animationViewerPosition;
+		float m_fullRateAnimationDistance { 50.0f };
+		uint32 m_maxAnimationUpdateInterval { 4 };
+
+		/// Set while the render queue of a shadow map is populated.
+		bool m_shadowPass { false };
+
 		typedef std::map<String, std::unique_ptr<RibbonTrail>> RibbonTrailMap;
 		RibbonTrailMap m_ribbonTrails;
 
@@ -685,6 +745,7 @@ namespace mmo
 		bool m_forwardTransparentOnly = false;
 		bool m_reuseRenderQueue = false;
 		bool m_depthPrepass = false;
+		JobSystem* m_jobSystem = nullptr;
 
 		Vector3 m_ambientColor = Vector3(0.04f, 0.035f, 0.03f);
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "skeleton.h"
+#include "skeleton_pose.h"
 
 namespace mmo
 {
@@ -34,6 +35,9 @@ namespace mmo
 
 		void FreeTagPoint(TagPoint& tagPoint);
 
+		/// Gets the flattened pose which evaluates the animations of this instance without updating the bone nodes.
+		[[nodiscard]] SkeletonPose& GetPose() { return m_pose; }
+
 	protected:
 		SkeletonPtr m_skeleton;
 
@@ -48,5 +52,7 @@ namespace mmo
 		std::vector<std::unique_ptr<TagPoint>> m_tagPoints;
 
 		uint16 m_nextTagPointHandle{ 0 };
+
+		SkeletonPose m_pose;
 	};
 }
@@ -0,0 +1,340 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "skeleton_pose.h"
+
+#include "animation.h"
+#include "animation_state.h"
+#include "bone.h"
+#include "skeleton.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace mmo
+{
+	namespace
+	{
+		bool IsSkeletonBone(const Skeleton& skeleton, const Node* node)
+		{
+			const auto* bone = dynamic_cast<const Bone*>(node);
+			return bone && bone->GetHandle() < skeleton.GetNumBones() && skeleton.GetBone(bone->GetHandle()) == bone;
+		}
+
+		/// Samples a track at the given time like NodeAnimationTrack::GetInterpolatedKeyFrame does with linear
+		///	interpolation. The cursor is the index of the first key frame at or after the time sampled last.
+		void SampleTrack(const AnimationKeyData& keys, const AnimationKeyData::Track& track, const float timePos, const float duration,
+			const bool sphericalRotation, uint32& cursor, Vector3& translate, Quaternion& rotation, Vector3& scale)
+		{
+			const float* times = keys.times.data() + track.firstKey;
+			const uint32 count = track.keyCount;
+
+			// Time usually advances by less than a key frame per update, so searching forward from the last key
+			// frame is cheaper than a binary search over the whole track
+			uint32 next = std::min(cursor, count);
+			if (next > 0 && times[next - 1] >= timePos)
+			{
+				// Time went backwards, most likely because the animation looped
+				next = static_cast<uint32>(std::lower_bound(times, times + next, timePos) - times);
+			}
+			else
+			{
+				while (next < count && times[next] < timePos)
+				{
+					++next;
+				}
+			}
+			cursor = next;
+
+			uint32 first, second;
+			float secondTime;
+			if (next == count)
+			{
+				// There is no key frame after this time, wrap back to the first one
+				first = count - 1;
+				second = 0;
+				secondTime = duration + times[0];
+			}
+			else
+			{
+				first = (next > 0 && timePos < times[next]) ? next - 1 : next;
+				second = next;
+				secondTime = times[next];
+			}
+
+			const float firstTime = times[first];
+			const float t = (firstTime == secondTime) ? 0.0f : (timePos - firstTime) / (secondTime - firstTime);
+
+			const uint32 k1 = track.firstKey + first;
+			if (t == 0.0f)
+			{
+				translate = keys.translations[k1];
+				rotation = keys.rotations[k1];
+				scale = keys.scales[k1];
+				return;
+			}
+
+			const uint32 k2 = track.firstKey + second;
+			rotation = sphericalRotation
+				? Quaternion::Slerp(t, keys.rotations[k1], keys.rotations[k2], track.useShortestRotationPath)
+				: Quaternion::NLerp(t, keys.rotations[k1], keys.rotations[k2], track.useShortestRotationPath);
+			translate = keys.translations[k1] + (keys.translations[k2] - keys.translations[k1]) * t;
+			scale = keys.scales[k1] + (keys.scales[k2] - keys.scales[k1]) * t;
+		}
+	}
+
+	bool SkeletonPose::Prepare(const Skeleton& skeleton, const AnimationStateSet& animationStates)
+	{
+		if (m_indexByHandle.size() != skeleton.GetNumBones())
+		{
+			Build(skeleton);
+		}
+
+		// Manually controlled bones are not reset to their initial state, which is only supported by the bone nodes
+		if (skeleton.HasManualBones())
+		{
+			m_layers.clear();
+			return false;
+		}
+
+		size_t layerCount = 0;
+		float totalWeights = 0.0f;
+
+		for (const AnimationState* state : animationStates.GetEnabledAnimationStates())
+		{
+			const LinkedSkeletonAnimationSource* linked = nullptr;
+			Animation* animation = skeleton.GetAnimationImpl(state->GetAnimationName(), &linked);
+
+			// Tolerate state entries for animations we're not aware of
+			if (!animation)
+			{
+				continue;
+			}
+
+			if (animation->GetInterpolationMode() != Animation::InterpolationMode::Linear)
+			{
+				m_layers.clear();
+				return false;
+			}
+
+			// Layers are matched to the enabled states of the last evaluation, so the track cursors survive
+			const auto matching = std::find_if(m_layers.begin() + layerCount, m_layers.end(), [state, animation](const Layer& layer)
+			{
+				return layer.state == state && layer.animation == animation;
+			});
+
+			if (matching != m_layers.end())
+			{
+				std::swap(*matching, m_layers[layerCount]);
+			}
+			else if (layerCount < m_layers.size())
+			{
+				m_layers[layerCount].cursors.clear();
+			}
+			else
+			{
+				m_layers.emplace_back();
+			}
+
+			Layer& layer = m_layers[layerCount++];
+			layer.state = state;
+			layer.animation = animation;
+			layer.keys = &animation->PrepareKeyData();
+			layer.blendMask = state->GetBlendMask();
+			layer.timePos = state->GetTimePosition();
+			layer.weight = state->GetWeight();
+			layer.scale = linked ? linked->scale : 1.0f;
+			layer.sphericalRotation = animation->GetRotationInterpolationMode() == Animation::RotationInterpolationMode::Spherical;
+			layer.cursors.resize(layer.keys->tracks.size(), 0);
+
+			totalWeights += layer.weight;
+		}
+
+		m_layers.resize(layerCount);
+
+		// Rebalance weights if they sum up to more than 1, but allow less to fade out all animations
+		if (skeleton.GetBlendMode() == SkeletonAnimationBlendMode::Average && totalWeights > 1.0f)
+		{
+			for (Layer& layer : m_layers)
+			{
+				layer.weight /= totalWeights;
+			}
+		}
+
+		return true;
+	}
+
+	void SkeletonPose::Evaluate(Matrix4* boneMatrices)
+	{
+		std::copy(m_initialPositions.begin(), m_initialPositions.end(), m_positions.begin());
+		std::copy(m_initialOrientations.begin(), m_initialOrientations.end(), m_orientations.begin());
+		std::copy(m_initialScales.begin(), m_initialScales.end(), m_scales.begin());
+
+		// Accumulate all layers in the local bone transforms, the same way NodeAnimationTrack::ApplyToNode does
+		for (Layer& layer : m_layers)
+		{
+			const AnimationKeyData& keys = *layer.keys;
+
+			float timePos = layer.timePos;
+			if (const float duration = layer.animation->GetDuration(); timePos > duration && duration > 0.0f)
+			{
+				timePos = std::fmod(timePos, duration);
+			}
+
+			for (size_t trackIndex = 0; trackIndex < keys.tracks.size(); ++trackIndex)
+			{
+				const AnimationKeyData::Track& track = keys.tracks[trackIndex];
+				if (track.handle >= m_indexByHandle.size() || m_indexByHandle[track.handle] < 0)
+				{
+					continue;
+				}
+
+				const float weight = layer.blendMask ? (*layer.blendMask)[track.handle] * layer.weight : layer.weight;
+				if (weight == 0.0f)
+				{
+					continue;
+				}
+
+				Vector3 translate, scale;
+				Quaternion rotation;
+				SampleTrack(keys, track, timePos, layer.animation->GetDuration(), layer.sphericalRotation, layer.cursors[trackIndex], translate, rotation, scale);
+
+				const int32 bone = m_indexByHandle[track.handle];
+				m_positions[bone] += translate * weight * layer.scale;
+
+				// Interpolate between no rotation and full rotation, so 0 = no rotation and 1 = full rotation. With full
+				// weight, this only flips the sign of the quaternion, which describes the same rotation.
+				Quaternion delta = rotation;
+				if (weight != 1.0f)
+				{
+					delta = layer.sphericalRotation
+						? Quaternion::Slerp(weight, Quaternion::Identity, rotation, track.useShortestRotationPath)
+						: Quaternion::NLerp(weight, Quaternion::Identity, rotation, track.useShortestRotationPath);
+				}
+				delta.Normalize();
+				m_orientations[bone] = m_orientations[bone] * delta;
+
+				if (scale != Vector3::UnitScale)
+				{
+					if (layer.scale != 1.0f)
+					{
+						scale = Vector3::UnitScale + (scale - Vector3::UnitScale) * layer.scale;
+					}
+					else if (weight != 1.0f)
+					{
+						scale = Vector3::UnitScale + (scale - Vector3::UnitScale) * weight;
+					}
+				}
+				m_scales[bone] = scale * m_scales[bone];
+			}
+		}
+
+		// Parents are stored before their children, so their derived transforms are always up to date here
+		for (size_t i = 0; i < m_handles.size(); ++i)
+		{
+			const int32 parent = m_parents[i];
+			if (parent < 0)
+			{
+				m_derivedPositions[i] = m_positions[i];
+				m_derivedOrientations[i] = m_orientations[i];
+				m_derivedScales[i] = m_scales[i];
+				continue;
+			}
+
+			const Quaternion& parentOrientation = m_derivedOrientations[parent];
+			const Vector3& parentScale = m_derivedScales[parent];
+			m_derivedOrientations[i] = m_inheritOrientation[i] ? parentOrientation * m_orientations[i] : m_orientations[i];
+			m_derivedScales[i] = m_inheritScale[i] ? parentScale * m_scales[i] : m_scales[i];
+			m_derivedPositions[i] = parentOrientation * (parentScale * m_positions[i]) + m_derivedPositions[parent];
+		}
+
+		// Same as Bone::GetOffsetTransform
+		for (size_t i = 0; i < m_handles.size(); ++i)
+		{
+			const Vector3 scale = m_derivedScales[i] * m_bindInverseScales[i];
+			const Quaternion rotation = m_derivedOrientations[i] * m_bindInverseOrientations[i];
+			const Vector3 translation = m_derivedPositions[i] + rotation * (scale * m_bindInversePositions[i]);
+			boneMatrices[m_handles[i]].MakeTransform(translation, scale, rotation);
+		}
+	}
+
+	void SkeletonPose::ApplyToBones() const
+	{
+		for (size_t i = 0; i < m_bones.size(); ++i)
+		{
+			m_bones[i]->SetPoseTransform(m_positions[i], m_orientations[i], m_scales[i],
+				m_derivedPositions[i], m_derivedOrientations[i], m_derivedScales[i]);
+		}
+	}
+
+	void SkeletonPose::Build(const Skeleton& skeleton)
+	{
+		const uint16 numBones = skeleton.GetNumBones();
+
+		// Sort the bones by their depth in the hierarchy, which puts every parent before its children
+		std::vector<uint32> depths(numBones, 0);
+		m_handles.clear();
+		for (uint16 handle = 0; handle < numBones; ++handle)
+		{
+			const Bone* bone = skeleton.GetBone(handle);
+			if (!bone)
+			{
+				continue;
+			}
+
+			for (const Node* parent = bone->GetParent(); IsSkeletonBone(skeleton, parent); parent = parent->GetParent())
+			{
+				++depths[handle];
+			}
+
+			m_handles.push_back(handle);
+		}
+
+		std::ranges::stable_sort(m_handles, [&depths](const uint16 a, const uint16 b) { return depths[a] < depths[b]; });
+
+		const size_t count = m_handles.size();
+		m_indexByHandle.assign(numBones, -1);
+		for (size_t i = 0; i < count; ++i)
+		{
+			m_indexByHandle[m_handles[i]] = static_cast<int32>(i);
+		}
+
+		m_bones.resize(count);
+		m_parents.resize(count);
+		m_inheritOrientation.resize(count);
+		m_inheritScale.resize(count);
+		m_initialPositions.resize(count);
+		m_initialOrientations.resize(count);
+		m_initialScales.resize(count);
+		m_bindInversePositions.resize(count);
+		m_bindInverseOrientations.resize(count);
+		m_bindInverseScales.resize(count);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			Bone* bone = skeleton.GetBone(m_handles[i]);
+			m_bones[i] = bone;
+
+			const Node* parent = bone->GetParent();
+			m_parents[i] = IsSkeletonBone(skeleton, parent) ? m_indexByHandle[static_cast<const Bone*>(parent)->GetHandle()] : -1;
+			m_inheritOrientation[i] = bone->IsInheritingOrientation();
+			m_inheritScale[i] = bone->IsInheritingScale();
+
+			m_initialPositions[i] = bone->GetInitialPosition();
+			m_initialOrientations[i] = bone->GetInitialOrientation();
+			m_initialScales[i] = bone->GetInitialScale();
+
+			m_bindInversePositions[i] = bone->GetBindingPoseInversePosition();
+			m_bindInverseOrientations[i] = bone->GetBindingPoseInverseOrientation();
+			m_bindInverseScales[i] = bone->GetBindingPoseInverseScale();
+		}
+
+		m_positions.resize(count);
+		m_orientations.resize(count);
+		m_scales.resize(count);
+		m_derivedPositions.resize(count);
+		m_derivedOrientations.resize(count);
+		m_derivedScales.resize(count);
+
+		m_layers.clear();
+	}
+}
@@ -0,0 +1,101 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/typedefs.h"
+#include "base/non_copyable.h"
+#include "math/matrix4.h"
+#include "math/quaternion.h"
+#include "math/vector3.h"
+
+#include <vector>
+
+namespace mmo
+{
+	class Animation;
+	class AnimationState;
+	class AnimationStateSet;
+	class Bone;
+	class Skeleton;
+	struct AnimationKeyData;
+
+	/// Evaluates the animation states of a skeleton instance on a flattened copy of its bones instead of the bone
+	///	nodes. Bones are stored in arrays ordered so that every parent comes before its children, which allows deriving
+	///	all bone transforms in a single pass, and every animation track remembers the key frame it sampled last, so
+	///	advancing the time usually doesn't need to search for key frames at all.
+	///
+	///	Evaluate only touches the pose itself and data prepared on the main thread, so the poses of different skeleton
+	///	instances can be evaluated in parallel.
+	class SkeletonPose final : public NonCopyable
+	{
+	public:
+		SkeletonPose() = default;
+
+	public:
+		/// Rebuilds the bone arrays if the bones of the skeleton changed and captures the enabled animation states.
+		///	Has to be called on the main thread before Evaluate.
+		///	@param skeleton The skeleton instance which is animated.
+		///	@param animationStates The animation states to evaluate.
+		///	@returns false if the animation states can only be evaluated on the bone nodes, which is the case for spline
+		///	         interpolated animations and manually controlled bones.
+		bool Prepare(const Skeleton& skeleton, const AnimationStateSet& animationStates);
+
+		/// Evaluates the animation states captured by the last call to Prepare and computes the skinning matrices.
+		///	@param boneMatrices Receives one matrix per bone, indexed by bone handle.
+		void Evaluate(Matrix4* boneMatrices);
+
+		/// Copies the evaluated pose to the bone nodes of the skeleton, so that bone queries and tag points see it.
+		void ApplyToBones() const;
+
+		/// Gets the number of bones of the pose.
+		[[nodiscard]] size_t GetNumBones() const { return m_handles.size(); }
+
+	private:
+		void Build(const Skeleton& skeleton);
+
+	private:
+		/// An enabled animation state, as captured by Prepare.
+		struct Layer
+		{
+			const AnimationState* state { nullptr };
+			const Animation* animation { nullptr };
+			const AnimationKeyData* keys { nullptr };
+			const std::vector<float>* blendMask { nullptr };
+			float timePos { 0.0f };
+			float weight { 0.0f };
+			float scale { 1.0f };
+			bool sphericalRotation { false };
+			/// Per track index of the first key frame at or after the time sampled last.
+			std::vector<uint32> cursors;
+		};
+
+		std::vector<Layer> m_layers;
+
+		/// Bone nodes of the skeleton instance, by pose index.
+		std::vector<Bone*> m_bones;
+		/// Bone handle by pose index.
+		std::vector<uint16> m_handles;
+		/// Pose index of the parent bone, or -1 for root bones.
+		std::vector<int32> m_parents;
+		/// Pose index by bone handle, or -1 for unused handles.
+		std::vector<int32> m_indexByHandle;
+		std::vector<uint8> m_inheritOrientation;
+		std::vector<uint8> m_inheritScale;
+
+		std::vector<Vector3> m_initialPositions;
+		std::vector<Quaternion> m_initialOrientations;
+		std::vector<Vector3> m_initialScales;
+
+		std::vector<Vector3> m_bindInversePositions;
+		std::vector<Quaternion> m_bindInverseOrientations;
+		std::vector<Vector3> m_bindInverseScales;
+
+		std::vector<Vector3> m_positions;
+		std::vector<Quaternion> m_orientations;
+		std::vector<Vector3> m_scales;
+
+		std::vector<Vector3> m_derivedPositions;
+		std::vector<Quaternion> m_derivedOrientations;
+		std::vector<Vector3> m_derivedScales;
+	};
+}
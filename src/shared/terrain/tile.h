@@ -10,7 +10,7 @@
 #include "coverage_map.h"
 #include "graphics/material_instance.h"
 #include "scene_graph/mesh.h"
-#include "lru_cache.h"
+#include "base/lru_cache.h"
 
 namespace mmo
 {
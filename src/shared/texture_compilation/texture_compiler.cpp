@@ -0,0 +1,447 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#include "texture_compiler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <set>
+
+#include "base/job_system.h"
+#include "binary_io/sink.h"
+#include "log/default_log_levels.h"
+
+#include "tex_v1_0/header.h"
+#include "tex_v1_0/header_save.h"
+
+#define STB_DXT_IMPLEMENTATION
+#include "stb_dxt.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image/stb_image.h"
+
+#define STB_IMAGE_RESIZE_IMPLEMENTATION
+#include "stb_image/stb_image_resize2.h"
+
+namespace mmo
+{
+	namespace
+	{
+		/// Number of block rows compressed by a single job. Small enough to spread the top mip of a single texture
+		///	over all threads, large enough to keep the overhead of a job negligible.
+		constexpr uint32 BlockRowsPerJob = 16;
+
+		/// A mip level which is written to the texture file.
+		struct MipLevel
+		{
+			uint32 index;
+			uint32 width;
+			uint32 height;
+			/// Uncompressed texels of this mip level, either the source data or the resized data.
+			const uint8* pixels;
+			size_t pixelSize;
+			std::vector<uint8> resized;
+			std::vector<uint8> compressed;
+		};
+
+		/// A range of block rows of a mip level which is compressed by a single job.
+		struct CompressionJob
+		{
+			MipLevel* level;
+			uint32 firstBlockRow;
+			uint32 blockRowCount;
+		};
+
+		uint32 GetChannelCount(const ImageFormat format)
+		{
+			switch (format)
+			{
+			case ImageFormat::R8:
+				return 1;
+			case ImageFormat::RG8:
+				return 2;
+			default:
+				return 4;
+			}
+		}
+
+		/// @brief Determines the output pixel format based on the image format and compression setting.
+		tex::v1_0::PixelFormat DetermineOutputFormat(const ImageFormat info, const bool compress)
+		{
+			if (!compress)
+			{
+				switch (info)
+				{
+				case ImageFormat::RGBX:
+				case ImageFormat::RGBA:
+					DLOG("Output format: RGBA");
+					return tex::v1_0::RGBA;
+				case ImageFormat::DXT1:
+					DLOG("Output format: DXT1");
+					return tex::v1_0::DXT1;
+				case ImageFormat::DXT5:
+					DLOG("Output format: DXT5");
+					return tex::v1_0::DXT5;
+				case ImageFormat::R8:
+					DLOG("Output format: R8");
+					return tex::v1_0::R8;
+				case ImageFormat::RG8:
+					DLOG("Output format: RG8");
+					return tex::v1_0::RG8;
+				}
+			}
+			else
+			{
+				switch (info)
+				{
+				case ImageFormat::RGBA:
+				case ImageFormat::DXT5:
+					DLOG("Output format: DXT5");
+					return tex::v1_0::DXT5;
+				case ImageFormat::RGBX:
+				case ImageFormat::DXT1:
+					DLOG("Output format: DXT1");
+					return tex::v1_0::DXT1;
+				case ImageFormat::R8:
+					DLOG("Output format: BC4");
+					return tex::v1_0::BC4;
+				case ImageFormat::RG8:
+					DLOG("Output format: BC5");
+					return tex::v1_0::BC5;
+				}
+			}
+
+			// Unknown / unsupported pixel format
+			return tex::v1_0::Unknown;
+		}
+
+		/// stb_dxt builds its lookup tables on first use without any synchronization, so this has to happen once
+		///	before blocks are compressed on multiple threads.
+		void InitializeBlockCompression()
+		{
+			static std::once_flag s_initialized;
+			std::call_once(s_initialized, []()
+			{
+				uint8 block[64] = {};
+				uint8 compressed[16];
+				stb_compress_dxt_block(compressed, block, 1, STB_DXT_NORMAL);
+			});
+		}
+
+		/// Compresses one channel of the given rows into BC4 blocks. There is no dedicated BC4 compressor, so the
+		///	channel is stored in the alpha channel of an rgba image, which is compressed as DXT5, and the alpha blocks
+		///	of the result are used.
+		void CompressChannel(uint8* dst, const size_t dstStride, const uint8* src, const uint32 srcChannels, const uint32 channel, const uint32 width, const uint32 rows)
+		{
+			const size_t pixelCount = static_cast<size_t>(width) * rows;
+			std::vector<uint8> expandedData(pixelCount * 4, 0);
+			for (size_t p = 0; p < pixelCount; ++p)
+			{
+				expandedData[p * 4 + 3] = src[p * srcChannels + channel];
+			}
+
+			const size_t totalBlocks = static_cast<size_t>((width + 3) / 4) * ((rows + 3) / 4);
+			std::vector<uint8> dxt5Buffer(totalBlocks * 16);
+			rygCompress(dxt5Buffer.data(), expandedData.data(), static_cast<int>(width), static_cast<int>(rows), true);
+
+			// Each DXT5 block is 16 bytes, the alpha block is the first 8 bytes
+			for (size_t b = 0; b < totalBlocks; ++b)
+			{
+				std::memcpy(dst + b * dstStride, &dxt5Buffer[b * 16], 8);
+			}
+		}
+
+		/// Compresses the block rows of a job. Blocks don't depend on each other, so compressing a mip level in
+		///	multiple jobs produces the same output as compressing it at once.
+		void CompressBlocks(const tex::v1_0::PixelFormat format, const CompressionJob& job)
+		{
+			MipLevel& level = *job.level;
+			const uint32 blocksX = (level.width + 3) / 4;
+			const uint32 firstRow = job.firstBlockRow * 4;
+			const uint32 rows = std::min(level.height - firstRow, job.blockRowCount * 4);
+			const size_t blockSize = (format == tex::v1_0::DXT1 || format == tex::v1_0::BC4) ? 8 : 16;
+			uint8* const dst = level.compressed.data() + static_cast<size_t>(job.firstBlockRow) * blocksX * blockSize;
+
+			switch (format)
+			{
+			case tex::v1_0::BC4:
+				CompressChannel(dst, 8, level.pixels + static_cast<size_t>(firstRow) * level.width, 1, 0, level.width, rows);
+				break;
+			case tex::v1_0::BC5:
+				// BC5: two independent BC4 blocks (one for R, one for G)
+				CompressChannel(dst, 16, level.pixels + static_cast<size_t>(firstRow) * level.width * 2, 2, 0, level.width, rows);
+				CompressChannel(dst + 8, 16, level.pixels + static_cast<size_t>(firstRow) * level.width * 2, 2, 1, level.width, rows);
+				break;
+			default:
+				// DXT1 or DXT5 compression for standard color textures
+				rygCompress(dst, const_cast<uint8*>(level.pixels) + static_cast<size_t>(firstRow) * level.width * 4,
+					static_cast<int>(level.width), static_cast<int>(rows), format == tex::v1_0::DXT5);
+				break;
+			}
+		}
+	}
+
+	bool IsSupportedTextureExtension(const String& extension)
+	{
+		// Use formats supported by stb_image implementation
+		static const std::set<String> supportedExtension = {
+			".png",
+			".jpg",
+			".psd",
+			".tga",
+			".bmp"
+		};
+
+		return supportedExtension.contains(extension);
+	}
+
+	bool ReadTextureData(const std::filesystem::path& filename, int32& width, int32& height, int32& numChannels, std::vector<uint8>& rawData)
+	{
+		int x,y,n;
+		uint8* data = stbi_load(filename.string().c_str(), &x, &y, &n, 4);
+		if (!data)
+		{
+			ELOG("Unable to read source image file, maybe file is damaged or format is not supported!");
+			return false;
+		}
+
+		width = x;
+		height = y;
+		numChannels = n;
+
+		rawData.assign(data, data + static_cast<size_t>(width) * height * 4);
+
+		stbi_image_free(data);
+		return true;
+	}
+
+	bool ConvertTextureData(const std::vector<uint8>& rawData, const int32 width, const int32 height, const int32 numChannels, const TextureUsage usage, TextureData& data)
+	{
+		if (width <= 0 || width > std::numeric_limits<uint16>::max())
+		{
+			ELOG("Unsupported width value (" << width << ") of source image data, has to be in range of 1.." << std::numeric_limits<uint16>::max());
+			return false;
+		}
+
+		if (height <= 0 || height > std::numeric_limits<uint16>::max())
+		{
+			ELOG("Unsupported height value (" << height << ") of source image data, has to be in range of 1.." << std::numeric_limits<uint16>::max());
+			return false;
+		}
+
+		data.width = static_cast<uint16>(width);
+		data.height = static_cast<uint16>(height);
+
+		switch (usage)
+		{
+		case TextureUsage::Grayscale:
+			{
+				// Extract only the red channel (or luminance) from the RGBA source
+				const size_t pixelCount = static_cast<size_t>(width) * height;
+				data.data.resize(pixelCount);
+				for (size_t i = 0; i < pixelCount; ++i)
+				{
+					data.data[i] = rawData[i * 4]; // R channel
+				}
+				data.format = ImageFormat::R8;
+				ILOG("Converted to single-channel grayscale");
+			}
+			break;
+
+		case TextureUsage::NormalMap:
+			{
+				// Extract only R and G channels (XY of the normal), Z can be reconstructed in shader
+				const size_t pixelCount = static_cast<size_t>(width) * height;
+				data.data.resize(pixelCount * 2);
+				for (size_t i = 0; i < pixelCount; ++i)
+				{
+					data.data[i * 2 + 0] = rawData[i * 4 + 0]; // R = X
+					data.data[i * 2 + 1] = rawData[i * 4 + 1]; // G = Y
+				}
+				data.format = ImageFormat::RG8;
+				ILOG("Converted to two-channel normal map (XY)");
+			}
+			break;
+
+		case TextureUsage::Color:
+		default:
+			{
+				if (numChannels == 3)
+				{
+					data.format = ImageFormat::RGBX;
+				}
+				else if (numChannels == 4)
+				{
+					data.format = ImageFormat::RGBA;
+				}
+				else if (numChannels == 1)
+				{
+					// Single-channel source but user wants color — expand to RGBA
+					data.format = ImageFormat::RGBX;
+				}
+				else
+				{
+					ELOG("Unsupported amount of channels in source image data (" << numChannels << ")!");
+					return false;
+				}
+				data.data = rawData;
+			}
+			break;
+		}
+
+		return true;
+	}
+
+	bool WriteTexture(io::ISink& sink, const TextureData& data, const bool compress, JobSystem* jobs)
+	{
+		using namespace mmo::tex;
+
+		const uint32 numChannels = GetChannelCount(data.format);
+		if (data.data.size() < static_cast<size_t>(data.width) * data.height * numChannels)
+		{
+			ELOG("Texture data is smaller than expected for an image of size " << data.width << "x" << data.height);
+			return false;
+		}
+
+		// Initialize the header
+		v1_0::Header header{ Version_1_0 };
+		header.width = data.width;
+		header.height = data.height;
+		ILOG("Image size: " << data.width << "x" << data.height);
+
+		// Check for correct image size since DXT requires a multiple of 4 as image size
+		bool applyCompression = compress;
+		if (applyCompression && ((data.width % 4) != 0 || (data.height % 4) != 0))
+		{
+			WLOG("DXT compression requires that both the width and height of the source image have to be a multiple of 4! Compression is disabled...");
+			applyCompression = false;
+		}
+
+		// Determine output format
+		header.format = DetermineOutputFormat(data.format, applyCompression);
+
+		// Check if support for mip mapping is enabled
+		bool widthIsPow2 = false, heightIsPow2 = false;
+		uint32 mipCount = 0;
+		for (uint32 i = 0; i < 16; ++i)
+		{
+			if (header.width == (1 << i))
+			{
+				widthIsPow2 = true;
+
+				if (mipCount == 0) mipCount = i + 1;
+			}
+			if (header.height == (1 << i))
+			{
+				heightIsPow2 = true;
+				if (mipCount == 0) mipCount = i + 1;
+			}
+		}
+
+		// Check the number of mip maps
+		header.hasMips = widthIsPow2 && heightIsPow2;
+		ILOG("Image supports mip maps: " << (header.hasMips ? "true" : "false"));
+		if (header.hasMips)
+		{
+			ILOG("Number of mip maps: " << mipCount);
+		}
+
+		// Collect the mip levels to write
+		std::vector<MipLevel> levels;
+		for (uint32 i = 0; (i < mipCount && i < 16) || i == 0; ++i)
+		{
+			const uint32 width = std::max(1u, static_cast<uint32>(header.width) >> i);
+			const uint32 height = std::max(1u, static_cast<uint32>(header.height) >> i);
+			if (i > 0 && width <= 16 && height <= 16)
+			{
+				break;
+			}
+
+			levels.push_back({ i, width, height, nullptr, static_cast<size_t>(width) * height * numChannels, {}, {} });
+		}
+
+		levels[0].pixels = data.data.data();
+
+		const auto forEach = [jobs](const size_t count, const std::function<void(size_t)>& job)
+		{
+			if (jobs)
+			{
+				jobs->ParallelFor(count, job);
+				return;
+			}
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				job(i);
+			}
+		};
+
+		// Every mip level is resized from the full resolution image, so they can be generated independently
+		const stbir_pixel_layout pixelLayout = numChannels == 1 ? STBIR_1CHANNEL : (numChannels == 2 ? STBIR_2CHANNEL : STBIR_RGBA);
+		forEach(levels.size() - 1, [&levels, &data, &header, pixelLayout](const size_t index)
+		{
+			MipLevel& level = levels[index + 1];
+			level.resized.resize(level.pixelSize);
+			stbir_resize_uint8_linear(data.data.data(), header.width, header.height,
+				0, level.resized.data(), static_cast<int>(level.width), static_cast<int>(level.height), 0, pixelLayout);
+			level.pixels = level.resized.data();
+		});
+
+		if (applyCompression)
+		{
+			InitializeBlockCompression();
+
+			// Split all mip levels into jobs of block rows, so that small mips are compressed alongside the large ones
+			const size_t blockSize = (header.format == v1_0::DXT1 || header.format == v1_0::BC4) ? 8 : 16;
+			std::vector<CompressionJob> compressionJobs;
+			for (MipLevel& level : levels)
+			{
+				const uint32 blocksX = (level.width + 3) / 4;
+				const uint32 blocksY = (level.height + 3) / 4;
+				level.compressed.resize(static_cast<size_t>(blocksX) * blocksY * blockSize);
+
+				for (uint32 row = 0; row < blocksY; row += BlockRowsPerJob)
+				{
+					compressionJobs.push_back({ &level, row, std::min(BlockRowsPerJob, blocksY - row) });
+				}
+			}
+
+			forEach(compressionJobs.size(), [&compressionJobs, &header](const size_t index)
+			{
+				CompressBlocks(header.format, compressionJobs[index]);
+			});
+		}
+
+		// Generate a sink to save the header
+		v1_0::HeaderSaver saver{ sink, header };
+
+		for (const MipLevel& level : levels)
+		{
+			if (level.index > 0)
+			{
+				ILOG("Generated mip #" << level.index << " with size " << level.width << "x" << level.height);
+			}
+
+			// After the header, now write the pixel data
+			header.mipmapOffsets[level.index] = static_cast<uint32>(sink.Position());
+			if (applyCompression)
+			{
+				ILOG("Original size: " << level.pixelSize << ", compressed size: " << level.compressed.size());
+				header.mipmapLengths[level.index] = static_cast<uint32>(level.compressed.size());
+				sink.Write(reinterpret_cast<const char*>(level.compressed.data()), level.compressed.size());
+			}
+			else
+			{
+				ILOG("Data size: " << level.pixelSize);
+				header.mipmapLengths[level.index] = static_cast<uint32>(level.pixelSize);
+				sink.Write(reinterpret_cast<const char*>(level.pixels), level.pixelSize);
+			}
+		}
+
+		// Finish the header with adjusted data
+		saver.finish();
+		return true;
+	}
+}
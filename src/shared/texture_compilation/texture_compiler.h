@@ -0,0 +1,94 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/filesystem.h"
+#include "base/typedefs.h"
+
+#include <vector>
+
+namespace io
+{
+	struct ISink;
+}
+
+namespace mmo
+{
+	class JobSystem;
+
+	/// @brief Enumerates the intended usage of a texture, which determines format selection during import.
+	enum class TextureUsage
+	{
+		/// Standard color texture (diffuse, albedo, UI, etc.)
+		Color,
+
+		/// Normal map texture (will be stored as two-channel RG for efficiency)
+		NormalMap,
+
+		/// Single-channel grayscale texture (heightmaps, alpha masks, roughness, etc.)
+		Grayscale,
+	};
+
+	/// Enumerates available pixel formats for source files.
+	enum class ImageFormat
+	{
+		/// Parser is expected to return 32 bit pixel data, but the alpha channel isn't
+		/// filled with meaningful data and thus discarded. This might be important when
+		/// choosing the final pixel format to write.
+		RGBX,
+		/// 32 bit rgba pixel data with 8 bits per channel. Uncompressed.
+		RGBA,
+		/// DXT1/BC1 compressed data.
+		DXT1,
+		/// DXT5/BC3 compressed data.
+		DXT5,
+		/// Single-channel 8-bit data.
+		R8,
+		/// Two-channel 8-bit data.
+		RG8,
+	};
+
+	/// Contains infos about a source image file.
+	struct TextureData final
+	{
+		/// Actual width of the image in texels.
+		uint16 width;
+		/// Actual height of the image in texels.
+		uint16 height;
+		/// Image texel data format.
+		ImageFormat format;
+		/// @brief Image data.
+		std::vector<uint8> data;
+	};
+
+	/// @brief Determines whether the given file extension (including the dot) is a supported source image format.
+	[[nodiscard]] bool IsSupportedTextureExtension(const String& extension);
+
+	/// @brief Reads image information from the given file and extracts the required data.
+	/// @param filename The name of the image file to extract data from.
+	/// @param width Image width will be stored here.
+	/// @param height Image height will be stored here.
+	/// @param numChannels Number of channels will be stored here.
+	/// @param rawData Raw pixel data will be stored here, in y * x * numChannel order.
+	/// @return true on success, false otherwise.
+	bool ReadTextureData(const std::filesystem::path& filename, int32& width, int32& height, int32& numChannels, std::vector<uint8>& rawData);
+
+	/// @brief Converts raw image data to the appropriate TextureData based on the texture usage.
+	/// @param rawData The raw RGBA pixel data from the source image.
+	/// @param width Image width.
+	/// @param height Image height.
+	/// @param numChannels Number of source channels.
+	/// @param usage The intended usage of the texture.
+	/// @param data The output TextureData structure.
+	/// @return true on success, false otherwise.
+	bool ConvertTextureData(const std::vector<uint8>& rawData, int32 width, int32 height, int32 numChannels, TextureUsage usage, TextureData& data);
+
+	/// @brief Writes a texture in the tex_v1_0 format including all of its mip maps.
+	/// @param sink The sink to write the texture to.
+	/// @param data The converted texture data to write.
+	/// @param compress Whether block compression should be applied if the image size allows it.
+	/// @param jobs Optional job system. If provided, mip maps are generated in parallel and the blocks of all mip maps
+	///	            are compressed in parallel. The output is identical to the output without a job system.
+	/// @return true on success, false otherwise.
+	bool WriteTexture(io::ISink& sink, const TextureData& data, bool compress, JobSystem* jobs = nullptr);
+}
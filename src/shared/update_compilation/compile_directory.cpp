@@ -2,6 +2,7 @@
 
 #include "compile_directory.h"
 
+#include "base/job_system.h"
 #include "base/macros.h"
 #include "base/sha1.h"
 
@@ -9,12 +10,18 @@
 #include "simple_file_format/sff_read_tree.h"
 #include "simple_file_format/sff_write_table.h"
 
+#include "updater/content_chunks.h"
+
 #include "virtual_dir/reader.h"
 #include "virtual_dir/writer.h"
 
 #include "zstr/zstr.hpp"
 
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
 
 namespace mmo
 {
@@ -26,18 +33,425 @@ namespace mmo
 			typedef sff::read::tree::Table<Iterator> Table;
 			typedef sff::write::Table<char> TableWriter;
 
+			/// Name of the file in the output directory which remembers the results of the last compilation.
+			const virtual_dir::Path CacheFileName = ".compile_cache";
+
+
+			/// A content chunk of a compiled file.
+			struct CompiledChunk
+			{
+				SHA1Hash sha1;
+				std::uintmax_t size;
+				std::uintmax_t compressedSize;
+			};
+
+			/// Everything the update list contains about a compiled file.
+			struct CompiledFile
+			{
+				std::uintmax_t originalSize = 0;
+				SHA1Hash sha1 {};
+				bool isZLibCompressed = false;
+				std::uintmax_t compressedSize = 0;
+				std::uintmax_t chunkSize = 0;
+				std::vector<CompiledChunk> chunks;
+			};
+
+			/// A file which is compiled, found while walking the source list.
+			struct FileJob
+			{
+				virtual_dir::Path fromLocation;
+				virtual_dir::Path outputPath;
+				CompiledFile result;
+				bool isSkipped = false;
+				std::string error;
+			};
+
+			/// State of a directory compilation. The source list is walked twice: The first walk collects all files,
+			/// which are then compiled in parallel, and the second walk writes the update list.
+			struct CompileContext
+			{
+				virtual_dir::IReader &sourceRoot;
+				virtual_dir::IWriter &outputRoot;
+				const CompileOptions &options;
+
+				bool isCollecting = true;
+				std::vector<FileJob> files;
+				std::map<virtual_dir::Path, size_t> fileIndexByOutputPath;
+
+				/// Results of the previous compilation by output path.
+				std::map<virtual_dir::Path, CompiledFile> cache;
+
+				/// Compressed sizes of all chunks which exist in the output, by digest. Chunks which are currently
+				/// written have a size of zero until all jobs finished.
+				std::map<SHA1Hash, std::uintmax_t> chunkSizes;
+				std::mutex chunkMutex;
+				size_t writtenChunks = 0;
+
+				CompileContext(
+				    virtual_dir::IReader &sourceRoot,
+				    virtual_dir::IWriter &outputRoot,
+				    const CompileOptions &options)
+					: sourceRoot(sourceRoot)
+					, outputRoot(outputRoot)
+					, options(options)
+				{
+				}
+			};
+
+
+			bool fileExists(virtual_dir::IReader &reader, const virtual_dir::Path &path)
+			{
+				try
+				{
+					return reader.getType(path) == virtual_dir::file_type::File;
+				}
+				catch (const std::exception &)
+				{
+					return false;
+				}
+			}
+
+			std::string formatSha1(const SHA1Hash &hash)
+			{
+				std::ostringstream formatter;
+				sha1PrintHex(formatter, hash);
+				return formatter.str();
+			}
+
+			bool parseSha1(const std::string &hex, SHA1Hash &hash)
+			{
+				std::istringstream sha1HexStream(hex);
+				hash = sha1ParseHex(sha1HexStream);
+				return !sha1HexStream.bad();
+			}
+
+			/// Writes data to an output file and returns the number of bytes written to the file.
+			std::uintmax_t writeOutputFile(
+			    virtual_dir::IWriter &outputRoot,
+			    const virtual_dir::Path &path,
+			    std::istream &source,
+			    bool isZLibCompressed
+			)
+			{
+				//workaround:
+				const auto outputFile = outputRoot.writeFile(
+				                            path,
+				                            false,
+				                            true
+				                        );
+
+				if (!outputFile)
+				{
+					throw std::runtime_error(
+					    "Could not open output file " +
+					    path);
+				}
+
+				// Generate the output stream with compression if requested
+				std::unique_ptr<std::ostream> outStream;
+				if (!isZLibCompressed)
+				{
+					outStream = std::make_unique<std::ostream>(outputFile->rdbuf());
+				}
+				else
+				{
+					outStream = std::make_unique<zstr::ostream>(*outputFile);
+				}
+
+				// Read in source file in 4k byte chunks and process it
+				char buf[4096];
+				std::streamsize read;
+				do
+				{
+					source.read(buf, 4096);
+					read = source.gcount();
+					if (read > 0)
+					{
+						outStream->write(buf, read);
+					}
+				} while (source && read > 0);
+
+				// Flush the output stream
+				outStream->flush();
+				outStream.reset();
+
+				return static_cast<std::uintmax_t>(outputFile->tellp());
+			}
+
+			/// Checks whether the output of the previous compilation of a file can be used as is.
+			bool isUpToDate(CompileContext &context, const FileJob &file, const CompiledFile &cached)
+			{
+				const CompiledFile &current = file.result;
+				if (cached.sha1 != current.sha1 ||
+				    cached.originalSize != current.originalSize ||
+				    cached.isZLibCompressed != current.isZLibCompressed ||
+				    cached.chunkSize != current.chunkSize)
+				{
+					return false;
+				}
+
+				{
+					std::scoped_lock lock{ context.chunkMutex };
+					for (const auto &chunk : cached.chunks)
+					{
+						if (!context.chunkSizes.count(chunk.sha1))
+						{
+							return false;
+						}
+					}
+				}
+
+				return fileExists(*context.options.previousOutput, file.outputPath);
+			}
+
+			/// Compiles a single file. Executed on the job system, so all errors are stored in the job.
+			void compileFileJob(CompileContext &context, FileJob &file)
+			{
+				try
+				{
+					const auto sourceFile = context.sourceRoot.readFile(
+					                            file.fromLocation,
+					                            false
+					                        );
+
+					if (!sourceFile)
+					{
+						throw std::runtime_error(
+						    "Could not open source file " +
+						    file.fromLocation);
+					}
+
+					CompiledFile &result = file.result;
+					result.isZLibCompressed = context.options.isZLibCompressed;
+
+					sourceFile->seekg(0, std::ios::end);
+					result.originalSize = static_cast<std::uintmax_t>(sourceFile->tellg());
+
+					sourceFile->seekg(0, std::ios::beg);
+					result.sha1 = sha1(*sourceFile);
+
+					// Files which fit into a single chunk can't be patched anyway
+					if (context.options.chunkSize > 0 && result.originalSize > context.options.chunkSize)
+					{
+						result.chunkSize = context.options.chunkSize;
+					}
+
+					if (context.options.previousOutput)
+					{
+						const auto cached = context.cache.find(file.outputPath);
+						if (cached != context.cache.end() && isUpToDate(context, file, cached->second))
+						{
+							result.compressedSize = cached->second.compressedSize;
+							result.chunks = cached->second.chunks;
+							file.isSkipped = true;
+							return;
+						}
+					}
+
+					sourceFile->clear();
+					sourceFile->seekg(0, std::ios::beg);
+					result.compressedSize = writeOutputFile(context.outputRoot, file.outputPath, *sourceFile, result.isZLibCompressed);
+
+					if (result.chunkSize == 0)
+					{
+						return;
+					}
+
+					sourceFile->clear();
+					sourceFile->seekg(0, std::ios::beg);
+					splitContentChunks(*sourceFile, result.chunkSize, [&context, &result](const ContentChunk &chunk, const char *data)
+					{
+						result.chunks.push_back({ chunk.sha1, chunk.size, 0 });
+
+						// Chunks are shared between all files and versions, so every chunk is only written once
+						{
+							std::scoped_lock lock{ context.chunkMutex };
+							if (!context.chunkSizes.emplace(chunk.sha1, 0).second)
+							{
+								return;
+							}
+						}
+
+						std::istringstream chunkSource(std::string(data, static_cast<size_t>(chunk.size)));
+						const auto compressedSize = writeOutputFile(
+						                                context.outputRoot,
+						                                getContentChunkPath(chunk.sha1, result.isZLibCompressed),
+						                                chunkSource,
+						                                result.isZLibCompressed);
+
+						std::scoped_lock lock{ context.chunkMutex };
+						context.chunkSizes[chunk.sha1] = compressedSize;
+						++context.writtenChunks;
+					});
+				}
+				catch (const std::exception &e)
+				{
+					file.error = e.what();
+				}
+			}
+
+			/// Writes the description of a compiled file, as used by the update list and the compile cache.
+			void writeCompiledFile(TableWriter &output, const CompiledFile &file)
+			{
+				output.addKey("originalSize", file.originalSize);
+				output.addKey("sha1", formatSha1(file.sha1));
+
+				if (file.isZLibCompressed)
+				{
+					output.addKey("compression", "zlib");
+					output.addKey("compressedSize", file.compressedSize);
+				}
+
+				if (file.chunkSize > 0)
+				{
+					output.addKey("chunkSize", file.chunkSize);
+
+					sff::write::Array<char> chunksOutput(
+					    output,
+					    "chunks",
+					    sff::write::MultiLine);
+
+					for (const auto &chunk : file.chunks)
+					{
+						TableWriter chunkOutput(chunksOutput, sff::write::Comma);
+						chunkOutput.addKey("sha1", formatSha1(chunk.sha1));
+						chunkOutput.addKey("size", chunk.size);
+						chunkOutput.addKey("compressedSize", chunk.compressedSize);
+						chunkOutput.Finish();
+					}
+
+					chunksOutput.Finish();
+				}
+			}
+
+			/// Reads the results of the previous compilation and remembers which of its chunks still exist.
+			void loadCache(CompileContext &context)
+			{
+				virtual_dir::IReader &previousOutput = *context.options.previousOutput;
+				if (!fileExists(previousOutput, CacheFileName))
+				{
+					return;
+				}
+
+				const auto cacheFile = previousOutput.readFile(CacheFileName, false);
+				if (!cacheFile)
+				{
+					return;
+				}
+
+				std::string cacheContent;
+				Table cacheTable;
+				try
+				{
+					sff::loadTableFromFile(cacheTable, cacheContent, *cacheFile);
+				}
+				catch (const std::exception &e)
+				{
+					std::cerr << "Ignoring damaged compile cache: " << e.what() << '\n';
+					return;
+				}
+
+				const auto *const files = cacheTable.getArray("files");
+				if (cacheTable.getInteger<unsigned>("version", 0) != 1 || !files)
+				{
+					return;
+				}
+
+				std::set<SHA1Hash> missingChunks;
+				for (size_t i = 0, c = files->getSize(); i < c; ++i)
+				{
+					const auto *const fileDescription = files->getTable(i);
+					if (!fileDescription)
+					{
+						continue;
+					}
+
+					CompiledFile file;
+					file.originalSize = fileDescription->getInteger<std::uintmax_t>("originalSize", 0);
+					file.isZLibCompressed = fileDescription->getString("compression") == "zlib";
+					file.compressedSize = fileDescription->getInteger<std::uintmax_t>("compressedSize", 0);
+					file.chunkSize = fileDescription->getInteger<std::uintmax_t>("chunkSize", 0);
+					if (!parseSha1(fileDescription->getString("sha1"), file.sha1))
+					{
+						continue;
+					}
+
+					if (const auto *const chunks = fileDescription->getArray("chunks"))
+					{
+						for (size_t j = 0, d = chunks->getSize(); j < d; ++j)
+						{
+							const auto *const chunkDescription = chunks->getTable(j);
+							if (!chunkDescription)
+							{
+								continue;
+							}
+
+							CompiledChunk chunk;
+							chunk.size = chunkDescription->getInteger<std::uintmax_t>("size", 0);
+							chunk.compressedSize = chunkDescription->getInteger<std::uintmax_t>("compressedSize", 0);
+							if (!parseSha1(chunkDescription->getString("sha1"), chunk.sha1))
+							{
+								continue;
+							}
+
+							if (!context.chunkSizes.count(chunk.sha1) && !missingChunks.count(chunk.sha1))
+							{
+								if (fileExists(previousOutput, getContentChunkPath(chunk.sha1, file.isZLibCompressed)))
+								{
+									context.chunkSizes.emplace(chunk.sha1, chunk.compressedSize);
+								}
+								else
+								{
+									missingChunks.insert(chunk.sha1);
+								}
+							}
+
+							file.chunks.push_back(chunk);
+						}
+					}
+
+					context.cache.emplace(fileDescription->getString("path"), std::move(file));
+				}
+			}
+
+			void saveCache(CompileContext &context)
+			{
+				const auto cacheFile = context.outputRoot.writeFile(CacheFileName, false, true);
+				if (!cacheFile)
+				{
+					throw std::runtime_error(
+					    "Could not open compile cache " + CacheFileName);
+				}
+
+				sff::write::Writer<char> cacheWriter(*cacheFile);
+				TableWriter cacheTable(cacheWriter, sff::write::MultiLine);
+				cacheTable.addKey("version", 1);
+
+				sff::write::Array<char> filesOutput(
+				    cacheTable,
+				    "files",
+				    sff::write::MultiLine);
+
+				for (const auto &file : context.files)
+				{
+					TableWriter fileOutput(filesOutput, sff::write::Comma);
+					fileOutput.addKey("path", file.outputPath);
+					writeCompiledFile(fileOutput, file.result);
+					fileOutput.Finish();
+				}
+
+				filesOutput.Finish();
+			}
 
 			void compileFile(
-				virtual_dir::IReader &sourceRoot,
-				virtual_dir::IWriter &outputRoot,
+				CompileContext &context,
 				const virtual_dir::Path &fromLocation,
 				TableWriter &outputDescription,
 				const virtual_dir::Path &destinationDir,
-				bool isZLibCompressed,
 				const std::string &fileName
 			)
 			{
-				const auto type = sourceRoot.getType(fromLocation);
+				const auto type = context.sourceRoot.getType(fromLocation);
 
 				if (type == virtual_dir::file_type::Directory)
 				{
@@ -46,7 +460,7 @@ namespace mmo
 					    "entries",
 					    sff::write::MultiLine);
 
-					const auto entries = sourceRoot.queryEntries(
+					const auto entries = context.sourceRoot.queryEntries(
 					                         fromLocation
 					                     );
 
@@ -57,12 +471,10 @@ namespace mmo
 						entryOutput.addKey("name", entry);
 
 						compileFile(
-						    sourceRoot,
-						    outputRoot,
+						    context,
 						    virtual_dir::joinPaths(fromLocation, entry),
 						    entryOutput,
 						    virtual_dir::joinPaths(destinationDir, entry),
-						    isZLibCompressed,
 						    entry
 						);
 
@@ -73,20 +485,8 @@ namespace mmo
 				}
 				else if (type == virtual_dir::file_type::File)
 				{
-					const auto sourceFile = sourceRoot.readFile(
-					                            fromLocation,
-					                            false
-					                        );
-
-					if (!sourceFile)
-					{
-						throw std::runtime_error(
-						    "Could not open source file " +
-						    fromLocation);
-					}
-
 					auto compressedNameFull = destinationDir;
-					if (isZLibCompressed)
+					if (context.options.isZLibCompressed)
 					{
 						const auto compressedName = fileName + ".z";
 						outputDescription.addKey("compressedName", compressedName);
@@ -94,97 +494,40 @@ namespace mmo
 						compressedNameFull += ".z";
 					}
 
+					// Files are compiled after the first walk, so only remember them for now
+					if (context.isCollecting)
 					{
-						sourceFile->seekg(0, std::ios::end);
+						if (context.fileIndexByOutputPath.emplace(compressedNameFull, context.files.size()).second)
 						{
-							const std::streamoff originalSize = sourceFile->tellg();
-							outputDescription.addKey("originalSize", originalSize);
+							FileJob file;
+							file.fromLocation = fromLocation;
+							file.outputPath = compressedNameFull;
+							context.files.push_back(std::move(file));
 						}
 
-						sourceFile->seekg(0, std::ios::beg);
-						{
-							const auto hashCode = sha1(*sourceFile);
-							std::ostringstream formatter;
-							sha1PrintHex(formatter, hashCode);
-							outputDescription.addKey("sha1", formatter.str());
-						}
-					}
-
-					//workaround:
-					const auto outputFile = outputRoot.writeFile(
-					                            compressedNameFull,
-					                            false,
-					                            true
-					                        );
-
-					if (!outputFile)
-					{
-						throw std::runtime_error(
-						    "Could not open output file " +
-						    compressedNameFull);
-					}
-
-					sourceFile->clear();
-					sourceFile->seekg(0, std::ios::beg);
-
-
-					// Generate the output stream with compression if requested
-					std::unique_ptr<std::ostream> outStream;
-					if (!isZLibCompressed)
-					{
-						outStream = std::make_unique<std::ostream>(outputFile->rdbuf());
-					}
-					else
-					{
-						outStream = std::make_unique<zstr::ostream>(*outputFile);
+						return;
 					}
 
-					// Read in source file in 4k byte chunks and process it
-					char buf[4096];
-					std::streamsize read;
-					do
-					{
-						sourceFile->read(buf, 4096);
-						read = sourceFile->gcount();
-						if (read > 0)
-						{
-							outStream->write(buf, read);
-						}
-					} while (*sourceFile && read > 0);
-
-					// Flush the output stream
-					outStream->flush();
-					outStream.reset();
-
-					if (isZLibCompressed)
-					{
-						outputDescription.addKey("compression", "zlib");
-
-						const std::uintmax_t compressedSize = outputFile->tellp();
-						outputDescription.addKey("compressedSize", compressedSize);
-					}
+					const FileJob &file = context.files[context.fileIndexByOutputPath.at(compressedNameFull)];
+					writeCompiledFile(outputDescription, file.result);
 				}
 			}
 
 			void compileIf(
-			    virtual_dir::IReader &sourceRoot,
-			    virtual_dir::IWriter &outputRoot,
+			    CompileContext &context,
 			    const Table &inputDescription,
 			    const virtual_dir::Path &fromLocation,
 			    TableWriter &outputDescription,
-			    const virtual_dir::Path &destinationDir,
-			    bool isZLibCompressed
+			    const virtual_dir::Path &destinationDir
 			);
 
 
 			void compileEntry(
-			    virtual_dir::IReader &sourceRoot,
-			    virtual_dir::IWriter &outputRoot,
+			    CompileContext &context,
 			    const Table &inputDescription,
 			    const virtual_dir::Path &fromLocation,
 			    TableWriter &outputDescription,
-			    const virtual_dir::Path &destinationDir,
-			    bool isZLibCompressed
+			    const virtual_dir::Path &destinationDir
 			)
 			{
 				// Obtain the source type so we can apply a different compiler eventually
@@ -197,13 +540,11 @@ namespace mmo
 				if (type == "if")
 				{
 					compileIf(
-					    sourceRoot,
-					    outputRoot,
+					    context,
 					    inputDescription,
 					    fromLocation,
 					    outputDescription,
-					    destinationDir,
-					    isZLibCompressed
+					    destinationDir
 					);
 				}
 				else
@@ -254,13 +595,11 @@ namespace mmo
 									sff::write::Comma);
 
 								compileEntry(
-									sourceRoot,
-									outputRoot,
+									context,
 									*entryDescription,
 									subFromLocation,
 									entryDescriptionOutput,
-									virtual_dir::joinPaths(subDestinationDir, sub),
-									isZLibCompressed
+									virtual_dir::joinPaths(subDestinationDir, sub)
 								);
 
 								subEntriesOutput.Finish();
@@ -275,13 +614,11 @@ namespace mmo
 									sff::write::Comma);
 
 								compileEntry(
-									sourceRoot,
-									outputRoot,
+									context,
 									*entryDescription,
 									subFromLocation,
 									entryDescriptionOutput,
-									subDestinationDir,
-									isZLibCompressed
+									subDestinationDir
 								);
 
 								entryDescriptionOutput.Finish();
@@ -306,12 +643,10 @@ namespace mmo
 							entryOutput.addKey("name", sub);
 
 							compileFile(
-								sourceRoot,
-								outputRoot,
+								context,
 								subFromLocation,
 								entryOutput,
 								virtual_dir::joinPaths(subDestinationDir, sub),
-								isZLibCompressed,
 								to
 							);
 
@@ -321,12 +656,10 @@ namespace mmo
 						else
 						{
 							compileFile(
-								sourceRoot,
-								outputRoot,
+								context,
 								subFromLocation,
 								outputDescription,
 								subDestinationDir,
-								isZLibCompressed,
 								to
 							);
 						}
@@ -336,13 +669,11 @@ namespace mmo
 
 
 			void compileIf(
-			    virtual_dir::IReader &sourceRoot,
-			    virtual_dir::IWriter &outputRoot,
+			    CompileContext &context,
 			    const Table &inputDescription,
 			    const virtual_dir::Path &fromLocation,
 			    TableWriter &outputDescription,
-			    const virtual_dir::Path &destinationDir,
-			    bool isZLibCompressed
+			    const virtual_dir::Path &destinationDir
 			)
 			{
 				{
@@ -366,17 +697,39 @@ namespace mmo
 				    sff::write::Comma);
 
 				compileEntry(
-				    sourceRoot,
-				    outputRoot,
+				    context,
 				    *value,
 				    fromLocation,
 				    valueOutput,
-				    destinationDir,
-				    isZLibCompressed
+				    destinationDir
 				);
 
 				valueOutput.Finish();
 			}
+
+			/// Writes the update list with the root entry of the source list.
+			void writeList(CompileContext &context, const Table &root, std::ostream &listFile)
+			{
+				// Write the target root table
+				sff::write::Writer<char> listWriter(listFile);
+				TableWriter listTable(listWriter, sff::write::MultiLine);
+
+				// Add the current file format verison
+				listTable.addKey("version", 1);
+
+				// Compile the first entry from the source list
+				TableWriter rootEntry(listTable, "root", sff::write::Comma);
+				compileEntry(
+				    context,
+				    root,
+				    "",
+				    rootEntry,
+				    ""
+				);
+
+				// And finishe the root entry in list.txt
+				rootEntry.Finish();
+			}
 		}
 
 
@@ -385,6 +738,17 @@ namespace mmo
 			virtual_dir::IWriter &destinationDir,
 		    bool isZLibCompressed
 		)
+		{
+			CompileOptions options;
+			options.isZLibCompressed = isZLibCompressed;
+			compileDirectory(sourceDir, destinationDir, options);
+		}
+
+		CompileStatistics compileDirectory(
+			virtual_dir::IReader &sourceDir,
+			virtual_dir::IWriter &destinationDir,
+			const CompileOptions &options
+		)
 		{
 			// Try to find source.txt in source directoy and open it for reading
 			const std::string fullSourceFileName = "source.txt";
@@ -401,17 +765,77 @@ namespace mmo
 
 			// Check the format version
 			const auto version = sourceTable.getInteger<unsigned>("version", 0);
-			if (version == 0)
+			if (version != 0)
+			{
+				throw std::runtime_error("Unsupported source list version");
+			}
+
+			// Try to get the root object
+			const auto *const root = sourceTable.getTable("root");
+			if (!root)
+			{
+				throw std::runtime_error("Root directory entry is missing");
+			}
+
+			CompileContext context(sourceDir, destinationDir, options);
+			if (options.previousOutput)
+			{
+				loadCache(context);
+			}
+
+			// Collect all files of the source list
+			{
+				std::ostringstream discardedList;
+				writeList(context, *root, discardedList);
+			}
+
+			// Compile the files, which are independent of each other
+			const auto compile = [&context](const size_t index)
+			{
+				compileFileJob(context, context.files[index]);
+			};
+
+			if (options.jobs)
+			{
+				options.jobs->ParallelFor(context.files.size(), compile);
+			}
+			else
+			{
+				for (size_t i = 0; i < context.files.size(); ++i)
+				{
+					compile(i);
+				}
+			}
+
+			CompileStatistics statistics;
+			for (auto &file : context.files)
 			{
-				// Try to get the root object
-				const auto *const root = sourceTable.getTable("root");
-				if (!root)
+				if (!file.error.empty())
+				{
+					throw std::runtime_error(file.error);
+				}
+
+				for (auto &chunk : file.result.chunks)
+				{
+					chunk.compressedSize = context.chunkSizes.at(chunk.sha1);
+				}
+
+				if (file.isSkipped)
 				{
-					throw std::runtime_error("Root directory entry is missing");
+					++statistics.skippedFiles;
 				}
+				else
+				{
+					++statistics.compiledFiles;
+				}
+			}
+
+			statistics.writtenChunks = context.writtenChunks;
 
-				// Create the list.txt file in the target directory for writing. This file
-				// will contain a summary of all file entries
+			// Create the list.txt file in the target directory for writing. This file
+			// will contain a summary of all file entries
+			context.isCollecting = false;
+			{
 				const virtual_dir::Path fullListFileName = "list.txt";
 				const auto listFile = destinationDir.writeFile(fullListFileName, false, true);
 				if (!listFile)
@@ -420,32 +844,11 @@ namespace mmo
 					    "Could not open output list file " + fullListFileName);
 				}
 
-				// Write the target root table
-				sff::write::Writer<char> listWriter(*listFile);
-				TableWriter listTable(listWriter, sff::write::MultiLine);
-
-				// Add the current file format verison
-				listTable.addKey("version", 1);
-
-				// Compile the first entry from the source list
-				TableWriter rootEntry(listTable, "root", sff::write::Comma);
-				compileEntry(
-				    sourceDir,
-				    destinationDir,
-				    *root,
-				    "",
-				    rootEntry,
-				    "",
-				    isZLibCompressed
-				);
-
-				// And finishe the root entry in list.txt
-				rootEntry.Finish();
-			}
-			else
-			{
-				throw std::runtime_error("Unsupported source list version");
+				writeList(context, *root, *listFile);
 			}
+
+			saveCache(context);
+			return statistics;
 		}
 	}
 }
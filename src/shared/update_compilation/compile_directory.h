@@ -4,8 +4,12 @@
 
 #include "base/filesystem.h"
 
+#include <cstdint>
+
 namespace mmo
 {
+	class JobSystem;
+
 	namespace virtual_dir
 	{
 		struct IReader;
@@ -14,6 +18,32 @@ namespace mmo
 
 	namespace updating
 	{
+		/// Options of an update compilation.
+		struct CompileOptions
+		{
+			/// True to apply zlib compression on the files.
+			bool isZLibCompressed = false;
+			/// Average size of the content chunks files are split into, so that clients can patch their local copy
+			/// instead of downloading whole files. Zero disables content chunks. Has to be a power of two.
+			std::uintmax_t chunkSize = 0;
+			/// Reader for the output of the previous compilation. Files whose content and settings did not change
+			/// since then are not written again. nullptr compiles every file.
+			virtual_dir::IReader *previousOutput = nullptr;
+			/// Optional job system which compiles multiple files in parallel.
+			JobSystem *jobs = nullptr;
+		};
+
+		/// Statistics of an update compilation.
+		struct CompileStatistics
+		{
+			/// Number of files which have been written.
+			size_t compiledFiles = 0;
+			/// Number of files which did not change since the previous compilation.
+			size_t skippedFiles = 0;
+			/// Number of content chunks which have been written.
+			size_t writtenChunks = 0;
+		};
+
 		/// Compiles a whole directory with all it's files and folders.
 		/// @sourceDir A reader object for the source directory.
 		/// @destinationDir A writer object for the destination directory.
@@ -23,5 +53,16 @@ namespace mmo
 			virtual_dir::IWriter &destinationDir,
 		    bool isZLibCompressed
 		);
+
+		/// Compiles a whole directory with all it's files and folders.
+		/// @sourceDir A reader object for the source directory.
+		/// @destinationDir A writer object for the destination directory.
+		/// @param options Compression, content chunk and incremental compilation options.
+		/// @returns Statistics about the written files.
+		CompileStatistics compileDirectory(
+			virtual_dir::IReader &sourceDir,
+			virtual_dir::IWriter &destinationDir,
+			const CompileOptions &options
+		);
 	}
 }
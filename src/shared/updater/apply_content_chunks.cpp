@@ -0,0 +1,216 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#include "apply_content_chunks.h"
+#include "update_source.h"
+#include "updater_progress_handler.h"
+
+#include "base/filesystem.h"
+
+#include "zstr/zstr.hpp"
+
+#include <fstream>
+#include <sstream>
+
+
+namespace mmo::updating
+{
+	namespace
+	{
+		/// Downloads a single chunk, decompresses it if needed and checks its digest.
+		void downloadChunk(
+		    const UpdateParameters &parameters,
+		    const RemoteContentChunk &chunk,
+		    bool doZLibUncompress,
+		    std::vector<char> &buffer
+		)
+		{
+			const auto path = getContentChunkPath(chunk.sha1, doZLibUncompress);
+			const auto sourceFile = parameters.source->readFile(path);
+			checkExpectedFileSize(path, chunk.compressedSize, sourceFile);
+
+			std::unique_ptr<std::istream> source =
+				doZLibUncompress ?
+					std::make_unique<zstr::istream>(*sourceFile.content) :
+					std::make_unique<std::istream>(sourceFile.content->rdbuf());
+
+			// Read one byte more than expected to detect chunks which are too large
+			buffer.resize(static_cast<size_t>(chunk.size) + 1);
+			source->read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+			if (static_cast<std::uintmax_t>(source->gcount()) != chunk.size)
+			{
+				throw std::runtime_error(path + ": Chunk has an unexpected size");
+			}
+
+			buffer.resize(static_cast<size_t>(chunk.size));
+			if (sha1(buffer.data(), buffer.size()) != chunk.sha1)
+			{
+				throw std::runtime_error(path + ": Chunk digest mismatch");
+			}
+		}
+	}
+
+
+	bool parseContentChunks(
+	    const sff::read::tree::Table<std::string::const_iterator> &entryDescription,
+	    std::uintmax_t &chunkSize,
+	    std::vector<RemoteContentChunk> &chunks
+	)
+	{
+		const auto *const chunkArray = entryDescription.getArray("chunks");
+		if (!chunkArray ||
+		    !entryDescription.tryGetInteger("chunkSize", chunkSize))
+		{
+			return false;
+		}
+
+		chunks.clear();
+		chunks.reserve(chunkArray->getSize());
+
+		for (size_t i = 0, c = chunkArray->getSize(); i < c; ++i)
+		{
+			const auto *const chunkDescription = chunkArray->getTable(i);
+			if (!chunkDescription)
+			{
+				throw std::runtime_error("Non-table element in chunks array");
+			}
+
+			RemoteContentChunk chunk;
+			if (!chunkDescription->tryGetInteger("size", chunk.size))
+			{
+				throw std::runtime_error("Chunk size is missing");
+			}
+
+			chunk.compressedSize = chunkDescription->getInteger<std::uintmax_t>("compressedSize", chunk.size);
+
+			std::string sha1Hex;
+			if (!chunkDescription->tryGetString("sha1", sha1Hex))
+			{
+				throw std::runtime_error("Chunk SHA-1 digest is missing");
+			}
+
+			std::istringstream sha1HexStream(sha1Hex);
+			chunk.sha1 = sha1ParseHex(sha1HexStream);
+			if (sha1HexStream.bad())
+			{
+				throw std::runtime_error("Invalid chunk SHA-1 digest");
+			}
+
+			chunks.push_back(chunk);
+		}
+
+		return true;
+	}
+
+	LocalContentChunks indexLocalContentChunks(
+	    const std::string &fileName,
+	    std::uintmax_t chunkSize
+	)
+	{
+		LocalContentChunks localChunks;
+
+		std::ifstream file(fileName, std::ios::binary);
+		if (!file)
+		{
+			return localChunks;
+		}
+
+		for (const auto &chunk : splitContentChunks(file, chunkSize))
+		{
+			localChunks.emplace(chunk.sha1, chunk);
+		}
+
+		return localChunks;
+	}
+
+	void applyContentChunks(
+	    const UpdateParameters &parameters,
+	    const std::string &name,
+	    const std::string &destination,
+	    const std::vector<RemoteContentChunk> &chunks,
+	    const LocalContentChunks &localChunks,
+	    const std::string &compression,
+	    std::uintmax_t originalSize,
+	    const SHA1Hash &sha1
+	)
+	{
+		bool doZLibUncompress = false;
+		if (compression == "zlib")
+		{
+			doZLibUncompress = true;
+		}
+		else if (!compression.empty())
+		{
+			throw std::runtime_error(
+			    "Unsupported compression type " + compression);
+		}
+
+		const std::string temporaryFileName = destination + ".patch";
+
+		HashGeneratorSha1 digest;
+		std::uintmax_t written = 0;
+
+		try
+		{
+			std::ifstream previousFile(destination, std::ios::binary);
+			std::ofstream sinkFile(temporaryFileName, std::ios::binary | std::ios::trunc);
+			if (!sinkFile)
+			{
+				throw std::runtime_error("Could not open output file " + temporaryFileName);
+			}
+
+			parameters.progressHandler.updateFile(name, originalSize, written);
+
+			std::vector<char> buffer;
+			for (const auto &chunk : chunks)
+			{
+				// The local copy may have changed since the update was prepared, so reused chunks are verified as well
+				bool isReused = false;
+				const auto local = localChunks.find(chunk.sha1);
+				if (previousFile && local != localChunks.end() && local->second.size == chunk.size)
+				{
+					buffer.resize(static_cast<size_t>(chunk.size));
+					previousFile.clear();
+					previousFile.seekg(static_cast<std::streamoff>(local->second.offset), std::ios::beg);
+					previousFile.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+
+					isReused =
+						static_cast<std::uintmax_t>(previousFile.gcount()) == chunk.size &&
+						mmo::sha1(buffer.data(), buffer.size()) == chunk.sha1;
+				}
+
+				if (!isReused)
+				{
+					downloadChunk(parameters, chunk, doZLibUncompress, buffer);
+				}
+
+				sinkFile.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+				digest.update(buffer.data(), buffer.size());
+				written += buffer.size();
+
+				parameters.progressHandler.updateFile(name, originalSize, written);
+			}
+
+			sinkFile.flush();
+			if (!sinkFile)
+			{
+				throw std::runtime_error("Could not write output file " + temporaryFileName);
+			}
+		}
+		catch (...)
+		{
+			// A chunk which could not be downloaded or verified leaves an incomplete file behind
+			std::error_code error;
+			std::filesystem::remove(temporaryFileName, error);
+			throw;
+		}
+
+		if (written != originalSize ||
+		    digest.finalize() != sha1)
+		{
+			std::filesystem::remove(temporaryFileName);
+			throw std::runtime_error(name + ": Patched file digest mismatch");
+		}
+
+		std::filesystem::rename(temporaryFileName, destination);
+	}
+}
@@ -0,0 +1,56 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "content_chunks.h"
+#include "update_parameters.h"
+
+#include "simple_file_format/sff_read_tree.h"
+
+#include <map>
+
+
+namespace mmo::updating
+{
+	/// A chunk of the new version of a file, as listed in the update list.
+	struct RemoteContentChunk
+	{
+		std::uintmax_t size;
+		std::uintmax_t compressedSize;
+		SHA1Hash sha1;
+	};
+
+
+	/// Chunks of a local file by their digest.
+	typedef std::map<SHA1Hash, ContentChunk> LocalContentChunks;
+
+
+	/// Reads the content chunks of a file entry of the update list.
+	/// @returns false if the entry has no content chunks, in which case the file can only be downloaded as a whole.
+	bool parseContentChunks(
+	    const sff::read::tree::Table<std::string::const_iterator> &entryDescription,
+	    std::uintmax_t &chunkSize,
+	    std::vector<RemoteContentChunk> &chunks
+	);
+
+	/// Splits a local file into content chunks the same way the update compiler did.
+	/// @returns The chunks by digest, which is empty if the file does not exist.
+	LocalContentChunks indexLocalContentChunks(
+	    const std::string &fileName,
+	    std::uintmax_t chunkSize
+	);
+
+	/// Rebuilds a file from the chunks of its new version. Chunks which are found in the local copy are copied from
+	/// it, all others are downloaded and verified. The result is written next to the destination and only replaces
+	/// it after its digest matched the expected one, so a failed update never leaves a damaged file behind.
+	void applyContentChunks(
+	    const UpdateParameters &parameters,
+	    const std::string &name,
+	    const std::string &destination,
+	    const std::vector<RemoteContentChunk> &chunks,
+	    const LocalContentChunks &localChunks,
+	    const std::string &compression,
+	    std::uintmax_t originalSize,
+	    const SHA1Hash &sha1
+	);
+}
@@ -0,0 +1,137 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#include "content_chunks.h"
+
+#include "base/typedefs.h"
+
+#include <array>
+#include <sstream>
+#include <stdexcept>
+
+
+namespace mmo::updating
+{
+	const std::string ContentChunkDirectory = "chunks";
+
+
+	namespace
+	{
+		/// Random values for every byte value used by the rolling gear hash. They are generated with splitmix64 from a
+		/// fixed seed, as the compiler and every client have to cut the same chunks.
+		constexpr std::array<uint64, 256> makeGearTable()
+		{
+			std::array<uint64, 256> table {};
+
+			uint64 state = 0;
+			for (auto &value : table)
+			{
+				state += 0x9E3779B97F4A7C15ull;
+				uint64 z = state;
+				z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+				z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+				value = z ^ (z >> 31);
+			}
+
+			return table;
+		}
+
+		constexpr std::array<uint64, 256> GearTable = makeGearTable();
+	}
+
+
+	std::vector<ContentChunk> splitContentChunks(
+	    std::istream &source,
+	    std::uintmax_t averageSize,
+	    const ContentChunkHandler &handler
+	)
+	{
+		if (averageSize < 64 || (averageSize & (averageSize - 1)) != 0)
+		{
+			throw std::invalid_argument("Content chunk size has to be a power of two of at least 64 bytes");
+		}
+
+		uint32 averageBits = 0;
+		while ((std::uintmax_t(1) << averageBits) < averageSize)
+		{
+			++averageBits;
+		}
+
+		const std::uintmax_t minSize = averageSize / 4;
+		const std::uintmax_t maxSize = averageSize * 4;
+
+		// The upper bits of the gear hash depend on the last 64 bytes, which makes them a good boundary condition
+		const uint32 boundaryShift = 64 - averageBits;
+
+		std::vector<ContentChunk> chunks;
+		std::vector<char> chunk;
+		chunk.reserve(static_cast<size_t>(maxSize));
+
+		std::uintmax_t offset = 0;
+		uint64 hash = 0;
+
+		const auto emit = [&]()
+		{
+			ContentChunk result;
+			result.offset = offset;
+			result.size = chunk.size();
+			result.sha1 = sha1(chunk.data(), chunk.size());
+
+			if (handler)
+			{
+				handler(result, chunk.data());
+			}
+
+			chunks.push_back(result);
+			offset += chunk.size();
+			chunk.clear();
+			hash = 0;
+		};
+
+		std::vector<char> buffer(64 * 1024);
+		while (source)
+		{
+			source.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+			const size_t read = static_cast<size_t>(source.gcount());
+
+			size_t start = 0;
+			for (size_t i = 0; i < read; ++i)
+			{
+				const std::uintmax_t size = chunk.size() + (i - start) + 1;
+				if (size < minSize)
+				{
+					continue;
+				}
+
+				hash = (hash << 1) + GearTable[static_cast<uint8>(buffer[i])];
+				if ((hash >> boundaryShift) == 0 || size >= maxSize)
+				{
+					chunk.insert(chunk.end(), buffer.begin() + start, buffer.begin() + i + 1);
+					start = i + 1;
+					emit();
+				}
+			}
+
+			chunk.insert(chunk.end(), buffer.begin() + start, buffer.begin() + read);
+		}
+
+		if (!chunk.empty())
+		{
+			emit();
+		}
+
+		return chunks;
+	}
+
+	std::string getContentChunkPath(const SHA1Hash &sha1, bool isZLibCompressed)
+	{
+		std::ostringstream path;
+		path << ContentChunkDirectory << '/';
+		sha1PrintHex(path, sha1);
+		if (isZLibCompressed)
+		{
+			path << ".z";
+		}
+
+		return path.str();
+	}
+}
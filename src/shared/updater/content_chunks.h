@@ -0,0 +1,51 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "base/sha1.h"
+
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace mmo::updating
+{
+	/// Default average size of content chunks used for delta updates.
+	constexpr std::uintmax_t DefaultContentChunkSize = 1024 * 1024;
+
+	/// Directory in the update source which contains all content chunks, named after their digest.
+	extern const std::string ContentChunkDirectory;
+
+
+	/// A chunk of a file which can be downloaded on its own.
+	struct ContentChunk
+	{
+		std::uintmax_t offset;
+		std::uintmax_t size;
+		SHA1Hash sha1;
+	};
+
+
+	/// Callback which receives every chunk together with its data.
+	typedef std::function<void (const ContentChunk &, const char *)> ContentChunkHandler;
+
+
+	/// Splits the contents of a stream into content defined chunks. Chunk boundaries only depend on the bytes
+	/// right in front of them, so inserting or removing data only changes the chunks around the edit. All other
+	/// chunks of a new file version can be taken from the previous version, even if their offsets changed.
+	/// @param source The stream to split, read until its end.
+	/// @param averageSize The average chunk size, which has to be a power of two. Chunks are at least a quarter
+	///        and at most four times as large.
+	/// @param handler Optional callback which receives every chunk together with its data.
+	/// @returns All chunks of the stream in order.
+	std::vector<ContentChunk> splitContentChunks(
+	    std::istream &source,
+	    std::uintmax_t averageSize,
+	    const ContentChunkHandler &handler = {}
+	);
+
+	/// Gets the path of a chunk in the update source.
+	std::string getContentChunkPath(const SHA1Hash &sha1, bool isZLibCompressed);
+}
@@ -0,0 +1,200 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#include "download_file.h"
+#include "update_source.h"
+#include "updater_progress_handler.h"
+
+#include "base/filesystem.h"
+
+#include "zstr/zstr.hpp"
+
+#include <fstream>
+#include <sstream>
+
+
+namespace mmo::updating
+{
+	std::string getPartialDownloadPath(
+	    const std::string &destination,
+	    const SHA1Hash &sha1
+	)
+	{
+		std::ostringstream path;
+		path << destination << '.';
+		sha1PrintHex(path, sha1);
+		path << ".download";
+		return path.str();
+	}
+
+	void downloadFile(
+	    const UpdateParameters &parameters,
+	    const std::string &source,
+	    const std::string &fileName,
+	    std::uintmax_t size
+	)
+	{
+		std::uintmax_t loaded = 0;
+
+		std::error_code error;
+		const auto existingSize = std::filesystem::file_size(fileName, error);
+		if (!error && existingSize <= size)
+		{
+			loaded = existingSize;
+		}
+
+		if (loaded == size && !error)
+		{
+			return;
+		}
+
+		const auto sourceFile = parameters.source->readFile(source, loaded);
+		checkExpectedFileSize(source, size - loaded, sourceFile);
+
+		std::ofstream sinkFile(
+		    fileName,
+		    std::ios::binary | (loaded > 0 ? std::ios::app : std::ios::trunc));
+		if (!sinkFile)
+		{
+			throw std::runtime_error("Could not open output file " + fileName);
+		}
+
+		parameters.progressHandler.updateDownload(source, size, loaded);
+
+		char buffer[1024 * 16];
+		for (;;)
+		{
+			sourceFile.content->read(buffer, sizeof(buffer));
+
+			const auto readSize = static_cast<std::uintmax_t>(sourceFile.content->gcount());
+			if ((loaded + readSize) > size)
+			{
+				throw std::runtime_error(source + ": Received more than expected");
+			}
+
+			sinkFile.write(buffer, static_cast<std::streamsize>(readSize));
+			loaded += readSize;
+
+			parameters.progressHandler.updateDownload(source, size, loaded);
+
+			if (!*sourceFile.content)
+			{
+				break;
+			}
+		}
+
+		sinkFile.flush();
+		if (!sinkFile)
+		{
+			throw std::runtime_error("Could not write output file " + fileName);
+		}
+
+		// The partial download is kept, so the next attempt continues where this one stopped
+		if (loaded != size)
+		{
+			throw std::runtime_error(source + ": Received incomplete file");
+		}
+	}
+
+	void installDownloadedFile(
+	    const UpdateParameters &parameters,
+	    const std::string &name,
+	    const std::string &downloadedFileName,
+	    const std::string &destination,
+	    const std::string &compression,
+	    std::uintmax_t originalSize,
+	    const SHA1Hash &sha1
+	)
+	{
+		bool doZLibUncompress = false;
+		if (compression == "zlib")
+		{
+			doZLibUncompress = true;
+		}
+		else if (!compression.empty())
+		{
+			throw std::runtime_error(
+			    "Unsupported compression type " + compression);
+		}
+
+		const std::string temporaryFileName = destination + ".patch";
+
+		HashGeneratorSha1 digest;
+		std::uintmax_t written = 0;
+		bool isDamaged = false;
+
+		try
+		{
+			std::ifstream downloadedFile(downloadedFileName, std::ios::binary);
+			if (!downloadedFile)
+			{
+				throw std::runtime_error("Could not open downloaded file " + downloadedFileName);
+			}
+
+			std::ofstream sinkFile(temporaryFileName, std::ios::binary | std::ios::trunc);
+			if (!sinkFile)
+			{
+				throw std::runtime_error("Could not open output file " + temporaryFileName);
+			}
+
+			std::unique_ptr<std::istream> source =
+				doZLibUncompress ?
+					std::make_unique<zstr::istream>(downloadedFile) :
+					std::make_unique<std::istream>(downloadedFile.rdbuf());
+
+			parameters.progressHandler.updateFile(name, originalSize, written);
+
+			char buffer[1024 * 16];
+			for (;;)
+			{
+				source->read(buffer, sizeof(buffer));
+
+				const auto readSize = static_cast<std::uintmax_t>(source->gcount());
+				if ((written + readSize) > originalSize)
+				{
+					isDamaged = true;
+					break;
+				}
+
+				sinkFile.write(buffer, static_cast<std::streamsize>(readSize));
+				digest.update(buffer, static_cast<size_t>(readSize));
+				written += readSize;
+
+				parameters.progressHandler.updateFile(name, originalSize, written);
+
+				if (!*source)
+				{
+					break;
+				}
+			}
+
+			sinkFile.flush();
+			if (!sinkFile)
+			{
+				throw std::runtime_error("Could not write output file " + temporaryFileName);
+			}
+		}
+		catch (const zstr::Exception &)
+		{
+			isDamaged = true;
+		}
+		catch (...)
+		{
+			std::error_code error;
+			std::filesystem::remove(temporaryFileName, error);
+			throw;
+		}
+
+		if (isDamaged ||
+		    written != originalSize ||
+		    digest.finalize() != sha1)
+		{
+			// A damaged download can't be resumed, so the next attempt starts from scratch
+			std::filesystem::remove(temporaryFileName);
+			std::filesystem::remove(downloadedFileName);
+			throw std::runtime_error(name + ": Downloaded file digest mismatch");
+		}
+
+		std::filesystem::rename(temporaryFileName, destination);
+		std::filesystem::remove(downloadedFileName);
+	}
+}
@@ -0,0 +1,46 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#pragma once
+
+#include "update_parameters.h"
+
+#include "base/sha1.h"
+
+#include <cstdint>
+#include <string>
+
+
+namespace mmo::updating
+{
+	/// Returns the local file a download is written to. It is kept when an update is interrupted, so that the next
+	/// attempt only requests the missing bytes. The name contains the expected digest, so a partial download is never
+	/// continued with a different version of the file.
+	std::string getPartialDownloadPath(
+	    const std::string &destination,
+	    const SHA1Hash &sha1
+	);
+
+	/// Downloads a file of the update source to a local file. If the local file already contains the beginning of
+	/// the download, only the remaining bytes are requested. Does nothing if the download is already complete.
+	/// @param source Path of the file in the update source.
+	/// @param fileName Local file which receives the download.
+	/// @param size Expected size of the download.
+	void downloadFile(
+	    const UpdateParameters &parameters,
+	    const std::string &source,
+	    const std::string &fileName,
+	    std::uintmax_t size
+	);
+
+	/// Decompresses a downloaded file and replaces the destination with it if its size and digest match. The
+	/// downloaded file is removed afterwards, or if it turned out to be damaged.
+	void installDownloadedFile(
+	    const UpdateParameters &parameters,
+	    const std::string &name,
+	    const std::string &downloadedFileName,
+	    const std::string &destination,
+	    const std::string &compression,
+	    std::uintmax_t originalSize,
+	    const SHA1Hash &sha1
+	);
+}
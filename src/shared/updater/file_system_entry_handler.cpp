@@ -1,10 +1,11 @@
 // Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
 
 #include "file_system_entry_handler.h"
+#include "apply_content_chunks.h"
 #include "prepare_parameters.h"
 #include "prepare_progress_handler.h"
 #include "update_source.h"
-#include "copy_with_progress.h"
+#include "download_file.h"
 #include "parse_directory_entries.h"
 #include "hpak2_entry_handler.h"
 #include "base/filesystem.h"
@@ -24,7 +25,7 @@ namespace mmo::updating
 		    (type == "hpak2" && parameters.doUnpackArchives))
 		{
 			std::filesystem::create_directories(destination);
-			return parseDirectoryEntries(
+			auto update = parseDirectoryEntries(
 			           parameters,
 			           listProperties,
 			           source,
@@ -32,6 +33,9 @@ namespace mmo::updating
 			           entries,
 			           *this
 			       );
+
+			removeStaleDownloads(destination);
+			return update;
 		}
 
 		if (type == "hpak2")
@@ -57,7 +61,7 @@ namespace mmo::updating
 
 	PreparedUpdate FileSystemEntryHandler::handleFile(
 	    const PrepareParameters &parameters,
-	    const sff::read::tree::Table<std::string::const_iterator> &/*entryDescription*/,
+	    const sff::read::tree::Table<std::string::const_iterator> &entryDescription,
 	    const std::string &source,
 	    const std::string &destination,
 	    std::uintmax_t originalSize,
@@ -66,6 +70,8 @@ namespace mmo::updating
 	    std::uintmax_t compressedSize
 	)
 	{
+		m_files.insert(destination);
+
 		for (;;)
 		{
 			{
@@ -92,46 +98,94 @@ namespace mmo::updating
 			}
 
 			PreparedUpdate update;
-			update.estimates.downloadSize = compressedSize;
-			update.estimates.updateSize = originalSize;
-			update.steps.push_back(PreparedUpdateStep(
-			                           destination,
-			                           [source, destination, compression, compressedSize, originalSize]
-			                           (const UpdateParameters & parameters) -> bool
-			{
-				const auto sourceFile = parameters.source->readFile(source);
-				checkExpectedFileSize(source, compressedSize, sourceFile);
 
-				bool doZLibUncompress = false;
+			// Files with content chunks are patched from the local copy, so only the chunks which changed are downloaded
+			std::uintmax_t chunkSize = 0;
+			std::vector<RemoteContentChunk> chunks;
+			if (parseContentChunks(entryDescription, chunkSize, chunks))
+			{
+				auto localChunks = indexLocalContentChunks(destination, chunkSize);
 
-				if (compression == "zlib")
+				std::uintmax_t downloadSize = 0;
+				bool isAnyChunkReused = false;
+				for (const auto &chunk : chunks)
 				{
-					doZLibUncompress = true;
-				}
-				else if (!compression.empty())
-				{
-					throw std::runtime_error(
-					    "Unsupported compression type " + compression);
+					if (localChunks.count(chunk.sha1))
+					{
+						isAnyChunkReused = true;
+					}
+					else
+					{
+						downloadSize += chunk.compressedSize;
+					}
 				}
 
-				std::ofstream sinkFile(destination, std::ios::binary);
-				if (!sinkFile)
+				if (isAnyChunkReused)
 				{
-					throw std::runtime_error("Could not open output file " + destination);
+					update.estimates.downloadSize = downloadSize;
+					update.estimates.updateSize = originalSize;
+					update.steps.push_back(PreparedUpdateStep(
+					                           destination,
+					                           [source, destination, chunks, localChunks = std::move(localChunks), compression, originalSize, sha1]
+					                           (const UpdateParameters & parameters) -> bool
+					{
+						applyContentChunks(
+						    parameters,
+						    source,
+						    destination,
+						    chunks,
+						    localChunks,
+						    compression,
+						    originalSize,
+						    sha1
+						);
+
+						return false;
+					}));
+
+					return update;
 				}
+			}
 
-				copyWithProgress(
+			const auto downloadedFileName = getPartialDownloadPath(destination, sha1);
+			m_partialDownloads.insert(downloadedFileName);
+
+			update.estimates.downloadSize = compressedSize;
+			update.estimates.updateSize = originalSize;
+			update.steps.push_back(PreparedUpdateStep(
+			                           destination,
+			                           [source, destination, downloadedFileName, compression, compressedSize, originalSize, sha1]
+			                           (const UpdateParameters & parameters) -> bool
+			{
+				// Completes the download if the fetch stage did not run or was interrupted
+				downloadFile(
 				    parameters,
-				    *sourceFile.content,
-				    sinkFile,
 				    source,
+				    downloadedFileName,
+				    compressedSize
+				);
+
+				installDownloadedFile(
+				    parameters,
+				    source,
+				    downloadedFileName,
+				    destination,
+				    compression,
 				    originalSize,
-					originalSize,
-				    doZLibUncompress
+				    sha1
 				);
 
-				//TODO: Copy step-wise
 				return false;
+			},
+			                           [source, downloadedFileName, compressedSize]
+			                           (const UpdateParameters & parameters)
+			{
+				downloadFile(
+				    parameters,
+				    source,
+				    downloadedFileName,
+				    compressedSize
+				);
 			}));
 
 			return update;
@@ -144,4 +198,47 @@ namespace mmo::updating
 	{
 		return PreparedUpdate();
 	}
+
+	void FileSystemEntryHandler::removeStaleDownloads(const std::filesystem::path &directory) const
+	{
+		static const std::string PatchSuffix = ".patch";
+		static const std::string DownloadSuffix = ".download";
+
+		// Partial downloads are named <file>.<sha1>.download
+		const size_t digestLength = 1 + 40;
+
+		const auto endsWith = [](const std::string &name, const std::string &suffix)
+		{
+			return name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+		};
+
+		std::vector<std::filesystem::path> staleFiles;
+
+		std::error_code error;
+		for (std::filesystem::directory_iterator i(directory, error), end; !error && i != end; i.increment(error))
+		{
+			const std::string name = i->path().filename().string();
+			if (endsWith(name, PatchSuffix))
+			{
+				if (m_files.count(directory / name.substr(0, name.size() - PatchSuffix.size())))
+				{
+					staleFiles.push_back(i->path());
+				}
+			}
+			else if (endsWith(name, DownloadSuffix) && name.size() > DownloadSuffix.size() + digestLength)
+			{
+				const std::string fileName = name.substr(0, name.size() - DownloadSuffix.size() - digestLength);
+				if (m_files.count(directory / fileName) && !m_partialDownloads.count(i->path()))
+				{
+					staleFiles.push_back(i->path());
+				}
+			}
+		}
+
+		// Files which can't be removed now are removed by the next update
+		for (const auto &file : staleFiles)
+		{
+			std::filesystem::remove(file, error);
+		}
+	}
 }
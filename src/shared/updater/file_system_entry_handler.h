@@ -4,6 +4,9 @@
 
 #include "file_entry_handler.h"
 
+#include <filesystem>
+#include <set>
+
 
 namespace mmo::updating
 {
@@ -29,5 +32,16 @@ namespace mmo::updating
 		) override;
 
 		virtual PreparedUpdate finish(const PrepareParameters &parameters) override;
+
+	private:
+		/// Removes the temporary files which earlier update attempts left in a directory: patched copies of its files
+		/// and partial downloads, except those of the current version of a file which still has to be downloaded.
+		void removeStaleDownloads(const std::filesystem::path &directory) const;
+
+	private:
+		/// All files handled so far.
+		std::set<std::filesystem::path> m_files;
+		/// Partial downloads which the prepared update continues.
+		std::set<std::filesystem::path> m_partialDownloads;
 	};
 }
@@ -12,7 +12,8 @@ namespace mmo::updating
 	}
 
 	UpdateSourceFile FileSystemUpdateSource::readFile(
-	    const std::string &path
+	    const std::string &path,
+	    std::uintmax_t offset
 	)
 	{
 		//TODO: filter paths with ".."
@@ -25,6 +26,11 @@ namespace mmo::updating
 			throw std::runtime_error("File not found: " + fullPath.string());
 		}
 
+		if (offset > 0)
+		{
+			file->seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+		}
+
 		//intentionally left empty
 		std::any internalData;
 		std::optional<std::uintmax_t> size;
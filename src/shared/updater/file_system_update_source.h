@@ -12,8 +12,11 @@ namespace mmo::updating
 	struct FileSystemUpdateSource : IUpdateSource
 	{
 		explicit FileSystemUpdateSource(std::filesystem::path root);
+		using IUpdateSource::readFile;
+
 		virtual UpdateSourceFile readFile(
-		    const std::string &path
+		    const std::string &path,
+		    std::uintmax_t offset
 		) override;
 
 	private:
@@ -19,30 +19,41 @@ namespace mmo::updating
 	}
 
 	UpdateSourceFile HTTPSUpdateSource::readFile(
-	    const std::string &path
+	    const std::string &path,
+	    std::uintmax_t offset
 	)
 	{
 		net::https_client::Request request;
 		request.host = m_host;
 		request.document = m_path;
 		virtual_dir::appendPath(request.document, path);
+		request.rangeBegin = offset;
 
 		auto response = net::https_client::sendRequest(
 		                    m_host,
 		                    m_port,
 		                    request);
 
-		if (response.status != net::https_client::Response::Ok)
+		if (response.status != net::https_client::Response::Ok &&
+		    (offset == 0 || response.status != net::https_client::Response::PartialContent))
 		{
 			throw std::runtime_error(
 			    path + ": HTTP response " +
 			    std::to_string(response.status));
 		}
 
-		return UpdateSourceFile(
-		           response.getInternalData(),
-		           std::move(response.body),
-		           response.bodySize
-		       );
+		UpdateSourceFile file(
+		    response.getInternalData(),
+		    std::move(response.body),
+		    response.bodySize
+		);
+
+		// Servers without support for range requests send the whole file
+		if (offset > 0 && response.status == net::https_client::Response::Ok)
+		{
+			skipContent(path, offset, file);
+		}
+
+		return file;
 	}
 }
@@ -16,8 +16,11 @@ namespace mmo::updating
 		    std::string path
 		);
 
+		using IUpdateSource::readFile;
+
 		virtual UpdateSourceFile readFile(
-		    const std::string &path
+		    const std::string &path,
+		    std::uintmax_t offset
 		) override;
 
 	private:
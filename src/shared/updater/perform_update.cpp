@@ -0,0 +1,296 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#include "perform_update.h"
+#include "prepared_update.h"
+#include "update_parameters.h"
+#include "update_source.h"
+#include "updater_progress_handler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+
+
+namespace mmo::updating
+{
+	namespace
+	{
+		/// Forwards to the update source of the caller, which stays the owner of it.
+		struct SharedUpdateSource final : IUpdateSource
+		{
+			explicit SharedUpdateSource(IUpdateSource &source)
+				: m_source(source)
+			{
+			}
+
+			using IUpdateSource::readFile;
+
+			UpdateSourceFile readFile(
+			    const std::string &path,
+			    std::uintmax_t offset
+			) override
+			{
+				return m_source.readFile(path, offset);
+			}
+
+		private:
+
+			IUpdateSource &m_source;
+		};
+
+
+		/// Forwards the progress of single files to the handler of the caller and sums it up for the whole update.
+		struct AggregatingProgressHandler final : IUpdaterProgressHandler
+		{
+			AggregatingProgressHandler(
+			    IUpdaterProgressHandler &handler,
+			    const std::function<void (const UpdateProgress &)> &report,
+			    const UpdateProgress &progress)
+				: m_handler(handler)
+				, m_report(report)
+				, m_progress(progress)
+			{
+			}
+
+			void updateFile(const std::string &name, std::uintmax_t size, std::uintmax_t loaded) override
+			{
+				m_handler.updateFile(name, size, loaded);
+
+				std::scoped_lock lock{ m_mutex };
+				add(m_updatedFiles, m_progress.updatedBytes, name, size, loaded);
+			}
+
+			void updateDownload(const std::string &name, std::uintmax_t size, std::uintmax_t loaded) override
+			{
+				m_handler.updateDownload(name, size, loaded);
+
+				std::scoped_lock lock{ m_mutex };
+				add(m_downloadedFiles, m_progress.downloadedBytes, name, size, loaded);
+			}
+
+			void completeStep()
+			{
+				std::scoped_lock lock{ m_mutex };
+				++m_progress.completedSteps;
+				report();
+			}
+
+		private:
+
+			/// Adds the bytes which have been loaded since the previous report of a file.
+			void add(
+			    std::map<std::string, std::uintmax_t> &files,
+			    std::uintmax_t &total,
+			    const std::string &name,
+			    std::uintmax_t size,
+			    std::uintmax_t loaded)
+			{
+				auto &previous = files[name];
+				if (loaded > previous)
+				{
+					total += loaded - previous;
+					previous = loaded;
+				}
+
+				if (loaded >= size)
+				{
+					files.erase(name);
+				}
+
+				report();
+			}
+
+			void report()
+			{
+				if (m_report)
+				{
+					m_report(m_progress);
+				}
+			}
+
+		private:
+
+			IUpdaterProgressHandler &m_handler;
+			const std::function<void (const UpdateProgress &)> &m_report;
+			std::mutex m_mutex;
+			UpdateProgress m_progress;
+			std::map<std::string, std::uintmax_t> m_downloadedFiles;
+			std::map<std::string, std::uintmax_t> m_updatedFiles;
+		};
+	}
+
+
+	bool performUpdate(
+	    const PreparedUpdate &update,
+	    const UpdateParameters &parameters,
+	    const PerformUpdateOptions &options
+	)
+	{
+		const auto &steps = update.steps;
+		if (steps.empty())
+		{
+			return true;
+		}
+
+		UpdateProgress initialProgress;
+		initialProgress.downloadSize = update.estimates.downloadSize;
+		initialProgress.updateSize = update.estimates.updateSize;
+		initialProgress.stepCount = steps.size();
+
+		AggregatingProgressHandler progressHandler(parameters.progressHandler, options.progress, initialProgress);
+		const UpdateParameters stepParameters(
+		    std::make_unique<SharedUpdateSource>(*parameters.source),
+		    parameters.doUnpackArchives,
+		    progressHandler
+		);
+
+		const size_t fetchThreadCount = std::clamp<size_t>(options.fetchConcurrency, 1, steps.size());
+		const size_t applyThreadCount = std::clamp<size_t>(options.applyConcurrency, 1, steps.size());
+
+		std::mutex mutex;
+		std::condition_variable fetchedCondition;
+		std::deque<size_t> fetchedSteps;
+		size_t runningFetchThreads = fetchThreadCount;
+		bool isStopped = false;
+		bool isCancelled = false;
+		std::exception_ptr error;
+		std::atomic<size_t> nextStep { 0 };
+
+		const auto stop = [&](std::exception_ptr stepError)
+		{
+			std::scoped_lock lock{ mutex };
+			if (stepError && !error)
+			{
+				error = stepError;
+			}
+			else if (!stepError)
+			{
+				isCancelled = true;
+			}
+
+			isStopped = true;
+			fetchedCondition.notify_all();
+		};
+
+		const auto shouldStop = [&]() -> bool
+		{
+			if (options.isCancelled && options.isCancelled())
+			{
+				stop(nullptr);
+				return true;
+			}
+
+			std::scoped_lock lock{ mutex };
+			return isStopped;
+		};
+
+		const auto runStep = [&](const PreparedUpdateStep &step)
+		{
+			while (step.step(stepParameters))
+			{
+				if (shouldStop())
+				{
+					return;
+				}
+			}
+
+			progressHandler.completeStep();
+		};
+
+		const auto fetchSteps = [&]()
+		{
+			while (!shouldStop())
+			{
+				const size_t index = nextStep++;
+				if (index >= steps.size())
+				{
+					break;
+				}
+
+				const auto &step = steps[index];
+				try
+				{
+					if (!step.fetch)
+					{
+						runStep(step);
+						continue;
+					}
+
+					step.fetch(stepParameters);
+
+					std::scoped_lock lock{ mutex };
+					fetchedSteps.push_back(index);
+					fetchedCondition.notify_one();
+				}
+				catch (...)
+				{
+					stop(std::current_exception());
+				}
+			}
+
+			std::scoped_lock lock{ mutex };
+			if (--runningFetchThreads == 0)
+			{
+				fetchedCondition.notify_all();
+			}
+		};
+
+		const auto applySteps = [&]()
+		{
+			for (;;)
+			{
+				size_t index;
+				{
+					std::unique_lock lock{ mutex };
+					fetchedCondition.wait(lock, [&]()
+					{
+						return isStopped || !fetchedSteps.empty() || runningFetchThreads == 0;
+					});
+
+					if (isStopped || fetchedSteps.empty())
+					{
+						break;
+					}
+
+					index = fetchedSteps.front();
+					fetchedSteps.pop_front();
+				}
+
+				if (shouldStop())
+				{
+					break;
+				}
+
+				try
+				{
+					runStep(steps[index]);
+				}
+				catch (...)
+				{
+					stop(std::current_exception());
+				}
+			}
+		};
+
+		std::vector<std::thread> threads;
+		threads.reserve(fetchThreadCount + applyThreadCount);
+		std::generate_n(std::back_inserter(threads), fetchThreadCount, [&fetchSteps]() { return std::thread(fetchSteps); });
+		std::generate_n(std::back_inserter(threads), applyThreadCount, [&applySteps]() { return std::thread(applySteps); });
+
+		for (auto &thread : threads)
+		{
+			thread.join();
+		}
+
+		if (error)
+		{
+			std::rethrow_exception(error);
+		}
+
+		return !isCancelled;
+	}
+}
@@ -0,0 +1,56 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+
+namespace mmo::updating
+{
+	struct PreparedUpdate;
+	struct UpdateParameters;
+
+
+	/// Progress of a whole update.
+	struct UpdateProgress
+	{
+		/// Bytes received from the update source.
+		std::uintmax_t downloadedBytes = 0;
+		/// Estimated number of bytes which have to be received.
+		std::uintmax_t downloadSize = 0;
+		/// Bytes written to the updated files.
+		std::uintmax_t updatedBytes = 0;
+		/// Estimated number of bytes which have to be written.
+		std::uintmax_t updateSize = 0;
+		size_t completedSteps = 0;
+		size_t stepCount = 0;
+	};
+
+
+	struct PerformUpdateOptions
+	{
+		/// Maximum number of files which are downloaded at the same time.
+		size_t fetchConcurrency = 4;
+		/// Number of threads which verify, decompress and write files which have been downloaded.
+		size_t applyConcurrency = 2;
+		/// Called whenever the update made progress. Calls are serialized, but come from the worker threads.
+		std::function<void (const UpdateProgress &)> progress;
+		/// Polled by the worker threads. Returning true stops the update after the steps which are currently running.
+		std::function<bool ()> isCancelled;
+	};
+
+
+	/// Performs all steps of a prepared update. Steps with a fetch stage are downloaded by a bounded number of
+	/// fetching threads and handed to the applying threads afterwards, so downloading overlaps with verifying and
+	/// writing. Steps without a fetch stage run on the fetching threads, as they download as well.
+	/// Partial downloads are kept if the update fails or is cancelled, so the next attempt resumes them.
+	/// @returns false if the update was cancelled.
+	/// @throws The first error of any step, after all running steps finished.
+	bool performUpdate(
+	    const PreparedUpdate &update,
+	    const UpdateParameters &parameters,
+	    const PerformUpdateOptions &options
+	);
+}
@@ -13,6 +13,13 @@ namespace mmo::updating
 	{
 	}
 
+	PreparedUpdateStep::PreparedUpdateStep(std::string destinationPath, StepFunction step, FetchFunction fetch)
+		: destinationPath(std::move(destinationPath))
+		, step(std::move(step))
+		, fetch(std::move(fetch))
+	{
+	}
+
 
 	PreparedUpdate::Estimates::Estimates()
 		: downloadSize(0)
@@ -15,14 +15,19 @@ namespace mmo::updating
 	struct PreparedUpdateStep
 	{
 		typedef std::function<bool (const UpdateParameters &)> StepFunction;
+		typedef std::function<void (const UpdateParameters &)> FetchFunction;
 
 
 		std::string destinationPath;
 		StepFunction step;
+		/// Optional download stage of the step, which can run ahead of the step itself, so that downloading overlaps
+		/// with verifying and writing other files. The step still works on its own if this was not called before.
+		FetchFunction fetch;
 
 
 		PreparedUpdateStep();
 		PreparedUpdateStep(std::string destinationPath, StepFunction step);
+		PreparedUpdateStep(std::string destinationPath, StepFunction step, FetchFunction fetch);
 		//TODO: move operations
 	};
 
@@ -10,8 +10,19 @@ namespace mmo::updating
 	struct IUpdateSource
 	{
 		virtual ~IUpdateSource() = default;
-		virtual UpdateSourceFile readFile(
+
+		UpdateSourceFile readFile(
 		    const std::string &path
+		)
+		{
+			return readFile(path, 0);
+		}
+
+		/// Reads a file starting at the given byte offset, which is used to resume interrupted downloads.
+		/// The size of the returned file is the number of remaining bytes, if known.
+		virtual UpdateSourceFile readFile(
+		    const std::string &path,
+		    std::uintmax_t offset
 		) = 0;
 	};
 }
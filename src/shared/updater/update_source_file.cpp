@@ -2,6 +2,9 @@
 
 #include "update_source_file.h"
 
+#include <algorithm>
+#include <stdexcept>
+
 
 namespace mmo::updating
 {
@@ -54,4 +57,39 @@ namespace mmo::updating
 			    std::to_string(*found.size));
 		}
 	}
+
+	void skipContent(
+	    const std::string &fileName,
+	    std::uintmax_t offset,
+	    UpdateSourceFile &file
+	)
+	{
+		if (file.size &&
+		        *file.size < offset)
+		{
+			throw std::runtime_error(
+			    fileName + ": Can not skip " +
+			    std::to_string(offset) +
+			    " bytes of " +
+			    std::to_string(*file.size));
+		}
+
+		std::uintmax_t skipped = 0;
+		while (skipped < offset && *file.content)
+		{
+			const auto count = static_cast<std::streamsize>(std::min<std::uintmax_t>(offset - skipped, 64 * 1024));
+			file.content->ignore(count);
+			skipped += static_cast<std::uintmax_t>(file.content->gcount());
+		}
+
+		if (skipped != offset)
+		{
+			throw std::runtime_error(fileName + ": File ended before offset " + std::to_string(offset));
+		}
+
+		if (file.size)
+		{
+			*file.size -= offset;
+		}
+	}
 }
@@ -35,4 +35,11 @@ namespace mmo::updating
 	    std::uintmax_t expected,
 	    const UpdateSourceFile &found
 	);
+
+	/// Skips the first bytes of a file, for sources which can't start reading at an offset.
+	void skipContent(
+	    const std::string &fileName,
+	    std::uintmax_t offset,
+	    UpdateSourceFile &file
+	);
 }
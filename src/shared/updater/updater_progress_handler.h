@@ -11,5 +11,7 @@ namespace mmo::updating
 	{
 		virtual ~IUpdaterProgressHandler() = default;
 		virtual void updateFile(const std::string &name, std::uintmax_t size, std::uintmax_t loaded) = 0;
+		/// Reports the progress of a download which is installed by a later call of updateFile.
+		virtual void updateDownload(const std::string &name, std::uintmax_t size, std::uintmax_t loaded) { }
 	};
 }
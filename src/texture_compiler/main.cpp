@@ -0,0 +1,397 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include "base/filesystem.h"
+#include "base/job_system.h"
+#include "base/sha1.h"
+#include "base/typedefs.h"
+#include "binary_io/stream_sink.h"
+#include "binary_io/string_sink.h"
+#include "log/default_log_levels.h"
+#include "log/log_std_stream.h"
+
+#include "cxxopts/cxxopts.hpp"
+
+#include "texture_compilation/texture_compiler.h"
+
+namespace mmo
+{
+	namespace
+	{
+		/// Name of the file in the output directory which remembers the content hashes of all compiled textures.
+		const String ManifestFileName = ".texture_manifest";
+
+		/// Increment whenever the generated output changes, so that all textures are compiled again.
+		constexpr uint32 CompilerVersion = 1;
+
+		/// Maps relative source paths to the hash of the source file and compiler settings they were compiled with.
+		typedef std::map<String, SHA1Hash> Manifest;
+
+		/// Settings which are applied to all textures of a directory.
+		struct CompileSettings
+		{
+			TextureUsage usage = TextureUsage::Color;
+			bool compress = false;
+		};
+
+		Manifest LoadManifest(const std::filesystem::path& path)
+		{
+			Manifest manifest;
+
+			std::ifstream file(path);
+			String line;
+			while (std::getline(file, line))
+			{
+				// <40 hex digits hash> <relative path>
+				if (line.size() < 42 || line[40] != ' ')
+				{
+					continue;
+				}
+
+				String hashString = line.substr(0, 40);
+				bool error = false;
+				const SHA1Hash hash = sha1ParseHex(hashString, &error);
+				if (!error)
+				{
+					manifest[line.substr(41)] = hash;
+				}
+			}
+
+			return manifest;
+		}
+
+		bool SaveManifest(const std::filesystem::path& path, const Manifest& manifest)
+		{
+			std::ofstream file(path, std::ios::out | std::ios::trunc);
+			if (!file)
+			{
+				return false;
+			}
+
+			for (const auto& [relativePath, hash] : manifest)
+			{
+				sha1PrintHex(file, hash);
+				file << ' ' << relativePath << '\n';
+			}
+
+			return static_cast<bool>(file);
+		}
+
+		/// Hashes the contents of a source file together with everything else that affects the compiled texture.
+		bool HashSource(const std::filesystem::path& path, const CompileSettings& settings, SHA1Hash& hash)
+		{
+			std::ifstream file(path, std::ios::in | std::ios::binary);
+			if (!file)
+			{
+				return false;
+			}
+
+			std::ostringstream content;
+			content << file.rdbuf();
+			const String buffer = content.str();
+
+			HashGeneratorSha1 generator;
+			generator.update(buffer.data(), buffer.size());
+			generator.update(CompilerVersion);
+			generator.update(static_cast<uint8>(settings.usage));
+			generator.update(static_cast<uint8>(settings.compress));
+			hash = generator.finalize();
+			return true;
+		}
+
+		/// Collects all source images of a directory and its sub directories, ordered by path.
+		std::vector<std::filesystem::path> CollectSources(const std::filesystem::path& sourceDir)
+		{
+			std::vector<std::filesystem::path> sources;
+			for (const auto& entry : std::filesystem::recursive_directory_iterator(sourceDir))
+			{
+				if (!entry.is_regular_file())
+				{
+					continue;
+				}
+
+				String extension = entry.path().extension().string();
+				std::transform(extension.begin(), extension.end(), extension.begin(), [](const unsigned char c) { return static_cast<char>(std::tolower(c)); });
+				if (IsSupportedTextureExtension(extension))
+				{
+					sources.push_back(entry.path());
+				}
+			}
+
+			std::sort(sources.begin(), sources.end());
+			return sources;
+		}
+
+		bool LoadTexture(const std::filesystem::path& path, const CompileSettings& settings, TextureData& data)
+		{
+			int32 width, height, numChannels;
+			std::vector<uint8> rawData;
+			if (!ReadTextureData(path, width, height, numChannels, rawData))
+			{
+				return false;
+			}
+
+			return ConvertTextureData(rawData, width, height, numChannels, settings.usage, data);
+		}
+
+		bool CompileTexture(const std::filesystem::path& sourcePath, const std::filesystem::path& outputPath, const CompileSettings& settings, JobSystem& jobs)
+		{
+			TextureData data;
+			if (!LoadTexture(sourcePath, settings, data))
+			{
+				return false;
+			}
+
+			std::filesystem::create_directories(outputPath.parent_path());
+
+			std::ofstream file(outputPath, std::ios::out | std::ios::binary | std::ios::trunc);
+			if (!file)
+			{
+				ELOG("Unable to create output file " << outputPath);
+				return false;
+			}
+
+			io::StreamSink sink{ file };
+			if (!WriteTexture(sink, data, settings.compress, &jobs))
+			{
+				return false;
+			}
+
+			file.flush();
+			return static_cast<bool>(file);
+		}
+
+		/// Compiles all textures of the source directory whose content or settings changed since the last run.
+		int32 CompileDirectory(const std::filesystem::path& sourceDir, const std::filesystem::path& outputDir, const CompileSettings& settings, const bool force, JobSystem& jobs)
+		{
+			std::filesystem::create_directories(outputDir);
+
+			const std::filesystem::path manifestPath = outputDir / ManifestFileName;
+			const Manifest previous = force ? Manifest() : LoadManifest(manifestPath);
+			Manifest manifest;
+
+			size_t compiled = 0, skipped = 0, failed = 0;
+			const auto start = std::chrono::steady_clock::now();
+
+			for (const auto& sourcePath : CollectSources(sourceDir))
+			{
+				const String relativePath = std::filesystem::relative(sourcePath, sourceDir).generic_string();
+				const std::filesystem::path outputPath = (outputDir / relativePath).replace_extension(".htex");
+
+				SHA1Hash hash;
+				if (!HashSource(sourcePath, settings, hash))
+				{
+					ELOG("Unable to read source file " << sourcePath);
+					++failed;
+					continue;
+				}
+
+				if (const auto it = previous.find(relativePath); it != previous.end() && it->second == hash && std::filesystem::exists(outputPath))
+				{
+					manifest[relativePath] = hash;
+					++skipped;
+					continue;
+				}
+
+				ILOG("Compiling " << relativePath << "...");
+				if (!CompileTexture(sourcePath, outputPath, settings, jobs))
+				{
+					ELOG("Failed to compile " << relativePath);
+					++failed;
+					continue;
+				}
+
+				manifest[relativePath] = hash;
+				++compiled;
+			}
+
+			if (!SaveManifest(manifestPath, manifest))
+			{
+				ELOG("Unable to save manifest " << manifestPath);
+				return 1;
+			}
+
+			const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+			ILOG("Compiled " << compiled << " textures, skipped " << skipped << " unchanged textures, " << failed << " failed (" << duration.count() << " ms)");
+
+			return failed == 0 ? 0 : 1;
+		}
+
+		/// Compresses all textures of the source directory in memory, once on the calling thread only and once using
+		///	the job system, and reports the throughput of both.
+		int32 RunBenchmark(const std::filesystem::path& sourceDir, const CompileSettings& settings, JobSystem& jobs)
+		{
+			std::vector<TextureData> textures;
+			uint64 texelCount = 0;
+			for (const auto& sourcePath : CollectSources(sourceDir))
+			{
+				TextureData data;
+				if (LoadTexture(sourcePath, settings, data))
+				{
+					texelCount += static_cast<uint64>(data.width) * data.height;
+					textures.push_back(std::move(data));
+				}
+			}
+
+			if (textures.empty())
+			{
+				ELOG("No textures found in " << sourceDir);
+				return 1;
+			}
+
+			const auto measure = [&textures, &settings](JobSystem* jobSystem)
+			{
+				String buffer;
+				const auto start = std::chrono::steady_clock::now();
+				for (const auto& data : textures)
+				{
+					buffer.clear();
+					io::StringSink sink{ buffer };
+					WriteTexture(sink, data, settings.compress, jobSystem);
+				}
+
+				return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			};
+
+			// Warm up caches and allocators, so that the first measurement isn't penalized
+			measure(&jobs);
+
+			const double serialSeconds = measure(nullptr);
+			const double parallelSeconds = measure(&jobs);
+
+			const double megaTexels = static_cast<double>(texelCount) / 1000000.0;
+			std::cout << "Textures:  " << textures.size() << " (" << megaTexels << " MTexels)\n";
+			std::cout << "Serial:    " << serialSeconds << " s, " << megaTexels / serialSeconds << " MTexels/s\n";
+			std::cout << "Parallel:  " << parallelSeconds << " s, " << megaTexels / parallelSeconds << " MTexels/s (" << (jobs.GetWorkerCount() + 1) << " threads)\n";
+			std::cout << "Speedup:   " << serialSeconds / parallelSeconds << "x\n";
+			return 0;
+		}
+	}
+}
+
+/// Entry point of the texture compiler console tool.
+///	@param argc The number of command line arguments.
+///	@param argv The command line arguments.
+///	@return 0 on success, anything else on error.
+int main(int argc, char* argv[])
+{
+	using namespace ::mmo;
+
+	static const std::string VersionStr = "MMORPG Texture Compiler 1.0";
+
+	auto logOptions = g_DefaultConsoleLogOptions;
+
+	// Add cout to the list of log output streams and make logging thread safe, so we don't write garbage to the console window
+	std::mutex coutLogMutex;
+	connection logConnection = g_DefaultLog.signal().connect([&coutLogMutex, &logOptions](const LogEntry& entry) {
+		std::scoped_lock lock{ coutLogMutex };
+		printLogEntry(std::cout, entry, logOptions);
+		});
+
+	// Paramaters parsed out of command line options
+	std::string sourceDir, outputDir;
+	std::string usage = "color";
+	size_t threadCount = std::thread::hardware_concurrency();
+
+	// Build command line options
+	cxxopts::Options options(VersionStr + ", available options");
+	options.add_options()
+		("h,help", "Produce help message")
+		("v,version", "Display the application's name and version")
+		("s,source", "A directory containing the source images", cxxopts::value(sourceDir))
+		("o,output", "Where to put the compiled textures", cxxopts::value(outputDir))
+		("u,usage", "Texture usage: 'color', 'normal' or 'grayscale'", cxxopts::value(usage))
+		("c,compress", "Apply block compression")
+		("j,threads", "Number of threads used to compress textures", cxxopts::value(threadCount))
+		("f,force", "Compile all textures, even if they did not change")
+		("b,benchmark", "Measure the compression throughput of the source textures without writing any output")
+		;
+
+	// Support positional arguments
+	options.parse_positional({ "source", "output" });
+
+	try
+	{
+		// Parse command line options
+		auto results = options.parse(argc, argv);
+
+		if (results.count("version"))
+		{
+			std::cerr << VersionStr << '\n';
+		}
+
+		if (results.count("help"))
+		{
+			std::cerr << options.help() << "\n";
+			return 0;
+		}
+
+		CompileSettings settings;
+		settings.compress = results.count("compress") > 0;
+		if (usage == "color")
+		{
+			settings.usage = TextureUsage::Color;
+		}
+		else if (usage == "normal")
+		{
+			settings.usage = TextureUsage::NormalMap;
+		}
+		else if (usage == "grayscale")
+		{
+			settings.usage = TextureUsage::Grayscale;
+		}
+		else
+		{
+			std::cerr
+				<< "Unknown texture usage '" << usage << "'\n"
+				<< "Use 'color', 'normal' or 'grayscale'\n";
+			return 1;
+		}
+
+		if (sourceDir.empty() || !std::filesystem::is_directory(sourceDir))
+		{
+			std::cerr << "Source directory '" << sourceDir << "' does not exist\n";
+			return 1;
+		}
+
+		// The calling thread works on the jobs as well
+		JobSystem jobs(std::max<size_t>(threadCount, 1) - 1);
+
+		try
+		{
+			if (results.count("benchmark"))
+			{
+				// Texture compilation is logged verbosely, which would distort the results
+				logConnection.disconnect();
+				return RunBenchmark(sourceDir, settings, jobs);
+			}
+
+			if (outputDir.empty())
+			{
+				std::cerr << "No output directory provided\n";
+				return 1;
+			}
+
+			return CompileDirectory(sourceDir, outputDir, settings, results.count("force") > 0, jobs);
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << e.what() << '\n';
+			return 1;
+		}
+	}
+	catch (const cxxopts::OptionException& e)
+	{
+		std::cerr << e.what() << "\n";
+		return 1;
+	}
+}
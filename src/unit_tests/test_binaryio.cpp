@@ -2,14 +2,24 @@
 
 #include "catch.hpp"
 #include "memory_source.h"
+#include "reader.h"
+#include "string_sink.h"
 #include "vector_sink.h"
 #include "base/typedefs.h"
+#include "base/timer_queue.h"
 #include "writer.h"
 #include "math/aabb.h"
+#include "game/movement_info.h"
+#include "game/object_type_id.h"
+#include "game_server/objects/game_player_s.h"
+#include "proto_data/project.h"
+#include "asio/io_service.hpp"
 
 #include <vector>
 #include <cstring>
 #include <algorithm>
+#include <limits>
+#include <memory>
 
 using namespace mmo;
 
@@ -52,6 +62,75 @@ TEST_CASE("Can serialize and deserialize partial packed guid", "[binaryio]")
 	CHECK(originalGuid == deserializedGuid);
 }
 
+TEST_CASE("Variable length integers round trip and stay small for small values", "[binaryio]")
+{
+	const std::vector<uint64> values = { 0, 1, 127, 128, 300, 16383, 16384, 0xFFFFFFFF, std::numeric_limits<uint64>::max() };
+	const std::vector<size_t> expectedSizes = { 1, 1, 1, 2, 2, 2, 3, 5, 10 };
+
+	for (size_t i = 0; i < values.size(); ++i)
+	{
+		std::vector<char> buffer;
+		io::VectorSink sink{ buffer };
+		io::Writer writer{ sink };
+		writer << io::write_var_uint(values[i]);
+		CHECK(buffer.size() == expectedSizes[i]);
+
+		io::MemorySource source{ buffer };
+		io::Reader reader{ source };
+		uint64 value = 1;
+		reader >> io::read_var_uint(value);
+
+		CHECK(reader);
+		CHECK(value == values[i]);
+	}
+}
+
+TEST_CASE("Reading a variable length integer rejects values which don't fit the target type", "[binaryio]")
+{
+	std::vector<char> buffer;
+	io::VectorSink sink{ buffer };
+	io::Writer writer{ sink };
+	writer << io::write_var_uint(static_cast<uint64>(std::numeric_limits<uint32>::max()) + 1);
+
+	SECTION("Too large for uint32")
+	{
+		io::MemorySource source{ buffer };
+		io::Reader reader{ source };
+		uint32 value = 0;
+		reader >> io::read_var_uint(value);
+		CHECK_FALSE(reader);
+	}
+
+	SECTION("Fits uint64")
+	{
+		io::MemorySource source{ buffer };
+		io::Reader reader{ source };
+		uint64 value = 0;
+		reader >> io::read_var_uint(value);
+		CHECK(reader);
+		CHECK(value == 0x100000000ull);
+	}
+
+	SECTION("Overlong encodings are rejected")
+	{
+		const std::vector<char> overlong(11, static_cast<char>(0x80));
+		io::MemorySource source{ overlong };
+		io::Reader reader{ source };
+		uint64 value = 0;
+		reader >> io::read_var_uint(value);
+		CHECK_FALSE(reader);
+	}
+
+	SECTION("Truncated encodings are rejected")
+	{
+		io::MemorySource source{ buffer.data(), buffer.data() + buffer.size() - 1 };
+		io::Reader reader{ source };
+		uint64 value = 0;
+		reader >> io::read_var_uint(value);
+		CHECK_FALSE(reader);
+	}
+}
+
 
 class MockSink : public io::ISink
 {
@@ -287,3 +366,297 @@ TEST_CASE("Reader reads limited string correctly", "[binaryio]")
     REQUIRE(reader);
 }
 
+
+TEST_CASE("Plain ranges are serialized like their elements", "[binaryio]")
+{
+	const std::vector<uint32> values = { 1, 2, 0xdeadbeef, 4, 0xffffffff };
+	const std::string text = "Hello";
+
+	// Generic sinks take the element by element path
+	MockSink expected;
+	{
+		io::Writer writer(expected);
+		for (const uint32 value : values)
+		{
+			writer << io::write<uint32>(value);
+		}
+
+		writer << io::write<uint16>(text.size());
+		for (const char c : text)
+		{
+			writer << c;
+		}
+	}
+
+	std::vector<char> buffer;
+	io::VectorSink sink(buffer);
+	io::Writer writer(sink);
+	writer
+		<< io::write_range(values)
+		<< io::write_dynamic_range<uint16>(text);
+
+	CHECK(buffer == expected.buffer);
+
+	std::vector<uint32> readValues(values.size());
+	std::string readText;
+
+	io::MemorySource source(buffer);
+	io::Reader reader(source);
+	reader
+		>> io::read_range(readValues)
+		>> io::read_container<uint16>(readText);
+
+	CHECK(reader);
+	CHECK(readValues == values);
+	CHECK(readText == text);
+	CHECK(source.end());
+}
+
+TEST_CASE("Plain ranges are readable from generic sources", "[binaryio]")
+{
+	const std::vector<uint16> values = { 1, 2, 3, 4 };
+
+	std::string buffer;
+	io::StringSink sink(buffer);
+	io::Writer writer(sink);
+	writer << io::write_range(values);
+
+	MockSource source(std::vector<char>(buffer.begin(), buffer.end()));
+	io::Reader reader(source);
+
+	std::vector<uint16> readValues(values.size());
+	reader >> io::read_range(readValues);
+
+	CHECK(reader);
+	CHECK(readValues == values);
+
+	// The source is exhausted now
+	reader >> io::read_range(readValues);
+	CHECK_FALSE(reader);
+}
+
+TEST_CASE("Reading a float range rejects non-finite values", "[binaryio]")
+{
+	const std::vector<float> values = { 1.0f, std::numeric_limits<float>::quiet_NaN(), 3.0f };
+
+	std::vector<char> buffer;
+	io::VectorSink sink(buffer);
+	io::Writer writer(sink);
+	writer << io::write_range(values);
+
+	io::MemorySource source(buffer);
+	io::Reader reader(source);
+
+	std::vector<float> readValues(values.size());
+	reader >> io::read_range(readValues);
+
+	CHECK_FALSE(reader);
+}
+
+TEST_CASE("Reading a container skips elements beyond the maximum length", "[binaryio]")
+{
+	const std::vector<uint32> values = { 1, 2, 3, 4, 5 };
+
+	std::vector<char> buffer;
+	io::VectorSink sink(buffer);
+	io::Writer writer(sink);
+	writer
+		<< io::write_dynamic_range<uint8>(values)
+		<< io::write<uint32>(42);
+
+	SECTION("Elements are skipped")
+	{
+		io::MemorySource source(buffer);
+		io::Reader reader(source);
+
+		std::vector<uint32> readValues;
+		uint32 trailing = 0;
+		reader
+			>> io::read_container<uint8>(readValues, 3)
+			>> io::read<uint32>(trailing);
+
+		CHECK(reader);
+		CHECK(readValues == std::vector<uint32>{ 1, 2, 3 });
+		CHECK(trailing == 42);
+	}
+
+	SECTION("Converted elements are skipped with their serialized size")
+	{
+		io::MemorySource source(buffer);
+		io::Reader reader(source);
+
+		std::vector<uint64> readValues;
+		uint32 trailing = 0;
+		reader
+			>> io::read_converted_container<uint8, uint32>(readValues, 2)
+			>> io::read<uint32>(trailing);
+
+		CHECK(reader);
+		CHECK(readValues == std::vector<uint64>{ 1, 2 });
+		CHECK(trailing == 42);
+	}
+
+	SECTION("Truncated data fails")
+	{
+		io::MemorySource source(buffer.data(), buffer.data() + 1 + 4 * sizeof(uint32));
+		io::Reader reader(source);
+
+		std::vector<uint32> readValues;
+		reader >> io::read_container<uint8>(readValues, 3);
+
+		CHECK_FALSE(reader);
+	}
+}
+
+TEST_CASE("Benchmark object creation blocks", "[binaryio][!benchmark]")
+{
+	asio::io_service io;
+	TimerQueue timers{ io };
+	proto::Project project;
+
+	// Roughly the number of players a client sees when entering a crowded city
+	constexpr size_t playerCount = 200;
+
+	std::vector<std::shared_ptr<GamePlayerS>> players;
+	players.reserve(playerCount);
+	for (size_t i = 0; i < playerCount; ++i)
+	{
+		auto player = std::make_shared<GamePlayerS>(project, timers);
+		player->Initialize();
+		player->Set<uint64>(object_fields::Guid, i + 1);
+		players.push_back(std::move(player));
+	}
+
+	std::string buffer;
+	buffer.reserve(playerCount * (object_fields::PlayerFieldCount * sizeof(uint32) + 64));
+
+	BENCHMARK("Write creation blocks")
+	{
+		buffer.clear();
+
+		io::StringSink sink(buffer);
+		io::Writer writer(sink);
+		for (const auto& player : players)
+		{
+			player->WriteObjectUpdateBlock(writer, true);
+		}
+
+		return buffer.size();
+	};
+
+	std::vector<uint32> fields(object_fields::PlayerFieldCount);
+
+	BENCHMARK("Read creation blocks")
+	{
+		io::MemorySource source(buffer.data(), buffer.data() + buffer.size());
+		io::Reader reader(source);
+
+		for (size_t i = 0; i < playerCount; ++i)
+		{
+			uint8 typeId = 0, creation = 0;
+			uint32 flags = 0;
+			MovementInfo movementInfo;
+			reader
+				>> io::read<uint8>(typeId)
+				>> io::read<uint8>(creation)
+				>> io::read<uint32>(flags)
+				>> movementInfo
+				>> io::read_range(fields);
+		}
+
+		return static_cast<bool>(reader);
+	};
+}
+
+TEST_CASE("Benchmark mesh loading", "[binaryio][!benchmark]")
+{
+	// Vertex and index layout of a submesh chunk, see MeshDeserializer
+	constexpr uint32 vertexCount = 20000;
+	constexpr uint32 indexCount = vertexCount * 3;
+
+	std::vector<char> buffer;
+	{
+		io::VectorSink sink(buffer);
+		io::Writer writer(sink);
+
+		writer << io::write<uint32>(vertexCount);
+		for (uint32 i = 0; i < vertexCount; ++i)
+		{
+			const float f = static_cast<float>(i);
+			writer
+				<< io::write<float>(f) << io::write<float>(f) << io::write<float>(f)
+				<< io::write<uint32>(0xffffffff)
+				<< io::write<float>(0.5f) << io::write<float>(0.5f) << io::write<float>(0.0f)
+				<< io::write<float>(0.0f) << io::write<float>(1.0f) << io::write<float>(0.0f)
+				<< io::write<float>(1.0f) << io::write<float>(0.0f) << io::write<float>(0.0f)
+				<< io::write<float>(0.0f) << io::write<float>(0.0f) << io::write<float>(1.0f);
+		}
+
+		writer << io::write<uint32>(indexCount);
+		for (uint32 i = 0; i < indexCount; ++i)
+		{
+			writer << io::write<uint16>(i % vertexCount);
+		}
+	}
+
+	struct Vertex
+	{
+		Vector3 position;
+		uint32 color;
+		Vector3 normal;
+		Vector3 binormal;
+		Vector3 tangent;
+		float u, v;
+	};
+
+	std::vector<Vertex> vertices(vertexCount);
+	std::vector<uint16> indices(indexCount);
+
+	const auto readVertices = [&vertices](io::Reader& reader)
+	{
+		uint32 count = 0;
+		reader >> io::read<uint32>(count);
+		for (Vertex& vert : vertices)
+		{
+			reader
+				>> io::read<float>(vert.position.x) >> io::read<float>(vert.position.y) >> io::read<float>(vert.position.z)
+				>> io::read<uint32>(vert.color)
+				>> io::read<float>(vert.u) >> io::read<float>(vert.v) >> io::skip<float>()
+				>> io::read<float>(vert.normal.x) >> io::read<float>(vert.normal.y) >> io::read<float>(vert.normal.z)
+				>> io::read<float>(vert.binormal.x) >> io::read<float>(vert.binormal.y) >> io::read<float>(vert.binormal.z)
+				>> io::read<float>(vert.tangent.x) >> io::read<float>(vert.tangent.y) >> io::read<float>(vert.tangent.z);
+		}
+	};
+
+	BENCHMARK("Read vertices and indices element by element")
+	{
+		io::MemorySource source(buffer);
+		io::Reader reader(source);
+
+		readVertices(reader);
+
+		uint32 count = 0;
+		reader >> io::read<uint32>(count);
+		for (uint16& index : indices)
+		{
+			reader >> io::read<uint16>(index);
+		}
+
+		return static_cast<bool>(reader);
+	};
+
+	BENCHMARK("Read vertices and index range")
+	{
+		io::MemorySource source(buffer);
+		io::Reader reader(source);
+
+		readVertices(reader);
+
+		uint32 count = 0;
+		reader
+			>> io::read<uint32>(count)
+			>> io::read_range(indices);
+
+		return static_cast<bool>(reader);
+	};
+}
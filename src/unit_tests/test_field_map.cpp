@@ -188,4 +188,30 @@ TEST_CASE("SetFieldsMarkFieldsAsChanged", "[field_map]")
 
 	CHECK(fieldMap.IsFieldMarkedAsChanged(0));
 	CHECK(fieldMap.IsFieldMarkedAsChanged(1));
-}
\ No newline at end of file
+}
+
+TEST_CASE("ChangedFieldRangeSpansMultipleWords", "[field_map]")
+{
+	FieldMap<uint32> fieldMap;
+	fieldMap.Initialize(150);
+
+	CHECK_FALSE(fieldMap.HasChanges());
+	CHECK(fieldMap.GetFirstChangedField() == -1);
+	CHECK(fieldMap.GetLastChangedField() == -1);
+
+	fieldMap.SetFieldValue<uint32>(70, 1);
+	fieldMap.SetFieldValue<uint64>(130, 2);
+
+	CHECK(fieldMap.HasChanges());
+	CHECK(fieldMap.GetFirstChangedField() == 70);
+	CHECK(fieldMap.GetLastChangedField() == 131);
+	CHECK_FALSE(fieldMap.IsFieldMarkedAsChanged(69));
+	CHECK_FALSE(fieldMap.IsFieldMarkedAsChanged(200));
+
+	fieldMap.MarkAllAsChanged();
+	CHECK(fieldMap.GetFirstChangedField() == 0);
+	CHECK(fieldMap.GetLastChangedField() == 149);
+
+	fieldMap.MarkAsUnchanged();
+	CHECK_FALSE(fieldMap.HasChanges());
+}
@@ -0,0 +1,109 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "base/guid_index.h"
+
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using namespace mmo;
+
+namespace
+{
+	/// Builds guids the way the realm does: type and entry in the high bits, a counter in the low bits.
+	uint64 MakeGuid(const uint64 type, const uint64 entry, const uint64 counter)
+	{
+		return (type << 48) | (entry << 24) | counter;
+	}
+}
+
+TEST_CASE("GuidIndex finds inserted guids", "[guid_index]")
+{
+	GuidIndex index;
+	CHECK(index.IsEmpty());
+	CHECK(index.Find(1) == GuidIndex::NotFound);
+	CHECK(index.Find(0) == GuidIndex::NotFound);
+
+	index.Set(MakeGuid(1, 100, 1), 0);
+	index.Set(MakeGuid(1, 100, 2), 1);
+	index.Set(MakeGuid(4, 0, 1), 2);
+
+	CHECK(index.Size() == 3);
+	CHECK(index.Find(MakeGuid(1, 100, 1)) == 0);
+	CHECK(index.Find(MakeGuid(1, 100, 2)) == 1);
+	CHECK(index.Find(MakeGuid(4, 0, 1)) == 2);
+	CHECK_FALSE(index.Contains(MakeGuid(1, 100, 3)));
+
+	// Setting an indexed guid again only updates its index
+	index.Set(MakeGuid(1, 100, 2), 7);
+	CHECK(index.Size() == 3);
+	CHECK(index.Find(MakeGuid(1, 100, 2)) == 7);
+}
+
+TEST_CASE("GuidIndex keeps colliding guids reachable after erasing", "[guid_index]")
+{
+	GuidIndex index;
+
+	// Enough guids to force several rehashes and long probe sequences
+	for (uint32 i = 1; i <= 1000; ++i)
+	{
+		index.Set(MakeGuid(3, 42, i), i);
+	}
+
+	for (uint32 i = 1; i <= 1000; i += 3)
+	{
+		CHECK(index.Erase(MakeGuid(3, 42, i)));
+	}
+
+	CHECK_FALSE(index.Erase(MakeGuid(3, 42, 1)));
+
+	for (uint32 i = 1; i <= 1000; ++i)
+	{
+		if (i % 3 == 1)
+		{
+			CHECK_FALSE(index.Contains(MakeGuid(3, 42, i)));
+		}
+		else
+		{
+			CHECK(index.Find(MakeGuid(3, 42, i)) == i);
+		}
+	}
+
+	index.Clear();
+	CHECK(index.IsEmpty());
+	CHECK_FALSE(index.Contains(MakeGuid(3, 42, 2)));
+}
+
+TEST_CASE("GuidIndex matches std::unordered_map under random operations", "[guid_index]")
+{
+	std::mt19937_64 random{ 1234 };
+	std::uniform_int_distribution<uint64> counterDist(1, 4000);
+	std::uniform_int_distribution<uint32> operationDist(0, 2);
+
+	GuidIndex index;
+	std::unordered_map<uint64, uint32> reference;
+
+	for (uint32 step = 0; step < 20000; ++step)
+	{
+		const uint64 guid = MakeGuid(step % 4 + 1, 7, counterDist(random));
+		switch (operationDist(random))
+		{
+		case 0:
+		case 1:
+			index.Set(guid, step);
+			reference[guid] = step;
+			break;
+		default:
+			CHECK(index.Erase(guid) == (reference.erase(guid) > 0));
+			break;
+		}
+	}
+
+	REQUIRE(index.Size() == reference.size());
+	for (const auto& [guid, value] : reference)
+	{
+		CHECK(index.Find(guid) == value);
+	}
+}
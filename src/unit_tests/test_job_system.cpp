@@ -0,0 +1,73 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "base/job_system.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace mmo;
+
+TEST_CASE("JobSystem executes every job exactly once", "[job_system]")
+{
+	JobSystem jobs(3);
+	REQUIRE(jobs.GetWorkerCount() == 3);
+
+	std::vector<int> executions(1000, 0);
+	jobs.ParallelFor(executions.size(), [&executions](const size_t index)
+	{
+		++executions[index];
+	});
+
+	for (const int count : executions)
+	{
+		REQUIRE(count == 1);
+	}
+}
+
+TEST_CASE("JobSystem without workers runs jobs in order on the calling thread", "[job_system]")
+{
+	JobSystem jobs(0);
+
+	const auto caller = std::this_thread::get_id();
+	std::vector<size_t> order;
+	jobs.ParallelFor(4, [&order, caller](const size_t index)
+	{
+		CHECK(std::this_thread::get_id() == caller);
+		order.push_back(index);
+	});
+
+	CHECK(order == std::vector<size_t>{ 0, 1, 2, 3 });
+}
+
+TEST_CASE("JobSystem can be used for many consecutive dispatches", "[job_system]")
+{
+	JobSystem jobs(4);
+
+	std::atomic<size_t> total{ 0 };
+	for (size_t dispatch = 0; dispatch < 500; ++dispatch)
+	{
+		std::vector<size_t> results(dispatch % 7, 0);
+		jobs.ParallelFor(results.size(), [&results, &total](const size_t index)
+		{
+			results[index] = index + 1;
+			++total;
+		});
+
+		// All results must be written once ParallelFor returned
+		for (size_t i = 0; i < results.size(); ++i)
+		{
+			REQUIRE(results[i] == i + 1);
+		}
+	}
+
+	size_t expected = 0;
+	for (size_t dispatch = 0; dispatch < 500; ++dispatch)
+	{
+		expected += dispatch % 7;
+	}
+
+	CHECK(total == expected);
+}
@@ -0,0 +1,49 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+#include "base/lru_cache.h"
+
+#include <memory>
+#include <string>
+
+using namespace mmo;
+
+TEST_CASE("LRUCache returns cached values", "[lru_cache]")
+{
+	LRUCache<std::string, int> cache(4);
+	REQUIRE(cache.Get("a") == nullptr);
+
+	cache.Put("a", std::make_unique<int>(1));
+	REQUIRE(cache.Get("a") != nullptr);
+	CHECK(*cache.Get("a") == 1);
+
+	// Putting an existing key replaces its value
+	cache.Put("a", std::make_unique<int>(2));
+	CHECK(*cache.Get("a") == 2);
+	CHECK(cache.Size() == 1);
+
+	cache.Clear();
+	CHECK(cache.Get("a") == nullptr);
+	CHECK(cache.Size() == 0);
+}
+
+TEST_CASE("LRUCache evicts the least recently used entry", "[lru_cache]")
+{
+	LRUCache<int, int> cache(2);
+	cache.Put(1, std::make_unique<int>(1));
+	cache.Put(2, std::make_unique<int>(2));
+
+	// Using the first entry makes the second one the least recently used
+	REQUIRE(cache.Get(1) != nullptr);
+	cache.Put(3, std::make_unique<int>(3));
+
+	CHECK(cache.Contains(1));
+	CHECK_FALSE(cache.Contains(2));
+	CHECK(cache.Contains(3));
+	CHECK(cache.Size() == 2);
+
+	// Shrinking the cache evicts until it fits
+	cache.SetMaxSize(1);
+	CHECK(cache.Size() == 1);
+	CHECK(cache.Contains(3));
+}
@@ -0,0 +1,171 @@
+// Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "base/small_object_pool.h"
+#include "base/countdown.h"
+#include "base/timer_queue.h"
+#include "asio/io_service.hpp"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+using namespace mmo;
+
+namespace
+{
+	struct SelfReferencing : std::enable_shared_from_this<SelfReferencing>
+	{
+		explicit SelfReferencing(const int value)
+			: value(value)
+		{
+		}
+
+		int value;
+	};
+
+	/// Rough stand-in for a spell cast state: some payload plus a cast and an impact countdown.
+	struct FakeCastState
+	{
+		FakeCastState(TimerQueue& timers, SmallObjectPool* pool)
+			: countdown(timers, pool)
+			, impactCountdown(timers, pool)
+		{
+		}
+
+		std::array<uint64, 24> payload {};
+		Countdown countdown;
+		Countdown impactCountdown;
+	};
+
+	/// Rough stand-in for an aura container with a single periodic effect.
+	struct FakeAura
+	{
+		FakeAura(TimerQueue& timers, SmallObjectPool* pool)
+			: expiration(timers, pool)
+			, tick(timers, pool)
+		{
+		}
+
+		std::array<uint64, 16> payload {};
+		Countdown expiration;
+		Countdown tick;
+	};
+
+	/// Simulates the allocations of one combat heavy world tick and releases everything again.
+	void SimulateCombatTick(TimerQueue& timers, SmallObjectPool* pool)
+	{
+		std::vector<std::shared_ptr<FakeCastState>> casts;
+		std::vector<std::shared_ptr<FakeAura>> auras;
+
+		for (int i = 0; i < 200; ++i)
+		{
+			casts.push_back(MakePooled<FakeCastState>(pool, timers, pool));
+		}
+
+		for (int i = 0; i < 100; ++i)
+		{
+			auras.push_back(MakePooled<FakeAura>(pool, timers, pool));
+		}
+	}
+}
+
+TEST_CASE("SmallObjectPool reuses released blocks", "[small_object_pool]")
+{
+	SmallObjectPool pool;
+
+	void* first = pool.Allocate(40);
+	pool.Deallocate(first, 40);
+
+	// Same size class is served from the free list
+	void* second = pool.Allocate(48);
+	CHECK(second == first);
+
+	const auto stats = pool.GetStats();
+	CHECK(stats.allocations == 2);
+	CHECK(stats.chunkAllocations == 1);
+	CHECK(stats.liveBlocks == 1);
+
+	pool.Deallocate(second, 48);
+	CHECK(pool.GetStats().liveBlocks == 0);
+}
+
+TEST_CASE("SmallObjectPool forwards large requests to the heap", "[small_object_pool]")
+{
+	SmallObjectPool pool;
+
+	void* block = pool.Allocate(SmallObjectPool::MaxBlockSize + 1);
+	REQUIRE(block != nullptr);
+	pool.Deallocate(block, SmallObjectPool::MaxBlockSize + 1);
+
+	const auto stats = pool.GetStats();
+	CHECK(stats.heapAllocations == 1);
+	CHECK(stats.chunkAllocations == 0);
+}
+
+TEST_CASE("Released pools stay alive until all objects are gone", "[small_object_pool]")
+{
+	auto pool = SmallObjectPool::Create();
+
+	auto object = MakePooled<SelfReferencing>(pool.get(), 42);
+	auto other = MakePooled<SelfReferencing>(pool.get(), 43);
+	CHECK(object->shared_from_this() == object);
+	CHECK(pool->GetStats().liveBlocks == 2);
+
+	// Simulates the world instance going away while a timer callback still holds the objects. The pool is
+	// destroyed with the last block, which is verified by leak and address sanitizers.
+	pool.reset();
+	CHECK(object->value == 42);
+	CHECK(other->value == 43);
+
+	object.reset();
+	CHECK(other->shared_from_this() == other);
+	other.reset();
+}
+
+TEST_CASE("MakePooled falls back to the heap without a pool", "[small_object_pool]")
+{
+	const auto object = MakePooled<SelfReferencing>(nullptr, 7);
+	REQUIRE(object);
+	CHECK(object->value == 7);
+}
+
+TEST_CASE("Pooled combat objects stop allocating chunks after warm up", "[small_object_pool]")
+{
+	asio::io_service io;
+	TimerQueue timers{ io };
+	SmallObjectPool pool;
+
+	SimulateCombatTick(timers, &pool);
+	const auto warm = pool.GetStats();
+
+	// Without the pool every tick performs 900 heap allocations: 300 casts and auras plus 600 countdown states
+	for (int tick = 0; tick < 10; ++tick)
+	{
+		SimulateCombatTick(timers, &pool);
+	}
+
+	const auto steady = pool.GetStats();
+	CHECK(steady.chunkAllocations == warm.chunkAllocations);
+	CHECK(steady.heapAllocations == 0);
+	CHECK(steady.allocations - warm.allocations == 10 * 900);
+	CHECK(steady.liveBlocks == 0);
+}
+
+TEST_CASE("Benchmark combat object churn", "[small_object_pool][!benchmark]")
+{
+	asio::io_service io;
+	TimerQueue timers{ io };
+
+	BENCHMARK("make_shared")
+	{
+		SimulateCombatTick(timers, nullptr);
+	};
+
+	SmallObjectPool pool;
+	BENCHMARK("SmallObjectPool")
+	{
+		SimulateCombatTick(timers, &pool);
+	};
+}
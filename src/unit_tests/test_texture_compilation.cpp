@@ -0,0 +1,146 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "base/job_system.h"
+#include "binary_io/reader.h"
+#include "binary_io/string_sink.h"
+#include "binary_io/string_source.h"
+#include "tex/pre_header.h"
+#include "tex/pre_header_load.h"
+#include "tex_v1_0/header.h"
+#include "tex_v1_0/header_load.h"
+#include "texture_compilation/texture_compiler.h"
+
+using namespace mmo;
+
+namespace
+{
+	/// Creates a texture with noisy gradients, so that block compression has something to work with.
+	TextureData CreateTexture(const uint16 width, const uint16 height, const ImageFormat format)
+	{
+		const size_t channels = format == ImageFormat::R8 ? 1 : (format == ImageFormat::RG8 ? 2 : 4);
+
+		TextureData data;
+		data.width = width;
+		data.height = height;
+		data.format = format;
+		data.data.resize(static_cast<size_t>(width) * height * channels);
+
+		uint32 seed = 12345;
+		for (size_t y = 0; y < height; ++y)
+		{
+			for (size_t x = 0; x < width; ++x)
+			{
+				for (size_t c = 0; c < channels; ++c)
+				{
+					seed = seed * 1664525 + 1013904223;
+					const size_t gradient = (x * (c + 1) + y * (channels - c)) & 0xff;
+					data.data[(y * width + x) * channels + c] = static_cast<uint8>((gradient + (seed >> 28)) & 0xff);
+				}
+			}
+		}
+
+		return data;
+	}
+
+	std::string Write(const TextureData& data, const bool compress, JobSystem* jobs)
+	{
+		std::string buffer;
+		io::StringSink sink{ buffer };
+		REQUIRE(WriteTexture(sink, data, compress, jobs));
+		return buffer;
+	}
+
+	tex::v1_0::Header ReadHeader(const std::string& buffer)
+	{
+		io::StringSource source{ buffer };
+		io::Reader reader{ source };
+
+		tex::PreHeader preHeader;
+		REQUIRE(tex::loadPreHeader(preHeader, reader));
+		REQUIRE(preHeader.version == tex::Version_1_0);
+
+		tex::v1_0::Header header{ preHeader.version };
+		REQUIRE(tex::v1_0::loadHeader(header, reader));
+		return header;
+	}
+}
+
+TEST_CASE("Compressing textures in parallel produces the same output", "[texture_compilation]")
+{
+	JobSystem jobs(3);
+
+	const auto format = GENERATE(ImageFormat::RGBA, ImageFormat::RGBX, ImageFormat::R8, ImageFormat::RG8);
+	const bool compress = GENERATE(false, true);
+
+	const TextureData data = CreateTexture(512, 256, format);
+	CHECK(Write(data, compress, &jobs) == Write(data, compress, nullptr));
+}
+
+TEST_CASE("Texture mip levels are written down to 16 texels", "[texture_compilation]")
+{
+	JobSystem jobs(3);
+
+	const std::string buffer = Write(CreateTexture(256, 256, ImageFormat::RGBX), true, &jobs);
+	const tex::v1_0::Header header = ReadHeader(buffer);
+
+	CHECK(header.format == tex::v1_0::DXT1);
+	CHECK(header.hasMips);
+
+	// 256, 128, 64 and 32 texels with 8 bytes per 4x4 block
+	const uint32 expectedLengths[] = { 32768, 8192, 2048, 512 };
+	for (size_t i = 0; i < 4; ++i)
+	{
+		CHECK(header.mipmapLengths[i] == expectedLengths[i]);
+		CHECK(header.mipmapOffsets[i] + header.mipmapLengths[i] <= buffer.size());
+		if (i > 0)
+		{
+			CHECK(header.mipmapOffsets[i] == header.mipmapOffsets[i - 1] + header.mipmapLengths[i - 1]);
+		}
+	}
+
+	CHECK(header.mipmapOffsets[4] == 0);
+	CHECK(header.mipmapLengths[4] == 0);
+}
+
+TEST_CASE("Compressed mip levels which are not a multiple of 4 texels use whole blocks", "[texture_compilation]")
+{
+	const std::string buffer = Write(CreateTexture(64, 4, ImageFormat::RGBA), true, nullptr);
+	const tex::v1_0::Header header = ReadHeader(buffer);
+
+	CHECK(header.format == tex::v1_0::DXT5);
+	CHECK(header.mipmapLengths[0] == 16 * 16);
+
+	// The second level is 32x2 texels, which still needs a full row of 16 byte blocks
+	CHECK(header.mipmapLengths[1] == 8 * 16);
+	CHECK(header.mipmapOffsets[1] + header.mipmapLengths[1] == buffer.size());
+}
+
+TEST_CASE("Texture compression benchmark", "[texture_compilation][!benchmark]")
+{
+	JobSystem jobs;
+
+	const TextureData color = CreateTexture(1024, 1024, ImageFormat::RGBA);
+	const TextureData normal = CreateTexture(1024, 1024, ImageFormat::RG8);
+
+	BENCHMARK("1024x1024 DXT5 with mips, serial")
+	{
+		return Write(color, true, nullptr).size();
+	};
+
+	BENCHMARK("1024x1024 DXT5 with mips, parallel")
+	{
+		return Write(color, true, &jobs).size();
+	};
+
+	BENCHMARK("1024x1024 BC5 with mips, serial")
+	{
+		return Write(normal, true, nullptr).size();
+	};
+
+	BENCHMARK("1024x1024 BC5 with mips, parallel")
+	{
+		return Write(normal, true, &jobs).size();
+	};
+}
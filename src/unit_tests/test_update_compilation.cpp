@@ -0,0 +1,245 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "base/filesystem.h"
+#include "base/job_system.h"
+#include "update_compilation/compile_directory.h"
+#include "updater/content_chunks.h"
+#include "updater/file_system_update_source.h"
+#include "updater/prepare_parameters.h"
+#include "updater/prepare_progress_handler.h"
+#include "updater/prepare_update.h"
+#include "updater/update_parameters.h"
+#include "updater/updater_progress_handler.h"
+#include "virtual_dir/file_system_reader.h"
+#include "virtual_dir/file_system_writer.h"
+
+#include <fstream>
+#include <sstream>
+
+using namespace mmo;
+
+namespace
+{
+	struct NullProgressHandler final : updating::IPrepareProgressHandler, updating::IUpdaterProgressHandler
+	{
+		void beginCheckLocalCopy(const std::string &) override
+		{
+		}
+
+		void updateFile(const std::string &, std::uintmax_t, std::uintmax_t) override
+		{
+		}
+	};
+
+	void WriteFile(const std::filesystem::path &path, const std::string &content)
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(content.data(), static_cast<std::streamsize>(content.size()));
+	}
+
+	std::string ReadFile(const std::filesystem::path &path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		std::ostringstream content;
+		content << file.rdbuf();
+		return content.str();
+	}
+
+	std::string RandomContent(const size_t size, uint32 seed)
+	{
+		std::string content(size, '\0');
+		for (auto &c : content)
+		{
+			seed = seed * 1664525 + 1013904223;
+			c = static_cast<char>(seed >> 24);
+		}
+
+		return content;
+	}
+
+	/// Temporary directory with a source, an output and a client directory, which is removed afterwards.
+	struct UpdateDirectories
+	{
+		std::filesystem::path root;
+		std::filesystem::path source;
+		std::filesystem::path output;
+		std::filesystem::path client;
+
+		UpdateDirectories()
+		{
+			static uint32 counter = 0;
+			root = std::filesystem::temp_directory_path() / ("mmo_update_test_" + std::to_string(++counter));
+			std::filesystem::remove_all(root);
+
+			source = root / "source";
+			output = root / "output";
+			client = root / "client";
+			std::filesystem::create_directories(source / "data");
+			std::filesystem::create_directories(client);
+
+			WriteFile(source / "source.txt", "version = 0\nroot = (type = \"fs\", from = \"data\")\n");
+		}
+
+		~UpdateDirectories()
+		{
+			std::error_code error;
+			std::filesystem::remove_all(root, error);
+		}
+	};
+
+	updating::CompileStatistics Compile(const UpdateDirectories &directories, const std::uintmax_t chunkSize, JobSystem *jobs = nullptr)
+	{
+		virtual_dir::FileSystemReader sourceReader(directories.source);
+		virtual_dir::FileSystemWriter outputWriter(directories.output);
+		virtual_dir::FileSystemReader previousOutputReader(directories.output);
+
+		updating::CompileOptions options;
+		options.isZLibCompressed = true;
+		options.chunkSize = chunkSize;
+		options.previousOutput = &previousOutputReader;
+		options.jobs = jobs;
+		return updating::compileDirectory(sourceReader, outputWriter, options);
+	}
+
+	updating::PreparedUpdate Prepare(const UpdateDirectories &directories, NullProgressHandler &progressHandler)
+	{
+		const updating::PrepareParameters parameters(
+			std::make_unique<updating::FileSystemUpdateSource>(directories.output),
+			{},
+			false,
+			progressHandler);
+
+		return updating::prepareUpdate(directories.client.string(), parameters);
+	}
+
+	void Apply(const UpdateDirectories &directories, updating::PreparedUpdate &update, NullProgressHandler &progressHandler)
+	{
+		const updating::UpdateParameters parameters(
+			std::make_unique<updating::FileSystemUpdateSource>(directories.output),
+			false,
+			progressHandler);
+
+		for (auto &step : update.steps)
+		{
+			while (step.step(parameters))
+			{
+			}
+		}
+	}
+}
+
+TEST_CASE("Content chunk boundaries survive insertions", "[updater]")
+{
+	const std::string original = RandomContent(256 * 1024, 1);
+	const std::string modified = original.substr(0, 100000) + "inserted bytes" + original.substr(100000);
+
+	std::istringstream originalStream(original);
+	std::istringstream modifiedStream(modified);
+	const auto originalChunks = updating::splitContentChunks(originalStream, 4096);
+	const auto modifiedChunks = updating::splitContentChunks(modifiedStream, 4096);
+
+	std::set<SHA1Hash> originalDigests;
+	std::uintmax_t offset = 0;
+	for (const auto &chunk : originalChunks)
+	{
+		CHECK(chunk.offset == offset);
+		CHECK(chunk.size <= 4096 * 4);
+		offset += chunk.size;
+		originalDigests.insert(chunk.sha1);
+	}
+	CHECK(offset == original.size());
+
+	size_t sharedChunks = 0;
+	for (const auto &chunk : modifiedChunks)
+	{
+		sharedChunks += originalDigests.count(chunk.sha1);
+	}
+
+	// Only the chunks around the insertion point differ
+	CHECK(sharedChunks + 3 >= modifiedChunks.size());
+}
+
+TEST_CASE("Update compilation skips unchanged files", "[updater]")
+{
+	UpdateDirectories directories;
+	for (uint32 i = 0; i < 8; ++i)
+	{
+		WriteFile(directories.source / "data" / ("file" + std::to_string(i) + ".bin"), RandomContent(1000 + i * 100, i));
+	}
+
+	JobSystem jobs(2);
+	auto statistics = Compile(directories, 0, &jobs);
+	CHECK(statistics.compiledFiles == 8);
+	CHECK(statistics.skippedFiles == 0);
+
+	statistics = Compile(directories, 0, &jobs);
+	CHECK(statistics.compiledFiles == 0);
+	CHECK(statistics.skippedFiles == 8);
+
+	WriteFile(directories.source / "data" / "file3.bin", "changed");
+	std::filesystem::remove(directories.output / "data" / "file5.bin.z");
+
+	statistics = Compile(directories, 0, &jobs);
+	CHECK(statistics.compiledFiles == 2);
+	CHECK(statistics.skippedFiles == 6);
+
+	NullProgressHandler progressHandler;
+	auto update = Prepare(directories, progressHandler);
+	CHECK(update.steps.size() == 8);
+	Apply(directories, update, progressHandler);
+
+	CHECK(ReadFile(directories.client / "data" / "file3.bin") == "changed");
+	CHECK(ReadFile(directories.client / "data" / "file5.bin") == RandomContent(1500, 5));
+	CHECK(Prepare(directories, progressHandler).steps.empty());
+}
+
+TEST_CASE("Updater patches files from content chunks", "[updater]")
+{
+	UpdateDirectories directories;
+	const std::string original = RandomContent(512 * 1024, 7);
+	WriteFile(directories.source / "data" / "large.bin", original);
+
+	Compile(directories, 4096);
+
+	NullProgressHandler progressHandler;
+	auto update = Prepare(directories, progressHandler);
+	Apply(directories, update, progressHandler);
+	REQUIRE(ReadFile(directories.client / "data" / "large.bin") == original);
+
+	const std::string modified = original.substr(0, 200000) + RandomContent(1000, 8) + original.substr(200000);
+	WriteFile(directories.source / "data" / "large.bin", modified);
+
+	const auto statistics = Compile(directories, 4096);
+	CHECK(statistics.compiledFiles == 1);
+	CHECK(statistics.writtenChunks <= 3);
+
+	SECTION("Only changed chunks are downloaded")
+	{
+		update = Prepare(directories, progressHandler);
+		REQUIRE(update.steps.size() == 1);
+		CHECK(update.estimates.downloadSize < 64 * 1024);
+
+		Apply(directories, update, progressHandler);
+		CHECK(ReadFile(directories.client / "data" / "large.bin") == modified);
+		CHECK_FALSE(std::filesystem::exists(directories.client / "data" / "large.bin.patch"));
+	}
+
+	SECTION("Damaged chunks leave the local copy untouched")
+	{
+		update = Prepare(directories, progressHandler);
+		REQUIRE(update.steps.size() == 1);
+
+		// Replace every chunk of the new version with one of the same size but different content
+		for (const auto &entry : std::filesystem::directory_iterator(directories.output / updating::ContentChunkDirectory))
+		{
+			std::filesystem::path path = entry.path();
+			const std::string damaged = RandomContent(static_cast<size_t>(std::filesystem::file_size(path)), 9);
+			WriteFile(path, damaged);
+		}
+
+		CHECK_THROWS(Apply(directories, update, progressHandler));
+		CHECK(ReadFile(directories.client / "data" / "large.bin") == original);
+	}
+}
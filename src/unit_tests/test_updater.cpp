@@ -0,0 +1,532 @@
+// Copyright (C) 2019 - 2026, Kyoril. All rights reserved.
+
+#include "catch.hpp"
+
+#include "base/filesystem.h"
+#include "base/job_system.h"
+#include "update_compilation/compile_directory.h"
+#include "updater/download_file.h"
+#include "updater/file_system_update_source.h"
+#include "updater/http_update_source.h"
+#include "updater/perform_update.h"
+#include "updater/prepare_parameters.h"
+#include "updater/prepare_progress_handler.h"
+#include "updater/prepare_update.h"
+#include "updater/update_parameters.h"
+#include "updater/updater_progress_handler.h"
+#include "virtual_dir/file_system_reader.h"
+#include "virtual_dir/file_system_writer.h"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "asio.hpp"
+
+using namespace mmo;
+
+namespace
+{
+	struct NullProgressHandler final : updating::IPrepareProgressHandler, updating::IUpdaterProgressHandler
+	{
+		void beginCheckLocalCopy(const std::string &) override
+		{
+		}
+
+		void updateFile(const std::string &, std::uintmax_t, std::uintmax_t) override
+		{
+		}
+	};
+
+	void WriteFile(const std::filesystem::path &path, const std::string &content)
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(content.data(), static_cast<std::streamsize>(content.size()));
+	}
+
+	std::string ReadFile(const std::filesystem::path &path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		std::ostringstream content;
+		content << file.rdbuf();
+		return content.str();
+	}
+
+	std::string RandomContent(const size_t size, uint32 seed)
+	{
+		std::string content(size, '\0');
+		for (auto &c : content)
+		{
+			seed = seed * 1664525 + 1013904223;
+			c = static_cast<char>(seed >> 24);
+		}
+
+		return content;
+	}
+
+	/// Temporary directory with a source, an output and a client directory, which is removed afterwards.
+	struct UpdateDirectories
+	{
+		std::filesystem::path root;
+		std::filesystem::path source;
+		std::filesystem::path output;
+		std::filesystem::path client;
+
+		UpdateDirectories()
+		{
+			static uint32 counter = 0;
+			root = std::filesystem::temp_directory_path() / ("mmo_update_pipeline_test_" + std::to_string(++counter));
+			std::filesystem::remove_all(root);
+
+			source = root / "source";
+			output = root / "output";
+			client = root / "client";
+			std::filesystem::create_directories(source / "data");
+			std::filesystem::create_directories(client);
+
+			WriteFile(source / "source.txt", "version = 0\nroot = (type = \"fs\", from = \"data\")\n");
+		}
+
+		~UpdateDirectories()
+		{
+			std::error_code error;
+			std::filesystem::remove_all(root, error);
+		}
+	};
+
+	updating::CompileStatistics Compile(const UpdateDirectories &directories, const std::uintmax_t chunkSize, JobSystem *jobs = nullptr)
+	{
+		virtual_dir::FileSystemReader sourceReader(directories.source);
+		virtual_dir::FileSystemWriter outputWriter(directories.output);
+		virtual_dir::FileSystemReader previousOutputReader(directories.output);
+
+		updating::CompileOptions options;
+		options.isZLibCompressed = true;
+		options.chunkSize = chunkSize;
+		options.previousOutput = &previousOutputReader;
+		options.jobs = jobs;
+		return updating::compileDirectory(sourceReader, outputWriter, options);
+	}
+
+	updating::PreparedUpdate Prepare(const UpdateDirectories &directories, NullProgressHandler &progressHandler)
+	{
+		const updating::PrepareParameters parameters(
+			std::make_unique<updating::FileSystemUpdateSource>(directories.output),
+			{},
+			false,
+			progressHandler);
+
+		return updating::prepareUpdate(directories.client.string(), parameters);
+	}
+
+	bool Perform(
+		const updating::PreparedUpdate &update,
+		std::unique_ptr<updating::IUpdateSource> source,
+		NullProgressHandler &progressHandler,
+		const updating::PerformUpdateOptions &options)
+	{
+		const updating::UpdateParameters parameters(
+			std::move(source),
+			false,
+			progressHandler);
+
+		return updating::performUpdate(update, parameters, options);
+	}
+
+	/// Remembers the offsets of all files which are read from an update source.
+	struct RecordingUpdateSource final : updating::IUpdateSource
+	{
+		explicit RecordingUpdateSource(const std::filesystem::path &root, std::map<std::string, std::uintmax_t> &offsets)
+			: m_source(root)
+			, m_offsets(offsets)
+		{
+		}
+
+		using IUpdateSource::readFile;
+
+		updating::UpdateSourceFile readFile(const std::string &path, const std::uintmax_t offset) override
+		{
+			m_offsets[path] = offset;
+			return m_source.readFile(path, offset);
+		}
+
+	private:
+		updating::FileSystemUpdateSource m_source;
+		std::map<std::string, std::uintmax_t> &m_offsets;
+	};
+
+	/// Delays every request, like a remote update source would.
+	struct DelayedUpdateSource final : updating::IUpdateSource
+	{
+		DelayedUpdateSource(const std::filesystem::path &root, const std::chrono::microseconds delay)
+			: m_source(root)
+			, m_delay(delay)
+		{
+		}
+
+		using IUpdateSource::readFile;
+
+		updating::UpdateSourceFile readFile(const std::string &path, const std::uintmax_t offset) override
+		{
+			std::this_thread::sleep_for(m_delay);
+			return m_source.readFile(path, offset);
+		}
+
+	private:
+		updating::FileSystemUpdateSource m_source;
+		std::chrono::microseconds m_delay;
+	};
+
+	/// Minimal HTTP server on the loopback interface which serves the files of a directory, optionally with support
+	/// for range requests.
+	struct HttpStandIn
+	{
+		HttpStandIn(std::filesystem::path root, const bool supportsRanges)
+			: m_root(std::move(root))
+			, m_supportsRanges(supportsRanges)
+			, m_acceptor(m_ioContext, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0))
+		{
+			m_thread = std::thread([this]() { Run(); });
+		}
+
+		~HttpStandIn()
+		{
+			m_isStopped = true;
+
+			// Wake up the blocking accept
+			asio::error_code error;
+			asio::ip::tcp::socket socket(m_ioContext);
+			socket.connect(m_acceptor.local_endpoint(), error);
+			m_thread.join();
+		}
+
+		uint16 GetPort() const
+		{
+			return m_acceptor.local_endpoint().port();
+		}
+
+		size_t GetRangeRequestCount() const
+		{
+			return m_rangeRequests;
+		}
+
+	private:
+		void Run()
+		{
+			while (!m_isStopped)
+			{
+				asio::ip::tcp::socket socket(m_ioContext);
+				asio::error_code error;
+				m_acceptor.accept(socket, error);
+				if (m_isStopped || error)
+				{
+					continue;
+				}
+
+				try
+				{
+					Handle(socket);
+				}
+				catch (const std::exception &)
+				{
+				}
+			}
+		}
+
+		void Handle(asio::ip::tcp::socket &socket)
+		{
+			asio::streambuf requestBuffer;
+			asio::read_until(socket, requestBuffer, "\r\n\r\n");
+
+			std::istream request(&requestBuffer);
+			std::string method, document, line;
+			request >> method >> document;
+			std::getline(request, line);
+
+			std::uintmax_t rangeBegin = 0;
+			while (std::getline(request, line) && line != "\r")
+			{
+				static const std::string RangeHeader = "Range: bytes=";
+				if (line.compare(0, RangeHeader.size(), RangeHeader) == 0)
+				{
+					rangeBegin = std::stoull(line.substr(RangeHeader.size()));
+				}
+			}
+
+			const std::filesystem::path path = m_root / document.substr(1);
+			if (!std::filesystem::is_regular_file(path))
+			{
+				asio::write(socket, asio::buffer(std::string("HTTP/1.0 404 Not Found\r\nContent-Length: 0\r\n\r\n")));
+				socket.shutdown(asio::ip::tcp::socket::shutdown_both);
+				return;
+			}
+
+			std::string body = ReadFile(path);
+			const bool isPartial = m_supportsRanges && rangeBegin > 0;
+			if (isPartial)
+			{
+				++m_rangeRequests;
+				body = body.substr(static_cast<size_t>(rangeBegin));
+			}
+
+			std::ostringstream response;
+			response << (isPartial ? "HTTP/1.0 206 Partial Content\r\n" : "HTTP/1.0 200 OK\r\n");
+			response << "Content-Length: " << body.size() << "\r\n";
+			response << "\r\n";
+			response << body;
+
+			asio::write(socket, asio::buffer(response.str()));
+			socket.shutdown(asio::ip::tcp::socket::shutdown_both);
+		}
+
+	private:
+		std::filesystem::path m_root;
+		bool m_supportsRanges;
+		asio::io_context m_ioContext;
+		asio::ip::tcp::acceptor m_acceptor;
+		std::thread m_thread;
+		std::atomic<bool> m_isStopped { false };
+		std::atomic<size_t> m_rangeRequests { 0 };
+	};
+
+	/// Writes the first half of the download of a file, as left behind by an interrupted update.
+	void WritePartialDownload(const UpdateDirectories &directories, const std::string &fileName)
+	{
+		const std::string download = ReadFile(directories.output / "data" / (fileName + ".z"));
+		const std::string content = ReadFile(directories.source / "data" / fileName);
+		const auto sha1 = mmo::sha1(content.data(), content.size());
+
+		std::filesystem::create_directories(directories.client / "data");
+		WriteFile(updating::getPartialDownloadPath((directories.client / "data" / fileName).string(), sha1), download.substr(0, download.size() / 2));
+	}
+}
+
+TEST_CASE("Update pipeline installs and verifies all files", "[updater]")
+{
+	UpdateDirectories directories;
+	for (uint32 i = 0; i < 64; ++i)
+	{
+		WriteFile(directories.source / "data" / ("file" + std::to_string(i) + ".bin"), RandomContent(500 + i * 97, i));
+	}
+
+	Compile(directories, 0);
+
+	NullProgressHandler progressHandler;
+	const auto update = Prepare(directories, progressHandler);
+	REQUIRE(update.steps.size() == 64);
+
+	updating::PerformUpdateOptions options;
+	options.fetchConcurrency = 4;
+	options.applyConcurrency = 2;
+
+	updating::UpdateProgress lastProgress;
+	options.progress = [&lastProgress](const updating::UpdateProgress &progress)
+	{
+		lastProgress = progress;
+	};
+
+	CHECK(Perform(update, std::make_unique<updating::FileSystemUpdateSource>(directories.output), progressHandler, options));
+
+	CHECK(lastProgress.completedSteps == 64);
+	CHECK(lastProgress.stepCount == 64);
+	CHECK(lastProgress.downloadedBytes == update.estimates.downloadSize);
+	CHECK(lastProgress.updatedBytes == update.estimates.updateSize);
+
+	for (uint32 i = 0; i < 64; ++i)
+	{
+		CHECK(ReadFile(directories.client / "data" / ("file" + std::to_string(i) + ".bin")) == RandomContent(500 + i * 97, i));
+	}
+
+	for (const auto &entry : std::filesystem::directory_iterator(directories.client / "data"))
+	{
+		CHECK(entry.path().extension() == ".bin");
+	}
+
+	CHECK(Prepare(directories, progressHandler).steps.empty());
+}
+
+TEST_CASE("Update pipeline resumes partial downloads", "[updater]")
+{
+	UpdateDirectories directories;
+	WriteFile(directories.source / "data" / "large.bin", RandomContent(200 * 1024, 3));
+	WriteFile(directories.source / "data" / "small.bin", RandomContent(1000, 4));
+	Compile(directories, 0);
+
+	WritePartialDownload(directories, "large.bin");
+
+	NullProgressHandler progressHandler;
+	const auto update = Prepare(directories, progressHandler);
+	REQUIRE(update.steps.size() == 2);
+
+	std::map<std::string, std::uintmax_t> offsets;
+	CHECK(Perform(update, std::make_unique<RecordingUpdateSource>(directories.output, offsets), progressHandler, {}));
+
+	CHECK(offsets["data/large.bin.z"] == std::filesystem::file_size(directories.output / "data" / "large.bin.z") / 2);
+	CHECK(offsets["data/small.bin.z"] == 0);
+	CHECK(ReadFile(directories.client / "data" / "large.bin") == RandomContent(200 * 1024, 3));
+	CHECK(ReadFile(directories.client / "data" / "small.bin") == RandomContent(1000, 4));
+}
+
+TEST_CASE("Update pipeline discards damaged downloads", "[updater]")
+{
+	UpdateDirectories directories;
+	const std::string content = RandomContent(64 * 1024, 5);
+	WriteFile(directories.source / "data" / "file.bin", content);
+	Compile(directories, 0);
+
+	std::filesystem::create_directories(directories.client / "data");
+	const auto partialDownload = updating::getPartialDownloadPath((directories.client / "data" / "file.bin").string(), sha1(content.data(), content.size()));
+	WriteFile(partialDownload, RandomContent(1000, 6));
+
+	NullProgressHandler progressHandler;
+	auto update = Prepare(directories, progressHandler);
+	CHECK_THROWS(Perform(update, std::make_unique<updating::FileSystemUpdateSource>(directories.output), progressHandler, {}));
+	CHECK_FALSE(std::filesystem::exists(partialDownload));
+	CHECK_FALSE(std::filesystem::exists(directories.client / "data" / "file.bin.patch"));
+	CHECK_FALSE(std::filesystem::exists(directories.client / "data" / "file.bin"));
+
+	update = Prepare(directories, progressHandler);
+	CHECK(Perform(update, std::make_unique<updating::FileSystemUpdateSource>(directories.output), progressHandler, {}));
+	CHECK(ReadFile(directories.client / "data" / "file.bin") == content);
+}
+
+TEST_CASE("Update preparation removes temporary files of earlier attempts", "[updater]")
+{
+	UpdateDirectories directories;
+	const std::string upToDate = RandomContent(1000, 7);
+	WriteFile(directories.source / "data" / "missing.bin", RandomContent(64 * 1024, 8));
+	WriteFile(directories.source / "data" / "current.bin", upToDate);
+	Compile(directories, 0);
+
+	const auto data = directories.client / "data";
+	const auto missing = (data / "missing.bin").string();
+	const auto current = (data / "current.bin").string();
+
+	// A partial download of the current version, one of an older version and a patched copy left by a failed attempt
+	WritePartialDownload(directories, "missing.bin");
+	const std::string missingContent = ReadFile(directories.source / "data" / "missing.bin");
+	const auto partialDownload = updating::getPartialDownloadPath(missing, sha1(missingContent.data(), missingContent.size()));
+	const auto outdatedDownload = updating::getPartialDownloadPath(missing, SHA1Hash{});
+	WriteFile(outdatedDownload, "outdated");
+	WriteFile(missing + ".patch", "incomplete");
+
+	// Leftovers of a file which has been updated since
+	WriteFile(current, upToDate);
+	WriteFile(updating::getPartialDownloadPath(current, sha1(upToDate.data(), upToDate.size())), "finished");
+	WriteFile(current + ".patch", "finished");
+
+	// Files which don't belong to an entry of the update list are left alone
+	WriteFile(data / "notes.patch", "notes");
+
+	NullProgressHandler progressHandler;
+	const auto update = Prepare(directories, progressHandler);
+	REQUIRE(update.steps.size() == 1);
+
+	CHECK(std::filesystem::exists(partialDownload));
+	CHECK_FALSE(std::filesystem::exists(outdatedDownload));
+	CHECK_FALSE(std::filesystem::exists(missing + ".patch"));
+	CHECK_FALSE(std::filesystem::exists(updating::getPartialDownloadPath(current, sha1(upToDate.data(), upToDate.size()))));
+	CHECK_FALSE(std::filesystem::exists(current + ".patch"));
+	CHECK(std::filesystem::exists(data / "notes.patch"));
+
+	CHECK(Perform(update, std::make_unique<updating::FileSystemUpdateSource>(directories.output), progressHandler, {}));
+	CHECK_FALSE(std::filesystem::exists(partialDownload));
+	CHECK(ReadFile(missing) == missingContent);
+}
+
+TEST_CASE("Update pipeline stops when cancelled", "[updater]")
+{
+	UpdateDirectories directories;
+	for (uint32 i = 0; i < 16; ++i)
+	{
+		WriteFile(directories.source / "data" / ("file" + std::to_string(i) + ".bin"), RandomContent(1000, i));
+	}
+
+	Compile(directories, 0);
+
+	NullProgressHandler progressHandler;
+	const auto update = Prepare(directories, progressHandler);
+
+	std::atomic<size_t> polls { 0 };
+	updating::PerformUpdateOptions options;
+	options.fetchConcurrency = 1;
+	options.applyConcurrency = 1;
+	options.isCancelled = [&polls]()
+	{
+		return ++polls > 4;
+	};
+
+	CHECK_FALSE(Perform(update, std::make_unique<updating::FileSystemUpdateSource>(directories.output), progressHandler, options));
+	CHECK(Prepare(directories, progressHandler).steps.size() > 0);
+}
+
+TEST_CASE("Update pipeline downloads from HTTP sources", "[updater]")
+{
+	const bool supportsRanges = GENERATE(true, false);
+
+	UpdateDirectories directories;
+	for (uint32 i = 0; i < 8; ++i)
+	{
+		WriteFile(directories.source / "data" / ("file" + std::to_string(i) + ".bin"), RandomContent(20 * 1024, i));
+	}
+
+	Compile(directories, 0);
+	WritePartialDownload(directories, "file3.bin");
+
+	HttpStandIn server(directories.output, supportsRanges);
+
+	NullProgressHandler progressHandler;
+	const auto update = Prepare(directories, progressHandler);
+	REQUIRE(update.steps.size() == 8);
+
+	updating::PerformUpdateOptions options;
+	options.fetchConcurrency = 3;
+	CHECK(Perform(update, std::make_unique<updating::HTTPUpdateSource>("127.0.0.1", server.GetPort(), "/"), progressHandler, options));
+	CHECK(server.GetRangeRequestCount() == (supportsRanges ? 1 : 0));
+
+	// Files which the server doesn't have are reported instead of being installed empty
+	updating::HTTPUpdateSource source("127.0.0.1", server.GetPort(), "/");
+	CHECK_THROWS(source.readFile("data/missing.bin.z", 0));
+
+	for (uint32 i = 0; i < 8; ++i)
+	{
+		CHECK(ReadFile(directories.client / "data" / ("file" + std::to_string(i) + ".bin")) == RandomContent(20 * 1024, i));
+	}
+}
+
+TEST_CASE("Update pipeline benchmark", "[!benchmark][updater]")
+{
+	UpdateDirectories directories;
+	for (uint32 i = 0; i < 2000; ++i)
+	{
+		WriteFile(directories.source / "data" / ("file" + std::to_string(i) + ".bin"), RandomContent(2048, i));
+	}
+
+	Compile(directories, 0);
+
+	NullProgressHandler progressHandler;
+	const auto update = Prepare(directories, progressHandler);
+	REQUIRE(update.steps.size() == 2000);
+
+	// Every run installs all files again, as the steps don't check the local copy. Requests take a millisecond, which
+	// is still less than the round trip to most update servers.
+	constexpr std::chrono::milliseconds Latency(1);
+
+	updating::PerformUpdateOptions sequentialOptions;
+	sequentialOptions.fetchConcurrency = 1;
+	sequentialOptions.applyConcurrency = 1;
+	BENCHMARK("2000 files, one at a time")
+	{
+		return Perform(update, std::make_unique<DelayedUpdateSource>(directories.output, Latency), progressHandler, sequentialOptions);
+	};
+
+	updating::PerformUpdateOptions options;
+	options.fetchConcurrency = 8;
+	options.applyConcurrency = 2;
+	BENCHMARK("2000 files, 8 concurrent fetches")
+	{
+		return Perform(update, std::make_unique<DelayedUpdateSource>(directories.output, Latency), progressHandler, options);
+	};
+}
@@ -1,13 +1,17 @@
 // Copyright (C) 2019 - 2025, Kyoril. All rights reserved.
 
+#include <algorithm>
 #include <iostream>
 #include <set>
+#include <thread>
 
 #include "base/filesystem.h"
+#include "base/job_system.h"
 
 #include "cxxopts/cxxopts.hpp"
 
 #include "update_compilation/compile_directory.h"
+#include "updater/content_chunks.h"
 
 #include "virtual_dir/file_system_reader.h"
 #include "virtual_dir/file_system_writer.h"
@@ -21,6 +25,7 @@ int main(int argc, char **argv)
 	// Paramaters parsed out of command line options
 	std::string sourceDir, outputDir;
 	std::string compression;
+	size_t threadCount = std::thread::hardware_concurrency();
 
 	// Build command line options
 	cxxopts::Options options(VersionStr + ", available options");
@@ -30,6 +35,9 @@ int main(int argc, char **argv)
 		("s,source", "A directory containing source.txt", cxxopts::value(sourceDir))
 		("o,output", "Where to put the updater-compatible files", cxxopts::value(outputDir))
 		("c,compression", "Provide 'zlib' for compression", cxxopts::value(compression))
+		("chunks", "Split large files into content chunks, so that clients only download changed parts")
+		("j,threads", "Number of threads used to compile files", cxxopts::value(threadCount))
+		("f,force", "Compile all files, even if they did not change since the last compilation")
 		;
 
 	// Support positional arguments
@@ -72,12 +80,27 @@ int main(int argc, char **argv)
 		{
 			virtual_dir::FileSystemReader sourceReader(sourceDir);
 			virtual_dir::FileSystemWriter outputWriter(outputDir);
+			virtual_dir::FileSystemReader previousOutputReader(outputDir);
 
-			mmo::updating::compileDirectory(
+			// The calling thread works on the jobs as well
+			JobSystem jobs(std::max<size_t>(threadCount, 1) - 1);
+
+			updating::CompileOptions compileOptions;
+			compileOptions.isZLibCompressed = isZLibCompressed;
+			compileOptions.chunkSize = results.count("chunks") ? updating::DefaultContentChunkSize : 0;
+			compileOptions.previousOutput = results.count("force") ? nullptr : &previousOutputReader;
+			compileOptions.jobs = &jobs;
+
+			const auto statistics = updating::compileDirectory(
 				sourceReader,
 				outputWriter,
-				isZLibCompressed
+				compileOptions
 			);
+
+			std::cout
+				<< "Compiled " << statistics.compiledFiles << " files, "
+				<< statistics.skippedFiles << " unchanged, "
+				<< statistics.writtenChunks << " new content chunks\n";
 		}
 		catch (const std::exception &e)
 		{
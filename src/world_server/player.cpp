@@ -213,6 +213,7 @@ namespace mmo
 		{
 			VisibilityTile &tile = m_worldInstance->GetGrid().RequireTile(GetTileIndex());
 			tile.GetWatchers().optionalRemove(this);
+			m_worldInstance->GetCombatLog().RemoveSubscriber(*this);
 			m_worldInstance->RemoveGameObject(*m_character);
 		}
 	}
@@ -555,7 +556,7 @@ namespace mmo
 
 
 			// Send movement packets
-			if (object->IsUnit())
+			if (object->IsUnit() && object->AsUnit().HasMover())
 			{
 				object->AsUnit().GetMover().SendMovementPackets(*this);
 			}
@@ -1219,6 +1220,7 @@ namespace mmo
 		TileIndex2D tileIndex = GetTileIndex();
 		VisibilityTile& tile = m_worldInstance->GetGrid().RequireTile(tileIndex);
 		tile.GetWatchers().remove(this);
+		m_worldInstance->GetCombatLog().RemoveSubscriber(*this);
 	}
 
 	void Player::OnTileChangePending(VisibilityTile& oldTile, VisibilityTile& newTile)
@@ -1929,6 +1931,9 @@ namespace mmo
 					}
 					return;
 				}
+
+				// Swimming inside this water quad needs no further geometry checks
+				m_worldInstance->GetMovementValidator().ConfirmWater(m_character->GetGuid(), info.position);
 			}
 		}
 		else if (opCode == game::client_realm_packet::MoveStopSwim)
@@ -1954,9 +1959,8 @@ namespace mmo
 			// water (leaving the water sends MoveStopSwim first). A hard miss is treated as a
 			// violation; the anti-cheat tracker only kicks once a threshold is exceeded so a single
 			// shoreline-edge race cannot cause a false kick. Only enforced when water data exists.
-			float surfaceY = 0.0f;
-			MapData* mapData = m_worldInstance->GetMapData();
-			if (mapData && mapData->IsWaterDataAvailable() && !mapData->GetWaterSurface(info.position, surfaceY))
+			// The water geometry is only queried once the player left the last verified water quad.
+			if (!m_worldInstance->GetMovementValidator().CheckWater(m_character->GetGuid(), info.position, m_worldInstance->GetMapData()))
 			{
 				WLOG("[AntiCheat] Player " << m_character->GetName()
 					<< " is flagged swimming but is not over water at " << info.position);
@@ -2104,43 +2108,39 @@ namespace mmo
 		    opCode == game::realm_client_packet::MoveStartStrafeLeft ||
 		    opCode == game::realm_client_packet::MoveStartStrafeRight;
 
-		if (isPositionPacket && !info.IsFalling() && m_lastPositionPacketTimestamp > 0)
-		{
-			const float dist = (info.position - m_lastPositionPacketPos).GetLength();
-			if (dist > 0.0f && info.timestamp > m_lastPositionPacketTimestamp)
-			{
-				const float elapsed = static_cast<float>(info.timestamp - m_lastPositionPacketTimestamp) / 1000.0f;
-				// 35% tolerance for latency jitter, frame-rate variation, physics rounding.
-				// When the player is moving backward, cap against the backward speed instead of run speed.
-				const bool wasMovingBackward =
-					(info.movementFlags & movement_flags::Backward) != 0 &&
-					(info.movementFlags & movement_flags::Forward) == 0;
-				const float baseSpeed = wasMovingBackward
-					? m_character->GetSpeed(movement_type::Backwards)
-					: m_character->GetSpeed(movement_type::Run);
-				const float maxSpeed = baseSpeed * 1.35f;
-				const float impliedSpeed = dist / elapsed;
-
-				if (impliedSpeed > maxSpeed)
-				{
-					WLOG("[AntiCheat] Speed violation: implied=" << impliedSpeed
-					    << " max=" << maxSpeed
-					    << " dist=" << dist
-					    << " elapsed=" << elapsed
-					    << "s opcode=" << log_hex_digit(opCode)
-					    << " flags=" << log_hex_digit(info.movementFlags)
-					    << " prevFlags=" << log_hex_digit(m_lastPositionPacketFlags)
-					    << " pos=(" << info.position.x << "," << info.position.y << "," << info.position.z << ")"
-					    << " prevPos=(" << m_lastPositionPacketPos.x << "," << m_lastPositionPacketPos.y << "," << m_lastPositionPacketPos.z << ")");
-					if (!m_character->HasPendingMovementChange()) {
-                        m_antiCheatTracker.RecordViolation(GetAsyncTimeMs());
-                        if (m_antiCheatTracker.ShouldKick(GetAsyncTimeMs())) {
-                            ELOG("[AntiCheat] Kicking player " << m_character->GetName()
-                                << " (GUID " << m_character->GetGuid() << "): excessive speed hack");
-                            Kick();
-                        }
+		if (isPositionPacket && !info.IsFalling() && m_lastPositionPacketTimestamp > 0 && info.timestamp > m_lastPositionPacketTimestamp)
+		{
+			const float elapsed = static_cast<float>(info.timestamp - m_lastPositionPacketTimestamp) / 1000.0f;
+			// 35% tolerance for latency jitter, frame-rate variation, physics rounding.
+			// When the player is moving backward, cap against the backward speed instead of run speed.
+			const bool wasMovingBackward =
+				(info.movementFlags & movement_flags::Backward) != 0 &&
+				(info.movementFlags & movement_flags::Forward) == 0;
+			const float baseSpeed = wasMovingBackward
+				? m_character->GetSpeed(movement_type::Backwards)
+				: m_character->GetSpeed(movement_type::Run);
+			const float maxSpeed = baseSpeed * 1.35f;
+
+			float impliedSpeed = 0.0f;
+			if (!m_worldInstance->GetMovementValidator().CheckSpeed(m_lastPositionPacketPos, info.position, elapsed, maxSpeed, impliedSpeed))
+			{
+				WLOG("[AntiCheat] Speed violation: implied=" << impliedSpeed
+				    << " max=" << maxSpeed
+				    << " dist=" << impliedSpeed * elapsed
+				    << " elapsed=" << elapsed
+				    << "s opcode=" << log_hex_digit(opCode)
+				    << " flags=" << log_hex_digit(info.movementFlags)
+				    << " prevFlags=" << log_hex_digit(m_lastPositionPacketFlags)
+				    << " pos=(" << info.position.x << "," << info.position.y << "," << info.position.z << ")"
+				    << " prevPos=(" << m_lastPositionPacketPos.x << "," << m_lastPositionPacketPos.y << "," << m_lastPositionPacketPos.z << ")");
+				if (!m_character->HasPendingMovementChange()) {
+                    m_antiCheatTracker.RecordViolation(GetAsyncTimeMs());
+                    if (m_antiCheatTracker.ShouldKick(GetAsyncTimeMs())) {
+                        ELOG("[AntiCheat] Kicking player " << m_character->GetName()
+                            << " (GUID " << m_character->GetGuid() << "): excessive speed hack");
+                        Kick();
                     }
-				}
+                }
 			}
 		}
 
@@ -3138,44 +3138,50 @@ namespace mmo
 
 	void Player::OnSpellDamageLog(uint64 targetGuid, uint32 amount, uint8 school, DamageFlags flags, const proto::SpellEntry& spell, uint32 blocked)
 	{
-		SendPacket([targetGuid, amount, school, flags, &spell, blocked](game::OutgoingPacket& packet)
-			{
-				packet.Start(game::realm_client_packet::SpellDamageLog);
-				packet
-					<< io::write_packed_guid(targetGuid)
-					<< io::write<uint32>(spell.id())
-					<< io::write<uint32>(amount)
-					<< io::write<uint8>(school)
-					<< io::write<uint8>(flags)
-					<< io::write<uint32>(blocked);
-				packet.Finish();
-			});
+		if (!m_worldInstance)
+		{
+			return;
+		}
+
+		CombatLogEvent event;
+		event.type = combat_log_event::SpellDamage;
+		event.targetGuid = targetGuid;
+		event.spellId = spell.id();
+		event.amount = amount;
+		event.school = school;
+		event.flags = flags;
+		event.blocked = blocked;
+		m_worldInstance->GetCombatLog().Add(*this, event);
 	}
 
 	void Player::OnNonSpellDamageLog(uint64 targetGuid, uint32 amount, DamageFlags flags)
 	{
-		SendPacket([targetGuid, amount, flags](game::OutgoingPacket& packet)
-			{
-				packet.Start(game::realm_client_packet::NonSpellDamageLog);
-				packet
-					<< io::write_packed_guid(targetGuid)
-					<< io::write<uint32>(amount)
-					<< io::write<uint8>(flags);
-				packet.Finish();
-			});
+		if (!m_worldInstance)
+		{
+			return;
+		}
+
+		CombatLogEvent event;
+		event.type = combat_log_event::NonSpellDamage;
+		event.targetGuid = targetGuid;
+		event.amount = amount;
+		event.flags = flags;
+		m_worldInstance->GetCombatLog().Add(*this, event);
 	}
 
 	void Player::OnEnvironmentalDamageLog(uint64 targetGuid, uint32 amount, EnvironmentalDamageType type)
 	{
-		SendPacket([targetGuid, amount, type](game::OutgoingPacket& packet)
-			{
-				packet.Start(game::realm_client_packet::EnvironmentalDamageLog);
-				packet
-					<< io::write_packed_guid(targetGuid)
-					<< io::write<uint32>(amount)
-					<< io::write<uint8>(type);
-				packet.Finish();
-			});
+		if (!m_worldInstance)
+		{
+			return;
+		}
+
+		CombatLogEvent event;
+		event.type = combat_log_event::EnvironmentalDamage;
+		event.targetGuid = targetGuid;
+		event.amount = amount;
+		event.subType = type;
+		m_worldInstance->GetCombatLog().Add(*this, event);
 	}
 
 	void Player::SetFallDamageConfig(float minHeight, float lethalHeight)
@@ -3269,6 +3275,7 @@ namespace mmo
 			// No longer watch tile
 			VisibilityTile& tile = m_worldInstance->GetGrid().RequireTile(GetTileIndex());
 			tile.GetWatchers().remove(this);
+			m_worldInstance->GetCombatLog().RemoveSubscriber(*this);
 
 			// Remove the character from the world (this will save the character)
 			m_worldInstance->RemoveGameObject(*m_character);
@@ -3442,6 +3449,9 @@ namespace mmo
 			return;
 		}
 
+		// Loot is rolled when it is opened for the first time
+		loot->Generate();
+
 		const uint64 roundRobinLooter = loot->GetRoundRobinLooter();
 		if (roundRobinLooter != 0 && roundRobinLooter != m_character->GetGuid())
 		{
@@ -419,15 +419,16 @@ namespace mmo
 			});
 	}
 
-void RealmConnector::SendSaveInventoryItems(uint64 characterGuid, uint32 operationId, const std::vector<ItemData>& items)
+void RealmConnector::SendSaveInventoryItems(uint64 characterGuid, uint32 operationId, const std::vector<ItemData>& items, bool replaceAll)
 {
 	// CRITICAL: Capture items by value to ensure they're not destroyed before async send
-	sendSinglePacket([characterGuid, operationId, items](auth::OutgoingPacket& outPacket)
+	sendSinglePacket([characterGuid, operationId, items, replaceAll](auth::OutgoingPacket& outPacket)
 	{
 		outPacket.Start(auth::world_realm_packet::SaveInventoryItems);
 		outPacket
 			<< io::write<uint64>(characterGuid)
 			<< io::write<uint32>(operationId)
+			<< io::write<uint8>(replaceAll ? 1 : 0)
 			<< io::write<uint16>(static_cast<uint16>(items.size()));
 
 		for (const auto& item : items)
@@ -1012,8 +1013,14 @@ void RealmConnector::SendDeleteInventoryItems(uint64 characterGuid, uint32 opera
 				<< " (operationId: " << operationId << ")");
 		}
 
-		// TODO: Notify WorldServerInventoryRepository via callback/signal
-		// For now, we just log the result
+		// The realm no longer matches the last save, so the next save must not rely on it
+		if (!success)
+		{
+			if (const auto player = m_playerManager.GetPlayerByCharacterGuid(characterGuid))
+			{
+				player->GetCharacter().GetInventory().RequestFullSave();
+			}
+		}
 
 		return PacketParseResult::Pass;
 	}
@@ -90,8 +90,9 @@ namespace mmo
 		/// Sends a batch of inventory items to persist on the realm server.
 		/// @param characterGuid The character whose inventory is being saved.
 		/// @param operationId Unique ID for tracking this operation.
-		/// @param items Vector of item data to save.
-		void SendSaveInventoryItems(uint64 characterGuid, uint32 operationId, const std::vector<ItemData>& items);
+		/// @param items Vector of item data to save. Items in the same slots are replaced.
+		/// @param replaceAll If set, all other items of the character are removed.
+		void SendSaveInventoryItems(uint64 characterGuid, uint32 operationId, const std::vector<ItemData>& items, bool replaceAll);
 
 		/// Sends a request to delete inventory items on the realm server.
 		/// @param characterGuid The character whose items are being deleted.